@@ -24,7 +24,9 @@ CONFIGUSER_INPUT_FILE_NAME_FIELD,
 GAMESTATE_SCOPE,
 CONFIGUSER_INPUT_FILE_PATH_FIELD
 ),
-m_camera(0), m_objectList(0), m_asteroid(0),
+m_camera(0), m_objectList(0), m_transformSystem(0),
+m_transformScheduler(0), m_workerPool(0), m_nTransformThreads(GAMESTATE_N_TRANSFORM_THREADS_DEFAULT),
+m_nSkippedTransformUpdates(0), m_spatialIndex(0), m_broadphase(0), m_asteroid(0),
 m_asteroidRadius(0.0f), m_asteroidGridSpacing(1.0f),
 m_nAsteroidsX(0), m_nAsteroidsY(0), m_nAsteroidsZ(0),
 m_gridQuads(0), m_gridQuadParents(0), m_quadWidth(0.0f), m_quadHeight(0.0f),
@@ -44,6 +46,27 @@ GameState::~GameState(void) {
 		m_camera = 0;
 	}
 
+	if( m_transformScheduler != 0 ) {
+		delete m_transformScheduler;
+		m_transformScheduler = 0;
+	}
+
+	if( m_workerPool != 0 ) {
+		delete m_workerPool;
+		m_workerPool = 0;
+	}
+
+	// Deleted before the Transformables it refers to
+	if( m_spatialIndex != 0 ) {
+		delete m_spatialIndex;
+		m_spatialIndex = 0;
+	}
+
+	if( m_broadphase != 0 ) {
+		delete m_broadphase;
+		m_broadphase = 0;
+	}
+
 	if( m_objectList != 0 ) {
 		std::vector<ObjectModel*>::size_type i = 0;
 		std::vector<ObjectModel*>::size_type size = m_objectList->size();
@@ -57,17 +80,6 @@ GameState::~GameState(void) {
 		m_objectList = 0;
 	}
 
-	if( m_gridQuads != 0 ) {
-		for( size_t i = 0; i < GAMESTATE_GEOMETRY_N_QUAD; ++i ) {
-			if( m_gridQuads[i] != 0 ) {
-				delete m_gridQuads[i];
-				m_gridQuads[i] = 0;
-			}
-		}
-		delete m_gridQuads;
-		m_gridQuads = 0;
-	}
-
 	if( m_gridQuadParents != 0 ) {
 		for( size_t i = 0; i < GAMESTATE_GEOMETRY_N_QUAD; ++i ) {
 			if( m_gridQuadParents[i] != 0 ) {
@@ -79,6 +91,23 @@ GameState::~GameState(void) {
 		m_gridQuadParents = 0;
 	}
 
+	// Deleted after the objects with Transformables bound to it
+	if( m_transformSystem != 0 ) {
+		delete m_transformSystem;
+		m_transformSystem = 0;
+	}
+
+	if( m_gridQuads != 0 ) {
+		for( size_t i = 0; i < GAMESTATE_GEOMETRY_N_QUAD; ++i ) {
+			if( m_gridQuads[i] != 0 ) {
+				delete m_gridQuads[i];
+				m_gridQuads[i] = 0;
+			}
+		}
+		delete m_gridQuads;
+		m_gridQuads = 0;
+	}
+
 	if (m_asteroid != 0) {
 		delete m_asteroid;
 		m_asteroid = 0;
@@ -100,6 +129,9 @@ HRESULT GameState::initialize(ID3D11Device* device, ID3D11Texture2D* backBuffer,
 	}
 
 	m_objectList = new vector<ObjectModel*>();
+	m_transformSystem = new TransformSystem(m_nAsteroidsX * m_nAsteroidsY * m_nAsteroidsZ * 3);
+	m_spatialIndex = new SpatialIndex(SPATIALINDEX_MARGIN_DEFAULT, m_nAsteroidsX * m_nAsteroidsY * m_nAsteroidsZ);
+	m_broadphase = new SweepAndPrune(m_nAsteroidsX * m_nAsteroidsY * m_nAsteroidsZ);
 
 	// Initialize models (geometry + spatial transformations)
 	if( FAILED(spawnAsteroidsGrid(m_nAsteroidsX, m_nAsteroidsY, m_nAsteroidsZ)) ) {
@@ -110,6 +142,10 @@ HRESULT GameState::initialize(ID3D11Device* device, ID3D11Texture2D* backBuffer,
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
+	if( FAILED(scheduleTransformables()) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+
 	return result;
 }
 
@@ -137,25 +173,42 @@ HRESULT GameState::drawContents(ID3D11DeviceContext* const context, GeometryRend
 HRESULT GameState::update(const DWORD currentTime, const DWORD updateTimeInterval) {
 	HRESULT result = ERROR_SUCCESS;
 
-	for( size_t i = 0; i < GAMESTATE_GEOMETRY_N_QUAD; ++i ) {
-		result = m_gridQuadParents[i]->update(currentTime, updateTimeInterval);
-		if( FAILED(result) ) {
-			logMessage(L"Failed to update quad parent Transformable at index = " + std::to_wstring(i) + L".");
-			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-		}
+	// Bound Transformables are not updated by their containing objects
+	result = m_transformSystem->update(updateTimeInterval);
+	if( FAILED(result) ) {
+		logMessage(L"Failed to update the TransformSystem.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
-	const vector<ObjectModel*>::size_type nObjects = m_objectList->size();
-	for( vector<ObjectModel*>::size_type i = 0; i < nObjects; ++i ) {
-		result = (*m_objectList)[i]->updateContainedTransforms(currentTime, updateTimeInterval);
-		if( FAILED(result) ) {
-			logMessage(L"Failed to update model at index = " + std::to_wstring(i) + L" in the object list.");
-			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-		}
+	result = m_transformScheduler->update(currentTime, updateTimeInterval);
+	if( FAILED(result) ) {
+		logMessage(L"Failed to update Transformable objects.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+	m_nSkippedTransformUpdates = m_transformScheduler->getNumberOfSkippedUpdates();
+
+	result = m_spatialIndex->update();
+	if( FAILED(result) ) {
+		logMessage(L"Failed to update the SpatialIndex.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+
+	result = m_broadphase->update();
+	if( FAILED(result) ) {
+		logMessage(L"Failed to update the collision broadphase.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 	return result;
 }
 
+size_t GameState::getNumberOfSkippedTransformUpdates(void) const {
+	return m_nSkippedTransformUpdates;
+}
+
+const SpatialIndex* GameState::getSpatialIndex(void) const {
+	return m_spatialIndex;
+}
+
 HRESULT GameState::poll(Keyboard& input, Mouse& mouse) {
 	if (FAILED(m_camera->poll(input, mouse))) {
 		logMessage(L"Call to Camera poll() function failed.");
@@ -176,6 +229,7 @@ HRESULT GameState::configure(void) {
 	int nAsteroidsX = GAMESTATE_NUMBER_OF_ASTEROIDS_X_DEFAULT;
 	int nAsteroidsY = GAMESTATE_NUMBER_OF_ASTEROIDS_Y_DEFAULT;
 	int nAsteroidsZ = GAMESTATE_NUMBER_OF_ASTEROIDS_Z_DEFAULT;
+	int nTransformThreads = GAMESTATE_N_TRANSFORM_THREADS_DEFAULT;
 
 	double quadWidth = GAMESTATE_QUAD_WIDTH_DEFAULT;
 	double quadHeight = GAMESTATE_QUAD_HEIGHT_DEFAULT;
@@ -220,6 +274,10 @@ HRESULT GameState::configure(void) {
 				nAsteroidsZ = *intValue;
 			}
 
+			if( retrieve<Config::DataType::INT, int>(GAMESTATE_SCOPE, GAMESTATE_N_TRANSFORM_THREADS_FIELD, intValue) ) {
+				nTransformThreads = *intValue;
+			}
+
 			if( retrieve<Config::DataType::DOUBLE, double>(GAMESTATE_SCOPE, GAMESTATE_QUAD_WIDTH_FIELD, doubleValue) ) {
 				quadWidth = *doubleValue;
 			}
@@ -271,6 +329,10 @@ HRESULT GameState::configure(void) {
 		nAsteroidsZ = GAMESTATE_NUMBER_OF_ASTEROIDS_Z_DEFAULT;
 		logMessage(L"nAsteroidsZ cannot be zero or negative. Reverting to default value of " + std::to_wstring(nAsteroidsZ));
 	}
+	if( nTransformThreads < 0 ) {
+		nTransformThreads = GAMESTATE_N_TRANSFORM_THREADS_DEFAULT;
+		logMessage(L"nTransformThreads cannot be negative. Reverting to default value of " + std::to_wstring(nTransformThreads));
+	}
 	if( quadWidth <= 0.0 ) {
 		quadWidth = GAMESTATE_QUAD_WIDTH_DEFAULT;
 		logMessage(L"Quad width cannot be zero or negative. Reverting to default value of " + std::to_wstring(quadWidth));
@@ -286,6 +348,7 @@ HRESULT GameState::configure(void) {
 	m_nAsteroidsX = nAsteroidsX;
 	m_nAsteroidsY = nAsteroidsY;
 	m_nAsteroidsZ = nAsteroidsZ;
+	m_nTransformThreads = nTransformThreads;
 
 	m_quadWidth = static_cast<float>(quadWidth);
 	m_quadHeight = static_cast<float>(quadHeight);
@@ -553,6 +616,12 @@ HRESULT GameState::spawnAsteroidsGrid(const size_t x, const size_t y, const size
 	if (m_asteroid == 0) {
 		logMessage(L"Cannot spawn asteroids before the asteroid has been constructed and configured.");
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	} else if( m_transformSystem == 0 ) {
+		logMessage(L"Cannot spawn asteroids before the TransformSystem has been constructed.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	} else if( m_spatialIndex == 0 || m_broadphase == 0 ) {
+		logMessage(L"Cannot spawn asteroids before the SpatialIndex and the collision broadphase have been constructed.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
 	}
 
 	XMFLOAT3 offset(0.0f, 0.0f, 0.0f);
@@ -565,6 +634,7 @@ HRESULT GameState::spawnAsteroidsGrid(const size_t x, const size_t y, const size
 	ObjectModel* newObject = 0;
 	Transformable* bone = 0;
 	Transformable* parent = 0;
+	size_t id = 0;
 
 	for (size_t i = 0; i < x; ++i){
 		for (size_t j = 0; j < y; ++j){
@@ -572,6 +642,9 @@ HRESULT GameState::spawnAsteroidsGrid(const size_t x, const size_t y, const size
 
 				newObject = new ObjectModel(m_asteroid);
 
+				// Add the object to the list (which takes ownership, even if an error occurs below)
+				m_objectList->emplace_back(newObject);
+
 				float offsetAmount = static_cast<float>(m_asteroidGridSpacing);
 				offset = XMFLOAT3(static_cast<float>(i * offsetAmount), static_cast<float>(j * offsetAmount), static_cast<float>(k * offsetAmount));
 
@@ -579,20 +652,54 @@ HRESULT GameState::spawnAsteroidsGrid(const size_t x, const size_t y, const size
 				bone = new Transformable(scale, offset, orientation);
 				parent = bone;
 				newObject->addTransformable(bone);
+				if( FAILED(bone->bindToSystem(m_transformSystem)) ) {
+					logMessage(L"Failed to bind asteroid Transformable to the TransformSystem.");
+					return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+				}
+
+				// Asteroids do not move, so their world transforms need only be computed once
+				if( FAILED(bone->bake()) ) {
+					logMessage(L"Failed to bake asteroid Transformable.");
+					return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+				}
+				bone->m_radius = m_asteroidRadius;
+				if( FAILED(m_spatialIndex->add(id, bone)) ) {
+					logMessage(L"Failed to add asteroid Transformable to the SpatialIndex.");
+					return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+				}
+				if( FAILED(m_broadphase->add(id, bone, GAMESTATE_COLLISION_ASTEROID,
+					SWEEPANDPRUNE_CATEGORY_ALL & ~GAMESTATE_COLLISION_ASTEROID)) ) {
+					logMessage(L"Failed to add asteroid Transformable to the collision broadphase.");
+					return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+				}
 
 				// South pole
 				bone = new Transformable(scale, southOffset, orientation);
 				bone->setParent(parent);
 				newObject->addTransformable(bone);
+				if( FAILED(bone->bindToSystem(m_transformSystem)) ) {
+					logMessage(L"Failed to bind asteroid Transformable to the TransformSystem.");
+					return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+				}
+
+				if( FAILED(bone->bake()) ) {
+					logMessage(L"Failed to bake asteroid Transformable.");
+					return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+				}
 
 				// North pole
 				bone = new Transformable(scale, northOffset, orientation);
 				bone->setParent(parent);
 				newObject->addTransformable(bone);
-
-
-				// Add the object to the list
-				m_objectList->emplace_back(newObject);
+				if( FAILED(bone->bindToSystem(m_transformSystem)) ) {
+					logMessage(L"Failed to bind asteroid Transformable to the TransformSystem.");
+					return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+				}
+
+				if( FAILED(bone->bake()) ) {
+					logMessage(L"Failed to bake asteroid Transformable.");
+					return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+				}
 			}
 		}
 	}
@@ -630,7 +737,7 @@ HRESULT GameState::spawnQuadRow(const float width, const float height, const XMF
 	XMVECTOR originVector = XMLoadFloat4(&origin);
 	XMVECTOR spacingVector = XMLoadFloat4(&spacing);
 
-	m_gridQuadParents = new Transformable*[GAMESTATE_GEOMETRY_N_QUAD];
+	m_gridQuadParents = new Transformable*[GAMESTATE_GEOMETRY_N_QUAD]();
 
 	for( size_t i = 0; i < GAMESTATE_GEOMETRY_N_QUAD; ++i ) {
 		if( GAMESTATE_GEOMETRY_N_QUAD > 1 ) {
@@ -675,7 +782,60 @@ HRESULT GameState::spawnQuadRow(const float width, const float height, const XMF
 		newObject->addTransformable(bone);
 
 		m_objectList->emplace_back(newObject);
+
+		// The quad's corners move relative to the quad, but the quad itself is fixed
+		if( FAILED(parent->bindToSystem(m_transformSystem)) || FAILED(parent->bake()) ) {
+			logMessage(L"Failed to bake the Transformable of the quad at index " + std::to_wstring(i) + L".");
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
 	}
 
 	return ERROR_SUCCESS;
-}
\ No newline at end of file
+}
+
+HRESULT GameState::scheduleTransformables(void) {
+	if( m_nTransformThreads != 1 ) {
+		try {
+			m_workerPool = new WorkerPool(m_nTransformThreads);
+		} catch( ... ) {
+			logMessage(L"Failed to create worker threads for updating Transformable objects.");
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_LIBRARY_CALL);
+		}
+	}
+	m_transformScheduler = new TransformScheduler(m_workerPool);
+
+	/* Baked objects are not updated per frame at all. (The scheduler treats
+	   parents which it does not update as being up to date.)
+	 */
+	vector<Transformable*> transformables;
+	for( size_t i = 0; i < GAMESTATE_GEOMETRY_N_QUAD; ++i ) {
+		if( !m_gridQuadParents[i]->isBaked() ) {
+			transformables.push_back(m_gridQuadParents[i]);
+		}
+	}
+	const vector<Transformable*>* objectTransformables = 0;
+	vector<Transformable*>::const_iterator it;
+	const vector<ObjectModel*>::size_type nObjects = m_objectList->size();
+	for( vector<ObjectModel*>::size_type i = 0; i < nObjects; ++i ) {
+		objectTransformables = (*m_objectList)[i]->getTransformables();
+		for( it = objectTransformables->cbegin(); it != objectTransformables->cend(); ++it ) {
+			if( !(*it)->isBaked() ) {
+				transformables.push_back(*it);
+			}
+		}
+	}
+
+	if( FAILED(m_transformScheduler->setTransformables(transformables)) ) {
+		logMessage(L"Failed to sort Transformable objects for updating.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+	return ERROR_SUCCESS;
+}
+
+SweepAndPrune* GameState::getBroadphase(void) {
+	return m_broadphase;
+}
+
+WorkerPool* GameState::getWorkerPool(void) {
+	return m_workerPool;
+}
@@ -40,11 +40,15 @@ using std::vector;
 
 GameStateWithParticles::GameStateWithParticles(const bool configureNow) :
 GameState(false),
-m_explosionModel(0), m_explosions(0),
-m_jetModel(0), m_jets(0),
-m_laserModel(0), m_lasers(0),
-m_ballModel(0), m_balls(0),
-m_identity(0),
+m_explosionModel(0), m_explosions(0), m_explosionIndex(),
+m_jetModel(0), m_jets(0), m_jetIndex(),
+m_laserModel(0), m_lasers(0), m_laserIndex(),
+m_freeSplineBuffers(), m_nSplineBuffers(0),
+m_ballModel(0), m_balls(0), m_ballIndex(), m_ballEndpointIndex(),
+m_poolSize(GAMESTATEWITHPARTICLES_POOLSIZE_DEFAULT), m_ballColliders(),
+m_instancedParticles(GAMESTATEWITHPARTICLES_INSTANCED_DEFAULT),
+m_particleBatcher(0), m_particleBackend(0),
+m_identity(0), m_laserKnots(0),
 m_explosionLifespan(GAMESTATEWITHPARTICLES_EXPLOSION_LIFE_DEFAULT),
 m_jetLifespan(GAMESTATEWITHPARTICLES_JET_LIFE_DEFAULT),
 m_laserLifespan(GAMESTATEWITHPARTICLES_LASER_LIFE_DEFAULT),
@@ -61,6 +65,7 @@ m_ballThresholdDistance(GAMESTATEWITHPARTICLES_BALL_THRESHOLDDISTANCE_DEFAULT),
 m_ballSplineParameterSpeed(GAMESTATEWITHPARTICLES_BALL_SPEEDT_DEFAULT),
 m_ballSplineParameterOffset(GAMESTATEWITHPARTICLES_BALL_OFFSETT_DEFAULT),
 m_ballLoopOverSpline(GAMESTATEWITHPARTICLES_BALL_LOOP_DEFAULT),
+m_ballConstantSpeed(GAMESTATEWITHPARTICLES_BALL_CONSTANTSPEED_DEFAULT),
 m_currentTime(0), m_demo_enabled(GAMESTATEWITHPARTICLES_DEMO_DEFAULT),
 m_demo_nExplosions(GAMESTATEWITHPARTICLES_DEMO_NEXPLOSIONS_DEFAULT),
 m_demo_zoneRadius(GAMESTATEWITHPARTICLES_DEMO_SHOWAREA_DEFAULT),
@@ -73,30 +78,20 @@ m_demoStartLaser(0), m_demoEndLaser(0), m_demoStartBall(0), m_demoEndBall(0)
 	}
 
 	m_identity = new Transformable(XMFLOAT3(1.0f, 1.0f, 1.0f), XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f));
+	m_laserKnots = new WanderingLineSystem();
 }
 
 GameStateWithParticles::~GameStateWithParticles(void) {
-	ActiveParticles<UniformBurstSphere>* activeExplosion = 0;
-	ActiveParticles<RandomBurstCone>* activeJet = 0;
-	ActiveSplineParticles<UniformRandomSplineModel>* activeLaser = 0;
-	ActiveParticles<GAMESTATEWITHPARTICLES_BALL_MODELCLASS>* activeBall = 0;
-
 	if( m_explosionModel != 0 ) {
 		delete m_explosionModel;
 		m_explosionModel = 0;
 	}
 
 	if( m_explosions != 0 ) {
-		const vector<ActiveParticles<UniformBurstSphere>*>::size_type nExplosions = m_explosions->size();
-		for( vector<ActiveParticles<UniformBurstSphere>*>::size_type i = 0; i < nExplosions; ++i ) {
-			activeExplosion = (*m_explosions)[i];
-			if( activeExplosion != 0 ) {
-				if( m_demo_enabled ) {
-					delete activeExplosion->getTransform();
-				}
-				delete activeExplosion;
-				activeExplosion = 0;
-				(*m_explosions)[i] = 0;
+		if( m_demo_enabled ) {
+			const size_t nExplosions = m_explosions->size();
+			for( size_t i = 0; i < nExplosions; ++i ) {
+				delete (*m_explosions)[i].getTransform();
 			}
 		}
 		delete m_explosions;
@@ -109,16 +104,10 @@ GameStateWithParticles::~GameStateWithParticles(void) {
 	}
 
 	if( m_jets != 0 ) {
-		const vector<ActiveParticles<RandomBurstCone>*>::size_type nJets = m_jets->size();
-		for( vector<ActiveParticles<RandomBurstCone>*>::size_type i = 0; i < nJets; ++i ) {
-			activeJet = (*m_jets)[i];
-			if( activeJet != 0 ) {
-				if( m_demo_enabled ) {
-					delete activeJet->getTransform();
-				}
-				delete activeJet;
-				activeJet = 0;
-				(*m_jets)[i] = 0;
+		if( m_demo_enabled ) {
+			const size_t nJets = m_jets->size();
+			for( size_t i = 0; i < nJets; ++i ) {
+				delete (*m_jets)[i].getTransform();
 			}
 		}
 		delete m_jets;
@@ -131,19 +120,21 @@ GameStateWithParticles::~GameStateWithParticles(void) {
 	}
 
 	if( m_lasers != 0 ) {
-		const vector<ActiveSplineParticles<UniformRandomSplineModel>*>::size_type nLasers = m_lasers->size();
-		for( vector<ActiveSplineParticles<UniformRandomSplineModel>*>::size_type i = 0; i < nLasers; ++i ) {
-			activeLaser = (*m_lasers)[i];
-			if( activeLaser != 0 ) {
-				delete activeLaser;
-				activeLaser = 0;
-				(*m_lasers)[i] = 0;
-			}
-		}
 		delete m_lasers;
 		m_lasers = 0;
 	}
 
+	// Lasers return their spline control point buffers when destroyed
+	for( size_t i = 0; i < m_freeSplineBuffers.size(); ++i ) {
+		delete m_freeSplineBuffers[i];
+		m_freeSplineBuffers[i] = 0;
+	}
+
+	if( m_laserKnots != 0 ) {
+		delete m_laserKnots;
+		m_laserKnots = 0;
+	}
+
 	if( m_laserTransformParameters != 0 ) {
 		delete m_laserTransformParameters;
 		m_laserTransformParameters = 0;
@@ -155,15 +146,9 @@ GameStateWithParticles::~GameStateWithParticles(void) {
 	}
 
 	if( m_balls != 0 ) {
-		const vector<ActiveParticles<GAMESTATEWITHPARTICLES_BALL_MODELCLASS>*>::size_type nBalls = m_balls->size();
-		for( vector<ActiveParticles<GAMESTATEWITHPARTICLES_BALL_MODELCLASS>*>::size_type i = 0; i < nBalls; ++i ) {
-			activeBall = (*m_balls)[i];
-			if( activeBall != 0 ) {
-				delete activeBall->getTransform();
-				delete activeBall;
-				activeBall = 0;
-				(*m_balls)[i] = 0;
-			}
+		const size_t nBalls = m_balls->size();
+		for( size_t i = 0; i < nBalls; ++i ) {
+			delete (*m_balls)[i].getTransform();
 		}
 		delete m_balls;
 		m_balls = 0;
@@ -174,6 +159,16 @@ GameStateWithParticles::~GameStateWithParticles(void) {
 		m_ballTransformParameters = 0;
 	}
 
+	if( m_particleBatcher != 0 ) {
+		delete m_particleBatcher;
+		m_particleBatcher = 0;
+	}
+
+	if( m_particleBackend != 0 ) {
+		delete m_particleBackend;
+		m_particleBackend = 0;
+	}
+
 	if (m_identity != 0) {
 		delete m_identity;
 		m_identity = 0;
@@ -226,10 +221,26 @@ HRESULT GameStateWithParticles::drawContents(ID3D11DeviceContext* const context,
 		return result;
 	}
 
+	/* Draw explosions, jets and ball lightning effects together, if possible.
+	   If instanced drawing fails after it has started, some systems
+	   may already have been drawn, so the systems are not drawn again
+	   individually until the next frame.
+	 */
+	bool instancedDrawingStarted = false;
+	if( m_instancedParticles ) {
+		result = drawInstancedParticles(context, manager, instancedDrawingStarted);
+		if( FAILED(result) ) {
+			logMessage(L"Failed to render particle systems with instancing. Instancing will be disabled.");
+			m_instancedParticles = false;
+			result = ERROR_SUCCESS;
+		}
+	}
+	const bool skipSystems = m_instancedParticles || instancedDrawingStarted;
+
 	// Draw all explosions
-	const vector<ActiveParticles<UniformBurstSphere>*>::size_type nExplosions = m_explosions->size();
-	for( vector<ActiveParticles<UniformBurstSphere>*>::size_type i = 0; i < nExplosions; ++i ) {
-		result = (*m_explosions)[i]->drawUsingAppropriateRenderer(context, manager, m_camera);
+	const size_t nExplosions = (skipSystems) ? 0 : m_explosions->size();
+	for( size_t i = 0; i < nExplosions; ++i ) {
+		result = (*m_explosions)[i].drawUsingAppropriateRenderer(context, manager, m_camera);
 		if( FAILED(result) ) {
 			logMessage(L"Failed to render explosion particle system at index = " + std::to_wstring(i) + L".");
 			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
@@ -237,9 +248,9 @@ HRESULT GameStateWithParticles::drawContents(ID3D11DeviceContext* const context,
 	}
 
 	// Draw all jets
-	const vector<ActiveParticles<RandomBurstCone>*>::size_type nJets = m_jets->size();
-	for( vector<ActiveParticles<RandomBurstCone>*>::size_type i = 0; i < nJets; ++i ) {
-		result = (*m_jets)[i]->drawUsingAppropriateRenderer(context, manager, m_camera);
+	const size_t nJets = (skipSystems) ? 0 : m_jets->size();
+	for( size_t i = 0; i < nJets; ++i ) {
+		result = (*m_jets)[i].drawUsingAppropriateRenderer(context, manager, m_camera);
 		if( FAILED(result) ) {
 			logMessage(L"Failed to render jet particle system at index = " + std::to_wstring(i) + L".");
 			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
@@ -247,9 +258,9 @@ HRESULT GameStateWithParticles::drawContents(ID3D11DeviceContext* const context,
 	}
 
 	// Draw all lasers
-	const vector<ActiveSplineParticles<UniformRandomSplineModel>*>::size_type nLasers = m_lasers->size();
-	for( vector<ActiveSplineParticles<UniformRandomSplineModel>*>::size_type i = 0; i < nLasers; ++i ) {
-		result = (*m_lasers)[i]->drawUsingAppropriateRenderer(context, manager, m_camera);
+	const size_t nLasers = m_lasers->size();
+	for( size_t i = 0; i < nLasers; ++i ) {
+		result = (*m_lasers)[i].drawUsingAppropriateRenderer(context, manager, m_camera);
 		if( FAILED(result) ) {
 			logMessage(L"Failed to render laser particle system at index = " + std::to_wstring(i) + L".");
 			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
@@ -257,9 +268,9 @@ HRESULT GameStateWithParticles::drawContents(ID3D11DeviceContext* const context,
 	}
 
 	// Draw all balls
-	const vector<ActiveParticles<GAMESTATEWITHPARTICLES_BALL_MODELCLASS>*>::size_type nBalls = m_balls->size();
-	for( vector<ActiveParticles<GAMESTATEWITHPARTICLES_BALL_MODELCLASS>*>::size_type i = 0; i < nBalls; ++i ) {
-		result = (*m_balls)[i]->drawUsingAppropriateRenderer(context, manager, m_camera);
+	const size_t nBalls = (skipSystems) ? 0 : m_balls->size();
+	for( size_t i = 0; i < nBalls; ++i ) {
+		result = (*m_balls)[i].drawUsingAppropriateRenderer(context, manager, m_camera);
 		if( FAILED(result) ) {
 			logMessage(L"Failed to render ball particle system at index = " + std::to_wstring(i) + L".");
 			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
@@ -283,107 +294,107 @@ HRESULT GameStateWithParticles::update(const DWORD currentTime, const DWORD upda
 
 	// Update all explosions
 	bool isExpired = false;
-	vector<ActiveParticles<UniformBurstSphere>*>::size_type nExplosions = m_explosions->size();
+	Transformable* transform = 0;
+	size_t nExplosions = m_explosions->size();
 	if( nExplosions > 0 ) {
-		for( vector<ActiveParticles<UniformBurstSphere>*>::size_type i = nExplosions - 1; (i >= 0) && (i < nExplosions); --i ) {
-			result = (*m_explosions)[i]->update(currentTime, updateTimeInterval, isExpired, m_demo_enabled);
+		for( size_t i = nExplosions - 1; (i >= 0) && (i < nExplosions); --i ) {
+			result = (*m_explosions)[i].update(currentTime, updateTimeInterval, isExpired, m_demo_enabled);
 			if( FAILED(result) ) {
 				logMessage(L"Failed to update explosion particle system at index = " + std::to_wstring(i) + L".");
 				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 			} else if( isExpired ) {
-				result = removeExplosion((*m_explosions)[i]->getTransform());
-				if( FAILED(result) ) {
-					logMessage(L"Failed to remove expired explosion particle system at index = " + std::to_wstring(i) + L".");
-					return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-				} else {
-					nExplosions = m_explosions->size();
-					if( i >= nExplosions ) {
-						/* This may result in multiple update() calls to the same
-						   explosion, but it is assumed that this does not matter.
-						   */
-						i = nExplosions - 1;
-					}
+				/* Remove only the expired explosion, as other explosions
+				   with the same transformation may have been spawned later.
+				   Removing several explosions could also move explosions which
+				   have not been updated yet to indices above 'i', where they would be skipped.
+				 */
+				transform = (*m_explosions)[i].getTransform();
+				eraseSystem(*m_explosions, m_explosionIndex, transform, m_explosions->getHandle(i));
+				nExplosions = m_explosions->size();
+
+				// If in demo mode, assume ownership of the transformation once it is unused
+				if( m_demo_enabled && m_explosionIndex.count(transform) == 0 ) {
+					delete transform;
 				}
 			}
 		}
 	}
 
 	// Update all jets
-	vector<ActiveParticles<RandomBurstCone>*>::size_type nJets = m_jets->size();
+	size_t nJets = m_jets->size();
 	if( nJets > 0 ) {
-		for( vector<ActiveParticles<RandomBurstCone>*>::size_type i = nJets - 1; (i >= 0) && (i < nJets); --i ) {
-			result = (*m_jets)[i]->update(currentTime, updateTimeInterval, isExpired, m_demo_enabled);
+		for( size_t i = nJets - 1; (i >= 0) && (i < nJets); --i ) {
+			result = (*m_jets)[i].update(currentTime, updateTimeInterval, isExpired, m_demo_enabled);
 			if( FAILED(result) ) {
 				logMessage(L"Failed to update jet particle system at index = " + std::to_wstring(i) + L".");
 				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 			} else if( isExpired ) {
-				result = removeJet((*m_jets)[i]->getTransform());
-				if( FAILED(result) ) {
-					logMessage(L"Failed to remove expired jet particle system at index = " + std::to_wstring(i) + L".");
-					return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-				} else {
-					nJets = m_jets->size();
-					if( i >= nJets ) {
-						/* This may result in multiple update() calls to the same
-						jet, but it is assumed that this does not matter.
-						*/
-						i = nJets - 1;
-					}
+				/* Remove only the expired jet, as other jets
+				   with the same transformation may have been spawned later.
+				   Removing several jets could also move jets which
+				   have not been updated yet to indices above 'i', where they would be skipped.
+				 */
+				transform = (*m_jets)[i].getTransform();
+				eraseSystem(*m_jets, m_jetIndex, transform, m_jets->getHandle(i));
+				nJets = m_jets->size();
+
+				// If in demo mode, assume ownership of the transformation once it is unused
+				if( m_demo_enabled && m_jetIndex.count(transform) == 0 ) {
+					delete transform;
 				}
 			}
 		}
 	}
 
 	// Update all lasers
-	vector<ActiveSplineParticles<UniformRandomSplineModel>*>::size_type nLasers = m_lasers->size();
+	Transformable* laserStart = 0;
+	Transformable* laserEnd = 0;
+	size_t nLasers = m_lasers->size();
 	if( nLasers > 0 ) {
-		for( vector<ActiveSplineParticles<UniformRandomSplineModel>*>::size_type i = nLasers - 1; (i >= 0) && (i < nLasers); --i ) {
-			result = (*m_lasers)[i]->update(currentTime, updateTimeInterval, isExpired, m_demo_enabled);
+		for( size_t i = nLasers - 1; (i >= 0) && (i < nLasers); --i ) {
+			result = (*m_lasers)[i].update(currentTime, updateTimeInterval, isExpired, m_demo_enabled);
 			if( FAILED(result) ) {
 				logMessage(L"Failed to update laser particle system at index = " + std::to_wstring(i) + L".");
 				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 			} else if( isExpired ) {
-				result = removeLaser((*m_lasers)[i]->getTransform());
-				if( FAILED(result) ) {
-					logMessage(L"Failed to remove expired laser particle system at index = " + std::to_wstring(i) + L".");
-					return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-				} else {
-					nLasers = m_lasers->size();
-					if( i >= nLasers ) {
-						/* This may result in multiple update() calls to the same
-						   laser, but it is assumed that this does not matter.
-						 */
-						i = nLasers - 1;
-					}
-				}
+				/* Remove only the expired laser, as other lasers
+				   with the same start transformation may have been spawned later
+				 */
+				static_cast<GAMESTATEWITHPARTICLES_LASER_SPLINE_CLASS*>((*m_lasers)[i].getSpline())->getEndpoints(
+					laserStart,
+					laserEnd);
+				eraseSystem(*m_lasers, m_laserIndex, laserStart, m_lasers->getHandle(i));
+				nLasers = m_lasers->size();
 			}
 		}
 	}
 
+	// Update the knots of all lasers, after the lasers have copied them
+	result = m_laserKnots->update(updateTimeInterval);
+	if( FAILED(result) ) {
+		logMessage(L"Failed to update laser spline knots.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+
 	// Update all ball lightning effects
 	HomingTransformable* ballTransform = 0;
-	vector<ActiveParticles<GAMESTATEWITHPARTICLES_BALL_MODELCLASS>*>::size_type nBalls = m_balls->size();
+	size_t nBalls = m_balls->size();
 	if( nBalls > 0 ) {
-		for( vector<ActiveParticles<GAMESTATEWITHPARTICLES_BALL_MODELCLASS>*>::size_type i = nBalls - 1; (i >= 0) && (i < nBalls); --i ) {
-			result = (*m_balls)[i]->update(currentTime, updateTimeInterval, isExpired, true);
+		for( size_t i = nBalls - 1; (i >= 0) && (i < nBalls); --i ) {
+			result = (*m_balls)[i].update(currentTime, updateTimeInterval, isExpired, true);
 			if( FAILED(result) ) {
 				logMessage(L"Failed to update ball particle system at index = " + std::to_wstring(i) + L".");
 				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 			} else {
-				ballTransform = static_cast<HomingTransformable*>((*m_balls)[i]->getTransform());
+				ballTransform = static_cast<HomingTransformable*>((*m_balls)[i].getTransform());
 				if( isExpired || ballTransform->isAtEnd() ) {
 					result = removeBall(ballTransform);
 					if( FAILED(result) ) {
 						logMessage(L"Failed to remove expired ball particle system at index = " + std::to_wstring(i) + L".");
 						return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 					} else {
+						// The last ball, which has been updated, now occupies index 'i'
 						nBalls = m_balls->size();
-						if( i >= nBalls ) {
-							/* This may result in multiple update() calls to the same
-							   ball, but it is assumed that this does not matter.
-							 */
-							i = nBalls - 1;
-						}
 					}
 				}
 			}
@@ -403,12 +414,11 @@ HRESULT GameStateWithParticles::spawnExplosion(Transformable* const transform) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
 	}
 
-	ActiveParticles<UniformBurstSphere>* newExplosion = 0;
-	newExplosion = new ActiveParticles<UniformBurstSphere>(
+	SlotMapHandle handle;
+	m_explosions->emplace(handle,
 		m_explosionModel, transform, m_explosionLifespan, m_currentTime,
 		XMFLOAT3(1.0f, 1.0f, 1.0f));
-
-	m_explosions->emplace_back(newExplosion);
+	m_explosionIndex.insert(std::make_pair(transform, handle));
 
 	return ERROR_SUCCESS;
 }
@@ -419,12 +429,11 @@ HRESULT GameStateWithParticles::spawnJet(Transformable* const transform) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
 	}
 
-	ActiveParticles<RandomBurstCone>* newJet = 0;
-	newJet = new ActiveParticles<RandomBurstCone>(
+	SlotMapHandle handle;
+	m_jets->emplace(handle,
 		m_jetModel, transform, m_jetLifespan, m_currentTime,
 		XMFLOAT3(1.0f, 1.0f, 1.0f));
-
-	m_jets->emplace_back(newJet);
+	m_jetIndex.insert(std::make_pair(transform, handle));
 
 	return ERROR_SUCCESS;
 }
@@ -436,7 +445,8 @@ HRESULT GameStateWithParticles::spawnLaser(Transformable* const start, Transform
 	}
 
 	Spline* newSpline = 0;
-	ActiveSplineParticles<UniformRandomSplineModel>* newLaser = 0;
+	SplineBuffer* splineBuffer = 0;
+	SlotMapHandle handle;
 
 	for( size_t i = 0; i < m_nSplinesPerLaser; ++i ) {
 		newSpline = new GAMESTATEWITHPARTICLES_LASER_SPLINE_CLASS(
@@ -444,12 +454,26 @@ HRESULT GameStateWithParticles::spawnLaser(Transformable* const start, Transform
 			m_laserControlPointSpeed,
 			start,
 			end,
-			*m_laserTransformParameters);
-		newLaser = new ActiveSplineParticles<UniformRandomSplineModel>(
-			m_laserModel, m_identity, newSpline, m_laserLifespan, m_currentTime,
-			XMFLOAT3(1.0f, 1.0f, 1.0f));
+			*m_laserTransformParameters,
+			m_laserKnots);
+
+		/* Reuse the control point buffer of a removed laser, if possible.
+		   Its Direct3D objects are created when the laser is first drawn.
+		 */
+		if( m_freeSplineBuffers.empty() ) {
+			splineBuffer = new SplineBuffer(newSpline->getNumberOfSegmentSlots());
+			++m_nSplineBuffers;
+			m_freeSplineBuffers.reserve(m_nSplineBuffers);
+		} else {
+			splineBuffer = m_freeSplineBuffers.back();
+			m_freeSplineBuffers.pop_back();
+		}
 
-		m_lasers->emplace_back(newLaser);
+		m_lasers->emplace(handle,
+			m_laserModel, m_identity, newSpline, splineBuffer, &m_freeSplineBuffers,
+			m_laserLifespan, m_currentTime,
+			XMFLOAT3(1.0f, 1.0f, 1.0f));
+		m_laserIndex.insert(std::make_pair(start, handle));
 	}
 
 	return ERROR_SUCCESS;
@@ -472,14 +496,26 @@ HRESULT GameStateWithParticles::spawnBall(Transformable* const start, Transforma
 		m_ballSplineParameterSpeed,
 		m_ballSplineParameterOffset,
 		m_ballLoopOverSpline,
-		m_currentTime);
+		m_currentTime,
+		m_ballConstantSpeed);
 
-	ActiveParticles<GAMESTATEWITHPARTICLES_BALL_MODELCLASS>* newBall = 0;
-	newBall = new ActiveParticles<GAMESTATEWITHPARTICLES_BALL_MODELCLASS>(
+	SlotMapHandle handle;
+	m_balls->emplace(handle,
 		m_ballModel, tempHandle, m_ballLifespan, m_currentTime,
 		XMFLOAT3(1.0f, 1.0f, 1.0f));
-
-	m_balls->emplace_back(newBall);
+	m_ballIndex.insert(std::make_pair(tempHandle, handle));
+	m_ballEndpointIndex.insert(std::make_pair(end, handle));
+
+	SweepAndPrune* broadphase = getBroadphase();
+	if( broadphase != 0 ) {
+		size_t id = 0;
+		tempHandle->m_radius = GAMESTATEWITHPARTICLES_BALL_COLLISION_RADIUS;
+		if( FAILED(broadphase->add(id, tempHandle, GAMESTATE_COLLISION_PROJECTILE)) ) {
+			logMessage(L"Failed to add ball lightning effect to the collision broadphase.");
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+		m_ballColliders[tempHandle] = id;
+	}
 
 	if( ballHandle != 0 ) {
 		*ballHandle = tempHandle;
@@ -488,16 +524,7 @@ HRESULT GameStateWithParticles::spawnBall(Transformable* const start, Transforma
 }
 
 HRESULT GameStateWithParticles::removeExplosion(Transformable* const transform) {
-	vector<ActiveParticles<UniformBurstSphere>*>::iterator it = m_explosions->begin();
-
-	while( it != m_explosions->end() ) {
-		if( (*it)->getTransform() == transform ) {
-			delete *it;
-			it = m_explosions->erase(it);
-		} else {
-			++it;
-		}
-	}
+	eraseSystems(*m_explosions, m_explosionIndex, transform);
 
 	// If in demo mode, assume ownership of transformable
 	if( m_demo_enabled ) {
@@ -507,16 +534,7 @@ HRESULT GameStateWithParticles::removeExplosion(Transformable* const transform)
 }
 
 HRESULT GameStateWithParticles::removeJet(Transformable* const transform) {
-	vector<ActiveParticles<RandomBurstCone>*>::iterator it = m_jets->begin();
-
-	while( it != m_jets->end() ) {
-		if( (*it)->getTransform() == transform ) {
-			delete *it;
-			it = m_jets->erase(it);
-		} else {
-			++it;
-		}
-	}
+	eraseSystems(*m_jets, m_jetIndex, transform);
 
 	// If in demo mode, assume ownership of transformable
 	if( m_demo_enabled ) {
@@ -526,47 +544,29 @@ HRESULT GameStateWithParticles::removeJet(Transformable* const transform) {
 }
 
 HRESULT GameStateWithParticles::removeLaser(Transformable* const startTransform) {
-	vector<ActiveSplineParticles<UniformRandomSplineModel>*>::iterator it = m_lasers->begin();
-	Transformable* start = 0;
-	Transformable* end = 0;
-
-	while( it != m_lasers->end() ) {
-		static_cast<GAMESTATEWITHPARTICLES_LASER_SPLINE_CLASS*>((*it)->getSpline())->getEndpoints(
-			start,
-			end);
-		if (start == startTransform) {
-			delete *it;
-			it = m_lasers->erase(it);
-		} else {
-			++it;
-		}
-	}
-
+	eraseSystems(*m_lasers, m_laserIndex, startTransform);
 	return ERROR_SUCCESS;
 }
 
 HRESULT GameStateWithParticles::removeBall(HomingTransformable*& transform) {
-	vector<ActiveParticles<GAMESTATEWITHPARTICLES_BALL_MODELCLASS>*>::iterator it = m_balls->begin();
-
-	HRESULT result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_DATA_NOT_FOUND);
-	bool found = false;
-	while( it != m_balls->end() ) {
-		if( (*it)->getTransform() == transform ) {
-			if( found ) {
-				logMessage(L"Found multiple ball lightning effects with the same HomingTransformable pointer.");
-				result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
-			} else {
-				found = true;
-				result = ERROR_SUCCESS;
-			}
-			delete *it;
-			it = m_balls->erase(it);
-		} else {
-			++it;
+	const std::pair<ParticleSystemIndex::iterator, ParticleSystemIndex::iterator> range = m_ballIndex.equal_range(transform);
+	if( range.first == range.second ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_DATA_NOT_FOUND);
+	}
+
+	HRESULT result = ERROR_SUCCESS;
+	for( ParticleSystemIndex::iterator it = range.first; it != range.second; ++it ) {
+		if( it != range.first ) {
+			logMessage(L"Found multiple ball lightning effects with the same HomingTransformable pointer.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
 		}
+		eraseIndexEntry(m_ballEndpointIndex, transform->getEnd(), it->second);
+		m_balls->remove(it->second);
 	}
+	m_ballIndex.erase(range.first, range.second);
 
 	if( SUCCEEDED(result) ) {
+		removeBallCollider(transform);
 		delete transform;
 		transform = 0;
 	}
@@ -574,24 +574,55 @@ HRESULT GameStateWithParticles::removeBall(HomingTransformable*& transform) {
 }
 
 HRESULT GameStateWithParticles::removeBallsByEndpoint(Transformable* const transform) {
-	vector<ActiveParticles<GAMESTATEWITHPARTICLES_BALL_MODELCLASS>*>::iterator it = m_balls->begin();
+	const std::pair<ParticleSystemIndex::iterator, ParticleSystemIndex::iterator> range = m_ballEndpointIndex.equal_range(transform);
+	ActiveParticles<GAMESTATEWITHPARTICLES_BALL_MODELCLASS>* ball = 0;
 	HomingTransformable* ballTransform = 0;
 
-	while( it != m_balls->end() ) {
-		ballTransform = static_cast<HomingTransformable*>((*it)->getTransform());
-		if( ballTransform->getEnd() == transform ) {
+	for( ParticleSystemIndex::iterator it = range.first; it != range.second; ++it ) {
+		ball = m_balls->get(it->second);
+		if( ball != 0 ) {
+			ballTransform = static_cast<HomingTransformable*>(ball->getTransform());
+			eraseIndexEntry(m_ballIndex, ballTransform, it->second);
+			m_balls->remove(it->second);
+			removeBallCollider(ballTransform);
 			delete ballTransform;
 			ballTransform = 0;
-			delete *it;
-			it = m_balls->erase(it);
-		} else {
-			++it;
 		}
 	}
+	m_ballEndpointIndex.erase(range.first, range.second);
 
 	return ERROR_SUCCESS;
 }
 
+template <typename T> void GameStateWithParticles::eraseSystem(SlotMap<T>& systems, ParticleSystemIndex& index,
+	const Transformable* const key, const SlotMapHandle& handle) {
+	eraseIndexEntry(index, key, handle);
+	systems.remove(handle);
+}
+
+template <typename T> size_t GameStateWithParticles::eraseSystems(SlotMap<T>& systems, ParticleSystemIndex& index,
+	const Transformable* const key) {
+	const std::pair<ParticleSystemIndex::iterator, ParticleSystemIndex::iterator> range = index.equal_range(key);
+	size_t nRemoved = 0;
+	for( ParticleSystemIndex::iterator it = range.first; it != range.second; ++it ) {
+		if( SUCCEEDED(systems.remove(it->second)) ) {
+			++nRemoved;
+		}
+	}
+	index.erase(range.first, range.second);
+	return nRemoved;
+}
+
+void GameStateWithParticles::eraseIndexEntry(ParticleSystemIndex& index, const Transformable* const key, const SlotMapHandle& handle) {
+	const std::pair<ParticleSystemIndex::iterator, ParticleSystemIndex::iterator> range = index.equal_range(key);
+	for( ParticleSystemIndex::iterator it = range.first; it != range.second; ++it ) {
+		if( it->second == handle ) {
+			index.erase(it);
+			return;
+		}
+	}
+}
+
 HRESULT GameStateWithParticles::configure(void) {
 	HRESULT result = ERROR_SUCCESS;
 
@@ -633,6 +664,10 @@ HRESULT GameStateWithParticles::configure(void) {
 	m_ballSplineParameterSpeed = GAMESTATEWITHPARTICLES_BALL_SPEEDT_DEFAULT;
 	m_ballSplineParameterOffset = GAMESTATEWITHPARTICLES_BALL_OFFSETT_DEFAULT;
 	m_ballLoopOverSpline = GAMESTATEWITHPARTICLES_BALL_LOOP_DEFAULT;
+	m_ballConstantSpeed = GAMESTATEWITHPARTICLES_BALL_CONSTANTSPEED_DEFAULT;
+
+	m_instancedParticles = GAMESTATEWITHPARTICLES_INSTANCED_DEFAULT;
+	m_poolSize = GAMESTATEWITHPARTICLES_POOLSIZE_DEFAULT;
 
 	m_demo_enabled = GAMESTATEWITHPARTICLES_DEMO_DEFAULT;
 	m_demo_nExplosions = GAMESTATEWITHPARTICLES_DEMO_NEXPLOSIONS_DEFAULT;
@@ -801,6 +836,23 @@ HRESULT GameStateWithParticles::configure(void) {
 				m_ballLoopOverSpline = *boolValue;
 			}
 
+			if( retrieve<Config::DataType::BOOL, bool>(GAMESTATEWITHPARTICLES_SCOPE, GAMESTATEWITHPARTICLES_BALL_CONSTANTSPEED_FIELD, boolValue) ) {
+				m_ballConstantSpeed = *boolValue;
+			}
+
+			if( retrieve<Config::DataType::BOOL, bool>(GAMESTATEWITHPARTICLES_SCOPE, GAMESTATEWITHPARTICLES_INSTANCED_FIELD, boolValue) ) {
+				m_instancedParticles = *boolValue;
+			}
+
+			if( retrieve<Config::DataType::INT, int>(GAMESTATEWITHPARTICLES_SCOPE, GAMESTATEWITHPARTICLES_POOLSIZE_FIELD, intValue) ) {
+				if( *intValue < GAMESTATEWITHPARTICLES_POOLSIZE_MIN ) {
+					logMessage(L"The particle system pool size retrieved from configuration data is too low. Using the default value of "
+						+ std::to_wstring(GAMESTATEWITHPARTICLES_POOLSIZE_DEFAULT) + L".");
+				} else {
+					m_poolSize = static_cast<size_t>(*intValue);
+				}
+			}
+
 			if( retrieve<Config::DataType::BOOL, bool>(GAMESTATEWITHPARTICLES_SCOPE, GAMESTATEWITHPARTICLES_DEMO_FIELD, boolValue) ) {
 				m_demo_enabled = *boolValue;
 			}
@@ -939,19 +991,25 @@ HRESULT GameStateWithParticles::configureParticles(void) {
 }
 
 HRESULT GameStateWithParticles::initializeParticles(ID3D11Device* device) {
+	// Generate particle vertices using the Transformable update threads, which are idle at this point
+	m_explosionModel->setWorkerPool(getWorkerPool());
+	m_jetModel->setWorkerPool(getWorkerPool());
+
 	if( FAILED(m_explosionModel->initialize(device, 0)) ) {
 		logMessage(L"Failed to initialize the explosion particle system.");
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
-	m_explosions = new vector<ActiveParticles<UniformBurstSphere>*>();
+	m_explosions = new SlotMap<ActiveParticles<UniformBurstSphere> >(m_poolSize);
+	m_explosions->reserve(m_poolSize);
 
 	if( FAILED(m_jetModel->initialize(device, 0)) ) {
 		logMessage(L"Failed to initialize the jet particle system.");
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
-	m_jets = new vector<ActiveParticles<RandomBurstCone>*>();
+	m_jets = new SlotMap<ActiveParticles<RandomBurstCone> >(m_poolSize);
+	m_jets->reserve(m_poolSize);
 
 	/* It is critical that the capacity of this spline
 	   is the same as the capacity of all splines which
@@ -963,14 +1021,63 @@ HRESULT GameStateWithParticles::initializeParticles(ID3D11Device* device) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
-	m_lasers = new vector<ActiveSplineParticles<UniformRandomSplineModel>*>();
+	m_lasers = new SlotMap<ActiveSplineParticles<UniformRandomSplineModel> >(m_poolSize);
+	m_lasers->reserve(m_poolSize);
 
 	if( FAILED(m_ballModel->initialize(device, 0)) ) {
 		logMessage(L"Failed to initialize the ball lightning particle system.");
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
-	m_balls = new vector<ActiveParticles<GAMESTATEWITHPARTICLES_BALL_MODELCLASS>*>();
+	m_balls = new SlotMap<ActiveParticles<GAMESTATEWITHPARTICLES_BALL_MODELCLASS> >(m_poolSize);
+	m_balls->reserve(m_poolSize);
+
+	// Models are added in the order of their GAMESTATEWITHPARTICLES_MODEL_* indices
+	m_particleBackend = new D3D11ParticleDrawBackend();
+	m_particleBackend->addModel(m_explosionModel);
+	m_particleBackend->addModel(m_jetModel);
+	m_particleBackend->addModel(m_ballModel);
+	m_particleBatcher = new ParticleInstanceBatcher(GAMESTATEWITHPARTICLES_NMODELS);
+
+	return ERROR_SUCCESS;
+}
+
+HRESULT GameStateWithParticles::drawInstancedParticles(ID3D11DeviceContext* const context, GeometryRendererManager& manager, bool& drawingStarted) {
+	drawingStarted = false;
+	if( m_particleBatcher == 0 || m_particleBackend == 0 ) {
+		logMessage(L"Cannot render particle systems with instancing before initialization.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+
+	HRESULT result = ERROR_SUCCESS;
+
+	const size_t nExplosions = m_explosions->size();
+	for( size_t i = 0; (i < nExplosions) && SUCCEEDED(result); ++i ) {
+		result = (*m_explosions)[i].addToBatch(*m_particleBatcher, GAMESTATEWITHPARTICLES_MODEL_EXPLOSION);
+	}
+
+	const size_t nJets = m_jets->size();
+	for( size_t i = 0; (i < nJets) && SUCCEEDED(result); ++i ) {
+		result = (*m_jets)[i].addToBatch(*m_particleBatcher, GAMESTATEWITHPARTICLES_MODEL_JET);
+	}
+
+	const size_t nBalls = m_balls->size();
+	for( size_t i = 0; (i < nBalls) && SUCCEEDED(result); ++i ) {
+		result = (*m_balls)[i].addToBatch(*m_particleBatcher, GAMESTATEWITHPARTICLES_MODEL_BALL);
+	}
+
+	if( FAILED(result) ) {
+		logMessage(L"Failed to queue particle systems for instanced rendering.");
+		m_particleBatcher->clear();
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+
+	m_particleBackend->setContext(context, &manager, m_camera);
+	drawingStarted = true;
+	if( FAILED(m_particleBatcher->flush(*m_particleBackend)) ) {
+		logMessage(L"Failed to render particle systems with instancing.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
 
 	return ERROR_SUCCESS;
 }
@@ -982,6 +1089,7 @@ HRESULT GameStateWithParticles::updateDemo(void) {
 	float theta, phi, radius; // Spherical polar coordinates
 
 	Transformable* transform;
+	SlotMapHandle handle;
 
 	if( m_explosions->size() < m_demo_nExplosions ) {
 
@@ -1003,13 +1111,14 @@ HRESULT GameStateWithParticles::updateDemo(void) {
 				XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f) // Orientation
 				);
 
-			m_explosions->emplace_back(new ActiveParticles<UniformBurstSphere>(
+			m_explosions->emplace(handle,
 				m_explosionModel,
 				transform,
 				static_cast<DWORD>(static_cast<float>(m_explosionLifespan) * w),
 				m_currentTime,
-				XMFLOAT3(1.0f, 1.0f, 1.0f))
+				XMFLOAT3(1.0f, 1.0f, 1.0f)
 				);
+			m_explosionIndex.insert(std::make_pair(transform, handle));
 		}
 	}
 
@@ -1023,13 +1132,14 @@ HRESULT GameStateWithParticles::updateDemo(void) {
 
 		// transform->Spin(0.0f, 100.0f, 0.0f);
 
-		m_jets->emplace_back(new ActiveParticles<RandomBurstCone>(
+		m_jets->emplace(handle,
 			m_jetModel,
 			transform,
 			m_jetLifespan,
 			m_currentTime,
-			XMFLOAT3(1.0f, 1.0f, 1.0f))
+			XMFLOAT3(1.0f, 1.0f, 1.0f)
 			);
+		m_jetIndex.insert(std::make_pair(transform, handle));
 	}
 
 	if( m_lasers->size() < GAMESTATEWITHPARTICLES_DEMO_NLASERS ) {
@@ -1073,4 +1183,12 @@ HRESULT GameStateWithParticles::updateDemo(void) {
 		}
 	}
 	return ERROR_SUCCESS;
-}
\ No newline at end of file
+}
+
+void GameStateWithParticles::removeBallCollider(const Transformable* const transform) {
+	std::map<const Transformable*, size_t>::iterator it = m_ballColliders.find(transform);
+	if( it != m_ballColliders.end() ) {
+		getBroadphase()->remove(it->second);
+		m_ballColliders.erase(it);
+	}
+}
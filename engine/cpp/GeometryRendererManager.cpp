@@ -238,4 +238,53 @@ HRESULT GeometryRendererManager::render(
 	}
 
 	return result;
-}
\ No newline at end of file
+}
+HRESULT GeometryRendererManager::renderInstanced(
+	ID3D11DeviceContext* const context,
+	const IGeometry& geometry,
+	const Camera* const camera,
+	GeometryRendererType rendererType,
+	const ParticleInstanceType* const instances,
+	const size_t nInstances
+	) {
+
+	HRESULT result = ERROR_SUCCESS;
+	IGeometryRenderer* geometryRenderer = 0;
+	wstring name;
+
+	// Retrieve the appropriate renderer
+	map<GeometryRendererType, IGeometryRenderer*>::const_iterator
+		mapping = m_map.find(rendererType);
+	if( mapping != m_map.cend() ) {
+		geometryRenderer = mapping->second;
+
+		// Render the geometry
+		if( FAILED(geometryRenderer->renderInstanced(context, geometry, camera, instances, nInstances)) ) {
+
+			if( FAILED(geometryRendererTypeToWString(name, rendererType)) ) {
+				name = L"[Error converting GeometryRendererType constant to a string. Code is likely broken.]";
+				result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+
+			logMessage(L"Call to renderInstanced() on renderer of type: " + name + L" failed.");
+			if( SUCCEEDED(result) ) {
+				result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+			}
+		}
+
+	} else {
+
+		// Not found
+		if( FAILED(geometryRendererTypeToWString(name, rendererType)) ) {
+			name = L"[Error converting GeometryRendererType constant to a string. Code is likely broken.]";
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+
+		logMessage(L"renderInstanced() could not find a renderer of type: " + name + L" to use for rendering.");
+		if( SUCCEEDED(result) ) {
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_DATA_NOT_FOUND);
+		}
+	}
+
+	return result;
+}
@@ -38,7 +38,7 @@ ObjectModel::~ObjectModel(){
 	}
 }
 
-HRESULT ObjectModel::updateContainedTransforms(const DWORD currentTime, const DWORD updateTimeInterval){
+HRESULT ObjectModel::updateContainedTransforms(const DWORD currentTime, const DWORD updateTimeInterval, size_t* const nSkipped){
 	HRESULT result;
 	for (std::vector<Transformable*>::size_type i = 0; i < tForms->size(); i++){
 		//tForms->at(i)->Spin(1.0f, 1.0f, 1.0f);
@@ -46,6 +46,9 @@ HRESULT ObjectModel::updateContainedTransforms(const DWORD currentTime, const DW
 		if (FAILED(result)){
 			return result;
 		}
+		if (nSkipped != 0 && ((*tForms)[i])->wasUpdateSkipped()){
+			++(*nSkipped);
+		}
 	}
 	return ERROR_SUCCESS;
 }
@@ -55,6 +58,10 @@ HRESULT ObjectModel::addTransformable(Transformable * newTrans){
 	return ERROR_SUCCESS;
 }
 
+const std::vector<Transformable*>* ObjectModel::getTransformables(void) const {
+	return tForms;
+}
+
 HRESULT ObjectModel::draw(ID3D11DeviceContext* const context, GeometryRendererManager& manager, Camera * camera){
 	HRESULT result = ERROR_SUCCESS;
 
@@ -23,6 +23,7 @@ Description
 #include "engineGlobals.h"
 #include "FlatAtomicConfigIO.h"
 #include "globals.h"
+#include "Transformable.h"
 #include <sstream>   // for wostringstream
 #include <string>
 
@@ -33,7 +34,8 @@ using std::wostringstream;
 StateControl::StateControl(void) :
 LogUser(true, STATECONTROL_START_MSG_PREFIX),
 m_mainWindow(0), m_Keyboard(0), m_Mouse(0), m_D3D(0),
-m_GeometryRendererManager(0), m_CurrentState(0)
+m_GeometryRendererManager(0), m_CurrentState(0), m_Timestep(0),
+m_RealClock(0), m_Clock(0), m_LastFrameTime()
 {}
 
 StateControl::~StateControl(void)
@@ -59,6 +61,21 @@ StateControl::~StateControl(void)
 		m_CurrentState = 0;
 	}
 
+	if( m_Timestep ) {
+		delete m_Timestep;
+		m_Timestep = 0;
+	}
+
+	if( m_Clock ) {
+		delete m_Clock;
+		m_Clock = 0;
+	}
+
+	if( m_RealClock ) {
+		delete m_RealClock;
+		m_RealClock = 0;
+	}
+
 	if( m_GeometryRendererManager ) {
 		delete m_GeometryRendererManager;
 		m_GeometryRendererManager = 0;
@@ -189,6 +206,8 @@ HRESULT StateControl::Initialize(void)
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
+	m_Timestep = new FixedTimestep(STATECONTROL_STEP_INTERVAL, STATECONTROL_MAX_STEPS_PER_FRAME);
+
 	m_mainWindow->addMessageHandler(m_Keyboard);
 	m_mainWindow->addMessageHandler(m_Mouse);
 
@@ -200,6 +219,17 @@ HRESULT StateControl::Run(WPARAM& quit_wParam)
 	HRESULT result = ERROR_SUCCESS;
 	std::wstring errorStr;
 
+	// Start the clocks
+	try {
+		m_RealClock = new MonotonicClock();
+		m_Clock = new ScaledClock(m_RealClock, STATECONTROL_TIME_SCALE);
+	} catch( ... ) {
+		logMessage(L"Failed to create clocks.");
+		BasicWindow::shutdownAll();
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+	m_LastFrameTime = m_Clock->now();
+
 	// The indefinite control loop
 	logMessage(L"Entering Run() loop.");
 	bool quit = false;
@@ -254,19 +284,10 @@ HRESULT StateControl::Run(WPARAM& quit_wParam)
 HRESULT StateControl::Frame(void)
 {
 	// Update time counters
-	static DWORD runStartTime = 0; // Time since the Run() loop started
-	static DWORD startTimeOfLastFrame = 0; // Time at which the previous frame started
-	DWORD currentTime = GetTickCount(); // Current clock time
-	DWORD elapsedTimeLastFrame = 0; // Time taken to complete the last frame
-	if (runStartTime == 0)
-	{
-		runStartTime = currentTime;
-	}
-	if (startTimeOfLastFrame != 0)
-	{
-		elapsedTimeLastFrame = currentTime - startTimeOfLastFrame;
-	}
-	startTimeOfLastFrame = currentTime;
+	const EngineTime currentClockTime = m_Clock->now();
+	const EngineDuration elapsedTimeLastFrame = currentClockTime - m_LastFrameTime; // Time taken to complete the last frame
+	m_LastFrameTime = currentClockTime;
+	DWORD currentTime = engineTime::toMilliseconds(m_RealClock->now()); // Time since the Run() loop started
 
 	// Initialize Window caption with application name
 	wostringstream captionWOSStream;
@@ -293,8 +314,8 @@ HRESULT StateControl::Frame(void)
 
 	// Display the window caption
 	captionWOSStream << itPerSecond << L" [Hz]";
-	// captionWOSStream << L", Last Iteration was: " << to_wstring(elapsedTimeLastFrame) << L" [ms]";
-	DWORD totalElapsedTime = (currentTime - runStartTime);
+	// captionWOSStream << L", Last Iteration was: " << engineTime::toMillisecondsFloat(elapsedTimeLastFrame) << L" [ms]";
+	DWORD totalElapsedTime = currentTime;
 	captionWOSStream << L" | Elapsed Time: " << (totalElapsedTime / MILLISECS_PER_SEC_DWORD) << L" [s]";
 	//captionWOSStream << L" | TimePressed(LEFT): " << m_Mouse->TimePressed(m_Mouse->LEFT) << L" [ms]";
 	//captionWOSStream << L" | TimeReleased(LEFT): " << m_Mouse->TimeReleased(m_Mouse->LEFT) << L" [ms]";
@@ -338,10 +359,17 @@ HRESULT StateControl::Frame(void)
 	m_Mouse->Update();
 	m_Keyboard->Update();
 
-	result = m_CurrentState->update(totalElapsedTime, elapsedTimeLastFrame);
-	if( FAILED(result) ) {
-		logMessage(L"Call to State Update() function failed.");
-		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	/* Update the state in fixed steps, so that the simulation
+	   does not depend on the frame rate or the clock granularity
+	 */
+	m_Timestep->advance(elapsedTimeLastFrame);
+	DWORD stepTime = 0;
+	while( m_Timestep->nextStep(stepTime) ) {
+		result = m_CurrentState->update(stepTime, m_Timestep->getStepInterval());
+		if( FAILED(result) ) {
+			logMessage(L"Call to State Update() function failed.");
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
 	}
 
 	/* Render the current frame */
@@ -352,11 +380,13 @@ HRESULT StateControl::Frame(void)
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
-	// Render the current state
+	// Render the current state, between the last two simulation steps
+	Transformable::setRenderInterpolation(m_Timestep->getInterpolationFactor());
 	result = m_CurrentState->drawContents(
 		m_D3D->GetDeviceContext(),
 		*m_GeometryRendererManager
 		);
+	Transformable::setRenderInterpolation(1.0f);
 	if( FAILED(result) ) {
 		logMessage(L"Call to State drawContents() function failed.");
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
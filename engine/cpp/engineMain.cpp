@@ -28,6 +28,28 @@ Description
 #include "engineGlobals.h"
 #include "globals.h"
 
+// Additional includes needed for test code
+#include "testTransformable.h"
+#include "testTransformSystem.h"
+#include "testTransformScheduler.h"
+#include "testSpline.h"
+#include "testKnot.h"
+#include "testCounterRNG.h"
+#include "testFixedTimestep.h"
+#include "testEngineTime.h"
+#include "testSpatialIndex.h"
+#include "testSweepAndPrune.h"
+#include "testSplineFitter.h"
+#include "testSplineUploader.h"
+#include "testAnimation.h"
+#include "testTransformBuffer.h"
+#include "testWanderingLineSystem.h"
+#include "testParticleKernels.h"
+#include "testBurstVertexGenerator.h"
+#include "testParticleInstanceBatcher.h"
+#include "testSlotMap.h"
+#include "testParticleLOD.h"
+
 // Initialize global graphics variables
 const bool FULL_SCREEN = false;
 const bool VSYNC_ENABLED = true;
@@ -45,6 +67,66 @@ HRESULT engineApplicationLoop(WPARAM& quit_wParam) {
 	XMStoreFloat3(&eps3D, XMVectorSplatEpsilon());
 	float_eps = eps3D.x;
 
+	// Tests which do not need a window
+	// testTransformable::testLazyEvaluation();
+	// testTransformSystem::testAgainstTransformable();
+	// testTransformSystem::benchmarkUpdate();
+	// testTransformSystem::testBaking();
+	// testTransformSystem::benchmarkBaking();
+	// testTransformScheduler::testDeterminism();
+	// testTransformScheduler::benchmarkUpdate();
+	// testSpline::testAgainstList();
+	// testSpline::benchmarkLasers();
+	// testSpline::testEvalBatch();
+	// testSpline::benchmarkEvalBatch();
+	// testSpline::testArcLength();
+	// testSpline::benchmarkArcLength();
+	// testSpline::testBounds();
+	// testSpline::benchmarkBounds();
+	// testKnot::testSides();
+	// testKnot::testPoolChurn();
+	// testCounterRNG::testStatistics();
+	// testCounterRNG::benchmarkThroughput();
+	// testFixedTimestep::testDeterminism();
+	// testFixedTimestep::testInterpolation();
+	// testEngineTime::testClocks();
+	// testEngineTime::benchmarkConversion();
+	// testSpatialIndex::testQueries();
+	// testSpatialIndex::benchmarkScaling();
+	// testSweepAndPrune::testAgainstBruteForce();
+	// testSweepAndPrune::benchmarkScaling();
+	// testSplineFitter::testErrorBound();
+	// testSplineFitter::testHomingSplineCompression();
+	// testSplineFitter::benchmarkFitting();
+	// testSplineUploader::testIncrementalUpload();
+	// testSplineUploader::benchmarkUpload();
+	// testAnimation::testCompression();
+	// testAnimation::testSampler();
+	// testAnimation::benchmarkSampling();
+	// testTransformBuffer::testFlip();
+	// testTransformBuffer::testConcurrentUpdateAndRender();
+	// testTransformBuffer::benchmarkOverlap();
+	// testWanderingLineSystem::testAgainstWanderingLineTransformable();
+	// testWanderingLineSystem::testSplines();
+	// testWanderingLineSystem::benchmarkUpdate();
+	// testParticleKernels::testGeneralGolden();
+	// testParticleKernels::testGeneralAgainstReference();
+	// testParticleKernels::benchmarkGeneral();
+	// testParticleKernels::testSplineGolden();
+	// testParticleKernels::testSplineAgainstReference();
+	// testParticleKernels::benchmarkSpline();
+	// testBurstVertexGenerator::testSphere();
+	// testBurstVertexGenerator::testCone();
+	// testBurstVertexGenerator::testDeterminism();
+	// testBurstVertexGenerator::benchmarkScaling();
+	// testParticleInstanceBatcher::testDrawCounts();
+	// testParticleInstanceBatcher::testInstanceData();
+	// testSlotMap::testHandles();
+	// testSlotMap::testChurn();
+	// testParticleLOD::testSelection();
+	// testParticleLOD::testProgressiveOrder();
+	// testParticleLOD::testFillRate();
+
 	StateControl* stateControl = 0;
 	HRESULT result = ERROR_SUCCESS;
 
@@ -0,0 +1,285 @@
+/*
+BurstVertexGenerator.cpp
+------------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: UniformBurstSphere.cpp and RandomBurstCone.cpp
+
+Description
+  -Implementation of the BurstVertexGenerator class
+*/
+
+#include "BurstVertexGenerator.h"
+#include "defs.h"
+#include <vector>
+#include <cmath> // for cbrt()
+
+using namespace DirectX;
+
+namespace {
+	/* Per-vertex properties which do not depend on the vertex's position.
+	   'u' and 'v' are only used for debugging colour casts.
+	 */
+	inline void setCommonProperties(ParticleVertexType& vertex, const BurstVertexGenerator::Parameters& parameters,
+		const float u, const float v) {
+		vertex.billboard = parameters.billboard;
+		vertex.life = parameters.life;
+		if( parameters.debugColorCasts ) {
+			vertex.index = XMFLOAT4(u, v, 1.0f, 1.0f);
+		} else {
+			vertex.index = parameters.colorCast;
+		}
+	}
+
+	/* Cone vertex position, given the sines and cosines of its angles.
+	   'rotation' rotates the cone to point in the forward direction.
+	 */
+	inline XMVECTOR conePositionFromAngles(const float radius,
+		const float sinPhi, const float cosPhi, const float sinTheta, const float cosTheta,
+		const XMMATRIX& rotation) {
+		XMFLOAT3 position(
+			radius * cosTheta * sinPhi,
+			radius * cosPhi,
+			radius * sinTheta * sinPhi);
+		return XMVector3Transform(XMLoadFloat3(&position), rotation);
+	}
+
+	// Everything but the billboard, life and index of a cone vertex
+	inline void setConeVertexMotion(ParticleVertexType& vertex, const XMVECTOR& position, const float speed) {
+		XMStoreFloat3(&vertex.position, position);
+		XMStoreFloat4(&vertex.linearVelocity, XMVector3Normalize(position));
+		vertex.linearVelocity.w = speed;
+	}
+}
+
+BurstVertexGenerator::BurstVertexGenerator(WorkerPool* const pool, const size_t chunkSize) :
+	m_pool(pool), m_chunkSize((chunkSize == 0) ? BURSTVERTEXGENERATOR_CHUNK_SIZE_DEFAULT : chunkSize)
+{}
+
+BurstVertexGenerator::~BurstVertexGenerator(void) {}
+
+HRESULT BurstVertexGenerator::sphere(ParticleVertexType* const vertices, const Parameters& parameters) {
+	const size_t nColumns = parameters.nColumns;
+	const size_t nRows = parameters.nRows;
+	const size_t nVertices = nColumns * nRows;
+	if( nVertices == 0 ) {
+		return ERROR_SUCCESS;
+	} else if( vertices == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+
+	/* Each grid row has a single value of 'phi', and each column has
+	   a single value of 'theta', so their sines and cosines
+	   are computed once (in the same way as in spherePosition()).
+	   Elements are (sine, cosine).
+	 */
+	std::vector<XMFLOAT2> rowTrig(nRows);
+	std::vector<XMFLOAT2> columnTrig(nColumns);
+	float v = 0.0f;
+	float u = 0.0f;
+	for( size_t i = 0; i < nRows; ++i ) {
+		v = static_cast<float>(i) / static_cast<float>(nRows);
+		XMScalarSinCos(&rowTrig[i].x, &rowTrig[i].y, XMScalarACos(2.0f*v - 1.0f));
+	}
+	for( size_t j = 0; j < nColumns; ++j ) {
+		u = static_cast<float>(j) / static_cast<float>(nColumns);
+		XMScalarSinCos(&columnTrig[j].x, &columnTrig[j].y, XM_2PI * u);
+	}
+
+	const XMFLOAT2* const rowTrigPtr = &rowTrig[0];
+	const XMFLOAT2* const columnTrigPtr = &columnTrig[0];
+
+	return runChunks(nVertices, [=, &parameters](const size_t first, const size_t n) {
+		size_t i = first / nColumns;
+		size_t j = first % nColumns;
+		float u = 0.0f;
+		float v = static_cast<float>(i) / static_cast<float>(nRows);
+		ParticleVertexType* vertex = vertices + first;
+		ParticleVertexType* const end = vertex + n;
+		for( ; vertex != end; ++vertex ) {
+			u = static_cast<float>(j) / static_cast<float>(nColumns);
+			const XMFLOAT2& phi = rowTrigPtr[i];
+			const XMFLOAT2& theta = columnTrigPtr[j];
+			vertex->position.x = theta.y * phi.x;
+			vertex->position.y = phi.y;
+			vertex->position.z = theta.x * phi.x;
+			vertex->linearVelocity = XMFLOAT4(
+				vertex->position.x,
+				vertex->position.y,
+				vertex->position.z,
+				parameters.linearSpeed);
+			setCommonProperties(*vertex, parameters, u, v);
+
+			// Advance to the next grid location
+			if( ++j == nColumns ) {
+				j = 0;
+				++i;
+				v = static_cast<float>(i) / static_cast<float>(nRows);
+			}
+		}
+	});
+}
+
+HRESULT BurstVertexGenerator::cone(ParticleVertexType* const vertices, const Parameters& parameters,
+	const ConeParameters& coneParameters, const CounterRNG& rng) {
+	const size_t nColumns = parameters.nColumns;
+	const size_t nRows = parameters.nRows;
+	const size_t nVertices = nColumns * nRows;
+	if( nVertices == 0 ) {
+		return ERROR_SUCCESS;
+	} else if( vertices == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+
+	// One 'v' value, and 'u' and 'w' values for each column, per row
+	const unsigned long long drawsPerRow = 1 + 2 * static_cast<unsigned long long>(nColumns);
+
+	return runChunks(nVertices, [=, &parameters, &coneParameters, &rng](const size_t first, const size_t n) {
+		// Private random number stream
+		CounterRNG chunkRng(rng);
+
+		const XMMATRIX rotation = XMMatrixRotationX(XM_PIDIV2);
+		const float radiusRange = coneParameters.maxR - coneParameters.minR;
+
+		// Random (u,w) pairs for the chunk's portion of a row
+		float values[2 * BURSTVERTEXGENERATOR_CHUNK_SIZE_DEFAULT];
+		std::vector<float> largeValues;
+		float* uw = values;
+		if( n > BURSTVERTEXGENERATOR_CHUNK_SIZE_DEFAULT ) {
+			largeValues.resize(2 * n);
+			uw = &largeValues[0];
+		}
+
+		// Azimuthal angle batches
+		XMFLOAT4 thetaIn, sinTheta, cosTheta;
+		float* const thetaLanes = &thetaIn.x;
+		const float* const sinLanes = &sinTheta.x;
+		const float* const cosLanes = &cosTheta.x;
+
+		float u = 0.0f;
+		float v = 0.0f;
+		float w = 0.0f;
+		float sinPhi, cosPhi, speed;
+
+		size_t i = first / nColumns;
+		size_t j = first % nColumns;
+		size_t nLeft = n;
+		ParticleVertexType* vertex = vertices + first;
+
+		while( nLeft > 0 ) {
+			const size_t nInRow = ((nColumns - j) < nLeft) ? (nColumns - j) : nLeft;
+
+			// Draw the row's 'v' value, then the (u,w) pairs of this part of the row
+			chunkRng.setDrawIndex(static_cast<unsigned long long>(i) * drawsPerRow);
+			v = chunkRng.nextUniform();
+			chunkRng.setDrawIndex(static_cast<unsigned long long>(i) * drawsPerRow + 1 + 2 * static_cast<unsigned long long>(j));
+			chunkRng.uniform(uw, 2 * nInRow);
+
+			XMScalarSinCos(&sinPhi, &cosPhi, XM_PI * v * coneParameters.maxPhi);
+			speed = parameters.linearSpeed * sqrtf(v);
+
+			for( size_t k = 0; k < nInRow; k += 4 ) {
+				const size_t nLanes = ((nInRow - k) < 4) ? (nInRow - k) : 4;
+				size_t lane = 0;
+				for( lane = 0; lane < nLanes; ++lane ) {
+					thetaLanes[lane] = XM_2PI * uw[2 * (k + lane)];
+				}
+				for( ; lane < 4; ++lane ) {
+					thetaLanes[lane] = 0.0f;
+				}
+				XMVECTOR sinVector, cosVector;
+				XMVectorSinCos(&sinVector, &cosVector, XMLoadFloat4(&thetaIn));
+				XMStoreFloat4(&sinTheta, sinVector);
+				XMStoreFloat4(&cosTheta, cosVector);
+
+				for( lane = 0; lane < nLanes; ++lane ) {
+					u = uw[2 * (k + lane)];
+					w = uw[2 * (k + lane) + 1];
+					setConeVertexMotion(*vertex,
+						conePositionFromAngles(cbrtf(w) * radiusRange + coneParameters.minR,
+							sinPhi, cosPhi, sinLanes[lane], cosLanes[lane], rotation),
+						speed);
+					setCommonProperties(*vertex, parameters, u, v);
+					vertex->life.x = parameters.life.x * w;
+					++vertex;
+				}
+			}
+
+			nLeft -= nInRow;
+			j = 0;
+			++i;
+		}
+	});
+}
+
+void BurstVertexGenerator::sphereVertex(ParticleVertexType& vertex, const Parameters& parameters,
+	const float u, const float v) {
+	spherePosition(vertex.position, u, v);
+	vertex.linearVelocity = XMFLOAT4(
+		vertex.position.x,
+		vertex.position.y,
+		vertex.position.z,
+		parameters.linearSpeed);
+	setCommonProperties(vertex, parameters, u, v);
+}
+
+void BurstVertexGenerator::coneVertex(ParticleVertexType& vertex, const Parameters& parameters,
+	const ConeParameters& coneParameters, const float u, const float v, const float w) {
+	conePosition(vertex.position, coneParameters, u, v, w);
+	setConeVertexMotion(vertex, XMLoadFloat3(&vertex.position), parameters.linearSpeed * sqrtf(v));
+	setCommonProperties(vertex, parameters, u, v);
+	vertex.life.x = parameters.life.x * w;
+}
+
+void BurstVertexGenerator::spherePosition(DirectX::XMFLOAT3& position, const float u, const float v) {
+	// phi = cos-1(2v - 1)
+	// u = theta / XM_2PI
+	float sinPhi, cosPhi, sinTheta, cosTheta;
+	XMScalarSinCos(&sinPhi, &cosPhi, XMScalarACos(2.0f*v - 1.0f));
+	XMScalarSinCos(&sinTheta, &cosTheta, XM_2PI * u);
+	position.x = cosTheta * sinPhi;
+	position.y = cosPhi;
+	position.z = sinTheta * sinPhi;
+}
+
+void BurstVertexGenerator::conePosition(DirectX::XMFLOAT3& position, const ConeParameters& coneParameters,
+	const float u, const float v, const float w) {
+	// v = phi / XM_PI
+	// u = theta / XM_2PI
+	float radius = cbrtf(w) * (coneParameters.maxR - coneParameters.minR) + coneParameters.minR;
+	float sinPhi, cosPhi, sinTheta, cosTheta;
+	XMScalarSinCos(&sinPhi, &cosPhi, XM_PI * v * coneParameters.maxPhi);
+	XMScalarSinCos(&sinTheta, &cosTheta, XM_2PI * u);
+
+	// Rotate to forward direction
+	XMStoreFloat3(&position, conePositionFromAngles(radius, sinPhi, cosPhi, sinTheta, cosTheta,
+		XMMatrixRotationX(XM_PIDIV2)));
+}
+
+size_t BurstVertexGenerator::getChunkSize(void) const {
+	return m_chunkSize;
+}
+
+HRESULT BurstVertexGenerator::runChunks(const size_t nVertices, const std::function<void(const size_t, const size_t)>& task) {
+	const size_t chunkSize = m_chunkSize;
+	const size_t nChunks = (nVertices + chunkSize - 1) / chunkSize;
+
+	std::function<void(const size_t)> chunkTask = [=, &task](const size_t chunk) {
+		const size_t first = chunk * chunkSize;
+		const size_t n = ((nVertices - first) < chunkSize) ? (nVertices - first) : chunkSize;
+		task(first, n);
+	};
+
+	if( m_pool == 0 || nChunks == 1 ) {
+		for( size_t chunk = 0; chunk < nChunks; ++chunk ) {
+			chunkTask(chunk);
+		}
+	} else if( FAILED(m_pool->run(nChunks, chunkTask)) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+	return ERROR_SUCCESS;
+}
@@ -36,7 +36,10 @@ InvariantParticles::InvariantParticles(const bool enableLogging, const std::wstr
 	m_rendererType(0),
 	m_renderLighting(INVARIANTPARTICLES_USE_LIGHTING_FLAG_DEFAULT),
 	m_time(XMFLOAT2(0.0f, 0.0f)),
-	m_colorCast(XMFLOAT3(0.0f, 0.0f, 0.0f))
+	m_colorCast(XMFLOAT3(0.0f, 0.0f, 0.0f)),
+	m_lod(0), m_drawVertexCount(0),
+	m_lodCompensation(XMFLOAT2(1.0f, 1.0f)),
+	m_lodInstances()
 {}
 
 InvariantParticles::InvariantParticles(const bool enableLogging, const std::wstring& msgPrefix,
@@ -50,7 +53,10 @@ InvariantParticles::InvariantParticles(const bool enableLogging, const std::wstr
 	m_rendererType(0),
 	m_renderLighting(INVARIANTPARTICLES_USE_LIGHTING_FLAG_DEFAULT),
 	m_time(XMFLOAT2(0.0f, 0.0f)),
-	m_colorCast(XMFLOAT3(0.0f, 0.0f, 0.0f))
+	m_colorCast(XMFLOAT3(0.0f, 0.0f, 0.0f)),
+	m_lod(0), m_drawVertexCount(0),
+	m_lodCompensation(XMFLOAT2(1.0f, 1.0f)),
+	m_lodInstances()
 {}
 
 HRESULT InvariantParticles::configure(const std::wstring& scope, const std::wstring* configUserScope, const std::wstring* logUserScope) {
@@ -67,6 +73,10 @@ HRESULT InvariantParticles::configure(const std::wstring& scope, const std::wstr
 	Material* material = new Material;
 	material->ambientAlbedo = INVARIANTPARTICLES_AMBIENT_ALBEDO_DEFAULT;
 
+	// Level of detail
+	bool lodFlag = INVARIANTPARTICLES_LOD_FLAG_DEFAULT;
+	ParticleLOD::Parameters lodParameters;
+
 	if (hasConfigToUse()) {
 
 		// Configure base members
@@ -80,6 +90,7 @@ HRESULT InvariantParticles::configure(const std::wstring& scope, const std::wstr
 
 			// Data retrieval helper variables
 			const bool* boolValue = 0;
+			const int* intValue = 0;
 			const double* doubleValue = 0;
 			const DirectX::XMFLOAT4* float4Value = 0;
 
@@ -96,6 +107,59 @@ HRESULT InvariantParticles::configure(const std::wstring& scope, const std::wstr
 			if (retrieve<Config::DataType::FLOAT4, DirectX::XMFLOAT4>(scope, INVARIANTPARTICLES_AMBIENT_ALBEDO_FIELD, float4Value)) {
 				material->ambientAlbedo = *float4Value;
 			}
+
+			// Level of detail
+			if (retrieve<Config::DataType::BOOL, bool>(scope, INVARIANTPARTICLES_LOD_FLAG_FIELD, boolValue)) {
+				lodFlag = *boolValue;
+			}
+
+			if (retrieve<Config::DataType::DOUBLE, double>(scope, INVARIANTPARTICLES_LOD_FULL_DETAIL_SIZE_FIELD, doubleValue)) {
+				if (*doubleValue > 0.0) {
+					lodParameters.fullDetailSize = static_cast<float>(*doubleValue);
+				} else {
+					logMessage(L"Level of detail full detail size is not positive. Using the default value of "
+						+ std::to_wstring(lodParameters.fullDetailSize));
+				}
+			}
+
+			if (retrieve<Config::DataType::INT, int>(scope, INVARIANTPARTICLES_LOD_LEVELS_FIELD, intValue)) {
+				if (*intValue < PARTICLELOD_LEVELS_MIN) {
+					logMessage(L"Number of levels of detail is too low. Using the default value of "
+						+ std::to_wstring(lodParameters.nLevels));
+				} else if (*intValue > PARTICLELOD_LEVELS_MAX) {
+					logMessage(L"Number of levels of detail is too high. Using the default value of "
+						+ std::to_wstring(lodParameters.nLevels));
+				} else {
+					lodParameters.nLevels = static_cast<size_t>(*intValue);
+				}
+			}
+
+			if (retrieve<Config::DataType::DOUBLE, double>(scope, INVARIANTPARTICLES_LOD_SIZE_COMPENSATION_FIELD, doubleValue)) {
+				if (*doubleValue < 0.0) {
+					logMessage(L"Level of detail size compensation exponent is too low. Using the default value of "
+						+ std::to_wstring(lodParameters.sizeCompensation));
+				} else {
+					lodParameters.sizeCompensation = static_cast<float>(*doubleValue);
+				}
+			}
+
+			if (retrieve<Config::DataType::DOUBLE, double>(scope, INVARIANTPARTICLES_LOD_ALPHA_COMPENSATION_FIELD, doubleValue)) {
+				if (*doubleValue < 0.0) {
+					logMessage(L"Level of detail transparency compensation exponent is too low. Using the default value of "
+						+ std::to_wstring(lodParameters.alphaCompensation));
+				} else {
+					lodParameters.alphaCompensation = static_cast<float>(*doubleValue);
+				}
+			}
+
+			if (retrieve<Config::DataType::DOUBLE, double>(scope, INVARIANTPARTICLES_LOD_MAX_ALPHA_SCALE_FIELD, doubleValue)) {
+				if (*doubleValue < static_cast<double>(PARTICLELOD_MAX_ALPHA_SCALE_MIN)) {
+					logMessage(L"Level of detail maximum transparency multiplier is too low. Using the default value of "
+						+ std::to_wstring(lodParameters.maxAlphaScale));
+				} else {
+					lodParameters.maxAlphaScale = static_cast<float>(*doubleValue);
+				}
+			}
 		}
 	}
 	else {
@@ -127,6 +191,16 @@ HRESULT InvariantParticles::configure(const std::wstring& scope, const std::wstr
 		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
+	if (m_lod != 0) {
+		delete m_lod;
+		m_lod = 0;
+	}
+	if (lodFlag) {
+		// Parameters were validated above
+		m_lod = new ParticleLOD(lodParameters);
+		m_lodInstances.resize(m_lod->getNumberOfLevels());
+	}
+
 	return result;
 }
 
@@ -157,6 +231,7 @@ HRESULT InvariantParticles::initializeVertexBuffer(ID3D11Device* const device,
 	// Simple member initialization
 	m_primitive_topology = topology;
 	m_vertexCount = nVertices;
+	m_drawVertexCount = nVertices;
 
 	D3D11_BUFFER_DESC vertexBufferDesc;
 	D3D11_SUBRESOURCE_DATA vertexData;
@@ -245,6 +320,10 @@ InvariantParticles::~InvariantParticles(void) {
 		delete m_rendererType;
 		m_rendererType = 0;
 	}
+	if (m_lod != 0) {
+		delete m_lod;
+		m_lod = 0;
+	}
 }
 
 HRESULT InvariantParticles::drawUsingAppropriateRenderer(ID3D11DeviceContext* const context, GeometryRendererManager& manager, const Camera* const camera) {
@@ -260,6 +339,23 @@ HRESULT InvariantParticles::drawUsingAppropriateRenderer(ID3D11DeviceContext* co
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
+	// Level of detail
+	// ---------------
+	ParticleLOD::Selection selection;
+	if (m_lod == 0) {
+		ParticleLOD::selectFullDetail(selection, m_vertexCount);
+	} else {
+		XMFLOAT4X4 world, view, projection;
+		if (FAILED(getWorldTransform(world))) {
+			logMessage(L"Failed to get world transform for level of detail selection.");
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+		camera->GetViewMatrix(view);
+		camera->GetProjectionMatrix(projection);
+		selectLOD(selection, world, m_time.x, view, projection);
+	}
+	setLOD(selection);
+
 	// Render
 	// ------
 	if (FAILED(manager.render(
@@ -273,6 +369,81 @@ HRESULT InvariantParticles::drawUsingAppropriateRenderer(ID3D11DeviceContext* co
 	return ERROR_SUCCESS;
 }
 
+HRESULT InvariantParticles::drawInstancedUsingAppropriateRenderer(ID3D11DeviceContext* const context, GeometryRendererManager& manager, const Camera* const camera,
+	const ParticleInstanceType* const instances, const size_t nInstances) {
+	if (m_rendererType == 0) {
+		logMessage(L"Cannot be rendered until a renderer type is specified.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+
+	// Prepare pipeline state
+	// ----------------------
+	if (FAILED(setVerticesOnContext(context))) {
+		logMessage(L"Call to setVerticesOnContext() failed.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+
+	ParticleLOD::Selection selection;
+	if (m_lod == 0) {
+
+		// Render
+		// ------
+		ParticleLOD::selectFullDetail(selection, m_vertexCount);
+		setLOD(selection);
+		if (FAILED(manager.renderInstanced(
+			context,
+			*this,
+			camera,
+			*m_rendererType,
+			instances,
+			nInstances
+			))) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+		return ERROR_SUCCESS;
+	}
+
+	// Group instances by level of detail
+	// ----------------------------------
+	XMFLOAT4X4 view, projection;
+	camera->GetViewMatrix(view);
+	camera->GetProjectionMatrix(projection);
+
+	const size_t nLevels = m_lodInstances.size();
+	for (size_t level = 0; level < nLevels; ++level) {
+		m_lodInstances[level].clear();
+	}
+	for (size_t i = 0; i < nInstances; ++i) {
+		selectLOD(selection, instances[i].world, instances[i].time.x, view, projection);
+		m_lodInstances[selection.level].push_back(instances[i]);
+		ParticleInstanceType& instance = m_lodInstances[selection.level].back();
+		instance.time.z = selection.compensation.x;
+		instance.time.w = selection.compensation.y;
+	}
+
+	// Render
+	// ------
+	HRESULT result = ERROR_SUCCESS;
+	for (size_t level = 0; level < nLevels; ++level) {
+		if (m_lodInstances[level].empty()) {
+			continue;
+		}
+		m_lod->selectLevel(selection, level, m_vertexCount);
+		setLOD(selection);
+		if (FAILED(manager.renderInstanced(
+			context,
+			*this,
+			camera,
+			*m_rendererType,
+			&m_lodInstances[level].front(),
+			m_lodInstances[level].size()
+			))) {
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+	}
+	return result;
+}
+
 HRESULT InvariantParticles::setTransformable(const Transformable* const transform) {
 	if (transform == 0) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
@@ -311,6 +482,14 @@ size_t InvariantParticles::getVertexCount(void) const {
 	return m_vertexCount;
 }
 
+size_t InvariantParticles::getDrawVertexCount(void) const {
+	return m_drawVertexCount;
+}
+
+DirectX::XMFLOAT2 InvariantParticles::getLODCompensation(void) const {
+	return m_lodCompensation;
+}
+
 float InvariantParticles::getTransparencyBlendFactor(void) const {
 	return m_blend;
 }
@@ -339,4 +518,23 @@ HRESULT InvariantParticles::setVerticesOnContext(ID3D11DeviceContext* const cont
 	context->IASetPrimitiveTopology(m_primitive_topology);
 
 	return ERROR_SUCCESS;
+}
+
+float InvariantParticles::getLODRadius(const float time) const {
+	return 0.0f;
+}
+
+void InvariantParticles::selectLOD(ParticleLOD::Selection& selection, const DirectX::XMFLOAT4X4& world, const float time,
+	const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection) const {
+	const float radius = getLODRadius(time);
+	if (m_lod == 0 || !(radius > 0.0f)) {
+		ParticleLOD::selectFullDetail(selection, m_vertexCount);
+	} else {
+		m_lod->select(selection, ParticleLOD::projectedSize(world, radius, view, projection), m_vertexCount);
+	}
+}
+
+void InvariantParticles::setLOD(const ParticleLOD::Selection& selection) {
+	m_drawVertexCount = selection.nVertices;
+	m_lodCompensation = selection.compensation;
 }
\ No newline at end of file
@@ -280,6 +280,25 @@ HRESULT InvariantTexturedParticles::drawUsingAppropriateRenderer(ID3D11DeviceCon
 	return InvariantParticles::drawUsingAppropriateRenderer(context, manager, camera);
 }
 
+HRESULT InvariantTexturedParticles::drawInstancedUsingAppropriateRenderer(ID3D11DeviceContext* const context, GeometryRendererManager& manager, const Camera* const camera,
+	const ParticleInstanceType* const instances, const size_t nInstances) {
+	if( m_rendererType == 0 ) {
+		logMessage(L"Cannot be rendered until a renderer type is specified.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+
+	// Bind textures
+	// -------------
+	if( FAILED(setTexturesOnContext(context)) ) {
+		logMessage(L"Failed to bind texture object data to the pipeline.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+
+	// Finish pipeline configuration and rendering in the base class
+	// -------------------------------------------------------------
+	return InvariantParticles::drawInstancedUsingAppropriateRenderer(context, manager, camera, instances, nInstances);
+}
+
 HRESULT InvariantTexturedParticles::setTexturesOnContext(ID3D11DeviceContext* const context) {
 	if( m_renderAlbedoTexture ) {
 		if( m_albedoTexture == 0 ) {
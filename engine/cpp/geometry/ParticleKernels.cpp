@@ -0,0 +1,607 @@
+/*
+ParticleKernels.cpp
+-------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: generalParticlesVS.hlsl, splineParticlesVS.hlsl,
+  and TransformSystem.cpp
+
+Description
+  -Implementation of the ParticleKernels class
+*/
+
+#include <cmath>
+#include "ParticleKernels.h"
+
+using namespace DirectX;
+
+// Replicates each element of a matrix into a vector, for the vectorized kernels
+#define PARTICLEKERNELS_SPLAT_MATRIX(out, m) \
+	out[0][0] = XMVectorReplicate((m)._11); out[0][1] = XMVectorReplicate((m)._12); \
+	out[0][2] = XMVectorReplicate((m)._13); out[0][3] = XMVectorReplicate((m)._14); \
+	out[1][0] = XMVectorReplicate((m)._21); out[1][1] = XMVectorReplicate((m)._22); \
+	out[1][2] = XMVectorReplicate((m)._23); out[1][3] = XMVectorReplicate((m)._24); \
+	out[2][0] = XMVectorReplicate((m)._31); out[2][1] = XMVectorReplicate((m)._32); \
+	out[2][2] = XMVectorReplicate((m)._33); out[2][3] = XMVectorReplicate((m)._34); \
+	out[3][0] = XMVectorReplicate((m)._41); out[3][1] = XMVectorReplicate((m)._42); \
+	out[3][2] = XMVectorReplicate((m)._43); out[3][3] = XMVectorReplicate((m)._44)
+
+namespace {
+
+	/* Vector version of ParticleKernels::hlslMod().
+	   Negation is performed by multiplication, as XMVectorNegate()
+	   may not produce negative zeros.
+	 */
+	XMVECTOR hlslModVector(const XMVECTOR a, const XMVECTOR b) {
+		const XMVECTOR minusOne = XMVectorReplicate(-1.0f);
+		const XMVECTOR q = XMVectorDivide(a, b);
+		const XMVECTOR absQ = XMVectorAbs(q);
+		const XMVECTOR f = XMVectorSubtract(absQ, XMVectorFloor(absQ));
+		return XMVectorMultiply(
+			XMVectorSelect(XMVectorMultiply(f, minusOne), f, XMVectorGreaterOrEqual(q, XMVectorMultiply(q, minusOne))),
+			b);
+	}
+
+	// Age and health of a particle, as computed by the particle vertex shaders
+	inline void particleLife(float& age, float& health, const XMFLOAT4& life, const float time) {
+		age = time - life.x; // If negative, particle has not yet been born.
+		age = (age > 0.0f) ? age : 0.0f;
+		health = life.y - ParticleKernels::hlslMod(life.z * age, life.y);
+		// Recompute age based on health (wrap around)
+		age = (life.y - health) / life.z;
+		if( health < life.w ) {
+			health = 0.0f;
+		}
+	}
+
+	/* Vector version of particleLife(),
+	   where the rows of 'life' are the components of the life vectors
+	 */
+	inline void particleLifeVector(XMVECTOR& age, XMVECTOR& health, const XMMATRIX& life, const XMVECTOR time) {
+		const XMVECTOR zero = XMVectorZero();
+		age = XMVectorSubtract(time, life.r[0]);
+		age = XMVectorSelect(zero, age, XMVectorGreater(age, zero));
+		health = XMVectorSubtract(life.r[1], hlslModVector(XMVectorMultiply(life.r[2], age), life.r[1]));
+		age = XMVectorDivide(XMVectorSubtract(life.r[1], health), life.r[2]);
+		health = XMVectorSelect(health, zero, XMVectorLess(health, life.r[3]));
+	}
+
+	/* Row vector-matrix products, with the products summed in order,
+	   for points (w = 1), homogeneous points, and directions (w = 0)
+	 */
+	inline void transformPoint(float* const out, const float x, const float y, const float z, const XMFLOAT4X4& m) {
+		out[0] = ((x * m._11 + y * m._21) + z * m._31) + m._41;
+		out[1] = ((x * m._12 + y * m._22) + z * m._32) + m._42;
+		out[2] = ((x * m._13 + y * m._23) + z * m._33) + m._43;
+		out[3] = ((x * m._14 + y * m._24) + z * m._34) + m._44;
+	}
+
+	inline void transformHomogeneous(float* const out, const float* const in, const XMFLOAT4X4& m) {
+		out[0] = ((in[0] * m._11 + in[1] * m._21) + in[2] * m._31) + in[3] * m._41;
+		out[1] = ((in[0] * m._12 + in[1] * m._22) + in[2] * m._32) + in[3] * m._42;
+		out[2] = ((in[0] * m._13 + in[1] * m._23) + in[2] * m._33) + in[3] * m._43;
+	}
+
+	inline void transformDirection(float* const out, const float x, const float y, const float z, const XMFLOAT4X4& m) {
+		out[0] = (x * m._11 + y * m._21) + z * m._31;
+		out[1] = (x * m._12 + y * m._22) + z * m._32;
+		out[2] = (x * m._13 + y * m._23) + z * m._33;
+	}
+
+	// Vector versions of the above, with matrices splatted by PARTICLEKERNELS_SPLAT_MATRIX
+	inline void transformPointVector(XMVECTOR* const out, const XMVECTOR x, const XMVECTOR y, const XMVECTOR z, const XMVECTOR m[4][4]) {
+		out[0] = XMVectorAdd(XMVectorAdd(XMVectorAdd(XMVectorMultiply(x, m[0][0]), XMVectorMultiply(y, m[1][0])), XMVectorMultiply(z, m[2][0])), m[3][0]);
+		out[1] = XMVectorAdd(XMVectorAdd(XMVectorAdd(XMVectorMultiply(x, m[0][1]), XMVectorMultiply(y, m[1][1])), XMVectorMultiply(z, m[2][1])), m[3][1]);
+		out[2] = XMVectorAdd(XMVectorAdd(XMVectorAdd(XMVectorMultiply(x, m[0][2]), XMVectorMultiply(y, m[1][2])), XMVectorMultiply(z, m[2][2])), m[3][2]);
+		out[3] = XMVectorAdd(XMVectorAdd(XMVectorAdd(XMVectorMultiply(x, m[0][3]), XMVectorMultiply(y, m[1][3])), XMVectorMultiply(z, m[2][3])), m[3][3]);
+	}
+
+	inline void transformHomogeneousVector(XMVECTOR* const out, const XMVECTOR* const in, const XMVECTOR m[4][4]) {
+		out[0] = XMVectorAdd(XMVectorAdd(XMVectorAdd(XMVectorMultiply(in[0], m[0][0]), XMVectorMultiply(in[1], m[1][0])), XMVectorMultiply(in[2], m[2][0])), XMVectorMultiply(in[3], m[3][0]));
+		out[1] = XMVectorAdd(XMVectorAdd(XMVectorAdd(XMVectorMultiply(in[0], m[0][1]), XMVectorMultiply(in[1], m[1][1])), XMVectorMultiply(in[2], m[2][1])), XMVectorMultiply(in[3], m[3][1]));
+		out[2] = XMVectorAdd(XMVectorAdd(XMVectorAdd(XMVectorMultiply(in[0], m[0][2]), XMVectorMultiply(in[1], m[1][2])), XMVectorMultiply(in[2], m[2][2])), XMVectorMultiply(in[3], m[3][2]));
+	}
+
+	inline void transformDirectionVector(XMVECTOR* const out, const XMVECTOR x, const XMVECTOR y, const XMVECTOR z, const XMVECTOR m[4][4]) {
+		out[0] = XMVectorAdd(XMVectorAdd(XMVectorMultiply(x, m[0][0]), XMVectorMultiply(y, m[1][0])), XMVectorMultiply(z, m[2][0]));
+		out[1] = XMVectorAdd(XMVectorAdd(XMVectorMultiply(x, m[0][1]), XMVectorMultiply(y, m[1][1])), XMVectorMultiply(z, m[2][1]));
+		out[2] = XMVectorAdd(XMVectorAdd(XMVectorMultiply(x, m[0][2]), XMVectorMultiply(y, m[1][2])), XMVectorMultiply(z, m[2][2]));
+	}
+
+	// Dot product of 3D vectors, with the products summed in order
+	inline float dot3(const float* const a, const float* const b) {
+		return (a[0] * b[0] + a[1] * b[1]) + a[2] * b[2];
+	}
+
+	inline XMVECTOR dot3Vector(const XMVECTOR* const a, const XMVECTOR* const b) {
+		return XMVectorAdd(XMVectorAdd(XMVectorMultiply(a[0], b[0]), XMVectorMultiply(a[1], b[1])), XMVectorMultiply(a[2], b[2]));
+	}
+
+	// Scales a 3D vector to unit length (the HLSL normalize() function)
+	inline void normalize3(float* const v) {
+		const float length = std::sqrt(dot3(v, v));
+		for( size_t i = 0; i < 3; ++i ) {
+			v[i] = v[i] / length;
+		}
+	}
+
+	inline void normalize3Vector(XMVECTOR* const v) {
+		const XMVECTOR length = XMVectorSqrt(dot3Vector(v, v));
+		v[0] = XMVectorDivide(v[0], length);
+		v[1] = XMVectorDivide(v[1], length);
+		v[2] = XMVectorDivide(v[2], length);
+	}
+
+	// Fractional part (the HLSL frac() function)
+	inline float frac(const float x) {
+		return x - std::floor(x);
+	}
+
+	inline XMVECTOR fracVector(const XMVECTOR x) {
+		return XMVectorSubtract(x, XMVectorFloor(x));
+	}
+
+	/* Returns whether a spline particle is within the valid segments of the spline.
+	   Written so that NaN segment indices are out of bounds.
+	 */
+	bool isSegmentValid(const float segmentIndex, const ParticleKernels::SplineGlobals& globals) {
+		return segmentIndex >= 0.0f && segmentIndex < globals.segments.x;
+	}
+
+	// Returns the control points of a segment, given its index
+	const XMFLOAT4* getSegment(const XMFLOAT4* const spline, const float segmentIndex,
+		const ParticleKernels::SplineGlobals& globals) {
+		const UINT slot = (static_cast<UINT>(segmentIndex) + static_cast<UINT>(globals.slots.x)) %
+			static_cast<UINT>(globals.slots.y);
+		return spline + 4 * slot;
+	}
+
+	// Output of splineParticlesVS.hlsl for particles outside the valid segments
+	void outOfBoundsOutput(ParticleKernels::GeneralOutput& output, const float age, const ParticleVertexType& input) {
+		output.positionVS = XMFLOAT3(0.0f, 0.0f, 0.0f);
+		output.billboard = XMFLOAT2(0.0f, 0.0f);
+		output.angle = 0.0f;
+		output.life = XMFLOAT3(age, 0.0f, input.life.z);
+		output.index = input.index;
+	}
+}
+
+void ParticleKernels::generalParticlesVSReference(GeneralOutput& output, const ParticleVertexType& input,
+	const Globals& globals, const DirectX::XMFLOAT4X4& view) {
+
+	const XMFLOAT4X4& world = globals.world;
+
+	float age, health;
+	particleLife(age, health, input.life, globals.time.x);
+	health *= globals.lodCompensation.y;
+
+	// Linear motion
+	const float px = input.position.x + (input.linearVelocity.x * input.linearVelocity.w) * age;
+	const float py = input.position.y + (input.linearVelocity.y * input.linearVelocity.w) * age;
+	const float pz = input.position.z + (input.linearVelocity.z * input.linearVelocity.w) * age;
+
+	// World position (the input w-component is one)
+	const float wx = ((px * world._11 + py * world._21) + pz * world._31) + world._41;
+	const float wy = ((px * world._12 + py * world._22) + pz * world._32) + world._42;
+	const float wz = ((px * world._13 + py * world._23) + pz * world._33) + world._43;
+	const float ww = ((px * world._14 + py * world._24) + pz * world._34) + world._44;
+
+	// View space position
+	output.positionVS.x = ((wx * view._11 + wy * view._21) + wz * view._31) + ww * view._41;
+	output.positionVS.y = ((wx * view._12 + wy * view._22) + wz * view._32) + ww * view._42;
+	output.positionVS.z = ((wx * view._13 + wy * view._23) + wz * view._33) + ww * view._43;
+
+	// View space direction (zero w-component)
+	const float dx = input.linearVelocity.x;
+	const float dy = input.linearVelocity.y;
+	const float dz = input.linearVelocity.z;
+	const float dwx = (dx * world._11 + dy * world._21) + dz * world._31;
+	const float dwy = (dx * world._12 + dy * world._22) + dz * world._32;
+	const float dwz = (dx * world._13 + dy * world._23) + dz * world._33;
+	const float dvx = (dwx * view._11 + dwy * view._21) + dwz * view._31;
+	const float dvy = (dwx * view._12 + dwy * view._22) + dwz * view._32;
+	const float dvz = (dwx * view._13 + dwy * view._23) + dwz * view._33;
+
+	// Billboard
+	output.billboard = XMFLOAT2(input.billboard.x * globals.lodCompensation.x,
+		input.billboard.y * globals.lodCompensation.x);
+
+	// Angular motion
+	output.angle = input.billboard.z * age;
+
+	// If direction is away from viewer, reverse the direction of rotation
+	const float dotV_Vel = (dvx * output.positionVS.x + dvy * output.positionVS.y) + dvz * output.positionVS.z;
+	if( dotV_Vel > 0.0f ) {
+		output.angle = output.angle * -1.0f;
+	}
+
+	// Updated life information
+	output.life = XMFLOAT3(age, health, input.life.z);
+
+	// Index - pass-through
+	output.index = input.index;
+}
+
+HRESULT ParticleKernels::generalParticlesVS(GeneralOutput* const output, const ParticleVertexType* const input,
+	const size_t n, const Globals& globals, const DirectX::XMFLOAT4X4& view) {
+
+	if( n == 0 ) {
+		return ERROR_SUCCESS;
+	} else if( output == 0 || input == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+
+	XMVECTOR w[4][4];
+	XMVECTOR v[4][4];
+	PARTICLEKERNELS_SPLAT_MATRIX(w, globals.world);
+	PARTICLEKERNELS_SPLAT_MATRIX(v, view);
+	const XMVECTOR zero = XMVectorZero();
+	const XMVECTOR minusOne = XMVectorReplicate(-1.0f);
+	const XMVECTOR time = XMVectorReplicate(globals.time.x);
+	const XMVECTOR alphaScale = XMVectorReplicate(globals.lodCompensation.y);
+	const float sizeScale = globals.lodCompensation.x;
+
+	XMMATRIX life, velocity, position;
+	XMVECTOR age, health, bz;
+	XMVECTOR px, py, pz, wx, wy, wz, ww, vx, vy, vz;
+	XMVECTOR dwx, dwy, dwz, dvx, dvy, dvz;
+	XMVECTOR angle, dotV_Vel;
+
+	// Transposed outputs: view position (3), angle, age, health
+	XMFLOAT4 results[6];
+	const float* result = 0;
+
+	const ParticleVertexType* p = 0;
+	GeneralOutput* out = 0;
+	const size_t nBatched = n - (n % PARTICLEKERNELS_BATCH_SIZE);
+	for( size_t i = 0; i < nBatched; i += PARTICLEKERNELS_BATCH_SIZE ) {
+		p = input + i;
+
+		// Each row of these matrices holds one component of four particles
+		life = XMMatrixTranspose(XMMATRIX(
+			XMLoadFloat4(&p[0].life), XMLoadFloat4(&p[1].life),
+			XMLoadFloat4(&p[2].life), XMLoadFloat4(&p[3].life)));
+		velocity = XMMatrixTranspose(XMMATRIX(
+			XMLoadFloat4(&p[0].linearVelocity), XMLoadFloat4(&p[1].linearVelocity),
+			XMLoadFloat4(&p[2].linearVelocity), XMLoadFloat4(&p[3].linearVelocity)));
+		position = XMMatrixTranspose(XMMATRIX(
+			XMLoadFloat3(&p[0].position), XMLoadFloat3(&p[1].position),
+			XMLoadFloat3(&p[2].position), XMLoadFloat3(&p[3].position)));
+		bz = XMVectorSet(p[0].billboard.z, p[1].billboard.z, p[2].billboard.z, p[3].billboard.z);
+
+		particleLifeVector(age, health, life, time);
+		health = XMVectorMultiply(health, alphaScale);
+
+		// Linear motion
+		px = XMVectorAdd(position.r[0], XMVectorMultiply(XMVectorMultiply(velocity.r[0], velocity.r[3]), age));
+		py = XMVectorAdd(position.r[1], XMVectorMultiply(XMVectorMultiply(velocity.r[1], velocity.r[3]), age));
+		pz = XMVectorAdd(position.r[2], XMVectorMultiply(XMVectorMultiply(velocity.r[2], velocity.r[3]), age));
+
+		// World position
+		wx = XMVectorAdd(XMVectorAdd(XMVectorAdd(XMVectorMultiply(px, w[0][0]), XMVectorMultiply(py, w[1][0])), XMVectorMultiply(pz, w[2][0])), w[3][0]);
+		wy = XMVectorAdd(XMVectorAdd(XMVectorAdd(XMVectorMultiply(px, w[0][1]), XMVectorMultiply(py, w[1][1])), XMVectorMultiply(pz, w[2][1])), w[3][1]);
+		wz = XMVectorAdd(XMVectorAdd(XMVectorAdd(XMVectorMultiply(px, w[0][2]), XMVectorMultiply(py, w[1][2])), XMVectorMultiply(pz, w[2][2])), w[3][2]);
+		ww = XMVectorAdd(XMVectorAdd(XMVectorAdd(XMVectorMultiply(px, w[0][3]), XMVectorMultiply(py, w[1][3])), XMVectorMultiply(pz, w[2][3])), w[3][3]);
+
+		// View space position
+		vx = XMVectorAdd(XMVectorAdd(XMVectorAdd(XMVectorMultiply(wx, v[0][0]), XMVectorMultiply(wy, v[1][0])), XMVectorMultiply(wz, v[2][0])), XMVectorMultiply(ww, v[3][0]));
+		vy = XMVectorAdd(XMVectorAdd(XMVectorAdd(XMVectorMultiply(wx, v[0][1]), XMVectorMultiply(wy, v[1][1])), XMVectorMultiply(wz, v[2][1])), XMVectorMultiply(ww, v[3][1]));
+		vz = XMVectorAdd(XMVectorAdd(XMVectorAdd(XMVectorMultiply(wx, v[0][2]), XMVectorMultiply(wy, v[1][2])), XMVectorMultiply(wz, v[2][2])), XMVectorMultiply(ww, v[3][2]));
+
+		// View space direction
+		dwx = XMVectorAdd(XMVectorAdd(XMVectorMultiply(velocity.r[0], w[0][0]), XMVectorMultiply(velocity.r[1], w[1][0])), XMVectorMultiply(velocity.r[2], w[2][0]));
+		dwy = XMVectorAdd(XMVectorAdd(XMVectorMultiply(velocity.r[0], w[0][1]), XMVectorMultiply(velocity.r[1], w[1][1])), XMVectorMultiply(velocity.r[2], w[2][1]));
+		dwz = XMVectorAdd(XMVectorAdd(XMVectorMultiply(velocity.r[0], w[0][2]), XMVectorMultiply(velocity.r[1], w[1][2])), XMVectorMultiply(velocity.r[2], w[2][2]));
+		dvx = XMVectorAdd(XMVectorAdd(XMVectorMultiply(dwx, v[0][0]), XMVectorMultiply(dwy, v[1][0])), XMVectorMultiply(dwz, v[2][0]));
+		dvy = XMVectorAdd(XMVectorAdd(XMVectorMultiply(dwx, v[0][1]), XMVectorMultiply(dwy, v[1][1])), XMVectorMultiply(dwz, v[2][1]));
+		dvz = XMVectorAdd(XMVectorAdd(XMVectorMultiply(dwx, v[0][2]), XMVectorMultiply(dwy, v[1][2])), XMVectorMultiply(dwz, v[2][2]));
+
+		// Angular motion, reversed if the direction is away from the viewer
+		angle = XMVectorMultiply(bz, age);
+		dotV_Vel = XMVectorAdd(XMVectorAdd(XMVectorMultiply(dvx, vx), XMVectorMultiply(dvy, vy)), XMVectorMultiply(dvz, vz));
+		angle = XMVectorSelect(angle, XMVectorMultiply(angle, minusOne), XMVectorGreater(dotV_Vel, zero));
+
+		// Output
+		XMStoreFloat4(&results[0], vx);
+		XMStoreFloat4(&results[1], vy);
+		XMStoreFloat4(&results[2], vz);
+		XMStoreFloat4(&results[3], angle);
+		XMStoreFloat4(&results[4], age);
+		XMStoreFloat4(&results[5], health);
+		for( size_t k = 0; k < PARTICLEKERNELS_BATCH_SIZE; ++k ) {
+			out = output + i + k;
+			result = &results[0].x + k;
+			out->positionVS = XMFLOAT3(result[0], result[4], result[8]);
+			out->billboard = XMFLOAT2(p[k].billboard.x * sizeScale, p[k].billboard.y * sizeScale);
+			out->angle = result[12];
+			out->life = XMFLOAT3(result[16], result[20], p[k].life.z);
+			out->index = p[k].index;
+		}
+	}
+
+	// Remaining particles
+	for( size_t i = nBatched; i < n; ++i ) {
+		generalParticlesVSReference(output[i], input[i], globals, view);
+	}
+	return ERROR_SUCCESS;
+}
+
+void ParticleKernels::splineParticlesVSReference(GeneralOutput& output, const ParticleVertexType& input,
+	const DirectX::XMFLOAT4* const spline, const SplineGlobals& globals, const DirectX::XMFLOAT4X4& view) {
+
+	float age, health;
+	particleLife(age, health, input.life, globals.general.time.x);
+
+	// Compute spline parameter and segment index
+	const float t = frac(input.position.x + input.linearVelocity.z * age);
+	const float segmentIndex = t * globals.segments.y;
+	if( !isSegmentValid(segmentIndex, globals) ) {
+		outOfBoundsOutput(output, age, input);
+		return;
+	}
+
+	// Evaluate the spline
+	const XMFLOAT4* const segment = getSegment(spline, segmentIndex, globals);
+	const float* const p0 = &segment[0].x;
+	const float* const p1 = &segment[1].x;
+	const float* const p2 = &segment[2].x;
+	const float* const p3 = &segment[3].x;
+	const float s = frac(segmentIndex);
+	const float invS = 1.0f - s;
+	const float invS2 = invS * invS;
+	const float s2 = s * s;
+
+	// Bezier basis functions, and their derivatives
+	const float b0 = invS2 * invS;
+	const float b1 = (3.0f * s) * invS2;
+	const float b2 = (3.0f * s2) * invS;
+	const float b3 = s2 * s;
+	const float d0 = 3.0f * invS2;
+	const float d1 = (6.0f * invS) * s;
+	const float d2 = 3.0f * s2;
+
+	float splinePosition[3], splineDirection[3];
+	for( size_t i = 0; i < 3; ++i ) {
+		splinePosition[i] = ((b0 * p0[i] + b1 * p1[i]) + b2 * p2[i]) + b3 * p3[i];
+		splineDirection[i] = (d0 * (p1[i] - p0[i]) + d1 * (p2[i] - p1[i])) + d2 * (p3[i] - p2[i]);
+	}
+	normalize3(splineDirection);
+
+	// Basis vectors of the plane normal to the spline
+	const float projection = dot3(splinePosition, splineDirection);
+	float tangent1[3];
+	for( size_t i = 0; i < 3; ++i ) {
+		tangent1[i] = splinePosition[i] - projection * splineDirection[i];
+	}
+	if( tangent1[0] == 0.0f && tangent1[1] == 0.0f && tangent1[2] == 0.0f ) {
+		tangent1[0] = tangent1[0] + 0.0001f;
+	}
+	normalize3(tangent1);
+	const float tangent2[3] = {
+		tangent1[1] * splineDirection[2] - tangent1[2] * splineDirection[1],
+		tangent1[2] * splineDirection[0] - tangent1[0] * splineDirection[2],
+		tangent1[0] * splineDirection[1] - tangent1[1] * splineDirection[0]
+	};
+
+	// Offset from the spline
+	const float radius = input.position.y + input.linearVelocity.x * age;
+	const float angle = input.position.z + input.linearVelocity.y * age;
+	XMVECTOR sinVector, cosVector;
+	XMVectorSinCos(&sinVector, &cosVector, XMVectorReplicate(angle));
+	const float sinAngle = XMVectorGetX(sinVector);
+	const float cosAngle = XMVectorGetX(cosVector);
+	float offset[3];
+	for( size_t i = 0; i < 3; ++i ) {
+		offset[i] = tangent1[i] * cosAngle + tangent2[i] * sinAngle;
+	}
+
+	// World and view space position, and offset direction
+	float world[4], position[3], worldOffset[3], offsetVS[3];
+	transformPoint(world,
+		radius * offset[0] + splinePosition[0],
+		radius * offset[1] + splinePosition[1],
+		radius * offset[2] + splinePosition[2],
+		globals.general.world);
+	transformHomogeneous(position, world, view);
+	transformDirection(worldOffset, offset[0], offset[1], offset[2], globals.general.world);
+	transformDirection(offsetVS, worldOffset[0], worldOffset[1], worldOffset[2], view);
+	output.positionVS = XMFLOAT3(position[0], position[1], position[2]);
+
+	// Billboard
+	output.billboard = XMFLOAT2(input.billboard.x, input.billboard.y);
+
+	// Angular motion, reversed if the direction of motion is away from the viewer
+	output.angle = input.billboard.z * age;
+	if( dot3(offsetVS, position) > 0.0f ) {
+		output.angle = output.angle * -1.0f;
+	}
+
+	// Updated life information
+	output.life = XMFLOAT3(age, health, input.life.z);
+
+	// Index - pass-through
+	output.index = input.index;
+}
+
+HRESULT ParticleKernels::splineParticlesVS(GeneralOutput* const output, const ParticleVertexType* const input,
+	const size_t n, const DirectX::XMFLOAT4* const spline, const size_t nSplineSlots,
+	const SplineGlobals& globals, const DirectX::XMFLOAT4X4& view) {
+
+	if( n == 0 ) {
+		return ERROR_SUCCESS;
+	} else if( output == 0 || input == 0 || spline == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	} else if( globals.segments.x > 0.0f &&
+		(globals.slots.y < 1.0f || static_cast<size_t>(globals.slots.y) > nSplineSlots) ) {
+		// Slot indices are taken modulo the number of slots given in the constant buffer
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+
+	XMVECTOR w[4][4];
+	XMVECTOR v[4][4];
+	PARTICLEKERNELS_SPLAT_MATRIX(w, globals.general.world);
+	PARTICLEKERNELS_SPLAT_MATRIX(v, view);
+	const XMVECTOR zero = XMVectorZero();
+	const XMVECTOR one = XMVectorReplicate(1.0f);
+	const XMVECTOR three = XMVectorReplicate(3.0f);
+	const XMVECTOR six = XMVectorReplicate(6.0f);
+	const XMVECTOR minusOne = XMVectorReplicate(-1.0f);
+	const XMVECTOR epsilon = XMVectorReplicate(0.0001f);
+	const XMVECTOR time = XMVectorReplicate(globals.general.time.x);
+	const XMVECTOR capacity = XMVectorReplicate(globals.segments.y);
+
+	// Control points of particles outside the valid segments
+	const XMFLOAT4 zeroSegment[4] = {
+		XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f), XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f),
+		XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f), XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f)
+	};
+
+	XMMATRIX life, velocity, position;
+	XMMATRIX controlPoints[4];
+	XMVECTOR age, health, bz, segmentIndex;
+	XMVECTOR s, invS, invS2, s2, b0, b1, b2, b3, d0, d1, d2;
+	XMVECTOR splinePosition[3], splineDirection[3], tangent1[3], tangent2[3], offset[3];
+	XMVECTOR projection, radius, angle, sinAngle, cosAngle;
+	XMVECTOR world[4], positionVS[3], worldOffset[3], offsetVS[3];
+
+	XMFLOAT4 segmentIndices;
+	const XMFLOAT4* segments[PARTICLEKERNELS_BATCH_SIZE];
+	bool valid[PARTICLEKERNELS_BATCH_SIZE];
+
+	// Transposed outputs: view position (3), angle, age, health
+	XMFLOAT4 results[6];
+	const float* result = 0;
+
+	const ParticleVertexType* p = 0;
+	GeneralOutput* out = 0;
+	const size_t nBatched = n - (n % PARTICLEKERNELS_BATCH_SIZE);
+	for( size_t i = 0; i < nBatched; i += PARTICLEKERNELS_BATCH_SIZE ) {
+		p = input + i;
+
+		// Each row of these matrices holds one component of four particles
+		life = XMMatrixTranspose(XMMATRIX(
+			XMLoadFloat4(&p[0].life), XMLoadFloat4(&p[1].life),
+			XMLoadFloat4(&p[2].life), XMLoadFloat4(&p[3].life)));
+		velocity = XMMatrixTranspose(XMMATRIX(
+			XMLoadFloat4(&p[0].linearVelocity), XMLoadFloat4(&p[1].linearVelocity),
+			XMLoadFloat4(&p[2].linearVelocity), XMLoadFloat4(&p[3].linearVelocity)));
+		position = XMMatrixTranspose(XMMATRIX(
+			XMLoadFloat3(&p[0].position), XMLoadFloat3(&p[1].position),
+			XMLoadFloat3(&p[2].position), XMLoadFloat3(&p[3].position)));
+		bz = XMVectorSet(p[0].billboard.z, p[1].billboard.z, p[2].billboard.z, p[3].billboard.z);
+
+		particleLifeVector(age, health, life, time);
+
+		// Spline parameter and segment index
+		segmentIndex = XMVectorMultiply(fracVector(XMVectorAdd(position.r[0], XMVectorMultiply(velocity.r[2], age))), capacity);
+
+		// Gather the control points of each particle's segment
+		XMStoreFloat4(&segmentIndices, segmentIndex);
+		for( size_t k = 0; k < PARTICLEKERNELS_BATCH_SIZE; ++k ) {
+			valid[k] = isSegmentValid((&segmentIndices.x)[k], globals);
+			segments[k] = valid[k] ? getSegment(spline, (&segmentIndices.x)[k], globals) : zeroSegment;
+		}
+		for( size_t j = 0; j < 4; ++j ) {
+			controlPoints[j] = XMMatrixTranspose(XMMATRIX(
+				XMLoadFloat4(segments[0] + j), XMLoadFloat4(segments[1] + j),
+				XMLoadFloat4(segments[2] + j), XMLoadFloat4(segments[3] + j)));
+		}
+
+		// Bezier basis functions, and their derivatives
+		s = fracVector(segmentIndex);
+		invS = XMVectorSubtract(one, s);
+		invS2 = XMVectorMultiply(invS, invS);
+		s2 = XMVectorMultiply(s, s);
+		b0 = XMVectorMultiply(invS2, invS);
+		b1 = XMVectorMultiply(XMVectorMultiply(three, s), invS2);
+		b2 = XMVectorMultiply(XMVectorMultiply(three, s2), invS);
+		b3 = XMVectorMultiply(s2, s);
+		d0 = XMVectorMultiply(three, invS2);
+		d1 = XMVectorMultiply(XMVectorMultiply(six, invS), s);
+		d2 = XMVectorMultiply(three, s2);
+
+		for( size_t j = 0; j < 3; ++j ) {
+			splinePosition[j] = XMVectorAdd(XMVectorAdd(XMVectorAdd(
+				XMVectorMultiply(b0, controlPoints[0].r[j]), XMVectorMultiply(b1, controlPoints[1].r[j])),
+				XMVectorMultiply(b2, controlPoints[2].r[j])), XMVectorMultiply(b3, controlPoints[3].r[j]));
+			splineDirection[j] = XMVectorAdd(XMVectorAdd(
+				XMVectorMultiply(d0, XMVectorSubtract(controlPoints[1].r[j], controlPoints[0].r[j])),
+				XMVectorMultiply(d1, XMVectorSubtract(controlPoints[2].r[j], controlPoints[1].r[j]))),
+				XMVectorMultiply(d2, XMVectorSubtract(controlPoints[3].r[j], controlPoints[2].r[j])));
+		}
+		normalize3Vector(splineDirection);
+
+		// Basis vectors of the plane normal to the spline
+		projection = dot3Vector(splinePosition, splineDirection);
+		for( size_t j = 0; j < 3; ++j ) {
+			tangent1[j] = XMVectorSubtract(splinePosition[j], XMVectorMultiply(projection, splineDirection[j]));
+		}
+		tangent1[0] = XMVectorSelect(tangent1[0], XMVectorAdd(tangent1[0], epsilon), XMVectorAndInt(
+			XMVectorAndInt(XMVectorEqual(tangent1[0], zero), XMVectorEqual(tangent1[1], zero)),
+			XMVectorEqual(tangent1[2], zero)));
+		normalize3Vector(tangent1);
+		tangent2[0] = XMVectorSubtract(XMVectorMultiply(tangent1[1], splineDirection[2]), XMVectorMultiply(tangent1[2], splineDirection[1]));
+		tangent2[1] = XMVectorSubtract(XMVectorMultiply(tangent1[2], splineDirection[0]), XMVectorMultiply(tangent1[0], splineDirection[2]));
+		tangent2[2] = XMVectorSubtract(XMVectorMultiply(tangent1[0], splineDirection[1]), XMVectorMultiply(tangent1[1], splineDirection[0]));
+
+		// Offset from the spline
+		radius = XMVectorAdd(position.r[1], XMVectorMultiply(velocity.r[0], age));
+		angle = XMVectorAdd(position.r[2], XMVectorMultiply(velocity.r[1], age));
+		XMVectorSinCos(&sinAngle, &cosAngle, angle);
+		for( size_t j = 0; j < 3; ++j ) {
+			offset[j] = XMVectorAdd(XMVectorMultiply(tangent1[j], cosAngle), XMVectorMultiply(tangent2[j], sinAngle));
+		}
+
+		// World and view space position, and offset direction
+		transformPointVector(world,
+			XMVectorAdd(XMVectorMultiply(radius, offset[0]), splinePosition[0]),
+			XMVectorAdd(XMVectorMultiply(radius, offset[1]), splinePosition[1]),
+			XMVectorAdd(XMVectorMultiply(radius, offset[2]), splinePosition[2]),
+			w);
+		transformHomogeneousVector(positionVS, world, v);
+		transformDirectionVector(worldOffset, offset[0], offset[1], offset[2], w);
+		transformDirectionVector(offsetVS, worldOffset[0], worldOffset[1], worldOffset[2], v);
+
+		// Angular motion, reversed if the direction of motion is away from the viewer
+		angle = XMVectorMultiply(bz, age);
+		angle = XMVectorSelect(angle, XMVectorMultiply(angle, minusOne), XMVectorGreater(dot3Vector(offsetVS, positionVS), zero));
+
+		// Output
+		XMStoreFloat4(&results[0], positionVS[0]);
+		XMStoreFloat4(&results[1], positionVS[1]);
+		XMStoreFloat4(&results[2], positionVS[2]);
+		XMStoreFloat4(&results[3], angle);
+		XMStoreFloat4(&results[4], age);
+		XMStoreFloat4(&results[5], health);
+		for( size_t k = 0; k < PARTICLEKERNELS_BATCH_SIZE; ++k ) {
+			out = output + i + k;
+			result = &results[0].x + k;
+			if( !valid[k] ) {
+				outOfBoundsOutput(*out, result[16], p[k]);
+				continue;
+			}
+			out->positionVS = XMFLOAT3(result[0], result[4], result[8]);
+			out->billboard = XMFLOAT2(p[k].billboard.x, p[k].billboard.y);
+			out->angle = result[12];
+			out->life = XMFLOAT3(result[16], result[20], p[k].life.z);
+			out->index = p[k].index;
+		}
+	}
+
+	// Remaining particles
+	for( size_t i = nBatched; i < n; ++i ) {
+		splineParticlesVSReference(output[i], input[i], spline, globals, view);
+	}
+	return ERROR_SUCCESS;
+}
+
+float ParticleKernels::hlslMod(const float a, const float b) {
+	const float q = a / b;
+	const float absQ = std::abs(q);
+	const float f = absQ - std::floor(absQ);
+	return ((q >= q * -1.0f) ? f : f * -1.0f) * b;
+}
@@ -0,0 +1,204 @@
+/*
+ParticleLOD.cpp
+---------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: BurstVertexGenerator.cpp
+
+Description
+  -Implementation of the ParticleLOD class
+*/
+
+#include "ParticleLOD.h"
+#include "defs.h"
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include <exception>
+
+using namespace DirectX;
+
+namespace {
+	// Number of bits needed to represent the values from zero to n - 1
+	inline size_t bitsNeeded(const size_t n) {
+		size_t bits = 0;
+		while( (static_cast<size_t>(1) << bits) < n ) {
+			++bits;
+		}
+		return bits;
+	}
+
+	/* Interleaves the bits of 'row' and 'column', starting with the least
+	   significant bit of 'column', and reverses the result, which is 'nBits' long
+	 */
+	inline unsigned long long reversedMortonCode(const size_t row, const size_t column,
+		const size_t rowBits, const size_t columnBits) {
+		const size_t maxBits = (rowBits > columnBits) ? rowBits : columnBits;
+		const size_t nBits = rowBits + columnBits;
+		unsigned long long code = 0;
+		size_t bit = 0;
+		for( size_t i = 0; i < maxBits; ++i ) {
+			if( i < columnBits ) {
+				code |= static_cast<unsigned long long>((column >> i) & 1) << (nBits - 1 - bit);
+				++bit;
+			}
+			if( i < rowBits ) {
+				code |= static_cast<unsigned long long>((row >> i) & 1) << (nBits - 1 - bit);
+				++bit;
+			}
+		}
+		return code;
+	}
+}
+
+ParticleLOD::Parameters::Parameters(void) :
+	fullDetailSize(PARTICLELOD_FULL_DETAIL_SIZE_DEFAULT),
+	nLevels(PARTICLELOD_LEVELS_DEFAULT),
+	sizeCompensation(PARTICLELOD_SIZE_COMPENSATION_DEFAULT),
+	alphaCompensation(PARTICLELOD_ALPHA_COMPENSATION_DEFAULT),
+	maxAlphaScale(PARTICLELOD_MAX_ALPHA_SCALE_DEFAULT)
+{}
+
+ParticleLOD::ParticleLOD(const Parameters& parameters) :
+	m_parameters(parameters)
+{
+	if( !(parameters.fullDetailSize > 0.0f) ) {
+		throw std::exception("The full detail size of a ParticleLOD object must be positive.");
+	} else if( parameters.nLevels < PARTICLELOD_LEVELS_MIN || parameters.nLevels > PARTICLELOD_LEVELS_MAX ) {
+		throw std::exception("The number of levels of detail of a ParticleLOD object is out of range.");
+	} else if( parameters.sizeCompensation < 0.0f || parameters.alphaCompensation < 0.0f ) {
+		throw std::exception("The compensation exponents of a ParticleLOD object must not be negative.");
+	} else if( parameters.maxAlphaScale < PARTICLELOD_MAX_ALPHA_SCALE_MIN ) {
+		throw std::exception("The maximum transparency multiplier of a ParticleLOD object is too low.");
+	}
+}
+
+ParticleLOD::~ParticleLOD(void) {}
+
+float ParticleLOD::projectedSize(const XMFLOAT4X4& world, const float radius,
+	const XMFLOAT4X4& view, const XMFLOAT4X4& projection) {
+
+	// Largest scaling factor of the world transformation
+	const XMMATRIX worldMatrix = XMLoadFloat4x4(&world);
+	float scale = XMVectorGetX(XMVector3Length(worldMatrix.r[0]));
+	float rowScale = XMVectorGetX(XMVector3Length(worldMatrix.r[1]));
+	scale = (rowScale > scale) ? rowScale : scale;
+	rowScale = XMVectorGetX(XMVector3Length(worldMatrix.r[2]));
+	scale = (rowScale > scale) ? rowScale : scale;
+	const float worldRadius = radius * scale;
+
+	// Centre of the sphere in view space
+	XMFLOAT3 centre;
+	XMStoreFloat3(&centre, XMVector3TransformCoord(
+		XMVector3TransformCoord(XMVectorZero(), worldMatrix),
+		XMLoadFloat4x4(&view)));
+
+	const float distance = std::sqrt(centre.x * centre.x + centre.y * centre.y + centre.z * centre.z);
+	if( distance <= worldRadius ) {
+		return FLT_MAX;
+	} else if( centre.z < -worldRadius ) {
+		return 0.0f;
+	}
+
+	// The projection maps the half-height of the view frustum to one, out of a total height of two
+	return worldRadius * projection._22 / (2.0f * distance);
+}
+
+void ParticleLOD::select(Selection& selection, const float projectedSize, const size_t nVertices) const {
+	float fraction = projectedSize / m_parameters.fullDetailSize;
+	fraction *= fraction;
+
+	// Use the smallest fraction of vertices which is at least the desired fraction
+	size_t level = 0;
+	float levelFraction = 0.5f;
+	while( (level + 1) < m_parameters.nLevels && levelFraction >= fraction ) {
+		++level;
+		levelFraction *= 0.5f;
+	}
+	selectLevel(selection, level, nVertices);
+}
+
+void ParticleLOD::selectLevel(Selection& selection, const size_t level, const size_t nVertices) const {
+	selection.level = (level < m_parameters.nLevels) ? level : (m_parameters.nLevels - 1);
+	selection.fraction = std::ldexp(1.0f, -static_cast<int>(selection.level));
+
+	selection.nVertices = static_cast<size_t>(std::ceil(selection.fraction * static_cast<float>(nVertices)));
+	if( selection.nVertices > nVertices ) {
+		selection.nVertices = nVertices;
+	} else if( selection.nVertices == 0 && nVertices > 0 ) {
+		selection.nVertices = 1;
+	}
+
+	selection.compensation.x = std::pow(selection.fraction, -0.5f * m_parameters.sizeCompensation);
+	selection.compensation.y = std::pow(selection.fraction, -m_parameters.alphaCompensation);
+	if( selection.compensation.y > m_parameters.maxAlphaScale ) {
+		selection.compensation.y = m_parameters.maxAlphaScale;
+	}
+}
+
+void ParticleLOD::selectFullDetail(Selection& selection, const size_t nVertices) {
+	selection.level = 0;
+	selection.nVertices = nVertices;
+	selection.fraction = 1.0f;
+	selection.compensation = XMFLOAT2(1.0f, 1.0f);
+}
+
+size_t ParticleLOD::getNumberOfLevels(void) const {
+	return m_parameters.nLevels;
+}
+
+void ParticleLOD::progressiveOrder(std::vector<size_t>& order, const size_t nRows, const size_t nColumns) {
+	const size_t rowBits = bitsNeeded(nRows);
+	const size_t columnBits = bitsNeeded(nColumns);
+	const size_t nCells = nRows * nColumns;
+
+	std::vector<std::pair<unsigned long long, size_t> > codes(nCells);
+	size_t cell = 0;
+	for( size_t row = 0; row < nRows; ++row ) {
+		for( size_t column = 0; column < nColumns; ++column ) {
+			codes[cell].first = reversedMortonCode(row, column, rowBits, columnBits);
+			codes[cell].second = cell;
+			++cell;
+		}
+	}
+
+	// Codes are unique, so the order does not depend on the sorting algorithm
+	std::sort(codes.begin(), codes.end());
+
+	order.resize(nCells);
+	for( cell = 0; cell < nCells; ++cell ) {
+		order[cell] = codes[cell].second;
+	}
+}
+
+HRESULT ParticleLOD::reorder(ParticleVertexType* const vertices, const size_t nRows, const size_t nColumns) {
+	if( vertices == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+
+	std::vector<size_t> order;
+	progressiveOrder(order, nRows, nColumns);
+
+	const std::vector<ParticleVertexType> gridOrder(vertices, vertices + order.size());
+	for( size_t i = 0; i < order.size(); ++i ) {
+		vertices[i] = gridOrder[order[i]];
+	}
+	return ERROR_SUCCESS;
+}
+
+float ParticleLOD::estimateFill(const Selection& selection, const float projectedSize,
+	const float radius, const XMFLOAT2& billboard, const float viewportHeight) {
+	if( !(radius > 0.0f) ) {
+		return 0.0f;
+	}
+
+	// Pixels per unit length in model space, at the centre of the bounding sphere
+	const float pixelsPerUnit = projectedSize * viewportHeight / radius;
+	const float width = billboard.x * selection.compensation.x * pixelsPerUnit;
+	const float height = billboard.y * selection.compensation.x * pixelsPerUnit;
+	return static_cast<float>(selection.nVertices) * width * height;
+}
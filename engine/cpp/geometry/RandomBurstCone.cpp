@@ -19,8 +19,7 @@ Description
 #pragma once
 
 #include "RandomBurstCone.h"
-#include <random>
-#include <cmath> // for cbrt()
+#include <cmath> // for sqrtf()
 
 using namespace DirectX;
 using std::wstring;
@@ -29,7 +28,8 @@ RandomBurstCone::RandomBurstCone(const bool enableLogging, const std::wstring& m
 	Config* sharedConfig) :
 	UniformBurstSphere(enableLogging, msgPrefix, sharedConfig, false),
 	m_maxPhi(RANDOMBURSTCONE_MAX_PHI_DEFAULT), m_minR(RANDOMBURSTCONE_RADIUS_MIN_DEFAULT),
-	m_maxR(RANDOMBURSTCONE_RADIUS_MAX_DEFAULT)
+	m_maxR(RANDOMBURSTCONE_RADIUS_MAX_DEFAULT),
+	m_rng(COUNTERRNG_SEED_DEFAULT, CounterRNG::getUniqueInstanceId())
 {
 	const std::wstring configUserScope = RANDOMBURSTCONE_CONFIGUSER_SCOPE;
 	const std::wstring logUserScope = RANDOMBURSTCONE_LOGUSER_SCOPE;
@@ -44,150 +44,63 @@ HRESULT RandomBurstCone::addVertices(
 		INVARIANTPARTICLES_VERTEX_TYPE* const vertices,
 		size_t& vertexOffset) {
 
-		HRESULT result = ERROR_SUCCESS;
-		wstring msg;
-
-		// Key indices
-		size_t endGrid = m_nColumns * m_nRows; // One beyond the index of the last grid location
-
-		// Counters
 		INVARIANTPARTICLES_VERTEX_TYPE* vertex = vertices + vertexOffset;
-		size_t i = 0; // First dimension counter
-		size_t j = 0; // Second dimension counter
-
-		// Surface parameters
-		float u = 0.0f;
-		float v = 0.0f;
-		float w = 1.0f;
-
-		// Random number generation
-		static std::default_random_engine generator;
-		static std::uniform_real_distribution<float> distribution(0.0, 1.0);
 
 		// Define diagnostic "reference" particles - Non random
 		// ----------------------------------------------------
 
 		if (m_createPoles) {
-
-			// South pole
-			INVARIANTPARTICLES_VERTEX_TYPE* pole = vertex + endGrid;
-			pole->position = XMFLOAT3(0.0f, -1.0f, 0.0f);
-			pole->billboard = XMFLOAT3(
-				m_billboardWidth,
-				m_billboardHeight,
-				m_billboardSpin);
-			pole->linearVelocity = XMFLOAT4(
-				pole->position.x,
-				pole->position.y,
-				pole->position.z,
-				m_linearSpeed);
-			pole->life = XMFLOAT4(
-				m_creationTimeOffset,
-				m_lifeAmount,
-				m_decay,
-				m_deathCutoff);
-			if (m_debugColorCasts) {
-				pole->index = XMFLOAT4(0.0f, 1.0f, 1.0f, 1.0f);
-			}
-			else {
-				pole->index = m_colorCast;
-			}
-
-			// North pole
-			++pole; // North pole immediately follows south pole
-			pole->position = XMFLOAT3(0.0f, 1.0f, 0.0f);
-			pole->billboard = XMFLOAT3(
-				m_billboardWidth,
-				m_billboardHeight,
-				m_billboardSpin);
-			pole->linearVelocity = XMFLOAT4(
-				pole->position.x,
-				pole->position.y,
-				pole->position.z,
-				m_linearSpeed);
-			pole->life = XMFLOAT4(
-				m_creationTimeOffset,
-				m_lifeAmount,
-				m_decay,
-				m_deathCutoff);
-			if (m_debugColorCasts) {
-				pole->index = XMFLOAT4(0.0f, 0.0f, 1.0f, 1.0f);
-			}
-			else {
-				pole->index = m_colorCast;
-			}
+			// One beyond the index of the last grid location
+			addPoleVertices(vertex + m_nColumns * m_nRows);
 		}
 
 		// Define vertices on the steady-state cone
 		// ----------------------------------------
-		for (i = 0; i < m_nRows; ++i) {
-
-			v = distribution(generator);
-
-			for (j = 0; j < m_nColumns; ++j) {
-
-				u = distribution(generator);
-				w = distribution(generator);
-
-				// Set vertex properties
-				if (FAILED(uvwToPosition(vertex->position, u, v, w))) {
-					msg = L"uvToPosition() failed";
-					result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-				} if( FAILED(uvwToBillboard(vertex->billboard, u, v, w)) ) {
-					msg = L"uvToBillboard() failed";
-					result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-				} if( FAILED(uvwToLinearVelocity(vertex->linearVelocity, u, v, w)) ) {
-					msg = L"uvToLinearVelocity() failed";
-					result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-				} if( FAILED(uvwToLife(vertex->life, u, v, w)) ) {
-					msg = L"uvToLife() failed";
-					result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-				} if( FAILED(uvwToIndex(vertex->index, u, v, w)) ) {
-					msg = L"uvToIndex() failed";
-					result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-				}
-
-				if (FAILED(result)) {
-					msg += L" at coordinates (u,v,w) = ";
-					msg += std::to_wstring(u);
-					msg += L", ";
-					msg += std::to_wstring(v);
-					msg += L", ";
-					msg += std::to_wstring(w);
-					msg += L").";
-					logMessage(msg);
-					return result;
-				}
 
-				++vertex;
-			}
+		/* Random number generation - One 'v' value, and 'u' and 'w' values for each column, per row,
+		   starting from the beginning of the sequence of 'm_rng'
+		 */
+		BurstVertexGenerator::Parameters parameters;
+		getGeneratorParameters(parameters);
+		BurstVertexGenerator::ConeParameters coneParameters;
+		getConeParameters(coneParameters);
+		BurstVertexGenerator generator(m_workerPool);
+		if (FAILED(generator.cone(vertex, parameters, coneParameters, m_rng))) {
+			logMessage(L"Failed to generate the grid of particles.");
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+		if (FAILED(ParticleLOD::reorder(vertex, m_nRows, m_nColumns))) {
+			logMessage(L"Failed to place the grid of particles in level of detail order.");
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 		}
 
 		// Adjust vertex offset
 		vertexOffset += getNumberOfVerticesToAdd();
 
-		return result;
+		return ERROR_SUCCESS;
 }
 
 HRESULT RandomBurstCone::uvwToPosition(DirectX::XMFLOAT3& position, const float u, const float v, const float w) const {
 	if( u < 0.0f || u > 1.0f || v < 0.0f || v > 1.0f || w < 0.0f || w > 1.0f ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
 	}
-	// v = phi / XM_PI
-	// u = theta / XM_2PI
-	float radius = cbrtf(w) * (m_maxR - m_minR) + m_minR;
-	float sinPhi, cosPhi, sinTheta, cosTheta;
-	XMScalarSinCos(&sinPhi, &cosPhi, XM_PI * v * m_maxPhi);
-	XMScalarSinCos(&sinTheta, &cosTheta, XM_2PI * u);
-	position.x = radius * cosTheta * sinPhi;
-	position.y = radius *cosPhi;
-	position.z = radius * sinTheta * sinPhi;
-
-	// Rotate to forward direction
-	XMStoreFloat3(&position, XMVector3Transform(XMLoadFloat3(&position), XMMatrixRotationX(XM_PIDIV2)));
+	BurstVertexGenerator::ConeParameters coneParameters;
+	getConeParameters(coneParameters);
+	BurstVertexGenerator::conePosition(position, coneParameters, u, v, w);
 	return ERROR_SUCCESS;
 }
 
+void RandomBurstCone::getConeParameters(BurstVertexGenerator::ConeParameters& coneParameters) const {
+	coneParameters.maxPhi = m_maxPhi;
+	coneParameters.minR = m_minR;
+	coneParameters.maxR = m_maxR;
+}
+
+float RandomBurstCone::getLODRadius(const float time) const {
+	const float initialRadius = (m_createPoles && m_maxR < 1.0f) ? 1.0f : m_maxR;
+	return getBurstRadius(initialRadius, time);
+}
+
 HRESULT RandomBurstCone::uvwToBillboard(DirectX::XMFLOAT3& billboard, const float u, const float v, const float w) const {
 	if( u < 0.0f || u > 1.0f || v < 0.0f || v > 1.0f || w < 0.0f || w > 1.0f ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
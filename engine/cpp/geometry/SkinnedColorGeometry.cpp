@@ -39,6 +39,7 @@ SkinnedColorGeometry::SkinnedColorGeometry(const bool enableLogging, const std::
 	m_bones(0), m_invBindMatrices(0),
 	m_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST),
 	m_vertexCount(0), m_indexCount(0), m_boneCount(0),
+	m_animation(0), m_animationTransform(0),
 	m_rendererType(0), m_material(0),
 	m_blend(SKINNEDCOLORGEOMETRY_BLEND_DEFAULT),
 	m_renderLighting(SKINNEDCOLORGEOMETRY_USE_LIGHTING_FLAG_DEFAULT)
@@ -53,6 +54,7 @@ SkinnedColorGeometry::SkinnedColorGeometry(const bool enableLogging, const std::
 	m_bones(0), m_invBindMatrices(0),
 	m_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST),
 	m_vertexCount(0), m_indexCount(0), m_boneCount(0),
+	m_animation(0), m_animationTransform(0),
 	m_rendererType(0), m_material(0),
 	m_blend(SKINNEDCOLORGEOMETRY_BLEND_DEFAULT),
 	m_renderLighting(SKINNEDCOLORGEOMETRY_USE_LIGHTING_FLAG_DEFAULT)
@@ -360,7 +362,18 @@ HRESULT SkinnedColorGeometry::updateAndBindBoneBuffers(ID3D11DeviceContext* cons
 
 	// Copy the matrices into the buffer.
 	std::vector<Transformable*>::size_type i = 0;
-	for( i = 0; i < m_boneCount; ++i ) {
+	if( m_animation != 0 ) {
+		result = m_animationTransform->getWorldTransform(storedWorldMatrix);
+		if( FAILED(result) ) {
+			logMessage(L"Failed to obtain world transformation of animated model.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		} else if( FAILED(m_animation->writeBoneMatrices(positionTransformPtr, normalTransformPtr,
+			m_invBindMatrices, storedWorldMatrix)) ) {
+			logMessage(L"Failed to obtain bone transformations from animation.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+	}
+	for( i = 0; m_animation == 0 && i < m_boneCount; ++i ) {
 		result = (*m_bones)[i]->getWorldTransform(storedWorldMatrix);
 		if( FAILED(result) ) {
 			logMessage(L"Failed to obtain bone world transformation from Transformable at index " + std::to_wstring(i));
@@ -399,6 +412,19 @@ HRESULT SkinnedColorGeometry::setTransformables(const std::vector<Transformable*
 	return ERROR_SUCCESS;
 }
 
+HRESULT SkinnedColorGeometry::setAnimation(const AnimationSampler* const animation, const Transformable* const transform) {
+	if( animation != 0 ) {
+		if( transform == 0 ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+		} else if( animation->getNumberOfBones() != m_boneCount ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+		}
+	}
+	m_animation = animation;
+	m_animationTransform = (animation == 0) ? 0 : transform;
+	return ERROR_SUCCESS;
+}
+
 size_t SkinnedColorGeometry::getIndexCount(void) const {
 	return m_indexCount;
 }
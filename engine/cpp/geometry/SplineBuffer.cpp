@@ -0,0 +1,111 @@
+/*
+SplineBuffer.cpp
+----------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: SplineParticles.cpp
+
+Description
+  -Implementation of the SplineBuffer class
+*/
+
+#include "SplineBuffer.h"
+#include "defs.h"
+
+SplineBuffer::SplineBuffer(const size_t nSlots) :
+	m_nSlots(nSlots), m_buffer(0), m_view(0),
+	m_writer(0), m_uploader()
+{}
+
+SplineBuffer::~SplineBuffer(void) {
+	if( m_writer ) {
+		delete m_writer;
+		m_writer = 0;
+	}
+	if( m_view ) {
+		m_view->Release();
+		m_view = 0;
+	}
+	if( m_buffer ) {
+		m_buffer->Release();
+		m_buffer = 0;
+	}
+}
+
+HRESULT SplineBuffer::initialize(ID3D11Device* const device) {
+	if( m_writer != 0 ) {
+		return ERROR_SUCCESS;
+	} else if( device == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+
+	/* Set up the description of the spline control point buffer.
+	   The buffer is updated in parts, with UpdateSubresource(),
+	   rather than mapped and rewritten every frame.
+	 */
+	D3D11_BUFFER_DESC bufferDesc;
+	bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+	bufferDesc.ByteWidth = SPLINEUPLOADER_SEGMENT_SIZE * m_nSlots;
+	bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+	bufferDesc.CPUAccessFlags = 0;
+	bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+	bufferDesc.StructureByteStride = SPLINEUPLOADER_SEGMENT_SIZE;
+
+	if( FAILED(device->CreateBuffer(&bufferDesc, 0, &m_buffer)) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_LIBRARY_CALL);
+	}
+
+	D3D11_SHADER_RESOURCE_VIEW_DESC viewDesc;
+	viewDesc.Format = DXGI_FORMAT_UNKNOWN;
+	viewDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+	viewDesc.Buffer.ElementOffset = 0;
+	viewDesc.Buffer.ElementWidth = m_nSlots;
+
+	if( FAILED(device->CreateShaderResourceView(m_buffer, &viewDesc, &m_view)) ) {
+		m_buffer->Release();
+		m_buffer = 0;
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_LIBRARY_CALL);
+	}
+
+	m_writer = new D3D11BufferWriter(m_buffer, bufferDesc.ByteWidth);
+	m_uploader.reset();
+	return ERROR_SUCCESS;
+}
+
+HRESULT SplineBuffer::update(ID3D11DeviceContext* const context, const Spline& spline) {
+	if( context == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	} else if( spline.getNumberOfSegmentSlots() != m_nSlots ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+
+	if( m_writer == 0 ) {
+		ID3D11Device* device = 0;
+		context->GetDevice(&device);
+		const HRESULT result = initialize(device);
+		if( device != 0 ) {
+			device->Release();
+		}
+		if( FAILED(result) ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+	}
+
+	m_writer->setContext(context);
+	if( FAILED(m_uploader.upload(*m_writer, spline)) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+	return ERROR_SUCCESS;
+}
+
+ID3D11ShaderResourceView* SplineBuffer::getView(void) const {
+	return m_view;
+}
+
+size_t SplineBuffer::getNumberOfSegmentSlots(void) const {
+	return m_nSlots;
+}
@@ -22,20 +22,18 @@ Description
 
 using namespace DirectX;
 
-#define SPLINEPARTICLES_SEGMENT_SIZE 4 * sizeof(DirectX::XMFLOAT4)
-
 SplineParticles::SplineParticles(const bool enableLogging, const std::wstring& msgPrefix,
 	Usage usage) :
 	InvariantTexturedParticles(enableLogging, msgPrefix, usage),
 	m_spline(0), m_splineCapacity(0),
-	m_splineBuffer(0), m_splineBufferView(0)
+	m_ownSplineBuffer(0), m_splineBuffer(0)
 {}
 
 SplineParticles::SplineParticles(const bool enableLogging, const std::wstring& msgPrefix,
 	Config* sharedConfig) :
 	InvariantTexturedParticles(enableLogging, msgPrefix, sharedConfig),
 	m_spline(0), m_splineCapacity(0),
-	m_splineBuffer(0), m_splineBufferView(0)
+	m_ownSplineBuffer(0), m_splineBuffer(0)
 {}
 
 HRESULT SplineParticles::initialize(ID3D11Device* const device,
@@ -69,35 +67,12 @@ HRESULT SplineParticles::initializeSplineData(ID3D11Device* const device,
 	m_spline = spline;
 	m_splineCapacity = m_spline->getNumberOfSegments(true);
 
-	D3D11_BUFFER_DESC splineBufferDesc;
-	HRESULT result = ERROR_SUCCESS;
-
-	// Set up the description of the spline control point buffers
-	splineBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
-	splineBufferDesc.ByteWidth = SPLINEPARTICLES_SEGMENT_SIZE * m_splineCapacity;
-	splineBufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-	splineBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-	splineBufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
-	splineBufferDesc.StructureByteStride = SPLINEPARTICLES_SEGMENT_SIZE;
-
-	// Now create the spline control point buffers
-	result = device->CreateBuffer(&splineBufferDesc, 0, &m_splineBuffer);
-	if( FAILED(result) ) {
+	// Create the control point buffer
+	m_ownSplineBuffer = new SplineBuffer(m_spline->getNumberOfSegmentSlots());
+	m_splineBuffer = m_ownSplineBuffer;
+	if( FAILED(m_ownSplineBuffer->initialize(device)) ) {
 		logMessage(L"Failed to create spline control point buffer.");
-		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_LIBRARY_CALL);
-	}
-
-	// Create a shader resource view for the spline control point buffer
-	D3D11_SHADER_RESOURCE_VIEW_DESC desc;
-	desc.Format = DXGI_FORMAT_UNKNOWN;
-	desc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
-	desc.Buffer.ElementOffset = 0;
-	desc.Buffer.ElementWidth = m_splineCapacity;
-
-	result = device->CreateShaderResourceView(m_splineBuffer, &desc, &m_splineBufferView);
-	if( FAILED(result) ) {
-		logMessage(L"Failed to create spline control point buffer shader resource view.");
-		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_LIBRARY_CALL);
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
 	return ERROR_SUCCESS;
@@ -130,14 +105,18 @@ HRESULT SplineParticles::setRendererType(const GeometryRendererManager::Geometry
 	return result;
 }
 
-HRESULT SplineParticles::setSpline(const Spline* const spline) {
+HRESULT SplineParticles::setSpline(const Spline* const spline, SplineBuffer* const buffer) {
 	if( spline == 0 ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
 	} else if( spline->getNumberOfSegments(true) != m_splineCapacity ) {
 		logMessage(L"Cannot set this object's spline to a spline with a different capacity.");
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	} else if( buffer != 0 && buffer->getNumberOfSegmentSlots() != spline->getNumberOfSegmentSlots() ) {
+		logMessage(L"Cannot use a spline control point buffer with a different number of segment slots from the spline.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
 	}
 	m_spline = spline;
+	m_splineBuffer = (buffer == 0) ? m_ownSplineBuffer : buffer;
 	return ERROR_SUCCESS;
 }
 
@@ -182,13 +161,9 @@ HRESULT SplineParticles::configure(const std::wstring& scope, const std::wstring
 
 
 SplineParticles::~SplineParticles(void) {
-	if( m_splineBuffer ) {
-		m_splineBuffer->Release();
-		m_splineBuffer = 0;
-	}
-	if( m_splineBufferView ) {
-		m_splineBufferView->Release();
-		m_splineBufferView = 0;
+	if( m_ownSplineBuffer ) {
+		delete m_ownSplineBuffer;
+		m_ownSplineBuffer = 0;
 	}
 }
 
@@ -214,34 +189,28 @@ size_t SplineParticles::getNumberOfSegments(const bool capacity) const {
 	return m_spline->getNumberOfSegments(capacity);
 }
 
-HRESULT SplineParticles::updateAndBindSplineBuffer(ID3D11DeviceContext* const context) {
-	HRESULT result = ERROR_SUCCESS;
-	D3D11_MAPPED_SUBRESOURCE mappedSplineBuffer;
-	DirectX::XMFLOAT4* splineBufferPtr; // Used to access buffer data
+size_t SplineParticles::getNumberOfSegmentSlots(void) const {
+	return m_spline->getNumberOfSegmentSlots();
+}
 
-	result = context->Map(m_splineBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSplineBuffer);
-	if( FAILED(result) ) {
-		logMessage(L"Failed to map spline control points buffer.");
-		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_LIBRARY_CALL);
-	}
+size_t SplineParticles::getSegmentSlotOffset(void) const {
+	return m_spline->getSegmentSlotOffset();
+}
 
-	// Get pointers to the data in the buffers
-	splineBufferPtr = static_cast<DirectX::XMFLOAT4*>(mappedSplineBuffer.pData);
+HRESULT SplineParticles::updateAndBindSplineBuffer(ID3D11DeviceContext* const context) {
+	HRESULT result = ERROR_SUCCESS;
 
-	// Copy the control points into the buffer
-	result = m_spline->getControlPoints(splineBufferPtr, true);
+	// Copy the control points of changed segments into the buffer
+	result = m_splineBuffer->update(context, *m_spline);
 	if( FAILED(result) ) {
-		logMessage(L"Failed to retrieve control points from Spline object.");
+		logMessage(L"Failed to upload control points from Spline object.");
 		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
-	// Unlock the buffer
-	context->Unmap(m_splineBuffer, 0);
-
 	// Set buffer register in the vertex shader
 	// -----------------------------------------
-	ID3D11ShaderResourceView *const bufferViews[1] = { m_splineBufferView };
+	ID3D11ShaderResourceView *const bufferViews[1] = { m_splineBuffer->getView() };
 	context->VSSetShaderResources(0, 1, bufferViews);
 
 	return result;
-}
\ No newline at end of file
+}
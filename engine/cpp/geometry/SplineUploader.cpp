@@ -0,0 +1,71 @@
+/*
+SplineUploader.cpp
+------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Implementation of the SplineUploader class
+*/
+
+#include "SplineUploader.h"
+#include "defs.h"
+
+using namespace DirectX;
+
+SplineUploader::SplineUploader(void) :
+	m_hasSpline(false), m_id(0), m_version(0), m_ranges(), m_staging()
+{}
+
+SplineUploader::~SplineUploader(void) {}
+
+HRESULT SplineUploader::upload(IBufferWriter& writer, const Spline& spline) {
+	const size_t nSlots = spline.getNumberOfSegmentSlots();
+	if( writer.getSize() != nSlots * SPLINEUPLOADER_SEGMENT_SIZE ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+
+	m_ranges.clear();
+	if( !m_hasSpline || m_id != spline.getId() ) {
+		m_ranges.push_back(std::pair<size_t, size_t>(0, nSlots));
+	} else if( spline.getVersion() != m_version ) {
+		spline.getChangedSlotRanges(m_ranges, m_version);
+	}
+
+	HRESULT result = ERROR_SUCCESS;
+	for( size_t i = 0; i < m_ranges.size(); ++i ) {
+		const size_t firstSlot = m_ranges[i].first;
+		const size_t nRangeSlots = m_ranges[i].second;
+		m_staging.resize(4 * nRangeSlots);
+		if( FAILED(spline.getSlotControlPoints(&m_staging[0], firstSlot, nRangeSlots)) ) {
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+			break;
+		}
+		if( FAILED(writer.write(&m_staging[0], firstSlot * SPLINEUPLOADER_SEGMENT_SIZE,
+			nRangeSlots * SPLINEUPLOADER_SEGMENT_SIZE)) ) {
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+			break;
+		}
+	}
+
+	if( FAILED(result) ) {
+		// The buffer may be partially updated
+		reset();
+	} else {
+		m_hasSpline = true;
+		m_id = spline.getId();
+		m_version = spline.getVersion();
+	}
+	return result;
+}
+
+void SplineUploader::reset(void) {
+	m_hasSpline = false;
+	m_id = 0;
+	m_version = 0;
+}
@@ -19,6 +19,7 @@ Description
 */
 
 #include "UniformBurstSphere.h"
+#include <cmath>
 
 using namespace DirectX;
 using std::wstring;
@@ -37,7 +38,8 @@ UniformBurstSphere::UniformBurstSphere(const bool enableLogging, const wstring&
 			UNIFORMBURSTSPHERE_COLORCAST_COLOR_DEFAULT_XYZ,
 			UNIFORMBURSTSPHERE_COLORCAST_WEIGHT_DEFAULT)
 		),
-	m_debugColorCasts(UNIFORMBURSTSPHERE_DEBUG_FLAG_DEFAULT)
+	m_debugColorCasts(UNIFORMBURSTSPHERE_DEBUG_FLAG_DEFAULT),
+	m_workerPool(0)
 {
 	if( configureNow ) {
 		if( FAILED(configure()) ) {
@@ -90,135 +92,128 @@ HRESULT UniformBurstSphere::addVertices(
 	INVARIANTPARTICLES_VERTEX_TYPE* const vertices,
 	size_t& vertexOffset) {
 
-	HRESULT result = ERROR_SUCCESS;
-	wstring msg;
-
-	// Key indices
-	size_t endGrid = m_nColumns * m_nRows; // One beyond the index of the last grid location
-
-	// Counters
 	INVARIANTPARTICLES_VERTEX_TYPE* vertex = vertices + vertexOffset;
-	size_t i = 0; // First dimension counter
-	size_t j = 0; // Second dimension counter
-
-	// Surface parameters
-	float u = 0.0f;
-	float v = 0.0f;
 
 	// Define special particles
 	// ------------------------
 
 	if( m_createPoles ) {
-
-		// South pole
-		INVARIANTPARTICLES_VERTEX_TYPE* pole = vertex + endGrid;
-		pole->position = XMFLOAT3(0.0f, -1.0f, 0.0f);
-		pole->billboard = XMFLOAT3(
-			m_billboardWidth,
-			m_billboardHeight,
-			m_billboardSpin);
-		pole->linearVelocity = XMFLOAT4(
-			pole->position.x,
-			pole->position.y,
-			pole->position.z,
-			m_linearSpeed);
-		pole->life = XMFLOAT4(
-			m_creationTimeOffset,
-			m_lifeAmount,
-			m_decay,
-			m_deathCutoff);
-		if( m_debugColorCasts ) {
-			pole->index = XMFLOAT4(0.0f, 1.0f, 1.0f, 1.0f);
-		} else {
-			pole->index = m_colorCast;
-		}
-
-		// North pole
-		++pole; // North pole immediately follows south pole
-		pole->position = XMFLOAT3(0.0f, 1.0f, 0.0f);
-		pole->billboard = XMFLOAT3(
-			m_billboardWidth,
-			m_billboardHeight,
-			m_billboardSpin);
-		pole->linearVelocity = XMFLOAT4(
-			pole->position.x,
-			pole->position.y,
-			pole->position.z,
-			m_linearSpeed);
-		pole->life = XMFLOAT4(
-			m_creationTimeOffset,
-			m_lifeAmount,
-			m_decay,
-			m_deathCutoff);
-		if( m_debugColorCasts ) {
-			pole->index = XMFLOAT4(0.0f, 0.0f, 1.0f, 1.0f);
-		} else {
-			pole->index = m_colorCast;
-		}
+		// One beyond the index of the last grid location
+		addPoleVertices(vertex + m_nColumns * m_nRows);
 	}
 
 	// Define vertices on the steady-state face
 	// ----------------------------------------
-	for( i = 0; i < m_nRows; ++i ) {
-
-		// Account for pole locations
-		// v = static_cast<float>(i + 1) / static_cast<float>(m_nRows + 2);
-		v = static_cast<float>(i) / static_cast<float>(m_nRows);
-
-		for( j = 0; j < m_nColumns; ++j ) {
-
-			u = static_cast<float>(j) / static_cast<float>(m_nColumns);
-
-			// Set vertex properties
-			if( FAILED(uvToPosition(vertex->position, u, v)) ) {
-				msg = L"uvToPosition() failed";
-				result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-			} if( FAILED(uvToBillboard(vertex->billboard, u, v)) ) {
-				msg = L"uvToBillboard() failed";
-				result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-			} if( FAILED(uvToLinearVelocity(vertex->linearVelocity, u, v)) ) {
-				msg = L"uvToLinearVelocity() failed";
-				result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-			} if( FAILED(uvToLife(vertex->life, u, v)) ) {
-				msg = L"uvToLife() failed";
-				result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-			} if( FAILED(uvToIndex(vertex->index, u, v)) ) {
-				msg = L"uvToIndex() failed";
-				result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-			}
-
-			if( FAILED(result) ) {
-				msg += L" at surface coordinates (u,v) = ";
-				msg += std::to_wstring(u);
-				msg += L", ";
-				msg += std::to_wstring(v);
-				msg += L").";
-				logMessage(msg);
-				return result;
-			}
 
-			++vertex;
-		}
+	BurstVertexGenerator::Parameters parameters;
+	getGeneratorParameters(parameters);
+	BurstVertexGenerator generator(m_workerPool);
+	if( FAILED(generator.sphere(vertex, parameters)) ) {
+		logMessage(L"Failed to generate the grid of particles.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+	if( FAILED(ParticleLOD::reorder(vertex, m_nRows, m_nColumns)) ) {
+		logMessage(L"Failed to place the grid of particles in level of detail order.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
 	// Adjust vertex offset
 	vertexOffset += getNumberOfVerticesToAdd();
 
-	return result;
+	return ERROR_SUCCESS;
+}
+
+void UniformBurstSphere::setWorkerPool(WorkerPool* const pool) {
+	m_workerPool = pool;
+}
+
+float UniformBurstSphere::getBurstRadius(const float initialRadius, const float time) const {
+	// Particles stop moving when their health wraps around (see generalParticlesVS.hlsl)
+	float age = time - m_creationTimeOffset;
+	if( age < 0.0f ) {
+		age = 0.0f;
+	} else if( m_decay > 0.0f && age > (m_lifeAmount / m_decay) ) {
+		age = m_lifeAmount / m_decay;
+	}
+	const float halfDiagonal = 0.5f * std::sqrt(m_billboardWidth * m_billboardWidth + m_billboardHeight * m_billboardHeight);
+	return initialRadius + std::abs(m_linearSpeed) * age + halfDiagonal;
+}
+
+float UniformBurstSphere::getLODRadius(const float time) const {
+	return getBurstRadius(1.0f, time);
+}
+
+void UniformBurstSphere::getGeneratorParameters(BurstVertexGenerator::Parameters& parameters) const {
+	parameters.nColumns = m_nColumns;
+	parameters.nRows = m_nRows;
+	parameters.billboard = XMFLOAT3(
+		m_billboardWidth,
+		m_billboardHeight,
+		m_billboardSpin);
+	parameters.linearSpeed = m_linearSpeed;
+	parameters.life = XMFLOAT4(
+		m_creationTimeOffset,
+		m_lifeAmount,
+		m_decay,
+		m_deathCutoff);
+	parameters.colorCast = m_colorCast;
+	parameters.debugColorCasts = m_debugColorCasts;
+}
+
+void UniformBurstSphere::addPoleVertices(INVARIANTPARTICLES_VERTEX_TYPE* const vertices) const {
+
+	// South pole
+	INVARIANTPARTICLES_VERTEX_TYPE* pole = vertices;
+	pole->position = XMFLOAT3(0.0f, -1.0f, 0.0f);
+	pole->billboard = XMFLOAT3(
+		m_billboardWidth,
+		m_billboardHeight,
+		m_billboardSpin);
+	pole->linearVelocity = XMFLOAT4(
+		pole->position.x,
+		pole->position.y,
+		pole->position.z,
+		m_linearSpeed);
+	pole->life = XMFLOAT4(
+		m_creationTimeOffset,
+		m_lifeAmount,
+		m_decay,
+		m_deathCutoff);
+	if( m_debugColorCasts ) {
+		pole->index = XMFLOAT4(0.0f, 1.0f, 1.0f, 1.0f);
+	} else {
+		pole->index = m_colorCast;
+	}
+
+	// North pole
+	++pole; // North pole immediately follows south pole
+	pole->position = XMFLOAT3(0.0f, 1.0f, 0.0f);
+	pole->billboard = XMFLOAT3(
+		m_billboardWidth,
+		m_billboardHeight,
+		m_billboardSpin);
+	pole->linearVelocity = XMFLOAT4(
+		pole->position.x,
+		pole->position.y,
+		pole->position.z,
+		m_linearSpeed);
+	pole->life = XMFLOAT4(
+		m_creationTimeOffset,
+		m_lifeAmount,
+		m_decay,
+		m_deathCutoff);
+	if( m_debugColorCasts ) {
+		pole->index = XMFLOAT4(0.0f, 0.0f, 1.0f, 1.0f);
+	} else {
+		pole->index = m_colorCast;
+	}
 }
 
 HRESULT UniformBurstSphere::uvToPosition(DirectX::XMFLOAT3& position, const float u, const float v) const {
 	if( u < 0.0f || u > 1.0f || v < 0.0f || v > 1.0f ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
 	}
-	// phi = cos-1(2v - 1)
-	// u = theta / XM_2PI
-	float sinPhi, cosPhi, sinTheta, cosTheta;
-	XMScalarSinCos(&sinPhi, &cosPhi, XMScalarACos(2.0f*v - 1.0f));
-	XMScalarSinCos(&sinTheta, &cosTheta, XM_2PI * u);
-	position.x = cosTheta * sinPhi;
-	position.y = cosPhi;
-	position.z = sinTheta * sinPhi;
+	BurstVertexGenerator::spherePosition(position, u, v);
 	return ERROR_SUCCESS;
 }
 
@@ -0,0 +1,299 @@
+/*
+AnimationClip.cpp
+-----------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Implementation of the AnimationClip class
+*/
+
+#include "AnimationClip.h"
+#include "defs.h"
+#include <exception>
+#include <algorithm> // For std::upper_bound
+#include <cmath> // For std::fmod
+
+using namespace DirectX;
+using namespace DirectX::PackedVector;
+
+namespace {
+
+	/* Returns the value taken by a track with no keys */
+	XMFLOAT4 identityValue(const size_t channel) {
+		if( channel == static_cast<size_t>(AnimationClip::Channel::ROTATION) ) {
+			return XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+		} else if( channel == static_cast<size_t>(AnimationClip::Channel::SCALE) ) {
+			return XMFLOAT4(1.0f, 1.0f, 1.0f, 0.0f);
+		}
+		return XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
+	}
+
+	/* Returns true if all components of 'a' and 'b'
+	   differ by no more than 'tolerance'
+	 */
+	bool isWithinTolerance(const XMVECTOR& a, const XMVECTOR& b, const XMVECTOR& tolerance) {
+		return XMVector4NearEqual(a, b, tolerance);
+	}
+}
+
+AnimationClip::AnimationClip(const size_t nBones, const float duration, const bool loop) :
+	m_nBones(nBones), m_duration(duration), m_loop(loop)
+{
+	if( nBones == 0 ) {
+		throw std::exception("AnimationClip: A clip must animate at least one bone.");
+	} else if( duration <= 0.0f ) {
+		throw std::exception("AnimationClip: The duration of a clip must be greater than zero.");
+	}
+
+	// Each track starts as a single key with an identity value
+	for( size_t c = 0; c < N_CHANNELS; ++c ) {
+		m_trackStart[c].resize(nBones);
+		m_trackLength[c].assign(nBones, 1);
+		m_rangeMin[c].assign(nBones, identityValue(c));
+		m_rangeScale[c].assign(nBones, XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f));
+		m_times[c].assign(nBones, 0);
+		m_values[c].assign(nBones, XMUSHORT4(static_cast<unsigned short>(0),
+			static_cast<unsigned short>(0), static_cast<unsigned short>(0), static_cast<unsigned short>(0)));
+		for( size_t i = 0; i < nBones; ++i ) {
+			m_trackStart[c][i] = i;
+		}
+	}
+}
+
+AnimationClip::~AnimationClip(void) {}
+
+HRESULT AnimationClip::setTrack(const size_t bone, const Channel channel,
+	const float* const times, const DirectX::XMFLOAT4* const values,
+	const size_t nKeys, const float tolerance) {
+
+	if( times == 0 || values == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+	const size_t c = static_cast<size_t>(channel);
+	if( bone >= m_nBones || c >= N_CHANNELS || nKeys == 0 || tolerance < 0.0f ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	for( size_t k = 0; k < nKeys; ++k ) {
+		if( times[k] < 0.0f || times[k] > m_duration || (k > 0 && times[k] <= times[k - 1]) ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+		}
+	}
+
+	// Prepare key values
+	const bool isRotation = (channel == Channel::ROTATION);
+	std::vector<XMFLOAT4> keys(values, values + nKeys);
+	XMVECTOR value;
+	for( size_t k = 0; k < nKeys; ++k ) {
+		value = XMLoadFloat4(&keys[k]);
+		if( isRotation ) {
+			if( XMVectorGetX(XMVector4LengthSq(value)) <= 0.0f ) {
+				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+			}
+			value = XMQuaternionNormalize(value);
+			if( k > 0 && XMVectorGetX(XMVector4Dot(value, XMLoadFloat4(&keys[k - 1]))) < 0.0f ) {
+				value = XMVectorNegate(value);
+			}
+		} else {
+			value = XMVectorSetW(value, 0.0f);
+		}
+		XMStoreFloat4(&keys[k], value);
+	}
+
+	// Key reduction
+	std::vector<size_t> kept;
+	reduceKeys(kept, times, keys, tolerance, isRotation);
+	const size_t nKept = kept.size();
+
+	// Quantization ranges
+	XMVECTOR minValue = XMLoadFloat4(&keys[kept[0]]);
+	XMVECTOR maxValue = minValue;
+	for( size_t k = 1; k < nKept; ++k ) {
+		value = XMLoadFloat4(&keys[kept[k]]);
+		minValue = XMVectorMin(minValue, value);
+		maxValue = XMVectorMax(maxValue, value);
+	}
+	const XMVECTOR extent = XMVectorSubtract(maxValue, minValue);
+	const XMVECTOR zero = XMVectorZero();
+	const XMVECTOR hasExtent = XMVectorGreater(extent, zero);
+	const XMVECTOR quantizationMax = XMVectorReplicate(ANIMATIONCLIP_QUANTIZATION_MAX);
+	const XMVECTOR scale = XMVectorDivide(extent, quantizationMax);
+	// Components with no extent are all stored as zero
+	const XMVECTOR inverseScale = XMVectorSelect(zero,
+		XMVectorDivide(quantizationMax, XMVectorSelect(quantizationMax, extent, hasExtent)),
+		hasExtent);
+
+	// Replace the track
+	const size_t oldStart = m_trackStart[c][bone];
+	const size_t oldLength = m_trackLength[c][bone];
+	std::vector<unsigned short>& trackTimes = m_times[c];
+	std::vector<XMUSHORT4>& trackValues = m_values[c];
+	trackTimes.erase(trackTimes.begin() + oldStart, trackTimes.begin() + oldStart + oldLength);
+	trackValues.erase(trackValues.begin() + oldStart, trackValues.begin() + oldStart + oldLength);
+	trackTimes.insert(trackTimes.begin() + oldStart, nKept, 0);
+	trackValues.insert(trackValues.begin() + oldStart, nKept, XMUSHORT4());
+
+	const float timeScale = ANIMATIONCLIP_QUANTIZATION_MAX / m_duration;
+	for( size_t k = 0; k < nKept; ++k ) {
+		trackTimes[oldStart + k] = static_cast<unsigned short>(times[kept[k]] * timeScale + 0.5f);
+		value = XMVectorMultiply(XMVectorSubtract(XMLoadFloat4(&keys[kept[k]]), minValue), inverseScale);
+		XMStoreUShort4(&trackValues[oldStart + k], value);
+	}
+
+	m_trackLength[c][bone] = nKept;
+	for( size_t i = bone + 1; i < m_nBones; ++i ) {
+		m_trackStart[c][i] = m_trackStart[c][i] + nKept - oldLength;
+	}
+	XMStoreFloat4(&m_rangeMin[c][bone], minValue);
+	XMStoreFloat4(&m_rangeScale[c][bone], scale);
+	return ERROR_SUCCESS;
+}
+
+void AnimationClip::sampleChannel(DirectX::XMFLOAT4* const values, const Channel channel, const float time) const {
+	const size_t c = static_cast<size_t>(channel);
+	const float keyTime = toKeyTime(time);
+
+	const std::vector<size_t>& trackStart = m_trackStart[c];
+	const std::vector<size_t>& trackLength = m_trackLength[c];
+	const XMFLOAT4* const rangeMin = m_rangeMin[c].data();
+	const XMFLOAT4* const rangeScale = m_rangeScale[c].data();
+	const unsigned short* const times = m_times[c].data();
+	const XMUSHORT4* const keys = m_values[c].data();
+
+	const unsigned short* first = 0;
+	const unsigned short* last = 0;
+	const unsigned short* next = 0;
+	size_t k = 0;
+	float span = 0.0f;
+	XMVECTOR minValue, scale, value0, value1;
+
+	for( size_t i = 0; i < m_nBones; ++i ) {
+		minValue = XMLoadFloat4(rangeMin + i);
+		scale = XMLoadFloat4(rangeScale + i);
+
+		// Find the first key after the time
+		first = times + trackStart[i];
+		last = first + trackLength[i];
+		next = std::upper_bound(first, last, keyTime,
+			[](const float t, const unsigned short key) { return t < static_cast<float>(key); });
+
+		if( next == first || next == last ) {
+			// Before the first key or after the last key
+			k = trackStart[i] + ((next == first) ? 0 : (trackLength[i] - 1));
+			XMStoreFloat4(values + i, XMVectorMultiplyAdd(XMLoadUShort4(keys + k), scale, minValue));
+		} else {
+			k = static_cast<size_t>(next - times);
+			value0 = XMVectorMultiplyAdd(XMLoadUShort4(keys + k - 1), scale, minValue);
+			value1 = XMVectorMultiplyAdd(XMLoadUShort4(keys + k), scale, minValue);
+			span = static_cast<float>(times[k]) - static_cast<float>(times[k - 1]);
+			XMStoreFloat4(values + i, XMVectorLerp(value0, value1,
+				(keyTime - static_cast<float>(times[k - 1])) / span));
+		}
+	}
+}
+
+size_t AnimationClip::getNumberOfBones(void) const {
+	return m_nBones;
+}
+
+float AnimationClip::getDuration(void) const {
+	return m_duration;
+}
+
+bool AnimationClip::isLooping(void) const {
+	return m_loop;
+}
+
+size_t AnimationClip::getNumberOfKeys(void) const {
+	size_t nKeys = 0;
+	for( size_t c = 0; c < N_CHANNELS; ++c ) {
+		nKeys += m_times[c].size();
+	}
+	return nKeys;
+}
+
+size_t AnimationClip::getSizeInBytes(void) const {
+	size_t size = 0;
+	for( size_t c = 0; c < N_CHANNELS; ++c ) {
+		size += m_times[c].size() * sizeof(unsigned short);
+		size += m_values[c].size() * sizeof(XMUSHORT4);
+	}
+	size += N_CHANNELS * m_nBones * (2 * sizeof(size_t) + 2 * sizeof(XMFLOAT4));
+	return size;
+}
+
+float AnimationClip::toKeyTime(const float time) const {
+	float t = time;
+	if( m_loop ) {
+		t = std::fmod(t, m_duration);
+		if( t < 0.0f ) {
+			t += m_duration;
+		}
+	} else if( t < 0.0f ) {
+		t = 0.0f;
+	} else if( t > m_duration ) {
+		t = m_duration;
+	}
+	return t * (ANIMATIONCLIP_QUANTIZATION_MAX / m_duration);
+}
+
+void AnimationClip::reduceKeys(std::vector<size_t>& kept,
+	const float* const times, const std::vector<DirectX::XMFLOAT4>& values,
+	const float tolerance, const bool normalize) {
+
+	const size_t nKeys = values.size();
+	const XMVECTOR toleranceVector = XMVectorReplicate(tolerance);
+	kept.clear();
+	kept.push_back(0);
+
+	// Constant tracks need only one key
+	const XMVECTOR firstValue = XMLoadFloat4(&values[0]);
+	size_t k = 1;
+	for( ; k < nKeys; ++k ) {
+		if( !isWithinTolerance(XMLoadFloat4(&values[k]), firstValue, toleranceVector) ) {
+			break;
+		}
+	}
+	if( k == nKeys ) {
+		return;
+	}
+
+	/* Greedily extend each interpolated segment until
+	   a key between its ends is no longer reproduced
+	 */
+	size_t start = 0;
+	size_t end = 0;
+	size_t j = 0;
+	bool fits = true;
+	XMVECTOR startValue, endValue, interpolated;
+	while( start < nKeys - 1 ) {
+		end = start + 1;
+		startValue = XMLoadFloat4(&values[start]);
+		while( end < nKeys - 1 ) {
+			endValue = XMLoadFloat4(&values[end + 1]);
+			fits = true;
+			for( j = start + 1; j <= end; ++j ) {
+				interpolated = XMVectorLerp(startValue, endValue,
+					(times[j] - times[start]) / (times[end + 1] - times[start]));
+				if( normalize ) {
+					interpolated = XMQuaternionNormalize(interpolated);
+				}
+				if( !isWithinTolerance(interpolated, XMLoadFloat4(&values[j]), toleranceVector) ) {
+					fits = false;
+					break;
+				}
+			}
+			if( !fits ) {
+				break;
+			}
+			++end;
+		}
+		kept.push_back(end);
+		start = end;
+	}
+}
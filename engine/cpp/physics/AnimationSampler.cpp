@@ -0,0 +1,252 @@
+/*
+AnimationSampler.cpp
+--------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: TransformSystem.cpp
+
+Description
+  -Implementation of the AnimationSampler class
+*/
+
+#include "AnimationSampler.h"
+#include "defs.h"
+#include <exception>
+
+using namespace DirectX;
+
+/* Loads the values of four consecutive bones, starting at the given index,
+   and transposes them, such that each output vector holds one component
+   of the values of all four bones
+ */
+#define ANIMATIONSAMPLER_LOAD_SOA(v, i) XMMatrixTranspose(XMMATRIX( \
+	XMLoadFloat4(&(v)[(i)]), XMLoadFloat4(&(v)[(i) + 1]), \
+	XMLoadFloat4(&(v)[(i) + 2]), XMLoadFloat4(&(v)[(i) + 3])))
+
+namespace {
+
+	/* Normalizes four quaternions, stored one component per row */
+	void normalizeSoA(XMMATRIX& q) {
+		XMVECTOR lengthSq = XMVectorMultiply(q.r[0], q.r[0]);
+		lengthSq = XMVectorMultiplyAdd(q.r[1], q.r[1], lengthSq);
+		lengthSq = XMVectorMultiplyAdd(q.r[2], q.r[2], lengthSq);
+		lengthSq = XMVectorMultiplyAdd(q.r[3], q.r[3], lengthSq);
+		const XMVECTOR inverseLength = XMVectorReciprocalSqrt(lengthSq);
+		for( size_t j = 0; j < 4; ++j ) {
+			q.r[j] = XMVectorMultiply(q.r[j], inverseLength);
+		}
+	}
+}
+
+AnimationSampler::AnimationSampler(const std::vector<size_t>& parents) :
+	m_nBones(parents.size()), m_parents(parents),
+	m_translations(), m_rotations(), m_scales(),
+	m_blendTranslations(), m_blendRotations(), m_blendScales(),
+	m_modelTransforms()
+{
+	if( m_nBones == 0 ) {
+		throw std::exception("AnimationSampler: A skeleton must have at least one bone.");
+	}
+	for( size_t i = 0; i < m_nBones; ++i ) {
+		if( parents[i] != ANIMATIONSAMPLER_NO_PARENT && parents[i] >= i ) {
+			throw std::exception("AnimationSampler: Parent bones must precede their children.");
+		}
+	}
+
+	const size_t paddedSize = ((m_nBones + ANIMATIONSAMPLER_BATCH_SIZE - 1) /
+		ANIMATIONSAMPLER_BATCH_SIZE) * ANIMATIONSAMPLER_BATCH_SIZE;
+	const XMFLOAT4 zero(0.0f, 0.0f, 0.0f, 0.0f);
+	const XMFLOAT4 identityRotation(0.0f, 0.0f, 0.0f, 1.0f);
+	const XMFLOAT4 identityScale(1.0f, 1.0f, 1.0f, 0.0f);
+	m_translations.resize(paddedSize, zero);
+	m_rotations.resize(paddedSize, identityRotation);
+	m_scales.resize(paddedSize, identityScale);
+	m_blendTranslations.resize(paddedSize, zero);
+	m_blendRotations.resize(paddedSize, identityRotation);
+	m_blendScales.resize(paddedSize, identityScale);
+
+	XMFLOAT4X4 identity;
+	XMStoreFloat4x4(&identity, XMMatrixIdentity());
+	m_modelTransforms.resize(paddedSize, identity);
+}
+
+AnimationSampler::~AnimationSampler(void) {}
+
+HRESULT AnimationSampler::sample(const AnimationClip& clip, const float time) {
+	if( clip.getNumberOfBones() != m_nBones ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	sampleClip(clip, time, m_translations, m_rotations, m_scales);
+	computeLocalTransforms(false, 0.0f);
+	computeHierarchy();
+	return ERROR_SUCCESS;
+}
+
+HRESULT AnimationSampler::blend(const AnimationClip& clipA, const float timeA,
+	const AnimationClip& clipB, const float timeB, const float weight) {
+	if( clipA.getNumberOfBones() != m_nBones || clipB.getNumberOfBones() != m_nBones ||
+		weight < 0.0f || weight > 1.0f ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	sampleClip(clipA, timeA, m_translations, m_rotations, m_scales);
+	sampleClip(clipB, timeB, m_blendTranslations, m_blendRotations, m_blendScales);
+	computeLocalTransforms(true, weight);
+	computeHierarchy();
+	return ERROR_SUCCESS;
+}
+
+HRESULT AnimationSampler::writeBoneMatrices(DirectX::XMFLOAT4X4* const positionTransforms,
+	DirectX::XMFLOAT4X4* const normalTransforms,
+	const DirectX::XMFLOAT4X4* const invBindMatrices,
+	const DirectX::XMFLOAT4X4& world) const {
+
+	if( positionTransforms == 0 || normalTransforms == 0 || invBindMatrices == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+
+	const XMMATRIX worldMatrix = XMLoadFloat4x4(&world);
+	XMMATRIX transform;
+	for( size_t i = 0; i < m_nBones; ++i ) {
+		transform = XMMatrixMultiply(
+			XMMatrixMultiply(XMLoadFloat4x4(invBindMatrices + i), XMLoadFloat4x4(&m_modelTransforms[i])),
+			worldMatrix);
+		// Transpose before sending to graphics system
+		XMStoreFloat4x4(positionTransforms + i, XMMatrixTranspose(transform));
+		// Normal transformation is already transposed
+		XMStoreFloat4x4(normalTransforms + i, XMMatrixInverse(0, transform));
+	}
+	return ERROR_SUCCESS;
+}
+
+HRESULT AnimationSampler::getModelTransform(const size_t bone, DirectX::XMFLOAT4X4& transform) const {
+	if( bone >= m_nBones ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	transform = m_modelTransforms[bone];
+	return ERROR_SUCCESS;
+}
+
+size_t AnimationSampler::getNumberOfBones(void) const {
+	return m_nBones;
+}
+
+void AnimationSampler::sampleClip(const AnimationClip& clip, const float time,
+	std::vector<DirectX::XMFLOAT4>& translations,
+	std::vector<DirectX::XMFLOAT4>& rotations,
+	std::vector<DirectX::XMFLOAT4>& scales) const {
+	clip.sampleChannel(translations.data(), AnimationClip::Channel::TRANSLATION, time);
+	clip.sampleChannel(rotations.data(), AnimationClip::Channel::ROTATION, time);
+	clip.sampleChannel(scales.data(), AnimationClip::Channel::SCALE, time);
+}
+
+void AnimationSampler::computeLocalTransforms(const bool blend, const float weight) {
+	const XMVECTOR zero = XMVectorZero();
+	const XMVECTOR one = XMVectorSplatOne();
+	const XMVECTOR two = XMVectorReplicate(2.0f);
+	const XMVECTOR w = XMVectorReplicate(weight);
+
+	XMMATRIX t, q, s, tB, qB, sB;
+	XMVECTOR qx, qy, qz, qw, flip;
+	XMVECTOR xx, yy, zz, xy, xz, yz, wx, wy, wz;
+	XMVECTOR r00, r01, r02, r10, r11, r12, r20, r21, r22;
+	size_t j = 0;
+
+	// Matrix rows for each of the four transformations, after transposition
+	XMMATRIX row0, row1, row2, row3;
+
+	const size_t paddedSize = m_modelTransforms.size();
+	for( size_t i = 0; i < paddedSize; i += ANIMATIONSAMPLER_BATCH_SIZE ) {
+
+		// Each row holds one component of the values of four bones
+		t = ANIMATIONSAMPLER_LOAD_SOA(m_translations, i);
+		q = ANIMATIONSAMPLER_LOAD_SOA(m_rotations, i);
+		s = ANIMATIONSAMPLER_LOAD_SOA(m_scales, i);
+
+		// Normalize rotations (interpolated keys are not unit quaternions)
+		normalizeSoA(q);
+
+		if( blend ) {
+			tB = ANIMATIONSAMPLER_LOAD_SOA(m_blendTranslations, i);
+			qB = ANIMATIONSAMPLER_LOAD_SOA(m_blendRotations, i);
+			sB = ANIMATIONSAMPLER_LOAD_SOA(m_blendScales, i);
+			normalizeSoA(qB);
+
+			// Negate the second rotations where they are in the opposite hemisphere
+			flip = XMVectorMultiply(q.r[0], qB.r[0]);
+			flip = XMVectorMultiplyAdd(q.r[1], qB.r[1], flip);
+			flip = XMVectorMultiplyAdd(q.r[2], qB.r[2], flip);
+			flip = XMVectorMultiplyAdd(q.r[3], qB.r[3], flip);
+			flip = XMVectorSelect(w, XMVectorNegate(w), XMVectorLess(flip, zero));
+
+			for( j = 0; j < 4; ++j ) {
+				t.r[j] = XMVectorMultiplyAdd(w, XMVectorSubtract(tB.r[j], t.r[j]), t.r[j]);
+				s.r[j] = XMVectorMultiplyAdd(w, XMVectorSubtract(sB.r[j], s.r[j]), s.r[j]);
+				q.r[j] = XMVectorMultiplyAdd(flip, qB.r[j],
+					XMVectorNegativeMultiplySubtract(w, q.r[j], q.r[j]));
+			}
+			normalizeSoA(q);
+		}
+		qx = q.r[0];
+		qy = q.r[1];
+		qz = q.r[2];
+		qw = q.r[3];
+
+		/* Rotation matrix elements, as computed by XMMatrixRotationQuaternion(),
+		   for four quaternions at once
+		 */
+		xx = XMVectorMultiply(qx, qx);
+		yy = XMVectorMultiply(qy, qy);
+		zz = XMVectorMultiply(qz, qz);
+		xy = XMVectorMultiply(qx, qy);
+		xz = XMVectorMultiply(qx, qz);
+		yz = XMVectorMultiply(qy, qz);
+		wx = XMVectorMultiply(qw, qx);
+		wy = XMVectorMultiply(qw, qy);
+		wz = XMVectorMultiply(qw, qz);
+
+		r00 = XMVectorNegativeMultiplySubtract(two, XMVectorAdd(yy, zz), one);
+		r01 = XMVectorMultiply(two, XMVectorAdd(xy, wz));
+		r02 = XMVectorMultiply(two, XMVectorSubtract(xz, wy));
+
+		r10 = XMVectorMultiply(two, XMVectorSubtract(xy, wz));
+		r11 = XMVectorNegativeMultiplySubtract(two, XMVectorAdd(xx, zz), one);
+		r12 = XMVectorMultiply(two, XMVectorAdd(yz, wx));
+
+		r20 = XMVectorMultiply(two, XMVectorAdd(xz, wy));
+		r21 = XMVectorMultiply(two, XMVectorSubtract(yz, wx));
+		r22 = XMVectorNegativeMultiplySubtract(two, XMVectorAdd(xx, yy), one);
+
+		// Scaling multiplies each of the first three rows by a scale factor
+		row0 = XMMatrixTranspose(XMMATRIX(
+			XMVectorMultiply(r00, s.r[0]), XMVectorMultiply(r01, s.r[0]), XMVectorMultiply(r02, s.r[0]), zero));
+		row1 = XMMatrixTranspose(XMMATRIX(
+			XMVectorMultiply(r10, s.r[1]), XMVectorMultiply(r11, s.r[1]), XMVectorMultiply(r12, s.r[1]), zero));
+		row2 = XMMatrixTranspose(XMMATRIX(
+			XMVectorMultiply(r20, s.r[2]), XMVectorMultiply(r21, s.r[2]), XMVectorMultiply(r22, s.r[2]), zero));
+		row3 = XMMatrixTranspose(XMMATRIX(t.r[0], t.r[1], t.r[2], one));
+
+		// Output matrices
+		for( j = 0; j < ANIMATIONSAMPLER_BATCH_SIZE; ++j ) {
+			XMStoreFloat4x4(&m_modelTransforms[i + j],
+				XMMATRIX(row0.r[j], row1.r[j], row2.r[j], row3.r[j]));
+		}
+	}
+}
+
+void AnimationSampler::computeHierarchy(void) {
+	size_t parent = ANIMATIONSAMPLER_NO_PARENT;
+
+	// Parents always precede their children, so their transformations are already final
+	for( size_t i = 0; i < m_nBones; ++i ) {
+		parent = m_parents[i];
+		if( parent != ANIMATIONSAMPLER_NO_PARENT ) {
+			XMStoreFloat4x4(&m_modelTransforms[i], XMMatrixMultiply(
+				XMLoadFloat4x4(&m_modelTransforms[i]),
+				XMLoadFloat4x4(&m_modelTransforms[parent])));
+		}
+	}
+}
@@ -23,6 +23,8 @@ Description
 
 using namespace DirectX;
 
+SlabPool DynamicKnot::s_pool(sizeof(DynamicKnot));
+
 DynamicKnot::DynamicKnot(const PointSet side, Transformable* const transform,
 	const bool ownTransform,
 	const bool useForward, const float* const speed) :
@@ -48,4 +50,23 @@ HRESULT DynamicKnot::update(const DWORD currentTime, const DWORD updateTimeInter
 		}
 	}
 	return updateControlPoints(*m_transform);
-}
\ No newline at end of file
+}
+
+void* DynamicKnot::operator new(const size_t size) {
+	if( size != sizeof(DynamicKnot) ) {
+		return ::operator new(size);
+	}
+	return s_pool.allocate();
+}
+
+void DynamicKnot::operator delete(void* const object, const size_t size) {
+	if( size != sizeof(DynamicKnot) ) {
+		::operator delete(object);
+	} else {
+		s_pool.deallocate(object);
+	}
+}
+
+void DynamicKnot::getPoolTelemetry(SlabPool::Telemetry& telemetry) {
+	s_pool.getTelemetry(telemetry);
+}
@@ -23,7 +23,6 @@ Description
 #include <exception>
 
 using namespace DirectX;
-using std::list;
 
 HomingSpline::HomingSpline(const size_t capacity,
 	const size_t initialSize,
@@ -35,7 +34,9 @@ HomingSpline::HomingSpline(const size_t capacity,
 	Spline(capacity, true, &speed, false),
 	m_end(end), m_pastPosition(0.0f, 0.0f, 0.0f),
 	m_thresholdDistance(thresholdDistance),
-	m_initialSegments(initialSize)
+	m_initialSegments(initialSize),
+	m_fitter(0), m_nNewSegments(0),
+	m_controlPoints(), m_fittedControlPoints()
 {
 	if( initialSize == 0 ) {
 		throw std::exception("Cannot create a spline with an initial size of zero segments.");
@@ -67,7 +68,12 @@ HomingSpline::HomingSpline(const size_t capacity,
 	}
 }
 
-HomingSpline::~HomingSpline(void) {}
+HomingSpline::~HomingSpline(void) {
+	if( m_fitter != 0 ) {
+		delete m_fitter;
+		m_fitter = 0;
+	}
+}
 
 Transformable* HomingSpline::getEnd(void) const {
 	return m_end;
@@ -117,6 +123,23 @@ float HomingSpline::getParameterAtInitialSize(const float t) const {
 		static_cast<float>(m_initialSegments));
 }
 
+HRESULT HomingSpline::setCompression(const float maxError) {
+	if( maxError < 0.0f ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	if( m_fitter != 0 ) {
+		delete m_fitter;
+		m_fitter = 0;
+	}
+	if( maxError > 0.0f ) {
+		m_fitter = new SplineFitter(maxError);
+
+		// All static segments are uncompressed
+		m_nNewSegments = getNumberOfSegments(false) - 1;
+	}
+	return ERROR_SUCCESS;
+}
+
 HRESULT HomingSpline::updateTracking(void) {
 	/* This is an unecessarily complicated way to insert
 	   a knot in second-last position,
@@ -137,5 +160,76 @@ HRESULT HomingSpline::updateTracking(void) {
 	if( FAILED(result) ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
+
+	if( m_fitter != 0 ) {
+		++m_nNewSegments;
+		if( m_nNewSegments >= HOMINGSPLINE_COMPRESSION_INTERVAL ) {
+			result = compressTail();
+			if( FAILED(result) ) {
+				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+			}
+		}
+	}
+	return ERROR_SUCCESS;
+}
+
+HRESULT HomingSpline::compressTail(void) {
+	// The last segment ends at the dynamic knot, and is not compressed
+	const size_t nStaticSegments = getNumberOfSegments(false) - 1;
+
+	/* Segments are removed from the start of the spline when it is at capacity.
+	   If the segment which the fitter would refit was removed,
+	   start fitting from the oldest remaining segment.
+	 */
+	size_t nReplacedSegments = m_fitter->getNumberOfReplacedSegments();
+	if( m_nNewSegments + nReplacedSegments > nStaticSegments ) {
+		m_fitter->reset();
+		nReplacedSegments = 0;
+		if( m_nNewSegments > nStaticSegments ) {
+			m_nNewSegments = nStaticSegments;
+		}
+	}
+	if( m_nNewSegments == 0 ) {
+		return ERROR_SUCCESS;
+	}
+
+	m_controlPoints.resize(getNumberOfControlPoints(false));
+	XMFLOAT4* controlPoints = &m_controlPoints[0];
+	HRESULT result = getControlPoints(controlPoints);
+	if( FAILED(result) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+	result = m_fitter->append(m_fittedControlPoints,
+		&m_controlPoints[4 * (nStaticSegments - m_nNewSegments)], m_nNewSegments);
+	if( FAILED(result) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+
+	/* Remove the knots following the start of the refit segments,
+	   including the dynamic knot. The fit does not change
+	   the knot at the start of the refit segments.
+	 */
+	const size_t nRemovedKnots = nReplacedSegments + m_nNewSegments + 1;
+	for( size_t i = 0; i < nRemovedKnots; ++i ) {
+		result = removeFromEnd();
+		if( FAILED(result) ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+	}
+
+	// Each fitted segment ends with the tangent and position control points of a knot
+	const size_t nFittedSegments = m_fittedControlPoints.size() / 4;
+	for( size_t i = 0; i < nFittedSegments; ++i ) {
+		result = addToEnd(&m_fittedControlPoints[4 * i + 2]);
+		if( FAILED(result) ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+	}
+	result = addToEnd(m_end, true);
+	if( FAILED(result) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+
+	m_nNewSegments = 0;
 	return ERROR_SUCCESS;
-}
\ No newline at end of file
+}
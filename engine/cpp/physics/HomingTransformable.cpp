@@ -35,13 +35,15 @@ HomingTransformable::HomingTransformable(const size_t capacity,
 	const float speedT,
 	const float offsetT,
 	const bool loop,
-	DWORD currentTime) :
+	DWORD currentTime,
+	const bool constantSpeed) :
 	Transformable(
 	XMFLOAT3(1.0f, 1.0f, 1.0f),
 	XMFLOAT3(0.0f, 0.0f, 0.0f),
 	XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f)),
 	m_startTime(currentTime), m_speedT(speedT),
-	m_loop(loop), m_spline(0), m_isAtEnd(false)
+	m_loop(loop), m_spline(0), m_isAtEnd(false),
+	m_constantSpeed(constantSpeed)
 {
 	m_spline = new HomingSpline(capacity, initialSize, speed, start, end,
 		knotParameters, thresholdDistance);
@@ -106,6 +108,16 @@ HRESULT HomingTransformable::updateSplineLocation(const DWORD currentTime) {
 		}
 	}
 
+	// The ends of the spline are at the same parameter values under both parameterizations
+	if( m_constantSpeed && tCurrent != 0.0f && tCurrent != 1.0f ) {
+		if( FAILED(m_spline->updateArcLengths()) ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+		if( FAILED(m_spline->arcLengthToT(tCurrent, tCurrent)) ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+	}
+
 	if( FAILED(m_spline->eval(this, tCurrent)) ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
@@ -25,91 +25,45 @@ Description
 using namespace DirectX;
 
 Knot::Knot(const PointSet side, const DirectX::XMFLOAT3* const controlPoints) :
-m_side(side), m_p2(0), m_p3(0), m_p0(0), m_p1(0),
-m_speed(0), m_useForward(0)
+m_points(sideToPoints(side)),
+m_p2(0.0f, 0.0f, 0.0f), m_p3(0.0f, 0.0f, 0.0f),
+m_p0(0.0f, 0.0f, 0.0f), m_p1(0.0f, 0.0f, 0.0f),
+m_speed(0.0f), m_hasSpeed(false), m_useForward(false)
 {
-	switch( m_side ) {
-	case PointSet::START:
-		m_p0 = new XMFLOAT3(controlPoints[0]);
-		m_p1 = new XMFLOAT3(controlPoints[1]);
-		break;
-	case PointSet::BOTH:
-		m_p2 = new XMFLOAT3(controlPoints[0]);
-		m_p3 = new XMFLOAT3(controlPoints[1]);
-		m_p0 = new XMFLOAT3(controlPoints[2]);
-		m_p1 = new XMFLOAT3(controlPoints[3]);
-		break;
-	case PointSet::END:
-		m_p2 = new XMFLOAT3(controlPoints[0]);
-		m_p3 = new XMFLOAT3(controlPoints[1]);
-		break;
-	default:
-		throw std::exception("Unknown PointSet enumeration constant passed to Knot constructor.");
-		break;
+	// Control points are listed in the same order as they are stored
+	size_t i = 0;
+	if( m_points & KNOT_POINT_P2 ) {
+		m_p2 = controlPoints[i++];
+	}
+	if( m_points & KNOT_POINT_P3 ) {
+		m_p3 = controlPoints[i++];
+	}
+	if( m_points & KNOT_POINT_P0 ) {
+		m_p0 = controlPoints[i++];
+	}
+	if( m_points & KNOT_POINT_P1 ) {
+		m_p1 = controlPoints[i++];
 	}
 }
 
 Knot::Knot(const PointSet side, Transformable& transform,
 	const bool useForward, const float* const speed) :
-	m_side(side), m_p2(0), m_p3(0), m_p0(0), m_p1(0),
-	m_speed(0), m_useForward(0) 
+	m_points(sideToPoints(side)),
+	m_p2(0.0f, 0.0f, 0.0f), m_p3(0.0f, 0.0f, 0.0f),
+	m_p0(0.0f, 0.0f, 0.0f), m_p1(0.0f, 0.0f, 0.0f),
+	m_speed(0.0f), m_hasSpeed(false), m_useForward(useForward)
 {
-	switch( m_side ) {
-	case PointSet::START:
-		m_p0 = new XMFLOAT3(0.0f, 0.0f, 0.0f);
-		m_p1 = new XMFLOAT3(0.0f, 0.0f, 0.0f);
-		break;
-	case PointSet::BOTH:
-		m_p2 = new XMFLOAT3(0.0f, 0.0f, 0.0f);
-		m_p3 = new XMFLOAT3(0.0f, 0.0f, 0.0f);
-		m_p0 = new XMFLOAT3(0.0f, 0.0f, 0.0f);
-		m_p1 = new XMFLOAT3(0.0f, 0.0f, 0.0f);
-		break;
-	case PointSet::END:
-		m_p2 = new XMFLOAT3(0.0f, 0.0f, 0.0f);
-		m_p3 = new XMFLOAT3(0.0f, 0.0f, 0.0f);
-		break;
-	default:
-		throw std::exception("Unknown PointSet enumeration constant passed to Knot constructor.");
-		break;
-	}
-
-	m_useForward = new bool(useForward);
 	if( speed != 0 ) {
-		m_speed = new float(*speed);
-	} else if( *m_useForward ) {
-		m_speed = new float(KNOT_DEFAULT_SPEED);
+		m_speed = *speed;
+		m_hasSpeed = true;
+	} else if( m_useForward ) {
+		m_speed = KNOT_DEFAULT_SPEED;
+		m_hasSpeed = true;
 	}
 	updateControlPoints(transform);
 }
 
-Knot::~Knot(void) {
-	if( m_p2 ) {
-		delete m_p2;
-		m_p2 = 0;
-	}
-	if( m_p3 ) {
-		delete m_p3;
-		m_p3 = 0;
-	}
-	if( m_p0 ) {
-		delete m_p0;
-		m_p0 = 0;
-	}
-	if( m_p1 ) {
-		delete m_p1;
-		m_p1 = 0;
-	}
-
-	if( m_speed ) {
-		delete m_speed;
-		m_speed = 0;
-	}
-	if( m_useForward ) {
-		delete m_useForward;
-		m_useForward = 0;
-	}
-}
+Knot::~Knot(void) {}
 
 HRESULT Knot::getControlPoints(DirectX::XMFLOAT4*& controlPoints) const {
 
@@ -117,160 +71,135 @@ HRESULT Knot::getControlPoints(DirectX::XMFLOAT4*& controlPoints) const {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
 	}
 
-	switch( m_side ) {
-	case PointSet::START:
-		controlPoints->x = m_p0->x;
-		controlPoints->y = m_p0->y;
-		controlPoints->z = m_p0->z;
-		controlPoints->w = 1.0f;
-		++controlPoints;
-		controlPoints->x = m_p1->x;
-		controlPoints->y = m_p1->y;
-		controlPoints->z = m_p1->z;
-		controlPoints->w = 1.0f;
-		++controlPoints;
-		break;
-	case PointSet::BOTH:
-		controlPoints->x = m_p2->x;
-		controlPoints->y = m_p2->y;
-		controlPoints->z = m_p2->z;
-		controlPoints->w = 1.0f;
+	if( m_points & KNOT_POINT_P2 ) {
+		*controlPoints = XMFLOAT4(m_p2.x, m_p2.y, m_p2.z, 1.0f);
 		++controlPoints;
-		controlPoints->x = m_p3->x;
-		controlPoints->y = m_p3->y;
-		controlPoints->z = m_p3->z;
-		controlPoints->w = 1.0f;
-		++controlPoints;
-		controlPoints->x = m_p0->x;
-		controlPoints->y = m_p0->y;
-		controlPoints->z = m_p0->z;
-		controlPoints->w = 1.0f;
-		++controlPoints;
-		controlPoints->x = m_p1->x;
-		controlPoints->y = m_p1->y;
-		controlPoints->z = m_p1->z;
-		controlPoints->w = 1.0f;
+	}
+	if( m_points & KNOT_POINT_P3 ) {
+		*controlPoints = XMFLOAT4(m_p3.x, m_p3.y, m_p3.z, 1.0f);
 		++controlPoints;
-		break;
-	case PointSet::END:
-		controlPoints->x = m_p2->x;
-		controlPoints->y = m_p2->y;
-		controlPoints->z = m_p2->z;
-		controlPoints->w = 1.0f;
+	}
+	if( m_points & KNOT_POINT_P0 ) {
+		*controlPoints = XMFLOAT4(m_p0.x, m_p0.y, m_p0.z, 1.0f);
 		++controlPoints;
-		controlPoints->x = m_p3->x;
-		controlPoints->y = m_p3->y;
-		controlPoints->z = m_p3->z;
-		controlPoints->w = 1.0f;
+	}
+	if( m_points & KNOT_POINT_P1 ) {
+		*controlPoints = XMFLOAT4(m_p1.x, m_p1.y, m_p1.z, 1.0f);
 		++controlPoints;
-		break;
-	default:
-		throw std::exception("Unknown PointSet enumeration constant found in Knot::getControlPoints().");
-		break;
 	}
 	return ERROR_SUCCESS;
 }
 
 HRESULT Knot::getP0(DirectX::XMFLOAT3& p0) const {
-	if( m_p0 == 0 ) {
+	if( !(m_points & KNOT_POINT_P0) ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
 	}
-	p0 = *m_p0;
+	p0 = m_p0;
 	return ERROR_SUCCESS;
 }
 
 HRESULT Knot::getP1(DirectX::XMFLOAT3& p1) const {
-	if( m_p1 == 0 ) {
+	if( !(m_points & KNOT_POINT_P1) ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
 	}
-	p1 = *m_p1;
+	p1 = m_p1;
 	return ERROR_SUCCESS;
 }
 
 HRESULT Knot::getP2(DirectX::XMFLOAT3& p2) const {
-	if( m_p2 == 0 ) {
+	if( !(m_points & KNOT_POINT_P2) ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
 	}
-	p2 = *m_p2;
+	p2 = m_p2;
 	return ERROR_SUCCESS;
 }
 
 HRESULT Knot::getP3(DirectX::XMFLOAT3& p3) const {
-	if( m_p3 == 0 ) {
+	if( !(m_points & KNOT_POINT_P3) ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
 	}
-	p3 = *m_p3;
+	p3 = m_p3;
 	return ERROR_SUCCESS;
 }
 
-HRESULT Knot::makeDouble(void) {
-	if( m_side == PointSet::BOTH ) {
-		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+void Knot::setControlPoints(const DirectX::XMFLOAT3* const controlPoints) {
+	if( m_points & KNOT_POINT_P2 ) {
+		m_p2 = controlPoints[0];
+	}
+	if( m_points & KNOT_POINT_P3 ) {
+		m_p3 = controlPoints[1];
+	}
+	if( m_points & KNOT_POINT_P0 ) {
+		m_p0 = controlPoints[2];
 	}
+	if( m_points & KNOT_POINT_P1 ) {
+		m_p1 = controlPoints[3];
+	}
+}
 
+HRESULT Knot::makeDouble(void) {
 	XMVECTOR v;
 
-	switch( m_side ) {
+	switch( getSide() ) {
 	case PointSet::START:
-		m_p2 = new XMFLOAT3(0.0f, 0.0f, 0.0f);
-		m_p3 = new XMFLOAT3(0.0f, 0.0f, 0.0f);
-		*m_p3 = *m_p0;
-		v = XMVectorScale(XMLoadFloat3(m_p0), 2.0f);
-		v = XMVectorSubtract(v, XMLoadFloat3(m_p1));
-		XMStoreFloat3(m_p2, v);
+		m_p3 = m_p0;
+		v = XMVectorScale(XMLoadFloat3(&m_p0), 2.0f);
+		v = XMVectorSubtract(v, XMLoadFloat3(&m_p1));
+		XMStoreFloat3(&m_p2, v);
 		break;
 	case PointSet::END:
-		m_p0 = new XMFLOAT3(0.0f, 0.0f, 0.0f);
-		m_p1 = new XMFLOAT3(0.0f, 0.0f, 0.0f);
-		*m_p0 = *m_p3;
-		v = XMVectorScale(XMLoadFloat3(m_p3), 2.0f);
-		v = XMVectorSubtract(v, XMLoadFloat3(m_p2));
-		XMStoreFloat3(m_p1, v);
+		m_p0 = m_p3;
+		v = XMVectorScale(XMLoadFloat3(&m_p3), 2.0f);
+		v = XMVectorSubtract(v, XMLoadFloat3(&m_p2));
+		XMStoreFloat3(&m_p1, v);
 		break;
 	default:
-		throw std::exception("Unknown PointSet enumeration constant found in Knot::makeDouble().");
-		break;
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
 	}
 
-	m_side = PointSet::BOTH;
+	m_points = KNOT_POINTS_BOTH;
 	return ERROR_SUCCESS;
 }
 
 HRESULT Knot::makeHalf(const PointSet side) {
-	if( m_side != PointSet::BOTH ) {
+	if( m_points != KNOT_POINTS_BOTH ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
 	}
 	if( side == PointSet::BOTH ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
 	}
 
-	m_side = side;
-	switch( m_side ) {
-	case PointSet::START:
-		delete m_p2;
-		m_p2 = 0;
-		delete m_p3;
-		m_p3 = 0;
-		break;
-
-	case PointSet::END:
-		delete m_p0;
-		m_p0 = 0;
-		delete m_p1;
-		m_p1 = 0;
-		break;
+	m_points = sideToPoints(side);
+	return ERROR_SUCCESS;
+}
 
+Knot::PointSet Knot::getSide(void) const {
+	switch( m_points ) {
+	case KNOT_POINTS_START:
+		return PointSet::START;
+	case KNOT_POINTS_END:
+		return PointSet::END;
 	default:
-		throw std::exception("Unknown PointSet enumeration constant found in Knot::makeHalf().");
-		break;
+		return PointSet::BOTH;
 	}
+}
 
-	return ERROR_SUCCESS;
+unsigned int Knot::sideToPoints(const PointSet side) {
+	switch( side ) {
+	case PointSet::START:
+		return KNOT_POINTS_START;
+	case PointSet::BOTH:
+		return KNOT_POINTS_BOTH;
+	case PointSet::END:
+		return KNOT_POINTS_END;
+	default:
+		throw std::exception("Unknown PointSet enumeration constant passed to Knot constructor.");
+	}
 }
 
 HRESULT Knot::updateControlPoints(Transformable& transform) {
 	HRESULT result = ERROR_SUCCESS;
-	switch( m_side ) {
+	switch( getSide() ) {
 	case PointSet::START:
 		result = updateP0(transform);
 		if( FAILED(result) ) {
@@ -315,8 +244,8 @@ HRESULT Knot::updateControlPoints(Transformable& transform) {
 HRESULT Knot::updateP2(Transformable& transform) {
 	HRESULT result = ERROR_SUCCESS;
 	XMFLOAT3 derivative(0.0f, 0.0f, 0.0f);
-	if( !(*m_useForward) ) {
-		if( m_speed != 0 ) {
+	if( !m_useForward ) {
+		if( m_hasSpeed ) {
 			result = transform.getWorldDirectionAndSpeed(derivative);
 		} else {
 			result = transform.getWorldVelocity(derivative);
@@ -328,9 +257,9 @@ HRESULT Knot::updateP2(Transformable& transform) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
-	if( m_speed != 0 ) {
+	if( m_hasSpeed ) {
 		XMStoreFloat3(&derivative,
-			XMVectorScale(XMLoadFloat3(&derivative), *m_speed));
+			XMVectorScale(XMLoadFloat3(&derivative), m_speed));
 	}
 
 	// The derivative is negative three times the displacement from p3 to p2
@@ -338,27 +267,27 @@ HRESULT Knot::updateP2(Transformable& transform) {
 		XMVectorScale(XMLoadFloat3(&derivative), -(1.0f /3.0f) ));
 
 	// Add the offset to p2 to find p3
-	XMStoreFloat3(m_p2,
-		XMVectorAdd(XMLoadFloat3(&derivative), XMLoadFloat3(m_p3)));
+	XMStoreFloat3(&m_p2,
+		XMVectorAdd(XMLoadFloat3(&derivative), XMLoadFloat3(&m_p3)));
 
 	return result;
 }
 
 HRESULT Knot::updateP3(Transformable& transform) {
-	*m_p3 = transform.getPosition();
+	m_p3 = transform.getPosition();
 	return ERROR_SUCCESS;
 }
 
 HRESULT Knot::updateP0(Transformable& transform) {
-	*m_p0 = transform.getPosition();
+	m_p0 = transform.getPosition();
 	return ERROR_SUCCESS;
 }
 
 HRESULT Knot::updateP1(Transformable& transform) {
 	HRESULT result = ERROR_SUCCESS;
 	XMFLOAT3 derivative(0.0f, 0.0f, 0.0f);
-	if( !(*m_useForward) ) {
-		if( m_speed != 0 ) {
+	if( !m_useForward ) {
+		if( m_hasSpeed ) {
 			result = transform.getWorldDirectionAndSpeed(derivative);
 		} else {
 			result = transform.getWorldVelocity(derivative);
@@ -370,9 +299,9 @@ HRESULT Knot::updateP1(Transformable& transform) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
-	if( m_speed != 0 ) {
+	if( m_hasSpeed ) {
 		XMStoreFloat3(&derivative,
-			XMVectorScale(XMLoadFloat3(&derivative), *m_speed));
+			XMVectorScale(XMLoadFloat3(&derivative), m_speed));
 	}
 
 	// The derivative is positive three times the displacement from p0 to p1
@@ -380,8 +309,8 @@ HRESULT Knot::updateP1(Transformable& transform) {
 		XMVectorScale(XMLoadFloat3(&derivative), (1.0f / 3.0f)));
 
 	// Add the offset to p0 to find p1
-	XMStoreFloat3(m_p1,
-		XMVectorAdd(XMLoadFloat3(&derivative), XMLoadFloat3(m_p0)));
+	XMStoreFloat3(&m_p1,
+		XMVectorAdd(XMLoadFloat3(&derivative), XMLoadFloat3(&m_p0)));
 
 	return result;
 }
\ No newline at end of file
@@ -0,0 +1,781 @@
+/*
+SpatialIndex.cpp
+----------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Implementation of the SpatialIndex class
+*/
+
+#include <exception>
+#include <algorithm>
+#include <queue>
+#include <cmath>
+#include "SpatialIndex.h"
+#include "defs.h"
+
+using namespace DirectX;
+
+namespace {
+
+	float surfaceArea(const XMFLOAT3& min, const XMFLOAT3& max) {
+		const float dx = max.x - min.x;
+		const float dy = max.y - min.y;
+		const float dz = max.z - min.z;
+		return 2.0f * (dx * dy + dy * dz + dz * dx);
+	}
+
+	float unionSurfaceArea(const XMFLOAT3& minA, const XMFLOAT3& maxA,
+		const XMFLOAT3& minB, const XMFLOAT3& maxB) {
+		const XMFLOAT3 min((minA.x < minB.x) ? minA.x : minB.x,
+			(minA.y < minB.y) ? minA.y : minB.y,
+			(minA.z < minB.z) ? minA.z : minB.z);
+		const XMFLOAT3 max((maxA.x > maxB.x) ? maxA.x : maxB.x,
+			(maxA.y > maxB.y) ? maxA.y : maxB.y,
+			(maxA.z > maxB.z) ? maxA.z : maxB.z);
+		return surfaceArea(min, max);
+	}
+
+	void combine(XMFLOAT3& min, XMFLOAT3& max,
+		const XMFLOAT3& minA, const XMFLOAT3& maxA,
+		const XMFLOAT3& minB, const XMFLOAT3& maxB) {
+		min.x = (minA.x < minB.x) ? minA.x : minB.x;
+		min.y = (minA.y < minB.y) ? minA.y : minB.y;
+		min.z = (minA.z < minB.z) ? minA.z : minB.z;
+		max.x = (maxA.x > maxB.x) ? maxA.x : maxB.x;
+		max.y = (maxA.y > maxB.y) ? maxA.y : maxB.y;
+		max.z = (maxA.z > maxB.z) ? maxA.z : maxB.z;
+	}
+
+	bool contains(const XMFLOAT3& outerMin, const XMFLOAT3& outerMax,
+		const XMFLOAT3& innerMin, const XMFLOAT3& innerMax) {
+		return outerMin.x <= innerMin.x && outerMin.y <= innerMin.y && outerMin.z <= innerMin.z &&
+			innerMax.x <= outerMax.x && innerMax.y <= outerMax.y && innerMax.z <= outerMax.z;
+	}
+
+	// Squared distance from a point to a box (zero inside the box)
+	float distanceSquaredToBox(const XMFLOAT3& p, const XMFLOAT3& min, const XMFLOAT3& max) {
+		float dx = (p.x < min.x) ? (min.x - p.x) : ((p.x > max.x) ? (p.x - max.x) : 0.0f);
+		float dy = (p.y < min.y) ? (min.y - p.y) : ((p.y > max.y) ? (p.y - max.y) : 0.0f);
+		float dz = (p.z < min.z) ? (min.z - p.z) : ((p.z > max.z) ? (p.z - max.z) : 0.0f);
+		return dx * dx + dy * dy + dz * dz;
+	}
+
+	// Distance from a point to the surface of a sphere (zero inside the sphere)
+	float distanceToSphere(const XMFLOAT3& p, const XMFLOAT3& center, const float radius) {
+		const float dx = p.x - center.x;
+		const float dy = p.y - center.y;
+		const float dz = p.z - center.z;
+		const float distance = std::sqrt(dx * dx + dy * dy + dz * dz) - radius;
+		return (distance > 0.0f) ? distance : 0.0f;
+	}
+
+	/* Slab test of a ray against a box, over the interval [0, tMax].
+	   'inverseDirection' contains the reciprocals of the ray direction components.
+	 */
+	bool rayIntersectsBox(const XMFLOAT3& origin, const XMFLOAT3& inverseDirection, const float tMax,
+		const XMFLOAT3& min, const XMFLOAT3& max) {
+		float t0 = 0.0f;
+		float t1 = tMax;
+		const float* o = &origin.x;
+		const float* d = &inverseDirection.x;
+		const float* lo = &min.x;
+		const float* hi = &max.x;
+		for( size_t i = 0; i < 3; ++i ) {
+			float tNear = (lo[i] - o[i]) * d[i];
+			float tFar = (hi[i] - o[i]) * d[i];
+			if( tNear > tFar ) {
+				const float temp = tNear;
+				tNear = tFar;
+				tFar = temp;
+			}
+			// Written so that NaN values (from 0 * infinity) do not reject the box
+			t0 = (tNear > t0) ? tNear : t0;
+			t1 = (tFar < t1) ? tFar : t1;
+			if( t0 > t1 ) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/* Outputs the smallest non-negative parameter at which the ray
+	   (with a unit direction) intersects the sphere.
+	   Rays starting inside the sphere intersect it at zero.
+	 */
+	bool rayIntersectsSphere(const XMFLOAT3& origin, const XMFLOAT3& direction,
+		const XMFLOAT3& center, const float radius, float& t) {
+		const float mx = origin.x - center.x;
+		const float my = origin.y - center.y;
+		const float mz = origin.z - center.z;
+		const float c = mx * mx + my * my + mz * mz - radius * radius;
+		if( c <= 0.0f ) {
+			t = 0.0f;
+			return true;
+		}
+		const float b = mx * direction.x + my * direction.y + mz * direction.z;
+		if( b > 0.0f ) {
+			return false;
+		}
+		/* Equivalent to b * b - c, but computed from the squared distance
+		   between the centre and the ray, which avoids cancellation
+		   when the sphere is far away and the ray passes near its edge
+		 */
+		const float px = mx - b * direction.x;
+		const float py = my - b * direction.y;
+		const float pz = mz - b * direction.z;
+		const float discriminant = radius * radius - (px * px + py * py + pz * pz);
+		if( discriminant < 0.0f ) {
+			return false;
+		}
+		t = -b - std::sqrt(discriminant);
+		return true;
+	}
+
+	struct NodeDistance {
+		float distance;
+		size_t index;
+	};
+
+	struct NodeDistanceGreater {
+		bool operator()(const NodeDistance& a, const NodeDistance& b) const {
+			return a.distance > b.distance;
+		}
+	};
+
+	struct ResultDistanceLess {
+		bool operator()(const SpatialIndex::Result& a, const SpatialIndex::Result& b) const {
+			return a.distance < b.distance;
+		}
+	};
+}
+
+SpatialIndex::SpatialIndex(const float margin, const size_t capacity) :
+	m_nodes(), m_root(SPATIALINDEX_NULL), m_freeList(SPATIALINDEX_NULL),
+	m_leaves(), m_margin(margin)
+{
+	if( margin < 0.0f ) {
+		throw std::exception("SpatialIndex margin cannot be negative.");
+	}
+	if( capacity > 0 ) {
+		m_nodes.reserve(2 * capacity);
+		m_leaves.reserve(capacity);
+	}
+}
+
+SpatialIndex::~SpatialIndex(void) {}
+
+HRESULT SpatialIndex::add(size_t& id, const Transformable* const transform) {
+	if( transform == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+	const size_t leaf = allocateNode();
+	Node& node = m_nodes[leaf];
+	node.transform = transform;
+	node.height = 0;
+	node.leafIndex = m_leaves.size();
+	m_leaves.push_back(leaf);
+	readBounds(node);
+	setFatBox(node);
+	insertLeaf(leaf);
+	id = leaf;
+	return ERROR_SUCCESS;
+}
+
+HRESULT SpatialIndex::remove(const size_t id) {
+	if( !isValidLeaf(id) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	removeLeaf(id);
+
+	// Swap-remove from the list of leaves
+	const size_t leafIndex = m_nodes[id].leafIndex;
+	m_leaves[leafIndex] = m_leaves.back();
+	m_nodes[m_leaves[leafIndex]].leafIndex = leafIndex;
+	m_leaves.pop_back();
+
+	freeNode(id);
+	return ERROR_SUCCESS;
+}
+
+HRESULT SpatialIndex::update(size_t* const nReinserted) {
+	size_t count = 0;
+	for( std::vector<size_t>::const_iterator it = m_leaves.cbegin(); it != m_leaves.cend(); ++it ) {
+		Node& leaf = m_nodes[*it];
+		if( !readBounds(leaf) ) {
+			removeLeaf(*it);
+			setFatBox(m_nodes[*it]);
+			insertLeaf(*it);
+			++count;
+		}
+	}
+	if( nReinserted != 0 ) {
+		*nReinserted = count;
+	}
+	return ERROR_SUCCESS;
+}
+
+HRESULT SpatialIndex::refit(void) {
+	if( m_root == SPATIALINDEX_NULL ) {
+		return ERROR_SUCCESS;
+	}
+	for( std::vector<size_t>::const_iterator it = m_leaves.cbegin(); it != m_leaves.cend(); ++it ) {
+		Node& leaf = m_nodes[*it];
+		if( !readBounds(leaf) ) {
+			setFatBox(leaf);
+		}
+	}
+
+	// Children are visited after their parents in a pre-order traversal
+	std::vector<size_t> order;
+	order.reserve(m_nodes.size());
+	order.push_back(m_root);
+	for( size_t i = 0; i < order.size(); ++i ) {
+		const Node& node = m_nodes[order[i]];
+		if( node.child1 != SPATIALINDEX_NULL ) {
+			order.push_back(node.child1);
+			order.push_back(node.child2);
+		}
+	}
+	for( size_t i = order.size(); i > 0; --i ) {
+		if( !isLeaf(order[i - 1]) ) {
+			refitNode(order[i - 1]);
+		}
+	}
+	return ERROR_SUCCESS;
+}
+
+HRESULT SpatialIndex::rebuild(void) {
+	// Free all internal nodes
+	for( size_t i = 0; i < m_nodes.size(); ++i ) {
+		if( m_nodes[i].height > 0 ) {
+			freeNode(i);
+		}
+	}
+	m_root = SPATIALINDEX_NULL;
+	if( m_leaves.empty() ) {
+		return ERROR_SUCCESS;
+	}
+
+	for( std::vector<size_t>::const_iterator it = m_leaves.cbegin(); it != m_leaves.cend(); ++it ) {
+		Node& leaf = m_nodes[*it];
+		readBounds(leaf);
+		setFatBox(leaf);
+	}
+
+	// Reserve storage for the internal nodes, so that building does not move nodes
+	m_nodes.reserve(m_nodes.size() + m_leaves.size());
+
+	std::vector<size_t> leaves(m_leaves);
+	m_root = buildRange(leaves, 0, leaves.size());
+	m_nodes[m_root].parent = SPATIALINDEX_NULL;
+	return ERROR_SUCCESS;
+}
+
+void SpatialIndex::clear(void) {
+	m_nodes.clear();
+	m_leaves.clear();
+	m_root = SPATIALINDEX_NULL;
+	m_freeList = SPATIALINDEX_NULL;
+}
+
+bool SpatialIndex::rayCast(const XMFLOAT3& origin, const XMFLOAT3& direction,
+	const float maxDistance, Result& result) const {
+
+	if( m_root == SPATIALINDEX_NULL ) {
+		return false;
+	}
+	const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+	if( length == 0.0f ) {
+		return false;
+	}
+	const XMFLOAT3 unitDirection(direction.x / length, direction.y / length, direction.z / length);
+	const XMFLOAT3 inverseDirection(1.0f / unitDirection.x, 1.0f / unitDirection.y, 1.0f / unitDirection.z);
+
+	bool hit = false;
+	float best = maxDistance;
+	float t = 0.0f;
+	std::vector<size_t> stack;
+	stack.reserve(64);
+	stack.push_back(m_root);
+	while( !stack.empty() ) {
+		const Node& node = m_nodes[stack.back()];
+		const size_t index = stack.back();
+		stack.pop_back();
+		if( !rayIntersectsBox(origin, inverseDirection, best, node.min, node.max) ) {
+			continue;
+		}
+		if( node.child1 == SPATIALINDEX_NULL ) {
+			if( rayIntersectsSphere(origin, unitDirection, node.center, node.radius, t) && t <= best ) {
+				best = t;
+				result.id = index;
+				result.transform = node.transform;
+				result.distance = t;
+				hit = true;
+			}
+		} else {
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+	return hit;
+}
+
+size_t SpatialIndex::sphereOverlap(const XMFLOAT3& center, const float radius,
+	std::vector<Result>& results) const {
+
+	results.clear();
+	if( m_root == SPATIALINDEX_NULL ) {
+		return 0;
+	}
+	const float radiusSquared = radius * radius;
+	Result result;
+	std::vector<size_t> stack;
+	stack.reserve(64);
+	stack.push_back(m_root);
+	while( !stack.empty() ) {
+		const size_t index = stack.back();
+		const Node& node = m_nodes[index];
+		stack.pop_back();
+		if( distanceSquaredToBox(center, node.min, node.max) > radiusSquared ) {
+			continue;
+		}
+		if( node.child1 == SPATIALINDEX_NULL ) {
+			result.distance = distanceToSphere(center, node.center, node.radius);
+			if( result.distance <= radius ) {
+				result.id = index;
+				result.transform = node.transform;
+				results.push_back(result);
+			}
+		} else {
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+	return results.size();
+}
+
+size_t SpatialIndex::nearest(const XMFLOAT3& point, const size_t k,
+	std::vector<Result>& results) const {
+
+	results.clear();
+	if( m_root == SPATIALINDEX_NULL || k == 0 ) {
+		return 0;
+	}
+
+	// Best-first traversal, with nodes ordered by their distance from the point
+	std::priority_queue<NodeDistance, std::vector<NodeDistance>, NodeDistanceGreater> queue;
+	NodeDistance entry;
+	entry.distance = std::sqrt(distanceSquaredToBox(point, m_nodes[m_root].min, m_nodes[m_root].max));
+	entry.index = m_root;
+	queue.push(entry);
+
+	// 'results' is a max-heap of the closest objects found so far
+	Result result;
+	while( !queue.empty() ) {
+		entry = queue.top();
+		queue.pop();
+		if( results.size() == k && entry.distance >= results.front().distance ) {
+			break;
+		}
+		const Node& node = m_nodes[entry.index];
+		if( node.child1 == SPATIALINDEX_NULL ) {
+			result.id = entry.index;
+			result.transform = node.transform;
+			result.distance = distanceToSphere(point, node.center, node.radius);
+			if( results.size() < k ) {
+				results.push_back(result);
+				std::push_heap(results.begin(), results.end(), ResultDistanceLess());
+			} else if( result.distance < results.front().distance ) {
+				std::pop_heap(results.begin(), results.end(), ResultDistanceLess());
+				results.back() = result;
+				std::push_heap(results.begin(), results.end(), ResultDistanceLess());
+			}
+		} else {
+			const size_t children[2] = { node.child1, node.child2 };
+			for( size_t i = 0; i < 2; ++i ) {
+				const Node& child = m_nodes[children[i]];
+				entry.index = children[i];
+				entry.distance = std::sqrt(distanceSquaredToBox(point, child.min, child.max));
+				queue.push(entry);
+			}
+		}
+	}
+	std::sort_heap(results.begin(), results.end(), ResultDistanceLess());
+	return results.size();
+}
+
+size_t SpatialIndex::getCount(void) const {
+	return m_leaves.size();
+}
+
+const Transformable* SpatialIndex::getTransformable(const size_t id) const {
+	return isValidLeaf(id) ? m_nodes[id].transform : 0;
+}
+
+size_t SpatialIndex::getHeight(void) const {
+	return (m_root == SPATIALINDEX_NULL) ? 0 : static_cast<size_t>(m_nodes[m_root].height);
+}
+
+float SpatialIndex::getCost(void) const {
+	if( m_root == SPATIALINDEX_NULL ) {
+		return 0.0f;
+	}
+	const float rootArea = surfaceArea(m_nodes[m_root].min, m_nodes[m_root].max);
+	if( rootArea == 0.0f ) {
+		return 0.0f;
+	}
+	double totalArea = 0.0;
+	for( std::vector<Node>::const_iterator it = m_nodes.cbegin(); it != m_nodes.cend(); ++it ) {
+		if( it->height > 0 ) {
+			totalArea += surfaceArea(it->min, it->max);
+		}
+	}
+	return static_cast<float>(totalArea / rootArea);
+}
+
+HRESULT SpatialIndex::validate(void) const {
+	if( m_root == SPATIALINDEX_NULL ) {
+		return m_leaves.empty() ? ERROR_SUCCESS : MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	if( m_nodes[m_root].parent != SPATIALINDEX_NULL ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	size_t nLeaves = 0;
+	std::vector<size_t> stack;
+	stack.push_back(m_root);
+	while( !stack.empty() ) {
+		const size_t index = stack.back();
+		const Node& node = m_nodes[index];
+		stack.pop_back();
+		if( node.height < 0 ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		if( node.child1 == SPATIALINDEX_NULL ) {
+			const XMFLOAT3 min(node.center.x - node.radius, node.center.y - node.radius, node.center.z - node.radius);
+			const XMFLOAT3 max(node.center.x + node.radius, node.center.y + node.radius, node.center.z + node.radius);
+			if( node.height != 0 || node.child2 != SPATIALINDEX_NULL || node.transform == 0 ||
+				node.leafIndex >= m_leaves.size() || m_leaves[node.leafIndex] != index ||
+				!contains(node.min, node.max, min, max) ) {
+				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+			++nLeaves;
+		} else {
+			const Node& child1 = m_nodes[node.child1];
+			const Node& child2 = m_nodes[node.child2];
+			const int expectedHeight = 1 + ((child1.height > child2.height) ? child1.height : child2.height);
+			const int imbalance = child1.height - child2.height;
+			if( child1.parent != index || child2.parent != index ||
+				node.height != expectedHeight || imbalance > 1 || imbalance < -1 ||
+				!contains(node.min, node.max, child1.min, child1.max) ||
+				!contains(node.min, node.max, child2.min, child2.max) ) {
+				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+	if( nLeaves != m_leaves.size() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	return ERROR_SUCCESS;
+}
+
+size_t SpatialIndex::allocateNode(void) {
+	size_t index = 0;
+	if( m_freeList != SPATIALINDEX_NULL ) {
+		index = m_freeList;
+		m_freeList = m_nodes[index].parent;
+	} else {
+		index = m_nodes.size();
+		m_nodes.push_back(Node());
+	}
+	Node& node = m_nodes[index];
+	node.parent = SPATIALINDEX_NULL;
+	node.child1 = SPATIALINDEX_NULL;
+	node.child2 = SPATIALINDEX_NULL;
+	node.height = 0;
+	node.transform = 0;
+	node.radius = 0.0f;
+	node.leafIndex = SPATIALINDEX_NULL;
+	return index;
+}
+
+void SpatialIndex::freeNode(const size_t index) {
+	Node& node = m_nodes[index];
+	node.parent = m_freeList;
+	node.child1 = SPATIALINDEX_NULL;
+	node.child2 = SPATIALINDEX_NULL;
+	node.height = -1;
+	node.transform = 0;
+	m_freeList = index;
+}
+
+bool SpatialIndex::isLeaf(const size_t index) const {
+	return m_nodes[index].child1 == SPATIALINDEX_NULL;
+}
+
+bool SpatialIndex::isValidLeaf(const size_t index) const {
+	return index < m_nodes.size() && m_nodes[index].height == 0 && m_nodes[index].transform != 0;
+}
+
+bool SpatialIndex::readBounds(Node& leaf) const {
+	XMFLOAT4X4 worldTransform;
+	leaf.transform->getWorldTransform(worldTransform);
+	leaf.center = XMFLOAT3(worldTransform._41, worldTransform._42, worldTransform._43);
+	leaf.radius = (leaf.transform->m_radius > 0.0f) ? leaf.transform->m_radius : 0.0f;
+	const XMFLOAT3 min(leaf.center.x - leaf.radius, leaf.center.y - leaf.radius, leaf.center.z - leaf.radius);
+	const XMFLOAT3 max(leaf.center.x + leaf.radius, leaf.center.y + leaf.radius, leaf.center.z + leaf.radius);
+	return contains(leaf.min, leaf.max, min, max);
+}
+
+void SpatialIndex::setFatBox(Node& leaf) const {
+	const float extent = leaf.radius + m_margin;
+	leaf.min = XMFLOAT3(leaf.center.x - extent, leaf.center.y - extent, leaf.center.z - extent);
+	leaf.max = XMFLOAT3(leaf.center.x + extent, leaf.center.y + extent, leaf.center.z + extent);
+}
+
+void SpatialIndex::insertLeaf(const size_t leaf) {
+	if( m_root == SPATIALINDEX_NULL ) {
+		m_root = leaf;
+		m_nodes[leaf].parent = SPATIALINDEX_NULL;
+		return;
+	}
+
+	// Find the best sibling, using the surface area heuristic
+	const XMFLOAT3 leafMin = m_nodes[leaf].min;
+	const XMFLOAT3 leafMax = m_nodes[leaf].max;
+	size_t index = m_root;
+	while( !isLeaf(index) ) {
+		const Node& node = m_nodes[index];
+		const float area = surfaceArea(node.min, node.max);
+		const float combinedArea = unionSurfaceArea(node.min, node.max, leafMin, leafMax);
+
+		// Cost of creating a new parent for this node and the new leaf
+		const float cost = 2.0f * combinedArea;
+
+		// Minimum cost of pushing the leaf further down the tree
+		const float inheritanceCost = 2.0f * (combinedArea - area);
+
+		float childCosts[2];
+		const size_t children[2] = { node.child1, node.child2 };
+		for( size_t i = 0; i < 2; ++i ) {
+			const Node& child = m_nodes[children[i]];
+			childCosts[i] = unionSurfaceArea(child.min, child.max, leafMin, leafMax) + inheritanceCost;
+			if( child.child1 != SPATIALINDEX_NULL ) {
+				childCosts[i] -= surfaceArea(child.min, child.max);
+			}
+		}
+
+		if( cost < childCosts[0] && cost < childCosts[1] ) {
+			break;
+		}
+		index = (childCosts[0] < childCosts[1]) ? children[0] : children[1];
+	}
+	const size_t sibling = index;
+
+	// Create a new parent
+	const size_t oldParent = m_nodes[sibling].parent;
+	const size_t newParent = allocateNode();
+	Node& parentNode = m_nodes[newParent];
+	Node& siblingNode = m_nodes[sibling];
+	parentNode.parent = oldParent;
+	combine(parentNode.min, parentNode.max, leafMin, leafMax, siblingNode.min, siblingNode.max);
+	parentNode.height = siblingNode.height + 1;
+	parentNode.child1 = sibling;
+	parentNode.child2 = leaf;
+	siblingNode.parent = newParent;
+	m_nodes[leaf].parent = newParent;
+
+	if( oldParent != SPATIALINDEX_NULL ) {
+		if( m_nodes[oldParent].child1 == sibling ) {
+			m_nodes[oldParent].child1 = newParent;
+		} else {
+			m_nodes[oldParent].child2 = newParent;
+		}
+	} else {
+		m_root = newParent;
+	}
+
+	// Walk back up the tree, fixing heights and boxes
+	index = m_nodes[leaf].parent;
+	while( index != SPATIALINDEX_NULL ) {
+		index = balance(index);
+		refitNode(index);
+		index = m_nodes[index].parent;
+	}
+}
+
+void SpatialIndex::removeLeaf(const size_t leaf) {
+	if( leaf == m_root ) {
+		m_root = SPATIALINDEX_NULL;
+		return;
+	}
+
+	const size_t parent = m_nodes[leaf].parent;
+	const size_t grandParent = m_nodes[parent].parent;
+	const size_t sibling = (m_nodes[parent].child1 == leaf) ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+	if( grandParent != SPATIALINDEX_NULL ) {
+		// Replace the parent with the sibling
+		if( m_nodes[grandParent].child1 == parent ) {
+			m_nodes[grandParent].child1 = sibling;
+		} else {
+			m_nodes[grandParent].child2 = sibling;
+		}
+		m_nodes[sibling].parent = grandParent;
+		freeNode(parent);
+
+		size_t index = grandParent;
+		while( index != SPATIALINDEX_NULL ) {
+			index = balance(index);
+			refitNode(index);
+			index = m_nodes[index].parent;
+		}
+	} else {
+		m_root = sibling;
+		m_nodes[sibling].parent = SPATIALINDEX_NULL;
+		freeNode(parent);
+	}
+	m_nodes[leaf].parent = SPATIALINDEX_NULL;
+}
+
+size_t SpatialIndex::balance(const size_t iA) {
+	Node& A = m_nodes[iA];
+	if( A.child1 == SPATIALINDEX_NULL || A.height < 2 ) {
+		return iA;
+	}
+
+	const size_t iB = A.child1;
+	const size_t iC = A.child2;
+	Node& B = m_nodes[iB];
+	Node& C = m_nodes[iC];
+	const int imbalance = C.height - B.height;
+
+	if( imbalance > 1 ) {
+		// Rotate C up
+		const size_t iF = C.child1;
+		const size_t iG = C.child2;
+		Node& F = m_nodes[iF];
+		Node& G = m_nodes[iG];
+
+		C.child1 = iA;
+		C.parent = A.parent;
+		A.parent = iC;
+		if( C.parent != SPATIALINDEX_NULL ) {
+			if( m_nodes[C.parent].child1 == iA ) {
+				m_nodes[C.parent].child1 = iC;
+			} else {
+				m_nodes[C.parent].child2 = iC;
+			}
+		} else {
+			m_root = iC;
+		}
+
+		// The taller of F and G stays with C
+		if( F.height > G.height ) {
+			C.child2 = iF;
+			A.child2 = iG;
+			G.parent = iA;
+		} else {
+			C.child2 = iG;
+			A.child2 = iF;
+			F.parent = iA;
+		}
+		refitNode(iA);
+		refitNode(iC);
+		return iC;
+	}
+
+	if( imbalance < -1 ) {
+		// Rotate B up
+		const size_t iD = B.child1;
+		const size_t iE = B.child2;
+		Node& D = m_nodes[iD];
+		Node& E = m_nodes[iE];
+
+		B.child1 = iA;
+		B.parent = A.parent;
+		A.parent = iB;
+		if( B.parent != SPATIALINDEX_NULL ) {
+			if( m_nodes[B.parent].child1 == iA ) {
+				m_nodes[B.parent].child1 = iB;
+			} else {
+				m_nodes[B.parent].child2 = iB;
+			}
+		} else {
+			m_root = iB;
+		}
+
+		// The taller of D and E stays with B
+		if( D.height > E.height ) {
+			B.child2 = iD;
+			A.child1 = iE;
+			E.parent = iA;
+		} else {
+			B.child2 = iE;
+			A.child1 = iD;
+			D.parent = iA;
+		}
+		refitNode(iA);
+		refitNode(iB);
+		return iB;
+	}
+
+	return iA;
+}
+
+void SpatialIndex::refitNode(const size_t index) {
+	Node& node = m_nodes[index];
+	const Node& child1 = m_nodes[node.child1];
+	const Node& child2 = m_nodes[node.child2];
+	combine(node.min, node.max, child1.min, child1.max, child2.min, child2.max);
+	node.height = 1 + ((child1.height > child2.height) ? child1.height : child2.height);
+}
+
+size_t SpatialIndex::buildRange(std::vector<size_t>& leaves, const size_t begin, const size_t end) {
+	if( end - begin == 1 ) {
+		return leaves[begin];
+	}
+
+	// Split at the median along the longest axis of the bounds of the centres
+	XMFLOAT3 min = m_nodes[leaves[begin]].center;
+	XMFLOAT3 max = min;
+	for( size_t i = begin + 1; i < end; ++i ) {
+		const XMFLOAT3& c = m_nodes[leaves[i]].center;
+		combine(min, max, min, max, c, c);
+	}
+	const float extents[3] = { max.x - min.x, max.y - min.y, max.z - min.z };
+	size_t axis = (extents[1] > extents[0]) ? 1 : 0;
+	axis = (extents[2] > extents[axis]) ? 2 : axis;
+
+	const size_t middle = begin + (end - begin) / 2;
+	struct LeafCenterLess {
+		const std::vector<Node>* nodes;
+		size_t axis;
+		bool operator()(const size_t a, const size_t b) const {
+			return (&(*nodes)[a].center.x)[axis] < (&(*nodes)[b].center.x)[axis];
+		}
+	} less;
+	less.nodes = &m_nodes;
+	less.axis = axis;
+	std::nth_element(leaves.begin() + begin, leaves.begin() + middle, leaves.begin() + end, less);
+
+	const size_t child1 = buildRange(leaves, begin, middle);
+	const size_t child2 = buildRange(leaves, middle, end);
+	const size_t index = allocateNode();
+	Node& node = m_nodes[index];
+	node.child1 = child1;
+	node.child2 = child2;
+	m_nodes[child1].parent = index;
+	m_nodes[child2].parent = index;
+	refitNode(index);
+	return index;
+}
@@ -24,19 +24,185 @@ Description
 #include "defs.h"
 #include <exception>
 #include <cmath>
+#include <cstring>
+#include <cfloat> // For FLT_MAX
 
 using namespace DirectX;
-using std::list;
+
+std::atomic<UINT64> Spline::s_nextId(0);
+
+namespace {
+
+	// A piece of a segment, produced by subdividing the segment
+	struct SubCurve {
+		XMFLOAT3 p[4];
+		float start;
+		float end;
+		size_t depth;
+	};
+
+	void setEmpty(XMFLOAT3& min, XMFLOAT3& max) {
+		min = XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX);
+		max = XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+	}
+
+	bool isEmpty(const XMFLOAT3& min, const XMFLOAT3& max) {
+		return min.x > max.x;
+	}
+
+	void combine(XMFLOAT3& min, XMFLOAT3& max,
+		const XMFLOAT3& minA, const XMFLOAT3& maxA,
+		const XMFLOAT3& minB, const XMFLOAT3& maxB) {
+		min.x = (minA.x < minB.x) ? minA.x : minB.x;
+		min.y = (minA.y < minB.y) ? minA.y : minB.y;
+		min.z = (minA.z < minB.z) ? minA.z : minB.z;
+		max.x = (maxA.x > maxB.x) ? maxA.x : maxB.x;
+		max.y = (maxA.y > maxB.y) ? maxA.y : maxB.y;
+		max.z = (maxA.z > maxB.z) ? maxA.z : maxB.z;
+	}
+
+	float distanceSquaredToBox(const XMFLOAT3& point, const XMFLOAT3& min, const XMFLOAT3& max) {
+		const float dx = (point.x < min.x) ? (min.x - point.x) : ((point.x > max.x) ? (point.x - max.x) : 0.0f);
+		const float dy = (point.y < min.y) ? (min.y - point.y) : ((point.y > max.y) ? (point.y - max.y) : 0.0f);
+		const float dz = (point.z < min.z) ? (min.z - point.z) : ((point.z > max.z) ? (point.z - max.z) : 0.0f);
+		return dx * dx + dy * dy + dz * dz;
+	}
+
+	/* Returns true if the ray segment from 'origin', with the given
+	   inverse direction and length, intersects the box enlarged by 'margin'
+	   on each side (slab test)
+	 */
+	bool rayIntersectsBox(const XMFLOAT3& origin, const XMFLOAT3& inverseDirection,
+		const float length, const XMFLOAT3& min, const XMFLOAT3& max, const float margin) {
+		const float o[3] = { origin.x, origin.y, origin.z };
+		const float inv[3] = { inverseDirection.x, inverseDirection.y, inverseDirection.z };
+		const float lo[3] = { min.x - margin, min.y - margin, min.z - margin };
+		const float hi[3] = { max.x + margin, max.y + margin, max.z + margin };
+		float tMin = 0.0f;
+		float tMax = length;
+		for( size_t i = 0; i < 3; ++i ) {
+			float t1 = (lo[i] - o[i]) * inv[i];
+			float t2 = (hi[i] - o[i]) * inv[i];
+			if( t1 > t2 ) {
+				const float temp = t1;
+				t1 = t2;
+				t2 = temp;
+			}
+			// NaN results, for origins on slab planes parallel to the ray, do not reject the box
+			tMin = (t1 > tMin) ? t1 : tMin;
+			tMax = (t2 < tMax) ? t2 : tMax;
+			if( tMin > tMax ) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/* Returns the squared distance from 'point' to the ray segment from 'origin'
+	   in the unit direction 'direction', with the given length
+	 */
+	float distanceSquaredToRay(const XMFLOAT3& point, const XMFLOAT3& origin,
+		const XMFLOAT3& direction, const float length) {
+		const XMFLOAT3 w(point.x - origin.x, point.y - origin.y, point.z - origin.z);
+		float s = w.x * direction.x + w.y * direction.y + w.z * direction.z;
+		s = (s < 0.0f) ? 0.0f : ((s > length) ? length : s);
+		const XMFLOAT3 d(w.x - s * direction.x, w.y - s * direction.y, w.z - s * direction.z);
+		return d.x * d.x + d.y * d.y + d.z * d.z;
+	}
+
+	/* As above, but also outputs the distance along the ray
+	   of the closest point on the ray
+	 */
+	float distanceSquaredToRay(float& s, const XMVECTOR& point, const XMVECTOR& origin,
+		const XMVECTOR& direction, const float length) {
+		const XMVECTOR w = XMVectorSubtract(point, origin);
+		s = XMVectorGetX(XMVector3Dot(w, direction));
+		s = (s < 0.0f) ? 0.0f : ((s > length) ? length : s);
+		return XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(w, XMVectorScale(direction, s))));
+	}
+
+	void boundingBox(XMFLOAT3& min, XMFLOAT3& max, const XMFLOAT3* const points) {
+		combine(min, max, points[0], points[0], points[1], points[1]);
+		combine(min, max, min, max, points[2], points[2]);
+		combine(min, max, min, max, points[3], points[3]);
+	}
+
+	/* Returns true if the inner control points of the piece are close
+	   to the points one third and two thirds of the way along its chord,
+	   in which case the piece is nearly a straight line traversed
+	   at a nearly constant speed, and its distance to a point or ray
+	   has at most one minimum in its interior
+	 */
+	bool isFlat(const XMFLOAT3* const p) {
+		const XMVECTOR p0 = XMLoadFloat3(p);
+		const XMVECTOR p3 = XMLoadFloat3(p + 3);
+		const XMVECTOR chord = XMVectorSubtract(p3, p0);
+		const float limit = SPLINE_CLOSEST_POINT_FLATNESS * SPLINE_CLOSEST_POINT_FLATNESS *
+			XMVectorGetX(XMVector3LengthSq(chord));
+		const XMVECTOR third = XMVectorScale(chord, 1.0f / 3.0f);
+		const XMVECTOR d1 = XMVectorSubtract(XMLoadFloat3(p + 1), XMVectorAdd(p0, third));
+		const XMVECTOR d2 = XMVectorSubtract(XMLoadFloat3(p + 2), XMVectorSubtract(p3, third));
+		return XMVectorGetX(XMVector3LengthSq(d1)) <= limit &&
+			XMVectorGetX(XMVector3LengthSq(d2)) <= limit;
+	}
+
+	// Splits the piece at the middle of its parameter interval (de Casteljau's algorithm)
+	void split(SubCurve& left, SubCurve& right, const SubCurve& curve) {
+		const XMVECTOR p0 = XMLoadFloat3(curve.p);
+		const XMVECTOR p1 = XMLoadFloat3(curve.p + 1);
+		const XMVECTOR p2 = XMLoadFloat3(curve.p + 2);
+		const XMVECTOR p3 = XMLoadFloat3(curve.p + 3);
+		const XMVECTOR p01 = XMVectorLerp(p0, p1, 0.5f);
+		const XMVECTOR p12 = XMVectorLerp(p1, p2, 0.5f);
+		const XMVECTOR p23 = XMVectorLerp(p2, p3, 0.5f);
+		const XMVECTOR p012 = XMVectorLerp(p01, p12, 0.5f);
+		const XMVECTOR p123 = XMVectorLerp(p12, p23, 0.5f);
+		const XMVECTOR middle = XMVectorLerp(p012, p123, 0.5f);
+		const float t = 0.5f * (curve.start + curve.end);
+
+		left.p[0] = curve.p[0];
+		XMStoreFloat3(left.p + 1, p01);
+		XMStoreFloat3(left.p + 2, p012);
+		XMStoreFloat3(left.p + 3, middle);
+		left.start = curve.start;
+		left.end = t;
+		left.depth = curve.depth + 1;
+
+		right.p[0] = left.p[3];
+		XMStoreFloat3(right.p + 1, p123);
+		XMStoreFloat3(right.p + 2, p23);
+		right.p[3] = curve.p[3];
+		right.start = t;
+		right.end = curve.end;
+		right.depth = curve.depth + 1;
+	}
+}
 
 Spline::Spline(const size_t capacity,
 	const bool useForward, const float* const speed,
 	const bool ownTransforms) :
 	m_capacity(capacity), m_speed(0), m_useForward(useForward),
-	m_ownTransforms(ownTransforms), m_knots()
+	m_ownTransforms(ownTransforms), m_knots(capacity + 1),
+	m_segmentArcLengths(capacity + 1, 0.0f), m_arcLengthsValid(false),
+	m_boundsTree(), m_nBoundsLeaves(1),
+	m_staleBounds(), m_isBoundsStale(capacity + 1, false),
+	m_boundsValid(false),
+	m_version(0), m_slotVersions(capacity + 1, 0),
+	m_id(s_nextId++)
 {
 	if( m_capacity == 0 ) {
 		throw std::exception("Cannot create a spline with a capacity of zero segments.");
 	}
+
+	// All boxes are initially empty
+	while( m_nBoundsLeaves < m_knots.capacity() ) {
+		m_nBoundsLeaves *= 2;
+	}
+	m_boundsTree.resize(2 * m_nBoundsLeaves);
+	for( size_t i = 0; i < m_boundsTree.size(); ++i ) {
+		setEmpty(m_boundsTree[i].min, m_boundsTree[i].max);
+	}
+	m_staleBounds.reserve(m_knots.capacity());
 	if( speed != 0 ) {
 		m_speed = new float(*speed);
 	} else if( m_useForward ) {
@@ -49,37 +215,42 @@ Spline::~Spline(void) {
 		delete m_speed;
 		m_speed = 0;
 	}
-	list<Knot*>::iterator start = m_knots.begin();
-	list<Knot*>::iterator end = m_knots.end();
-	while( start != end ) {
-		delete *start;
-		*start = 0;
-		++start;
+	for( size_t i = 0; i < m_knots.size(); ++i ) {
+		delete m_knots[i].knot;
+		m_knots[i].knot = 0;
 	}
 }
 
 HRESULT Spline::update(const DWORD currentTime, const DWORD updateTimeInterval) {
-	list<Knot*>::iterator start = m_knots.begin();
-	list<Knot*>::iterator end = m_knots.end();
-	while( start != end ) {
-		if( FAILED((*start)->update(currentTime, updateTimeInterval)) ) {
+	for( size_t i = 0; i < m_knots.size(); ++i ) {
+		if( FAILED(m_knots[i].knot->update(currentTime, updateTimeInterval)) ) {
 			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 		}
-		++start;
+		refreshControlPoints(i);
 	}
 	return ERROR_SUCCESS;
 }
 
 HRESULT Spline::getControlPoints(DirectX::XMFLOAT4*& controlPoints, const bool fillToCapacity) const {
-	if( getNumberOfSegments(false) > 0 ) {
-		list<Knot*>::const_iterator start = m_knots.cbegin();
-		list<Knot*>::const_iterator end = m_knots.cend();
-		while( start != end ) {
-			if( FAILED((*start)->getControlPoints(controlPoints)) ) {
-				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-			}
-			++start;
-		}
+	const size_t nSegments = getNumberOfSegments(false);
+	if( controlPoints == 0 && (nSegments > 0 || fillToCapacity) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+
+	// Each segment consists of p0 and p1 of one knot, followed by p2 and p3 of the next
+	const KnotSlot* preKnot = 0;
+	const KnotSlot* postKnot = 0;
+	for( size_t i = 0; i < nSegments; ++i ) {
+		preKnot = &m_knots[i];
+		postKnot = &m_knots[i + 1];
+		*controlPoints = XMFLOAT4(preKnot->p0.x, preKnot->p0.y, preKnot->p0.z, 1.0f);
+		++controlPoints;
+		*controlPoints = XMFLOAT4(preKnot->p1.x, preKnot->p1.y, preKnot->p1.z, 1.0f);
+		++controlPoints;
+		*controlPoints = XMFLOAT4(postKnot->p2.x, postKnot->p2.y, postKnot->p2.z, 1.0f);
+		++controlPoints;
+		*controlPoints = XMFLOAT4(postKnot->p3.x, postKnot->p3.y, postKnot->p3.z, 1.0f);
+		++controlPoints;
 	}
 
 	XMFLOAT4 zero = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
@@ -107,7 +278,7 @@ size_t Spline::getNumberOfSegments(const bool capacity) const {
 	if( capacity ) {
 		return m_capacity;
 	} else {
-		size_t n = static_cast<size_t>(m_knots.size());
+		size_t n = m_knots.size();
 		if( n < 2 ) {
 			/* The spline does not have segments until it has
 			   at least two knots
@@ -158,49 +329,79 @@ HRESULT Spline::addToEnd(Transformable* const transform, const bool dynamic) {
 }
 
 HRESULT Spline::removeFromStart(void) {
-	if( m_knots.size() == 0 ) {
+	if( m_knots.isEmpty() ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
 	}
 
-	delete m_knots.front();
-	m_knots.pop_front();
+	delete m_knots[0].knot;
+	m_knots[0].knot = 0;
+	invalidateSlot(m_knots.toDataIndex(0));
+	m_knots.popFront();
+	m_arcLengthsValid = false;
 
 	// Cleanup
 	HRESULT result = ERROR_SUCCESS;
-	list<Knot*>::size_type n = m_knots.size();
+	size_t n = m_knots.size();
 	if( n > 1 ) {
-		result = (m_knots.front())->makeHalf(Knot::PointSet::START);
+		result = m_knots[0].knot->makeHalf(Knot::PointSet::START);
 	} else if( n == 1 ) {
-		result = (m_knots.front())->makeDouble();
+		result = m_knots[0].knot->makeDouble();
 	}
 	if( FAILED(result) ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
+	if( n > 0 ) {
+		refreshControlPoints(0);
+	}
 	return result;
 }
 
 HRESULT Spline::removeFromEnd(void) {
-	if( m_knots.size() == 0 ) {
+	if( m_knots.isEmpty() ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
 	}
 
-	delete m_knots.back();
-	m_knots.pop_back();
+	size_t n = m_knots.size() - 1;
+	delete m_knots[n].knot;
+	m_knots[n].knot = 0;
+	invalidateSlot(m_knots.toDataIndex(n));
+	if( n > 0 ) {
+		// The new last knot does not start a segment
+		invalidateSlot(m_knots.toDataIndex(n - 1));
+	}
+	m_knots.popBack();
+	m_arcLengthsValid = false;
 
 	// Cleanup
 	HRESULT result = ERROR_SUCCESS;
-	list<Knot*>::size_type n = m_knots.size();
 	if( n > 1 ) {
-		result = (m_knots.back())->makeHalf(Knot::PointSet::END);
+		result = m_knots[n - 1].knot->makeHalf(Knot::PointSet::END);
 	} else if( n == 1 ) {
-		result = (m_knots.back())->makeDouble();
+		result = m_knots[n - 1].knot->makeDouble();
 	}
 	if( FAILED(result) ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
+	if( n > 0 ) {
+		refreshControlPoints(n - 1);
+	}
 	return result;
 }
 
+HRESULT Spline::setKnotControlPoints(const DirectX::XMFLOAT3* const controlPoints,
+	const size_t first, const size_t n) {
+	if( controlPoints == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	} else if( first + n > m_knots.size() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	for( size_t i = 0; i < n; ++i ) {
+		m_knots[first + i].knot->setControlPoints(controlPoints + 4 * i);
+		refreshControlPoints(first + i);
+	}
+	return ERROR_SUCCESS;
+}
+
 HRESULT Spline::addKnot(Knot* const knot, bool addToStart) {
 	HRESULT result = ERROR_SUCCESS;
 	if( isAtCapacity() ) {
@@ -215,18 +416,16 @@ HRESULT Spline::addKnot(Knot* const knot, bool addToStart) {
 		}
 	}
 
-	list<Knot*>::size_type n = m_knots.size();
+	// Index of the knot which will be adjacent to the new knot
+	size_t n = m_knots.size();
+	size_t neighbour = addToStart ? 0 : (n - 1);
 	if( n > 1 ) {
-		if( addToStart ) {
-			result = (m_knots.front())->makeDouble();
-		} else {
-			result = (m_knots.back())->makeDouble();
-		}
+		result = m_knots[neighbour].knot->makeDouble();
 	} else if( n == 1 ) {
 		if( addToStart ) {
-			result = (m_knots.front())->makeHalf(Knot::PointSet::END);
+			result = m_knots[neighbour].knot->makeHalf(Knot::PointSet::END);
 		} else {
-			result = (m_knots.back())->makeHalf(Knot::PointSet::START);
+			result = m_knots[neighbour].knot->makeHalf(Knot::PointSet::START);
 		}
 	} else if( n == 0 ) {
 		result = knot->makeDouble();
@@ -234,48 +433,46 @@ HRESULT Spline::addKnot(Knot* const knot, bool addToStart) {
 	if( FAILED(result) ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
+	if( n > 0 ) {
+		refreshControlPoints(neighbour);
+	}
 
 	// Add the knot
+	KnotSlot slot = KnotSlot();
+	slot.knot = knot;
+	slot.arcLengthValid = false;
 	if( addToStart ) {
-		m_knots.push_front(knot);
+		result = m_knots.pushFront(slot);
+		neighbour = 0;
 	} else {
-		m_knots.push_back(knot);
+		result = m_knots.pushBack(slot);
+		neighbour = n;
+	}
+	if( FAILED(result) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
 	}
+	refreshControlPoints(neighbour);
+
+	// The new segment is between the new knot and its neighbour
+	invalidateSegment(addToStart ? 0 : (n - 1));
 
 	return result;
 }
 
 HRESULT Spline::eval(XMFLOAT3* const position, XMFLOAT3* const direction, const float& t) const {
-	Knot* preKnot = 0;
-	Knot* postKnot = 0;
+	size_t segmentIndex = 0;
 	float segmentT = 0.0f;
-	if( !globalTtoSegmentT(preKnot, postKnot, segmentT, t) ) {
+	if( !globalTtoSegmentT(segmentIndex, segmentT, t) ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
 	}
 
 	// Get segment control points
-	DirectX::XMFLOAT3 temp;
-	XMVECTOR p0, p1, p2, p3;
-	if( FAILED(preKnot->getP0(temp)) ) {
-		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-	} else {
-		p0 = XMLoadFloat3(&temp);
-	}
-	if( FAILED(preKnot->getP1(temp)) ) {
-		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-	} else {
-		p1 = XMLoadFloat3(&temp);
-	}
-	if( FAILED(postKnot->getP2(temp)) ) {
-		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-	} else {
-		p2 = XMLoadFloat3(&temp);
-	}
-	if( FAILED(postKnot->getP3(temp)) ) {
-		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
-	} else {
-		p3 = XMLoadFloat3(&temp);
-	}
+	const KnotSlot& preKnot = m_knots[segmentIndex];
+	const KnotSlot& postKnot = m_knots[segmentIndex + 1];
+	XMVECTOR p0 = XMLoadFloat3(&preKnot.p0);
+	XMVECTOR p1 = XMLoadFloat3(&preKnot.p1);
+	XMVECTOR p2 = XMLoadFloat3(&postKnot.p2);
+	XMVECTOR p3 = XMLoadFloat3(&postKnot.p3);
 
 	// Compute spline position
 	float invSegmentT = 1.0f - segmentT;
@@ -325,7 +522,117 @@ HRESULT Spline::eval(Transformable* const transform, const float& t) const {
 	return ERROR_SUCCESS;
 }
 
-bool Spline::globalTtoSegmentT(Knot*& preKnot, Knot*& postKnot, float& segmentT, const float& t) const {
+HRESULT Spline::evalBatch(const float* const t, const size_t n,
+	XMFLOAT3* const positions, XMFLOAT3* const firstDerivatives,
+	XMFLOAT3* const secondDerivatives) const {
+
+	const size_t segments = getNumberOfSegments();
+	if( segments == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+	if( n > 0 && (t == 0 || positions == 0) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+
+	/* Parameter values are evaluated four at a time, one per vector lane.
+	   The polynomial coefficients of each coordinate are transposed
+	   so that each lane holds the coefficients of the segment of its parameter value,
+	   and are reused while the segments of the lanes do not change.
+	 */
+	const float scale = static_cast<float>(segments);
+	XMVECTOR a, b, c, d;
+	XMMATRIX rows; // Rows of coefficients (a, b, c, d) of 'currentSegment', for x, y and z
+	XMFLOAT4 laneRows[3][4]; // Coefficient rows of the segment of each lane, for x, y and z
+	XMMATRIX coefficients[3]; // Transposed 'laneRows': Vectors of a, b, c and d, for x, y and z
+	XMMATRIX firstCoefficients[3]; // Scaled coefficients of the first derivative
+	XMMATRIX secondCoefficients[3]; // Scaled coefficients of the second derivative
+	XMMATRIX output;
+	XMVECTOR s;
+	XMVECTOR results[3];
+	float segmentT[4];
+	size_t segmentIndex = 0;
+	size_t currentSegment = segments; // No segment
+	size_t laneSegments[4] = { segments, segments, segments, segments }; // No segments
+	size_t count = 0;
+	size_t j = 0;
+	size_t k = 0;
+	bool sameSegments = true;
+
+	for( size_t i = 0; i < n; i += 4 ) {
+		count = (n - i < 4) ? (n - i) : 4;
+
+		// Unused lanes repeat the last parameter value
+		sameSegments = true;
+		for( k = 0; k < 4; ++k ) {
+			globalTtoSegmentT(segmentIndex, segmentT[k], t[i + ((k < count) ? k : (count - 1))]);
+			if( segmentIndex != laneSegments[k] ) {
+				if( segmentIndex != currentSegment ) {
+					getSegmentCoefficients(segmentIndex, a, b, c, d);
+					rows = XMMatrixTranspose(XMMATRIX(a, b, c, d));
+					currentSegment = segmentIndex;
+				}
+				for( j = 0; j < 3; ++j ) {
+					XMStoreFloat4(&laneRows[j][k], rows.r[j]);
+				}
+				laneSegments[k] = segmentIndex;
+				sameSegments = false;
+			}
+		}
+
+		if( !sameSegments ) {
+			for( j = 0; j < 3; ++j ) {
+				coefficients[j] = XMMatrixTranspose(XMMATRIX(
+					XMLoadFloat4(&laneRows[j][0]), XMLoadFloat4(&laneRows[j][1]),
+					XMLoadFloat4(&laneRows[j][2]), XMLoadFloat4(&laneRows[j][3])));
+
+				// Derivatives with respect to 't' are scaled by the number of segments
+				if( firstDerivatives != 0 ) {
+					firstCoefficients[j].r[0] = XMVectorScale(coefficients[j].r[1], scale);
+					firstCoefficients[j].r[1] = XMVectorScale(coefficients[j].r[2], 2.0f * scale);
+					firstCoefficients[j].r[2] = XMVectorScale(coefficients[j].r[3], 3.0f * scale);
+				}
+				if( secondDerivatives != 0 ) {
+					secondCoefficients[j].r[0] = XMVectorScale(coefficients[j].r[2], 2.0f * scale * scale);
+					secondCoefficients[j].r[1] = XMVectorScale(coefficients[j].r[3], 6.0f * scale * scale);
+				}
+			}
+		}
+		s = XMVectorSet(segmentT[0], segmentT[1], segmentT[2], segmentT[3]);
+
+		for( j = 0; j < 3; ++j ) {
+			results[j] = XMVectorMultiplyAdd(XMVectorMultiplyAdd(XMVectorMultiplyAdd(
+				coefficients[j].r[3], s, coefficients[j].r[2]), s, coefficients[j].r[1]), s, coefficients[j].r[0]);
+		}
+		output = XMMatrixTranspose(XMMATRIX(results[0], results[1], results[2], XMVectorZero()));
+		for( k = 0; k < count; ++k ) {
+			XMStoreFloat3(positions + i + k, output.r[k]);
+		}
+
+		if( firstDerivatives != 0 ) {
+			for( j = 0; j < 3; ++j ) {
+				results[j] = XMVectorMultiplyAdd(XMVectorMultiplyAdd(
+					firstCoefficients[j].r[2], s, firstCoefficients[j].r[1]), s, firstCoefficients[j].r[0]);
+			}
+			output = XMMatrixTranspose(XMMATRIX(results[0], results[1], results[2], XMVectorZero()));
+			for( k = 0; k < count; ++k ) {
+				XMStoreFloat3(firstDerivatives + i + k, output.r[k]);
+			}
+		}
+
+		if( secondDerivatives != 0 ) {
+			for( j = 0; j < 3; ++j ) {
+				results[j] = XMVectorMultiplyAdd(secondCoefficients[j].r[1], s, secondCoefficients[j].r[0]);
+			}
+			output = XMMatrixTranspose(XMMATRIX(results[0], results[1], results[2], XMVectorZero()));
+			for( k = 0; k < count; ++k ) {
+				XMStoreFloat3(secondDerivatives + i + k, output.r[k]);
+			}
+		}
+	}
+	return ERROR_SUCCESS;
+}
+
+bool Spline::globalTtoSegmentT(size_t& segmentIndex, float& segmentT, const float& t) const {
 	size_t segments = getNumberOfSegments();
 	if( segments == 0 ) {
 		return false;
@@ -334,16 +641,642 @@ bool Spline::globalTtoSegmentT(Knot*& preKnot, Knot*& postKnot, float& segmentT,
 	// Compute segment parameters
 	float adjustedT = t - floor(t); // Wrap to [0, 1]
 	segmentT = adjustedT * segments;
-	size_t segmentIndex = static_cast<size_t>(segmentT);
+	segmentIndex = static_cast<size_t>(segmentT);
 	segmentT = segmentT - floor(segmentT);
 
-	// Retrieve knots corresponding to the segment
-	std::list<Knot*>::const_iterator itr = m_knots.cbegin();
-	for( size_t i = 0; i < segmentIndex; ++i ) {
-		++itr;
+	// Rounding can produce an index one past the last segment
+	if( segmentIndex >= segments ) {
+		segmentIndex = segments - 1;
+		segmentT = 1.0f;
 	}
-	preKnot = *itr;
-	++itr;
-	postKnot = *itr;
 	return true;
 }
+
+void Spline::getSegmentCoefficients(const size_t segmentIndex,
+	XMVECTOR& a, XMVECTOR& b, XMVECTOR& c, XMVECTOR& d) const {
+	const KnotSlot& preKnot = m_knots[segmentIndex];
+	const KnotSlot& postKnot = m_knots[segmentIndex + 1];
+	XMVECTOR p0 = XMLoadFloat3(&preKnot.p0);
+	XMVECTOR p1 = XMLoadFloat3(&preKnot.p1);
+	XMVECTOR p2 = XMLoadFloat3(&postKnot.p2);
+	XMVECTOR p3 = XMLoadFloat3(&postKnot.p3);
+
+	// Expansion of the Bernstein form into powers of 's'
+	a = p0;
+	b = XMVectorScale(XMVectorSubtract(p1, p0), 3.0f);
+	c = XMVectorScale(XMVectorAdd(XMVectorSubtract(p0, XMVectorScale(p1, 2.0f)), p2), 3.0f);
+	d = XMVectorAdd(XMVectorSubtract(p3, p0), XMVectorScale(XMVectorSubtract(p1, p2), 3.0f));
+}
+
+HRESULT Spline::updateArcLengths(void) {
+	const size_t segments = getNumberOfSegments();
+	if( segments == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+	if( m_arcLengthsValid ) {
+		return ERROR_SUCCESS;
+	}
+
+	XMVECTOR a, b, c, d;
+	const float interval = 1.0f / SPLINE_ARC_LENGTH_SAMPLES;
+	float start = 0.0f;
+	float length = 0.0f;
+	for( size_t i = 0; i < segments; ++i ) {
+		KnotSlot& slot = m_knots[i];
+		if( !slot.arcLengthValid ) {
+			getSegmentCoefficients(i, a, b, c, d);
+			length = 0.0f;
+			for( size_t k = 0; k < SPLINE_ARC_LENGTH_SAMPLES; ++k ) {
+				start = k * interval;
+				length += integrateArcLengthAdaptive(b, c, d, start, start + interval,
+					integrateArcLength(b, c, d, start, start + interval), 0);
+				slot.arcLengths[k] = length;
+			}
+			slot.arcLengthValid = true;
+		}
+		m_segmentArcLengths[i + 1] = m_segmentArcLengths[i] + slot.arcLengths[SPLINE_ARC_LENGTH_SAMPLES - 1];
+	}
+	m_arcLengthsValid = true;
+	return ERROR_SUCCESS;
+}
+
+bool Spline::areArcLengthsValid(void) const {
+	return m_arcLengthsValid && getNumberOfSegments() > 0;
+}
+
+HRESULT Spline::getArcLength(float& length) const {
+	if( !areArcLengthsValid() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+	length = m_segmentArcLengths[getNumberOfSegments()];
+	return ERROR_SUCCESS;
+}
+
+HRESULT Spline::arcLengthToT(float& t, const float& s) const {
+	if( !areArcLengthsValid() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+
+	const size_t segments = getNumberOfSegments();
+	const float totalLength = m_segmentArcLengths[segments];
+	float adjustedS = s - floor(s); // Wrap to [0, 1]
+	if( totalLength <= 0.0f ) {
+		t = adjustedS;
+		return ERROR_SUCCESS;
+	}
+	const float target = adjustedS * totalLength;
+
+	// Binary search for the last segment starting at or before the target length
+	size_t low = 0;
+	size_t high = segments;
+	size_t middle = 0;
+	while( high - low > 1 ) {
+		middle = (low + high) / 2;
+		if( m_segmentArcLengths[middle] <= target ) {
+			low = middle;
+		} else {
+			high = middle;
+		}
+	}
+	const size_t segmentIndex = low;
+	const KnotSlot& slot = m_knots[segmentIndex];
+	const float segmentTarget = target - m_segmentArcLengths[segmentIndex];
+
+	// Binary search for the first interval ending at or after the target length
+	low = 0;
+	high = SPLINE_ARC_LENGTH_SAMPLES - 1;
+	while( low < high ) {
+		middle = (low + high) / 2;
+		if( slot.arcLengths[middle] < segmentTarget ) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	const float interval = 1.0f / SPLINE_ARC_LENGTH_SAMPLES;
+	const float intervalStart = low * interval;
+	const float intervalEnd = intervalStart + interval;
+	const float lengthAtStart = (low == 0) ? 0.0f : slot.arcLengths[low - 1];
+	const float intervalLength = slot.arcLengths[low] - lengthAtStart;
+
+	// Newton iterations, starting from linear interpolation within the interval
+	float segmentT = intervalStart;
+	if( intervalLength > 0.0f ) {
+		segmentT += interval * (segmentTarget - lengthAtStart) / intervalLength;
+
+		XMVECTOR a, b, c, d;
+		getSegmentCoefficients(segmentIndex, a, b, c, d);
+		float error = 0.0f;
+		float speed = 0.0f;
+		const float tolerance = SPLINE_ARC_LENGTH_TOLERANCE * slot.arcLengths[SPLINE_ARC_LENGTH_SAMPLES - 1];
+		for( size_t i = 0; i < SPLINE_ARC_LENGTH_NEWTON_ITERATIONS; ++i ) {
+			error = lengthAtStart + integrateArcLengthAdaptive(b, c, d, intervalStart, segmentT,
+				integrateArcLength(b, c, d, intervalStart, segmentT), 0) - segmentTarget;
+			speed = segmentSpeed(b, c, d, segmentT);
+			if( fabs(error) <= tolerance || speed <= 0.0f ) {
+				break;
+			}
+			segmentT -= error / speed;
+			if( segmentT < intervalStart ) {
+				segmentT = intervalStart;
+			} else if( segmentT > intervalEnd ) {
+				segmentT = intervalEnd;
+			}
+		}
+	}
+
+	t = (static_cast<float>(segmentIndex) + segmentT) / static_cast<float>(segments);
+	if( t > 1.0f ) {
+		t = 1.0f;
+	}
+	return ERROR_SUCCESS;
+}
+
+HRESULT Spline::tToArcLength(float& s, const float& t) const {
+	if( !areArcLengthsValid() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+
+	const size_t segments = getNumberOfSegments();
+	const float totalLength = m_segmentArcLengths[segments];
+	size_t segmentIndex = 0;
+	float segmentT = 0.0f;
+	globalTtoSegmentT(segmentIndex, segmentT, t);
+	if( totalLength <= 0.0f ) {
+		s = (static_cast<float>(segmentIndex) + segmentT) / static_cast<float>(segments);
+		return ERROR_SUCCESS;
+	}
+
+	size_t intervalIndex = static_cast<size_t>(segmentT * SPLINE_ARC_LENGTH_SAMPLES);
+	if( intervalIndex >= SPLINE_ARC_LENGTH_SAMPLES ) {
+		intervalIndex = SPLINE_ARC_LENGTH_SAMPLES - 1;
+	}
+	const KnotSlot& slot = m_knots[segmentIndex];
+	float length = m_segmentArcLengths[segmentIndex];
+	if( intervalIndex > 0 ) {
+		length += slot.arcLengths[intervalIndex - 1];
+	}
+
+	XMVECTOR a, b, c, d;
+	getSegmentCoefficients(segmentIndex, a, b, c, d);
+	const float intervalStart = static_cast<float>(intervalIndex) / SPLINE_ARC_LENGTH_SAMPLES;
+	length += integrateArcLengthAdaptive(b, c, d, intervalStart, segmentT,
+		integrateArcLength(b, c, d, intervalStart, segmentT), 0);
+	s = length / totalLength;
+	if( s > 1.0f ) {
+		s = 1.0f;
+	}
+	return ERROR_SUCCESS;
+}
+
+HRESULT Spline::updateBounds(void) {
+	const size_t segments = getNumberOfSegments();
+	if( segments == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+
+	for( size_t i = 0; i < m_staleBounds.size(); ++i ) {
+		const size_t dataIndex = m_staleBounds[i];
+		m_isBoundsStale[dataIndex] = false;
+		size_t node = m_nBoundsLeaves + dataIndex;
+		BoundsNode& leaf = m_boundsTree[node];
+
+		// The box of the control points contains their convex hull
+		const size_t segmentIndex = m_knots.toIndex(dataIndex);
+		if( segmentIndex < segments ) {
+			const KnotSlot& preKnot = m_knots[segmentIndex];
+			const KnotSlot& postKnot = m_knots[segmentIndex + 1];
+			combine(leaf.min, leaf.max, preKnot.p0, preKnot.p0, preKnot.p1, preKnot.p1);
+			combine(leaf.min, leaf.max, leaf.min, leaf.max, postKnot.p2, postKnot.p2);
+			combine(leaf.min, leaf.max, leaf.min, leaf.max, postKnot.p3, postKnot.p3);
+		} else {
+			setEmpty(leaf.min, leaf.max);
+		}
+
+		// Update the ancestors
+		while( node > 1 ) {
+			node /= 2;
+			BoundsNode& parent = m_boundsTree[node];
+			const BoundsNode& left = m_boundsTree[2 * node];
+			const BoundsNode& right = m_boundsTree[2 * node + 1];
+			combine(parent.min, parent.max, left.min, left.max, right.min, right.max);
+		}
+	}
+	m_staleBounds.clear();
+	m_boundsValid = true;
+	return ERROR_SUCCESS;
+}
+
+bool Spline::areBoundsValid(void) const {
+	return m_boundsValid && getNumberOfSegments() > 0;
+}
+
+HRESULT Spline::getBounds(XMFLOAT3& min, XMFLOAT3& max) const {
+	if( !areBoundsValid() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+	min = m_boundsTree[1].min;
+	max = m_boundsTree[1].max;
+	return ERROR_SUCCESS;
+}
+
+HRESULT Spline::getSegmentBounds(XMFLOAT3& min, XMFLOAT3& max, const size_t segmentIndex) const {
+	if( !areBoundsValid() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	} else if( segmentIndex >= getNumberOfSegments() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	const BoundsNode& leaf = m_boundsTree[m_nBoundsLeaves + m_knots.toDataIndex(segmentIndex)];
+	min = leaf.min;
+	max = leaf.max;
+	return ERROR_SUCCESS;
+}
+
+HRESULT Spline::closestPoint(float& t, XMFLOAT3& position, float& distance,
+	const XMFLOAT3& point) const {
+	if( !areBoundsValid() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+	float rayDistance = 0.0f;
+	distance = std::sqrt(closestPointToRaySegment(t, position, rayDistance,
+		point, XMFLOAT3(1.0f, 0.0f, 0.0f), 0.0f));
+	return ERROR_SUCCESS;
+}
+
+HRESULT Spline::closestPointToRay(float& t, float& rayDistance, float& distance,
+	const XMFLOAT3& origin, const XMFLOAT3& direction, const float maxLength) const {
+	if( !areBoundsValid() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+	const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+	if( length == 0.0f || !(maxLength > 0.0f) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	const XMFLOAT3 unitDirection(direction.x / length, direction.y / length, direction.z / length);
+	XMFLOAT3 position;
+	distance = std::sqrt(closestPointToRaySegment(t, position, rayDistance,
+		origin, unitDirection, maxLength));
+	return ERROR_SUCCESS;
+}
+
+size_t Spline::getNumberOfSegmentSlots(void) const {
+	return m_knots.capacity();
+}
+
+size_t Spline::getSegmentSlotOffset(void) const {
+	return m_knots.toDataIndex(0);
+}
+
+UINT64 Spline::getVersion(void) const {
+	return m_version;
+}
+
+UINT64 Spline::getId(void) const {
+	return m_id;
+}
+
+void Spline::getChangedSlotRanges(std::vector<std::pair<size_t, size_t> >& ranges,
+	const UINT64 version) const {
+	const size_t segments = getNumberOfSegments();
+	const size_t nSlots = m_knots.capacity();
+	size_t first = nSlots; // No run
+	for( size_t slot = 0; slot < nSlots; ++slot ) {
+		if( m_slotVersions[slot] > version && m_knots.toIndex(slot) < segments ) {
+			if( first == nSlots ) {
+				first = slot;
+			}
+		} else if( first != nSlots ) {
+			ranges.push_back(std::pair<size_t, size_t>(first, slot - first));
+			first = nSlots;
+		}
+	}
+	if( first != nSlots ) {
+		ranges.push_back(std::pair<size_t, size_t>(first, nSlots - first));
+	}
+}
+
+HRESULT Spline::getSlotControlPoints(XMFLOAT4* const controlPoints,
+	const size_t firstSlot, const size_t nSlots) const {
+	if( controlPoints == 0 && nSlots > 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	} else if( firstSlot + nSlots > m_knots.capacity() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+
+	const size_t segments = getNumberOfSegments();
+	XMFLOAT4* output = controlPoints;
+	for( size_t slot = firstSlot; slot < firstSlot + nSlots; ++slot ) {
+		const size_t segmentIndex = m_knots.toIndex(slot);
+		if( segmentIndex < segments ) {
+			const KnotSlot& preKnot = m_knots[segmentIndex];
+			const KnotSlot& postKnot = m_knots[segmentIndex + 1];
+			output[0] = XMFLOAT4(preKnot.p0.x, preKnot.p0.y, preKnot.p0.z, 1.0f);
+			output[1] = XMFLOAT4(preKnot.p1.x, preKnot.p1.y, preKnot.p1.z, 1.0f);
+			output[2] = XMFLOAT4(postKnot.p2.x, postKnot.p2.y, postKnot.p2.z, 1.0f);
+			output[3] = XMFLOAT4(postKnot.p3.x, postKnot.p3.y, postKnot.p3.z, 1.0f);
+		} else {
+			output[0] = output[1] = output[2] = output[3] = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
+		}
+		output += 4;
+	}
+	return ERROR_SUCCESS;
+}
+
+float Spline::closestPointToRaySegment(float& t, XMFLOAT3& position, float& rayDistance,
+	const XMFLOAT3& origin, const XMFLOAT3& direction, const float maxLength) const {
+
+	const bool isRay = (maxLength > 0.0f);
+	const XMFLOAT3 inverseDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+	const float segments = static_cast<float>(getNumberOfSegments());
+
+	float best = FLT_MAX;
+	float bestDistance = FLT_MAX; // Square root of 'best'
+	float segmentT = 0.0f;
+	float segmentRayDistance = 0.0f;
+	float distanceSquared = 0.0f;
+	XMFLOAT3 controlPoints[4];
+	XMVECTOR a, b, c, d;
+	std::vector<size_t> stack;
+	stack.reserve(64);
+	stack.push_back(1);
+	while( !stack.empty() ) {
+		const size_t node = stack.back();
+		stack.pop_back();
+		const BoundsNode& box = m_boundsTree[node];
+		if( isEmpty(box.min, box.max) ) {
+			continue;
+		}
+
+		// Skip boxes which cannot contain points closer than the closest point so far
+		if( isRay ) {
+			if( best < FLT_MAX && !rayIntersectsBox(origin, inverseDirection, maxLength, box.min, box.max, bestDistance) ) {
+				continue;
+			}
+		} else if( distanceSquaredToBox(origin, box.min, box.max) >= best ) {
+			continue;
+		}
+
+		if( node >= m_nBoundsLeaves ) {
+			const size_t segmentIndex = m_knots.toIndex(node - m_nBoundsLeaves);
+			const KnotSlot& preKnot = m_knots[segmentIndex];
+			const KnotSlot& postKnot = m_knots[segmentIndex + 1];
+			controlPoints[0] = preKnot.p0;
+			controlPoints[1] = preKnot.p1;
+			controlPoints[2] = postKnot.p2;
+			controlPoints[3] = postKnot.p3;
+			distanceSquared = closestPointOnSegment(segmentT, segmentRayDistance,
+				controlPoints, origin, direction, inverseDirection, maxLength, best);
+			if( distanceSquared < best ) {
+				best = distanceSquared;
+				bestDistance = std::sqrt(best);
+				t = (static_cast<float>(segmentIndex) + segmentT) / segments;
+				rayDistance = segmentRayDistance;
+				const XMVECTOR u = XMVectorReplicate(segmentT);
+				getSegmentCoefficients(segmentIndex, a, b, c, d);
+				XMStoreFloat3(&position, XMVectorMultiplyAdd(XMVectorMultiplyAdd(XMVectorMultiplyAdd(d, u, c), u, b), u, a));
+			}
+		} else {
+			// Visit the closer child first
+			const BoundsNode& left = m_boundsTree[2 * node];
+			const BoundsNode& right = m_boundsTree[2 * node + 1];
+			const XMFLOAT3 leftCenter(0.5f * (left.min.x + left.max.x), 0.5f * (left.min.y + left.max.y), 0.5f * (left.min.z + left.max.z));
+			const XMFLOAT3 rightCenter(0.5f * (right.min.x + right.max.x), 0.5f * (right.min.y + right.max.y), 0.5f * (right.min.z + right.max.z));
+			if( distanceSquaredToRay(leftCenter, origin, direction, maxLength) <
+				distanceSquaredToRay(rightCenter, origin, direction, maxLength) ) {
+				stack.push_back(2 * node + 1);
+				stack.push_back(2 * node);
+			} else {
+				stack.push_back(2 * node);
+				stack.push_back(2 * node + 1);
+			}
+		}
+	}
+	if( t > 1.0f ) {
+		t = 1.0f;
+	}
+	return best;
+}
+
+void Spline::invalidateSegment(const size_t segmentIndex) {
+	if( segmentIndex < getNumberOfSegments() ) {
+		m_knots[segmentIndex].arcLengthValid = false;
+		m_arcLengthsValid = false;
+		invalidateSlot(m_knots.toDataIndex(segmentIndex));
+	}
+}
+
+void Spline::invalidateSlot(const size_t slot) {
+	if( !m_isBoundsStale[slot] ) {
+		m_isBoundsStale[slot] = true;
+		m_staleBounds.push_back(slot);
+	}
+	m_boundsValid = false;
+	m_slotVersions[slot] = ++m_version;
+}
+
+float Spline::integrateArcLength(const XMVECTOR& b, const XMVECTOR& c, const XMVECTOR& d,
+	const float start, const float end) {
+
+	// Five-point Gauss-Legendre abscissae and weights on [-1, 1]
+	static const float abscissae[] = {
+		0.0f,
+		-0.5384693101056831f, 0.5384693101056831f,
+		-0.9061798459386640f, 0.9061798459386640f
+	};
+	static const float weights[] = {
+		0.5688888888888889f,
+		0.4786286704993665f, 0.4786286704993665f,
+		0.2369268850561891f, 0.2369268850561891f
+	};
+
+	const float halfWidth = 0.5f * (end - start);
+	const float midpoint = 0.5f * (end + start);
+	float sum = 0.0f;
+	for( size_t i = 0; i < 5; ++i ) {
+		sum += weights[i] * segmentSpeed(b, c, d, midpoint + halfWidth * abscissae[i]);
+	}
+	return sum * halfWidth;
+}
+
+float Spline::integrateArcLengthAdaptive(const XMVECTOR& b, const XMVECTOR& c, const XMVECTOR& d,
+	const float start, const float end, const float whole,
+	const size_t depth) {
+
+	const float midpoint = 0.5f * (start + end);
+	const float left = integrateArcLength(b, c, d, start, midpoint);
+	const float right = integrateArcLength(b, c, d, midpoint, end);
+	const float halves = left + right;
+	if( depth >= SPLINE_ARC_LENGTH_MAX_DEPTH ||
+		fabs(halves - whole) <= SPLINE_ARC_LENGTH_TOLERANCE * halves ) {
+		return halves;
+	}
+	return integrateArcLengthAdaptive(b, c, d, start, midpoint, left, depth + 1) +
+		integrateArcLengthAdaptive(b, c, d, midpoint, end, right, depth + 1);
+}
+
+float Spline::segmentSpeed(const XMVECTOR& b, const XMVECTOR& c, const XMVECTOR& d,
+	const float segmentT) {
+	// Derivative of a + b*s + c*s^2 + d*s^3, in Horner form
+	const XMVECTOR s = XMVectorReplicate(segmentT);
+	const XMVECTOR derivative = XMVectorMultiplyAdd(
+		XMVectorMultiplyAdd(XMVectorScale(d, 3.0f), s, XMVectorScale(c, 2.0f)), s, b);
+	return XMVectorGetX(XMVector3Length(derivative));
+}
+
+float Spline::closestPointOnSegment(float& segmentT, float& rayDistance,
+	const XMFLOAT3* const controlPoints,
+	const XMFLOAT3& origin, const XMFLOAT3& direction, const XMFLOAT3& inverseDirection,
+	const float maxLength, const float bound) {
+
+	const XMVECTOR originVector = XMLoadFloat3(&origin);
+	const XMVECTOR directionVector = XMLoadFloat3(&direction);
+	const bool isRay = (maxLength > 0.0f);
+	float best = bound;
+	float s = 0.0f;
+	float distanceSquared = 0.0f;
+
+	// Coefficients of the segment, as in getSegmentCoefficients()
+	const XMVECTOR p0 = XMLoadFloat3(controlPoints);
+	const XMVECTOR p1 = XMLoadFloat3(controlPoints + 1);
+	const XMVECTOR p2 = XMLoadFloat3(controlPoints + 2);
+	const XMVECTOR p3 = XMLoadFloat3(controlPoints + 3);
+	const XMVECTOR a = p0;
+	const XMVECTOR b = XMVectorScale(XMVectorSubtract(p1, p0), 3.0f);
+	const XMVECTOR c = XMVectorScale(XMVectorAdd(XMVectorSubtract(p0, XMVectorScale(p1, 2.0f)), p2), 3.0f);
+	const XMVECTOR d = XMVectorAdd(XMVectorSubtract(p3, p0), XMVectorScale(XMVectorSubtract(p1, p2), 3.0f));
+	const XMVECTOR c2 = XMVectorScale(c, 2.0f);
+	const XMVECTOR d3 = XMVectorScale(d, 3.0f);
+	const XMVECTOR d6 = XMVectorScale(d, 6.0f);
+
+	/* Depth-first subdivision. Each subdivision pushes two pieces
+	   in place of one, so the stack never holds more than one piece per level.
+	 */
+	SubCurve stack[SPLINE_CLOSEST_POINT_MAX_DEPTH + 2];
+	size_t stackSize = 1;
+	for( size_t i = 0; i < 4; ++i ) {
+		stack[0].p[i] = controlPoints[i];
+	}
+	stack[0].start = 0.0f;
+	stack[0].end = 1.0f;
+	stack[0].depth = 0;
+	XMFLOAT3 min, max;
+
+	while( stackSize > 0 ) {
+		const SubCurve curve = stack[--stackSize];
+
+		// Skip pieces which cannot contain points closer than the closest point so far
+		boundingBox(min, max, curve.p);
+		if( isRay ) {
+			if( best < FLT_MAX && !rayIntersectsBox(origin, inverseDirection, maxLength, min, max, std::sqrt(best)) ) {
+				continue;
+			}
+		} else if( distanceSquaredToBox(origin, min, max) >= best ) {
+			continue;
+		}
+
+		// The ends of each piece are on the segment
+		distanceSquared = distanceSquaredToRay(s, XMLoadFloat3(curve.p), originVector, directionVector, maxLength);
+		if( distanceSquared < best ) {
+			best = distanceSquared;
+			segmentT = curve.start;
+			rayDistance = s;
+		}
+		distanceSquared = distanceSquaredToRay(s, XMLoadFloat3(curve.p + 3), originVector, directionVector, maxLength);
+		if( distanceSquared < best ) {
+			best = distanceSquared;
+			segmentT = curve.end;
+			rayDistance = s;
+		}
+
+		if( curve.depth < SPLINE_CLOSEST_POINT_MAX_DEPTH && !isFlat(curve.p) ) {
+			// Visit the half whose middle control points are closer first
+			SubCurve& first = stack[stackSize];
+			SubCurve& second = stack[stackSize + 1];
+			split(second, first, curve);
+			if( distanceSquaredToRay(s, XMLoadFloat3(second.p + 1), originVector, directionVector, maxLength) >
+				distanceSquaredToRay(s, XMLoadFloat3(first.p + 2), originVector, directionVector, maxLength) ) {
+				const SubCurve temp = first;
+				first = second;
+				second = temp;
+			}
+			stackSize += 2;
+			continue;
+		}
+
+		/* Safeguarded Newton iterations on the derivative of the squared distance,
+		   within the piece, starting from its middle.
+		   Steps which leave the piece, or which are taken where the squared
+		   distance is not convex, are replaced by bisection.
+		 */
+		float lower = curve.start;
+		float upper = curve.end;
+		float u = 0.5f * (lower + upper);
+		float rawS = 0.0f;
+		float step = 0.0f;
+		XMVECTOR position, offset, difference;
+		for( size_t i = 0; i < SPLINE_CLOSEST_POINT_NEWTON_ITERATIONS; ++i ) {
+			const XMVECTOR uv = XMVectorReplicate(u);
+			position = XMVectorMultiplyAdd(XMVectorMultiplyAdd(XMVectorMultiplyAdd(d, uv, c), uv, b), uv, a);
+			const XMVECTOR first = XMVectorMultiplyAdd(XMVectorMultiplyAdd(d3, uv, c2), uv, b);
+			const XMVECTOR second = XMVectorMultiplyAdd(d6, uv, c2);
+			offset = XMVectorSubtract(position, originVector);
+			rawS = XMVectorGetX(XMVector3Dot(offset, directionVector));
+			s = (rawS < 0.0f) ? 0.0f : ((rawS > maxLength) ? maxLength : rawS);
+			difference = XMVectorSubtract(offset, XMVectorScale(directionVector, s));
+
+			// While the closest point on the ray is interior, it moves with the spline
+			const float gradient = XMVectorGetX(XMVector3Dot(difference, first));
+			float hessian = XMVectorGetX(XMVector3Dot(first, first)) +
+				XMVectorGetX(XMVector3Dot(difference, second));
+			if( rawS > 0.0f && rawS < maxLength ) {
+				const float along = XMVectorGetX(XMVector3Dot(first, directionVector));
+				hessian -= along * along;
+			}
+			if( gradient > 0.0f ) {
+				upper = u;
+			} else if( gradient < 0.0f ) {
+				lower = u;
+			} else {
+				break;
+			}
+			step = (hessian > 0.0f) ? (gradient / hessian) : 0.0f;
+			if( step == 0.0f || !(u - step > lower && u - step < upper) ) {
+				step = u - 0.5f * (lower + upper);
+			}
+			u -= step;
+			if( std::fabs(step) <= SPLINE_CLOSEST_POINT_TOLERANCE ) {
+				break;
+			}
+		}
+
+		const XMVECTOR uv = XMVectorReplicate(u);
+		position = XMVectorMultiplyAdd(XMVectorMultiplyAdd(XMVectorMultiplyAdd(d, uv, c), uv, b), uv, a);
+		distanceSquared = distanceSquaredToRay(s, position, originVector, directionVector, maxLength);
+		if( distanceSquared < best ) {
+			best = distanceSquared;
+			segmentT = u;
+			rayDistance = s;
+		}
+	}
+	return best;
+}
+
+void Spline::refreshControlPoints(const size_t index) {
+	KnotSlot& slot = m_knots[index];
+	const KnotSlot old = slot;
+	slot.knot->getP2(slot.p2);
+	slot.knot->getP3(slot.p3);
+	slot.knot->getP0(slot.p0);
+	slot.knot->getP1(slot.p1);
+
+	// The segments on either side of the knot change shape if its control points move
+	if( memcmp(&old.p2, &slot.p2, sizeof(XMFLOAT3)) != 0 ||
+		memcmp(&old.p3, &slot.p3, sizeof(XMFLOAT3)) != 0 ||
+		memcmp(&old.p0, &slot.p0, sizeof(XMFLOAT3)) != 0 ||
+		memcmp(&old.p1, &slot.p1, sizeof(XMFLOAT3)) != 0 ) {
+		if( index > 0 ) {
+			invalidateSegment(index - 1);
+		}
+		invalidateSegment(index);
+	}
+}
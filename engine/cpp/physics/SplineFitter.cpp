@@ -0,0 +1,497 @@
+/*
+SplineFitter.cpp
+----------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Implementation of the SplineFitter class
+*/
+
+#include "SplineFitter.h"
+#include "defs.h"
+#include <exception>
+#include <cfloat> // For FLT_MAX
+
+using namespace DirectX;
+
+namespace {
+
+	/* Outputs the coefficients of the cubic polynomial
+	   a + b*u + c*u^2 + d*u^3 describing the Bezier segment 'p'
+	 */
+	void bezierToPolynomial(const XMVECTOR* const p,
+		XMVECTOR& a, XMVECTOR& b, XMVECTOR& c, XMVECTOR& d) {
+		XMVECTOR three = XMVectorReplicate(3.0f);
+		a = p[0];
+		b = XMVectorMultiply(three, XMVectorSubtract(p[1], p[0]));
+		c = XMVectorMultiply(three,
+			XMVectorAdd(XMVectorSubtract(p[0], XMVectorScale(p[1], 2.0f)), p[2]));
+		d = XMVectorAdd(XMVectorSubtract(p[3], p[0]),
+			XMVectorMultiply(three, XMVectorSubtract(p[1], p[2])));
+	}
+
+	float length(const XMVECTOR& v) {
+		return XMVectorGetX(XMVector3Length(v));
+	}
+
+	/* Returns the slope of the knot placement function at an end,
+	   at which the end segment has about three times the given tangent length
+	 */
+	float gradingSlope(const float tangentLength, const size_t nSegments, const float totalLength) {
+		if( totalLength <= 0.0f ) {
+			return 1.0f;
+		}
+		const float slope = 3.0f * tangentLength * static_cast<float>(nSegments) / totalLength;
+		if( slope < SPLINEFITTER_MIN_SLOPE ) {
+			return SPLINEFITTER_MIN_SLOPE;
+		} else if( slope > 2.0f - SPLINEFITTER_MIN_SLOPE ) {
+			return 2.0f - SPLINEFITTER_MIN_SLOPE;
+		}
+		return slope;
+	}
+}
+
+SplineFitter::SplineFitter(const float maxError, const size_t samplesPerSegment) :
+	m_maxError(maxError), m_samplesPerSegment(samplesPerSegment),
+	m_samples(), m_tangents(), m_chordLengths(), m_parameters(),
+	m_knots(), m_tangentLengths(),
+	m_diagonal(), m_offDiagonal(), m_rhs(),
+	m_startTangentLength(0.0f), m_endTangentLength(0.0f),
+	m_lastError(0.0f), m_lastNumberOfPasses(0)
+{
+	if( maxError <= 0.0f ) {
+		throw std::exception("SplineFitter: The maximum error must be greater than zero.");
+	} else if( samplesPerSegment < 2 ) {
+		throw std::exception("SplineFitter: At least two samples per segment are required.");
+	}
+}
+
+SplineFitter::~SplineFitter(void) {}
+
+HRESULT SplineFitter::append(std::vector<DirectX::XMFLOAT3>& output,
+	const DirectX::XMFLOAT4* const controlPoints, const size_t nSegments) {
+
+	if( controlPoints == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	} else if( nSegments == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+
+	const size_t nOldSamples = m_samples.empty() ? 0 : (m_samples.size() - 1);
+	sample(controlPoints, nSegments);
+
+	/* Placing knots at the ends of the input segments reproduces the input,
+	   so only smaller numbers of segments are considered.
+	   The first and last segments must also be long enough relative
+	   to the fixed tangent lengths at their ends, to avoid forming loops.
+	 */
+	const size_t nInputSegments = nSegments + ((nOldSamples > 0) ? 1 : 0);
+	size_t maxSegments = nInputSegments - 1;
+	const float longerTangent = (m_startTangentLength > m_endTangentLength) ?
+		m_startTangentLength : m_endTangentLength;
+	if( longerTangent > 0.0f ) {
+		const float limit = (2.0f - SPLINEFITTER_MIN_SLOPE) * m_chordLengths.back() /
+			(SPLINEFITTER_MIN_CHORD_RATIO * longerTangent);
+		if( limit < static_cast<float>(maxSegments) ) {
+			maxSegments = static_cast<size_t>(limit);
+		}
+	}
+
+	// Find the smallest number of segments which fits, by doubling, then bisecting
+	m_lastNumberOfPasses = 0;
+	bool fits = false;
+	size_t lower = 0;
+	size_t upper = 0;
+	while( !fits && upper < maxSegments ) {
+		lower = upper;
+		upper = (2 * upper < maxSegments) ? ((upper == 0) ? 1 : (2 * upper)) : maxSegments;
+		fits = fitSegments(upper);
+	}
+	if( fits ) {
+		size_t nFitted = upper;
+		while( upper - lower > 1 ) {
+			const size_t middle = (lower + upper) / 2;
+			nFitted = middle;
+			if( fitSegments(middle) ) {
+				upper = middle;
+			} else {
+				lower = middle;
+			}
+		}
+		if( nFitted != upper ) {
+			fitSegments(upper);
+		}
+	} else {
+		fitInputKnots(controlPoints, nOldSamples, nSegments);
+	}
+
+	const size_t nFittedSegments = m_knots.size() - 1;
+	output.resize(4 * nFittedSegments);
+	XMVECTOR segment[4];
+	for( size_t i = 0; i < nFittedSegments; ++i ) {
+		getSegment(i, segment);
+		for( size_t j = 0; j < 4; ++j ) {
+			XMStoreFloat3(&output[4 * i + j], segment[j]);
+		}
+	}
+
+	// Only the last output segment will be refit
+	const size_t start = m_knots[nFittedSegments - 1];
+	m_startTangentLength = m_tangentLengths[nFittedSegments - 1];
+	m_samples.erase(m_samples.begin(), m_samples.begin() + start);
+	m_tangents.erase(m_tangents.begin(), m_tangents.begin() + start);
+	return ERROR_SUCCESS;
+}
+
+void SplineFitter::reset(void) {
+	m_samples.clear();
+	m_tangents.clear();
+}
+
+HRESULT SplineFitter::fit(std::vector<DirectX::XMFLOAT3>& output,
+	const DirectX::XMFLOAT4* const controlPoints, const size_t nSegments) {
+	reset();
+	return append(output, controlPoints, nSegments);
+}
+
+size_t SplineFitter::getNumberOfReplacedSegments(void) const {
+	return m_samples.empty() ? 0 : 1;
+}
+
+float SplineFitter::getMaxError(void) const {
+	return m_maxError;
+}
+
+size_t SplineFitter::getSamplesPerSegment(void) const {
+	return m_samplesPerSegment;
+}
+
+float SplineFitter::getLastError(void) const {
+	return m_lastError;
+}
+
+size_t SplineFitter::getLastNumberOfPasses(void) const {
+	return m_lastNumberOfPasses;
+}
+
+void SplineFitter::sample(const DirectX::XMFLOAT4* const controlPoints, const size_t nSegments) {
+	// The first new sample replaces the sample at the end of the previous input
+	const size_t nOldSamples = m_samples.empty() ? 0 : (m_samples.size() - 1);
+	if( nOldSamples == 0 ) {
+		m_startTangentLength = length(XMVectorSubtract(
+			XMLoadFloat4(controlPoints + 1), XMLoadFloat4(controlPoints)));
+	}
+	const size_t nSamples = nOldSamples + nSegments * m_samplesPerSegment + 1;
+	m_samples.resize(nSamples);
+	m_tangents.resize(nSamples);
+	m_chordLengths.resize(nSamples);
+	m_parameters.resize(nSamples);
+
+	XMVECTOR p[4];
+	XMVECTOR a, b, c, d;
+	size_t k = nOldSamples;
+	for( size_t i = 0; i < nSegments; ++i ) {
+		for( size_t j = 0; j < 4; ++j ) {
+			p[j] = XMLoadFloat4(controlPoints + 4 * i + j);
+		}
+		bezierToPolynomial(p, a, b, c, d);
+		for( size_t j = 0; j < m_samplesPerSegment; ++j, ++k ) {
+			XMVECTOR u = XMVectorReplicate(static_cast<float>(j) / static_cast<float>(m_samplesPerSegment));
+			XMVECTOR position = XMVectorMultiplyAdd(XMVectorMultiplyAdd(
+				XMVectorMultiplyAdd(d, u, c), u, b), u, a);
+			XMVECTOR derivative = XMVectorMultiplyAdd(
+				XMVectorMultiplyAdd(XMVectorScale(d, 3.0f), u, XMVectorScale(c, 2.0f)), u, b);
+			XMStoreFloat3(&m_samples[k], position);
+			XMStoreFloat3(&m_tangents[k], derivative);
+		}
+	}
+	XMStoreFloat3(&m_samples[k], p[3]);
+	XMStoreFloat3(&m_tangents[k], XMVectorSubtract(p[3], p[2]));
+	m_endTangentLength = length(XMVectorSubtract(p[3], p[2]));
+
+	for( k = nOldSamples; k < nSamples; ++k ) {
+		// Fall back to the direction between neighbouring samples at cusps
+		XMVECTOR tangent = XMLoadFloat3(&m_tangents[k]);
+		if( XMVector3Equal(tangent, XMVectorZero()) ) {
+			tangent = XMVectorSubtract(
+				XMLoadFloat3(&m_samples[(k + 1 < nSamples) ? (k + 1) : k]),
+				XMLoadFloat3(&m_samples[(k > 0) ? (k - 1) : k]));
+		}
+		if( !XMVector3Equal(tangent, XMVectorZero()) ) {
+			tangent = XMVector3Normalize(tangent);
+		}
+		XMStoreFloat3(&m_tangents[k], tangent);
+	}
+
+	m_chordLengths[0] = 0.0f;
+	for( k = 1; k < nSamples; ++k ) {
+		m_chordLengths[k] = m_chordLengths[k - 1] + length(XMVectorSubtract(
+			XMLoadFloat3(&m_samples[k]), XMLoadFloat3(&m_samples[k - 1])));
+	}
+}
+
+void SplineFitter::parameterizeByChordLength(void) {
+	for( size_t i = 0; i + 1 < m_knots.size(); ++i ) {
+		const size_t start = m_knots[i];
+		const size_t end = m_knots[i + 1];
+		const float chord = m_chordLengths[end] - m_chordLengths[start];
+		for( size_t k = start + 1; k < end; ++k ) {
+			if( chord > 0.0f ) {
+				m_parameters[k] = (m_chordLengths[k] - m_chordLengths[start]) / chord;
+			} else {
+				m_parameters[k] = static_cast<float>(k - start) / static_cast<float>(end - start);
+			}
+		}
+	}
+}
+
+void SplineFitter::solveTangentLengths(void) {
+	const size_t nKnots = m_knots.size();
+	m_diagonal.assign(nKnots, 0.0f);
+	m_offDiagonal.assign(nKnots - 1, 0.0f);
+	m_rhs.assign(nKnots, 0.0f);
+
+	/* Each sample contributes the squared distance |r + la*va + lb*vb|^2,
+	   where 'la' and 'lb' are the tangent lengths at the start and end
+	   of its segment, to the quantity being minimized.
+	 */
+	for( size_t i = 0; i + 1 < nKnots; ++i ) {
+		const size_t start = m_knots[i];
+		const size_t end = m_knots[i + 1];
+		XMVECTOR p0 = XMLoadFloat3(&m_samples[start]);
+		XMVECTOR p3 = XMLoadFloat3(&m_samples[end]);
+		XMVECTOR ta = XMLoadFloat3(&m_tangents[start]);
+		XMVECTOR tb = XMLoadFloat3(&m_tangents[end]);
+		float aa = 0.0f, ab = 0.0f, bb = 0.0f, ra = 0.0f, rb = 0.0f;
+		for( size_t k = start + 1; k < end; ++k ) {
+			const float u = m_parameters[k];
+			const float v = 1.0f - u;
+			const float b0 = v * v * v;
+			const float b1 = 3.0f * u * v * v;
+			const float b2 = 3.0f * u * u * v;
+			const float b3 = u * u * u;
+			XMVECTOR r = XMVectorSubtract(
+				XMVectorAdd(XMVectorScale(p0, b0 + b1), XMVectorScale(p3, b2 + b3)),
+				XMLoadFloat3(&m_samples[k]));
+			XMVECTOR va = XMVectorScale(ta, b1);
+			XMVECTOR vb = XMVectorScale(tb, -b2);
+			aa += XMVectorGetX(XMVector3Dot(va, va));
+			ab += XMVectorGetX(XMVector3Dot(va, vb));
+			bb += XMVectorGetX(XMVector3Dot(vb, vb));
+			ra -= XMVectorGetX(XMVector3Dot(r, va));
+			rb -= XMVectorGetX(XMVector3Dot(r, vb));
+		}
+		m_diagonal[i] += aa;
+		m_diagonal[i + 1] += bb;
+		m_offDiagonal[i] += ab;
+		m_rhs[i] += ra;
+		m_rhs[i + 1] += rb;
+	}
+
+	// The tangent lengths at the ends are fixed
+	if( nKnots < 3 ) {
+		return;
+	}
+	const size_t first = 1;
+	const size_t last = nKnots - 2;
+	m_rhs[first] -= m_offDiagonal[0] * m_tangentLengths[0];
+	m_rhs[last] -= m_offDiagonal[last] * m_tangentLengths[nKnots - 1];
+
+	// Bias towards a default length, and solve with the Thomas algorithm
+	for( size_t i = first; i <= last; ++i ) {
+		m_diagonal[i] += SPLINEFITTER_REGULARIZATION;
+		m_rhs[i] += SPLINEFITTER_REGULARIZATION * shorterChord(i) / 3.0f;
+		if( i > first ) {
+			const float factor = m_diagonal[i] - m_offDiagonal[i - 1] * m_diagonal[i - 1];
+			m_rhs[i] = (m_rhs[i] - m_offDiagonal[i - 1] * m_rhs[i - 1]) / factor;
+			m_diagonal[i] = (i < last) ? (m_offDiagonal[i] / factor) : 0.0f;
+		} else {
+			m_rhs[i] /= m_diagonal[i];
+			m_diagonal[i] = (i < last) ? (m_offDiagonal[i] / m_diagonal[i]) : 0.0f;
+		}
+	}
+	m_tangentLengths[last] = m_rhs[last];
+	for( size_t i = last; i > first; --i ) {
+		m_tangentLengths[i - 1] = m_rhs[i - 1] - m_diagonal[i - 1] * m_tangentLengths[i];
+	}
+
+	// Replace degenerate solutions
+	for( size_t i = first; i <= last; ++i ) {
+		const float chord = shorterChord(i);
+		if( !(m_tangentLengths[i] >= SPLINEFITTER_MIN_TANGENT_FRACTION * chord) ) {
+			m_tangentLengths[i] = chord / 3.0f;
+		}
+	}
+}
+
+float SplineFitter::shorterChord(const size_t knotIndex) const {
+	const float before = (knotIndex > 0) ?
+		(m_chordLengths[m_knots[knotIndex]] - m_chordLengths[m_knots[knotIndex - 1]]) : FLT_MAX;
+	const float after = (knotIndex + 1 < m_knots.size()) ?
+		(m_chordLengths[m_knots[knotIndex + 1]] - m_chordLengths[m_knots[knotIndex]]) : FLT_MAX;
+	return (before < after) ? before : after;
+}
+
+void SplineFitter::getSegment(const size_t knotIndex, DirectX::XMVECTOR* const segment) const {
+	const size_t start = m_knots[knotIndex];
+	const size_t end = m_knots[knotIndex + 1];
+	segment[0] = XMLoadFloat3(&m_samples[start]);
+	segment[1] = XMVectorAdd(segment[0],
+		XMVectorScale(XMLoadFloat3(&m_tangents[start]), m_tangentLengths[knotIndex]));
+	segment[3] = XMLoadFloat3(&m_samples[end]);
+	segment[2] = XMVectorSubtract(segment[3],
+		XMVectorScale(XMLoadFloat3(&m_tangents[end]), m_tangentLengths[knotIndex + 1]));
+}
+
+void SplineFitter::reparameterize(void) {
+	XMVECTOR segment[4];
+	XMVECTOR a, b, c, d;
+	for( size_t i = 0; i + 1 < m_knots.size(); ++i ) {
+		getSegment(i, segment);
+		bezierToPolynomial(segment, a, b, c, d);
+		XMVECTOR c2 = XMVectorScale(c, 2.0f);
+		XMVECTOR d3 = XMVectorScale(d, 3.0f);
+		XMVECTOR d6 = XMVectorScale(d, 6.0f);
+		for( size_t k = m_knots[i] + 1; k < m_knots[i + 1]; ++k ) {
+			const float u = m_parameters[k];
+			XMVECTOR uv = XMVectorReplicate(u);
+			XMVECTOR position = XMVectorMultiplyAdd(XMVectorMultiplyAdd(
+				XMVectorMultiplyAdd(d, uv, c), uv, b), uv, a);
+			XMVECTOR first = XMVectorMultiplyAdd(XMVectorMultiplyAdd(d3, uv, c2), uv, b);
+			XMVECTOR second = XMVectorMultiplyAdd(d6, uv, c2);
+			XMVECTOR difference = XMVectorSubtract(position, XMLoadFloat3(&m_samples[k]));
+			const float numerator = XMVectorGetX(XMVector3Dot(difference, first));
+			const float denominator = XMVectorGetX(XMVector3Dot(first, first)) +
+				XMVectorGetX(XMVector3Dot(difference, second));
+			if( denominator > 0.0f ) {
+				const float newU = u - numerator / denominator;
+				m_parameters[k] = (newU < 0.0f) ? 0.0f : ((newU > 1.0f) ? 1.0f : newU);
+			}
+		}
+	}
+}
+
+bool SplineFitter::fitSegments(const size_t nSegments) {
+	placeKnots(nSegments);
+	return fitKnots();
+}
+
+bool SplineFitter::fitKnots(void) {
+	m_tangentLengths.resize(m_knots.size());
+	m_tangentLengths.front() = m_startTangentLength;
+	m_tangentLengths.back() = m_endTangentLength;
+
+	parameterizeByChordLength();
+	for( size_t i = 0; i < SPLINEFITTER_REPARAMETERIZATION_ITERATIONS; ++i ) {
+		solveTangentLengths();
+		reparameterize();
+	}
+	++m_lastNumberOfPasses;
+	m_lastError = measureError();
+	return m_lastError <= m_maxError;
+}
+
+void SplineFitter::placeKnots(const size_t nSegments) {
+	const size_t last = m_samples.size() - 1;
+	const float totalLength = m_chordLengths[last];
+	m_knots.resize(nSegments + 1);
+	m_knots[0] = 0;
+
+	/* The first and last segments should have lengths matching
+	   the fixed tangent lengths at the ends (about three times the tangent lengths).
+	   Segment lengths change gradually between them, by placing knots
+	   at a cubic Hermite function of x in [0, 1] of the total length,
+	   with these slopes at the ends. The function is monotonic
+	   for slopes between 0 and 3.
+	 */
+	const float slope0 = gradingSlope(m_startTangentLength, nSegments, totalLength);
+	const float slope1 = gradingSlope(m_endTangentLength, nSegments, totalLength);
+
+	size_t k = 1;
+	for( size_t i = 1; i < nSegments; ++i ) {
+		const float x = static_cast<float>(i) / static_cast<float>(nSegments);
+		const float x2 = x * x;
+		const float x3 = x2 * x;
+		const float target = totalLength * ((3.0f * x2 - 2.0f * x3) +
+			slope0 * (x3 - 2.0f * x2 + x) + slope1 * (x3 - x2));
+		while( k < last && m_chordLengths[k] < target ) {
+			++k;
+		}
+		// Choose the closer of the samples on either side of the target
+		size_t knot = k;
+		if( (target - m_chordLengths[k - 1]) < (m_chordLengths[k] - target) ) {
+			knot = k - 1;
+		}
+
+		// Leave room for the remaining knots
+		if( knot <= m_knots[i - 1] ) {
+			knot = m_knots[i - 1] + 1;
+		} else if( knot > last - (nSegments - i) ) {
+			knot = last - (nSegments - i);
+		}
+		m_knots[i] = knot;
+		k = knot + 1;
+	}
+	m_knots[nSegments] = last;
+}
+
+void SplineFitter::fitInputKnots(const DirectX::XMFLOAT4* const controlPoints,
+	const size_t nOldSamples, const size_t nSegments) {
+	m_knots.clear();
+	m_tangentLengths.clear();
+	m_knots.push_back(0);
+	m_tangentLengths.push_back(m_startTangentLength);
+	if( nOldSamples > 0 ) {
+		m_knots.push_back(nOldSamples);
+		m_tangentLengths.push_back(length(XMVectorSubtract(
+			XMLoadFloat4(controlPoints + 1), XMLoadFloat4(controlPoints))));
+	}
+	for( size_t i = 0; i < nSegments; ++i ) {
+		m_knots.push_back(nOldSamples + (i + 1) * m_samplesPerSegment);
+		m_tangentLengths.push_back(length(XMVectorSubtract(
+			XMLoadFloat4(controlPoints + 4 * i + 3), XMLoadFloat4(controlPoints + 4 * i + 2))));
+	}
+
+	/* The input segments were sampled at equal parameter intervals.
+	   Only the parameters of the samples in the previous output segment
+	   need to be improved.
+	 */
+	for( size_t i = 0; i + 1 < m_knots.size(); ++i ) {
+		const size_t start = m_knots[i];
+		const size_t end = m_knots[i + 1];
+		for( size_t k = start + 1; k < end; ++k ) {
+			m_parameters[k] = static_cast<float>(k - start) / static_cast<float>(end - start);
+		}
+	}
+	for( size_t i = 0; i < SPLINEFITTER_REPARAMETERIZATION_ITERATIONS; ++i ) {
+		reparameterize();
+	}
+	++m_lastNumberOfPasses;
+	m_lastError = measureError();
+}
+
+float SplineFitter::measureError(void) const {
+	XMVECTOR segment[4];
+	XMVECTOR a, b, c, d;
+	float maxError = 0.0f;
+	for( size_t i = 0; i + 1 < m_knots.size(); ++i ) {
+		getSegment(i, segment);
+		bezierToPolynomial(segment, a, b, c, d);
+		for( size_t k = m_knots[i] + 1; k < m_knots[i + 1]; ++k ) {
+			XMVECTOR u = XMVectorReplicate(m_parameters[k]);
+			XMVECTOR position = XMVectorMultiplyAdd(XMVectorMultiplyAdd(
+				XMVectorMultiplyAdd(d, u, c), u, b), u, a);
+			const float error = length(XMVectorSubtract(position, XMLoadFloat3(&m_samples[k])));
+			if( error > maxError ) {
+				maxError = error;
+			}
+		}
+	}
+	return maxError;
+}
@@ -22,6 +22,8 @@ Description
 
 using namespace DirectX;
 
+SlabPool StaticKnot::s_pool(sizeof(StaticKnot));
+
 StaticKnot::StaticKnot(const PointSet side, const DirectX::XMFLOAT3* const controlPoints) :
 Knot(side, controlPoints)
 {}
@@ -35,4 +37,23 @@ StaticKnot::~StaticKnot(void) {}
 
 HRESULT StaticKnot::update(const DWORD currentTime, const DWORD updateTimeInterval) {
 	return ERROR_SUCCESS;
-}
\ No newline at end of file
+}
+
+void* StaticKnot::operator new(const size_t size) {
+	if( size != sizeof(StaticKnot) ) {
+		return ::operator new(size);
+	}
+	return s_pool.allocate();
+}
+
+void StaticKnot::operator delete(void* const object, const size_t size) {
+	if( size != sizeof(StaticKnot) ) {
+		::operator delete(object);
+	} else {
+		s_pool.deallocate(object);
+	}
+}
+
+void StaticKnot::getPoolTelemetry(SlabPool::Telemetry& telemetry) {
+	s_pool.getTelemetry(telemetry);
+}
@@ -0,0 +1,283 @@
+/*
+SweepAndPrune.cpp
+-----------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Implementation of the SweepAndPrune class
+*/
+
+#include <algorithm>
+#include "SweepAndPrune.h"
+#include "defs.h"
+
+using namespace DirectX;
+
+namespace {
+
+	struct IntervalLess {
+		template<typename T> bool operator()(const T& a, const T& b) const {
+			return (a.min < b.min) || (a.min == b.min && a.id < b.id);
+		}
+	};
+
+	bool pairLess(const SweepAndPrune::Pair& a, const SweepAndPrune::Pair& b) {
+		return (a.id1 < b.id1) || (a.id1 == b.id1 && a.id2 < b.id2);
+	}
+}
+
+SweepAndPrune::SweepAndPrune(const size_t capacity) :
+	m_objects(), m_freeIds(), m_removedIds(), m_intervals(),
+	m_nAdded(0), m_axis(0),
+	m_pairs(), m_previousPairs(), m_events(),
+	m_nSwaps(0), m_nTests(0)
+{
+	if( capacity > 0 ) {
+		m_objects.reserve(capacity);
+		m_intervals.reserve(capacity);
+	}
+}
+
+SweepAndPrune::~SweepAndPrune(void) {}
+
+HRESULT SweepAndPrune::add(size_t& id, const Transformable* const transform,
+	const unsigned int category, const unsigned int mask) {
+
+	if( transform == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+	if( m_freeIds.empty() ) {
+		id = m_objects.size();
+		m_objects.push_back(Object());
+	} else {
+		id = m_freeIds.back();
+		m_freeIds.pop_back();
+	}
+	Object& object = m_objects[id];
+	object.transform = transform;
+	object.category = category;
+	object.mask = mask;
+	object.isActive = true;
+	readBounds(object);
+
+	// Placed in sorted order during the next update
+	Interval interval;
+	interval.min = (&object.center.x)[m_axis] - object.radius;
+	interval.max = (&object.center.x)[m_axis] + object.radius;
+	interval.id = id;
+	interval.category = category;
+	interval.mask = mask;
+	m_intervals.push_back(interval);
+	++m_nAdded;
+	return ERROR_SUCCESS;
+}
+
+HRESULT SweepAndPrune::remove(const size_t id) {
+	if( getTransformable(id) == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	Object& object = m_objects[id];
+	object.transform = 0;
+	object.isActive = false;
+	m_removedIds.push_back(id);
+	return ERROR_SUCCESS;
+}
+
+HRESULT SweepAndPrune::update(void) {
+	m_previousPairs.swap(m_pairs);
+	m_pairs.clear();
+
+	// Discard the intervals of removed objects
+	if( !m_removedIds.empty() ) {
+		size_t nKept = 0;
+		for( size_t i = 0; i < m_intervals.size(); ++i ) {
+			if( m_objects[m_intervals[i].id].isActive ) {
+				m_intervals[nKept] = m_intervals[i];
+				++nKept;
+			}
+		}
+		m_intervals.resize(nKept);
+	}
+
+	for( std::vector<Interval>::iterator it = m_intervals.begin(); it != m_intervals.end(); ++it ) {
+		readBounds(m_objects[it->id]);
+	}
+	const bool axisChanged = chooseAxis();
+	for( std::vector<Interval>::iterator it = m_intervals.begin(); it != m_intervals.end(); ++it ) {
+		const Object& object = m_objects[it->id];
+		it->min = (&object.center.x)[m_axis] - object.radius;
+		it->max = (&object.center.x)[m_axis] + object.radius;
+		it->center = object.center;
+		it->radius = object.radius;
+	}
+
+	// Sort the intervals by their lower bounds
+	const size_t n = m_intervals.size();
+	m_nSwaps = 0;
+	if( axisChanged || static_cast<float>(m_nAdded) > SWEEPANDPRUNE_FULL_SORT_FRACTION * static_cast<float>(n) ) {
+		std::sort(m_intervals.begin(), m_intervals.end(), IntervalLess());
+		m_nSwaps = n;
+	} else {
+		IntervalLess less;
+		for( size_t i = 1; i < n; ++i ) {
+			const Interval interval = m_intervals[i];
+			size_t j = i;
+			while( j > 0 && less(interval, m_intervals[j - 1]) ) {
+				m_intervals[j] = m_intervals[j - 1];
+				--j;
+			}
+			m_intervals[j] = interval;
+			m_nSwaps += i - j;
+		}
+	}
+
+	sweep();
+	computeEvents();
+
+	// Identifiers of removed objects no longer appear in events
+	m_freeIds.insert(m_freeIds.end(), m_removedIds.begin(), m_removedIds.end());
+	m_removedIds.clear();
+	m_nAdded = 0;
+	return ERROR_SUCCESS;
+}
+
+void SweepAndPrune::clear(void) {
+	m_objects.clear();
+	m_freeIds.clear();
+	m_removedIds.clear();
+	m_intervals.clear();
+	m_nAdded = 0;
+	m_pairs.clear();
+	m_previousPairs.clear();
+	m_events.clear();
+	m_nSwaps = 0;
+	m_nTests = 0;
+}
+
+const std::vector<SweepAndPrune::Event>& SweepAndPrune::getEvents(void) const {
+	return m_events;
+}
+
+const std::vector<SweepAndPrune::Pair>& SweepAndPrune::getPairs(void) const {
+	return m_pairs;
+}
+
+size_t SweepAndPrune::getCount(void) const {
+	return m_objects.size() - m_freeIds.size() - m_removedIds.size();
+}
+
+const Transformable* SweepAndPrune::getTransformable(const size_t id) const {
+	return (id < m_objects.size() && m_objects[id].isActive) ? m_objects[id].transform : 0;
+}
+
+size_t SweepAndPrune::getAxis(void) const {
+	return m_axis;
+}
+
+size_t SweepAndPrune::getNumberOfSwaps(void) const {
+	return m_nSwaps;
+}
+
+size_t SweepAndPrune::getNumberOfTests(void) const {
+	return m_nTests;
+}
+
+void SweepAndPrune::readBounds(Object& object) const {
+	XMFLOAT4X4 worldTransform;
+	object.transform->getWorldTransform(worldTransform);
+	object.center = XMFLOAT3(worldTransform._41, worldTransform._42, worldTransform._43);
+	object.radius = (object.transform->m_radius > 0.0f) ? object.transform->m_radius : 0.0f;
+}
+
+bool SweepAndPrune::chooseAxis(void) {
+	if( m_intervals.empty() ) {
+		return false;
+	}
+
+	// Variance of the sphere centres along each axis
+	double sum[3] = { 0.0, 0.0, 0.0 };
+	double sumSquares[3] = { 0.0, 0.0, 0.0 };
+	for( std::vector<Interval>::const_iterator it = m_intervals.cbegin(); it != m_intervals.cend(); ++it ) {
+		const float* center = &m_objects[it->id].center.x;
+		for( size_t i = 0; i < 3; ++i ) {
+			sum[i] += center[i];
+			sumSquares[i] += static_cast<double>(center[i]) * center[i];
+		}
+	}
+	const double n = static_cast<double>(m_intervals.size());
+	double variance[3];
+	size_t best = 0;
+	for( size_t i = 0; i < 3; ++i ) {
+		variance[i] = sumSquares[i] / n - (sum[i] / n) * (sum[i] / n);
+		if( variance[i] > variance[best] ) {
+			best = i;
+		}
+	}
+
+	if( best != m_axis && variance[best] > SWEEPANDPRUNE_AXIS_HYSTERESIS * variance[m_axis] ) {
+		m_axis = best;
+		return true;
+	}
+	return false;
+}
+
+void SweepAndPrune::sweep(void) {
+	m_nTests = 0;
+	const size_t n = m_intervals.size();
+	Pair pair;
+	for( size_t i = 0; i < n; ++i ) {
+		const Interval& a = m_intervals[i];
+		for( size_t j = i + 1; j < n && m_intervals[j].min <= a.max; ++j ) {
+			++m_nTests;
+			const Interval& b = m_intervals[j];
+			if( (a.category & b.mask) == 0 || (b.category & a.mask) == 0 ) {
+				continue;
+			}
+			const float dx = a.center.x - b.center.x;
+			const float dy = a.center.y - b.center.y;
+			const float dz = a.center.z - b.center.z;
+			const float r = a.radius + b.radius;
+			if( dx * dx + dy * dy + dz * dz <= r * r ) {
+				pair.id1 = (a.id < b.id) ? a.id : b.id;
+				pair.id2 = (a.id < b.id) ? b.id : a.id;
+				m_pairs.push_back(pair);
+			}
+		}
+	}
+	std::sort(m_pairs.begin(), m_pairs.end(), pairLess);
+}
+
+void SweepAndPrune::computeEvents(void) {
+	m_events.clear();
+	std::vector<Pair>::const_iterator current = m_pairs.cbegin();
+	std::vector<Pair>::const_iterator previous = m_previousPairs.cbegin();
+	Event event;
+	while( current != m_pairs.cend() || previous != m_previousPairs.cend() ) {
+		if( previous == m_previousPairs.cend() || (current != m_pairs.cend() && pairLess(*current, *previous)) ) {
+			event.type = EventType::BEGIN;
+			event.id1 = current->id1;
+			event.id2 = current->id2;
+			++current;
+		} else if( current == m_pairs.cend() || pairLess(*previous, *current) ) {
+			event.type = EventType::END;
+			event.id1 = previous->id1;
+			event.id2 = previous->id2;
+			++previous;
+		} else {
+			event.type = EventType::STAY;
+			event.id1 = current->id1;
+			event.id2 = current->id2;
+			++current;
+			++previous;
+		}
+		event.transform1 = getTransformable(event.id1);
+		event.transform2 = getTransformable(event.id2);
+		m_events.push_back(event);
+	}
+}
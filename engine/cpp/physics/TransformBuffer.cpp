@@ -0,0 +1,210 @@
+/*
+TransformBuffer.cpp
+-------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Implementation of the TransformBuffer class
+*/
+
+#include "TransformBuffer.h"
+#include "Transformable.h"
+#include "TransformSystem.h"
+#include "defs.h"
+#include <algorithm> // For std::copy
+
+using namespace DirectX;
+
+TransformBuffer::TransformBuffer(const size_t size) :
+	m_front(&m_frames[0]), m_back(&m_frames[1]),
+	m_size(0), m_frameNumber(0), m_isBackCurrent(false),
+	m_writing(false), m_nReaders(0)
+{
+	resize(size);
+}
+
+TransformBuffer::~TransformBuffer(void) {}
+
+HRESULT TransformBuffer::resize(const size_t size) {
+	if( m_writing || m_nReaders != 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+
+	XMFLOAT4X4 identity;
+	XMStoreFloat4x4(&identity, XMMatrixIdentity());
+	Frame* frame = 0;
+	for( size_t f = 0; f < 2; ++f ) {
+		frame = &m_frames[f];
+		frame->m_worldTransform.resize(size, identity);
+		frame->m_previousWorldTransform.resize(size, identity);
+		frame->m_isWritten.resize(size, false);
+
+		// Forget removed slots
+		if( size < m_size ) {
+			std::vector<size_t>::iterator end = frame->m_written.begin();
+			for( std::vector<size_t>::const_iterator it = frame->m_written.cbegin(); it != frame->m_written.cend(); ++it ) {
+				if( *it < size ) {
+					*end = *it;
+					++end;
+				}
+			}
+			frame->m_written.erase(end, frame->m_written.end());
+		}
+	}
+	m_size = size;
+	return ERROR_SUCCESS;
+}
+
+size_t TransformBuffer::getSize(void) const {
+	return m_size;
+}
+
+HRESULT TransformBuffer::flip(void) {
+	if( m_writing || m_nReaders != 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+
+	// If nothing was written since the last flip, the front buffer is still current
+	if( m_isBackCurrent ) {
+		Frame* const temp = m_front;
+		m_front = m_back;
+		m_back = temp;
+		++m_frameNumber;
+		m_isBackCurrent = false;
+	}
+	return ERROR_SUCCESS;
+}
+
+unsigned long TransformBuffer::getFrameNumber(void) const {
+	return m_frameNumber;
+}
+
+HRESULT TransformBuffer::beginWrite(void) {
+	bool expected = false;
+	if( !m_writing.compare_exchange_strong(expected, true) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+
+	/* The back buffer is missing the slots written to the front buffer
+	   during the previous frame
+	 */
+	if( !m_isBackCurrent ) {
+		Frame& back = *m_back;
+		const Frame& front = *m_front;
+		for( std::vector<size_t>::const_iterator it = back.m_written.cbegin(); it != back.m_written.cend(); ++it ) {
+			back.m_isWritten[*it] = false;
+		}
+		back.m_written.clear();
+		for( std::vector<size_t>::const_iterator it = front.m_written.cbegin(); it != front.m_written.cend(); ++it ) {
+			back.m_worldTransform[*it] = front.m_worldTransform[*it];
+			back.m_previousWorldTransform[*it] = front.m_previousWorldTransform[*it];
+		}
+		m_isBackCurrent = true;
+	}
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformBuffer::endWrite(void) {
+	bool expected = true;
+	if( !m_writing.compare_exchange_strong(expected, false) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformBuffer::write(const size_t slot, const DirectX::XMFLOAT4X4& worldTransform,
+	const DirectX::XMFLOAT4X4& previousWorldTransform) {
+	if( !m_writing ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	} else if( slot >= m_size ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	m_back->m_worldTransform[slot] = worldTransform;
+	m_back->m_previousWorldTransform[slot] = previousWorldTransform;
+	markWritten(slot);
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformBuffer::write(const size_t slot, const Transformable& transformable) {
+	if( !m_writing ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	} else if( slot >= m_size ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	if( FAILED(transformable.getWorldTransforms(m_back->m_worldTransform[slot],
+		m_back->m_previousWorldTransform[slot])) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+	markWritten(slot);
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformBuffer::write(const TransformSystem& system) {
+	if( !m_writing ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+	const size_t n = (system.getSize() < m_size) ? system.getSize() : m_size;
+	if( n == 0 ) {
+		return ERROR_SUCCESS;
+	}
+	const XMFLOAT4X4* const worldTransforms = system.getWorldTransforms();
+	const XMFLOAT4X4* const previousWorldTransforms = system.getPreviousWorldTransforms();
+	std::copy(worldTransforms, worldTransforms + n, m_back->m_worldTransform.begin());
+	std::copy(previousWorldTransforms, previousWorldTransforms + n, m_back->m_previousWorldTransform.begin());
+	for( size_t i = 0; i < n; ++i ) {
+		markWritten(i);
+	}
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformBuffer::beginRead(void) {
+	++m_nReaders;
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformBuffer::endRead(void) {
+	unsigned int nReaders = m_nReaders;
+	do {
+		if( nReaders == 0 ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+		}
+	} while( !m_nReaders.compare_exchange_weak(nReaders, nReaders - 1) );
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformBuffer::getWorldTransform(const size_t slot, DirectX::XMFLOAT4X4& worldTransform) const {
+	if( slot >= m_size ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	worldTransform = m_front->m_worldTransform[slot];
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformBuffer::getInterpolatedWorldTransform(const size_t slot, DirectX::XMFLOAT4X4& worldTransform, const float alpha) const {
+	if( slot >= m_size ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	TransformSystem::interpolate(worldTransform, m_front->m_previousWorldTransform[slot],
+		m_front->m_worldTransform[slot], alpha);
+	return ERROR_SUCCESS;
+}
+
+const DirectX::XMFLOAT4X4* TransformBuffer::getWorldTransforms(void) const {
+	if( m_size == 0 ) {
+		return 0;
+	}
+	return &m_front->m_worldTransform[0];
+}
+
+void TransformBuffer::markWritten(const size_t slot) {
+	if( !m_back->m_isWritten[slot] ) {
+		m_back->m_isWritten[slot] = true;
+		m_back->m_written.push_back(slot);
+	}
+}
@@ -0,0 +1,247 @@
+/*
+TransformScheduler.cpp
+----------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Implementation of the TransformScheduler class
+*/
+
+#include <unordered_map>
+#include "TransformScheduler.h"
+#include "defs.h"
+
+// Marks a missing parent, or an object whose level has not yet been determined
+#define TRANSFORMSCHEDULER_NONE static_cast<size_t>(-1)
+
+TransformScheduler::TransformScheduler(WorkerPool* const pool, const size_t chunkSize) :
+	m_pool(pool), m_chunkSize(chunkSize),
+	m_ordered(), m_nLevels(0),
+	m_chunkStart(1, 0), m_phaseStart(1, 0),
+	m_chunkSkipped(), m_chunkResults(),
+	m_nSkipped(0)
+{
+	if( m_chunkSize == 0 ) {
+		throw std::exception("TransformScheduler chunk size must be greater than zero.");
+	}
+}
+
+TransformScheduler::~TransformScheduler(void) {}
+
+HRESULT TransformScheduler::setTransformables(const std::vector<Transformable*>& transformables) {
+	const size_t n = transformables.size();
+
+	std::unordered_map<const Transformable*, size_t> indices;
+	indices.reserve(n);
+	for( size_t i = 0; i < n; ++i ) {
+		if( transformables[i] == 0 ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+		}
+		if( !indices.insert(std::make_pair(transformables[i], i)).second ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+		}
+	}
+
+	std::vector<size_t> parents(n, TRANSFORMSCHEDULER_NONE);
+	std::unordered_map<const Transformable*, size_t>::const_iterator parent;
+	for( size_t i = 0; i < n; ++i ) {
+		parent = indices.find(transformables[i]->getParent());
+		if( parent != indices.end() ) {
+			parents[i] = parent->second;
+		}
+	}
+
+	// Find the depth of each object, reusing the depths of its ancestors
+	std::vector<size_t> levels(n, TRANSFORMSCHEDULER_NONE);
+	std::vector<size_t> path;
+	size_t nLevels = 0;
+	size_t level = 0;
+	size_t current = 0;
+	for( size_t i = 0; i < n; ++i ) {
+		path.clear();
+		current = i;
+		while( current != TRANSFORMSCHEDULER_NONE && levels[current] == TRANSFORMSCHEDULER_NONE ) {
+			path.push_back(current);
+			if( path.size() > n ) {
+				// The hierarchy contains a cycle
+				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+			}
+			current = parents[current];
+		}
+
+		// Assign levels from the top of the path downwards
+		level = (current == TRANSFORMSCHEDULER_NONE) ? 0 : (levels[current] + 1);
+		for( std::vector<size_t>::reverse_iterator it = path.rbegin(); it != path.rend(); ++it ) {
+			levels[*it] = level;
+			++level;
+		}
+		if( level > nLevels ) {
+			nLevels = level;
+		}
+	}
+
+	// Stable counting sort by level
+	std::vector<size_t> levelStart(nLevels + 1, 0);
+	for( size_t i = 0; i < n; ++i ) {
+		++levelStart[levels[i] + 1];
+	}
+	for( size_t i = 1; i <= nLevels; ++i ) {
+		levelStart[i] += levelStart[i - 1];
+	}
+	std::vector<size_t> next(levelStart.begin(), levelStart.end() - 1);
+	std::vector<size_t> byLevel(n);
+	for( size_t i = 0; i < n; ++i ) {
+		byLevel[next[levels[i]]++] = i;
+	}
+
+	/* Find the first level with enough objects to give each thread
+	   several subtrees. A single thread can process the entire
+	   hierarchy subtree by subtree.
+	 */
+	const size_t minSubtrees = (m_pool == 0) ? 1 :
+		(m_pool->getNumberOfThreads() * TRANSFORMSCHEDULER_SUBTREES_PER_THREAD);
+	size_t splitLevel = nLevels;
+	for( size_t i = 0; i < nLevels; ++i ) {
+		if( levelStart[i + 1] - levelStart[i] >= minSubtrees ) {
+			splitLevel = i;
+			break;
+		}
+	}
+
+	m_ordered.clear();
+	m_ordered.reserve(n);
+	m_chunkStart.assign(1, 0);
+	m_phaseStart.assign(1, 0);
+
+	// One phase per level above the split level, divided into fixed-size chunks
+	for( size_t i = 0; i < splitLevel; ++i ) {
+		for( size_t j = levelStart[i]; j < levelStart[i + 1]; ++j ) {
+			m_ordered.push_back(transformables[byLevel[j]]);
+			if( m_ordered.size() - m_chunkStart.back() == m_chunkSize ) {
+				m_chunkStart.push_back(m_ordered.size());
+			}
+		}
+		if( m_ordered.size() != m_chunkStart.back() ) {
+			m_chunkStart.push_back(m_ordered.size());
+		}
+		m_phaseStart.push_back(m_chunkStart.size() - 1);
+	}
+
+	// One phase for all subtrees rooted at the split level
+	if( splitLevel < nLevels ) {
+
+		// Identify the subtree containing each object
+		std::vector<size_t> subtrees(n, TRANSFORMSCHEDULER_NONE);
+		size_t nSubtrees = 0;
+		for( size_t i = 0; i < n; ++i ) {
+			if( levels[i] == splitLevel ) {
+				subtrees[i] = nSubtrees;
+				++nSubtrees;
+			}
+		}
+		for( size_t j = levelStart[splitLevel + 1]; j < n; ++j ) {
+			subtrees[byLevel[j]] = subtrees[parents[byLevel[j]]];
+		}
+
+		// Stable counting sort of the remaining objects by subtree
+		std::vector<size_t> subtreeStart(nSubtrees + 1, 0);
+		for( size_t j = levelStart[splitLevel]; j < n; ++j ) {
+			++subtreeStart[subtrees[byLevel[j]] + 1];
+		}
+		for( size_t i = 1; i <= nSubtrees; ++i ) {
+			subtreeStart[i] += subtreeStart[i - 1];
+		}
+		next.assign(subtreeStart.begin(), subtreeStart.end() - 1);
+		const size_t offset = m_ordered.size();
+		m_ordered.resize(n);
+		for( size_t j = levelStart[splitLevel]; j < n; ++j ) {
+			m_ordered[offset + next[subtrees[byLevel[j]]]++] = transformables[byLevel[j]];
+		}
+
+		// Chunks contain whole subtrees
+		for( size_t i = 1; i <= nSubtrees; ++i ) {
+			if( offset + subtreeStart[i] - m_chunkStart.back() >= m_chunkSize || i == nSubtrees ) {
+				m_chunkStart.push_back(offset + subtreeStart[i]);
+			}
+		}
+		m_phaseStart.push_back(m_chunkStart.size() - 1);
+	}
+
+	m_nLevels = nLevels;
+	m_chunkSkipped.assign(m_chunkStart.size() - 1, 0);
+	m_chunkResults.assign(m_chunkStart.size() - 1, ERROR_SUCCESS);
+	m_nSkipped = 0;
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformScheduler::update(const DWORD currentTime, const DWORD updateTimeInterval) {
+	m_nSkipped = 0;
+	const size_t nPhases = getNumberOfPhases();
+	size_t phaseStart = 0;
+	size_t nChunks = 0;
+
+	for( size_t phase = 0; phase < nPhases; ++phase ) {
+		phaseStart = m_phaseStart[phase];
+		nChunks = m_phaseStart[phase + 1] - phaseStart;
+
+		if( m_pool == 0 ) {
+			for( size_t chunk = phaseStart; chunk < phaseStart + nChunks; ++chunk ) {
+				updateChunk(chunk, currentTime, updateTimeInterval);
+			}
+		} else {
+			// The pool returns only once all chunks in this phase are finished
+			if( FAILED(m_pool->run(nChunks, [&](const size_t i) {
+				updateChunk(phaseStart + i, currentTime, updateTimeInterval);
+			})) ) {
+				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+			}
+		}
+
+		for( size_t chunk = phaseStart; chunk < phaseStart + nChunks; ++chunk ) {
+			if( FAILED(m_chunkResults[chunk]) ) {
+				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+			}
+			m_nSkipped += m_chunkSkipped[chunk];
+		}
+	}
+	return ERROR_SUCCESS;
+}
+
+size_t TransformScheduler::getNumberOfTransformables(void) const {
+	return m_ordered.size();
+}
+
+size_t TransformScheduler::getNumberOfLevels(void) const {
+	return m_nLevels;
+}
+
+size_t TransformScheduler::getNumberOfPhases(void) const {
+	return m_phaseStart.size() - 1;
+}
+
+size_t TransformScheduler::getNumberOfSkippedUpdates(void) const {
+	return m_nSkipped;
+}
+
+void TransformScheduler::updateChunk(const size_t chunk, const DWORD currentTime, const DWORD updateTimeInterval) {
+	const size_t end = m_chunkStart[chunk + 1];
+	size_t nSkipped = 0;
+	HRESULT result = ERROR_SUCCESS;
+	for( size_t i = m_chunkStart[chunk]; i < end; ++i ) {
+		result = m_ordered[i]->update(currentTime, updateTimeInterval);
+		if( FAILED(result) ) {
+			break;
+		}
+		if( m_ordered[i]->wasUpdateSkipped() ) {
+			++nSkipped;
+		}
+	}
+	m_chunkSkipped[chunk] = nSkipped;
+	m_chunkResults[chunk] = result;
+}
@@ -0,0 +1,654 @@
+/*
+TransformSystem.cpp
+-------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: Transformable.cpp
+
+Description
+  -Implementation of the TransformSystem class
+*/
+
+#include <cstring> // for memcmp()
+#include <algorithm> // for copy()
+#include "TransformSystem.h"
+#include "engineGlobals.h"
+#include "defs.h"
+
+using namespace DirectX;
+
+// Loads four consecutive elements of an array into a vector
+#define TRANSFORMSYSTEM_LOAD(v, i) XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&(v)[i]))
+#define TRANSFORMSYSTEM_STORE(v, i, x) XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&(v)[i]), (x))
+
+TransformSystem::TransformSystem(const size_t capacity) :
+	m_count(0), m_size(0), m_nWithParent(0), m_nBaked(0)
+{
+	// Allocate storage without creating any slots
+	if( capacity > 0 ) {
+		grow(capacity);
+		m_size = 0;
+	}
+}
+
+TransformSystem::~TransformSystem(void) {}
+
+HRESULT TransformSystem::add(size_t& index, const DirectX::XMFLOAT3& scale,
+	const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT4& orientation,
+	const size_t parent) {
+
+	if( parent != TRANSFORMSYSTEM_NO_PARENT && !isInUse(parent) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+
+	// Reuse a free slot that comes after the parent, if there is one
+	bool found = false;
+	std::vector<size_t>::size_type i = m_freeList.size();
+	while( i > 0 ) {
+		--i;
+		if( parent == TRANSFORMSYSTEM_NO_PARENT || m_freeList[i] > parent ) {
+			index = m_freeList[i];
+			m_freeList[i] = m_freeList.back();
+			m_freeList.pop_back();
+			found = true;
+			break;
+		}
+	}
+	if( !found ) {
+		index = m_size;
+		grow(m_size + 1);
+	}
+
+	XMFLOAT4 normalizedOrientation;
+	XMStoreFloat4(&normalizedOrientation, XMQuaternionNormalize(XMLoadFloat4(&orientation)));
+
+	m_px[index] = position.x;
+	m_py[index] = position.y;
+	m_pz[index] = position.z;
+	m_qx[index] = normalizedOrientation.x;
+	m_qy[index] = normalizedOrientation.y;
+	m_qz[index] = normalizedOrientation.z;
+	m_qw[index] = normalizedOrientation.w;
+	m_sx[index] = scale.x;
+	m_sy[index] = scale.y;
+	m_sz[index] = scale.z;
+
+	m_parent[index] = parent;
+	if( parent != TRANSFORMSYSTEM_NO_PARENT ) {
+		++m_nChildren[parent];
+		++m_nWithParent;
+	}
+	m_inUse[index] = true;
+	setDynamic(index, true);
+	m_newSlots.push_back(index);
+	++m_count;
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::remove(const size_t index) {
+	if( !isInUse(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+
+	// Baked children would otherwise keep world transformations relative to this one
+	unbake(index);
+	setDynamic(index, false);
+
+	// Detach children, which always have greater indices
+	if( m_nChildren[index] > 0 ) {
+		for( size_t i = index + 1; i < m_size; ++i ) {
+			if( m_parent[i] == index ) {
+				m_parent[i] = TRANSFORMSYSTEM_NO_PARENT;
+				--m_nWithParent;
+			}
+		}
+		m_nChildren[index] = 0;
+	}
+
+	if( m_parent[index] != TRANSFORMSYSTEM_NO_PARENT ) {
+		--m_nChildren[m_parent[index]];
+		--m_nWithParent;
+	}
+
+	clear(index);
+	m_freeList.push_back(index);
+	--m_count;
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::update(const DWORD updateTimeInterval) {
+
+	// Baked and free slots already have equal previous and current world transformations
+	const size_t paddedSize = m_px.size();
+	for( size_t i = 0; i < paddedSize; i += TRANSFORMSYSTEM_BATCH_SIZE ) {
+		if( m_nDynamicInBatch[i / TRANSFORMSYSTEM_BATCH_SIZE] > 0 ) {
+			std::copy(m_worldTransform.begin() + i, m_worldTransform.begin() + i + TRANSFORMSYSTEM_BATCH_SIZE,
+				m_previousWorldTransform.begin() + i);
+		}
+	}
+
+	integrate(updateTimeInterval);
+	computeLocalTransforms();
+	computeHierarchy();
+
+	// New slots had identity transformations before this update
+	for( std::vector<size_t>::const_iterator it = m_newSlots.cbegin(); it != m_newSlots.cend(); ++it ) {
+		m_previousWorldTransform[*it] = m_worldTransform[*it];
+	}
+	m_newSlots.clear();
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::bake(const size_t index) {
+	if( !isInUse(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	} else if( isBaked(index) ) {
+		return ERROR_SUCCESS;
+	}
+
+	const size_t parent = m_parent[index];
+	if( parent != TRANSFORMSYSTEM_NO_PARENT && !isBaked(parent) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+
+	// Same computation as Transformable::computeTransforms(), without motion
+	XMMATRIX noScale = XMMatrixMultiply(
+		XMMatrixRotationQuaternion(XMVectorSet(m_qx[index], m_qy[index], m_qz[index], m_qw[index])),
+		XMMatrixTranslation(m_px[index], m_py[index], m_pz[index]));
+	if( parent != TRANSFORMSYSTEM_NO_PARENT ) {
+		noScale = XMMatrixMultiply(noScale, XMLoadFloat4x4(&m_worldTransformNoScale[parent]));
+	}
+	XMStoreFloat4x4(&m_worldTransformNoScale[index], noScale);
+	XMStoreFloat4x4(&m_worldTransform[index], XMMatrixMultiply(
+		XMMatrixScaling(m_sx[index], m_sy[index], m_sz[index]), noScale));
+	m_previousWorldTransform[index] = m_worldTransform[index];
+
+	setDynamic(index, false);
+	++m_nBaked;
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::unbake(const size_t index) {
+	if( !isInUse(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	} else if( !isBaked(index) ) {
+		return ERROR_SUCCESS;
+	}
+
+	setDynamic(index, true);
+	--m_nBaked;
+
+	/* A baked transformation's parent is always baked, except below
+	   a transformation being unbaked. Descendants always have greater indices.
+	 */
+	if( m_nChildren[index] > 0 ) {
+		size_t parent = TRANSFORMSYSTEM_NO_PARENT;
+		for( size_t i = index + 1; i < m_size; ++i ) {
+			parent = m_parent[i];
+			if( parent != TRANSFORMSYSTEM_NO_PARENT && isBaked(i) && !isBaked(parent) ) {
+				setDynamic(i, true);
+				--m_nBaked;
+			}
+		}
+	}
+	return ERROR_SUCCESS;
+}
+
+bool TransformSystem::isBaked(const size_t index) const {
+	return isInUse(index) && m_dynamic[index] == 0.0f;
+}
+
+HRESULT TransformSystem::getWorldTransform(const size_t index, DirectX::XMFLOAT4X4& worldTransform) const {
+	if( !isValidIndex(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	worldTransform = m_worldTransform[index];
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::getWorldTransformNoScale(const size_t index, DirectX::XMFLOAT4X4& worldTransformNoScale) const {
+	if( !isValidIndex(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	worldTransformNoScale = m_worldTransformNoScale[index];
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::getInterpolatedWorldTransform(const size_t index, DirectX::XMFLOAT4X4& worldTransform, const float alpha) const {
+	if( !isValidIndex(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	interpolate(worldTransform, m_previousWorldTransform[index], m_worldTransform[index], alpha);
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::getPreviousWorldTransform(const size_t index, DirectX::XMFLOAT4X4& previousWorldTransform) const {
+	if( !isValidIndex(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	previousWorldTransform = m_previousWorldTransform[index];
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::resetInterpolation(const size_t index) {
+	if( !isValidIndex(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	m_previousWorldTransform[index] = m_worldTransform[index];
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::getScale(const size_t index, DirectX::XMFLOAT3& scale) const {
+	if( !isValidIndex(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	scale = XMFLOAT3(m_sx[index], m_sy[index], m_sz[index]);
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::getPosition(const size_t index, DirectX::XMFLOAT3& position) const {
+	if( !isValidIndex(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	position = XMFLOAT3(m_px[index], m_py[index], m_pz[index]);
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::getOrientation(const size_t index, DirectX::XMFLOAT4& orientation) const {
+	if( !isValidIndex(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	orientation = XMFLOAT4(m_qx[index], m_qy[index], m_qz[index], m_qw[index]);
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::setScale(const size_t index, const DirectX::XMFLOAT3& scale) {
+	if( !isInUse(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	unbake(index);
+	m_sx[index] = scale.x;
+	m_sy[index] = scale.y;
+	m_sz[index] = scale.z;
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::setPosition(const size_t index, const DirectX::XMFLOAT3& position) {
+	if( !isInUse(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	unbake(index);
+	m_px[index] = position.x;
+	m_py[index] = position.y;
+	m_pz[index] = position.z;
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::setOrientation(const size_t index, const DirectX::XMFLOAT4& orientation) {
+	if( !isInUse(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	unbake(index);
+	m_qx[index] = orientation.x;
+	m_qy[index] = orientation.y;
+	m_qz[index] = orientation.z;
+	m_qw[index] = orientation.w;
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::setLinearVelocity(const size_t index, const DirectX::XMFLOAT3& direction, const float speed) {
+	if( !isInUse(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	unbake(index);
+	m_dx[index] = direction.x;
+	m_dy[index] = direction.y;
+	m_dz[index] = direction.z;
+	m_speed[index] = speed;
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::setAngularMomentum(const size_t index, const DirectX::XMFLOAT4& angularMomentum) {
+	if( !isInUse(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	unbake(index);
+	m_lx[index] = angularMomentum.x;
+	m_ly[index] = angularMomentum.y;
+	m_lz[index] = angularMomentum.z;
+	m_lw[index] = angularMomentum.w;
+	return ERROR_SUCCESS;
+}
+
+HRESULT TransformSystem::setParent(const size_t index, const size_t parent) {
+	if( !isInUse(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	} else if( parent != TRANSFORMSYSTEM_NO_PARENT && (parent >= index || !isInUse(parent)) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	unbake(index);
+
+	if( m_parent[index] != TRANSFORMSYSTEM_NO_PARENT ) {
+		--m_nChildren[m_parent[index]];
+		--m_nWithParent;
+	}
+	m_parent[index] = parent;
+	if( parent != TRANSFORMSYSTEM_NO_PARENT ) {
+		++m_nChildren[parent];
+		++m_nWithParent;
+	}
+	return ERROR_SUCCESS;
+}
+
+size_t TransformSystem::getParent(const size_t index) const {
+	if( !isValidIndex(index) ) {
+		return TRANSFORMSYSTEM_NO_PARENT;
+	}
+	return m_parent[index];
+}
+
+size_t TransformSystem::getSize(void) const {
+	return m_size;
+}
+
+size_t TransformSystem::getCount(void) const {
+	return m_count;
+}
+
+size_t TransformSystem::getNumberOfBaked(void) const {
+	return m_nBaked;
+}
+
+bool TransformSystem::isInUse(const size_t index) const {
+	return isValidIndex(index) && m_inUse[index];
+}
+
+const DirectX::XMFLOAT4X4* TransformSystem::getWorldTransforms(void) const {
+	if( m_worldTransform.empty() ) {
+		return 0;
+	}
+	return &m_worldTransform[0];
+}
+
+const DirectX::XMFLOAT4X4* TransformSystem::getWorldTransformsNoScale(void) const {
+	if( m_worldTransformNoScale.empty() ) {
+		return 0;
+	}
+	return &m_worldTransformNoScale[0];
+}
+
+const DirectX::XMFLOAT4X4* TransformSystem::getPreviousWorldTransforms(void) const {
+	if( m_previousWorldTransform.empty() ) {
+		return 0;
+	}
+	return &m_previousWorldTransform[0];
+}
+
+void TransformSystem::interpolate(DirectX::XMFLOAT4X4& out, const DirectX::XMFLOAT4X4& previous,
+	const DirectX::XMFLOAT4X4& current, const float alpha) {
+
+	// Most objects do not move between steps
+	if( alpha >= 1.0f || std::memcmp(&previous, &current, sizeof(XMFLOAT4X4)) == 0 ) {
+		out = current;
+		return;
+	} else if( alpha <= 0.0f ) {
+		out = previous;
+		return;
+	}
+
+	const XMMATRIX previousMatrix = XMLoadFloat4x4(&previous);
+	const XMMATRIX currentMatrix = XMLoadFloat4x4(&current);
+	XMVECTOR previousScale, previousRotation, previousTranslation;
+	XMVECTOR currentScale, currentRotation, currentTranslation;
+	if( XMMatrixDecompose(&previousScale, &previousRotation, &previousTranslation, previousMatrix) &&
+		XMMatrixDecompose(&currentScale, &currentRotation, &currentTranslation, currentMatrix) ) {
+		XMStoreFloat4x4(&out, XMMatrixAffineTransformation(
+			XMVectorLerp(previousScale, currentScale, alpha),
+			XMVectorZero(),
+			XMQuaternionSlerp(previousRotation, currentRotation, alpha),
+			XMVectorLerp(previousTranslation, currentTranslation, alpha)
+			));
+	} else {
+		XMMATRIX result;
+		for( size_t i = 0; i < 4; ++i ) {
+			result.r[i] = XMVectorLerp(previousMatrix.r[i], currentMatrix.r[i], alpha);
+		}
+		XMStoreFloat4x4(&out, result);
+	}
+}
+
+void TransformSystem::grow(const size_t size) {
+	const size_t paddedSize = ((size + TRANSFORMSYSTEM_BATCH_SIZE - 1) / TRANSFORMSYSTEM_BATCH_SIZE) * TRANSFORMSYSTEM_BATCH_SIZE;
+	if( paddedSize > m_px.size() ) {
+		XMFLOAT4X4 identity;
+		XMStoreFloat4x4(&identity, XMMatrixIdentity());
+
+		m_px.resize(paddedSize, 0.0f);
+		m_py.resize(paddedSize, 0.0f);
+		m_pz.resize(paddedSize, 0.0f);
+		m_qx.resize(paddedSize, 0.0f);
+		m_qy.resize(paddedSize, 0.0f);
+		m_qz.resize(paddedSize, 0.0f);
+		m_qw.resize(paddedSize, 1.0f);
+		m_sx.resize(paddedSize, 1.0f);
+		m_sy.resize(paddedSize, 1.0f);
+		m_sz.resize(paddedSize, 1.0f);
+		m_dx.resize(paddedSize, 0.0f);
+		m_dy.resize(paddedSize, 0.0f);
+		m_dz.resize(paddedSize, 0.0f);
+		m_speed.resize(paddedSize, 0.0f);
+		m_lx.resize(paddedSize, 0.0f);
+		m_ly.resize(paddedSize, 0.0f);
+		m_lz.resize(paddedSize, 0.0f);
+		m_lw.resize(paddedSize, 1.0f);
+		m_parent.resize(paddedSize, TRANSFORMSYSTEM_NO_PARENT);
+		m_nChildren.resize(paddedSize, 0);
+		m_inUse.resize(paddedSize, false);
+		m_dynamic.resize(paddedSize, 0.0f);
+		m_nDynamicInBatch.resize(paddedSize / TRANSFORMSYSTEM_BATCH_SIZE, 0);
+		m_worldTransform.resize(paddedSize, identity);
+		m_worldTransformNoScale.resize(paddedSize, identity);
+		m_previousWorldTransform.resize(paddedSize, identity);
+	}
+	if( size > m_size ) {
+		m_size = size;
+	}
+}
+
+void TransformSystem::clear(const size_t index) {
+	m_px[index] = 0.0f;
+	m_py[index] = 0.0f;
+	m_pz[index] = 0.0f;
+	m_qx[index] = 0.0f;
+	m_qy[index] = 0.0f;
+	m_qz[index] = 0.0f;
+	m_qw[index] = 1.0f;
+	m_sx[index] = 1.0f;
+	m_sy[index] = 1.0f;
+	m_sz[index] = 1.0f;
+	m_dx[index] = 0.0f;
+	m_dy[index] = 0.0f;
+	m_dz[index] = 0.0f;
+	m_speed[index] = 0.0f;
+	m_lx[index] = 0.0f;
+	m_ly[index] = 0.0f;
+	m_lz[index] = 0.0f;
+	m_lw[index] = 1.0f;
+	m_parent[index] = TRANSFORMSYSTEM_NO_PARENT;
+	m_nChildren[index] = 0;
+	m_inUse[index] = false;
+	XMStoreFloat4x4(&m_worldTransform[index], XMMatrixIdentity());
+	XMStoreFloat4x4(&m_worldTransformNoScale[index], XMMatrixIdentity());
+	XMStoreFloat4x4(&m_previousWorldTransform[index], XMMatrixIdentity());
+}
+
+void TransformSystem::setDynamic(const size_t index, const bool dynamic) {
+	const float value = dynamic ? 1.0f : 0.0f;
+	if( m_dynamic[index] != value ) {
+		m_dynamic[index] = value;
+		if( dynamic ) {
+			++m_nDynamicInBatch[index / TRANSFORMSYSTEM_BATCH_SIZE];
+		} else {
+			--m_nDynamicInBatch[index / TRANSFORMSYSTEM_BATCH_SIZE];
+		}
+	}
+}
+
+void TransformSystem::integrate(const DWORD updateTimeInterval) {
+	const XMVECTOR interval = XMVectorReplicate(static_cast<float>(updateTimeInterval));
+	const XMVECTOR millisecondsPerSecond = XMVectorReplicate(MILLISECS_PER_SEC_FLOAT);
+	const XMVECTOR zero = XMVectorZero();
+	XMVECTOR increment, dynamic, isDynamic;
+	XMVECTOR qx, qy, qz, qw, lx, ly, lz, lw;
+
+	const size_t paddedSize = m_px.size();
+	for( size_t i = 0; i < paddedSize; i += TRANSFORMSYSTEM_BATCH_SIZE ) {
+		if( m_nDynamicInBatch[i / TRANSFORMSYSTEM_BATCH_SIZE] == 0 ) {
+			continue;
+		}
+
+		// Baked slots do not move
+		dynamic = TRANSFORMSYSTEM_LOAD(m_dynamic, i);
+		isDynamic = XMVectorNotEqual(dynamic, zero);
+
+		// Move based on speed
+		increment = XMVectorMultiply(XMVectorDivide(XMVectorMultiply(TRANSFORMSYSTEM_LOAD(m_speed, i), interval), millisecondsPerSecond), dynamic);
+		TRANSFORMSYSTEM_STORE(m_px, i, XMVectorMultiplyAdd(TRANSFORMSYSTEM_LOAD(m_dx, i), increment, TRANSFORMSYSTEM_LOAD(m_px, i)));
+		TRANSFORMSYSTEM_STORE(m_py, i, XMVectorMultiplyAdd(TRANSFORMSYSTEM_LOAD(m_dy, i), increment, TRANSFORMSYSTEM_LOAD(m_py, i)));
+		TRANSFORMSYSTEM_STORE(m_pz, i, XMVectorMultiplyAdd(TRANSFORMSYSTEM_LOAD(m_dz, i), increment, TRANSFORMSYSTEM_LOAD(m_pz, i)));
+
+		/* Orient based on angular momentum
+		   Same as XMQuaternionMultiply(orientation, L), evaluated for four quaternions at once
+		 */
+		qx = TRANSFORMSYSTEM_LOAD(m_qx, i);
+		qy = TRANSFORMSYSTEM_LOAD(m_qy, i);
+		qz = TRANSFORMSYSTEM_LOAD(m_qz, i);
+		qw = TRANSFORMSYSTEM_LOAD(m_qw, i);
+		lx = TRANSFORMSYSTEM_LOAD(m_lx, i);
+		ly = TRANSFORMSYSTEM_LOAD(m_ly, i);
+		lz = TRANSFORMSYSTEM_LOAD(m_lz, i);
+		lw = TRANSFORMSYSTEM_LOAD(m_lw, i);
+
+		TRANSFORMSYSTEM_STORE(m_qx, i, XMVectorSelect(qx, XMVectorSubtract(XMVectorAdd(XMVectorAdd(
+			XMVectorMultiply(lw, qx), XMVectorMultiply(lx, qw)), XMVectorMultiply(ly, qz)), XMVectorMultiply(lz, qy)), isDynamic));
+		TRANSFORMSYSTEM_STORE(m_qy, i, XMVectorSelect(qy, XMVectorAdd(XMVectorAdd(XMVectorSubtract(
+			XMVectorMultiply(lw, qy), XMVectorMultiply(lx, qz)), XMVectorMultiply(ly, qw)), XMVectorMultiply(lz, qx)), isDynamic));
+		TRANSFORMSYSTEM_STORE(m_qz, i, XMVectorSelect(qz, XMVectorAdd(XMVectorSubtract(XMVectorAdd(
+			XMVectorMultiply(lw, qz), XMVectorMultiply(lx, qy)), XMVectorMultiply(ly, qx)), XMVectorMultiply(lz, qw)), isDynamic));
+		TRANSFORMSYSTEM_STORE(m_qw, i, XMVectorSelect(qw, XMVectorSubtract(XMVectorSubtract(XMVectorSubtract(
+			XMVectorMultiply(lw, qw), XMVectorMultiply(lx, qx)), XMVectorMultiply(ly, qy)), XMVectorMultiply(lz, qz)), isDynamic));
+	}
+}
+
+void TransformSystem::computeLocalTransforms(void) {
+	const XMVECTOR zero = XMVectorZero();
+	const XMVECTOR one = XMVectorSplatOne();
+	const XMVECTOR two = XMVectorReplicate(2.0f);
+
+	XMVECTOR qx, qy, qz, qw;
+	XMVECTOR xx, yy, zz, xy, xz, yz, wx, wy, wz;
+	XMVECTOR r00, r01, r02, r10, r11, r12, r20, r21, r22;
+	XMVECTOR sx, sy, sz;
+
+	// Matrix rows for each of the four transformations, after transposition
+	XMMATRIX row0, row1, row2, row3, scaledRow0, scaledRow1, scaledRow2;
+
+	const size_t paddedSize = m_px.size();
+	size_t k = 0;
+	for( size_t i = 0; i < paddedSize; i += TRANSFORMSYSTEM_BATCH_SIZE ) {
+		if( m_nDynamicInBatch[i / TRANSFORMSYSTEM_BATCH_SIZE] == 0 ) {
+			continue;
+		}
+
+		/* Rotation matrix elements, as computed by XMMatrixRotationQuaternion(),
+		   for four quaternions at once
+		 */
+		qx = TRANSFORMSYSTEM_LOAD(m_qx, i);
+		qy = TRANSFORMSYSTEM_LOAD(m_qy, i);
+		qz = TRANSFORMSYSTEM_LOAD(m_qz, i);
+		qw = TRANSFORMSYSTEM_LOAD(m_qw, i);
+
+		xx = XMVectorMultiply(qx, qx);
+		yy = XMVectorMultiply(qy, qy);
+		zz = XMVectorMultiply(qz, qz);
+		xy = XMVectorMultiply(qx, qy);
+		xz = XMVectorMultiply(qx, qz);
+		yz = XMVectorMultiply(qy, qz);
+		wx = XMVectorMultiply(qw, qx);
+		wy = XMVectorMultiply(qw, qy);
+		wz = XMVectorMultiply(qw, qz);
+
+		r00 = XMVectorNegativeMultiplySubtract(two, XMVectorAdd(yy, zz), one);
+		r01 = XMVectorMultiply(two, XMVectorAdd(xy, wz));
+		r02 = XMVectorMultiply(two, XMVectorSubtract(xz, wy));
+
+		r10 = XMVectorMultiply(two, XMVectorSubtract(xy, wz));
+		r11 = XMVectorNegativeMultiplySubtract(two, XMVectorAdd(xx, zz), one);
+		r12 = XMVectorMultiply(two, XMVectorAdd(yz, wx));
+
+		r20 = XMVectorMultiply(two, XMVectorAdd(xz, wy));
+		r21 = XMVectorMultiply(two, XMVectorSubtract(yz, wx));
+		r22 = XMVectorNegativeMultiplySubtract(two, XMVectorAdd(xx, yy), one);
+
+		// Transpose so that each vector holds one row of one matrix
+		row0 = XMMatrixTranspose(XMMATRIX(r00, r01, r02, zero));
+		row1 = XMMatrixTranspose(XMMATRIX(r10, r11, r12, zero));
+		row2 = XMMatrixTranspose(XMMATRIX(r20, r21, r22, zero));
+		row3 = XMMatrixTranspose(XMMATRIX(
+			TRANSFORMSYSTEM_LOAD(m_px, i),
+			TRANSFORMSYSTEM_LOAD(m_py, i),
+			TRANSFORMSYSTEM_LOAD(m_pz, i),
+			one));
+
+		// Scaling multiplies each of the first three rows by a scale factor
+		sx = TRANSFORMSYSTEM_LOAD(m_sx, i);
+		sy = TRANSFORMSYSTEM_LOAD(m_sy, i);
+		sz = TRANSFORMSYSTEM_LOAD(m_sz, i);
+		scaledRow0 = XMMatrixTranspose(XMMATRIX(
+			XMVectorMultiply(r00, sx), XMVectorMultiply(r01, sx), XMVectorMultiply(r02, sx), zero));
+		scaledRow1 = XMMatrixTranspose(XMMATRIX(
+			XMVectorMultiply(r10, sy), XMVectorMultiply(r11, sy), XMVectorMultiply(r12, sy), zero));
+		scaledRow2 = XMMatrixTranspose(XMMATRIX(
+			XMVectorMultiply(r20, sz), XMVectorMultiply(r21, sz), XMVectorMultiply(r22, sz), zero));
+
+		// Output matrices, leaving those of baked and free slots unchanged
+		for( k = 0; k < TRANSFORMSYSTEM_BATCH_SIZE; ++k ) {
+			if( m_dynamic[i + k] == 0.0f ) {
+				continue;
+			}
+			XMStoreFloat4x4(&m_worldTransformNoScale[i + k],
+				XMMATRIX(row0.r[k], row1.r[k], row2.r[k], row3.r[k]));
+			XMStoreFloat4x4(&m_worldTransform[i + k],
+				XMMATRIX(scaledRow0.r[k], scaledRow1.r[k], scaledRow2.r[k], row3.r[k]));
+		}
+	}
+}
+
+void TransformSystem::computeHierarchy(void) {
+	if( m_nWithParent == 0 ) {
+		return;
+	}
+
+	XMMATRIX noScale;
+	size_t parent = TRANSFORMSYSTEM_NO_PARENT;
+
+	// Parents always precede their children, so their transformations are already final
+	for( size_t i = 0; i < m_size; ++i ) {
+		parent = m_parent[i];
+		if( parent != TRANSFORMSYSTEM_NO_PARENT && m_dynamic[i] != 0.0f ) {
+			noScale = XMMatrixMultiply(XMLoadFloat4x4(&m_worldTransformNoScale[i]),
+				XMLoadFloat4x4(&m_worldTransformNoScale[parent]));
+			XMStoreFloat4x4(&m_worldTransformNoScale[i], noScale);
+			XMStoreFloat4x4(&m_worldTransform[i], XMMatrixMultiply(
+				XMMatrixScaling(m_sx[i], m_sy[i], m_sz[i]), noScale));
+		}
+	}
+}
+
+bool TransformSystem::isValidIndex(const size_t index) const {
+	return index < m_size;
+}
@@ -22,21 +22,32 @@ Description
 -Implementation of the Transformable class
 */
 
+#include <cstring> // for memcmp()
 #include "Transformable.h"
+#include "TransformSystem.h"
 #include "defs.h"
 
 using namespace DirectX;
 
+bool Transformable::s_lazyEvaluation = true;
+float Transformable::s_renderInterpolation = 1.0f;
+
 ////////////////////////////////////////////////////////////////////////////////
 // Class name: Transformable
 ////////////////////////////////////////////////////////////////////////////////
 
 Transformable::Transformable(DirectX::XMFLOAT3& scale, DirectX::XMFLOAT3& position,
 	DirectX::XMFLOAT4& orientation) :
-	m_parent(0), m_scale(scale), m_position(position), m_orientation(orientation)
+	m_parent(0), m_scale(scale), m_position(position), m_orientation(orientation),
+	m_system(0), m_systemIndex(0),
+	m_localVersion(0), m_worldVersion(0),
+	m_computedLocalVersion(0), m_computedParentVersion(0),
+	m_computedParent(0), m_hasComputed(false), m_updateSkipped(false)
 {
 	XMStoreFloat4x4(&m_worldTransform, XMMatrixIdentity());
 	XMStoreFloat4x4(&m_worldTransformNoScale, XMMatrixIdentity());
+	m_previousWorldTransform = m_worldTransform;
+	m_computedTransformations = m_worldTransform;
 	// Normalize the orientation so any input values are properly accepted
 	XMVECTOR oriVec = XMLoadFloat4(&orientation);
 	oriVec = XMQuaternionNormalize(oriVec);
@@ -51,14 +62,49 @@ Transformable::Transformable(DirectX::XMFLOAT3& scale, DirectX::XMFLOAT3& positi
 }
 
 Transformable::~Transformable(void)
-{}
+{
+	if( m_system != 0 ) {
+		m_system->remove(m_systemIndex);
+		m_system = 0;
+	}
+}
 
 HRESULT Transformable::getWorldTransform(XMFLOAT4X4& worldTransform) const {
+	if( s_renderInterpolation < 1.0f ) {
+		return getInterpolatedWorldTransform(worldTransform, s_renderInterpolation);
+	}
+	if( m_system != 0 ) {
+		return m_system->getWorldTransform(m_systemIndex, worldTransform);
+	}
 	worldTransform = m_worldTransform;
 	return ERROR_SUCCESS;
 }
 
+HRESULT Transformable::getInterpolatedWorldTransform(XMFLOAT4X4& worldTransform, const float alpha) const {
+	if( m_system != 0 ) {
+		return m_system->getInterpolatedWorldTransform(m_systemIndex, worldTransform, alpha);
+	}
+	TransformSystem::interpolate(worldTransform, m_previousWorldTransform, m_worldTransform, alpha);
+	return ERROR_SUCCESS;
+}
+
+HRESULT Transformable::getWorldTransforms(XMFLOAT4X4& worldTransform, XMFLOAT4X4& previousWorldTransform) const {
+	if( m_system != 0 ) {
+		if( FAILED(m_system->getWorldTransform(m_systemIndex, worldTransform)) ||
+			FAILED(m_system->getPreviousWorldTransform(m_systemIndex, previousWorldTransform)) ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+		return ERROR_SUCCESS;
+	}
+	worldTransform = m_worldTransform;
+	previousWorldTransform = m_previousWorldTransform;
+	return ERROR_SUCCESS;
+}
+
 HRESULT Transformable::getWorldTransformNoScale(XMFLOAT4X4& worldTransformNoScale) const {
+	if( m_system != 0 ) {
+		return m_system->getWorldTransformNoScale(m_systemIndex, worldTransformNoScale);
+	}
 	worldTransformNoScale = m_worldTransformNoScale;
 	return ERROR_SUCCESS;
 }
@@ -110,11 +156,19 @@ HRESULT Transformable::getWorldForward(DirectX::XMFLOAT3& worldForward) {
 
 HRESULT Transformable::update(const DWORD currentTime, const DWORD updateTimeInterval) {
 
+	// Bound objects are updated by their TransformSystem
+	if( m_system != 0 ) {
+		m_updateSkipped = false;
+		return ERROR_SUCCESS;
+	}
+
 	XMFLOAT4X4 newWorldTransform;
+	unsigned long parentVersion = 0;
 
 	// First get parent's world transform
 	if (m_parent != 0) {
 		m_parent->getWorldTransformNoScale(newWorldTransform);
+		parentVersion = m_parent->m_worldVersion;
 	}
 	else {
 		XMStoreFloat4x4(&newWorldTransform, XMMatrixIdentity());
@@ -123,9 +177,56 @@ HRESULT Transformable::update(const DWORD currentTime, const DWORD updateTimeInt
 	// perform all matrix transformations on the transform
 	transformations(newWorldTransform, currentTime, updateTimeInterval);
 
+	/* Skip the recomputation if its inputs are the same as last time.
+	   A parent bound to a TransformSystem does not maintain a version counter.
+	   The output of transformations() is compared with the output used
+	   by the last recomputation, as derived classes may change it
+	   without changing any version counters.
+	 */
+	if( s_lazyEvaluation && m_hasComputed &&
+		m_localVersion == m_computedLocalVersion &&
+		m_parent == m_computedParent &&
+		(m_parent == 0 || (parentVersion == m_computedParentVersion && m_parent->m_system == 0)) &&
+		isAtRest() &&
+		std::memcmp(&m_computedTransformations, &newWorldTransform, sizeof(XMFLOAT4X4)) == 0 ) {
+		m_previousWorldTransform = m_worldTransform;
+		m_updateSkipped = true;
+		return ERROR_SUCCESS;
+	}
+
+	const XMFLOAT3 oldPosition = m_position;
+	const XMFLOAT4 oldOrientation = m_orientation;
+	const XMFLOAT4X4 oldWorldTransform = m_worldTransform;
+	const XMFLOAT4X4 oldWorldTransformNoScale = m_worldTransformNoScale;
+
 	// compute the final world transforms (with scale and without)
 	computeTransforms(newWorldTransform, updateTimeInterval);
-	
+
+	// The first computed transform has no meaningful predecessor
+	m_previousWorldTransform = m_hasComputed ? oldWorldTransform : m_worldTransform;
+
+	// Record the inputs used
+	m_computedLocalVersion = m_localVersion;
+	m_computedParentVersion = parentVersion;
+	m_computedParent = m_parent;
+	m_computedTransformations = newWorldTransform;
+	m_hasComputed = true;
+	m_updateSkipped = false;
+
+	/* If the computation changed the local state (e.g. because of motion),
+	   the next computation may produce a different result.
+	 */
+	if( std::memcmp(&oldPosition, &m_position, sizeof(XMFLOAT3)) != 0 ||
+		std::memcmp(&oldOrientation, &m_orientation, sizeof(XMFLOAT4)) != 0 ) {
+		++m_localVersion;
+	}
+
+	// Notify children of changes
+	if( std::memcmp(&oldWorldTransform, &m_worldTransform, sizeof(XMFLOAT4X4)) != 0 ||
+		std::memcmp(&oldWorldTransformNoScale, &m_worldTransformNoScale, sizeof(XMFLOAT4X4)) != 0 ) {
+		++m_worldVersion;
+	}
+
 	return ERROR_SUCCESS;
 }
 
@@ -187,6 +288,9 @@ void Transformable::Move(float ahead)
 	// move ahead by the given amount
 	XMVECTOR aheadv = XMVectorScale(XMLoadFloat3(&m_forward), ahead);
 	XMStoreFloat3(&m_position, XMVectorAdd(XMLoadFloat3(&m_position), aheadv));
+
+	markLocalChanged();
+	pushToSystem();
 }
 
 void Transformable::Strafe(float side)
@@ -196,6 +300,9 @@ void Transformable::Strafe(float side)
 	// move horizontally by the given amount
 	XMVECTOR sidev = XMVectorScale(XMLoadFloat3(&m_left), side);
 	XMStoreFloat3(&m_position, XMVectorAdd(XMLoadFloat3(&m_position), sidev));
+
+	markLocalChanged();
+	pushToSystem();
 }
 
 void Transformable::Crane(float vertical)
@@ -205,6 +312,9 @@ void Transformable::Crane(float vertical)
 	// move vertically by the given amount
 	XMVECTOR verticalv = XMVectorScale(XMLoadFloat3(&m_up), vertical);
 	XMStoreFloat3(&m_position, XMVectorAdd(XMLoadFloat3(&m_position), verticalv));
+
+	markLocalChanged();
+	pushToSystem();
 }
 
 void Transformable::Spin(float roll, float pitch, float yaw) {
@@ -219,6 +329,9 @@ void Transformable::Spin(float roll, float pitch, float yaw) {
 	XMStoreFloat4(&m_orientation, XMQuaternionMultiply(XMLoadFloat4(&m_orientation), rollq));
 	XMStoreFloat4(&m_orientation, XMQuaternionMultiply(XMLoadFloat4(&m_orientation), pitchq));
 	XMStoreFloat4(&m_orientation, XMQuaternionMultiply(XMLoadFloat4(&m_orientation), yawq));
+
+	markLocalChanged();
+	pushToSystem();
 }
 
 bool Transformable::MoveIfParent(float amount)
@@ -259,17 +372,137 @@ bool Transformable::SpinIfParent(float roll, float pitch, float yaw)
 
 
 HRESULT Transformable::setParent(Transformable* const parent) {
+	if( m_system != 0 ) {
+		size_t parentIndex = TRANSFORMSYSTEM_NO_PARENT;
+		if( parent != 0 ) {
+			if( parent->m_system != m_system ) {
+				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+			}
+			parentIndex = parent->m_systemIndex;
+		}
+		if( FAILED(m_system->setParent(m_systemIndex, parentIndex)) ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+	}
 	m_parent = parent;
+	markLocalChanged();
+	return ERROR_SUCCESS;
+}
+
+HRESULT Transformable::bindToSystem(TransformSystem* const system) {
+	if( system == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	} else if( m_system != 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+
+	size_t parentIndex = TRANSFORMSYSTEM_NO_PARENT;
+	if( m_parent != 0 ) {
+		if( m_parent->m_system != system ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+		}
+		parentIndex = m_parent->m_systemIndex;
+	}
+
+	if( FAILED(system->add(m_systemIndex, m_scale, m_position, m_orientation, parentIndex)) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+	system->setLinearVelocity(m_systemIndex, m_velDirection, m_speed);
+	system->setAngularMomentum(m_systemIndex, m_L);
+	m_system = system;
+	return ERROR_SUCCESS;
+}
+
+bool Transformable::isBoundToSystem(void) const {
+	return m_system != 0;
+}
+
+HRESULT Transformable::bake(void) {
+	if( m_system == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+	if( FAILED(m_system->bake(m_systemIndex)) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
 	return ERROR_SUCCESS;
 }
 
+HRESULT Transformable::unbake(void) {
+	if( m_system == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+	if( FAILED(m_system->unbake(m_systemIndex)) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+	return ERROR_SUCCESS;
+}
+
+bool Transformable::isBaked(void) const {
+	return m_system != 0 && m_system->isBaked(m_systemIndex);
+}
+
+void Transformable::setLazyEvaluation(const bool enable) {
+	s_lazyEvaluation = enable;
+}
+
+bool Transformable::getLazyEvaluation(void) {
+	return s_lazyEvaluation;
+}
+
+void Transformable::setRenderInterpolation(const float alpha) {
+	s_renderInterpolation = alpha;
+}
+
+float Transformable::getRenderInterpolation(void) {
+	return s_renderInterpolation;
+}
+
+void Transformable::resetInterpolation(void) {
+	if( m_system != 0 ) {
+		m_system->resetInterpolation(m_systemIndex);
+	} else {
+		m_previousWorldTransform = m_worldTransform;
+	}
+}
+
+bool Transformable::wasUpdateSkipped(void) const {
+	return m_updateSkipped;
+}
+
+unsigned long Transformable::getWorldVersion(void) const {
+	return m_worldVersion;
+}
+
+void Transformable::setLinearVelocity(const DirectX::XMFLOAT3& direction, const float speed) {
+	m_velDirection = direction;
+	m_speed = speed;
+	if( m_system != 0 ) {
+		m_system->setLinearVelocity(m_systemIndex, m_velDirection, m_speed);
+	}
+}
+
+void Transformable::setAngularMomentum(const DirectX::XMFLOAT4& angularMomentum) {
+	m_L = angularMomentum;
+	if( m_system != 0 ) {
+		m_system->setAngularMomentum(m_systemIndex, m_L);
+	}
+}
+
 XMFLOAT3 Transformable::getScale() const
 {
+	if( m_system != 0 ) {
+		XMFLOAT3 scale;
+		m_system->getScale(m_systemIndex, scale);
+		return scale;
+	}
 	return m_scale;
 }
 
 XMFLOAT3 Transformable::getPosition(void) const {
 	XMFLOAT3 newPos = m_position;
+	if( m_system != 0 ) {
+		m_system->getPosition(m_systemIndex, newPos);
+	}
 	if (m_parent != 0) {
 		XMFLOAT3 parentPos = m_parent->getPosition();
 		newPos = XMFLOAT3(newPos.x + parentPos.x,
@@ -281,20 +514,35 @@ XMFLOAT3 Transformable::getPosition(void) const {
 
 XMFLOAT4 Transformable::getOrientation(void) const {
 	XMFLOAT4 newOri = m_orientation;
+	if( m_system != 0 ) {
+		m_system->getOrientation(m_systemIndex, newOri);
+	}
 
 	return newOri;
 }
 
 void Transformable::setScale(const DirectX::XMFLOAT3& scale) {
 	m_scale = scale;
+	markLocalChanged();
+	if( m_system != 0 ) {
+		m_system->setScale(m_systemIndex, m_scale);
+	}
 }
 
 void Transformable::setPosition(const DirectX::XMFLOAT3& position) {
 	m_position = position;
+	markLocalChanged();
+	if( m_system != 0 ) {
+		m_system->setPosition(m_systemIndex, m_position);
+	}
 }
 
 void Transformable::setOrientation(const DirectX::XMFLOAT4& orientation) {
 	m_orientation = orientation;
+	markLocalChanged();
+	if( m_system != 0 ) {
+		m_system->setOrientation(m_systemIndex, m_orientation);
+	}
 }
 
 HRESULT Transformable::setOrientation(const DirectX::XMFLOAT3& direction) {
@@ -310,13 +558,15 @@ HRESULT Transformable::setOrientation(const DirectX::XMFLOAT3& direction) {
 	XMVECTOR vector2 = XMVectorNotEqual(vector1, XMVectorZero());
 	XMStoreFloat3(&storedValue1, vector2);
 	if( storedValue1.x == 0 && storedValue1.y == 0 && storedValue1.z == 0 ) {
-		m_orientation = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+		setOrientation(XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f));
 		return ERROR_SUCCESS;
 	}
 
 	vector2 = XMVector3AngleBetweenVectors(XMLoadFloat3(&canonicalForward), XMLoadFloat3(&direction));
 	XMStoreFloat3(&storedValue1, vector2);
-	XMStoreFloat4(&m_orientation, XMQuaternionRotationAxis(vector1, storedValue1.x));
+	XMFLOAT4 orientation;
+	XMStoreFloat4(&orientation, XMQuaternionRotationAxis(vector1, storedValue1.x));
+	setOrientation(orientation);
 	return ERROR_SUCCESS;
 }
 
@@ -353,6 +603,8 @@ void Transformable::updateTransformProperties()
 {
 	// make sure transform properties are up to date
 	// NB: actually unnecessary, since they are updated every frame anyway; done here for clarity
+	pullFromSystem();
+
 	m_forward = XMFLOAT3(0.0f, 0.0f, 1.0f);
 	m_up = XMFLOAT3(0.0f, 1.0f, 0.0f);
 	m_left = XMFLOAT3(-1.0f, 0.0f, 0.0f);
@@ -367,6 +619,31 @@ void Transformable::updateTransformProperties()
 		XMVector3Cross(XMLoadFloat3(&m_forward), XMLoadFloat3(&m_up)));
 }
 
+void Transformable::pullFromSystem(void) {
+	if( m_system != 0 ) {
+		m_system->getScale(m_systemIndex, m_scale);
+		m_system->getPosition(m_systemIndex, m_position);
+		m_system->getOrientation(m_systemIndex, m_orientation);
+	}
+}
+
+void Transformable::pushToSystem(void) {
+	if( m_system != 0 ) {
+		m_system->setScale(m_systemIndex, m_scale);
+		m_system->setPosition(m_systemIndex, m_position);
+		m_system->setOrientation(m_systemIndex, m_orientation);
+	}
+}
+
+void Transformable::markLocalChanged(void) {
+	++m_localVersion;
+}
+
+bool Transformable::isAtRest(void) const {
+	return m_speed == 0.0f &&
+		m_L.x == 0.0f && m_L.y == 0.0f && m_L.z == 0.0f && m_L.w == 1.0f;
+}
+
 bool Transformable::hasParent(){
 	if (m_parent == 0){
 		return false;
@@ -374,6 +651,10 @@ bool Transformable::hasParent(){
 	return true;
 }
 
+Transformable* Transformable::getParent(void) const {
+	return m_parent;
+}
+
 HRESULT Transformable::getDirectionInWorld(DirectX::XMFLOAT3& unitWorldDirection,
 	const DirectX::XMFLOAT3& localDirection, const bool normalize) const {
 	DirectX::XMFLOAT4X4 storedTempMatrix;
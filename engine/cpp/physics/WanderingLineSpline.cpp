@@ -19,6 +19,7 @@ Description
 */
 
 #include "WanderingLineSpline.h"
+#include "WanderingLineSystem.h"
 #include "defs.h"
 #include <exception>
 
@@ -32,7 +33,8 @@ WanderingLineSpline::WanderingLineSpline(const size_t capacity, const float spee
 	Spline(capacity, true, &speed, false),
 	m_knotParameters(knotParameters),
 	m_start(start), m_end(end),
-	m_knotTransforms()
+	m_knotTransforms(), m_system(0), m_systemIndex(0),
+	m_speed(speed), m_controlPoints()
 {
 	// Generate spline knots at increasing interpolation parameter values
 	WanderingLineTransformable* transform = 0;
@@ -58,7 +60,50 @@ WanderingLineSpline::WanderingLineSpline(const size_t capacity, const float spee
 	}
 }
 
+WanderingLineSpline::WanderingLineSpline(const size_t capacity, const float speed,
+	Transformable* const start,
+	Transformable* const end,
+	const WanderingLineTransformable::Parameters& knotParameters,
+	WanderingLineSystem* const system) :
+	Spline(capacity, true, &speed, false),
+	m_knotParameters(knotParameters),
+	m_start(start), m_end(end),
+	m_knotTransforms(), m_system(system), m_systemIndex(0),
+	m_speed(speed), m_controlPoints()
+{
+	if( m_system == 0 ) {
+		throw std::exception("WanderingLineSpline: Null WanderingLineSystem.");
+	}
+
+	// Same interpolation parameter values as used by the other constructor
+	const size_t nKnots = capacity + 1;
+	std::vector<WanderingLineTransformable::Parameters> parameters(nKnots, m_knotParameters);
+	for( size_t i = 0; i < nKnots; ++i ) {
+		parameters[i].t = static_cast<float>(i) / static_cast<float>(capacity);
+	}
+	if( FAILED(m_system->add(m_systemIndex, nKnots, m_start, m_end, &parameters[0])) ) {
+		throw std::exception("WanderingLineSpline: Failed to add knots to the WanderingLineSystem.");
+	}
+
+	m_controlPoints.resize(4 * nKnots);
+	if( FAILED(m_system->getKnotControlPoints(&m_controlPoints[0], m_systemIndex, nKnots, m_speed)) ) {
+		m_system->remove(m_systemIndex, nKnots);
+		throw std::exception("WanderingLineSpline: Failed to obtain knots from the WanderingLineSystem.");
+	}
+	for( size_t i = 0; i < nKnots; ++i ) {
+		// End-side knots take the first two control points, p2 and p3
+		if( FAILED(addToEnd(&m_controlPoints[4 * i])) ) {
+			m_system->remove(m_systemIndex, nKnots);
+			throw std::exception("WanderingLineSpline: Failed to add a knot to the spline during initialization.");
+		}
+	}
+}
+
 WanderingLineSpline::~WanderingLineSpline(void) {
+	if( m_system != 0 ) {
+		m_system->remove(m_systemIndex, m_controlPoints.size() / 4);
+		m_system = 0;
+	}
 	list<WanderingLineTransformable*>::iterator start = m_knotTransforms.begin();
 	list<WanderingLineTransformable*>::iterator end = m_knotTransforms.end();
 	while( start != end ) {
@@ -74,6 +119,10 @@ HRESULT WanderingLineSpline::setEndpoints(Transformable* const startTransform,
 	m_start = startTransform;
 	m_end = endTransform;
 
+	if( m_system != 0 ) {
+		return m_system->setEndpoints(m_systemIndex, m_controlPoints.size() / 4, m_start, m_end);
+	}
+
 	list<WanderingLineTransformable*>::iterator start = m_knotTransforms.begin();
 	list<WanderingLineTransformable*>::iterator end = m_knotTransforms.end();
 	while( start != end ) {
@@ -93,6 +142,18 @@ void WanderingLineSpline::getEndpoints(Transformable*& start,
 
 HRESULT WanderingLineSpline::update(const DWORD currentTime, const DWORD updateTimeInterval) {
 
+	// The knots are static, so only need to be refreshed from the system
+	if( m_system != 0 ) {
+		const size_t nKnots = m_controlPoints.size() / 4;
+		if( FAILED(m_system->getKnotControlPoints(&m_controlPoints[0], m_systemIndex, nKnots, m_speed)) ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+		if( FAILED(setKnotControlPoints(&m_controlPoints[0], 0, nKnots)) ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+		return ERROR_SUCCESS;
+	}
+
 	// Update base class data
 	if( FAILED(Spline::update(currentTime, updateTimeInterval)) ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
@@ -0,0 +1,577 @@
+/*
+WanderingLineSystem.cpp
+-----------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: WanderingLineTransformable.cpp, TransformSystem.cpp
+
+Description
+  -Implementation of the WanderingLineSystem class
+*/
+
+#include "WanderingLineSystem.h"
+#include "Transformable.h"
+#include "defs.h"
+#include <cmath> // For fabs()
+
+using namespace DirectX;
+
+// Loads four consecutive elements of an array into a vector
+#define WANDERINGLINESYSTEM_LOAD(v, i) XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&(v)[i]))
+#define WANDERINGLINESYSTEM_STORE(v, i, x) XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&(v)[i]), (x))
+
+namespace {
+	/* Hamilton product 'a' * 'b' of four pairs of quaternions,
+	   equal to XMQuaternionMultiply(b, a)
+	 */
+	void multiplyQuaternions(XMVECTOR& x, XMVECTOR& y, XMVECTOR& z, XMVECTOR& w,
+		const XMVECTOR& ax, const XMVECTOR& ay, const XMVECTOR& az, const XMVECTOR& aw,
+		const XMVECTOR& bx, const XMVECTOR& by, const XMVECTOR& bz, const XMVECTOR& bw) {
+		x = XMVectorSubtract(XMVectorAdd(XMVectorAdd(
+			XMVectorMultiply(aw, bx), XMVectorMultiply(ax, bw)), XMVectorMultiply(ay, bz)), XMVectorMultiply(az, by));
+		y = XMVectorAdd(XMVectorAdd(XMVectorSubtract(
+			XMVectorMultiply(aw, by), XMVectorMultiply(ax, bz)), XMVectorMultiply(ay, bw)), XMVectorMultiply(az, bx));
+		z = XMVectorAdd(XMVectorSubtract(XMVectorAdd(
+			XMVectorMultiply(aw, bz), XMVectorMultiply(ax, by)), XMVectorMultiply(ay, bx)), XMVectorMultiply(az, bw));
+		w = XMVectorSubtract(XMVectorSubtract(XMVectorSubtract(
+			XMVectorMultiply(aw, bw), XMVectorMultiply(ax, bx)), XMVectorMultiply(ay, by)), XMVectorMultiply(az, bz));
+	}
+
+	/* Advances a rotational offset, as done for each component
+	   by WanderingLineTransformable::refresh(), in the lanes selected by 'enabled'.
+	   Note that the direction of rotation only reverses at the upper limit.
+	 */
+	void advanceAngle(XMVECTOR& angle, XMVECTOR& sign, const XMVECTOR& speed,
+		const XMVECTOR& maxAngle, const XMVECTOR& interval, const XMVECTOR& enabled) {
+		const XMVECTOR factor = XMVectorMultiply(sign, interval);
+		XMVECTOR newAngle = XMVectorAdd(angle, XMVectorMultiply(factor, speed));
+		const XMVECTOR reverse = XMVectorGreater(newAngle, maxAngle);
+		newAngle = XMVectorSelect(newAngle,
+			XMVectorAdd(newAngle, XMVectorMultiply(XMVectorMultiply(XMVectorReplicate(-2.0f), factor), speed)),
+			reverse);
+		angle = XMVectorSelect(angle, newAngle, enabled);
+		sign = XMVectorSelect(sign, XMVectorSelect(sign, XMVectorNegate(sign), reverse), enabled);
+	}
+}
+
+WanderingLineSystem::WanderingLineSystem(const size_t capacity) :
+	m_size(0), m_count(0)
+{
+	// Allocate storage without creating any slots
+	if( capacity > 0 ) {
+		grow(capacity);
+		m_size = 0;
+	}
+}
+
+WanderingLineSystem::~WanderingLineSystem(void) {}
+
+HRESULT WanderingLineSystem::add(size_t& first, const size_t n,
+	Transformable* const start, Transformable* const end,
+	const WanderingLineTransformable::Parameters* const parameters,
+	const unsigned int* const instanceIds) {
+
+	if( n == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	} else if( start == 0 || end == 0 || parameters == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+	for( size_t i = 0; i < n; ++i ) {
+		if( parameters[i].t > 1.0f || parameters[i].t < 0.0f ) {
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+		}
+	}
+
+	// Use the first free range which is large enough
+	bool found = false;
+	for( std::vector<std::pair<size_t, size_t> >::iterator it = m_freeRanges.begin(); it != m_freeRanges.end(); ++it ) {
+		if( it->second >= n ) {
+			first = it->first;
+			it->first += n;
+			it->second -= n;
+			if( it->second == 0 ) {
+				m_freeRanges.erase(it);
+			}
+			found = true;
+			break;
+		}
+	}
+	if( !found ) {
+		first = m_size;
+		grow(m_size + n);
+	}
+
+	// Same initialization as in the WanderingLineTransformable constructor
+	float factor = 0.0f;
+	XMFLOAT3 offset;
+	float values[6];
+	size_t index = 0;
+	for( size_t i = 0; i < n; ++i ) {
+		index = first + i;
+		const WanderingLineTransformable::Parameters& p = parameters[i];
+		factor = 1.0f - 2.0f * fabs(p.t - 0.5f);
+		m_t[index] = p.t;
+		m_maxRadius[index] = p.maxRadius * factor;
+		m_linearSpeed[index] = p.linearSpeed;
+		m_maxRoll[index] = p.maxRollPitchYaw.x * factor;
+		m_maxPitch[index] = p.maxRollPitchYaw.y * factor;
+		m_maxYaw[index] = p.maxRollPitchYaw.z * factor;
+		m_rollSpeed[index] = p.rollPitchYawSpeeds.x;
+		m_pitchSpeed[index] = p.rollPitchYawSpeeds.y;
+		m_yawSpeed[index] = p.rollPitchYawSpeeds.z;
+
+		m_rng[index] = CounterRNG(COUNTERRNG_SEED_DEFAULT,
+			(instanceIds == 0 || instanceIds[i] == 0) ? CounterRNG::getUniqueInstanceId() : instanceIds[i]);
+
+		// Initial offset
+		m_rng[index].sphere(&offset, 1, true);
+		XMStoreFloat3(&offset, XMVectorScale(XMLoadFloat3(&offset), m_maxRadius[index]));
+		m_ox[index] = offset.x;
+		m_oy[index] = offset.y;
+		m_oz[index] = offset.z;
+
+		// Initial rotational offset and directions of rotation
+		m_rng[index].uniform(values, 6);
+		m_roll[index] = values[0] * m_maxRoll[index];
+		m_pitch[index] = values[1] * m_maxPitch[index];
+		m_yaw[index] = values[2] * m_maxYaw[index];
+		m_rollSign[index] = (values[3] > 0.5f) ? 1.0f : -1.0f;
+		m_pitchSign[index] = (values[4] > 0.5f) ? 1.0f : -1.0f;
+		m_yawSign[index] = (values[5] > 0.5f) ? 1.0f : -1.0f;
+
+		m_start[index] = start;
+		m_end[index] = end;
+		m_inUse[index] = 1.0f;
+	}
+	m_count += n;
+
+	gatherEndpoints(first, first + n);
+	step(first, first + n, 0);
+	return ERROR_SUCCESS;
+}
+
+HRESULT WanderingLineSystem::remove(const size_t first, const size_t n) {
+	if( !isValidRange(first, n) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+
+	size_t index = 0;
+	for( size_t i = 0; i < n; ++i ) {
+		index = first + i;
+		m_inUse[index] = 0.0f;
+		m_maxRadius[index] = 0.0f;
+		m_linearSpeed[index] = 0.0f;
+		m_start[index] = 0;
+		m_end[index] = 0;
+	}
+	m_count -= n;
+
+	// Insert the range in order, merging it with adjacent free ranges
+	std::vector<std::pair<size_t, size_t> >::iterator it = m_freeRanges.begin();
+	while( it != m_freeRanges.end() && it->first < first ) {
+		++it;
+	}
+	it = m_freeRanges.insert(it, std::pair<size_t, size_t>(first, n));
+	std::vector<std::pair<size_t, size_t> >::iterator next = it + 1;
+	if( next != m_freeRanges.end() && it->first + it->second == next->first ) {
+		it->second += next->second;
+		it = m_freeRanges.erase(next) - 1;
+	}
+	if( it != m_freeRanges.begin() ) {
+		std::vector<std::pair<size_t, size_t> >::iterator previous = it - 1;
+		if( previous->first + previous->second == it->first ) {
+			previous->second += it->second;
+			m_freeRanges.erase(it);
+		}
+	}
+	return ERROR_SUCCESS;
+}
+
+HRESULT WanderingLineSystem::setEndpoints(const size_t first, const size_t n,
+	Transformable* const start, Transformable* const end) {
+	if( start == 0 || end == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	} else if( !isValidRange(first, n) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	for( size_t i = first; i < first + n; ++i ) {
+		m_start[i] = start;
+		m_end[i] = end;
+	}
+	gatherEndpoints(first, first + n);
+	step(first, first + n, 0);
+	return ERROR_SUCCESS;
+}
+
+HRESULT WanderingLineSystem::update(const DWORD updateTimeInterval) {
+	if( m_count == 0 ) {
+		return ERROR_SUCCESS;
+	}
+	gatherEndpoints(0, m_size);
+	if( updateTimeInterval != 0 ) {
+		drawOffsets();
+	}
+	step(0, m_size, updateTimeInterval);
+	return ERROR_SUCCESS;
+}
+
+HRESULT WanderingLineSystem::getScale(const size_t index, DirectX::XMFLOAT3& scale) const {
+	if( !isInUse(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	scale = XMFLOAT3(m_sx[index], m_sy[index], m_sz[index]);
+	return ERROR_SUCCESS;
+}
+
+HRESULT WanderingLineSystem::getPosition(const size_t index, DirectX::XMFLOAT3& position) const {
+	if( !isInUse(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	position = XMFLOAT3(m_px[index], m_py[index], m_pz[index]);
+	return ERROR_SUCCESS;
+}
+
+HRESULT WanderingLineSystem::getOrientation(const size_t index, DirectX::XMFLOAT4& orientation) const {
+	if( !isInUse(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	orientation = XMFLOAT4(m_qx[index], m_qy[index], m_qz[index], m_qw[index]);
+	return ERROR_SUCCESS;
+}
+
+HRESULT WanderingLineSystem::getForward(const size_t index, DirectX::XMFLOAT3& forward) const {
+	if( !isInUse(index) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	forward = XMFLOAT3(m_fx[index], m_fy[index], m_fz[index]);
+	return ERROR_SUCCESS;
+}
+
+HRESULT WanderingLineSystem::getKnotControlPoints(DirectX::XMFLOAT3* const controlPoints,
+	const size_t first, const size_t n, const float speed) const {
+	if( controlPoints == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	} else if( !isValidRange(first, n) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+
+	// Same construction as in Knot::updateP1() and Knot::updateP2()
+	XMVECTOR position, tangent;
+	XMFLOAT3* points = controlPoints;
+	for( size_t i = first; i < first + n; ++i ) {
+		position = XMVectorSet(m_px[i], m_py[i], m_pz[i], 0.0f);
+		tangent = XMVectorScale(XMVectorSet(m_fx[i], m_fy[i], m_fz[i], 0.0f), speed);
+		XMStoreFloat3(points, XMVectorAdd(XMVectorScale(tangent, -(1.0f / 3.0f)), position));
+		XMStoreFloat3(points + 1, position);
+		XMStoreFloat3(points + 2, position);
+		XMStoreFloat3(points + 3, XMVectorAdd(XMVectorScale(tangent, (1.0f / 3.0f)), position));
+		points += 4;
+	}
+	return ERROR_SUCCESS;
+}
+
+size_t WanderingLineSystem::getSize(void) const {
+	return m_size;
+}
+
+size_t WanderingLineSystem::getCount(void) const {
+	return m_count;
+}
+
+bool WanderingLineSystem::isInUse(const size_t index) const {
+	return index < m_size && m_inUse[index] != 0.0f;
+}
+
+void WanderingLineSystem::grow(const size_t size) {
+	const size_t paddedSize = ((size + WANDERINGLINESYSTEM_BATCH_SIZE - 1) / WANDERINGLINESYSTEM_BATCH_SIZE) * WANDERINGLINESYSTEM_BATCH_SIZE;
+	if( paddedSize > m_t.size() ) {
+		std::vector<float>* const zeroArrays[] = {
+			&m_t, &m_maxRadius, &m_linearSpeed,
+			&m_maxRoll, &m_maxPitch, &m_maxYaw,
+			&m_rollSpeed, &m_pitchSpeed, &m_yawSpeed,
+			&m_ox, &m_oy, &m_oz, &m_roll, &m_pitch, &m_yaw,
+			&m_inUse,
+			&m_ax, &m_ay, &m_az, &m_bx, &m_by, &m_bz,
+			&m_u0, &m_u1,
+			&m_px, &m_py, &m_pz, &m_qx, &m_qy, &m_qz, &m_fx, &m_fy
+		};
+		std::vector<float>* const oneArrays[] = {
+			&m_rollSign, &m_pitchSign, &m_yawSign,
+			&m_asx, &m_asy, &m_asz, &m_bsx, &m_bsy, &m_bsz,
+			&m_qw, &m_sx, &m_sy, &m_sz, &m_fz
+		};
+		for( size_t i = 0; i < sizeof(zeroArrays) / sizeof(zeroArrays[0]); ++i ) {
+			zeroArrays[i]->resize(paddedSize, 0.0f);
+		}
+		for( size_t i = 0; i < sizeof(oneArrays) / sizeof(oneArrays[0]); ++i ) {
+			oneArrays[i]->resize(paddedSize, 1.0f);
+		}
+		m_start.resize(paddedSize, 0);
+		m_end.resize(paddedSize, 0);
+		m_rng.resize(paddedSize);
+	}
+	if( size > m_size ) {
+		m_size = size;
+	}
+}
+
+void WanderingLineSystem::gatherEndpoints(const size_t first, const size_t last) {
+	// Consecutive objects usually share endpoints (e.g. the knots of one spline)
+	const Transformable* start = 0;
+	const Transformable* end = 0;
+	XMFLOAT3 startPosition, startScale, endPosition, endScale;
+	for( size_t i = first; i < last; ++i ) {
+		if( m_inUse[i] == 0.0f ) {
+			continue;
+		}
+		if( m_start[i] != start ) {
+			start = m_start[i];
+			startPosition = start->getPosition();
+			startScale = start->getScale();
+		}
+		if( m_end[i] != end ) {
+			end = m_end[i];
+			endPosition = end->getPosition();
+			endScale = end->getScale();
+		}
+		m_ax[i] = startPosition.x;
+		m_ay[i] = startPosition.y;
+		m_az[i] = startPosition.z;
+		m_asx[i] = startScale.x;
+		m_asy[i] = startScale.y;
+		m_asz[i] = startScale.z;
+		m_bx[i] = endPosition.x;
+		m_by[i] = endPosition.y;
+		m_bz[i] = endPosition.z;
+		m_bsx[i] = endScale.x;
+		m_bsy[i] = endScale.y;
+		m_bsz[i] = endScale.z;
+	}
+}
+
+void WanderingLineSystem::drawOffsets(void) {
+	m_movingRng.clear();
+	m_movingIndices.clear();
+	for( size_t i = 0; i < m_size; ++i ) {
+		if( m_inUse[i] != 0.0f && m_maxRadius[i] > 0.0f && m_linearSpeed[i] != 0.0f ) {
+			m_movingRng.push_back(&m_rng[i]);
+			m_movingIndices.push_back(i);
+		}
+	}
+	if( m_movingIndices.empty() ) {
+		return;
+	}
+
+	// Two values per object, as consumed by CounterRNG::sphere()
+	m_draws.resize(2 * m_movingIndices.size());
+	CounterRNG::uniform(&m_movingRng[0], m_movingRng.size(), &m_draws[0], 2);
+	size_t index = 0;
+	for( size_t i = 0; i < m_movingIndices.size(); ++i ) {
+		index = m_movingIndices[i];
+		m_u0[index] = m_draws[2 * i];
+		m_u1[index] = m_draws[2 * i + 1];
+	}
+}
+
+void WanderingLineSystem::step(const size_t first, const size_t last, const DWORD updateTimeInterval) {
+	const XMVECTOR zero = XMVectorZero();
+	const XMVECTOR one = XMVectorSplatOne();
+	const XMVECTOR half = XMVectorReplicate(0.5f);
+	const XMVECTOR two = XMVectorReplicate(2.0f);
+	const XMVECTOR twoPi = XMVectorReplicate(XM_2PI);
+	const XMVECTOR halfAngleFactor = XMVectorReplicate(0.5f * TRANSFORM_ORI_CHANGE_FACTOR);
+	const XMVECTOR interval = XMVectorReplicate(static_cast<float>(updateTimeInterval));
+	const bool isMoving = (updateTimeInterval != 0);
+
+	float selected[WANDERINGLINESYSTEM_BATCH_SIZE];
+	XMVECTOR update, moving, enabled;
+	XMVECTOR t, ax, ay, az, dx, dy, dz, length, hasLength;
+	XMVECTOR px, py, pz, ox, oy, oz, nx, ny, nz, radius, distance, reverse;
+	XMVECTOR cosPhi, sinPhi, sinTheta, cosTheta, cx, cy, cz;
+	XMVECTOR roll, pitch, yaw, rollSign, pitchSign, yawSign;
+	XMVECTOR maxRoll, maxPitch, maxYaw, rollSpeed, pitchSpeed, yawSpeed;
+	XMVECTOR lx, ly, lz, cosAngle, axisLengthSq, hasAxis, inverseAxisLength, sinHalf, cosHalf;
+	XMVECTOR q0x, q0y, q0z, q0w, sr, cr, sp, cp, sy, cy2, rx, ry, rz, rw, qx, qy, qz, qw;
+
+	const size_t begin = (first / WANDERINGLINESYSTEM_BATCH_SIZE) * WANDERINGLINESYSTEM_BATCH_SIZE;
+	size_t index = 0;
+	for( size_t i = begin; i < last; i += WANDERINGLINESYSTEM_BATCH_SIZE ) {
+
+		// Lanes in the range and in use
+		for( size_t k = 0; k < WANDERINGLINESYSTEM_BATCH_SIZE; ++k ) {
+			index = i + k;
+			selected[k] = (index >= first && index < last) ? m_inUse[index] : 0.0f;
+		}
+		update = XMVectorNotEqual(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(selected)), zero);
+
+		// Linear interpolation of position
+		t = WANDERINGLINESYSTEM_LOAD(m_t, i);
+		ax = WANDERINGLINESYSTEM_LOAD(m_ax, i);
+		ay = WANDERINGLINESYSTEM_LOAD(m_ay, i);
+		az = WANDERINGLINESYSTEM_LOAD(m_az, i);
+		dx = XMVectorSubtract(WANDERINGLINESYSTEM_LOAD(m_bx, i), ax);
+		dy = XMVectorSubtract(WANDERINGLINESYSTEM_LOAD(m_by, i), ay);
+		dz = XMVectorSubtract(WANDERINGLINESYSTEM_LOAD(m_bz, i), az);
+		px = XMVectorAdd(ax, XMVectorMultiply(t, dx));
+		py = XMVectorAdd(ay, XMVectorMultiply(t, dy));
+		pz = XMVectorAdd(az, XMVectorMultiply(t, dz));
+
+		// Unit vector along the line
+		length = XMVectorSqrt(XMVectorAdd(XMVectorAdd(
+			XMVectorMultiply(dx, dx), XMVectorMultiply(dy, dy)), XMVectorMultiply(dz, dz)));
+		hasLength = XMVectorGreater(length, zero);
+		lx = XMVectorSelect(zero, XMVectorDivide(dx, length), hasLength);
+		ly = XMVectorSelect(zero, XMVectorDivide(dy, length), hasLength);
+		lz = XMVectorSelect(one, XMVectorDivide(dz, length), hasLength);
+
+		// Positional offset
+		ox = WANDERINGLINESYSTEM_LOAD(m_ox, i);
+		oy = WANDERINGLINESYSTEM_LOAD(m_oy, i);
+		oz = WANDERINGLINESYSTEM_LOAD(m_oz, i);
+		radius = WANDERINGLINESYSTEM_LOAD(m_maxRadius, i);
+		if( isMoving ) {
+			distance = WANDERINGLINESYSTEM_LOAD(m_linearSpeed, i);
+			moving = XMVectorAndInt(update, XMVectorAndInt(
+				XMVectorGreater(radius, zero), XMVectorNotEqual(distance, zero)));
+			distance = XMVectorMultiply(distance, interval);
+
+			// Same mapping from random numbers to the unit sphere as CounterRNG::sphere()
+			cosPhi = XMVectorSubtract(XMVectorMultiply(two, WANDERINGLINESYSTEM_LOAD(m_u1, i)), one);
+			sinPhi = XMVectorSqrt(XMVectorMax(zero, XMVectorSubtract(one, XMVectorMultiply(cosPhi, cosPhi))));
+			XMVectorSinCos(&sinTheta, &cosTheta, XMVectorMultiply(twoPi, WANDERINGLINESYSTEM_LOAD(m_u0, i)));
+			cx = XMVectorMultiply(cosTheta, sinPhi);
+			cy = cosPhi;
+			cz = XMVectorMultiply(sinTheta, sinPhi);
+
+			nx = XMVectorAdd(ox, XMVectorMultiply(cx, distance));
+			ny = XMVectorAdd(oy, XMVectorMultiply(cy, distance));
+			nz = XMVectorAdd(oz, XMVectorMultiply(cz, distance));
+
+			// Move in the opposite direction if the maximum radius is exceeded
+			reverse = XMVectorGreater(XMVectorSqrt(XMVectorAdd(XMVectorAdd(
+				XMVectorMultiply(nx, nx), XMVectorMultiply(ny, ny)), XMVectorMultiply(nz, nz))), radius);
+			distance = XMVectorNegate(distance);
+			nx = XMVectorSelect(nx, XMVectorAdd(ox, XMVectorMultiply(cx, distance)), reverse);
+			ny = XMVectorSelect(ny, XMVectorAdd(oy, XMVectorMultiply(cy, distance)), reverse);
+			nz = XMVectorSelect(nz, XMVectorAdd(oz, XMVectorMultiply(cz, distance)), reverse);
+
+			ox = XMVectorSelect(ox, nx, moving);
+			oy = XMVectorSelect(oy, ny, moving);
+			oz = XMVectorSelect(oz, nz, moving);
+			WANDERINGLINESYSTEM_STORE(m_ox, i, ox);
+			WANDERINGLINESYSTEM_STORE(m_oy, i, oy);
+			WANDERINGLINESYSTEM_STORE(m_oz, i, oz);
+		}
+		WANDERINGLINESYSTEM_STORE(m_px, i, XMVectorSelect(WANDERINGLINESYSTEM_LOAD(m_px, i), XMVectorAdd(px, ox), update));
+		WANDERINGLINESYSTEM_STORE(m_py, i, XMVectorSelect(WANDERINGLINESYSTEM_LOAD(m_py, i), XMVectorAdd(py, oy), update));
+		WANDERINGLINESYSTEM_STORE(m_pz, i, XMVectorSelect(WANDERINGLINESYSTEM_LOAD(m_pz, i), XMVectorAdd(pz, oz), update));
+
+		// Linear interpolation of scale
+		ax = WANDERINGLINESYSTEM_LOAD(m_asx, i);
+		ay = WANDERINGLINESYSTEM_LOAD(m_asy, i);
+		az = WANDERINGLINESYSTEM_LOAD(m_asz, i);
+		WANDERINGLINESYSTEM_STORE(m_sx, i, XMVectorSelect(WANDERINGLINESYSTEM_LOAD(m_sx, i),
+			XMVectorAdd(ax, XMVectorMultiply(t, XMVectorSubtract(WANDERINGLINESYSTEM_LOAD(m_bsx, i), ax))), update));
+		WANDERINGLINESYSTEM_STORE(m_sy, i, XMVectorSelect(WANDERINGLINESYSTEM_LOAD(m_sy, i),
+			XMVectorAdd(ay, XMVectorMultiply(t, XMVectorSubtract(WANDERINGLINESYSTEM_LOAD(m_bsy, i), ay))), update));
+		WANDERINGLINESYSTEM_STORE(m_sz, i, XMVectorSelect(WANDERINGLINESYSTEM_LOAD(m_sz, i),
+			XMVectorAdd(az, XMVectorMultiply(t, XMVectorSubtract(WANDERINGLINESYSTEM_LOAD(m_bsz, i), az))), update));
+
+		// Rotational offset
+		roll = WANDERINGLINESYSTEM_LOAD(m_roll, i);
+		pitch = WANDERINGLINESYSTEM_LOAD(m_pitch, i);
+		yaw = WANDERINGLINESYSTEM_LOAD(m_yaw, i);
+		if( isMoving ) {
+			rollSign = WANDERINGLINESYSTEM_LOAD(m_rollSign, i);
+			pitchSign = WANDERINGLINESYSTEM_LOAD(m_pitchSign, i);
+			yawSign = WANDERINGLINESYSTEM_LOAD(m_yawSign, i);
+			maxRoll = WANDERINGLINESYSTEM_LOAD(m_maxRoll, i);
+			maxPitch = WANDERINGLINESYSTEM_LOAD(m_maxPitch, i);
+			maxYaw = WANDERINGLINESYSTEM_LOAD(m_maxYaw, i);
+			rollSpeed = WANDERINGLINESYSTEM_LOAD(m_rollSpeed, i);
+			pitchSpeed = WANDERINGLINESYSTEM_LOAD(m_pitchSpeed, i);
+			yawSpeed = WANDERINGLINESYSTEM_LOAD(m_yawSpeed, i);
+
+			enabled = XMVectorAndInt(update, XMVectorAndInt(
+				XMVectorNotEqual(rollSpeed, zero), XMVectorNotEqual(maxRoll, zero)));
+			advanceAngle(roll, rollSign, rollSpeed, maxRoll, interval, enabled);
+			enabled = XMVectorAndInt(update, XMVectorAndInt(
+				XMVectorNotEqual(pitchSpeed, zero), XMVectorNotEqual(maxPitch, zero)));
+			advanceAngle(pitch, pitchSign, pitchSpeed, maxPitch, interval, enabled);
+			enabled = XMVectorAndInt(update, XMVectorAndInt(
+				XMVectorNotEqual(yawSpeed, zero), XMVectorNotEqual(maxYaw, zero)));
+			advanceAngle(yaw, yawSign, yawSpeed, maxYaw, interval, enabled);
+
+			WANDERINGLINESYSTEM_STORE(m_roll, i, roll);
+			WANDERINGLINESYSTEM_STORE(m_pitch, i, pitch);
+			WANDERINGLINESYSTEM_STORE(m_yaw, i, yaw);
+			WANDERINGLINESYSTEM_STORE(m_rollSign, i, rollSign);
+			WANDERINGLINESYSTEM_STORE(m_pitchSign, i, pitchSign);
+			WANDERINGLINESYSTEM_STORE(m_yawSign, i, yawSign);
+		}
+
+		/* Rotation taking the positive z-axis onto the line, about their cross product,
+		   (-ly, lx, 0), or about the z-axis if the line is parallel to the z-axis.
+		   The sine and cosine of half of the angle are found from its cosine, 'lz'.
+		 */
+		cosAngle = lz;
+		sinHalf = XMVectorSqrt(XMVectorMax(zero, XMVectorMultiply(XMVectorSubtract(one, cosAngle), half)));
+		cosHalf = XMVectorSqrt(XMVectorMax(zero, XMVectorMultiply(XMVectorAdd(one, cosAngle), half)));
+		axisLengthSq = XMVectorAdd(XMVectorMultiply(lx, lx), XMVectorMultiply(ly, ly));
+		hasAxis = XMVectorGreater(axisLengthSq, zero);
+		inverseAxisLength = XMVectorMultiply(sinHalf, XMVectorReciprocal(XMVectorSqrt(axisLengthSq)));
+		q0x = XMVectorSelect(zero, XMVectorNegate(XMVectorMultiply(ly, inverseAxisLength)), hasAxis);
+		q0y = XMVectorSelect(zero, XMVectorMultiply(lx, inverseAxisLength), hasAxis);
+		q0z = XMVectorSelect(sinHalf, zero, hasAxis);
+		q0w = cosHalf;
+
+		/* Transformable::Spin() rotates about the object's forward, left and up
+		   directions, which is the same as following the above rotation with
+		   a yaw about the y-axis, a pitch about the negative x-axis,
+		   and a roll about the z-axis, in that order of multiplication.
+		 */
+		XMVectorSinCos(&sr, &cr, XMVectorMultiply(roll, halfAngleFactor));
+		XMVectorSinCos(&sp, &cp, XMVectorMultiply(pitch, halfAngleFactor));
+		XMVectorSinCos(&sy, &cy2, XMVectorMultiply(yaw, halfAngleFactor));
+
+		// (yaw * pitch) * roll
+		rx = XMVectorNegate(XMVectorMultiply(cy2, sp));
+		ry = XMVectorMultiply(sy, cp);
+		rz = XMVectorMultiply(sy, sp);
+		rw = XMVectorMultiply(cy2, cp);
+		qx = XMVectorAdd(XMVectorMultiply(rx, cr), XMVectorMultiply(ry, sr));
+		qy = XMVectorSubtract(XMVectorMultiply(ry, cr), XMVectorMultiply(rx, sr));
+		qz = XMVectorAdd(XMVectorMultiply(rw, sr), XMVectorMultiply(rz, cr));
+		qw = XMVectorSubtract(XMVectorMultiply(rw, cr), XMVectorMultiply(rz, sr));
+		multiplyQuaternions(rx, ry, rz, rw, q0x, q0y, q0z, q0w, qx, qy, qz, qw);
+
+		WANDERINGLINESYSTEM_STORE(m_qx, i, XMVectorSelect(WANDERINGLINESYSTEM_LOAD(m_qx, i), rx, update));
+		WANDERINGLINESYSTEM_STORE(m_qy, i, XMVectorSelect(WANDERINGLINESYSTEM_LOAD(m_qy, i), ry, update));
+		WANDERINGLINESYSTEM_STORE(m_qz, i, XMVectorSelect(WANDERINGLINESYSTEM_LOAD(m_qz, i), rz, update));
+		WANDERINGLINESYSTEM_STORE(m_qw, i, XMVectorSelect(WANDERINGLINESYSTEM_LOAD(m_qw, i), rw, update));
+
+		// Forward direction: The third row of the rotation matrix
+		WANDERINGLINESYSTEM_STORE(m_fx, i, XMVectorSelect(WANDERINGLINESYSTEM_LOAD(m_fx, i),
+			XMVectorMultiply(two, XMVectorAdd(XMVectorMultiply(rx, rz), XMVectorMultiply(rw, ry))), update));
+		WANDERINGLINESYSTEM_STORE(m_fy, i, XMVectorSelect(WANDERINGLINESYSTEM_LOAD(m_fy, i),
+			XMVectorMultiply(two, XMVectorSubtract(XMVectorMultiply(ry, rz), XMVectorMultiply(rw, rx))), update));
+		WANDERINGLINESYSTEM_STORE(m_fz, i, XMVectorSelect(WANDERINGLINESYSTEM_LOAD(m_fz, i),
+			XMVectorSubtract(one, XMVectorMultiply(two, XMVectorAdd(XMVectorMultiply(rx, rx), XMVectorMultiply(ry, ry)))), update));
+	}
+}
+
+bool WanderingLineSystem::isValidRange(const size_t first, const size_t n) const {
+	if( n == 0 || first + n > m_size ) {
+		return false;
+	}
+	for( size_t i = first; i < first + n; ++i ) {
+		if( m_inUse[i] == 0.0f ) {
+			return false;
+		}
+	}
+	return true;
+}
@@ -21,15 +21,13 @@ Description
 #include "WanderingLineTransformable.h"
 #include "defs.h"
 #include <exception>
-#include <cmath> // For fabs() and cbrt()
+#include <cmath> // For fabs()
 
 using namespace DirectX;
 
-std::default_random_engine WanderingLineTransformable::s_generator;
-std::uniform_real_distribution<float> WanderingLineTransformable::s_offsetDistribution(0.0f, 1.0f);
-
 WanderingLineTransformable::WanderingLineTransformable(Transformable* const start,
-	Transformable* const end, const Parameters& parameters) :
+	Transformable* const end, const Parameters& parameters,
+	const unsigned int instanceId) :
 	Transformable(
 	XMFLOAT3(0.0f, 0.0f, 0.0f),
 	XMFLOAT3(0.0f, 0.0f, 0.0f),
@@ -37,7 +35,8 @@ WanderingLineTransformable::WanderingLineTransformable(Transformable* const star
 	m_offset(XMFLOAT3(0.0f, 0.0f, 0.0f)),
 	m_rollPitchYaw(XMFLOAT3(0.0f, 0.0f, 0.0f)),
 	m_parameters(parameters),
-	m_start(start), m_end(end)
+	m_start(start), m_end(end),
+	m_rng(COUNTERRNG_SEED_DEFAULT, (instanceId == 0) ? CounterRNG::getUniqueInstanceId() : instanceId)
 {
 	if (parameters.t > 1.0f || parameters.t < 0.0f) {
 		throw std::exception("WanderingLineTransformable: Linear interpolation parameter is not in the range [0,1].");
@@ -50,25 +49,20 @@ WanderingLineTransformable::WanderingLineTransformable(Transformable* const star
 	m_parameters.maxRollPitchYaw.z *= factor;
 
 	// Set an initial offset
-	float u = s_offsetDistribution(s_generator);
-	float v = s_offsetDistribution(s_generator);
-	float w = cbrt(s_offsetDistribution(s_generator));
-	float sinPhi, cosPhi, sinTheta, cosTheta;
-	XMScalarSinCos(&sinPhi, &cosPhi, XMScalarACos(2.0f * v - 1));
-	XMScalarSinCos(&sinTheta, &cosTheta, XM_2PI * u);
-	m_offset.x = w * m_parameters.maxRadius * cosTheta * sinPhi;
-	m_offset.y = w * m_parameters.maxRadius * cosPhi;
-	m_offset.z = w * m_parameters.maxRadius * sinTheta * sinPhi;
+	m_rng.sphere(&m_offset, 1, true);
+	XMStoreFloat3(&m_offset, XMVectorScale(XMLoadFloat3(&m_offset), m_parameters.maxRadius));
 
 	// Set an initial rotational offset
-	m_rollPitchYaw.x = s_offsetDistribution(s_generator) * m_parameters.maxRollPitchYaw.x;
-	m_rollPitchYaw.y = s_offsetDistribution(s_generator) * m_parameters.maxRollPitchYaw.y;
-	m_rollPitchYaw.z = s_offsetDistribution(s_generator) * m_parameters.maxRollPitchYaw.z;
+	float values[6];
+	m_rng.uniform(values, 6);
+	m_rollPitchYaw.x = values[0] * m_parameters.maxRollPitchYaw.x;
+	m_rollPitchYaw.y = values[1] * m_parameters.maxRollPitchYaw.y;
+	m_rollPitchYaw.z = values[2] * m_parameters.maxRollPitchYaw.z;
 
 	// Set initial directions of rotation
-	m_rollPitchYawDirection[0] = (s_offsetDistribution(s_generator) > 0.5f);
-	m_rollPitchYawDirection[1] = (s_offsetDistribution(s_generator) > 0.5f);
-	m_rollPitchYawDirection[2] = (s_offsetDistribution(s_generator) > 0.5f);
+	m_rollPitchYawDirection[0] = (values[3] > 0.5f);
+	m_rollPitchYawDirection[1] = (values[4] > 0.5f);
+	m_rollPitchYawDirection[2] = (values[5] > 0.5f);
 
 	if (FAILED(refresh(0))) {
 		throw std::exception("WanderingLineTransformable: Initialization failed.");
@@ -116,15 +110,8 @@ HRESULT WanderingLineTransformable::refresh(const DWORD updateTimeInterval) {
 
 	// Calculate position offset
 	if( m_parameters.maxRadius > 0.0f && timeInterval != 0.0f && m_parameters.linearSpeed != 0.0f ) {
-		float u = s_offsetDistribution(s_generator);
-		float v = s_offsetDistribution(s_generator);
-		float sinPhi, cosPhi, sinTheta, cosTheta;
-		XMScalarSinCos(&sinPhi, &cosPhi, XMScalarACos(2.0f * v - 1));
-		XMScalarSinCos(&sinTheta, &cosTheta, XM_2PI * u);
-		XMFLOAT3 offsetChange = XMFLOAT3(
-			cosTheta * sinPhi,
-			cosPhi,
-			sinTheta * sinPhi);
+		XMFLOAT3 offsetChange;
+		m_rng.sphere(&offsetChange, 1);
 
 		vector1 = XMLoadFloat3(&m_offset);
 		vector2 = XMVectorScale(XMLoadFloat3(&offsetChange), m_parameters.linearSpeed * timeInterval);
@@ -208,5 +195,8 @@ HRESULT WanderingLineTransformable::refresh(const DWORD updateTimeInterval) {
 		Spin(m_rollPitchYaw.x, m_rollPitchYaw.y, m_rollPitchYaw.z);
 	}
 
+	// Position, scale and orientation were modified directly
+	markLocalChanged();
+
 	return ERROR_SUCCESS;
 }
\ No newline at end of file
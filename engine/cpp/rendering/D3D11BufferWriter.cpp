@@ -0,0 +1,58 @@
+/*
+D3D11BufferWriter.cpp
+---------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Implementation of the D3D11BufferWriter class
+*/
+
+#include "D3D11BufferWriter.h"
+#include "defs.h"
+
+D3D11BufferWriter::D3D11BufferWriter(ID3D11Buffer* const buffer, const size_t size) :
+	IBufferWriter(), m_buffer(buffer), m_size(size), m_context(0)
+{
+	if( m_buffer == 0 ) {
+		throw std::exception("Cannot create a D3D11BufferWriter for a null buffer.");
+	}
+}
+
+D3D11BufferWriter::~D3D11BufferWriter(void) {}
+
+void D3D11BufferWriter::setContext(ID3D11DeviceContext* const context) {
+	m_context = context;
+}
+
+size_t D3D11BufferWriter::getSize(void) const {
+	return m_size;
+}
+
+HRESULT D3D11BufferWriter::write(const void* const data, const size_t offset, const size_t size) {
+	if( m_context == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	} else if( offset > m_size || size > m_size - offset ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	} else if( size == 0 ) {
+		return ERROR_SUCCESS;
+	} else if( data == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+
+	// Buffers are one-dimensional, and boxes are measured in bytes
+	D3D11_BOX box;
+	box.left = static_cast<UINT>(offset);
+	box.right = static_cast<UINT>(offset + size);
+	box.top = 0;
+	box.bottom = 1;
+	box.front = 0;
+	box.back = 1;
+	m_context->UpdateSubresource(m_buffer, 0, &box, data, 0, 0);
+	return ERROR_SUCCESS;
+}
@@ -0,0 +1,62 @@
+/*
+D3D11ParticleDrawBackend.cpp
+----------------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: D3D11BufferWriter.cpp
+
+Description
+  -Implementation of the D3D11ParticleDrawBackend class
+*/
+
+#include "D3D11ParticleDrawBackend.h"
+#include "defs.h"
+
+D3D11ParticleDrawBackend::D3D11ParticleDrawBackend(void) :
+	IParticleDrawBackend(), m_models(), m_model(0),
+	m_context(0), m_manager(0), m_camera(0)
+{}
+
+D3D11ParticleDrawBackend::~D3D11ParticleDrawBackend(void) {}
+
+size_t D3D11ParticleDrawBackend::addModel(InvariantParticles* const model) {
+	m_models.push_back(model);
+	return m_models.size() - 1;
+}
+
+void D3D11ParticleDrawBackend::setContext(ID3D11DeviceContext* const context, GeometryRendererManager* const manager,
+	const Camera* const camera) {
+	m_context = context;
+	m_manager = manager;
+	m_camera = camera;
+}
+
+HRESULT D3D11ParticleDrawBackend::bindModel(const size_t model) {
+	if( model >= m_models.size() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	} else if( m_models[model] == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+	m_model = m_models[model];
+	return ERROR_SUCCESS;
+}
+
+HRESULT D3D11ParticleDrawBackend::draw(const ParticleInstanceType& instance) {
+	return drawInstanced(&instance, 1);
+}
+
+HRESULT D3D11ParticleDrawBackend::drawInstanced(const ParticleInstanceType* const instances, const size_t nInstances) {
+	if( m_model == 0 || m_context == 0 || m_manager == 0 || m_camera == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	} else if( nInstances == 0 ) {
+		return ERROR_SUCCESS;
+	}
+	if( FAILED(m_model->drawInstancedUsingAppropriateRenderer(m_context, *m_manager, m_camera, instances, nInstances)) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+	return ERROR_SUCCESS;
+}
@@ -23,6 +23,7 @@ Description
 */
 
 #include "InvariantParticlesRenderer.h"
+#include <cstring>
 
 using namespace DirectX;
 using std::wstring;
@@ -40,6 +41,8 @@ InvariantParticlesRenderer::InvariantParticlesRenderer(
 	m_vertexShader(0), m_geometryShader(0), m_pixelShader(0),
 	m_layout(0),
 	m_cameraBuffer(0), m_materialBuffer(0), m_globalBuffer(0), m_lightBuffer(0),
+	m_instancedVertexShader(0), m_instancedLayout(0), m_instanceBuffer(0),
+	m_instanceCapacity(INVARIANTPARTICLESRENDERER_INSTANCE_CAPACITY_DEFAULT),
 	m_lighting(false), m_light(0), m_configured(false),
 	m_additiveBlendState(0), m_dsState(0)
 {
@@ -93,6 +96,21 @@ InvariantParticlesRenderer::~InvariantParticlesRenderer(void) {
 		m_lightBuffer = 0;
 	}
 
+	if (m_instancedVertexShader) {
+		delete m_instancedVertexShader;
+		m_instancedVertexShader = 0;
+	}
+
+	if (m_instancedLayout) {
+		m_instancedLayout->Release();
+		m_instancedLayout = 0;
+	}
+
+	if (m_instanceBuffer) {
+		m_instanceBuffer->Release();
+		m_instanceBuffer = 0;
+	}
+
 	if (m_light != 0) {
 		delete m_light;
 		m_light = 0;
@@ -131,6 +149,13 @@ HRESULT InvariantParticlesRenderer::initialize(ID3D11Device* const device) {
 		}
 	}
 
+	if (m_instancedVertexShader != 0) {
+		if (FAILED(createInstanceBuffer(device))) {
+			logMessage(L"Call to createInstanceBuffer() failed.");
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+	}
+
 	if( FAILED(createBlendAndDSStates(device)) ) {
 		logMessage(L"Call to createBlendAndDSStates() failed.");
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
@@ -170,7 +195,7 @@ HRESULT InvariantParticlesRenderer::render(ID3D11DeviceContext* const context, c
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
-	size_t particleCount = castGeometry.getVertexCount();
+	size_t particleCount = castGeometry.getDrawVertexCount();
 
 	// Now render the prepared buffers with the shader.
 	renderShader(context, particleCount);
@@ -178,6 +203,69 @@ HRESULT InvariantParticlesRenderer::render(ID3D11DeviceContext* const context, c
 	return result;
 }
 
+HRESULT InvariantParticlesRenderer::renderInstanced(ID3D11DeviceContext* const context, const IGeometry& geometry, const Camera* const camera,
+	const ParticleInstanceType* const instances, const size_t nInstances) {
+	if (m_instancedVertexShader == 0) {
+		logMessage(L"Instanced rendering is disabled, as no instanced vertex shader was specified in configuration data.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	} else if (nInstances == 0) {
+		return ERROR_SUCCESS;
+	} else if (instances == 0) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+
+	const InvariantParticles& castGeometry = static_cast<const InvariantParticles&>(geometry);
+
+	HRESULT result = ERROR_SUCCESS;
+
+	XMFLOAT4X4 viewMatrix;
+	camera->GetViewMatrix(viewMatrix);
+
+	XMFLOAT4X4 projectionMatrix;
+	camera->GetProjectionMatrix(projectionMatrix);
+
+	// Prepare camera data
+	DirectX::XMFLOAT4 cameraPosition;
+	DirectX::XMFLOAT3 cameraPositionFloat3 = camera->GetPosition();
+	cameraPosition.x = cameraPositionFloat3.x;
+	cameraPosition.y = cameraPositionFloat3.y;
+	cameraPosition.z = cameraPositionFloat3.z;
+	cameraPosition.w = 1.0f;
+
+	// Set the shader parameters shared by all instances
+	result = setInstancedShaderParameters(context, viewMatrix, projectionMatrix,
+		cameraPosition, castGeometry);
+	if (FAILED(result)) {
+		logMessage(L"Failed to set shader parameters.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+
+	size_t particleCount = castGeometry.getDrawVertexCount();
+
+	unsigned int stride = sizeof(ParticleInstanceType);
+	unsigned int offset = 0;
+	D3D11_MAPPED_SUBRESOURCE mappedResource;
+
+	// Fill the instance buffer, and draw, as many times as necessary
+	for (size_t first = 0; first < nInstances; first += m_instanceCapacity) {
+		const size_t count = ((nInstances - first) < m_instanceCapacity) ? (nInstances - first) : m_instanceCapacity;
+
+		result = context->Map(m_instanceBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
+		if (FAILED(result)) {
+			logMessage(L"Failed to map instance buffer.");
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_LIBRARY_CALL);
+		}
+		std::memcpy(mappedResource.pData, instances + first, count * sizeof(ParticleInstanceType));
+		context->Unmap(m_instanceBuffer, 0);
+
+		context->IASetVertexBuffers(1, 1, &m_instanceBuffer, &stride, &offset);
+
+		renderShader(context, particleCount, count);
+	}
+
+	return ERROR_SUCCESS;
+}
+
 HRESULT InvariantParticlesRenderer::configure(const wstring& scope, const wstring* configUserScope, const wstring* logUserScope) {
 	HRESULT result = ERROR_SUCCESS;
 
@@ -197,6 +285,7 @@ HRESULT InvariantParticlesRenderer::configure(const wstring& scope, const wstrin
 			const bool* boolValue = 0;
 			const DirectX::XMFLOAT4* float4Value = 0;
 			const double* doubleValue = 0;
+			const int* intValue = 0;
 
 			// Query for initialization data
 			// -----------------------------
@@ -216,6 +305,16 @@ HRESULT InvariantParticlesRenderer::configure(const wstring& scope, const wstrin
 				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_DATA_NOT_FOUND);
 			}
 
+			// Instance buffer capacity
+			if (retrieve<Config::DataType::INT, int>(scope, INVARIANTPARTICLESRENDERER_INSTANCE_CAPACITY_FIELD, intValue)) {
+				if (*intValue < INVARIANTPARTICLESRENDERER_INSTANCE_CAPACITY_MIN) {
+					logMessage(L"The instance buffer capacity retrieved from configuration data is too low. Using the default value of "
+						+ std::to_wstring(INVARIANTPARTICLESRENDERER_INSTANCE_CAPACITY_DEFAULT) + L".");
+				} else {
+					m_instanceCapacity = static_cast<size_t>(*intValue);
+				}
+			}
+
 			// Light parameters
 			if (m_lighting) {
 				m_light = new Light;
@@ -254,11 +353,20 @@ HRESULT InvariantParticlesRenderer::configure(const wstring& scope, const wstrin
 				INVARIANTPARTICLESRENDERER_SHADER_SCOPE_CONFIGUSER_DEFAULT,
 			};
 
-			const size_t nShaders = 3;
+			const size_t nShaders = 4;
 			Shader** shaders[] = {
 				&m_vertexShader,
 				&m_geometryShader,
-				&m_pixelShader
+				&m_pixelShader,
+				&m_instancedVertexShader
+			};
+
+			// Only the instanced vertex shader is optional
+			bool shaderRequired[] = {
+				true,
+				true,
+				true,
+				false
 			};
 
 			// Shader configuration keys
@@ -266,7 +374,8 @@ HRESULT InvariantParticlesRenderer::configure(const wstring& scope, const wstrin
 			wstring prefixes[] = {
 				INVARIANTPARTICLESRENDERER_VSSHADER_FIELD_PREFIX,
 				INVARIANTPARTICLESRENDERER_GSSHADER_FIELD_PREFIX,
-				INVARIANTPARTICLESRENDERER_PSSHADER_FIELD_PREFIX
+				INVARIANTPARTICLESRENDERER_PSSHADER_FIELD_PREFIX,
+				INVARIANTPARTICLESRENDERER_VSINSTANCEDSHADER_FIELD_PREFIX
 			};
 
 			const size_t nStringFields = 4; // Not 6 (intentionally - see below)
@@ -308,6 +417,10 @@ HRESULT InvariantParticlesRenderer::configure(const wstring& scope, const wstrin
 						shaderInputConfigFilePath = *stringValue;
 					}
 				}
+				else if (!shaderRequired[i]) {
+					logMessage(L"No instanced vertex shader configuration filename found in configuration data. Instanced rendering is disabled.");
+					continue;
+				}
 				else {
 					logMessage(L"No shader configuration filename found in configuration data.");
 					result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_DATA_NOT_FOUND);
@@ -375,7 +488,22 @@ HRESULT InvariantParticlesRenderer::createShaders(ID3D11Device* const device) {
 	result = createInputLayout(device);
 	if( FAILED(result) ) {
 		logMessage(L"Call to createInputLayout() failed.");
-		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+
+	// Optional instanced vertex shader
+	if( m_instancedVertexShader != 0 ) {
+		result = m_instancedVertexShader->initialize(device);
+		if( FAILED(result) ) {
+			logMessage(L"Instanced vertex shader initialization failed.");
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+
+		result = createInstancedInputLayout(device);
+		if( FAILED(result) ) {
+			logMessage(L"Call to createInstancedInputLayout() failed.");
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
 	}
 
 	return result;
@@ -443,6 +571,95 @@ HRESULT InvariantParticlesRenderer::createInputLayout(ID3D11Device* const device
 	return result;
 }
 
+HRESULT InvariantParticlesRenderer::createInstancedInputLayout(ID3D11Device* const device) {
+	HRESULT result = ERROR_SUCCESS;
+	const unsigned int numElements = PARTICLEVERTEXTYPE_COMPONENTS + PARTICLEINSTANCETYPE_COMPONENTS;
+	D3D11_INPUT_ELEMENT_DESC polygonLayout[numElements];
+	size_t i = 0;
+
+	// Per-vertex data, as in createInputLayout()
+	LPCSTR vertexSemantics[PARTICLEVERTEXTYPE_COMPONENTS] = {
+		"POSITION",
+		"BILLBOARD",
+		"LINEAR_VELOCITY",
+		"LIFE",
+		"INDEX"
+	};
+	DXGI_FORMAT vertexFormats[PARTICLEVERTEXTYPE_COMPONENTS] = {
+		DXGI_FORMAT_R32G32B32_FLOAT,
+		DXGI_FORMAT_R32G32B32_FLOAT,
+		DXGI_FORMAT_R32G32B32A32_FLOAT,
+		DXGI_FORMAT_R32G32B32A32_FLOAT,
+		DXGI_FORMAT_R32G32B32A32_FLOAT
+	};
+	for( ; i < PARTICLEVERTEXTYPE_COMPONENTS; ++i ) {
+		polygonLayout[i].SemanticName = vertexSemantics[i];
+		polygonLayout[i].SemanticIndex = 0;
+		polygonLayout[i].Format = vertexFormats[i];
+		polygonLayout[i].InputSlot = 0;
+		polygonLayout[i].AlignedByteOffset = (i == 0) ? 0 : D3D11_APPEND_ALIGNED_ELEMENT;
+		polygonLayout[i].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+		polygonLayout[i].InstanceDataStepRate = 0;
+	}
+
+	// Per-instance data. This setup needs to match ParticleInstanceType and the instanced vertex shader.
+	for( unsigned int row = 0; row < 4; ++row, ++i ) {
+		polygonLayout[i].SemanticName = "WORLD";
+		polygonLayout[i].SemanticIndex = row;
+		polygonLayout[i].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+		polygonLayout[i].InputSlot = 1;
+		polygonLayout[i].AlignedByteOffset = (row == 0) ? 0 : D3D11_APPEND_ALIGNED_ELEMENT;
+		polygonLayout[i].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
+		polygonLayout[i].InstanceDataStepRate = 1;
+	}
+
+	polygonLayout[i].SemanticName = "TIME";
+	polygonLayout[i].SemanticIndex = 0;
+	polygonLayout[i].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+	polygonLayout[i].InputSlot = 1;
+	polygonLayout[i].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
+	polygonLayout[i].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
+	polygonLayout[i].InstanceDataStepRate = 1;
+	++i;
+
+	polygonLayout[i].SemanticName = "COLOR_CAST";
+	polygonLayout[i].SemanticIndex = 0;
+	polygonLayout[i].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+	polygonLayout[i].InputSlot = 1;
+	polygonLayout[i].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
+	polygonLayout[i].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
+	polygonLayout[i].InstanceDataStepRate = 1;
+	++i;
+
+	// Create the vertex input layout.
+	result = m_instancedVertexShader->createInputLayout(device, polygonLayout, numElements, &m_instancedLayout, true);
+	if( FAILED(result) ) {
+		logMessage(L"Failed to create instanced input layout object through the instanced vertex shader object.");
+		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+	return result;
+}
+
+HRESULT InvariantParticlesRenderer::createInstanceBuffer(ID3D11Device* const device) {
+	HRESULT result = ERROR_SUCCESS;
+	D3D11_BUFFER_DESC instanceBufferDesc;
+
+	instanceBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+	instanceBufferDesc.ByteWidth = static_cast<UINT>(sizeof(ParticleInstanceType) * m_instanceCapacity);
+	instanceBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	instanceBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	instanceBufferDesc.MiscFlags = 0;
+	instanceBufferDesc.StructureByteStride = 0;
+
+	result = device->CreateBuffer(&instanceBufferDesc, NULL, &m_instanceBuffer);
+	if( FAILED(result) ) {
+		logMessage(L"Failed to create instance buffer.");
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_LIBRARY_CALL);
+	}
+
+	return result;
+}
+
 HRESULT InvariantParticlesRenderer::createNoLightConstantBuffers(ID3D11Device* const device) {
 	HRESULT result = ERROR_SUCCESS;
 	D3D11_BUFFER_DESC cameraBufferDesc;
@@ -577,17 +794,15 @@ HRESULT InvariantParticlesRenderer::setShaderParameters(
 	return ERROR_SUCCESS;
 }
 
-HRESULT InvariantParticlesRenderer::setNoLightShaderParameters(
+HRESULT InvariantParticlesRenderer::setCameraShaderParameters(
 	ID3D11DeviceContext* const context,
 	const DirectX::XMFLOAT4X4 viewMatrix,
 	const DirectX::XMFLOAT4X4 projectionMatrix,
-	const DirectX::XMFLOAT4 cameraPosition,
-	const InvariantParticles& geometry) {
+	const DirectX::XMFLOAT4 cameraPosition) {
 
 	HRESULT result = ERROR_SUCCESS;
 	D3D11_MAPPED_SUBRESOURCE mappedResource;
 	CameraBufferType* cameraDataPtr = 0;
-	GlobalBufferType* globalDataPtr = 0;
 
 	// Transpose the matrices to prepare them for the shader.
 	DirectX::XMFLOAT4X4 viewMatrixTranspose;
@@ -619,6 +834,25 @@ HRESULT InvariantParticlesRenderer::setNoLightShaderParameters(
 	// The geometry shader will also use the camera data
 	context->GSSetConstantBuffers(0, 1, &m_cameraBuffer);
 
+	return result;
+}
+
+HRESULT InvariantParticlesRenderer::setNoLightShaderParameters(
+	ID3D11DeviceContext* const context,
+	const DirectX::XMFLOAT4X4 viewMatrix,
+	const DirectX::XMFLOAT4X4 projectionMatrix,
+	const DirectX::XMFLOAT4 cameraPosition,
+	const InvariantParticles& geometry) {
+
+	HRESULT result = ERROR_SUCCESS;
+	D3D11_MAPPED_SUBRESOURCE mappedResource;
+	GlobalBufferType* globalDataPtr = 0;
+
+	result = setCameraShaderParameters(context, viewMatrix, projectionMatrix, cameraPosition);
+	if( FAILED(result) ) {
+		return result;
+	}
+
 	// Lock the globals constant buffer so it can be written to.
 	result = context->Map(m_globalBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
 	if( FAILED(result) ) {
@@ -656,7 +890,13 @@ HRESULT InvariantParticlesRenderer::setNoLightShaderParameters(
 		globalDataPtr->timeAndPadding.y = time.y;
 	}
 
+	// Level of detail compensation
+	DirectX::XMFLOAT2 lodCompensation = geometry.getLODCompensation();
+	globalDataPtr->timeAndPadding.z = lodCompensation.x;
+	globalDataPtr->timeAndPadding.w = lodCompensation.y;
+
 	// SplineParticlesRenderer parameters
+	globalDataPtr->splineBuffer = DirectX::XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
 	if( FAILED(setSplineParameters(*globalDataPtr, geometry)) ) {
 		logMessage(L"Call to setSplineParameters() failed.");
 	}
@@ -678,6 +918,61 @@ HRESULT InvariantParticlesRenderer::setNoLightShaderParameters(
 	return result;
 }
 
+HRESULT InvariantParticlesRenderer::setInstancedShaderParameters(
+	ID3D11DeviceContext* const context,
+	const DirectX::XMFLOAT4X4 viewMatrix,
+	const DirectX::XMFLOAT4X4 projectionMatrix,
+	const DirectX::XMFLOAT4 cameraPosition,
+	const InvariantParticles& geometry) {
+
+	HRESULT result = ERROR_SUCCESS;
+	D3D11_MAPPED_SUBRESOURCE mappedResource;
+	GlobalBufferType* globalDataPtr = 0;
+
+	result = setCameraShaderParameters(context, viewMatrix, projectionMatrix, cameraPosition);
+	if( FAILED(result) ) {
+		return result;
+	}
+
+	// Lock the globals constant buffer so it can be written to.
+	result = context->Map(m_globalBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
+	if( FAILED(result) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_LIBRARY_CALL);
+	}
+
+	globalDataPtr = static_cast<GlobalBufferType*>(mappedResource.pData);
+
+	// The blend amount is shared by all instances
+	float blend = geometry.getTransparencyBlendFactor();
+	if( blend > 1.0f || blend < 0.0f ) {
+		logMessage(L"Blend factor out of range (0.0f to 1.0f) - Defaulted to 1.0f.");
+		blend = 1.0f;
+	}
+	globalDataPtr->blendAmountColourCast = DirectX::XMFLOAT4(blend, 0.0f, 0.0f, 0.0f);
+
+	// The world matrix, time vector and level of detail compensation are read from the instance buffer
+	XMStoreFloat4x4(&globalDataPtr->world, XMMatrixIdentity());
+	globalDataPtr->timeAndPadding = DirectX::XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
+	globalDataPtr->splineBuffer = DirectX::XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
+
+	// Unlock the buffer.
+	context->Unmap(m_globalBuffer, 0);
+
+	// Now set the global constant buffer in all shaders
+	context->VSSetConstantBuffers(1, 1, &m_globalBuffer);
+	context->GSSetConstantBuffers(1, 1, &m_globalBuffer);
+	context->PSSetConstantBuffers(0, 1, &m_globalBuffer);
+
+	if( m_lighting ) {
+		if( FAILED(setLightShaderParameters(context, geometry.getMaterial(), blend)) ) {
+			logMessage(L"Call to setLightShaderParameters() failed.");
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+	}
+
+	return result;
+}
+
 HRESULT InvariantParticlesRenderer::setLightShaderParameters(
 	ID3D11DeviceContext* const context,
 	const INVARIANTPARTICLESRENDERER_MATERIAL_STRUCT* material,
@@ -729,12 +1024,12 @@ HRESULT InvariantParticlesRenderer::setLightShaderParameters(
 	return result;
 }
 
-void InvariantParticlesRenderer::renderShader(ID3D11DeviceContext* const context, const size_t particleCount) {
+void InvariantParticlesRenderer::renderShader(ID3D11DeviceContext* const context, const size_t particleCount, const size_t nInstances) {
 	// Set the vertex input layout.
-	context->IASetInputLayout(m_layout);
+	context->IASetInputLayout((nInstances == 0) ? m_layout : m_instancedLayout);
 
 	// Set the vertex and pixel shaders that will be used to render the system
-	if( FAILED(m_vertexShader->bind(context)) ) {
+	if( FAILED(((nInstances == 0) ? m_vertexShader : m_instancedVertexShader)->bind(context)) ) {
 		logMessage(L"Failed to bind vertex shader.");
 	}
 	if( FAILED(m_geometryShader->bind(context)) ) {
@@ -760,7 +1055,11 @@ void InvariantParticlesRenderer::renderShader(ID3D11DeviceContext* const context
 	context->OMSetDepthStencilState(m_dsState, StencilRef);
 
 	// Render the geometry.
-	context->Draw(particleCount, 0);
+	if( nInstances == 0 ) {
+		context->Draw(particleCount, 0);
+	} else {
+		context->DrawInstanced(particleCount, nInstances, 0, 0);
+	}
 
 	// Restore previous states
 	context->OMSetBlendState(blendState, BlendFactor, SampleMask);
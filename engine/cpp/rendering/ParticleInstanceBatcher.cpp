@@ -0,0 +1,106 @@
+/*
+ParticleInstanceBatcher.cpp
+---------------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: SplineUploader.cpp
+
+Description
+  -Implementation of the ParticleInstanceBatcher class
+*/
+
+#include "ParticleInstanceBatcher.h"
+#include "defs.h"
+
+using namespace DirectX;
+using std::vector;
+
+ParticleInstanceBatcher::ParticleInstanceBatcher(const size_t nModels, const bool instanced,
+	const size_t maxInstancesPerDraw) :
+	m_instances(nModels), m_nInstances(0), m_instanced(instanced),
+	m_maxInstancesPerDraw((maxInstancesPerDraw == 0) ? PARTICLEINSTANCEBATCHER_MAX_INSTANCES_DEFAULT : maxInstancesPerDraw)
+{}
+
+ParticleInstanceBatcher::~ParticleInstanceBatcher(void) {}
+
+HRESULT ParticleInstanceBatcher::add(const size_t model, const ParticleInstanceType& instance) {
+	if( model >= m_instances.size() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	m_instances[model].push_back(instance);
+	++m_nInstances;
+	return ERROR_SUCCESS;
+}
+
+HRESULT ParticleInstanceBatcher::flush(IParticleDrawBackend& backend) {
+	HRESULT result = ERROR_SUCCESS;
+	const size_t nModels = m_instances.size();
+
+	for( size_t model = 0; (model < nModels) && SUCCEEDED(result); ++model ) {
+		const vector<ParticleInstanceType>& instances = m_instances[model];
+		const size_t nInstances = instances.size();
+		if( nInstances == 0 ) {
+			continue;
+		}
+
+		if( m_instanced ) {
+			if( FAILED(backend.bindModel(model)) ) {
+				result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+				break;
+			}
+			for( size_t first = 0; first < nInstances; first += m_maxInstancesPerDraw ) {
+				const size_t count = ((nInstances - first) < m_maxInstancesPerDraw) ? (nInstances - first) : m_maxInstancesPerDraw;
+				if( FAILED(backend.drawInstanced(&instances[first], count)) ) {
+					result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+					break;
+				}
+			}
+		} else {
+			for( size_t i = 0; i < nInstances; ++i ) {
+				if( FAILED(backend.bindModel(model)) || FAILED(backend.draw(instances[i])) ) {
+					result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+					break;
+				}
+			}
+		}
+	}
+
+	clear();
+	return result;
+}
+
+void ParticleInstanceBatcher::clear(void) {
+	const size_t nModels = m_instances.size();
+	for( size_t model = 0; model < nModels; ++model ) {
+		m_instances[model].clear();
+	}
+	m_nInstances = 0;
+}
+
+void ParticleInstanceBatcher::setInstanced(const bool instanced) {
+	m_instanced = instanced;
+}
+
+bool ParticleInstanceBatcher::isInstanced(void) const {
+	return m_instanced;
+}
+
+size_t ParticleInstanceBatcher::getNumberOfModels(void) const {
+	return m_instances.size();
+}
+
+size_t ParticleInstanceBatcher::getNumberOfInstances(void) const {
+	return m_nInstances;
+}
+
+void ParticleInstanceBatcher::makeInstance(ParticleInstanceType& instance,
+	const XMFLOAT4X4& world, const XMFLOAT2& time,
+	const XMFLOAT3& colorCast) {
+	instance.world = world;
+	instance.time = XMFLOAT4(time.x, time.y, 1.0f, 1.0f);
+	instance.colorCast = XMFLOAT4(colorCast.x, colorCast.y, colorCast.z, 0.0f);
+}
@@ -0,0 +1,71 @@
+/*
+RecordingBufferWriter.cpp
+-------------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: ManualClock.cpp
+
+Description
+  -Implementation of the RecordingBufferWriter class
+*/
+
+#include "RecordingBufferWriter.h"
+#include "defs.h"
+#include <cstring>
+
+RecordingBufferWriter::RecordingBufferWriter(const size_t size) :
+	IBufferWriter(), m_contents(size, 0),
+	m_frameBytes(0), m_frameWrites(0),
+	m_totalBytes(0), m_totalWrites(0)
+{}
+
+RecordingBufferWriter::~RecordingBufferWriter(void) {}
+
+size_t RecordingBufferWriter::getSize(void) const {
+	return m_contents.size();
+}
+
+HRESULT RecordingBufferWriter::write(const void* const data, const size_t offset, const size_t size) {
+	if( offset > m_contents.size() || size > m_contents.size() - offset ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	} else if( size == 0 ) {
+		return ERROR_SUCCESS;
+	} else if( data == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+	std::memcpy(&m_contents[offset], data, size);
+	m_frameBytes += size;
+	++m_frameWrites;
+	m_totalBytes += size;
+	++m_totalWrites;
+	return ERROR_SUCCESS;
+}
+
+void RecordingBufferWriter::beginFrame(void) {
+	m_frameBytes = 0;
+	m_frameWrites = 0;
+}
+
+const unsigned char* RecordingBufferWriter::getContents(void) const {
+	return (m_contents.empty()) ? 0 : &m_contents[0];
+}
+
+size_t RecordingBufferWriter::getFrameBytes(void) const {
+	return m_frameBytes;
+}
+
+size_t RecordingBufferWriter::getFrameWrites(void) const {
+	return m_frameWrites;
+}
+
+size_t RecordingBufferWriter::getTotalBytes(void) const {
+	return m_totalBytes;
+}
+
+size_t RecordingBufferWriter::getTotalWrites(void) const {
+	return m_totalWrites;
+}
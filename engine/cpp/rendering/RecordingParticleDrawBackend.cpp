@@ -0,0 +1,124 @@
+/*
+RecordingParticleDrawBackend.cpp
+--------------------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: RecordingBufferWriter.cpp
+
+Description
+  -Implementation of the RecordingParticleDrawBackend class
+*/
+
+#include "RecordingParticleDrawBackend.h"
+#include "defs.h"
+
+using std::vector;
+
+RecordingParticleDrawBackend::RecordingParticleDrawBackend(const size_t nModels) :
+	IParticleDrawBackend(), m_nModels(nModels), m_model(nModels),
+	m_frameDraws(), m_frameInstances(),
+	m_frameModelBinds(0), m_frameConstantBufferWrites(0),
+	m_frameInstanceBufferWrites(0),
+	m_totalDrawCalls(0), m_totalStateChanges(0)
+{}
+
+RecordingParticleDrawBackend::~RecordingParticleDrawBackend(void) {}
+
+HRESULT RecordingParticleDrawBackend::bindModel(const size_t model) {
+	if( model >= m_nModels ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	m_model = model;
+	++m_frameModelBinds;
+	++m_totalStateChanges;
+	return ERROR_SUCCESS;
+}
+
+HRESULT RecordingParticleDrawBackend::draw(const ParticleInstanceType& instance) {
+	if( m_model >= m_nModels ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+	Draw record;
+	record.model = m_model;
+	record.firstInstance = m_frameInstances.size();
+	record.nInstances = 1;
+	record.instanced = false;
+	m_frameDraws.push_back(record);
+	m_frameInstances.push_back(instance);
+
+	++m_frameConstantBufferWrites;
+	++m_totalStateChanges;
+	++m_totalDrawCalls;
+	return ERROR_SUCCESS;
+}
+
+HRESULT RecordingParticleDrawBackend::drawInstanced(const ParticleInstanceType* const instances, const size_t nInstances) {
+	if( m_model >= m_nModels ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	} else if( nInstances == 0 ) {
+		return ERROR_SUCCESS;
+	} else if( instances == 0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+	Draw record;
+	record.model = m_model;
+	record.firstInstance = m_frameInstances.size();
+	record.nInstances = nInstances;
+	record.instanced = true;
+	m_frameDraws.push_back(record);
+	m_frameInstances.insert(m_frameInstances.end(), instances, instances + nInstances);
+
+	++m_frameInstanceBufferWrites;
+	++m_totalStateChanges;
+	++m_totalDrawCalls;
+	return ERROR_SUCCESS;
+}
+
+void RecordingParticleDrawBackend::beginFrame(void) {
+	m_model = m_nModels;
+	m_frameDraws.clear();
+	m_frameInstances.clear();
+	m_frameModelBinds = 0;
+	m_frameConstantBufferWrites = 0;
+	m_frameInstanceBufferWrites = 0;
+}
+
+const vector<RecordingParticleDrawBackend::Draw>& RecordingParticleDrawBackend::getFrameDraws(void) const {
+	return m_frameDraws;
+}
+
+const vector<ParticleInstanceType>& RecordingParticleDrawBackend::getFrameInstances(void) const {
+	return m_frameInstances;
+}
+
+size_t RecordingParticleDrawBackend::getFrameDrawCalls(void) const {
+	return m_frameDraws.size();
+}
+
+size_t RecordingParticleDrawBackend::getFrameModelBinds(void) const {
+	return m_frameModelBinds;
+}
+
+size_t RecordingParticleDrawBackend::getFrameConstantBufferWrites(void) const {
+	return m_frameConstantBufferWrites;
+}
+
+size_t RecordingParticleDrawBackend::getFrameInstanceBufferWrites(void) const {
+	return m_frameInstanceBufferWrites;
+}
+
+size_t RecordingParticleDrawBackend::getFrameStateChanges(void) const {
+	return m_frameModelBinds + m_frameConstantBufferWrites + m_frameInstanceBufferWrites;
+}
+
+size_t RecordingParticleDrawBackend::getTotalDrawCalls(void) const {
+	return m_totalDrawCalls;
+}
+
+size_t RecordingParticleDrawBackend::getTotalStateChanges(void) const {
+	return m_totalStateChanges;
+}
@@ -47,5 +47,7 @@ HRESULT SplineParticlesRenderer::setSplineParameters(GlobalBufferType& buffer,
 	const SplineParticles& castGeometry = static_cast<const SplineParticles&>(geometry);
 	buffer.timeAndPadding.z = static_cast<float>(castGeometry.getNumberOfSegments(false));
 	buffer.timeAndPadding.w = static_cast<float>(castGeometry.getNumberOfSegments(true));
+	buffer.splineBuffer.x = static_cast<float>(castGeometry.getSegmentSlotOffset());
+	buffer.splineBuffer.y = static_cast<float>(castGeometry.getNumberOfSegmentSlots());
 	return ERROR_SUCCESS;
 }
\ No newline at end of file
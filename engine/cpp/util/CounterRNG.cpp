@@ -0,0 +1,332 @@
+/*
+CounterRNG.cpp
+--------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Implementation of the CounterRNG class
+*/
+
+#include "CounterRNG.h"
+#include <atomic>
+#include <cmath>
+
+using namespace DirectX;
+
+// Philox4x32 multipliers and Weyl sequence key increments
+#define COUNTERRNG_M0 0xD2511F53u
+#define COUNTERRNG_M1 0xCD9E8D57u
+#define COUNTERRNG_W0 0x9E3779B9u
+#define COUNTERRNG_W1 0xBB67AE85u
+#define COUNTERRNG_N_ROUNDS 10
+
+CounterRNG::CounterRNG(const unsigned int seed, const unsigned int instanceId) :
+	m_drawIndex(0), m_blockIndex(0), m_blockValid(false)
+{
+	m_key[0] = seed;
+	m_key[1] = instanceId;
+}
+
+CounterRNG::~CounterRNG(void) {}
+
+unsigned int CounterRNG::getUniqueInstanceId(void) {
+	static std::atomic<unsigned int> s_nextInstanceId(1);
+	return s_nextInstanceId++;
+}
+
+unsigned long long CounterRNG::getDrawIndex(void) const {
+	return m_drawIndex;
+}
+
+void CounterRNG::setDrawIndex(const unsigned long long index) {
+	m_drawIndex = index;
+}
+
+float CounterRNG::nextUniform(void) {
+	const unsigned long long blockIndex = m_drawIndex / 4;
+	if( !m_blockValid || blockIndex != m_blockIndex ) {
+		generateBlocks(m_block, blockIndex, 1);
+		m_blockIndex = blockIndex;
+		m_blockValid = true;
+	}
+	const unsigned int value = m_block[m_drawIndex % 4];
+	++m_drawIndex;
+	return toUniform(value);
+}
+
+void CounterRNG::uniform(float* const out, const size_t n) {
+	unsigned int values[4 * COUNTERRNG_BLOCKS_PER_BATCH];
+	const size_t batchSize = 4 * (COUNTERRNG_BLOCKS_PER_BATCH - 1);
+	size_t count = 0;
+	for( size_t i = 0; i < n; i += count ) {
+		count = (n - i < batchSize) ? (n - i) : batchSize;
+		nextBatch(values, count);
+		for( size_t j = 0; j < count; ++j ) {
+			out[i + j] = toUniform(values[j]);
+		}
+	}
+}
+
+void CounterRNG::uniform(CounterRNG* const* const generators, const size_t nGenerators,
+	float* const out, const size_t n) {
+	if( n == 0 ) {
+		return;
+	}
+
+	// Largest number of blocks spanned by 'n' values
+	const size_t maxBlocksPerGenerator = (n + 6) / 4;
+	if( maxBlocksPerGenerator > COUNTERRNG_BLOCKS_PER_BATCH ) {
+		for( size_t i = 0; i < nGenerators; ++i ) {
+			generators[i]->uniform(out + i * n, n);
+		}
+		return;
+	}
+
+	unsigned int key0[COUNTERRNG_BLOCKS_PER_BATCH];
+	unsigned int key1[COUNTERRNG_BLOCKS_PER_BATCH];
+	unsigned long long blockIndices[COUNTERRNG_BLOCKS_PER_BATCH];
+	unsigned int values[4 * COUNTERRNG_BLOCKS_PER_BATCH];
+	const size_t batchSize = COUNTERRNG_BLOCKS_PER_BATCH / maxBlocksPerGenerator;
+	size_t count = 0;
+	size_t nBlocks = 0;
+	size_t offset = 0;
+	const unsigned int* value = 0;
+	CounterRNG* generator = 0;
+	unsigned long long lastBlock = 0;
+	for( size_t i = 0; i < nGenerators; i += count ) {
+		count = (nGenerators - i < batchSize) ? (nGenerators - i) : batchSize;
+
+		// Blocks needed by each generator, in order
+		nBlocks = 0;
+		for( size_t j = 0; j < count; ++j ) {
+			generator = generators[i + j];
+			lastBlock = (generator->m_drawIndex + n - 1) / 4;
+			for( unsigned long long b = generator->m_drawIndex / 4; b <= lastBlock; ++b ) {
+				key0[nBlocks] = generator->m_key[0];
+				key1[nBlocks] = generator->m_key[1];
+				blockIndices[nBlocks] = b;
+				++nBlocks;
+			}
+		}
+		generateBlocks(values, key0, key1, blockIndices, nBlocks);
+
+		value = values;
+		for( size_t j = 0; j < count; ++j ) {
+			generator = generators[i + j];
+			offset = static_cast<size_t>(generator->m_drawIndex % 4);
+			for( size_t k = 0; k < n; ++k ) {
+				out[(i + j) * n + k] = toUniform(value[offset + k]);
+			}
+			value += 4 * ((offset + n + 3) / 4);
+			generator->m_drawIndex += n;
+		}
+	}
+}
+
+void CounterRNG::normal(float* const out, const size_t n) {
+	float values[4 * (COUNTERRNG_BLOCKS_PER_BATCH - 1)];
+	const size_t batchSize = 4 * (COUNTERRNG_BLOCKS_PER_BATCH - 1);
+	size_t count = 0;
+	float radius = 0.0f;
+	float sinTheta, cosTheta;
+	for( size_t i = 0; i < n; i += count ) {
+		count = (n - i < batchSize) ? (n - i) : batchSize;
+		uniform(values, count + (count % 2));
+		for( size_t j = 0; j < count; j += 2 ) {
+			// Use (0,1] rather than [0,1) to avoid taking the logarithm of zero
+			radius = sqrtf(-2.0f * logf(1.0f - values[j]));
+			XMScalarSinCos(&sinTheta, &cosTheta, XM_2PI * values[j + 1]);
+			out[i + j] = radius * cosTheta;
+			if( j + 1 < count ) {
+				out[i + j + 1] = radius * sinTheta;
+			}
+		}
+	}
+}
+
+void CounterRNG::sphere(XMFLOAT3* const out, const size_t n, const bool volume) {
+	float values[3 * COUNTERRNG_BLOCKS_PER_BATCH];
+	const size_t nValues = volume ? 3 : 2;
+	const size_t batchSize = COUNTERRNG_BLOCKS_PER_BATCH;
+	size_t count = 0;
+	float radius = 1.0f;
+	float sinPhi, cosPhi, sinTheta, cosTheta;
+	const float* value = 0;
+	for( size_t i = 0; i < n; i += count ) {
+		count = (n - i < batchSize) ? (n - i) : batchSize;
+		uniform(values, count * nValues);
+		value = values;
+		for( size_t j = 0; j < count; ++j ) {
+			// Same mapping as used by WanderingLineTransformable
+			XMScalarSinCos(&sinPhi, &cosPhi, XMScalarACos(2.0f * value[1] - 1.0f));
+			XMScalarSinCos(&sinTheta, &cosTheta, XM_2PI * value[0]);
+			radius = volume ? cbrtf(value[2]) : 1.0f;
+			out[i + j] = XMFLOAT3(
+				radius * cosTheta * sinPhi,
+				radius * cosPhi,
+				radius * sinTheta * sinPhi);
+			value += nValues;
+		}
+	}
+}
+
+void CounterRNG::cone(XMFLOAT3* const out, const size_t n, const float maxAngle) {
+	float values[2 * COUNTERRNG_BLOCKS_PER_BATCH];
+	const size_t batchSize = COUNTERRNG_BLOCKS_PER_BATCH;
+	const float minCos = cosf(maxAngle);
+	size_t count = 0;
+	float cosPhi, sinPhi, sinTheta, cosTheta;
+	for( size_t i = 0; i < n; i += count ) {
+		count = (n - i < batchSize) ? (n - i) : batchSize;
+		uniform(values, count * 2);
+		for( size_t j = 0; j < count; ++j ) {
+			// The cosine of the angle from the axis is uniform over a spherical cap
+			cosPhi = 1.0f - values[2 * j + 1] * (1.0f - minCos);
+			sinPhi = sqrtf(1.0f - cosPhi * cosPhi);
+			XMScalarSinCos(&sinTheta, &cosTheta, XM_2PI * values[2 * j]);
+			out[i + j] = XMFLOAT3(sinPhi * cosTheta, sinPhi * sinTheta, cosPhi);
+		}
+	}
+}
+
+void CounterRNG::philox(unsigned int* const result,
+	const unsigned int* const counter, const unsigned int* const key) {
+
+	unsigned int c[4] = { counter[0], counter[1], counter[2], counter[3] };
+	unsigned int k[2] = { key[0], key[1] };
+	unsigned long long product0, product1;
+	for( size_t round = 0; round < COUNTERRNG_N_ROUNDS; ++round ) {
+		if( round > 0 ) {
+			k[0] += COUNTERRNG_W0;
+			k[1] += COUNTERRNG_W1;
+		}
+		product0 = static_cast<unsigned long long>(COUNTERRNG_M0) * c[0];
+		product1 = static_cast<unsigned long long>(COUNTERRNG_M1) * c[2];
+		c[0] = static_cast<unsigned int>(product1 >> 32) ^ c[1] ^ k[0];
+		c[2] = static_cast<unsigned int>(product0 >> 32) ^ c[3] ^ k[1];
+		c[1] = static_cast<unsigned int>(product1);
+		c[3] = static_cast<unsigned int>(product0);
+	}
+	result[0] = c[0];
+	result[1] = c[1];
+	result[2] = c[2];
+	result[3] = c[3];
+}
+
+void CounterRNG::generateBlocks(unsigned int* const out,
+	const unsigned long long firstBlock, const size_t nBlocks) const {
+
+	// Structure-of-arrays state, so that each round is applied to all blocks in one loop
+	unsigned int c0[COUNTERRNG_BLOCKS_PER_BATCH];
+	unsigned int c1[COUNTERRNG_BLOCKS_PER_BATCH];
+	unsigned int c2[COUNTERRNG_BLOCKS_PER_BATCH];
+	unsigned int c3[COUNTERRNG_BLOCKS_PER_BATCH];
+	unsigned long long blockIndex = 0;
+	for( size_t b = 0; b < nBlocks; ++b ) {
+		blockIndex = firstBlock + b;
+		c0[b] = static_cast<unsigned int>(blockIndex);
+		c1[b] = static_cast<unsigned int>(blockIndex >> 32);
+		c2[b] = 0;
+		c3[b] = 0;
+	}
+
+	unsigned int k0 = m_key[0];
+	unsigned int k1 = m_key[1];
+	unsigned long long product0, product1;
+	unsigned int old1, old3;
+	for( size_t round = 0; round < COUNTERRNG_N_ROUNDS; ++round ) {
+		if( round > 0 ) {
+			k0 += COUNTERRNG_W0;
+			k1 += COUNTERRNG_W1;
+		}
+		for( size_t b = 0; b < nBlocks; ++b ) {
+			product0 = static_cast<unsigned long long>(COUNTERRNG_M0) * c0[b];
+			product1 = static_cast<unsigned long long>(COUNTERRNG_M1) * c2[b];
+			old1 = c1[b];
+			old3 = c3[b];
+			c0[b] = static_cast<unsigned int>(product1 >> 32) ^ old1 ^ k0;
+			c2[b] = static_cast<unsigned int>(product0 >> 32) ^ old3 ^ k1;
+			c1[b] = static_cast<unsigned int>(product1);
+			c3[b] = static_cast<unsigned int>(product0);
+		}
+	}
+
+	for( size_t b = 0; b < nBlocks; ++b ) {
+		out[4 * b] = c0[b];
+		out[4 * b + 1] = c1[b];
+		out[4 * b + 2] = c2[b];
+		out[4 * b + 3] = c3[b];
+	}
+}
+
+void CounterRNG::generateBlocks(unsigned int* const out,
+	const unsigned int* const key0, const unsigned int* const key1,
+	const unsigned long long* const blockIndices, const size_t nBlocks) {
+
+	unsigned int c0[COUNTERRNG_BLOCKS_PER_BATCH];
+	unsigned int c1[COUNTERRNG_BLOCKS_PER_BATCH];
+	unsigned int c2[COUNTERRNG_BLOCKS_PER_BATCH];
+	unsigned int c3[COUNTERRNG_BLOCKS_PER_BATCH];
+	unsigned int k0[COUNTERRNG_BLOCKS_PER_BATCH];
+	unsigned int k1[COUNTERRNG_BLOCKS_PER_BATCH];
+	for( size_t b = 0; b < nBlocks; ++b ) {
+		c0[b] = static_cast<unsigned int>(blockIndices[b]);
+		c1[b] = static_cast<unsigned int>(blockIndices[b] >> 32);
+		c2[b] = 0;
+		c3[b] = 0;
+		k0[b] = key0[b];
+		k1[b] = key1[b];
+	}
+
+	unsigned long long product0, product1;
+	unsigned int old1, old3;
+	for( size_t round = 0; round < COUNTERRNG_N_ROUNDS; ++round ) {
+		for( size_t b = 0; b < nBlocks; ++b ) {
+			if( round > 0 ) {
+				k0[b] += COUNTERRNG_W0;
+				k1[b] += COUNTERRNG_W1;
+			}
+			product0 = static_cast<unsigned long long>(COUNTERRNG_M0) * c0[b];
+			product1 = static_cast<unsigned long long>(COUNTERRNG_M1) * c2[b];
+			old1 = c1[b];
+			old3 = c3[b];
+			c0[b] = static_cast<unsigned int>(product1 >> 32) ^ old1 ^ k0[b];
+			c2[b] = static_cast<unsigned int>(product0 >> 32) ^ old3 ^ k1[b];
+			c1[b] = static_cast<unsigned int>(product1);
+			c3[b] = static_cast<unsigned int>(product0);
+		}
+	}
+
+	for( size_t b = 0; b < nBlocks; ++b ) {
+		out[4 * b] = c0[b];
+		out[4 * b + 1] = c1[b];
+		out[4 * b + 2] = c2[b];
+		out[4 * b + 3] = c3[b];
+	}
+}
+
+void CounterRNG::nextBatch(unsigned int* const out, const size_t n) {
+	if( n == 0 ) {
+		return;
+	}
+	const unsigned long long firstBlock = m_drawIndex / 4;
+	const size_t offset = static_cast<size_t>(m_drawIndex % 4);
+	const size_t nBlocks = (offset + n + 3) / 4;
+	unsigned int values[4 * COUNTERRNG_BLOCKS_PER_BATCH];
+	generateBlocks(values, firstBlock, nBlocks);
+	for( size_t i = 0; i < n; ++i ) {
+		out[i] = values[offset + i];
+	}
+	m_drawIndex += n;
+}
+
+float CounterRNG::toUniform(const unsigned int value) {
+	// The upper 24 bits fit exactly in the significand of a float
+	return static_cast<float>(value >> 8) * (1.0f / 16777216.0f);
+}
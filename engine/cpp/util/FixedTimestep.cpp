@@ -0,0 +1,103 @@
+/*
+FixedTimestep.cpp
+-----------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Implementation of the FixedTimestep class
+*/
+
+#include <exception>
+#include "FixedTimestep.h"
+
+FixedTimestep::FixedTimestep(const DWORD stepInterval, const unsigned int maxStepsPerFrame) :
+	m_stepInterval(stepInterval), m_maxStepsPerFrame(maxStepsPerFrame),
+	m_stepDuration(engineTime::fromMilliseconds(stepInterval)),
+	m_accumulator(EngineDuration::zero()), m_simulationTime(0), m_stepCount(0),
+	m_frameStepCount(0), m_droppedTime(EngineDuration::zero())
+{
+	if( stepInterval == 0 ) {
+		throw std::exception("FixedTimestep step interval must be greater than zero.");
+	}
+	if( maxStepsPerFrame == 0 ) {
+		throw std::exception("FixedTimestep maximum number of steps per frame must be greater than zero.");
+	}
+	reset();
+}
+
+FixedTimestep::~FixedTimestep(void) {}
+
+void FixedTimestep::advance(const EngineDuration& frameInterval) {
+	if( frameInterval > EngineDuration::zero() ) {
+		m_accumulator += frameInterval;
+	}
+	m_frameStepCount = 0;
+}
+
+void FixedTimestep::advance(const DWORD frameInterval) {
+	advance(engineTime::fromMilliseconds(frameInterval));
+}
+
+bool FixedTimestep::nextStep(DWORD& currentTime) {
+	if( m_accumulator < m_stepDuration ) {
+		return false;
+	}
+
+	if( m_frameStepCount >= m_maxStepsPerFrame ) {
+		// Discard whole steps that cannot be taken, but keep the fractional part
+		const EngineDuration excess = m_accumulator - (m_accumulator % m_stepDuration);
+		m_droppedTime += excess;
+		m_accumulator -= excess;
+		return false;
+	}
+
+	currentTime = m_simulationTime;
+	m_simulationTime += m_stepInterval;
+	m_accumulator -= m_stepDuration;
+	++m_stepCount;
+	++m_frameStepCount;
+	return true;
+}
+
+float FixedTimestep::getInterpolationFactor(void) const {
+	return static_cast<float>(static_cast<double>((m_accumulator % m_stepDuration).count()) /
+		static_cast<double>(m_stepDuration.count()));
+}
+
+void FixedTimestep::reset(void) {
+	m_accumulator = m_stepDuration;
+	m_simulationTime = 0;
+	m_stepCount = 0;
+	m_frameStepCount = 0;
+	m_droppedTime = EngineDuration::zero();
+}
+
+DWORD FixedTimestep::getStepInterval(void) const {
+	return m_stepInterval;
+}
+
+unsigned int FixedTimestep::getMaxStepsPerFrame(void) const {
+	return m_maxStepsPerFrame;
+}
+
+DWORD FixedTimestep::getSimulationTime(void) const {
+	return m_simulationTime;
+}
+
+unsigned long FixedTimestep::getStepCount(void) const {
+	return m_stepCount;
+}
+
+unsigned int FixedTimestep::getFrameStepCount(void) const {
+	return m_frameStepCount;
+}
+
+DWORD FixedTimestep::getDroppedTime(void) const {
+	return engineTime::toMilliseconds(m_droppedTime);
+}
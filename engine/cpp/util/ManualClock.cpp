@@ -0,0 +1,43 @@
+/*
+ManualClock.cpp
+---------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Implementation of the ManualClock class
+*/
+
+#include "ManualClock.h"
+#include "defs.h"
+
+ManualClock::ManualClock(const EngineTime& start) :
+	IClock(), m_time(start)
+{}
+
+ManualClock::~ManualClock(void) {}
+
+EngineTime ManualClock::now(void) const {
+	return m_time;
+}
+
+HRESULT ManualClock::set(const EngineTime& time) {
+	if( time < m_time ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	m_time = time;
+	return ERROR_SUCCESS;
+}
+
+HRESULT ManualClock::advance(const EngineDuration& interval) {
+	if( interval < EngineDuration::zero() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	m_time += interval;
+	return ERROR_SUCCESS;
+}
@@ -0,0 +1,43 @@
+/*
+MonotonicClock.cpp
+------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Implementation of the MonotonicClock class
+*/
+
+#include <exception>
+#include "MonotonicClock.h"
+
+MonotonicClock::MonotonicClock(void) :
+	IClock(), m_start(0), m_frequency(0)
+{
+	LARGE_INTEGER value;
+	if( !QueryPerformanceFrequency(&value) || value.QuadPart <= 0 ) {
+		throw std::exception("MonotonicClock: The performance counter is not available.");
+	}
+	m_frequency = value.QuadPart;
+	QueryPerformanceCounter(&value);
+	m_start = value.QuadPart;
+}
+
+MonotonicClock::~MonotonicClock(void) {}
+
+EngineTime MonotonicClock::now(void) const {
+	LARGE_INTEGER value;
+	QueryPerformanceCounter(&value);
+	const LONGLONG ticks = value.QuadPart - m_start;
+
+	// Split the conversion to avoid overflow of (ticks * 10^9)
+	const LONGLONG seconds = ticks / m_frequency;
+	const LONGLONG remainder = ticks % m_frequency;
+	return EngineTime(EngineDuration(seconds * ENGINETIME_NANOSECS_PER_SEC +
+		(remainder * ENGINETIME_NANOSECS_PER_SEC) / m_frequency));
+}
@@ -0,0 +1,57 @@
+/*
+ScaledClock.cpp
+---------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Implementation of the ScaledClock class
+*/
+
+#include <exception>
+#include "ScaledClock.h"
+#include "defs.h"
+
+ScaledClock::ScaledClock(const IClock* const source, const double scale) :
+	IClock(), m_source(source), m_scale(scale), m_base(), m_sourceBase()
+{
+	if( source == 0 ) {
+		throw std::exception("ScaledClock: Null source clock.");
+	}
+	if( scale < 0.0 ) {
+		throw std::exception("ScaledClock: Negative time scale.");
+	}
+	m_sourceBase = m_source->now();
+}
+
+ScaledClock::~ScaledClock(void) {}
+
+EngineTime ScaledClock::now(void) const {
+	return timeAt(m_source->now());
+}
+
+EngineTime ScaledClock::timeAt(const EngineTime& sourceTime) const {
+	const EngineDuration sourceElapsed = sourceTime - m_sourceBase;
+	return m_base + EngineDuration(static_cast<long long>(static_cast<double>(sourceElapsed.count()) * m_scale));
+}
+
+HRESULT ScaledClock::setScale(const double scale) {
+	if( scale < 0.0 ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_INVALID_INPUT);
+	}
+	// Read the source clock once, so that no time is lost or gained
+	const EngineTime sourceTime = m_source->now();
+	m_base = timeAt(sourceTime);
+	m_sourceBase = sourceTime;
+	m_scale = scale;
+	return ERROR_SUCCESS;
+}
+
+double ScaledClock::getScale(void) const {
+	return m_scale;
+}
@@ -0,0 +1,99 @@
+/*
+SlabPool.cpp
+------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Implementation of the SlabPool class
+*/
+
+#include "SlabPool.h"
+#include <exception>
+
+SlabPool::SlabPool(const size_t blockSize, const size_t blocksPerSlab) :
+	m_blockSize(blockSize), m_blocksPerSlab(blocksPerSlab),
+	m_slabs(), m_freeList(0), m_telemetry(), m_mutex()
+{
+	if( m_blocksPerSlab == 0 ) {
+		throw std::exception("Cannot create a SlabPool with zero blocks per slab.");
+	}
+
+	// Each free block must be able to hold a pointer to the next free block
+	if( m_blockSize < sizeof(void*) ) {
+		m_blockSize = sizeof(void*);
+	}
+	m_blockSize = ((m_blockSize + SLABPOOL_ALIGNMENT - 1) / SLABPOOL_ALIGNMENT) * SLABPOOL_ALIGNMENT;
+
+	m_telemetry.nAllocations = 0;
+	m_telemetry.nDeallocations = 0;
+	m_telemetry.nLiveBlocks = 0;
+	m_telemetry.nPeakLiveBlocks = 0;
+	m_telemetry.nSlabs = 0;
+	m_telemetry.nReservedBytes = 0;
+}
+
+SlabPool::~SlabPool(void) {
+	for( size_t i = 0; i < m_slabs.size(); ++i ) {
+		delete[] m_slabs[i];
+	}
+}
+
+void* SlabPool::allocate(void) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if( m_freeList == 0 ) {
+		addSlab();
+	}
+	void* block = m_freeList;
+	m_freeList = *static_cast<void**>(block);
+
+	++m_telemetry.nAllocations;
+	++m_telemetry.nLiveBlocks;
+	if( m_telemetry.nLiveBlocks > m_telemetry.nPeakLiveBlocks ) {
+		m_telemetry.nPeakLiveBlocks = m_telemetry.nLiveBlocks;
+	}
+	return block;
+}
+
+void SlabPool::deallocate(void* const block) {
+	if( block == 0 ) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(m_mutex);
+	*static_cast<void**>(block) = m_freeList;
+	m_freeList = block;
+
+	++m_telemetry.nDeallocations;
+	--m_telemetry.nLiveBlocks;
+}
+
+size_t SlabPool::getBlockSize(void) const {
+	return m_blockSize;
+}
+
+void SlabPool::getTelemetry(Telemetry& telemetry) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	telemetry = m_telemetry;
+}
+
+void SlabPool::addSlab(void) {
+	const size_t slabSize = m_blockSize * m_blocksPerSlab;
+	char* slab = new char[slabSize];
+	m_slabs.push_back(slab);
+
+	// Thread the blocks onto the free list, in address order
+	char* block = slab + slabSize;
+	for( size_t i = 0; i < m_blocksPerSlab; ++i ) {
+		block -= m_blockSize;
+		*reinterpret_cast<void**>(block) = m_freeList;
+		m_freeList = block;
+	}
+
+	++m_telemetry.nSlabs;
+	m_telemetry.nReservedBytes += slabSize;
+}
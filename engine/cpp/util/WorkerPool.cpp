@@ -0,0 +1,121 @@
+/*
+WorkerPool.cpp
+--------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Implementation of the WorkerPool class
+*/
+
+#include "WorkerPool.h"
+#include "defs.h"
+
+WorkerPool::WorkerPool(const size_t nThreads) :
+	m_task(0), m_nTasks(0), m_nextTask(0),
+	m_nBusyWorkers(0), m_batch(0), m_quit(false)
+{
+	size_t nWorkers = nThreads;
+	if( nWorkers == 0 ) {
+		nWorkers = static_cast<size_t>(std::thread::hardware_concurrency());
+		if( nWorkers == 0 ) {
+			nWorkers = 1;
+		}
+	}
+
+	// The calling thread also executes tasks
+	--nWorkers;
+	for( size_t i = 0; i < nWorkers; ++i ) {
+		m_threads.push_back(std::thread(&WorkerPool::workerLoop, this));
+	}
+}
+
+WorkerPool::~WorkerPool(void) {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_quit = true;
+	}
+	m_startCondition.notify_all();
+	for( std::vector<std::thread>::size_type i = 0; i < m_threads.size(); ++i ) {
+		m_threads[i].join();
+	}
+}
+
+size_t WorkerPool::getNumberOfThreads(void) const {
+	return m_threads.size() + 1;
+}
+
+HRESULT WorkerPool::run(const size_t nTasks, const std::function<void(const size_t)>& task) {
+	if( !task ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NULL_INPUT);
+	}
+
+	// Avoid the cost of waking the worker threads when there is nothing to share
+	if( nTasks < 2 || m_threads.empty() ) {
+		for( size_t i = 0; i < nTasks; ++i ) {
+			task(i);
+		}
+		return ERROR_SUCCESS;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_task = &task;
+		m_nTasks = nTasks;
+		m_nextTask = 0;
+		m_nBusyWorkers = m_threads.size();
+		++m_batch;
+	}
+	m_startCondition.notify_all();
+
+	runTasks();
+
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while( m_nBusyWorkers > 0 ) {
+			m_doneCondition.wait(lock);
+		}
+		m_task = 0;
+		m_nTasks = 0;
+	}
+	return ERROR_SUCCESS;
+}
+
+void WorkerPool::workerLoop(void) {
+	unsigned long batch = 0;
+	while( true ) {
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			while( !m_quit && m_batch == batch ) {
+				m_startCondition.wait(lock);
+			}
+			if( m_quit ) {
+				return;
+			}
+			batch = m_batch;
+		}
+
+		runTasks();
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			--m_nBusyWorkers;
+			if( m_nBusyWorkers == 0 ) {
+				m_doneCondition.notify_one();
+			}
+		}
+	}
+}
+
+void WorkerPool::runTasks(void) {
+	size_t i = m_nextTask++;
+	while( i < m_nTasks ) {
+		(*m_task)(i);
+		i = m_nextTask++;
+	}
+}
@@ -23,6 +23,11 @@ Description:
 #include <DirectXMath.h>
 #include "ObjectModel.h"
 #include "Transformable.h"
+#include "TransformSystem.h"
+#include "TransformScheduler.h"
+#include "WorkerPool.h"
+#include "SpatialIndex.h"
+#include "SweepAndPrune.h"
 #include "State.h"
 #include "ConfigUser.h"
 #include "Camera.h"
@@ -69,6 +74,12 @@ Description:
 #define GAMESTATE_QUAD_ORIGIN_FIELD L"quadArrayOrigin"
 #define GAMESTATE_QUAD_ORIGIN_DEFAULT DirectX::XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f)
 
+/* Number of threads used to update Transformable objects.
+   Zero means one thread per hardware thread.
+ */
+#define GAMESTATE_N_TRANSFORM_THREADS_FIELD L"nTransformThreads"
+#define GAMESTATE_N_TRANSFORM_THREADS_DEFAULT 1
+
 // LogUser and ConfigUser configuration parameters
 // Refer to LogUser.h and ConfigUser.h
 #define GAMESTATE_LOGUSER_SCOPE			L"GameState_LogUser"
@@ -84,6 +95,12 @@ Description:
 
 #define GAMESTATE_CONFIGIO_CLASS FlatAtomicConfigIO
 
+/* Collision categories of objects in the broadphase.
+   Asteroids are not tested against each other.
+ */
+#define GAMESTATE_COLLISION_ASTEROID 0x1U
+#define GAMESTATE_COLLISION_PROJECTILE 0x2U
+
 class GameState : public State, public ConfigUser{
 
 	// Data members
@@ -92,6 +109,35 @@ protected:
 
 private:
 	std::vector<ObjectModel*>* m_objectList;
+
+	/* Storage and batch updates for the asteroid transformations,
+	   which are bound to this object.
+	 */
+	TransformSystem* m_transformSystem;
+
+	/* Updates the quad parents and the Transformables of all objects
+	   in parent-before-child order, using 'm_workerPool' if it is not null.
+	 */
+	TransformScheduler* m_transformScheduler;
+	WorkerPool* m_workerPool;
+	size_t m_nTransformThreads;
+
+	/* Number of Transformable objects, during the last call to update(),
+	   which did not need to recompute their world transforms
+	 */
+	size_t m_nSkippedTransformUpdates;
+
+	/* Bounding spheres of the asteroids, for ray casts
+	   and proximity queries. Updated after the Transformables.
+	 */
+	SpatialIndex* m_spatialIndex;
+
+	/* Finds overlapping pairs among the asteroids
+	   and other objects added by derived classes.
+	   Updated after the Transformables.
+	 */
+	SweepAndPrune* m_broadphase;
+
 	GridSphereTextured* m_asteroid;
 	GridQuadTextured** m_gridQuads;
 	Transformable** m_gridQuadParents;
@@ -126,6 +172,18 @@ public:
 
 	virtual HRESULT poll(Keyboard& input, Mouse& mouse) override;
 
+	/* Returns the number of Transformable objects, during the last frame,
+	   which did not need to recompute their world transforms
+	   (see Transformable::wasUpdateSkipped()).
+	 */
+	size_t getNumberOfSkippedTransformUpdates(void) const;
+
+	/* Returns the index of asteroid bounding spheres,
+	   which is current as of the last call to update(),
+	   or null if this object has not been initialized.
+	 */
+	const SpatialIndex* getSpatialIndex(void) const;
+
 protected:
 
 	/* Retrieves configuration data, or sets default values
@@ -153,4 +211,22 @@ protected:
 	virtual HRESULT spawnAsteroidsGrid(const size_t x, const size_t y, const size_t z);
 
 	virtual HRESULT spawnQuadRow(const float width, const float height, const DirectX::XMFLOAT4& origin, const DirectX::XMFLOAT4& spacing);
+
+	/* Gives all Transformable objects to the TransformScheduler.
+	   Called after all objects have been created.
+	 */
+	virtual HRESULT scheduleTransformables(void);
+
+	/* Returns the collision broadphase, so that derived classes
+	   can add their own objects, and respond to collision events,
+	   or null if this object has not been initialized.
+	 */
+	SweepAndPrune* getBroadphase(void);
+
+	/* Returns the threads used to update Transformable objects, so that
+	   derived classes can use them for other work between frames,
+	   or null if updates are single-threaded, or if this object
+	   has not been initialized. The pool remains owned by this object.
+	 */
+	WorkerPool* getWorkerPool(void);
 };
\ No newline at end of file
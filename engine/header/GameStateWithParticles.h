@@ -22,9 +22,16 @@ Description
 #include "UniformBurstSphere.h"
 #include "RandomBurstCone.h"
 #include "WanderingLineSpline.h"
+#include "WanderingLineSystem.h"
 #include "UniformRandomSplineModel.h"
 #include "HomingTransformable.h"
+#include "ParticleInstanceBatcher.h"
+#include "D3D11ParticleDrawBackend.h"
+#include "SlotMap.h"
+#include "SplineBuffer.h"
 #include <vector>
+#include <map>
+#include <unordered_map>
 
 // Logging message prefix
 #define GAMESTATEWITHPARTICLES_START_MSG_PREFIX L"GameStateWithParticles"
@@ -126,8 +133,40 @@ Description
 #define GAMESTATEWITHPARTICLES_BALL_LOOP_DEFAULT false
 #define GAMESTATEWITHPARTICLES_BALL_LOOP_FIELD L"ball_loopOverSpline"
 
+/* If true, ball lightning effects move along their splines
+   at a constant speed, using arc length parameterization
+ */
+#define GAMESTATEWITHPARTICLES_BALL_CONSTANTSPEED_DEFAULT false
+#define GAMESTATEWITHPARTICLES_BALL_CONSTANTSPEED_FIELD L"ball_constantSpeed"
+
 #define GAMESTATEWITHPARTICLES_BALL_MODELCLASS RandomBurstCone
 
+/* Radius of the bounding spheres of ball lightning effects
+   in the collision broadphase
+ */
+#define GAMESTATEWITHPARTICLES_BALL_COLLISION_RADIUS 1.0f
+
+/* If true, all explosions, jets and ball lightning effects sharing a model
+   are drawn with one instanced draw call, rather than one draw call each.
+   Instancing is disabled if it fails (e.g. if the renderer
+   has no instanced vertex shader).
+ */
+#define GAMESTATEWITHPARTICLES_INSTANCED_DEFAULT true
+#define GAMESTATEWITHPARTICLES_INSTANCED_FIELD L"instancedParticles"
+
+/* Number of particle systems of each type (explosions, jets, lasers
+   and ball lightning effects) for which storage is allocated at once
+ */
+#define GAMESTATEWITHPARTICLES_POOLSIZE_MIN 1
+#define GAMESTATEWITHPARTICLES_POOLSIZE_DEFAULT 64
+#define GAMESTATEWITHPARTICLES_POOLSIZE_FIELD L"particleSystemPoolSize"
+
+// Indices of the models drawn with instancing
+#define GAMESTATEWITHPARTICLES_MODEL_EXPLOSION 0
+#define GAMESTATEWITHPARTICLES_MODEL_JET 1
+#define GAMESTATEWITHPARTICLES_MODEL_BALL 2
+#define GAMESTATEWITHPARTICLES_NMODELS 3
+
 /* If true, a continual fireworks show will be produced. */
 #define GAMESTATEWITHPARTICLES_DEMO_FIELD L"demoMode"
 #define GAMESTATEWITHPARTICLES_DEMO_DEFAULT false
@@ -209,6 +248,11 @@ private:
 		HRESULT update(const DWORD currentTime, const DWORD updateTimeInterval, bool& isExpired, const bool isDemo = false);
 		HRESULT drawUsingAppropriateRenderer(ID3D11DeviceContext* const context, GeometryRendererManager& manager, const Camera* const camera);
 
+		/* Queues the particle system for drawing with the model
+		   at index 'model', instead of calling drawUsingAppropriateRenderer()
+		 */
+		HRESULT addToBatch(ParticleInstanceBatcher& batcher, const size_t model) const;
+
 		Transformable* getTransform(void);
 
 		// Currently not implemented - will cause linker errors if called
@@ -228,8 +272,21 @@ private:
 		// Assumed to be owned by this object
 		Spline* m_spline;
 
+		/* Control point buffer for the spline, used only by this object,
+		   so that only the segments which change are uploaded each frame
+		 */
+		SplineBuffer* m_splineBuffer;
+
+		// Shared - Receives 'm_splineBuffer' when this object is destroyed
+		std::vector<SplineBuffer*>* m_freeSplineBuffers;
+
 	public:
-		ActiveSplineParticles(T* particles, Transformable* transform, Spline* spline, DWORD lifespan, DWORD currentTime, const DirectX::XMFLOAT3& colorCast);
+		/* 'freeSplineBuffers' must have enough capacity
+		   to receive 'splineBuffer' without reallocating.
+		 */
+		ActiveSplineParticles(T* particles, Transformable* transform, Spline* spline,
+			SplineBuffer* splineBuffer, std::vector<SplineBuffer*>* freeSplineBuffers,
+			DWORD lifespan, DWORD currentTime, const DirectX::XMFLOAT3& colorCast);
 		~ActiveSplineParticles(void);
 
 		/* The object will update its Spline regardless
@@ -246,6 +303,12 @@ private:
 		ActiveSplineParticles& operator=(const ActiveSplineParticles& other);
 	};
 
+private:
+	/* Handles of particle systems, looked up by the transformations
+	   with which they are removed
+	 */
+	typedef std::unordered_multimap<const Transformable*, SlotMapHandle> ParticleSystemIndex;
+
 	// Data members
 private:
 
@@ -253,29 +316,62 @@ private:
 	UniformBurstSphere* m_explosionModel;
 
 	// Keeps track of the positions at which to render explosions
-	std::vector<ActiveParticles<UniformBurstSphere>*>* m_explosions;
+	SlotMap<ActiveParticles<UniformBurstSphere> >* m_explosions;
+	ParticleSystemIndex m_explosionIndex; // By transformation
 
 	// The model for all jets
 	RandomBurstCone* m_jetModel;
 
 	// Keeps track of the positions at which to render jets
-	std::vector<ActiveParticles<RandomBurstCone>*>* m_jets;
+	SlotMap<ActiveParticles<RandomBurstCone> >* m_jets;
+	ParticleSystemIndex m_jetIndex; // By transformation
 
 	// The model for all lasers
 	UniformRandomSplineModel* m_laserModel;
 
 	// Keeps track of the positions at which to render lasers
-	std::vector<ActiveSplineParticles<UniformRandomSplineModel>*>* m_lasers;
+	SlotMap<ActiveSplineParticles<UniformRandomSplineModel> >* m_lasers;
+	ParticleSystemIndex m_laserIndex; // By start transformation
+
+	/* Spline control point buffers which are not in use by lasers,
+	   and the total number of buffers created
+	 */
+	std::vector<SplineBuffer*> m_freeSplineBuffers;
+	size_t m_nSplineBuffers;
 
 	// The model for all ball lightning effects
 	GAMESTATEWITHPARTICLES_BALL_MODELCLASS* m_ballModel;
 
 	// Keeps track of the positions at which to render ball lightning effects
-	std::vector<ActiveParticles<GAMESTATEWITHPARTICLES_BALL_MODELCLASS>*>* m_balls;
+	SlotMap<ActiveParticles<GAMESTATEWITHPARTICLES_BALL_MODELCLASS> >* m_balls;
+	ParticleSystemIndex m_ballIndex; // By transformation
+	ParticleSystemIndex m_ballEndpointIndex; // By end transformation
+
+	/* Number of particle systems of each type
+	   for which storage is allocated at once
+	 */
+	size_t m_poolSize;
+
+	/* Identifiers of the transformations of ball lightning effects
+	   in the collision broadphase
+	 */
+	std::map<const Transformable*, size_t> m_ballColliders;
+
+	/* Used to draw explosions, jets and ball lightning effects
+	   if 'm_instancedParticles' is true
+	 */
+	bool m_instancedParticles;
+	ParticleInstanceBatcher* m_particleBatcher;
+	D3D11ParticleDrawBackend* m_particleBackend;
 
 	// Prevents double-transformation of lasers
 	Transformable* m_identity;
 
+	/* Simulates the knots of the splines of all lasers together.
+	   Must be deleted after all lasers.
+	 */
+	WanderingLineSystem* m_laserKnots;
+
 	/* Set globally for all explosions based on configuration data */
 	DWORD m_explosionLifespan;
 
@@ -299,6 +395,7 @@ private:
 	float m_ballSplineParameterSpeed;
 	float m_ballSplineParameterOffset;
 	bool m_ballLoopOverSpline;
+	bool m_ballConstantSpeed;
 
 	DWORD m_currentTime;
 
@@ -356,8 +453,8 @@ public:
 	   If calling this function from within this class while iterating
 	   over 'm_explosions', be sure to iterate backwards,
 	   as this function may result in the deletion of an element
-	   in 'm_explosions', followed by the shifting of remaining
-	   elements to lower indices.
+	   in 'm_explosions', followed by the moving of the last
+	   element in 'm_explosions' into its index.
 	 */
 	virtual HRESULT removeExplosion(Transformable* const transform);
 
@@ -369,8 +466,8 @@ public:
 	   If calling this function from within this class while iterating
 	   over 'm_jets', be sure to iterate backwards,
 	   as this function may result in the deletion of an element
-	   in 'm_jets', followed by the shifting of remaining
-	   elements to lower indices.
+	   in 'm_jets', followed by the moving of the last
+	   element in 'm_jets' into its index.
 	*/
 	virtual HRESULT removeJet(Transformable* const transform);
 
@@ -382,8 +479,8 @@ public:
 	   If calling this function from within this class while iterating
 	   over 'm_lasers', be sure to iterate backwards,
 	   as this function may result in the deletion of an element
-	   in 'm_lasers', followed by the shifting of remaining
-	   elements to lower indices.
+	   in 'm_lasers', followed by the moving of the last
+	   element in 'm_lasers' into its index.
 	 */
 	virtual HRESULT removeLaser(Transformable* const startTransform);
 
@@ -395,8 +492,8 @@ public:
 	   If calling this function from within this class while iterating
 	   over 'm_balls', be sure to iterate backwards,
 	   as this function will result in the deletion of an element
-	   in 'm_balls', followed by the shifting of remaining
-	   elements to lower indices.
+	   in 'm_balls', followed by the moving of the last
+	   element in 'm_balls' into its index.
 
 	   If no ball lightning effect is found with the given transformation,
 	   this function returns a failure result and does nothing.
@@ -410,8 +507,8 @@ public:
 	   If calling this function from within this class while iterating
 	   over 'm_balls', be sure to iterate backwards,
 	   as this function may result in the deletion of an element
-	   in 'm_balls', followed by the shifting of remaining
-	   elements to lower indices.
+	   in 'm_balls', followed by the moving of the last
+	   element in 'm_balls' into its index.
 
 	   Tip: This function is useful to prevent errors resulting from
 	        the deletion of the target of a ball lightning effect
@@ -436,6 +533,32 @@ protected:
 protected:
 	virtual HRESULT initializeParticles(ID3D11Device* device);
 
+	// Particle system storage helpers
+private:
+	/* Removes the particle system with the given handle from 'systems',
+	   and its entry under 'key' from 'index'
+	 */
+	template <typename T> static void eraseSystem(SlotMap<T>& systems, ParticleSystemIndex& index,
+		const Transformable* const key, const SlotMapHandle& handle);
+
+	/* Removes all particle systems with entries under 'key' in 'index',
+	   and their entries. Returns the number of particle systems removed.
+	 */
+	template <typename T> static size_t eraseSystems(SlotMap<T>& systems, ParticleSystemIndex& index,
+		const Transformable* const key);
+
+	// Removes the entry for the given handle under 'key' from 'index', if it exists
+	static void eraseIndexEntry(ParticleSystemIndex& index, const Transformable* const key, const SlotMapHandle& handle);
+
+	// Rendering helpers
+protected:
+	/* Draws all explosions, jets and ball lightning effects
+	   with one instanced draw call per model.
+	   'drawingStarted' is set to true if any particle systems
+	   may have been drawn, even if a failure result is returned.
+	 */
+	virtual HRESULT drawInstancedParticles(ID3D11DeviceContext* const context, GeometryRendererManager& manager, bool& drawingStarted);
+
 protected:
 
 	/* Assumes demo mode is active ('m_demo_enabled' is true),
@@ -445,6 +568,11 @@ protected:
 	 */
 	virtual HRESULT updateDemo(void);
 
+	/* Removes the transformation of a ball lightning effect
+	   from the collision broadphase, if it was added
+	 */
+	void removeBallCollider(const Transformable* const transform);
+
 	/* Used only in demo mode */
 	Transformable* m_demoStartLaser;
 	Transformable* m_demoEndLaser;
@@ -510,6 +638,21 @@ template <typename T> HRESULT GameStateWithParticles::ActiveParticles<T>::drawUs
 	return ERROR_SUCCESS;
 }
 
+template <typename T> HRESULT GameStateWithParticles::ActiveParticles<T>::addToBatch(ParticleInstanceBatcher& batcher, const size_t model) const {
+	DirectX::XMFLOAT4X4 world;
+	if( FAILED(m_transform->getWorldTransform(world)) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+
+	ParticleInstanceType instance;
+	ParticleInstanceBatcher::makeInstance(instance, world, m_time, m_colorCast);
+	if( FAILED(batcher.add(model, instance)) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+
+	return ERROR_SUCCESS;
+}
+
 template <typename T> Transformable* GameStateWithParticles::ActiveParticles<T>::getTransform(void) {
 	return m_transform;
 }
@@ -519,9 +662,10 @@ template <typename T> Transformable* GameStateWithParticles::ActiveParticles<T>:
    ------------------------------------------
 */
 template <typename T> GameStateWithParticles::ActiveSplineParticles<T>::ActiveSplineParticles(T* particles, Transformable* transform,
-	Spline* spline, DWORD lifespan, DWORD currentTime, const DirectX::XMFLOAT3& colorCast) :
+	Spline* spline, SplineBuffer* splineBuffer, std::vector<SplineBuffer*>* freeSplineBuffers,
+	DWORD lifespan, DWORD currentTime, const DirectX::XMFLOAT3& colorCast) :
 	ActiveParticles(particles, transform, lifespan, currentTime, colorCast),
-	m_spline(spline)
+	m_spline(spline), m_splineBuffer(splineBuffer), m_freeSplineBuffers(freeSplineBuffers)
 {}
 
 template <typename T> GameStateWithParticles::ActiveSplineParticles<T>::~ActiveSplineParticles(void) {
@@ -529,6 +673,10 @@ template <typename T> GameStateWithParticles::ActiveSplineParticles<T>::~ActiveS
 		delete m_spline;
 		m_spline = 0;
 	}
+	if( m_splineBuffer != 0 ) {
+		m_freeSplineBuffers->push_back(m_splineBuffer);
+		m_splineBuffer = 0;
+	}
 }
 
 template <typename T> HRESULT GameStateWithParticles::ActiveSplineParticles<T>::update(const DWORD currentTime, const DWORD updateTimeInterval, bool& isExpired, const bool isDemo) {
@@ -547,7 +695,7 @@ template <typename T> HRESULT GameStateWithParticles::ActiveSplineParticles<T>::
 template <typename T> HRESULT GameStateWithParticles::ActiveSplineParticles<T>::drawUsingAppropriateRenderer(ID3D11DeviceContext* const context, GeometryRendererManager& manager, const Camera* const camera) {
 
 	// Set the appropriate spline
-	if( FAILED(m_particles->setSpline(m_spline)) ) {
+	if( FAILED(m_particles->setSpline(m_spline, m_splineBuffer)) ) {
 		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
 	}
 
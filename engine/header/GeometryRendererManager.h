@@ -179,6 +179,22 @@ public:
 		GeometryRendererType rendererType
 		);
 
+	/* Render 'nInstances' copies of the specified particle geometry,
+	   using the renderer stored under the given GeometryRendererType
+	   enumeration constant, with per-system state read from 'instances'.
+
+	   Returns failure results in the same cases as render(),
+	   and also if the renderer does not support instancing.
+	*/
+	HRESULT renderInstanced(
+		ID3D11DeviceContext* const context,
+		const IGeometry& geometry,
+		const Camera* const camera,
+		GeometryRendererType rendererType,
+		const ParticleInstanceType* const instances,
+		const size_t nInstances
+		);
+
 	// Currently not implemented - will cause linker errors if called
 private:
 	GeometryRendererManager(const GeometryRendererManager& other);
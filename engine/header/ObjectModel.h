@@ -17,8 +17,13 @@ class ObjectModel : public LogUser {
 		ObjectModel(IGeometry* geometry);
 		virtual ~ObjectModel(void);
 
-		virtual HRESULT updateContainedTransforms(const DWORD currentTime, const DWORD updateTimeInterval);
+		/* If 'nSkipped' is not null, it will be incremented by the number
+		   of Transformable objects which did not need to recompute
+		   their world transforms (see Transformable::wasUpdateSkipped()).
+		 */
+		virtual HRESULT updateContainedTransforms(const DWORD currentTime, const DWORD updateTimeInterval, size_t* const nSkipped = 0);
 		virtual HRESULT addTransformable(Transformable*);
+		virtual const std::vector<Transformable*>* getTransformables(void) const;
 		virtual HRESULT draw(ID3D11DeviceContext* const context, GeometryRendererManager& manager, Camera * camera);
 
 	protected:
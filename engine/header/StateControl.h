@@ -37,12 +37,26 @@ Description
 #include "d3dclass.h"
 #include "GeometryRendererManager.h"
 #include "LogUser.h"
+#include "FixedTimestep.h"
+#include "MonotonicClock.h"
+#include "ScaledClock.h"
 
 // Logging message prefix
 #define STATECONTROL_START_MSG_PREFIX L"StateControl "
 
 #define STATECONTROL_WINDOW_TITLE L"COMP3501A Project: BK, BL, MW"
 
+/* Length of a simulation step [milliseconds],
+   and the maximum number of steps per frame
+ */
+#define STATECONTROL_STEP_INTERVAL FIXEDTIMESTEP_STEP_INTERVAL_DEFAULT
+#define STATECONTROL_MAX_STEPS_PER_FRAME FIXEDTIMESTEP_MAX_STEPS_DEFAULT
+
+/* Rate of simulation time relative to real time
+   (less than one for slow motion)
+ */
+#define STATECONTROL_TIME_SCALE 1.0
+
 class StateControl : public LogUser
 {
 	// Data members
@@ -54,6 +68,18 @@ private:
 	GeometryRendererManager* m_GeometryRendererManager;
 	State* m_CurrentState;
 
+	// Divides frame time into fixed simulation steps
+	FixedTimestep* m_Timestep;
+
+	/* Real time, and the scaled time which drives the simulation.
+	   Both clocks start when the Run() loop starts.
+	 */
+	MonotonicClock* m_RealClock;
+	ScaledClock* m_Clock;
+
+	// Time, according to 'm_Clock', at which the previous frame started
+	EngineTime m_LastFrameTime;
+
 public:
 	StateControl(void);
 	virtual ~StateControl(void);
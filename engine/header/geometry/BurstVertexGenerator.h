@@ -0,0 +1,133 @@
+/*
+BurstVertexGenerator.h
+----------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: UniformBurstSphere.cpp, RandomBurstCone.cpp
+  and TransformScheduler.h
+
+Description
+  -Generates the grids of particle vertices of UniformBurstSphere
+     and RandomBurstCone objects (excluding the pole particles).
+  -The vertex range is split into chunks of consecutive vertices,
+     which are the units of work given to the threads of a WorkerPool.
+  -Sphere vertices lie on a grid of rows and columns, so the sines
+     and cosines of the angles of each row and column are computed once,
+     rather than for every vertex.
+  -Cone vertices are generated from the same CounterRNG sequence
+     as RandomBurstCone::addVertices() used previously: For row 'i',
+     one 'v' value is followed by a 'u' and a 'w' value for each column,
+     starting at draw index 'i * (1 + 2 * nColumns)'. Each chunk
+     draws its values from a copy of the generator, starting
+     at the draw index of its first vertex.
+  -The sines and cosines of the cone vertices' azimuthal angles
+     are computed four at a time, using DirectXMath vector functions.
+
+Notes
+  -Each vertex is a function of its grid location and random values only,
+     so the output is the same for any number of threads and any chunk size.
+  -Vectorized sines and cosines can differ in the last bits from
+     the values returned by XMScalarSinCos(). Cone vertices are therefore
+     not bitwise-identical to those produced by coneVertex().
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <DirectXMath.h>
+#include "vertexTypes.h"
+#include "CounterRNG.h"
+#include "WorkerPool.h"
+
+// Default number of vertices in each unit of parallel work
+#define BURSTVERTEXGENERATOR_CHUNK_SIZE_DEFAULT 1024
+
+class BurstVertexGenerator {
+
+public:
+	// Parameters shared by spheres and cones
+	struct Parameters {
+		size_t nColumns;
+		size_t nRows;
+
+		// (width, height, spin)
+		DirectX::XMFLOAT3 billboard;
+
+		float linearSpeed;
+
+		// (creation time offset, life amount, decay, death cutoff)
+		DirectX::XMFLOAT4 life;
+
+		DirectX::XMFLOAT4 colorCast;
+
+		// If true, particle indices are set to (u, v, 1, 1) instead of 'colorCast'
+		bool debugColorCasts;
+	};
+
+	// Additional parameters of cones
+	struct ConeParameters {
+		float maxPhi;
+		float minR;
+		float maxR;
+	};
+
+public:
+	/* 'pool' is not deleted by this object, and can be shared
+	   with other objects. If 'pool' is null, all vertices are generated
+	   on the calling thread.
+	 */
+	BurstVertexGenerator(WorkerPool* const pool = 0,
+		const size_t chunkSize = BURSTVERTEXGENERATOR_CHUNK_SIZE_DEFAULT);
+
+	virtual ~BurstVertexGenerator(void);
+
+	/* Outputs the 'parameters.nRows * parameters.nColumns' grid vertices
+	   of a UniformBurstSphere, in row-major order
+	 */
+	HRESULT sphere(ParticleVertexType* const vertices, const Parameters& parameters);
+
+	/* Outputs the 'parameters.nRows * parameters.nColumns' grid vertices
+	   of a RandomBurstCone, in row-major order, using random values from
+	   the sequence of 'rng' (starting at draw index zero).
+	   'rng' itself is not modified.
+	 */
+	HRESULT cone(ParticleVertexType* const vertices, const Parameters& parameters,
+		const ConeParameters& coneParameters, const CounterRNG& rng);
+
+	/* Single-vertex versions, computing the vertex at surface parameters
+	   'u' and 'v' (and radius parameter 'w'), all in the range [0,1].
+	   These are the mappings used by UniformBurstSphere::uvToPosition()
+	   and RandomBurstCone::uvwToPosition(), and so on.
+	 */
+	static void sphereVertex(ParticleVertexType& vertex, const Parameters& parameters,
+		const float u, const float v);
+	static void coneVertex(ParticleVertexType& vertex, const Parameters& parameters,
+		const ConeParameters& coneParameters, const float u, const float v, const float w);
+
+	// Initial positions of sphere and cone vertices
+	static void spherePosition(DirectX::XMFLOAT3& position, const float u, const float v);
+	static void conePosition(DirectX::XMFLOAT3& position, const ConeParameters& coneParameters,
+		const float u, const float v, const float w);
+
+	size_t getChunkSize(void) const;
+
+protected:
+	/* Executes 'task' for each chunk of 'nVertices' vertices,
+	   passing the index of the first vertex, and the number of vertices, in the chunk
+	 */
+	HRESULT runChunks(const size_t nVertices, const std::function<void(const size_t, const size_t)>& task);
+
+	// Data members
+private:
+	WorkerPool* m_pool;
+	size_t m_chunkSize;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	BurstVertexGenerator(const BurstVertexGenerator& other);
+	BurstVertexGenerator& operator=(const BurstVertexGenerator& other);
+};
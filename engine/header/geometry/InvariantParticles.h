@@ -17,6 +17,10 @@ Primary basis: "SkinnedColorGeometry.h"
 Description
   -Stores non-indexed point vertices representing particles
   -Material properties are set up for ambient lighting only
+  -Optionally draws fewer particles when the particle system
+     is small on screen (see ParticleLOD.h). Level of detail
+     is only used by derived classes which override getLODRadius(),
+     and which place vertices in a progressive order.
 */
 
 #pragma once
@@ -27,6 +31,8 @@ Description
 #include "IGeometry.h"
 #include "ConfigUser.h"
 #include "Transformable.h"
+#include "ParticleLOD.h"
+#include <vector>
 
 #define INVARIANTPARTICLES_VERTEX_TYPE ParticleVertexType
 
@@ -50,6 +56,17 @@ Description
 #define INVARIANTPARTICLES_BLEND_DEFAULT 1.0f
 #define INVARIANTPARTICLES_BLEND_FIELD L"transparencyMultiplier"
 
+/* Level of detail
+   Default parameter values are defined in ParticleLOD.h
+ */
+#define INVARIANTPARTICLES_LOD_FLAG_DEFAULT false
+#define INVARIANTPARTICLES_LOD_FLAG_FIELD L"levelOfDetail"
+#define INVARIANTPARTICLES_LOD_FULL_DETAIL_SIZE_FIELD L"lodFullDetailSize"
+#define INVARIANTPARTICLES_LOD_LEVELS_FIELD L"lodLevels"
+#define INVARIANTPARTICLES_LOD_SIZE_COMPENSATION_FIELD L"lodSizeCompensation"
+#define INVARIANTPARTICLES_LOD_ALPHA_COMPENSATION_FIELD L"lodAlphaCompensation"
+#define INVARIANTPARTICLES_LOD_MAX_ALPHA_SCALE_FIELD L"lodMaxAlphaScale"
+
 class InvariantParticles : public IGeometry, public ConfigUser {
 
 public:
@@ -169,6 +186,19 @@ public:
 
 	virtual HRESULT drawUsingAppropriateRenderer(ID3D11DeviceContext* const context, GeometryRendererManager& manager, const Camera* const camera) override;
 
+	/* Draws 'nInstances' copies of this model, with the world transformations,
+	   times and colour casts in 'instances', rather than those set
+	   with setTransformable(), setTime() and setColorCast().
+	   Fails if the renderer does not support instancing.
+
+	   If level of detail is enabled, instances are grouped by level of detail,
+	   with one call to the renderer per level, and the 'z' and 'w' components
+	   of their times are replaced by the level's compensation factors
+	   (see getLODCompensation()).
+	 */
+	virtual HRESULT drawInstancedUsingAppropriateRenderer(ID3D11DeviceContext* const context, GeometryRendererManager& manager, const Camera* const camera,
+		const ParticleInstanceType* const instances, const size_t nInstances);
+
 	/* Allows for changing the position, motion, etc., of the model
 	   in the world.
 	*/
@@ -193,6 +223,18 @@ public:
 	// Number of particles
 	size_t getVertexCount(void) const;
 
+	/* Number of particles to draw, from the start of the vertex buffer,
+	   as chosen by level of detail selection during the current draw call.
+	   Equal to getVertexCount() if level of detail is disabled.
+	 */
+	size_t getDrawVertexCount(void) const;
+
+	/* (billboard size multiplier, transparency multiplier)
+	   compensating for the particles omitted during the current draw call.
+	   (1, 1) if level of detail is disabled.
+	 */
+	DirectX::XMFLOAT2 getLODCompensation(void) const;
+
 	virtual float getTransparencyBlendFactor(void) const;
 
 	const Material* getMaterial(void) const;
@@ -207,6 +249,22 @@ protected:
 	*/
 	virtual HRESULT setVerticesOnContext(ID3D11DeviceContext* const context);
 
+	/* Returns the radius of a sphere, centred at the origin of model space,
+	   enclosing all particles at the given time (currentTimeOffset),
+	   or zero if it is unknown, in which case all particles are drawn.
+	 */
+	virtual float getLODRadius(const float time) const;
+
+	/* Chooses the level of detail for drawing this model
+	   with the given world transformation and time, as seen by the camera
+	   with the given view and projection transformations
+	 */
+	void selectLOD(ParticleLOD::Selection& selection, const DirectX::XMFLOAT4X4& world, const float time,
+		const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection) const;
+
+	// Sets the values returned by getDrawVertexCount() and getLODCompensation()
+	void setLOD(const ParticleLOD::Selection& selection);
+
 	/* Functions deemed useful for derived classes to provide,
 	   used to support building models composed of
 	   multiple parts.
@@ -254,6 +312,18 @@ private:
 
 	DirectX::XMFLOAT3 m_colorCast;
 
+	// Null if level of detail is disabled
+	ParticleLOD* m_lod;
+
+	// Refer to getDrawVertexCount() and getLODCompensation()
+	size_t m_drawVertexCount;
+	DirectX::XMFLOAT2 m_lodCompensation;
+
+	/* Instances of each level of detail,
+	   filled during drawInstancedUsingAppropriateRenderer()
+	 */
+	std::vector<std::vector<ParticleInstanceType> > m_lodInstances;
+
 protected:
 	const Transformable* m_transform; // Shared - not deleted by the destructor
 
@@ -303,7 +373,10 @@ template<typename ConfigIOClass> InvariantParticles::InvariantParticles(
 	m_rendererType(0),
 	m_renderLighting(INVARIANTPARTICLES_USE_LIGHTING_FLAG_DEFAULT),
 	m_time(XMFLOAT2(0.0f, 0.0f)),
-	m_colorCast(XMFLOAT3(0.0f, 0.0f, 0.0f)) {}
+	m_colorCast(XMFLOAT3(0.0f, 0.0f, 0.0f)),
+	m_lod(0), m_drawVertexCount(0),
+	m_lodCompensation(XMFLOAT2(1.0f, 1.0f)),
+	m_lodInstances() {}
 
 template<typename ConfigIOClass> InvariantParticles::InvariantParticles(
 	const bool enableLogging, const std::wstring& msgPrefix,
@@ -326,4 +399,7 @@ template<typename ConfigIOClass> InvariantParticles::InvariantParticles(
 	m_rendererType(0),
 	m_renderLighting(INVARIANTPARTICLES_USE_LIGHTING_FLAG_DEFAULT),
 	m_time(XMFLOAT2(0.0f, 0.0f)),
-	m_colorCast(XMFLOAT3(0.0f, 0.0f, 0.0f)) {}
\ No newline at end of file
+	m_colorCast(XMFLOAT3(0.0f, 0.0f, 0.0f)),
+	m_lod(0), m_drawVertexCount(0),
+	m_lodCompensation(XMFLOAT2(1.0f, 1.0f)),
+	m_lodInstances() {}
\ No newline at end of file
@@ -123,6 +123,8 @@ public:
 	virtual ~InvariantTexturedParticles(void);
 
 	virtual HRESULT drawUsingAppropriateRenderer(ID3D11DeviceContext* const context, GeometryRendererManager& manager, const Camera* const camera) override;
+	virtual HRESULT drawInstancedUsingAppropriateRenderer(ID3D11DeviceContext* const context, GeometryRendererManager& manager, const Camera* const camera,
+		const ParticleInstanceType* const instances, const size_t nInstances) override;
 
 protected:
 	/* Performs texture-related pipeline configuration */
@@ -0,0 +1,189 @@
+/*
+ParticleKernels.h
+-----------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: generalParticlesVS.hlsl, splineParticlesVS.hlsl,
+  and TransformSystem.h
+
+Description
+  -CPU implementations of the particle vertex shaders, for testing,
+     profiling and headless simulation of particle systems
+  -Each shader has a scalar reference version, which follows the HLSL code
+     statement by statement, and a version which processes arrays of particles
+     four at a time, using DirectXMath vector operations.
+     The two versions produce bitwise-identical results.
+  -The shader constants are supplied in the same form as the
+     'Globals' constant buffer, and can be obtained from the same
+     geometry accessors used by InvariantParticlesRenderer (see getGlobals()).
+  -The spline particle kernels read control points from a buffer with the
+     layout written by SplineUploader (as used by SplineParticles),
+     so that the packing of the buffer and the evaluation of the spline
+     can be tested together.
+
+Notes
+  -The HLSL '%' operator on floats is reproduced as compiled by fxc:
+     a % b = b * (frac(|a/b|), negated if a/b is negative),
+     which differs slightly from fmod().
+  -Products and sums are evaluated in the order written in the HLSL code,
+     without fused multiply-add operations, so that the vectorized
+     versions match the scalar versions exactly. Results can still differ
+     from those of the GPU in the last few bits, depending on how
+     the driver orders matrix-vector products.
+  -The matrices passed to these functions are not transposed
+     (unlike the copies placed in constant buffers), so the
+     HLSL expression mul(v, M) corresponds to XMVector4Transform(v, M).
+  -In splineParticlesVS.hlsl, pow(x, 2) and pow(x, 3) are expanded
+     by fxc into products, which are reproduced here as (x * x) and
+     ((x * x) * x). Normalization divides by the square root of the squared
+     length, whereas the GPU multiplies by a reciprocal square root.
+     Sines and cosines are computed with XMVectorSinCos() in both versions.
+  -Spline particles with NaN spline parameters are treated as being
+     outside the valid segments of the spline.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <DirectXMath.h>
+#include "vertexTypes.h"
+#include "defs.h"
+
+// Number of particles processed together by the vectorized kernels
+#define PARTICLEKERNELS_BATCH_SIZE 4
+
+class ParticleKernels {
+
+public:
+	// Contents of the 'Globals' constant buffer
+	struct Globals {
+		DirectX::XMFLOAT4X4 world;
+
+		// x = transparency blend factor, yzw = colour cast
+		DirectX::XMFLOAT4 blendAmountAndColorCast;
+
+		// (currentTimeOffset, updateTimeInterval) [milliseconds]
+		DirectX::XMFLOAT2 time;
+
+		/* (billboard size multiplier, transparency multiplier)
+		   Level of detail compensation - Not used by splineParticlesVS.hlsl
+		 */
+		DirectX::XMFLOAT2 lodCompensation;
+	};
+
+	// Output of generalParticlesVS.hlsl, per particle
+	struct GeneralOutput {
+		DirectX::XMFLOAT3 positionVS; // View space
+		DirectX::XMFLOAT2 billboard; // Billboard dimensions (width, height)
+		float angle; // Billboard rotation angle (radians)
+		DirectX::XMFLOAT3 life; // (current age, current health, decay factor)
+		DirectX::XMFLOAT4 index; // Same as input vertex
+	};
+
+	/* Contents of the 'Globals' constant buffer used by splineParticlesVS.hlsl,
+	   which extends the general 'Globals' constant buffer
+	 */
+	struct SplineGlobals {
+		Globals general;
+
+		// (number of valid segments, spline capacity)
+		DirectX::XMFLOAT2 segments;
+
+		// (slot of the first segment, number of segment slots)
+		DirectX::XMFLOAT2 slots;
+	};
+
+public:
+	/* Fills 'globals' with the same values that InvariantParticlesRenderer
+	   places in the 'Globals' constant buffer when rendering 'geometry'
+	   (e.g. an InvariantParticles object). The time is the value set by
+	   the geometry's setTime() function.
+	 */
+	template<typename GeometryType> static HRESULT getGlobals(Globals& globals, const GeometryType& geometry);
+
+	/* Reference implementation of generalParticlesVS.hlsl for one particle.
+	   'view' is the camera's view matrix.
+	 */
+	static void generalParticlesVSReference(GeneralOutput& output, const ParticleVertexType& input,
+		const Globals& globals, const DirectX::XMFLOAT4X4& view);
+
+	/* Vectorized implementation of generalParticlesVS.hlsl
+	   for 'n' particles. 'output' must have room for 'n' elements.
+	 */
+	static HRESULT generalParticlesVS(GeneralOutput* const output, const ParticleVertexType* const input,
+		const size_t n, const Globals& globals, const DirectX::XMFLOAT4X4& view);
+
+	/* Fills 'globals' with the same values that SplineParticlesRenderer
+	   places in the 'Globals' constant buffer when rendering 'geometry'
+	   (e.g. a SplineParticles object)
+	 */
+	template<typename SplineGeometryType> static HRESULT getSplineGlobals(SplineGlobals& globals, const SplineGeometryType& geometry);
+
+	/* Reference implementation of splineParticlesVS.hlsl for one particle.
+	   'spline' is the contents of the control point buffer, with four control
+	   points per segment slot. It must hold at least 'globals.slots.y' slots.
+
+	   Particles outside the valid segments of the spline are output
+	   with zero health, and zero position, billboard size and angle.
+	 */
+	static void splineParticlesVSReference(GeneralOutput& output, const ParticleVertexType& input,
+		const DirectX::XMFLOAT4* const spline, const SplineGlobals& globals, const DirectX::XMFLOAT4X4& view);
+
+	/* Vectorized implementation of splineParticlesVS.hlsl
+	   for 'n' particles. 'output' must have room for 'n' elements.
+	   'nSplineSlots' is the number of segment slots in 'spline'.
+
+	   Returns a failure result, and does nothing, if the constant
+	   buffer contents refer to slots beyond the end of 'spline'.
+	 */
+	static HRESULT splineParticlesVS(GeneralOutput* const output, const ParticleVertexType* const input,
+		const size_t n, const DirectX::XMFLOAT4* const spline, const size_t nSplineSlots,
+		const SplineGlobals& globals, const DirectX::XMFLOAT4X4& view);
+
+	/* Evaluates the HLSL expression 'a % b' for float operands,
+	   using the instruction sequence generated by fxc
+	 */
+	static float hlslMod(const float a, const float b);
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	ParticleKernels(void);
+};
+
+template<typename GeometryType> HRESULT ParticleKernels::getGlobals(Globals& globals, const GeometryType& geometry) {
+	HRESULT result = ERROR_SUCCESS;
+
+	// Same range check as in InvariantParticlesRenderer::setNoLightShaderParameters()
+	float blend = geometry.getTransparencyBlendFactor();
+	if( blend > 1.0f || blend < 0.0f ) {
+		blend = 1.0f;
+	}
+	const DirectX::XMFLOAT3 colorCast = geometry.getColorCast();
+	globals.blendAmountAndColorCast = DirectX::XMFLOAT4(blend, colorCast.x, colorCast.y, colorCast.z);
+
+	if( FAILED(geometry.getWorldTransform(globals.world)) ) {
+		DirectX::XMStoreFloat4x4(&globals.world, DirectX::XMMatrixIdentity());
+		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+	if( FAILED(geometry.getTime(globals.time)) ) {
+		globals.time = DirectX::XMFLOAT2(0.0f, 0.0f);
+		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+	}
+	globals.lodCompensation = geometry.getLODCompensation();
+	return result;
+}
+
+template<typename SplineGeometryType> HRESULT ParticleKernels::getSplineGlobals(SplineGlobals& globals, const SplineGeometryType& geometry) {
+	HRESULT result = getGlobals(globals.general, geometry);
+
+	// Same values as in SplineParticlesRenderer::setSplineParameters()
+	globals.segments.x = static_cast<float>(geometry.getNumberOfSegments(false));
+	globals.segments.y = static_cast<float>(geometry.getNumberOfSegments(true));
+	globals.slots.x = static_cast<float>(geometry.getSegmentSlotOffset());
+	globals.slots.y = static_cast<float>(geometry.getNumberOfSegmentSlots());
+	return result;
+}
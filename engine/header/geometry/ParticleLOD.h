@@ -0,0 +1,175 @@
+/*
+ParticleLOD.h
+-------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: BurstVertexGenerator.h
+
+Description
+  -Chooses how many of the particles of a particle system to draw,
+     based on the size of the system on screen.
+  -The size on screen is estimated from a bounding sphere, centred
+     at the origin of the system's model space, and the camera's
+     view and projection transformations.
+  -Detail is reduced in levels. Level 'k' draws a fraction of 2^-k
+     of the particles. When fewer particles are drawn, the remaining
+     particles are enlarged, and made more opaque, according to
+     compensation exponents, so that the system keeps roughly
+     the same appearance.
+  -Only a prefix of the vertex buffer is drawn at reduced detail,
+     so vertices must be placed in an order in which any prefix
+     is representative of the whole system. progressiveOrder()
+     computes such an order for a grid of particles.
+
+Notes
+  -This class does not create any Direct3D objects,
+     so that it can be tested without a window.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <DirectXMath.h>
+#include <vector>
+#include "vertexTypes.h"
+
+/* Default parameters
+   Refer to the Parameters structure below.
+ */
+#define PARTICLELOD_FULL_DETAIL_SIZE_DEFAULT 0.25f
+#define PARTICLELOD_LEVELS_DEFAULT 4
+#define PARTICLELOD_SIZE_COMPENSATION_DEFAULT 0.5f
+#define PARTICLELOD_ALPHA_COMPENSATION_DEFAULT 0.5f
+#define PARTICLELOD_MAX_ALPHA_SCALE_DEFAULT 4.0f
+
+// Constraints on parameters
+#define PARTICLELOD_LEVELS_MIN 1
+#define PARTICLELOD_LEVELS_MAX 16
+#define PARTICLELOD_MAX_ALPHA_SCALE_MIN 1.0f
+
+class ParticleLOD {
+
+public:
+	struct Parameters {
+		/* Radius of the projection of the bounding sphere,
+		   as a fraction of the viewport's height, at or above which
+		   all particles are drawn. Below this size, the fraction
+		   of particles drawn is proportional to the square of the size.
+		 */
+		float fullDetailSize;
+
+		/* Number of levels of detail,
+		   so the smallest fraction of particles drawn is 2^-(nLevels - 1)
+		 */
+		size_t nLevels;
+
+		/* When a fraction 'f' of particles is drawn, billboard dimensions
+		   are multiplied by f^(-sizeCompensation / 2), and particle transparency
+		   is multiplied by f^(-alphaCompensation). If the two exponents sum to one,
+		   the total opacity of the billboards drawn is preserved.
+		 */
+		float sizeCompensation;
+		float alphaCompensation;
+
+		// Upper limit on the transparency multiplier
+		float maxAlphaScale;
+
+		// Initializes all parameters to their default values
+		Parameters(void);
+	};
+
+	struct Selection {
+		size_t level;
+
+		// Number of vertices to draw, from the start of the vertex buffer
+		size_t nVertices;
+
+		// Fraction of vertices to draw
+		float fraction;
+
+		// (billboard size multiplier, transparency multiplier)
+		DirectX::XMFLOAT2 compensation;
+	};
+
+public:
+	/* Throws an exception of type std::exception
+	   if the parameters are outside their valid ranges.
+	 */
+	ParticleLOD(const Parameters& parameters);
+
+	virtual ~ParticleLOD(void);
+
+	/* Returns the radius of the projection of a sphere of the given radius,
+	   centred at the origin of model space, as a fraction of the viewport's
+	   height. The distance from the camera to the sphere's centre is used
+	   instead of the depth of the centre, so that the estimate does not change
+	   when the camera rotates. 'radius' is multiplied by the largest scaling
+	   factor of 'world'.
+
+	   Returns FLT_MAX if the camera is inside the sphere,
+	   and zero if the sphere is entirely behind the camera.
+
+	   'view' and 'projection' are untransposed, as returned
+	   by Camera::GetViewMatrix() and Camera::GetProjectionMatrix().
+	 */
+	static float projectedSize(const DirectX::XMFLOAT4X4& world, const float radius,
+		const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection);
+
+	/* Chooses the level of detail for a system of 'nVertices' particles,
+	   whose bounding sphere has the given projected size (see projectedSize())
+	 */
+	void select(Selection& selection, const float projectedSize, const size_t nVertices) const;
+
+	/* Fills 'selection' with the values for the given level.
+	   Levels beyond the last level are treated as the last level.
+	 */
+	void selectLevel(Selection& selection, const size_t level, const size_t nVertices) const;
+
+	// Outputs a selection which draws all particles without compensation
+	static void selectFullDetail(Selection& selection, const size_t nVertices);
+
+	size_t getNumberOfLevels(void) const;
+
+	/* Outputs in 'order' the indices of the cells of a grid of 'nRows' rows
+	   and 'nColumns' columns, stored in row-major order, in the order in
+	   which they should be placed in a vertex buffer.
+
+	   The order is that of the bit-reversed Morton (Z-order) codes of the
+	   cells: The first half of the order consists of every second column,
+	   the first quarter, of every second column of every second row,
+	   and so forth, so any prefix is spread over the whole grid.
+	   When both dimensions are powers of two, the first 4^-k of the order
+	   is exactly the cells whose row and column are multiples of 2^k.
+	 */
+	static void progressiveOrder(std::vector<size_t>& order, const size_t nRows, const size_t nColumns);
+
+	/* Rearranges the grid of 'nRows' rows and 'nColumns' columns
+	   of vertices at 'vertices', stored in row-major order,
+	   into the order given by progressiveOrder().
+	 */
+	static HRESULT reorder(ParticleVertexType* const vertices, const size_t nRows, const size_t nColumns);
+
+	/* Estimates the number of pixels covered by the billboards drawn
+	   with the given selection, assuming that they are all at the distance
+	   of the centre of the bounding sphere, and neglecting overlap.
+
+	   'billboard' is the (width, height) of each particle's billboard
+	   and 'radius' is the radius of the bounding sphere, both in model space.
+	   'projectedSize' is the value returned by projectedSize() for the sphere.
+	 */
+	static float estimateFill(const Selection& selection, const float projectedSize,
+		const float radius, const DirectX::XMFLOAT2& billboard, const float viewportHeight);
+
+	// Data members
+private:
+	Parameters m_parameters;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	ParticleLOD(const ParticleLOD& other);
+	ParticleLOD& operator=(const ParticleLOD& other);
+};
@@ -22,6 +22,7 @@ Description
 #pragma once
 
 #include "UniformBurstSphere.h"
+#include "CounterRNG.h"
 
 // Default log message prefix used before more information is available
 #define RANDOMBURSTCONE_START_MSG_PREFIX L"RandomBurstCone"
@@ -81,6 +82,9 @@ public:
 	u = first surface parameter, in the range [0,1]
 	v = second surface parameter, in the range [0,1]
 	w = radius parameter, in the range [0,1]
+
+	The uvwTo*() functions are not called by addVertices(),
+	which uses the equivalent BurstVertexGenerator functions directly.
 	*/
 	virtual HRESULT uvwToPosition(DirectX::XMFLOAT3& position, const float u, const float v, const float w) const;
 
@@ -106,6 +110,12 @@ protected:
 	*/
 	virtual HRESULT configure(const std::wstring& scope = RANDOMBURSTCONE_SCOPE, const std::wstring* configUserScope = 0, const std::wstring* logUserScope = 0) override;
 
+	// Fills 'coneParameters' with the angle and radius parameters
+	void getConeParameters(BurstVertexGenerator::ConeParameters& coneParameters) const;
+
+	// Particles start within the maximum radius, or on the unit sphere, for pole particles
+	virtual float getLODRadius(const float time) const override;
+
 	// Data members
 protected:
 
@@ -114,6 +124,12 @@ protected:
 	float m_minR;
 	float m_maxR;
 
+	/* Source of the random parameters of the particles.
+	   Read from the start of its sequence each time vertices are generated,
+	   so that this object always produces the same particles.
+	 */
+	CounterRNG m_rng;
+
 	// Currently not implemented - will cause linker errors if called
 private:
 	RandomBurstCone(const RandomBurstCone& other);
@@ -138,7 +154,8 @@ template<typename ConfigIOClass> RandomBurstCone::RandomBurstCone(
 	false
 	),
 	m_maxPhi(RANDOMBURSTCONE_MAX_PHI_DEFAULT), m_minR(RANDOMBURSTCONE_RADIUS_MIN_DEFAULT),
-	m_maxR(RANDOMBURSTCONE_RADIUS_MAX_DEFAULT)
+	m_maxR(RANDOMBURSTCONE_RADIUS_MAX_DEFAULT),
+	m_rng(COUNTERRNG_SEED_DEFAULT, CounterRNG::getUniqueInstanceId())
 {
 	// Surrogates for base class constructor arguments
 	setMsgPrefix(RANDOMBURSTCONE_START_MSG_PREFIX);
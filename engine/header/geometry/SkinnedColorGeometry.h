@@ -34,6 +34,7 @@ Description
 #include "IGeometry.h"
 #include "ConfigUser.h"
 #include "Transformable.h"
+#include "AnimationSampler.h"
 
 #define SKINNEDCOLORGEOMETRY_VERTEX_TYPE SkinnedColorVertexType
 
@@ -228,6 +229,19 @@ public:
 	 */
 	virtual HRESULT setTransformables(const std::vector<Transformable*>* const bones) override;
 
+	/* Drives the bones of the model with the pose evaluated by 'animation',
+	   instead of with the Transformable objects set by setTransformables().
+	   Bone transformations are relative to the world transformation of 'transform'.
+	   The caller retains ownership of both objects, and is responsible for calling
+	   AnimationSampler::sample() or AnimationSampler::blend()
+	   before the model is rendered.
+
+	   Passing null for 'animation' reverts to the Transformable bones.
+	   Returns a failure result if 'transform' is null while 'animation' is not,
+	   or if the skeleton of 'animation' has a different number of bones than the model.
+	 */
+	HRESULT setAnimation(const AnimationSampler* const animation, const Transformable* const transform);
+
 	const Material* getMaterial(void) const;
 
 protected:
@@ -302,6 +316,12 @@ protected:
 	size_t m_vertexCount, m_indexCount;
 	std::vector<Transformable*>::size_type m_boneCount;
 
+	/* Source of bone transformations, used instead of 'm_bones' if not null,
+	   and the transformation of the model as a whole
+	 */
+	const AnimationSampler* m_animation;
+	const Transformable* m_animationTransform;
+
 	Material* m_material;
 
 	/* Transparency multiplier,
@@ -348,6 +368,7 @@ template<typename ConfigIOClass> SkinnedColorGeometry::SkinnedColorGeometry(
 	m_bones(0), m_invBindMatrices(0),
 	m_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST),
 	m_vertexCount(0), m_indexCount(0), m_boneCount(0),
+	m_animation(0), m_animationTransform(0),
 	m_rendererType(0), m_material(0),
 	m_blend(SKINNEDCOLORGEOMETRY_BLEND_DEFAULT),
 	m_renderLighting(SKINNEDCOLORGEOMETRY_USE_LIGHTING_FLAG_DEFAULT) {}
@@ -372,6 +393,7 @@ template<typename ConfigIOClass> SkinnedColorGeometry::SkinnedColorGeometry(
 	m_bones(0), m_invBindMatrices(0),
 	m_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST),
 	m_vertexCount(0), m_indexCount(0), m_boneCount(0),
+	m_animation(0), m_animationTransform(0),
 	m_rendererType(0), m_material(0),
 	m_blend(SKINNEDCOLORGEOMETRY_BLEND_DEFAULT),
 	m_renderLighting(SKINNEDCOLORGEOMETRY_USE_LIGHTING_FLAG_DEFAULT) {}
\ No newline at end of file
@@ -0,0 +1,75 @@
+/*
+SplineBuffer.h
+--------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: SplineParticles.cpp
+
+Description
+  -A structured buffer of spline control points, with a shader
+     resource view, kept up to date with a Spline by a SplineUploader
+  -Each spline drawn in a frame should have its own SplineBuffer,
+     so that only the segments which changed since the spline
+     was last drawn are uploaded. A buffer can be reused for another spline
+     (for instance, when the spline is destroyed), in which case
+     all segments are uploaded the first time.
+
+Notes
+  -The Direct3D objects are created by initialize(), or by the first
+     call to update(), using the device of the device context.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <d3d11.h>
+#include "Spline.h"
+#include "SplineUploader.h"
+#include "D3D11BufferWriter.h"
+
+class SplineBuffer {
+
+public:
+	/* 'nSlots' is the number of segment slots of the splines
+	   to be stored in the buffer (Spline::getNumberOfSegmentSlots()).
+	 */
+	SplineBuffer(const size_t nSlots);
+
+	virtual ~SplineBuffer(void);
+
+	/* Creates the buffer and its shader resource view.
+	   Does nothing if they have already been created.
+	 */
+	HRESULT initialize(ID3D11Device* const device);
+
+	/* Writes the segments of 'spline' which have changed since the last
+	   call to this function to the buffer. Returns a failure result
+	   if the spline does not have the number of slots of the buffer.
+	 */
+	HRESULT update(ID3D11DeviceContext* const context, const Spline& spline);
+
+	// Returns null if the buffer has not been created
+	ID3D11ShaderResourceView* getView(void) const;
+
+	size_t getNumberOfSegmentSlots(void) const;
+
+	// Data members
+private:
+	size_t m_nSlots;
+
+	ID3D11Buffer* m_buffer;
+	ID3D11ShaderResourceView* m_view;
+
+	// Writes changed segments to 'm_buffer'
+	D3D11BufferWriter* m_writer;
+	SplineUploader m_uploader;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	SplineBuffer(const SplineBuffer& other);
+	SplineBuffer& operator=(const SplineBuffer& other);
+};
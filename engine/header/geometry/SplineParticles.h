@@ -21,12 +21,20 @@ Description
      and then transformed using this object's current Transformable.
   -This class does not update or otherwise manage the Spline
      object to which it refers.
+  -The control point buffer is laid out by spline segment slot,
+     and only the segments which have changed since the last frame
+     are uploaded (see SplineUploader.h). The renderer passes
+     the slot of the first segment to the shader.
+  -When one object is used to draw several splines, each spline
+     should be given its own SplineBuffer (see setSpline()),
+     so that the splines do not overwrite each other's control points.
 */
 
 #pragma once
 
 #include "InvariantTexturedParticles.h"
 #include "Spline.h"
+#include "SplineBuffer.h"
 
 class SplineParticles : public InvariantTexturedParticles {
 
@@ -100,10 +108,22 @@ public:
 	 */
 	size_t getNumberOfSegments(const bool capacity) const;
 
+	/* Proxies of the corresponding functions in the Spline class,
+	   describing the layout of the control point buffer.
+	   To be used to set constant buffer parameters during rendering.
+	 */
+	size_t getNumberOfSegmentSlots(void) const;
+	size_t getSegmentSlotOffset(void) const;
+
 	/* The new spline must have the same capacity as the spline
 	   passed to initialize().
+
+	   'buffer' is the control point buffer to use for the spline,
+	   and must have the same number of slots as the spline.
+	   If it is null, this object's own buffer is used.
+	   (Shared - Not deleted by the destructor)
 	*/
-	virtual HRESULT setSpline(const Spline* const spline);
+	virtual HRESULT setSpline(const Spline* const spline, SplineBuffer* const buffer = 0);
 
 protected:
 	/* Prepares spline control point data on the pipeline
@@ -117,8 +137,13 @@ private:
 	const Spline* m_spline;
 	size_t m_splineCapacity;
 
-	ID3D11Buffer *m_splineBuffer;
-	ID3D11ShaderResourceView *m_splineBufferView;
+	// Control point buffer used when no other buffer is passed to setSpline()
+	SplineBuffer* m_ownSplineBuffer;
+
+	/* Shared - Not deleted by the destructor.
+	   Control point buffer for 'm_spline'
+	 */
+	SplineBuffer* m_splineBuffer;
 
 	// Currently not implemented - will cause linker errors if called
 private:
@@ -146,7 +171,7 @@ template<typename ConfigIOClass> SplineParticles::SplineParticles(
 	directoryField
 	),
 	m_spline(0), m_splineCapacity(0),
-	m_splineBuffer(0), m_splineBufferView(0)
+	m_ownSplineBuffer(0), m_splineBuffer(0)
 {}
 
 template<typename ConfigIOClass> SplineParticles::SplineParticles(
@@ -163,5 +188,5 @@ template<typename ConfigIOClass> SplineParticles::SplineParticles(
 	path
 	),
 	m_spline(0), m_splineCapacity(0),
-	m_splineBuffer(0), m_splineBufferView(0) 
+	m_ownSplineBuffer(0), m_splineBuffer(0)
 {}
\ No newline at end of file
@@ -0,0 +1,84 @@
+/*
+SplineUploader.h
+----------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Keeps a buffer of spline control points up to date with a Spline,
+     writing only the segments which have changed since the last upload.
+  -The buffer is laid out by segment slot (see Spline.h),
+     with 4 control points (DirectX::XMFLOAT4) per slot, in the order
+     output by Spline::getControlPoints(). Its size must be
+     Spline::getNumberOfSegmentSlots() times the size of a segment.
+  -Shaders find segment 'i' in slot
+     '(i + Spline::getSegmentSlotOffset()) % Spline::getNumberOfSegmentSlots()'.
+     When knots are added at one end of the spline and removed
+     from the other end, the slots of the unchanged segments
+     stay the same, and do not need to be uploaded again.
+
+Notes
+  -Consecutive changed slots are uploaded with a single write.
+  -This class does not update or otherwise manage the Spline
+     object to which it refers.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <DirectXMath.h>
+#include <vector>
+#include <utility>
+#include "Spline.h"
+#include "IBufferWriter.h"
+
+// Size of a spline segment in the buffer, in bytes
+#define SPLINEUPLOADER_SEGMENT_SIZE (4 * sizeof(DirectX::XMFLOAT4))
+
+class SplineUploader {
+
+public:
+	SplineUploader(void);
+
+	virtual ~SplineUploader(void);
+
+	/* Writes the segments of 'spline' which have changed since
+	   the last call to this function to 'writer'.
+	   All slots are written by the first call, the first call
+	   after a call to reset(), and calls with a different spline
+	   (as identified by Spline::getId()).
+
+	   Returns a failure result, and does nothing, if the buffer
+	   does not have the size required for the spline.
+	 */
+	HRESULT upload(IBufferWriter& writer, const Spline& spline);
+
+	/* Causes the next call to upload() to write all slots,
+	   for instance, when the buffer is replaced.
+	 */
+	void reset(void);
+
+	// Data members
+private:
+	/* Whether the buffer holds a spline, which has the identifier 'm_id'
+	   and had the version 'm_version' at the last call to upload().
+	   Splines are not identified by their addresses, which can be reused.
+	 */
+	bool m_hasSpline;
+	UINT64 m_id;
+	UINT64 m_version;
+
+	// Reused buffers for changed slot ranges and their control points
+	std::vector<std::pair<size_t, size_t> > m_ranges;
+	std::vector<DirectX::XMFLOAT4> m_staging;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	SplineUploader(const SplineUploader& other);
+	SplineUploader& operator=(const SplineUploader& other);
+};
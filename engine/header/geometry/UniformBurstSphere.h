@@ -19,6 +19,12 @@ Description
      with an initial model space radius of 1
   -Over time, the sphere will uniformly expand or contract
   -Aside from position and direction of motion, all particles are otherwise identical
+  -The grid of particles is generated by a BurstVertexGenerator,
+     in parallel if a WorkerPool has been provided (see setWorkerPool()).
+  -Grid vertices are placed in the order given by ParticleLOD::progressiveOrder(),
+     so that level of detail selection draws particles spread over the whole grid.
+     Pole particles follow the grid vertices, and are therefore
+     only drawn at full detail.
 */
 
 #pragma once
@@ -27,6 +33,8 @@ Description
 #include "vertexTypes.h"
 #include "InvariantTexturedParticles.h"
 #include "Transformable.h"
+#include "BurstVertexGenerator.h"
+#include "WorkerPool.h"
 #include <string>
 
 // Default log message prefix used before more information is available
@@ -119,6 +127,12 @@ public:
 	virtual HRESULT initialize(ID3D11Device* const device,
 		const Transformable* const transform = 0);
 
+	/* Vertices will be generated using the threads of 'pool',
+	   if it is not null. 'pool' is not deleted by this object,
+	   and must not be running other tasks during calls to initialize().
+	 */
+	void setWorkerPool(WorkerPool* const pool);
+
 	// Geometry setup
 public:
 
@@ -132,6 +146,9 @@ public:
 	   (Cartesian coordinates)
 	   u = first surface parameter, in the range [0,1]
 	   v = second surface parameter, in the range [0,1]
+
+	   The uvTo*() functions are not called by addVertices(),
+	   which uses the equivalent BurstVertexGenerator functions directly.
 	 */
 	virtual HRESULT uvToPosition(DirectX::XMFLOAT3& position, const float u, const float v) const;
 
@@ -157,6 +174,21 @@ protected:
 	 */
 	virtual HRESULT configure(const std::wstring& scope = UNIFORMBURSTSPHERE_SCOPE, const std::wstring* configUserScope = 0, const std::wstring* logUserScope = 0) override;
 
+	// Fills 'parameters' with the grid, billboard, speed, life and colour parameters
+	void getGeneratorParameters(BurstVertexGenerator::Parameters& parameters) const;
+
+	// Pole particles are output at 'vertices'
+	void addPoleVertices(INVARIANTPARTICLES_VERTEX_TYPE* const vertices) const;
+
+	/* Returns the distance from the origin which no particle exceeds
+	   at the given time, including the extent of its billboard,
+	   if no particle starts further than 'initialRadius' from the origin
+	 */
+	float getBurstRadius(const float initialRadius, const float time) const;
+
+	// Particles start on the unit sphere
+	virtual float getLODRadius(const float time) const override;
+
 	// Data members
 protected:
 
@@ -187,6 +219,9 @@ protected:
 	 */
 	bool m_debugColorCasts;
 
+	// Shared, not owned by this object
+	WorkerPool* m_workerPool;
+
 	// Currently not implemented - will cause linker errors if called
 private:
 	UniformBurstSphere(const UniformBurstSphere& other);
@@ -222,7 +257,8 @@ template<typename ConfigIOClass> UniformBurstSphere::UniformBurstSphere(
 			UNIFORMBURSTSPHERE_COLORCAST_COLOR_DEFAULT_XYZ,
 			UNIFORMBURSTSPHERE_COLORCAST_WEIGHT_DEFAULT)
 			),
-	m_debugColorCasts(UNIFORMBURSTSPHERE_DEBUG_FLAG_DEFAULT)
+	m_debugColorCasts(UNIFORMBURSTSPHERE_DEBUG_FLAG_DEFAULT),
+	m_workerPool(0)
 {
 	if( configureNow ) {
 		if( FAILED(configure()) ) {
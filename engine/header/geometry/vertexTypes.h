@@ -121,4 +121,26 @@ struct ParticleVertexType {
 //	// Multi-purpose: Color/albedo, or 1D to 4D texture coordinates,
 //	//   or even a particle ID.
 //	DirectX::XMFLOAT4 index;
-//};
\ No newline at end of file
+//};
+
+/* Per-instance data for drawing several copies of one particle system
+   in a single draw call (refer to the ParticleInstanceBatcher class).
+   Each element is read from a second vertex buffer, stepped once per instance,
+   in place of the per-system values otherwise set in constant buffers.
+ */
+#define PARTICLEINSTANCETYPE_COMPONENTS 6
+struct ParticleInstanceType {
+
+	// Rows of the world transformation (not transposed),
+	//   passed to the shader as four float4 elements
+	DirectX::XMFLOAT4X4 world;
+
+	// x = time since the creation of the particle system (milliseconds)
+	// y = time since the last update (milliseconds)
+	// z = billboard size multiplier, w = transparency multiplier
+	//   (level of detail compensation - see InvariantParticles::getLODCompensation())
+	DirectX::XMFLOAT4 time;
+
+	// xyz = colour cast, w = unused
+	DirectX::XMFLOAT4 colorCast;
+};
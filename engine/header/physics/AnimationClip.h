@@ -0,0 +1,160 @@
+/*
+AnimationClip.h
+---------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: TransformSystem.h
+Other references:
+  -Jason Gregory, _Game Engine Architecture_, 2nd ed.,
+     Chapter 11 (Animation Systems), section on animation compression
+
+Description
+  -Keyframe animation of the local transformations of the bones
+     of a skeleton, relative to their parents.
+  -Each bone has three tracks, one per channel: translation,
+     rotation (a quaternion) and scale. Each track is a sequence
+     of keys, interpolated linearly (rotations are interpolated
+     linearly and renormalized by AnimationSampler).
+  -Tracks are compressed when they are set:
+     -Keys which can be reproduced, within a tolerance,
+        by interpolating between the keys kept on either side of them
+        are removed. Constant tracks are reduced to a single key.
+     -Key times are quantized to 16 bits over the duration of the clip.
+     -Key values are quantized to 16 bits per component,
+        over the range of the track's values in each component.
+  -Key data is stored in structure-of-arrays form: one array
+     of key times and one array of key values per channel,
+     with the keys of each track stored contiguously,
+     and the tracks stored in bone order. The locations and
+     quantization ranges of the tracks are stored in separate arrays.
+
+Notes
+  -Clips are sampled with AnimationSampler.
+  -The time of a clip is measured in milliseconds, as elsewhere
+     in the engine, from zero to the duration of the clip.
+     Looping clips wrap times outside this range,
+     whereas other clips clamp them.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+#include <vector>
+
+// Default maximum error per component allowed when removing keys
+#define ANIMATIONCLIP_DEFAULT_TOLERANCE 1.0e-3f
+
+// Largest quantized value
+#define ANIMATIONCLIP_QUANTIZATION_MAX 65535.0f
+
+class AnimationClip {
+
+public:
+	enum class Channel : unsigned int {
+		TRANSLATION,
+		ROTATION,
+		SCALE
+	};
+
+	// Number of channels per bone
+	static const size_t N_CHANNELS = 3;
+
+public:
+	/* Creates a clip for a skeleton with 'nBones' bones,
+	   in which all bones have the identity transformation
+	   until their tracks are set.
+
+	   The constructor throws an exception if 'nBones' is zero,
+	   or if 'duration' is not positive.
+	 */
+	AnimationClip(const size_t nBones, const float duration, const bool loop = true);
+
+	virtual ~AnimationClip(void);
+
+	/* Replaces the track of the given channel of the given bone
+	   with a compressed version of the 'nKeys' keys
+	   with the given times and values.
+
+	   Times must be increasing, and within the duration of the clip.
+	   The value is held constant before the first key, and after the last key.
+	   Translations and scales are given by the first three components of
+	   the values (the fourth component is ignored). Rotations are quaternions,
+	   which will be normalized, and negated where necessary to be in the same
+	   hemisphere as the previous key, so that interpolation takes the shorter path.
+
+	   Keys are removed if every component of their values can be reproduced
+	   to within 'tolerance' by interpolation.
+
+	   Returns a failure result, and does nothing, if the input is invalid.
+	 */
+	HRESULT setTrack(const size_t bone, const Channel channel,
+		const float* const times, const DirectX::XMFLOAT4* const values,
+		const size_t nKeys, const float tolerance = ANIMATIONCLIP_DEFAULT_TOLERANCE);
+
+	/* Outputs the interpolated values of the given channel
+	   for all bones, at the given time, to the first getNumberOfBones()
+	   elements of 'values'. Rotations are not renormalized.
+	 */
+	void sampleChannel(DirectX::XMFLOAT4* const values, const Channel channel, const float time) const;
+
+	size_t getNumberOfBones(void) const;
+	float getDuration(void) const;
+	bool isLooping(void) const;
+
+	// Returns the number of keys stored, over all tracks
+	size_t getNumberOfKeys(void) const;
+
+	// Returns the number of bytes occupied by keys and track information
+	size_t getSizeInBytes(void) const;
+
+	// Helper functions
+private:
+	/* Returns the position of the time in the clip,
+	   on the scale of quantized key times
+	 */
+	float toKeyTime(const float time) const;
+
+	/* Outputs in 'kept' the indices of the keys needed to reproduce
+	   all keys to within 'tolerance' by interpolation.
+	   If 'normalize' is true, interpolated values are normalized
+	   before being compared with the keys.
+	 */
+	static void reduceKeys(std::vector<size_t>& kept,
+		const float* const times, const std::vector<DirectX::XMFLOAT4>& values,
+		const float tolerance, const bool normalize);
+
+	// Data members
+private:
+	size_t m_nBones;
+	float m_duration;
+	bool m_loop;
+
+	/* Per channel: Index of the first key of each bone's track,
+	   and the number of keys in the track
+	 */
+	std::vector<size_t> m_trackStart[N_CHANNELS];
+	std::vector<size_t> m_trackLength[N_CHANNELS];
+
+	/* Per channel: Quantization ranges of each bone's track.
+	   A quantized value 'q' represents 'rangeMin + q * rangeScale'.
+	 */
+	std::vector<DirectX::XMFLOAT4> m_rangeMin[N_CHANNELS];
+	std::vector<DirectX::XMFLOAT4> m_rangeScale[N_CHANNELS];
+
+	/* Per channel: Quantized key times, as fractions of the duration
+	   scaled to ANIMATIONCLIP_QUANTIZATION_MAX, and quantized key values
+	 */
+	std::vector<unsigned short> m_times[N_CHANNELS];
+	std::vector<DirectX::PackedVector::XMUSHORT4> m_values[N_CHANNELS];
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	AnimationClip(const AnimationClip& other);
+	AnimationClip& operator=(const AnimationClip& other);
+};
@@ -0,0 +1,144 @@
+/*
+AnimationSampler.h
+------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: TransformSystem.h
+
+Description
+  -Evaluates the pose of a skeleton from one AnimationClip,
+     or from a weighted blend of two clips, at given times.
+  -Bone transformations are evaluated in batches of four bones:
+     the sampled translations, rotations and scales are transposed
+     into structure-of-arrays form, blended, and converted
+     to local transformation matrices, in the same manner as
+     TransformSystem::computeLocalTransforms().
+  -Local transformations are then combined with the transformations
+     of their parent bones, in a single forward pass.
+  -The resulting model space bone transformations are output
+     in the form expected by the bone matrix buffers
+     of SkinnedColorGeometry.
+
+Notes
+  -Parent bones must precede their children, such that
+     a bone's index is always greater than the index of its parent.
+  -A bone inherits the full transformation of its parent,
+     including scaling (unlike in TransformSystem).
+  -Rotations are blended by normalized linear interpolation,
+     negating one of the two quaternions if necessary so that
+     the blend takes the shorter path.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <DirectXMath.h>
+#include <vector>
+#include "AnimationClip.h"
+
+// Index value indicating that a bone has no parent
+#define ANIMATIONSAMPLER_NO_PARENT static_cast<size_t>(-1)
+
+// Number of bones processed together by the vectorized loops
+#define ANIMATIONSAMPLER_BATCH_SIZE 4
+
+class AnimationSampler {
+
+public:
+	/* 'parents' contains the index of the parent of each bone,
+	   or ANIMATIONSAMPLER_NO_PARENT for root bones.
+
+	   The constructor throws an exception if 'parents' is empty,
+	   or if a bone's parent index is not less than the bone's index.
+	 */
+	AnimationSampler(const std::vector<size_t>& parents);
+
+	virtual ~AnimationSampler(void);
+
+	/* Evaluates the pose of the skeleton given by the clip at the given time.
+	   Returns a failure result if the clip does not have the same number of bones
+	   as the skeleton.
+	 */
+	HRESULT sample(const AnimationClip& clip, const float time);
+
+	/* Evaluates the pose of the skeleton given by interpolating
+	   between the poses of two clips at the given times.
+	   'weight' is the weight of the second clip, and must be in the range [0,1].
+
+	   Returns a failure result if either clip does not have the same number
+	   of bones as the skeleton, or if the weight is out of range.
+	 */
+	HRESULT blend(const AnimationClip& clipA, const float timeA,
+		const AnimationClip& clipB, const float timeB, const float weight);
+
+	/* Outputs the transformation of each bone for vertex skinning,
+	   as done by SkinnedColorGeometry::updateAndBindBoneBuffers():
+	   The transformation of a bone is the product of its inverse bind pose
+	   transformation ('invBindMatrices'), its model space transformation
+	   from the last call to sample() or blend(), and 'world'.
+
+	   'positionTransforms' receives the transposed transformations,
+	   and 'normalTransforms' receives the inverses of the transformations.
+	   All arrays must have getNumberOfBones() elements.
+	 */
+	HRESULT writeBoneMatrices(DirectX::XMFLOAT4X4* const positionTransforms,
+		DirectX::XMFLOAT4X4* const normalTransforms,
+		const DirectX::XMFLOAT4X4* const invBindMatrices,
+		const DirectX::XMFLOAT4X4& world) const;
+
+	/* Retrieves the model space transformation of the given bone,
+	   from the last call to sample() or blend()
+	 */
+	HRESULT getModelTransform(const size_t bone, DirectX::XMFLOAT4X4& transform) const;
+
+	size_t getNumberOfBones(void) const;
+
+	// Helper functions
+private:
+	/* Samples all channels of the clip into the given arrays */
+	void sampleClip(const AnimationClip& clip, const float time,
+		std::vector<DirectX::XMFLOAT4>& translations,
+		std::vector<DirectX::XMFLOAT4>& rotations,
+		std::vector<DirectX::XMFLOAT4>& scales) const;
+
+	/* Computes local transformations from the sampled values,
+	   blending with the values sampled from a second clip
+	   using the given weight, if 'blend' is true,
+	   and stores them in 'm_modelTransforms'.
+	 */
+	void computeLocalTransforms(const bool blend, const float weight);
+
+	/* Combines the local transformations in 'm_modelTransforms'
+	   with the transformations of their parents
+	 */
+	void computeHierarchy(void);
+
+	// Data members
+private:
+	size_t m_nBones;
+
+	// Indices of parent bones
+	std::vector<size_t> m_parents;
+
+	/* Sampled values from the first and second clips,
+	   padded to a multiple of ANIMATIONSAMPLER_BATCH_SIZE with identity values
+	 */
+	std::vector<DirectX::XMFLOAT4> m_translations;
+	std::vector<DirectX::XMFLOAT4> m_rotations;
+	std::vector<DirectX::XMFLOAT4> m_scales;
+	std::vector<DirectX::XMFLOAT4> m_blendTranslations;
+	std::vector<DirectX::XMFLOAT4> m_blendRotations;
+	std::vector<DirectX::XMFLOAT4> m_blendScales;
+
+	// Model space bone transformations, with the same padding
+	std::vector<DirectX::XMFLOAT4X4> m_modelTransforms;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	AnimationSampler(const AnimationSampler& other);
+	AnimationSampler& operator=(const AnimationSampler& other);
+};
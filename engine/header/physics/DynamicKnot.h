@@ -24,6 +24,7 @@ Description
 #include <Windows.h>
 #include <DirectXMath.h>
 #include "Knot.h"
+#include "SlabPool.h"
 
 class DynamicKnot : public Knot {
 
@@ -51,6 +52,20 @@ private:
 	bool m_ownTransform;
 	Transformable* m_transform;
 
+	/* Instances are allocated from a pool shared by all DynamicKnots.
+	   Objects of further derived classes, which have different sizes,
+	   are allocated from the global heap.
+	 */
+public:
+	static void* operator new(const size_t size);
+	static void operator delete(void* const object, const size_t size);
+
+	/* Outputs the allocation statistics of the pool */
+	static void getPoolTelemetry(SlabPool::Telemetry& telemetry);
+
+private:
+	static SlabPool s_pool;
+
 	// Currently not implemented - will cause linker errors if called
 private:
 	DynamicKnot(const DynamicKnot& other);
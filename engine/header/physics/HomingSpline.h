@@ -25,6 +25,11 @@ Description
 	 of the end Transformable, when the end Transformable
 	 has moved beyond a threshold distance from the second-last knot.
   -The end Transformable is always the last (and dynamic) knot in the spline.
+  -Optionally, the static knots can be compressed (see setCompression()),
+     so that long chases do not use up the spline's capacity.
+     Every few added knots, the segments added since the last compression
+     are passed to a SplineFitter, and the segments which it refit
+     are replaced with its output.
 
 Notes:
   -Be sure to understand the getParameterAtInitialSize()
@@ -37,6 +42,13 @@ Notes:
 #include <DirectXMath.h>
 #include "Spline.h"
 #include "WanderingLineTransformable.h"
+#include "SplineFitter.h"
+#include <vector>
+
+/* Number of static knots added between compressions of the spline,
+   when compression is enabled
+ */
+#define HOMINGSPLINE_COMPRESSION_INTERVAL 4
 
 class HomingSpline : public Spline {
 
@@ -121,6 +133,18 @@ public:
 	 */
 	float getParameterAtInitialSize(const float t) const;
 
+	/* Enables compression of the static knots of the spline
+	   to within a distance of 'maxError' of their original path,
+	   or disables compression if 'maxError' is zero.
+	   Returns a failure result if 'maxError' is negative.
+
+	   Compression reduces the number of segments, and therefore
+	   changes the parameterization of the spline.
+	   It is best used with arc length parameterization
+	   (see Spline::arcLengthToT()).
+	 */
+	HRESULT setCompression(const float maxError);
+
 private:
 	/* Saves the state of the endpoint of the spline
 	   as a new second-last knot (a static knot).
@@ -130,6 +154,14 @@ private:
 	 */
 	HRESULT updateTracking(void);
 
+	/* Passes the static segments added since the last compression
+	   to the SplineFitter, and replaces the segments which it refit.
+
+	   If this function fails, the spline may be in an inconsistent state.
+	   (The failure should be deemed critical.)
+	 */
+	HRESULT compressTail(void);
+
 	// Data members
 private:
 
@@ -150,6 +182,18 @@ private:
 	/* The number of segments at the time of initialization */
 	size_t m_initialSegments;
 
+	/* Null if compression is disabled */
+	SplineFitter* m_fitter;
+
+	/* Number of static segments at the end of the spline
+	   added since the last compression
+	 */
+	size_t m_nNewSegments;
+
+	// Compression buffers, kept to avoid reallocation
+	std::vector<DirectX::XMFLOAT4> m_controlPoints;
+	std::vector<DirectX::XMFLOAT3> m_fittedControlPoints;
+
 	// Currently not implemented - will cause linker errors if called
 private:
 	HomingSpline(const HomingSpline& other);
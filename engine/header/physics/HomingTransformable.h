@@ -44,6 +44,12 @@ public:
 	   'currentTime' should be the current time
 	   as used elsewhere in the program.
 
+	   If 'constantSpeed' is true, 'speedT' and 'offsetT'
+	   are treated as fractions of the length of the spline,
+	   rather than spline parameter values, so that the object
+	   moves at a constant speed regardless of the lengths
+	   of the spline's segments.
+
 	   Note: The constructor initializes this object's scaling
 	         vector to (1,1,1).
 	 */
@@ -57,7 +63,8 @@ public:
 		const float speedT,
 		const float offsetT,
 		const bool loop,
-		DWORD currentTime);
+		DWORD currentTime,
+		const bool constantSpeed = false);
 
 	virtual ~HomingTransformable(void);
 
@@ -121,6 +128,12 @@ private:
 	 */
 	bool m_isAtEnd;
 
+	/* If true, the spline parameter is obtained from
+	   the fraction of the spline's length travelled,
+	   using the spline's arc length tables.
+	 */
+	bool m_constantSpeed;
+
 	/* The spline that this object is tracking. */
 	HomingSpline* m_spline;
 
@@ -22,6 +22,13 @@ References:
 Description
   -Abstract class defining a C_1 continuous knot
      between two segments in a Bezier curve
+
+Implementation Notes:
+  -Control points are stored inline, and a bitmask records
+     which of them are currently valid, so that creating knots,
+     and changing the sides they represent, does not allocate memory.
+  -Derived classes allocate their instances from SlabPool objects
+     (see StaticKnot and DynamicKnot).
 */
 
 #pragma once
@@ -32,6 +39,15 @@ Description
 
 #define KNOT_DEFAULT_SPEED 1.0f
 
+// Bits of the mask identifying the valid control points of a knot
+#define KNOT_POINT_P2 0x1u
+#define KNOT_POINT_P3 0x2u
+#define KNOT_POINT_P0 0x4u
+#define KNOT_POINT_P1 0x8u
+#define KNOT_POINTS_END (KNOT_POINT_P2 | KNOT_POINT_P3)
+#define KNOT_POINTS_START (KNOT_POINT_P0 | KNOT_POINT_P1)
+#define KNOT_POINTS_BOTH (KNOT_POINTS_END | KNOT_POINTS_START)
+
 class Knot {
 public:
 	/* Identifies which control points are to be returned by
@@ -109,6 +125,15 @@ public:
 	HRESULT getP2(DirectX::XMFLOAT3& p2) const;
 	HRESULT getP3(DirectX::XMFLOAT3& p3) const;
 
+	/* Replaces the control points which this object has,
+	   taking them from the array 'controlPoints', which holds
+	   four control points in the order p2, p3, p0, p1.
+	   Control points which this object does not have are ignored.
+	   (The control points of a DynamicKnot will be overwritten
+	    by its next update.)
+	 */
+	void setControlPoints(const DirectX::XMFLOAT3* const controlPoints);
+
 	/* Converts a single-sided knot into a double-sided knot.
 	   Does nothing and returns a failure result if
 	   'm_side' is already PointSet::BOTH.
@@ -127,11 +152,20 @@ public:
 	 */
 	HRESULT makeHalf(const PointSet side);
 
+	/* Returns the side of the knot, based on the control points it has */
+	PointSet getSide(void) const;
+
 	/* The following helper functions are not called by this class. */
 protected:
 	HRESULT updateControlPoints(Transformable& transform);
 
 private:
+	/* Returns the bitmask of the control points
+	   present in a knot of the given side.
+	   Throws an exception if 'side' is not a valid enumeration constant.
+	 */
+	static unsigned int sideToPoints(const PointSet side);
+
 	HRESULT updateP2(Transformable& transform);
 	HRESULT updateP3(Transformable& transform);
 	HRESULT updateP0(Transformable& transform);
@@ -139,29 +173,30 @@ private:
 
 	// Data members
 private:
-	/* Determines which control points
-	   are allocated and output.
+	/* Bitmask of KNOT_POINT_* values, indicating which control points
+	   are valid and output. Determines the side of the knot.
 	 */
-	PointSet m_side;
+	unsigned int m_points;
 
-	DirectX::XMFLOAT3* m_p2; // Final tangent control point of the previous segment
-	DirectX::XMFLOAT3* m_p3; // Final position control point of the previous segment
-	DirectX::XMFLOAT3* m_p0; // Initial position control point of the next segment
-	DirectX::XMFLOAT3* m_p1; // Initial tangent control point of the next segment
+	DirectX::XMFLOAT3 m_p2; // Final tangent control point of the previous segment
+	DirectX::XMFLOAT3 m_p3; // Final position control point of the previous segment
+	DirectX::XMFLOAT3 m_p0; // Initial position control point of the next segment
+	DirectX::XMFLOAT3 m_p1; // Initial tangent control point of the next segment
 
 	/* Used to calculate tangent control points
-	   Not needed if 'm_useForward' is false, and
-	   the constructor was not passed a speed value.
+	   Not needed (and 'm_hasSpeed' is false) if 'm_useForward' is false,
+	   and the constructor was not passed a speed value.
 
 	   In units of units per second.
 	 */
-	float* m_speed;
+	float m_speed;
+	bool m_hasSpeed;
 
 	/* Flag indicating whether
 	   to use the forward or velocity vectors of any Transformable
 	   object used to set or update control points.
 	 */
-	bool* m_useForward;
+	bool m_useForward;
 
 	// Currently not implemented - will cause linker errors if called
 private:
@@ -0,0 +1,219 @@
+/*
+SpatialIndex.h
+--------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+Other references:
+  -Erin Catto, b2DynamicTree (Box2D physics engine)
+  -Christer Ericson, Real-Time Collision Detection (2005), chapter 6
+
+Description
+  -A dynamic bounding volume hierarchy over Transformable objects,
+     supporting ray casts, sphere overlap queries, and k-nearest queries.
+  -Each object is bounded by a sphere centred at the translation
+     of its world transform, with a radius of Transformable::m_radius,
+     interpreted as a world-space radius.
+  -Leaves store axis-aligned boxes enlarged by a margin ("fat" boxes),
+     so that objects which move slightly do not change the tree.
+     update() reads the current bounds of all objects, and removes
+     and reinserts only the objects which have left their fat boxes.
+  -Insertions choose a sibling with the surface area heuristic,
+     and the tree is kept balanced with AVL-style rotations.
+  -rebuild() constructs a balanced tree from scratch, by median splits,
+     which is faster than inserting many objects one at a time.
+     refit() recomputes all boxes without changing the tree structure,
+     which is faster than update() when most objects move,
+     at the cost of gradually degrading query performance.
+  -Query results are found using the exact bounding spheres,
+     not the fat boxes.
+
+Notes
+  -Objects must be removed before they are destroyed.
+  -This class is not thread-safe, although concurrent queries are safe
+     when no modifications are being made.
+  -Node indices of leaves are used as object identifiers,
+     and remain valid until the object is removed.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <DirectXMath.h>
+#include <vector>
+#include "Transformable.h"
+
+// Identifier value indicating the absence of a node
+#define SPATIALINDEX_NULL static_cast<size_t>(-1)
+
+// Default amount by which leaf boxes are enlarged on each side
+#define SPATIALINDEX_MARGIN_DEFAULT 0.1f
+
+class SpatialIndex {
+
+public:
+	struct Result {
+		size_t id;
+		const Transformable* transform;
+
+		/* Distance from the ray origin to the first intersection (for ray casts),
+		   or from the query point to the surface of the object's bounding sphere,
+		   clamped to zero for points inside the sphere (for other queries)
+		 */
+		float distance;
+	};
+
+public:
+	/* 'margin' must not be negative, or the constructor will throw an exception.
+	   'capacity' is the number of objects for which storage
+	   will be reserved initially.
+	 */
+	SpatialIndex(const float margin = SPATIALINDEX_MARGIN_DEFAULT, const size_t capacity = 0);
+
+	virtual ~SpatialIndex(void);
+
+	// Modification
+public:
+	/* Adds the object, and outputs its identifier in 'id'.
+	   The object is not owned by this object.
+	 */
+	HRESULT add(size_t& id, const Transformable* const transform);
+
+	HRESULT remove(const size_t id);
+
+	/* Reads the current bounds of all objects, and reinserts
+	   the objects whose bounds are no longer within their fat boxes.
+	   If 'nReinserted' is not null, it will be assigned
+	   the number of objects which were reinserted.
+	 */
+	HRESULT update(size_t* const nReinserted = 0);
+
+	/* Reads the current bounds of all objects, and recomputes
+	   all boxes without changing the structure of the tree.
+	 */
+	HRESULT refit(void);
+
+	/* Reads the current bounds of all objects,
+	   and builds a balanced tree. Identifiers remain valid.
+	 */
+	HRESULT rebuild(void);
+
+	void clear(void);
+
+	// Queries
+public:
+	/* Finds the closest object whose bounding sphere is intersected
+	   by the ray from 'origin' in direction 'direction' (which need not
+	   be normalized), within a distance of 'maxDistance' from the origin.
+	   Returns false if there is no such object,
+	   or if 'direction' is a zero vector.
+	 */
+	bool rayCast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction,
+		const float maxDistance, Result& result) const;
+
+	/* Outputs all objects whose bounding spheres intersect the given sphere,
+	   in no particular order, and returns their number.
+	 */
+	size_t sphereOverlap(const DirectX::XMFLOAT3& center, const float radius,
+		std::vector<Result>& results) const;
+
+	/* Outputs the (up to) 'k' objects whose bounding spheres
+	   are closest to the given point, in order of increasing distance,
+	   and returns their number.
+	 */
+	size_t nearest(const DirectX::XMFLOAT3& point, const size_t k,
+		std::vector<Result>& results) const;
+
+	// Inspection
+public:
+	size_t getCount(void) const;
+
+	// Returns null if 'id' is not a valid identifier
+	const Transformable* getTransformable(const size_t id) const;
+
+	// Zero for an empty tree or a tree containing one object
+	size_t getHeight(void) const;
+
+	/* Sum of the surface areas of the boxes of internal nodes,
+	   divided by the surface area of the root box.
+	   Lower values indicate better query performance.
+	 */
+	float getCost(void) const;
+
+	/* Checks the structure of the tree, and checks that each node's box
+	   contains its children's boxes, and that each leaf's box
+	   contains its object's bounding sphere. For testing.
+	 */
+	HRESULT validate(void) const;
+
+	// Helper functions
+private:
+	struct Node {
+		DirectX::XMFLOAT3 min;
+		DirectX::XMFLOAT3 max;
+
+		// Also used to link free nodes
+		size_t parent;
+
+		// SPATIALINDEX_NULL for leaves
+		size_t child1;
+		size_t child2;
+
+		// Zero for leaves, and -1 for free nodes
+		int height;
+
+		// Leaf data
+		const Transformable* transform;
+		DirectX::XMFLOAT3 center;
+		float radius;
+		size_t leafIndex; // Index in 'm_leaves'
+	};
+
+	size_t allocateNode(void);
+	void freeNode(const size_t index);
+
+	bool isLeaf(const size_t index) const;
+	bool isValidLeaf(const size_t index) const;
+
+	/* Reads the bounding sphere of the object at the leaf.
+	   Returns true if the sphere is still within the leaf's box.
+	 */
+	bool readBounds(Node& leaf) const;
+
+	// Sets the box of the leaf to its bounding sphere's box, enlarged by the margin
+	void setFatBox(Node& leaf) const;
+
+	void insertLeaf(const size_t leaf);
+	void removeLeaf(const size_t leaf);
+
+	/* Performs a rotation at the node, if it is unbalanced,
+	   and returns the index of the node which takes its place
+	 */
+	size_t balance(const size_t index);
+
+	// Recomputes the box and height of an internal node from its children
+	void refitNode(const size_t index);
+
+	// Builds a subtree from the given leaves, and returns its root
+	size_t buildRange(std::vector<size_t>& leaves, const size_t begin, const size_t end);
+
+	// Data members
+private:
+	std::vector<Node> m_nodes;
+	size_t m_root;
+	size_t m_freeList;
+
+	// Indices of all leaf nodes
+	std::vector<size_t> m_leaves;
+
+	float m_margin;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	SpatialIndex(const SpatialIndex& other);
+	SpatialIndex& operator=(const SpatialIndex& other);
+};
@@ -18,6 +18,38 @@ Description
   -A non-instantiable base class defining a cubic Bezier spline
 
 Implementation Notes:
+  -Knots are stored in a fixed-capacity ring buffer, together with
+     copies of their control points, so that segments can be
+     located in constant time, and evaluated without accessing
+     the Knot objects.
+  -Arc length tables are stored per segment, and only the segments
+     whose control points have changed are re-integrated
+     by updateArcLengths(). Each segment's length is computed
+     with adaptive Gauss-Legendre quadrature, separately for several
+     equal intervals of the segment parameter, so that the inverse
+     mapping from arc length to parameter value can be found
+     with a binary search followed by a few Newton iterations.
+  -Each segment is bounded by the axis-aligned box of its control points,
+     which contains their convex hull, and therefore the segment.
+     The boxes are stored in an implicit binary tree whose leaves
+     correspond to the elements of the ring buffer's array,
+     rather than to segment indices, so that adding or removing knots
+     at either end only changes the boxes of the affected segments
+     and their ancestors. updateBounds() recomputes only the boxes
+     of segments whose control points have changed.
+  -Closest point queries traverse the tree, skipping boxes which are
+     farther away than the closest point found so far.
+     Within a segment, the search continues by recursive subdivision
+     of the segment, skipping pieces whose control point boxes are farther away
+     than the closest point found so far. Once a piece is nearly straight,
+     its closest point is found with safeguarded Newton iterations.
+  -Segments are also identified by "slots", the indices in the ring
+     buffer's array of the knots at their starts. Each slot records
+     the value of a counter, incremented whenever a segment changes,
+     at the last change to its segment. Copies of the spline,
+     such as GPU buffers laid out by slot (see SplineUploader),
+     can be brought up to date by copying only the slots whose
+     versions are later than the version of the copy.
   -Remember that a spline cannot be defined until it contains
      at least one segment.
   -Treat a spline with a single knot as a special case
@@ -33,9 +65,47 @@ Implementation Notes:
 
 #include <Windows.h>
 #include <DirectXMath.h>
+#include <vector>
+#include <utility>
+#include <atomic>
 #include "Transformable.h"
 #include "Knot.h"
-#include <list>
+#include "RingBuffer.h"
+
+/* Number of equal parameter intervals per segment
+   for which cumulative arc lengths are stored
+ */
+#define SPLINE_ARC_LENGTH_SAMPLES 8
+
+/* Relative error at which adaptive Gauss-Legendre
+   integration of arc length stops subdividing an interval
+ */
+#define SPLINE_ARC_LENGTH_TOLERANCE 1.0e-5f
+
+// Maximum recursion depth of adaptive arc length integration
+#define SPLINE_ARC_LENGTH_MAX_DEPTH 8
+
+// Maximum number of Newton iterations when converting arc length to parameter values
+#define SPLINE_ARC_LENGTH_NEWTON_ITERATIONS 4
+
+/* Closest point searches subdivide segments until the inner control points
+   of each piece are within this fraction of the length of its chord
+   from the points one third and two thirds of the way along its chord
+ */
+#define SPLINE_CLOSEST_POINT_FLATNESS 0.1f
+
+// Maximum number of times a segment is halved in a closest point search
+#define SPLINE_CLOSEST_POINT_MAX_DEPTH 16
+
+/* Maximum number of safeguarded Newton iterations
+   within each nearly straight piece of a segment in a closest point search
+ */
+#define SPLINE_CLOSEST_POINT_NEWTON_ITERATIONS 16
+
+/* Closest point searches stop when the change in the segment
+   parameter value is at most this amount
+ */
+#define SPLINE_CLOSEST_POINT_TOLERANCE 1.0e-6f
 
 class Spline {
 
@@ -144,6 +214,17 @@ protected:
 	 */
 	virtual HRESULT removeFromEnd(void);
 
+	/* Replaces the control points of 'n' knots, starting from the knot
+	   at index 'first', with control points taken from 'controlPoints'
+	   (four per knot, in the order accepted by Knot::setControlPoints()).
+	   Intended for splines of StaticKnot objects whose control points
+	   are computed in bulk elsewhere.
+	   Returns a failure result, and does nothing, if the knots
+	   extend past the end of the spline.
+	 */
+	HRESULT setKnotControlPoints(const DirectX::XMFLOAT3* const controlPoints,
+		const size_t first, const size_t n);
+
 private:
 	/* Helper function for adding a knot to the spline.
 	   Takes care of ejecting knots if the spline is at capacity.
@@ -176,13 +257,159 @@ public:
 	 */
 	HRESULT eval(Transformable* const transform, const float& t) const;
 
+	/* Evaluates the spline at the 'n' parameter values in 't'
+	   (each wrapped to the interval [0,1]), and outputs the positions
+	   and, if the corresponding pointers are not null,
+	   the first and second derivatives with respect to 't'.
+	   Output arrays must have at least 'n' elements.
+
+	   Parameter values are evaluated four at a time, one per vector lane.
+	   Each segment is evaluated in Horner form, so results may differ
+	   from those of eval() by a few units in the last place
+	   of the largest control point coordinate.
+	   Groups of parameter values in the same segments as the previous group
+	   reuse those segments' polynomial coefficients,
+	   so sorted parameter values are evaluated fastest.
+
+	   Returns a failure result and does nothing if the spline has no segments.
+	 */
+	HRESULT evalBatch(const float* const t, const size_t n,
+		DirectX::XMFLOAT3* const positions,
+		DirectX::XMFLOAT3* const firstDerivatives = 0,
+		DirectX::XMFLOAT3* const secondDerivatives = 0) const;
+
+	/* Arc length parameterization
+	   ---------------------------
+	   Arc lengths are expressed as fractions of the total length
+	   of the spline, in the interval [0,1], so that they can be used
+	   in place of spline parameter values.
+
+	   The following conversion functions return failure results
+	   and do nothing if the spline has no segments,
+	   or if the spline has changed since the last call
+	   to updateArcLengths().
+	 */
+
+	/* Recomputes the arc length tables of segments which
+	   have changed since the last call to this function.
+	   Returns a failure result if the spline has no segments.
+	 */
+	HRESULT updateArcLengths(void);
+
+	/* Returns whether the arc length tables are up to date */
+	bool areArcLengthsValid(void) const;
+
+	/* Outputs the total length of the spline */
+	HRESULT getArcLength(float& length) const;
+
+	/* Outputs the spline parameter value at which the arc length
+	   from the start of the spline is the fraction 's'
+	   (wrapped to the interval [0,1]) of the total length.
+	 */
+	HRESULT arcLengthToT(float& t, const float& s) const;
+
+	/* The inverse of arcLengthToT() */
+	HRESULT tToArcLength(float& s, const float& t) const;
+
+	/* Bounding volumes and proximity queries
+	   --------------------------------------
+	   The following query functions return failure results
+	   and do nothing if the spline has no segments,
+	   or if the spline has changed since the last call
+	   to updateBounds().
+	 */
+
+	/* Recomputes the bounding boxes of segments which
+	   have changed since the last call to this function.
+	   Returns a failure result if the spline has no segments.
+	 */
+	HRESULT updateBounds(void);
+
+	/* Returns whether the bounding boxes are up to date */
+	bool areBoundsValid(void) const;
+
+	/* Outputs the corners of an axis-aligned box containing the spline */
+	HRESULT getBounds(DirectX::XMFLOAT3& min, DirectX::XMFLOAT3& max) const;
+
+	/* Outputs the corners of an axis-aligned box containing
+	   the segment with the given index. Returns a failure result
+	   if the index is not less than getNumberOfSegments().
+	 */
+	HRESULT getSegmentBounds(DirectX::XMFLOAT3& min, DirectX::XMFLOAT3& max,
+		const size_t segmentIndex) const;
+
+	/* Outputs the spline parameter value, 't', and the position
+	   of the point on the spline closest to 'point',
+	   and the distance between the two points.
+	   Note that 't' is 1 if the closest point is the end of the spline,
+	   whereas eval() wraps a 't' of 1 to the start of the spline.
+	 */
+	HRESULT closestPoint(float& t, DirectX::XMFLOAT3& position, float& distance,
+		const DirectX::XMFLOAT3& point) const;
+
+	/* Finds the closest pair of points on the spline, and on the ray
+	   starting at 'origin' in the direction 'direction' (which need not
+	   be normalized), up to a distance of 'maxLength' from the origin.
+	   Outputs the spline parameter value, 't', of the point on the spline,
+	   the distance of the point on the ray from the origin, 'rayDistance',
+	   and the distance between the two points.
+
+	   Returns a failure result if 'direction' is a zero vector,
+	   or if 'maxLength' is not positive.
+	 */
+	HRESULT closestPointToRay(float& t, float& rayDistance, float& distance,
+		const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction,
+		const float maxLength) const;
+
+	/* Change tracking
+	   ---------------
+	   Segment 'i' is stored in slot
+	   '(i + getSegmentSlotOffset()) % getNumberOfSegmentSlots()'.
+	 */
+
+	/* Returns the number of slots, which is one more than the capacity,
+	   as the slot of the last knot does not hold a segment
+	 */
+	size_t getNumberOfSegmentSlots(void) const;
+
+	// Returns the slot of the first segment
+	size_t getSegmentSlotOffset(void) const;
+
+	/* Returns a counter which increases whenever a segment is added,
+	   removed or changed. The version of a new spline is zero.
+	 */
+	UINT64 getVersion(void) const;
+
+	/* Returns a number which is different for every spline
+	   created while the program runs, so that copies of a spline
+	   are not mistaken for copies of a later spline created at the same address
+	 */
+	UINT64 getId(void) const;
+
+	/* Appends to 'ranges' a (first slot, number of slots) pair
+	   for each run of consecutive slots which hold segments that have
+	   been added or changed since the spline had the given version.
+	   Runs do not wrap around from the last slot to the first slot.
+	 */
+	void getChangedSlotRanges(std::vector<std::pair<size_t, size_t> >& ranges,
+		const UINT64 version) const;
+
+	/* Outputs the control points of the segments in 'nSlots' slots,
+	   starting from 'firstSlot', in the same format as getControlPoints().
+	   The control points of slots without segments are output as zero.
+	   Returns a failure result, and does nothing, if the slots
+	   extend past the last slot.
+	 */
+	HRESULT getSlotControlPoints(DirectX::XMFLOAT4* const controlPoints,
+		const size_t firstSlot, const size_t nSlots) const;
+
 	// Spline evaluation helper functions
 private:
 
 	/* Returns false and does nothing if there are no segments
 	   in the spline.
 
-	   Otherwise, returns true and outputs the knots delimiting the segment
+	   Otherwise, returns true and outputs the index of the segment
 	   corresponding to the spline parameter 't',
 	   and outputs the interpolation parameter within
 	   the segment, 'segmentT'.
@@ -190,7 +417,106 @@ private:
 	   't' will be wrapped around if it is less than zero
 	   or greater than 1 to obtain an input value in the interval [0,1].
 	  */
-	bool globalTtoSegmentT(Knot*& preKnot, Knot*& postKnot, float& segmentT, const float& t) const;
+	bool globalTtoSegmentT(size_t& segmentIndex, float& segmentT, const float& t) const;
+
+	/* Outputs the coefficients of the cubic polynomial
+	   a + b*s + c*s^2 + d*s^3 describing the segment at the given index,
+	   where 's' is the interpolation parameter within the segment.
+	 */
+	void getSegmentCoefficients(const size_t segmentIndex,
+		DirectX::XMVECTOR& a, DirectX::XMVECTOR& b,
+		DirectX::XMVECTOR& c, DirectX::XMVECTOR& d) const;
+
+	// Arc length and bounding volume helper functions
+private:
+	/* Marks the arc length table, bounding box and slot of the segment
+	   starting at the given knot index as out of date, if the segment exists.
+	 */
+	void invalidateSegment(const size_t segmentIndex);
+
+	/* Marks the bounding box of the segment in the given slot as out of date,
+	   whether or not the segment exists, and updates the version of the slot.
+	   (Boxes of segments which no longer exist are emptied by updateBounds().)
+	 */
+	void invalidateSlot(const size_t slot);
+
+	/* Returns the arc length of the segment with derivative coefficients
+	   'b', 'c' and 'd' (see getSegmentCoefficients()),
+	   over the segment parameter interval ['start', 'end'],
+	   computed with five-point Gauss-Legendre quadrature.
+	 */
+	static float integrateArcLength(const DirectX::XMVECTOR& b,
+		const DirectX::XMVECTOR& c, const DirectX::XMVECTOR& d,
+		const float start, const float end);
+
+	/* Adaptive version of integrateArcLength(), which subdivides
+	   the interval until the estimate 'whole' for the interval agrees
+	   with the sum of the estimates for its two halves
+	 */
+	static float integrateArcLengthAdaptive(const DirectX::XMVECTOR& b,
+		const DirectX::XMVECTOR& c, const DirectX::XMVECTOR& d,
+		const float start, const float end, const float whole,
+		const size_t depth);
+
+	/* Returns the magnitude of the derivative of the segment
+	   with respect to the segment parameter
+	 */
+	static float segmentSpeed(const DirectX::XMVECTOR& b,
+		const DirectX::XMVECTOR& c, const DirectX::XMVECTOR& d,
+		const float segmentT);
+
+	/* Finds the segment parameter value, 'segmentT', minimizing
+	   the distance from the segment with the given 4 control points
+	   to the ray segment from 'origin' in the unit direction 'direction',
+	   with length 'maxLength'. Closest point queries use a 'maxLength' of zero.
+	   'inverseDirection' holds the reciprocals of the components of 'direction'.
+
+	   Only points whose squared distances are less than 'bound'
+	   are considered. If such a point is found, outputs the distance
+	   along the ray of the closest point on the ray, and returns
+	   the squared distance between the two points. Otherwise,
+	   returns 'bound', and leaves the output parameters unchanged.
+	 */
+	static float closestPointOnSegment(float& segmentT, float& rayDistance,
+		const DirectX::XMFLOAT3* const controlPoints,
+		const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction,
+		const DirectX::XMFLOAT3& inverseDirection,
+		const float maxLength, const float bound);
+
+	/* Shared implementation of closestPoint() and closestPointToRay(),
+	   where 'direction' is a unit vector, and 'maxLength' is zero
+	   for closestPoint(). Returns the squared distance.
+	 */
+	float closestPointToRaySegment(float& t, DirectX::XMFLOAT3& position, float& rayDistance,
+		const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction,
+		const float maxLength) const;
+
+	// Knot storage helper functions
+private:
+	/* Copies the control points of the knot at the given index
+	   into its KnotSlot.
+	 */
+	void refreshControlPoints(const size_t index);
+
+	// Data types
+private:
+	/* A knot, and copies of the control points which it currently has.
+	   Control points missing from the knot are not updated.
+
+	   Also holds the arc length table of the segment
+	   starting at the knot, containing the arc lengths
+	   from the start of the segment to the ends of
+	   each of SPLINE_ARC_LENGTH_SAMPLES equal parameter intervals.
+	 */
+	struct KnotSlot {
+		Knot* knot;
+		DirectX::XMFLOAT3 p2;
+		DirectX::XMFLOAT3 p3;
+		DirectX::XMFLOAT3 p0;
+		DirectX::XMFLOAT3 p1;
+		float arcLengths[SPLINE_ARC_LENGTH_SAMPLES];
+		bool arcLengthValid;
+	};
 
 	// Data members
 private:
@@ -207,8 +533,57 @@ private:
 	/* Same usage as in the DynamicKnot class. */
 	bool m_ownTransforms;
 
-	/* The knots in the spline, implicitly defining its segments. */
-	std::list<Knot*> m_knots;
+	/* The knots in the spline, implicitly defining its segments.
+	   The capacity is one more than the maximum number of segments.
+	 */
+	RingBuffer<KnotSlot> m_knots;
+
+	/* Arc lengths from the start of the spline to the start
+	   of each segment, followed by the total length
+	 */
+	std::vector<float> m_segmentArcLengths;
+
+	/* False if any segment's arc length table is out of date,
+	   or if segments have been added or removed
+	   since 'm_segmentArcLengths' was computed
+	 */
+	bool m_arcLengthsValid;
+
+	/* Node of the bounding box tree. Empty boxes have
+	   'min' greater than 'max'.
+	 */
+	struct BoundsNode {
+		DirectX::XMFLOAT3 min;
+		DirectX::XMFLOAT3 max;
+	};
+
+	/* Implicit binary tree of bounding boxes. The root is at index 1,
+	   and the children of node 'i' are at '2 * i' and '2 * i + 1'.
+	   The leaves start at index 'm_nBoundsLeaves', which is a power of two
+	   at least equal to the capacity of 'm_knots', and leaf
+	   'm_nBoundsLeaves + i' bounds the segment starting at the knot
+	   stored at index 'i' in the ring buffer's array.
+	 */
+	std::vector<BoundsNode> m_boundsTree;
+	size_t m_nBoundsLeaves;
+
+	/* Ring buffer array indices of knots whose segments' boxes are out of date,
+	   with flags to avoid listing indices more than once
+	 */
+	std::vector<size_t> m_staleBounds;
+	std::vector<bool> m_isBoundsStale;
+
+	bool m_boundsValid;
+
+	// Version of the spline, and of the last change to each slot
+	UINT64 m_version;
+	std::vector<UINT64> m_slotVersions;
+
+	/* Unique identifier, and the identifier of the next spline to be created
+	   (atomic, as splines may be constructed on several threads)
+	 */
+	UINT64 m_id;
+	static std::atomic<UINT64> s_nextId;
 
 	// Currently not implemented - will cause linker errors if called
 private:
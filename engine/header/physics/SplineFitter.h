@@ -0,0 +1,267 @@
+/*
+SplineFitter.h
+--------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+Other references:
+  -Philip J. Schneider, "An Algorithm for Automatically Fitting
+     Digitized Curves", Graphics Gems (1990)
+
+Description
+  -Compresses a sequence of cubic Bezier segments, laid out as output
+     by Spline::getControlPoints(), into fewer cubic Bezier segments,
+     such that every sample of the input lies within a maximum distance
+     of the output.
+  -The input is sampled at equal parameter intervals within each segment.
+     Knots of the output are placed at samples, with tangent directions
+     equal to the tangent directions of the input at the samples.
+  -The lengths of the tangent control points are chosen to minimize
+     the sum of squared distances from the samples to the output
+     (linear least squares). C_1 continuity is enforced by giving
+     both sides of each interior knot the same tangent length,
+     which couples neighbouring segments into a tridiagonal system.
+  -Sample parameters are initialized from chord lengths and improved
+     with Newton iterations, as in Schneider's algorithm.
+  -The positions and tangent control points at the ends of the input
+     are preserved, so that the output can replace a run of segments
+     in a longer spline without changing the neighbouring segments.
+  -Knots are placed at nearly equal intervals of chord length, because
+     segments which share tangent lengths must have similar lengths
+     to fit well. Segment lengths change gradually from lengths
+     which match the fixed tangent lengths at the ends.
+     (Splitting only the segments with the largest errors, as in
+     Schneider's algorithm, shortens the tangents of their neighbours.)
+     The smallest number of segments which fits within the maximum error
+     is found by doubling the number of segments, then bisecting.
+  -If no number of segments smaller than the number of input segments
+     fits, the input segments are output unchanged
+     (after the last output segment, if it is refit).
+  -Fitting is incremental: Input segments can be appended
+     to the end of the input from earlier calls to append().
+     All output segments but the last are final. The last output segment
+     is refit together with the appended segments, against the samples
+     of the original input, so errors do not accumulate over refits,
+     and keeping the tangent length at its start.
+     Only the samples covered by the last output segment are retained.
+
+Notes
+  -The output is not reparameterized. A point at a given spline
+     parameter value moves when segments are merged, whereas
+     arc length fractions change only slightly.
+  -Errors are measured at the samples only. Increase the number
+     of samples per segment to reduce the error between samples.
+  -The output never has more segments than the input, but its error
+     may exceed the maximum error if the input appended by append()
+     is not C_1 continuous with the previous input.
+  -This class is not thread-safe, as it reuses internal buffers between fits.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <DirectXMath.h>
+#include <vector>
+
+// Default number of samples taken per input segment
+#define SPLINEFITTER_SAMPLES_PER_SEGMENT 16
+
+/* Number of alternating least squares solutions
+   and Newton reparameterization steps per fitting pass
+ */
+#define SPLINEFITTER_REPARAMETERIZATION_ITERATIONS 3
+
+/* Weight of the bias of each tangent length towards a third of
+   the length of the shorter adjacent chord, relative to the weight
+   of a single sample. Keeps the least squares system well-conditioned
+   when a segment contains few samples.
+ */
+#define SPLINEFITTER_REGULARIZATION 1.0e-3f
+
+/* Tangent lengths smaller than this fraction of the length of the shorter
+   adjacent chord are replaced by a third of the chord length
+ */
+#define SPLINEFITTER_MIN_TANGENT_FRACTION 0.01f
+
+/* Minimum ratio of the lengths of the first and last segments
+   to the fixed tangent lengths at the ends of the input.
+   Longer tangents can form loops between samples.
+ */
+#define SPLINEFITTER_MIN_CHORD_RATIO 1.5f
+
+/* Bounds the ratios of the lengths of the first and last segments
+   to the average segment length, when the lengths of the segments
+   are graded to match the fixed tangent lengths at the ends.
+   The ratios are between SPLINEFITTER_MIN_SLOPE and (2 - SPLINEFITTER_MIN_SLOPE).
+ */
+#define SPLINEFITTER_MIN_SLOPE 0.25f
+
+class SplineFitter {
+
+public:
+	/* 'maxError' is the maximum distance allowed between
+	   each sample of the input and the output, and must be greater than zero.
+
+	   'samplesPerSegment' is the number of samples taken
+	   per input segment, and must be at least 2.
+
+	   The constructor throws an exception if the parameters are invalid.
+	 */
+	SplineFitter(const float maxError,
+		const size_t samplesPerSegment = SPLINEFITTER_SAMPLES_PER_SEGMENT);
+
+	virtual ~SplineFitter(void);
+
+	/* Appends the 'nSegments' segments described by 'controlPoints'
+	   to the input, and fits the input which is not yet final.
+	   'controlPoints' must contain 4 * 'nSegments' control points
+	   (in the order output by Spline::getControlPoints()).
+	   The input is assumed to be C_1 continuous, including at the start
+	   of the appended segments, which should continue from the end
+	   of the input from the previous call to this function.
+
+	   Replaces the contents of 'output' with the control points
+	   of the fitted segments, in the same order, 4 per segment.
+	   The output replaces the last getNumberOfReplacedSegments()
+	   segments output by the previous call to this function.
+	 */
+	HRESULT append(std::vector<DirectX::XMFLOAT3>& output,
+		const DirectX::XMFLOAT4* const controlPoints, const size_t nSegments);
+
+	/* Discards the input, so that the next call to append()
+	   starts a new curve
+	 */
+	void reset(void);
+
+	/* Equivalent to calling reset(), followed by append() */
+	HRESULT fit(std::vector<DirectX::XMFLOAT3>& output,
+		const DirectX::XMFLOAT4* const controlPoints, const size_t nSegments);
+
+	/* Returns the number of segments from the end of the previous output
+	   which are replaced by the output of the next call to append()
+	   (0 after a reset, or 1 otherwise)
+	 */
+	size_t getNumberOfReplacedSegments(void) const;
+
+	float getMaxError(void) const;
+
+	size_t getSamplesPerSegment(void) const;
+
+	// Statistics of the last call to fit()
+public:
+	// Maximum distance from a sample to the output
+	float getLastError(void) const;
+
+	/* Number of numbers of segments which were tried
+	   (Each requires solving for the tangent lengths and measuring the error)
+	 */
+	size_t getLastNumberOfPasses(void) const;
+
+	// Helper functions
+private:
+	/* Adds samples of the input segments to 'm_samples' and 'm_tangents',
+	   replacing the last sample, which is at the start of the input segments
+	 */
+	void sample(const DirectX::XMFLOAT4* const controlPoints, const size_t nSegments);
+
+	/* Assigns each sample a parameter value within its output segment,
+	   proportional to the chord length from the start of the segment
+	 */
+	void parameterizeByChordLength(void);
+
+	/* Solves for the lengths of the tangent control points
+	   of the knots, given the current sample parameters
+	 */
+	void solveTangentLengths(void);
+
+	/* Returns the smaller of the chord lengths of the output segments
+	   adjacent to the knot with the given index
+	 */
+	float shorterChord(const size_t knotIndex) const;
+
+	/* Outputs the control points of the output segment starting
+	   at the knot with the given index
+	 */
+	void getSegment(const size_t knotIndex, DirectX::XMVECTOR* const segment) const;
+
+	/* Improves the parameters of the samples in each output segment
+	   with one Newton iteration towards the closest points on the segment
+	 */
+	void reparameterize(void);
+
+	/* Fits the given number of output segments to the samples,
+	   and returns true if the error is within the limit
+	 */
+	bool fitSegments(const size_t nSegments);
+
+	/* Fits output segments with the current knots to the samples,
+	   and returns true if the error is within the limit
+	 */
+	bool fitKnots(void);
+
+	/* Places knots at the samples closest to gradually changing
+	   intervals of chord length
+	 */
+	void placeKnots(const size_t nSegments);
+
+	/* Places knots at the ends of the last output segment
+	   (if 'nOldSamples' is not zero) and of the input segments,
+	   with the tangent lengths of the input, which reproduces the input
+	 */
+	void fitInputKnots(const DirectX::XMFLOAT4* const controlPoints,
+		const size_t nOldSamples, const size_t nSegments);
+
+	// Returns the largest distance from a sample to the output
+	float measureError(void) const;
+
+	// Data members
+private:
+	float m_maxError;
+	size_t m_samplesPerSegment;
+
+	/* Sample positions and unit tangent directions, starting from
+	   the start of the last output segment
+	 */
+	std::vector<DirectX::XMFLOAT3> m_samples;
+	std::vector<DirectX::XMFLOAT3> m_tangents;
+
+	// Cumulative chord lengths at the samples
+	std::vector<float> m_chordLengths;
+
+	/* Parameter of each sample within its output segment.
+	   (The parameters of samples at knots are not used.)
+	 */
+	std::vector<float> m_parameters;
+
+	// Sample indices of the knots of the output
+	std::vector<size_t> m_knots;
+
+	/* Lengths of the tangent control points at the knots,
+	   along the tangent directions of the samples at the knots
+	 */
+	std::vector<float> m_tangentLengths;
+
+	// Scratch storage for the tridiagonal solver
+	std::vector<float> m_diagonal;
+	std::vector<float> m_offDiagonal;
+	std::vector<float> m_rhs;
+
+	/* Lengths of the tangent control points at the start of the samples
+	   (shared with the previous output, or from the input),
+	   and at the end of the input, which are not changed by the fit
+	 */
+	float m_startTangentLength;
+	float m_endTangentLength;
+
+	float m_lastError;
+	size_t m_lastNumberOfPasses;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	SplineFitter(const SplineFitter& other);
+	SplineFitter& operator=(const SplineFitter& other);
+};
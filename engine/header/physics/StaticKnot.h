@@ -23,6 +23,7 @@ Description
 #include <Windows.h>
 #include <DirectXMath.h>
 #include "Knot.h"
+#include "SlabPool.h"
 
 class StaticKnot : public Knot {
 
@@ -40,6 +41,20 @@ public:
 	/* Does nothing - Control points are static. */
 	virtual HRESULT update(const DWORD currentTime, const DWORD updateTimeInterval) override;
 
+	/* Instances are allocated from a pool shared by all StaticKnots.
+	   Objects of further derived classes, which have different sizes,
+	   are allocated from the global heap.
+	 */
+public:
+	static void* operator new(const size_t size);
+	static void operator delete(void* const object, const size_t size);
+
+	/* Outputs the allocation statistics of the pool */
+	static void getPoolTelemetry(SlabPool::Telemetry& telemetry);
+
+private:
+	static SlabPool s_pool;
+
 	// Currently not implemented - will cause linker errors if called
 private:
 	StaticKnot(const StaticKnot& other);
@@ -0,0 +1,232 @@
+/*
+SweepAndPrune.h
+---------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: SpatialIndex.h
+Other references:
+  -Christer Ericson, Real-Time Collision Detection (2005), section 7.5
+  -Pierre Terdiman, "Sweep-and-prune" (2007)
+
+Description
+  -A collision broadphase which finds all pairs of overlapping objects
+     among a set of moving Transformable objects.
+  -Each object is bounded by a sphere centred at the translation
+     of its world transform, with a radius of Transformable::m_radius,
+     interpreted as a world-space radius (as in SpatialIndex).
+  -The objects are kept sorted by the lower bounds of their spheres
+     along one axis, the axis along which the sphere centres
+     are most spread out. Each update() re-sorts the objects
+     with an insertion sort, which takes close to linear time when
+     the objects move only slightly between updates, then sweeps along
+     the axis, testing only objects whose intervals on the axis overlap.
+  -The time taken by the sweep is proportional to the number of pairs
+     of objects whose intervals overlap on the sweep axis. For large numbers
+     of objects spread evenly in all three dimensions, this grows faster
+     than the number of objects, and SpatialIndex queries may be faster.
+  -Pairs are reported only if the bounding spheres overlap,
+     and only if each object's category is accepted by the other
+     object's mask. For example, static objects can be given a mask
+     which excludes their own category, so that they are not
+     tested against each other.
+  -Overlapping pairs persist between updates. Each update() outputs
+     an event for each pair which started overlapping (BEGIN),
+     which continued to overlap (STAY), or which stopped overlapping,
+     or had one of its objects removed (END).
+
+Notes
+  -Objects must be removed before they are destroyed.
+     After an object is removed, its identifier is not reused
+     until the next call to update(), so that END events
+     for its pairs can be reported unambiguously.
+  -Event and pair lists are sorted by object identifiers,
+     and so do not depend on the order in which pairs were found.
+  -This class is not thread-safe.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <DirectXMath.h>
+#include <vector>
+#include "Transformable.h"
+
+// Category and mask value which includes all categories
+#define SWEEPANDPRUNE_CATEGORY_ALL 0xffffffffU
+
+/* The sweep axis is changed only if the spread of the objects
+   along another axis is larger than the spread along the current axis
+   by this factor, to avoid alternating between axes.
+ */
+#define SWEEPANDPRUNE_AXIS_HYSTERESIS 1.5f
+
+/* If more than this fraction of the objects were added since the last update,
+   the objects are re-sorted from scratch, rather than with an insertion sort.
+ */
+#define SWEEPANDPRUNE_FULL_SORT_FRACTION 0.125f
+
+class SweepAndPrune {
+
+public:
+	enum class EventType : unsigned int {
+		BEGIN, // The pair started overlapping during the last update
+		STAY, // The pair was already overlapping, and is still overlapping
+		END // The pair stopped overlapping, or one of its objects was removed
+	};
+
+	struct Event {
+		EventType type;
+
+		// The first identifier is less than the second
+		size_t id1;
+		size_t id2;
+
+		/* Null for objects which have been removed
+		   (in which case the event is an END event)
+		 */
+		const Transformable* transform1;
+		const Transformable* transform2;
+	};
+
+	// An overlapping pair of objects, with 'id1' less than 'id2'
+	struct Pair {
+		size_t id1;
+		size_t id2;
+	};
+
+public:
+	/* 'capacity' is the number of objects for which storage
+	   will be reserved initially.
+	 */
+	SweepAndPrune(const size_t capacity = 0);
+
+	virtual ~SweepAndPrune(void);
+
+	// Modification
+public:
+	/* Adds the object, and outputs its identifier in 'id'.
+	   The object is not owned by this object.
+	   Pairs involving the object are reported starting from the next update.
+	 */
+	HRESULT add(size_t& id, const Transformable* const transform,
+		const unsigned int category = SWEEPANDPRUNE_CATEGORY_ALL,
+		const unsigned int mask = SWEEPANDPRUNE_CATEGORY_ALL);
+
+	/* END events for the object's pairs
+	   are reported during the next update.
+	 */
+	HRESULT remove(const size_t id);
+
+	/* Reads the current bounds of all objects,
+	   finds all overlapping pairs, and computes the list of events.
+	 */
+	HRESULT update(void);
+
+	// Removes all objects, without generating events
+	void clear(void);
+
+	// Inspection
+public:
+	/* Events from the last call to update(), sorted by identifiers */
+	const std::vector<Event>& getEvents(void) const;
+
+	/* Overlapping pairs as of the last call to update(), sorted by identifiers */
+	const std::vector<Pair>& getPairs(void) const;
+
+	size_t getCount(void) const;
+
+	// Returns null if 'id' is not a valid identifier
+	const Transformable* getTransformable(const size_t id) const;
+
+	// Index (0, 1 or 2) of the axis along which objects are sorted
+	size_t getAxis(void) const;
+
+	/* Number of times that objects were moved past each other
+	   by the insertion sort in the last call to update(),
+	   or the number of objects, if they were re-sorted from scratch
+	 */
+	size_t getNumberOfSwaps(void) const;
+
+	/* Number of pairs of objects whose intervals overlapped
+	   on the sweep axis, in the last call to update()
+	 */
+	size_t getNumberOfTests(void) const;
+
+	// Helper functions
+private:
+	struct Object {
+		const Transformable* transform;
+		DirectX::XMFLOAT3 center;
+		float radius;
+		unsigned int category;
+		unsigned int mask;
+		bool isActive;
+	};
+
+	/* Extent of an object along the sweep axis, with a copy of the data
+	   needed to test it against other objects, so that the sweep
+	   reads memory sequentially
+	 */
+	struct Interval {
+		float min;
+		float max;
+		size_t id;
+		DirectX::XMFLOAT3 center;
+		float radius;
+		unsigned int category;
+		unsigned int mask;
+	};
+
+	// Reads the bounding sphere of the object
+	void readBounds(Object& object) const;
+
+	/* Chooses the sweep axis, and returns true
+	   if it is different from the previous axis
+	 */
+	bool chooseAxis(void);
+
+	/* Fills 'm_pairs' with the overlapping pairs.
+	   'm_intervals' must be sorted.
+	 */
+	void sweep(void);
+
+	/* Computes events by comparing 'm_pairs'
+	   with 'm_previousPairs'
+	 */
+	void computeEvents(void);
+
+	// Data members
+private:
+	// Indexed by identifier
+	std::vector<Object> m_objects;
+
+	// Identifiers available for reuse
+	std::vector<size_t> m_freeIds;
+
+	// Identifiers of objects removed since the last update
+	std::vector<size_t> m_removedIds;
+
+	// Sorted by lower bound, for active objects
+	std::vector<Interval> m_intervals;
+
+	// Number of objects added since the last update
+	size_t m_nAdded;
+
+	size_t m_axis;
+
+	std::vector<Pair> m_pairs;
+	std::vector<Pair> m_previousPairs;
+	std::vector<Event> m_events;
+
+	size_t m_nSwaps;
+	size_t m_nTests;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	SweepAndPrune(const SweepAndPrune& other);
+	SweepAndPrune& operator=(const SweepAndPrune& other);
+};
@@ -0,0 +1,159 @@
+/*
+TransformBuffer.h
+-----------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Double-buffered storage of world transformations, which allows
+     the simulation to update the next frame while the renderer
+     draws the previous frame.
+  -Each buffer holds, for every slot, a world transformation
+     and the world transformation from the previous simulation step
+     (for render interpolation, as in TransformSystem).
+  -The simulation writes only to the back buffer, between calls
+     to beginWrite() and endWrite(). The renderer reads only from
+     the front buffer, between calls to beginRead() and endRead().
+     Neither side blocks the other.
+  -flip() swaps the front and back buffers by exchanging two pointers.
+     It must be called while neither side is active, typically by the
+     main loop after waiting for both the update and the render to finish.
+  -Slots which were written in the frame that was last published are copied
+     from the front buffer to the back buffer by the first call to beginWrite()
+     after a flip, so that the simulation only needs to write the slots
+     which change. beginWrite() and endWrite() can be called several times
+     per frame (e.g. once per fixed simulation step).
+     (The front buffer is not modified, so this copy
+     can overlap with the renderer's reads.)
+
+Notes
+  -Only one thread may write, between beginWrite() and endWrite(),
+     but any number of threads may read, between beginRead() and endRead().
+  -The number of slots can only be changed while neither side is active.
+  -Functions called at the wrong time fail with ERROR_WRONG_STATE,
+     rather than blocking.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <DirectXMath.h>
+#include <vector>
+#include <atomic>
+
+class Transformable;
+class TransformSystem;
+
+class TransformBuffer {
+
+public:
+	/* Creates a buffer with 'size' slots,
+	   all holding identity transformations
+	 */
+	TransformBuffer(const size_t size = 0);
+
+	virtual ~TransformBuffer(void);
+
+	/* Changes the number of slots. New slots hold identity transformations.
+	   Fails if a read or a write is in progress.
+	 */
+	HRESULT resize(const size_t size);
+
+	size_t getSize(void) const;
+
+	/* Swaps the front and back buffers, publishing the transformations
+	   written since the last flip. Fails if a read or a write is in progress.
+	 */
+	HRESULT flip(void);
+
+	/* Number of calls to flip() which succeeded.
+	   The front buffer holds the transformations written
+	   before the flip with this number.
+	 */
+	unsigned long getFrameNumber(void) const;
+
+	// Simulation side
+public:
+	/* Starts writing the next frame to the back buffer.
+	   Fails if a write is already in progress.
+	 */
+	HRESULT beginWrite(void);
+
+	HRESULT endWrite(void);
+
+	/* Stores the current and previous world transformations of a slot
+	   in the back buffer
+	 */
+	HRESULT write(const size_t slot, const DirectX::XMFLOAT4X4& worldTransform,
+		const DirectX::XMFLOAT4X4& previousWorldTransform);
+
+	/* Stores the world transformations of the object in the given slot */
+	HRESULT write(const size_t slot, const Transformable& transformable);
+
+	/* Stores the world transformations of the first getSize() slots
+	   of the TransformSystem (or of all of its slots, if it has fewer)
+	   in the slots with the same indices
+	 */
+	HRESULT write(const TransformSystem& system);
+
+	// Render side
+public:
+	/* Starts reading the front buffer */
+	HRESULT beginRead(void);
+
+	HRESULT endRead(void);
+
+	HRESULT getWorldTransform(const size_t slot, DirectX::XMFLOAT4X4& worldTransform) const;
+
+	/* Outputs the world transformation 'alpha' of the way from the previous
+	   world transformation to the current world transformation,
+	   interpolated by TransformSystem::interpolate()
+	 */
+	HRESULT getInterpolatedWorldTransform(const size_t slot, DirectX::XMFLOAT4X4& worldTransform, const float alpha) const;
+
+	/* Contiguous array of getSize() world transformations in the front buffer,
+	   valid until the next call to flip() or resize()
+	 */
+	const DirectX::XMFLOAT4X4* getWorldTransforms(void) const;
+
+	// Helper functions
+private:
+	/* Marks a slot of the back buffer as written in the current frame */
+	void markWritten(const size_t slot);
+
+	// Data members
+private:
+	struct Frame {
+		std::vector<DirectX::XMFLOAT4X4> m_worldTransform;
+		std::vector<DirectX::XMFLOAT4X4> m_previousWorldTransform;
+
+		// Slots written while this was the back buffer
+		std::vector<size_t> m_written;
+		std::vector<bool> m_isWritten;
+	};
+
+	Frame m_frames[2];
+	Frame* m_front;
+	Frame* m_back;
+
+	size_t m_size;
+	unsigned long m_frameNumber;
+
+	/* True if the back buffer has been brought up to date
+	   with the front buffer since the last flip
+	 */
+	bool m_isBackCurrent;
+
+	std::atomic<bool> m_writing;
+	std::atomic<unsigned int> m_nReaders;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	TransformBuffer(const TransformBuffer& other);
+	TransformBuffer& operator=(const TransformBuffer& other);
+};
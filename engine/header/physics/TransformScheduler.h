@@ -0,0 +1,135 @@
+/*
+TransformScheduler.h
+--------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Updates a set of Transformable objects in an order which guarantees
+     that each object is updated after its parent.
+  -Objects are sorted into levels by their depth in the hierarchy.
+     A parent which is not in the set is treated as already up to date,
+     so objects whose parents are not in the set are at level zero.
+  -Objects in the same level do not depend on each other, and are
+     updated in parallel by a WorkerPool. Each level is split
+     into chunks of consecutive objects, which are the units of work
+     given to the worker threads.
+  -Once a level contains enough objects to keep all threads busy,
+     the objects in that level are instead used as the roots of subtrees.
+     Each subtree is stored contiguously, in parent-before-child order,
+     and is updated from start to finish by a single thread.
+     This avoids synchronizing the threads after every level
+     of deep hierarchies, and keeps each thread working on
+     closely-related objects.
+  -The results are independent of the number of threads, because
+     each object's update reads only its own state and that of its parent.
+
+Notes
+  -Objects whose update() functions modify shared state
+     should not be updated by a scheduler with more than one thread.
+  -The hierarchy must not change between calls to setTransformables()
+     and update(). Call setTransformables() again after
+     parent-child relationships change.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include "Transformable.h"
+#include "WorkerPool.h"
+
+// Default minimum number of objects in each unit of parallel work
+#define TRANSFORMSCHEDULER_CHUNK_SIZE_DEFAULT 64
+
+/* Number of subtrees per thread needed before the scheduler
+   stops synchronizing the threads after each level
+ */
+#define TRANSFORMSCHEDULER_SUBTREES_PER_THREAD 4
+
+class TransformScheduler {
+
+public:
+	/* 'pool' is not deleted by this object, and can be shared
+	   with other objects. If 'pool' is null, all updates are performed
+	   on the calling thread, one subtree at a time.
+	 */
+	TransformScheduler(WorkerPool* const pool = 0,
+		const size_t chunkSize = TRANSFORMSCHEDULER_CHUNK_SIZE_DEFAULT);
+
+	virtual ~TransformScheduler(void);
+
+	/* Replaces the set of objects to be updated, and sorts them
+	   into levels and subtrees. Objects in the same level or subtree
+	   remain in the same relative order as in the input.
+	   The objects are not owned by this object.
+	   Fails if there are null or duplicate elements,
+	   or cycles in the hierarchy.
+	 */
+	HRESULT setTransformables(const std::vector<Transformable*>& transformables);
+
+	/* Updates all objects. Stops after the first level,
+	   or set of subtrees, in which an update fails.
+	 */
+	HRESULT update(const DWORD currentTime, const DWORD updateTimeInterval);
+
+	size_t getNumberOfTransformables(void) const;
+
+	// Returns the depth of the deepest object, plus one
+	size_t getNumberOfLevels(void) const;
+
+	/* Returns the number of times update() waits
+	   for all threads to finish their work
+	 */
+	size_t getNumberOfPhases(void) const;
+
+	/* Returns the number of objects, during the last call to update(),
+	   which did not need to recompute their world transforms
+	   (see Transformable::wasUpdateSkipped()).
+	 */
+	size_t getNumberOfSkippedUpdates(void) const;
+
+protected:
+	/* Updates the objects in the given chunk, and stores the outcome
+	   in the elements of 'm_chunkSkipped' and 'm_chunkResults'
+	   at index 'chunk'.
+	 */
+	void updateChunk(const size_t chunk, const DWORD currentTime, const DWORD updateTimeInterval);
+
+	// Data members
+private:
+	WorkerPool* m_pool;
+	size_t m_chunkSize;
+
+	// Objects sorted by level, and then by subtree
+	std::vector<Transformable*> m_ordered;
+
+	size_t m_nLevels;
+
+	/* Indices in 'm_ordered' of the first objects in each chunk,
+	   with an extra element at the end equal to the number of objects
+	 */
+	std::vector<size_t> m_chunkStart;
+
+	/* Indices in 'm_chunkStart' of the first chunks in each phase,
+	   with an extra element at the end equal to the number of chunks.
+	   All chunks in a phase can be updated in parallel.
+	 */
+	std::vector<size_t> m_phaseStart;
+
+	// Outcomes of the chunks
+	std::vector<size_t> m_chunkSkipped;
+	std::vector<HRESULT> m_chunkResults;
+
+	size_t m_nSkipped;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	TransformScheduler(const TransformScheduler& other);
+	TransformScheduler& operator=(const TransformScheduler& other);
+};
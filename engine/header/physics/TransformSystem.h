@@ -0,0 +1,263 @@
+/*
+TransformSystem.h
+-----------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: Transformable.h
+
+Description
+  -Stores the state of many simple transformations in structure-of-arrays form
+     (position, orientation, scale, linear velocity and angular momentum),
+     and updates them in batches, four at a time, using DirectXMath vector operations.
+  -World transformations, with and without scaling, are written
+     to contiguous arrays of matrices, which can be read directly
+     by code that needs all of them (e.g. for copying to a GPU buffer).
+  -The update rules are the same as those of Transformable::update(),
+     for a Transformable which does not override transformations().
+  -Transformable objects can act as thin handles into a TransformSystem,
+     by calling Transformable::bindToSystem().
+  -The world transformations from before the last update are kept,
+     for render interpolation between fixed simulation steps.
+  -Transformations which will not move can be baked (see bake()),
+     so that their world transformations are computed once, and then
+     skipped by update().
+
+Notes
+  -Parent transformations must be added before their children,
+     such that a parent's index is always less than those of its children.
+     This allows the hierarchical part of the update to be done
+     with a single forward pass over the arrays.
+  -Removed slots are reused by later additions, when doing so
+     preserves the above ordering requirement.
+  -update() skips batches of slots which are all baked or free,
+     so baking pays off most when the transformations baked
+     were added consecutively.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <DirectXMath.h>
+#include <vector>
+
+// Index value indicating that a transformation has no parent
+#define TRANSFORMSYSTEM_NO_PARENT static_cast<size_t>(-1)
+
+// Number of transformations processed together by the vectorized update loops
+#define TRANSFORMSYSTEM_BATCH_SIZE 4
+
+class TransformSystem {
+
+public:
+	/* 'capacity' is the number of transformations for which
+	   storage will be reserved initially.
+	 */
+	TransformSystem(const size_t capacity = 0);
+
+	virtual ~TransformSystem(void);
+
+public:
+	/* Adds a transformation to the system, and outputs its index in 'index'.
+	   The orientation quaternion will be normalized.
+
+	   'parent' must be TRANSFORMSYSTEM_NO_PARENT, or the index
+	   of a transformation currently in this system.
+	 */
+	virtual HRESULT add(size_t& index, const DirectX::XMFLOAT3& scale,
+		const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT4& orientation,
+		const size_t parent = TRANSFORMSYSTEM_NO_PARENT);
+
+	/* Frees the slot at the given index.
+	   Any children of the transformation will no longer have a parent.
+	 */
+	virtual HRESULT remove(const size_t index);
+
+	/* Integrates the linear and angular motion of all transformations
+	   which are not baked over the given time interval,
+	   and then recomputes their world transformations.
+	 */
+	virtual HRESULT update(const DWORD updateTimeInterval);
+
+	/* Computes the world transformations of the given transformation
+	   from its current state, and freezes them. From then on, update()
+	   ignores the transformation's linear and angular motion,
+	   and does not recompute its world transformations.
+	   The previous world transformation is made equal to the current one.
+
+	   Fails if the transformation has a parent which is not baked.
+	   Does nothing if the transformation is already baked.
+	 */
+	HRESULT bake(const size_t index);
+
+	/* Returns a baked transformation to the per-frame update,
+	   along with any baked transformations below it in the hierarchy.
+	   The setters below, and remove(), call this function,
+	   so that moving a baked transformation unbakes it.
+	   Does nothing if the transformation is not baked.
+	 */
+	HRESULT unbake(const size_t index);
+
+	bool isBaked(const size_t index) const;
+
+	// Per-transformation state access
+public:
+	HRESULT getWorldTransform(const size_t index, DirectX::XMFLOAT4X4& worldTransform) const;
+	HRESULT getWorldTransformNoScale(const size_t index, DirectX::XMFLOAT4X4& worldTransformNoScale) const;
+
+	/* Outputs the world transformation 'alpha' of the way from the world
+	   transformation before the last update to the current world transformation
+	 */
+	HRESULT getInterpolatedWorldTransform(const size_t index, DirectX::XMFLOAT4X4& worldTransform, const float alpha) const;
+
+	/* Outputs the world transformation before the last update */
+	HRESULT getPreviousWorldTransform(const size_t index, DirectX::XMFLOAT4X4& previousWorldTransform) const;
+
+	/* Makes the previous world transformation equal to the current world transformation */
+	HRESULT resetInterpolation(const size_t index);
+
+	HRESULT getScale(const size_t index, DirectX::XMFLOAT3& scale) const;
+	HRESULT getPosition(const size_t index, DirectX::XMFLOAT3& position) const;
+	HRESULT getOrientation(const size_t index, DirectX::XMFLOAT4& orientation) const;
+
+	HRESULT setScale(const size_t index, const DirectX::XMFLOAT3& scale);
+	HRESULT setPosition(const size_t index, const DirectX::XMFLOAT3& position);
+
+	/* Expects a valid, normalized quaternion as input */
+	HRESULT setOrientation(const size_t index, const DirectX::XMFLOAT4& orientation);
+
+	/* 'direction' is expected to be a unit vector,
+	   and 'speed' is in units per second, as in the Transformable class.
+	 */
+	HRESULT setLinearVelocity(const size_t index, const DirectX::XMFLOAT3& direction, const float speed);
+
+	/* The quaternion multiplied into the orientation at each update */
+	HRESULT setAngularMomentum(const size_t index, const DirectX::XMFLOAT4& angularMomentum);
+
+	/* 'parent' must be TRANSFORMSYSTEM_NO_PARENT,
+	   or an index less than 'index'.
+	 */
+	HRESULT setParent(const size_t index, const size_t parent);
+	size_t getParent(const size_t index) const;
+
+	// Bulk access
+public:
+	/* Number of slots, including free slots.
+	   Valid indices are in the range [0, getSize()).
+	 */
+	size_t getSize(void) const;
+
+	/* Number of slots in use */
+	size_t getCount(void) const;
+
+	/* Number of baked slots */
+	size_t getNumberOfBaked(void) const;
+
+	bool isInUse(const size_t index) const;
+
+	/* Contiguous arrays of getSize() matrices,
+	   invalidated by add() when the arrays grow.
+	   Free slots contain identity matrices.
+	 */
+	const DirectX::XMFLOAT4X4* getWorldTransforms(void) const;
+	const DirectX::XMFLOAT4X4* getWorldTransformsNoScale(void) const;
+	const DirectX::XMFLOAT4X4* getPreviousWorldTransforms(void) const;
+
+	/* Interpolates between two world transformations, by decomposing them
+	   into scale, rotation and translation components. The translation
+	   and scale are interpolated linearly, and the rotation is interpolated
+	   spherically. If either transformation cannot be decomposed,
+	   the matrix elements are interpolated linearly.
+	 */
+	static void interpolate(DirectX::XMFLOAT4X4& out, const DirectX::XMFLOAT4X4& previous,
+		const DirectX::XMFLOAT4X4& current, const float alpha);
+
+protected:
+	/* Resizes all arrays so that they hold at least 'size' elements,
+	   padded to a multiple of the batch size.
+	   New slots are initialized as free identity transformations.
+	 */
+	void grow(const size_t size);
+
+	/* Resets the given slot to the identity transformation, with no motion */
+	void clear(const size_t index);
+
+	/* Marks a slot in use as updated every frame (true), or as baked (false) */
+	void setDynamic(const size_t index, const bool dynamic);
+
+	/* Applies linear and angular velocities to positions and orientations */
+	void integrate(const DWORD updateTimeInterval);
+
+	/* Computes world transformations for all slots,
+	   ignoring the parent hierarchy
+	 */
+	void computeLocalTransforms(void);
+
+	/* Multiplies in parent transformations, in index order */
+	void computeHierarchy(void);
+
+	bool isValidIndex(const size_t index) const;
+
+	// Data members
+protected:
+	/* Structure-of-arrays state.
+	   All arrays have the same length, a multiple of TRANSFORMSYSTEM_BATCH_SIZE.
+	 */
+	std::vector<float> m_px, m_py, m_pz; // Position
+	std::vector<float> m_qx, m_qy, m_qz, m_qw; // Orientation quaternion
+	std::vector<float> m_sx, m_sy, m_sz; // Scale
+	std::vector<float> m_dx, m_dy, m_dz; // Linear velocity direction
+	std::vector<float> m_speed; // Linear speed (units per second)
+	std::vector<float> m_lx, m_ly, m_lz, m_lw; // Angular momentum quaternion
+
+	std::vector<size_t> m_parent;
+	std::vector<size_t> m_nChildren;
+	std::vector<bool> m_inUse;
+
+	/* 1 for slots updated by update(), and 0 for baked and free slots
+	   (stored as floats for use as a mask by the vectorized loops)
+	 */
+	std::vector<float> m_dynamic;
+
+	/* Number of slots updated by update() in each batch,
+	   used to skip batches of baked and free slots
+	 */
+	std::vector<size_t> m_nDynamicInBatch;
+
+	// Outputs
+	std::vector<DirectX::XMFLOAT4X4> m_worldTransform;
+	std::vector<DirectX::XMFLOAT4X4> m_worldTransformNoScale;
+
+	// World transformations before the last update, for render interpolation
+	std::vector<DirectX::XMFLOAT4X4> m_previousWorldTransform;
+
+	/* Slots added since the last update, whose previous world transformations
+	   will be set equal to their first computed world transformations
+	 */
+	std::vector<size_t> m_newSlots;
+
+	/* Number of slots in use, and the number of slots in the arrays
+	   not counting padding to the batch size
+	 */
+	size_t m_count;
+	size_t m_size;
+
+	/* Number of slots with a parent,
+	   used to skip the hierarchical pass when zero
+	 */
+	size_t m_nWithParent;
+
+	// Number of baked slots
+	size_t m_nBaked;
+
+	// Indices of free slots, in no particular order
+	std::vector<size_t> m_freeList;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	TransformSystem(const TransformSystem& other);
+	TransformSystem& operator=(const TransformSystem& other);
+};
@@ -33,6 +33,26 @@ How To Use:
  transformation, object transformations, and you'll have to save the modified matrix to 
  the world space matrix (worldTransform and worldTransformNoScale).
 -The position of the object in world space is represented by m_worldTransform.
+-Lazy evaluation: update() skips recomputing the world transforms when the object
+ is at rest (zero speed and identity angular momentum), when its local state
+ has not changed since the last recomputation, when its parent's world transform
+ has not changed since then (tracked with version counters), and when transformations()
+ produced the same matrix as at the last recomputation. The results are identical to those obtained
+ when the matrices are recomputed every frame. Derived classes which modify
+ m_position, m_orientation or m_scale directly must call markLocalChanged().
+-Objects which do not override update() or transformations() can be bound
+ to a TransformSystem with bindToSystem(). Their state is then stored and updated
+ by the TransformSystem, and update() does nothing. Use setLinearVelocity()
+ and setAngularMomentum(), rather than the public motion variables,
+ to change the motion of a bound object.
+-Bound objects which never move can be baked with bake(), so that the TransformSystem
+ computes their world transforms once, instead of every frame.
+-Render interpolation: update() keeps the world transform from before the last
+ update. While a render interpolation factor less than one is set, with
+ setRenderInterpolation(), getWorldTransform() returns a transform blended
+ between the previous and current world transforms, for rendering between
+ fixed simulation steps (see FixedTimestep). Call resetInterpolation() after
+ teleporting an object, so that it is not drawn moving from its old location.
 */
 
 #pragma once
@@ -42,6 +62,8 @@ How To Use:
 #include "ITransformable.h"
 #include "engineGlobals.h"
 
+class TransformSystem;
+
 ////////////////////////////////////////////////////////////////////////////////
 // Class name: Transformable
 ////////////////////////////////////////////////////////////////////////////////
@@ -73,13 +95,63 @@ public:
 	float m_speed; // Local linear speed (units per second)
 	float m_radius;
 
+	// TransformSystem binding
+protected:
+	TransformSystem* m_system; // Shared - not deleted by the destructor
+	size_t m_systemIndex;
+
+	// Lazy evaluation state
+protected:
+	/* Incremented when position, orientation or scale change,
+	   or when the world transforms change, respectively.
+	 */
+	unsigned long m_localVersion;
+	unsigned long m_worldVersion;
+
+	/* Values of the version counters, the parent, and the output
+	   of transformations(), used by the last recomputation of the world transforms
+	 */
+	unsigned long m_computedLocalVersion;
+	unsigned long m_computedParentVersion;
+	const Transformable* m_computedParent;
+	DirectX::XMFLOAT4X4 m_computedTransformations;
+	bool m_hasComputed;
+
+	// True if the last call to update() did not recompute the world transforms
+	bool m_updateSkipped;
+
+	// World transform before the last call to update(), used for render interpolation
+	DirectX::XMFLOAT4X4 m_previousWorldTransform;
+
+	// Enables or disables lazy evaluation for all objects
+	static bool s_lazyEvaluation;
+
+	// Interpolation factor applied by getWorldTransform()
+	static float s_renderInterpolation;
+
 public:
 	Transformable(DirectX::XMFLOAT3& scale, DirectX::XMFLOAT3& position, DirectX::XMFLOAT4& orientation);
 
 	virtual ~Transformable(void);
 
+	/* Returns the interpolated world transform
+	   if a render interpolation factor less than one is set.
+	 */
 	virtual HRESULT getWorldTransform(DirectX::XMFLOAT4X4& worldTransform) const override;
 
+	/* Outputs the world transform 'alpha' of the way from the world transform
+	   before the last update to the current world transform.
+	   The translation and scale are interpolated linearly, and
+	   the rotation is interpolated spherically.
+	 */
+	HRESULT getInterpolatedWorldTransform(DirectX::XMFLOAT4X4& worldTransform, const float alpha) const;
+
+	/* Outputs the current world transform and the world transform
+	   before the last update, regardless of the render interpolation factor
+	   (for copying the results of an update to a TransformBuffer)
+	 */
+	HRESULT getWorldTransforms(DirectX::XMFLOAT4X4& worldTransform, DirectX::XMFLOAT4X4& previousWorldTransform) const;
+
 	virtual HRESULT getWorldTransformNoScale(DirectX::XMFLOAT4X4& worldTransformNoScale) const;
 
 	/* Computes the world-space direction vector (normalized)
@@ -102,8 +174,60 @@ public:
 
 	virtual HRESULT update(const DWORD currentTime, const DWORD updateTimeInterval);
 
+	/* If this object is bound to a TransformSystem,
+	   the parent must be bound to the same TransformSystem,
+	   and must have been bound before this object.
+	 */
 	HRESULT setParent(Transformable* const parent);
 
+	/* Moves this object's state into the TransformSystem, which will
+	   be responsible for updating it from now on. The TransformSystem
+	   must outlive this object. If this object has a parent,
+	   the parent must already be bound to the same TransformSystem.
+	 */
+	HRESULT bindToSystem(TransformSystem* const system);
+	bool isBoundToSystem(void) const;
+
+	/* Bound objects which will not move can be baked, so that their
+	   world transforms are computed once and then skipped by
+	   TransformSystem::update() (see TransformSystem::bake()).
+	   Moving a baked object, using the setters or the functions
+	   which move and spin the object, unbakes it.
+	   These functions fail for objects which are not bound.
+	 */
+	HRESULT bake(void);
+	HRESULT unbake(void);
+	bool isBaked(void) const;
+
+	/* Lazy evaluation is enabled by default. Disabling it makes update()
+	   recompute the world transforms of every object on every call.
+	 */
+	static void setLazyEvaluation(const bool enable);
+	static bool getLazyEvaluation(void);
+
+	/* Sets the interpolation factor used by getWorldTransform() for all objects.
+	   It should be set to a value in [0, 1) before rendering, and reset
+	   to 1 (the default, meaning no interpolation) after rendering,
+	   so that simulation code sees the current world transforms.
+	 */
+	static void setRenderInterpolation(const float alpha);
+	static float getRenderInterpolation(void);
+
+	/* Makes the previous world transform equal to the current world transform */
+	void resetInterpolation(void);
+
+	/* Returns true if the last call to update() found that the world transforms
+	   were already up to date, and therefore did not recompute them.
+	 */
+	bool wasUpdateSkipped(void) const;
+
+	/* A counter which changes whenever the world transforms change */
+	unsigned long getWorldVersion(void) const;
+
+	/* Setters for the motion variables, which also work for bound objects */
+	void setLinearVelocity(const DirectX::XMFLOAT3& direction, const float speed);
+	void setAngularMomentum(const DirectX::XMFLOAT4& angularMomentum);
+
 	void Move(float amount); // move forward and back (move forward, move backward)
 	void Strafe(float amount); // move left and right
 	void Crane(float amount); // move up and down
@@ -115,6 +239,7 @@ public:
 	bool CraneIfParent(float amount); // move up and down
 	bool SpinIfParent(float roll, float pitch, float yaw); // spin the object (tilt, pan)
 	bool hasParent();
+	Transformable* getParent(void) const;
 
 	DirectX::XMFLOAT3 getScale() const;
 	DirectX::XMFLOAT3 getPosition() const;
@@ -148,6 +273,22 @@ protected:
 	virtual void computeTransforms(DirectX::XMFLOAT4X4 newWorldTransform, const DWORD updateTimeInterval);
 	void updateTransformProperties();
 
+	/* To be called after modifying position, orientation or scale
+	   without using the public setters
+	 */
+	void markLocalChanged(void);
+
+	/* True if the linear speed is zero and the angular momentum
+	   is the identity quaternion
+	 */
+	bool isAtRest(void) const;
+
+	/* Copies position, orientation and scale to and from the TransformSystem,
+	   if this object is bound to one. Otherwise, these functions do nothing.
+	 */
+	void pullFromSystem(void);
+	void pushToSystem(void);
+
 	/* Transforms the local space direction vector into world space,
 	   normalizing it in the process if 'normalize' is true.
 	 */
@@ -21,6 +21,10 @@ Description
   -WanderingLineTransformable objects are constructed
      with uniformly-spaced interpolation parameter values
 	 between 0 and 1.
+  -Alternatively, the knots can be simulated by a WanderingLineSystem
+     shared by many splines, which updates all of them together.
+	 The spline then holds static knots, whose control points
+	 are replaced in bulk by update().
 */
 
 #pragma once
@@ -28,9 +32,12 @@ Description
 #include <Windows.h>
 #include <DirectXMath.h>
 #include <list>
+#include <vector>
 #include "Spline.h"
 #include "WanderingLineTransformable.h"
 
+class WanderingLineSystem;
+
 class WanderingLineSpline : public Spline {
 
 public:
@@ -55,6 +62,23 @@ public:
 		Transformable* const end,
 		const WanderingLineTransformable::Parameters& knotParameters);
 
+	/* Same as the above constructor, but the knots are added
+	   to 'system' (which must outlive this object), rather than
+	   being created as separate WanderingLineTransformable objects.
+
+	   update() copies the current state of the knots from 'system',
+	   but does not update 'system', which should be updated once per frame
+	   after all of the splines using it have been updated.
+	   (Separate WanderingLineTransformable knots are likewise
+	    updated after the spline is updated from them.)
+	 */
+	WanderingLineSpline(const size_t capacity,
+		const float speed,
+		Transformable* const start,
+		Transformable* const end,
+		const WanderingLineTransformable::Parameters& knotParameters,
+		WanderingLineSystem* const system);
+
 	virtual ~WanderingLineSpline(void);
 
 	/* Changes the endpoints of the spline,
@@ -88,6 +112,20 @@ private:
 	 */
 	std::list<WanderingLineTransformable*> m_knotTransforms;
 
+	/* Simulates the knots instead of 'm_knotTransforms', if not null
+	   Shared - not deleted by destructor
+	 */
+	WanderingLineSystem* m_system;
+
+	// Index of the first knot in 'm_system'
+	size_t m_systemIndex;
+
+	// Speed used for knot construction
+	float m_speed;
+
+	// Buffer of knot control points copied from 'm_system'
+	std::vector<DirectX::XMFLOAT3> m_controlPoints;
+
 	// Currently not implemented - will cause linker errors if called
 private:
 	WanderingLineSpline(const WanderingLineSpline& other);
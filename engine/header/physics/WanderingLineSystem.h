@@ -0,0 +1,204 @@
+/*
+WanderingLineSystem.h
+---------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: WanderingLineTransformable.h, TransformSystem.h
+
+Description
+  -Stores the state of many objects which behave like
+     WanderingLineTransformable objects in structure-of-arrays form,
+     and updates them in batches, four at a time, using DirectXMath vector operations.
+  -Each object is positioned along the line joining two Transformables,
+     with a random offset and a cycling orientation, according to
+     the same rules as WanderingLineTransformable::update(). An object added
+     with the same parameters and instance identifier as a WanderingLineTransformable
+     draws the same random numbers, and follows the same path.
+  -The random offsets of all objects are drawn together, with the rounds
+     of the generator applied to several objects in lockstep
+     (see CounterRNG::uniform()).
+  -Objects are added and removed in ranges of consecutive indices,
+     so that the knots of a spline can be output in bulk
+     (see getKnotControlPoints() and WanderingLineSpline).
+
+Notes
+  -Orientations are computed directly from the line direction and the
+     rotational offsets, rather than with the sequence of quaternion operations
+     used by WanderingLineTransformable, so results agree to within
+     floating-point rounding error.
+  -A line whose endpoints coincide is treated as pointing
+     along the positive z-axis.
+  -Removed ranges are reused by later additions which fit within them.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <DirectXMath.h>
+#include <vector>
+#include <utility>
+#include "WanderingLineTransformable.h"
+#include "CounterRNG.h"
+
+// Number of objects processed together by the vectorized update loop
+#define WANDERINGLINESYSTEM_BATCH_SIZE 4
+
+class Transformable;
+
+class WanderingLineSystem {
+
+public:
+	/* 'capacity' is the number of objects for which
+	   storage will be reserved initially.
+	 */
+	WanderingLineSystem(const size_t capacity = 0);
+
+	virtual ~WanderingLineSystem(void);
+
+public:
+	/* Adds 'n' objects with consecutive indices, the first of which
+	   is output in 'first'. Object 'i' is initialized in the same way
+	   as a WanderingLineTransformable constructed with
+	   'parameters[i]' and 'instanceIds[i]'. If 'instanceIds' is null,
+	   unique identifiers are used.
+
+	   Fails if the 't' member of any of the parameters
+	   is not in the range [0,1].
+	 */
+	HRESULT add(size_t& first, const size_t n,
+		Transformable* const start, Transformable* const end,
+		const WanderingLineTransformable::Parameters* const parameters,
+		const unsigned int* const instanceIds = 0);
+
+	/* Frees a range of objects previously output by add() */
+	HRESULT remove(const size_t first, const size_t n);
+
+	/* Changes the endpoints of a range of objects,
+	   and recomputes their positions and orientations
+	   without advancing their offsets
+	 */
+	HRESULT setEndpoints(const size_t first, const size_t n,
+		Transformable* const start, Transformable* const end);
+
+	/* Advances the offsets of all objects by the given time interval
+	   (in milliseconds), and recomputes their positions, orientations
+	   and scales from the current states of their endpoints.
+	 */
+	HRESULT update(const DWORD updateTimeInterval);
+
+	// Per-object state access
+public:
+	HRESULT getScale(const size_t index, DirectX::XMFLOAT3& scale) const;
+	HRESULT getPosition(const size_t index, DirectX::XMFLOAT3& position) const;
+	HRESULT getOrientation(const size_t index, DirectX::XMFLOAT4& orientation) const;
+
+	/* The unit vector obtained by rotating the positive z-axis
+	   by the object's orientation. (This is the world forward
+	   direction used by a Knot, provided that the object's scale
+	   has a positive z-component.)
+	 */
+	HRESULT getForward(const size_t index, DirectX::XMFLOAT3& forward) const;
+
+	/* Outputs the control points that knots created from 'n' objects,
+	   starting from 'first', would have, using forward vectors
+	   and the given speed (as in the Knot class).
+	   Each knot has four control points, in the order p2, p3, p0, p1.
+	 */
+	HRESULT getKnotControlPoints(DirectX::XMFLOAT3* const controlPoints,
+		const size_t first, const size_t n, const float speed) const;
+
+	// Bulk access
+public:
+	/* Number of slots, including free slots.
+	   Valid indices are in the range [0, getSize()).
+	 */
+	size_t getSize(void) const;
+
+	/* Number of slots in use */
+	size_t getCount(void) const;
+
+	bool isInUse(const size_t index) const;
+
+protected:
+	/* Resizes all arrays so that they hold at least 'size' elements,
+	   padded to a multiple of the batch size.
+	 */
+	void grow(const size_t size);
+
+	/* Copies the positions and scales of the endpoints
+	   of the objects in the range ['first', 'last')
+	 */
+	void gatherEndpoints(const size_t first, const size_t last);
+
+	/* Draws the random offset directions of all moving objects */
+	void drawOffsets(void);
+
+	/* Updates the objects in the range ['first', 'last')
+	   from their gathered endpoints. If 'updateTimeInterval' is not zero,
+	   the offsets must have been drawn with drawOffsets().
+	 */
+	void step(const size_t first, const size_t last, const DWORD updateTimeInterval);
+
+	bool isValidRange(const size_t first, const size_t n) const;
+
+	// Data members
+protected:
+	/* Structure-of-arrays state.
+	   All arrays of floats have the same length,
+	   a multiple of WANDERINGLINESYSTEM_BATCH_SIZE.
+	 */
+
+	// Parameters, scaled as by the WanderingLineTransformable constructor
+	std::vector<float> m_t;
+	std::vector<float> m_maxRadius;
+	std::vector<float> m_linearSpeed;
+	std::vector<float> m_maxRoll, m_maxPitch, m_maxYaw;
+	std::vector<float> m_rollSpeed, m_pitchSpeed, m_yawSpeed;
+
+	// Positional and rotational offsets
+	std::vector<float> m_ox, m_oy, m_oz;
+	std::vector<float> m_roll, m_pitch, m_yaw;
+
+	// Directions of rotation (1 or -1)
+	std::vector<float> m_rollSign, m_pitchSign, m_yawSign;
+
+	// 1 for slots in use, 0 for free slots
+	std::vector<float> m_inUse;
+
+	// Endpoint positions and scales, copied at the start of an update
+	std::vector<float> m_ax, m_ay, m_az, m_asx, m_asy, m_asz;
+	std::vector<float> m_bx, m_by, m_bz, m_bsx, m_bsy, m_bsz;
+
+	// Random numbers for the current update
+	std::vector<float> m_u0, m_u1;
+
+	// Outputs
+	std::vector<float> m_px, m_py, m_pz; // Position
+	std::vector<float> m_qx, m_qy, m_qz, m_qw; // Orientation quaternion
+	std::vector<float> m_sx, m_sy, m_sz; // Scale
+	std::vector<float> m_fx, m_fy, m_fz; // Forward direction
+
+	std::vector<Transformable*> m_start; // Shared - not deleted by destructor
+	std::vector<Transformable*> m_end; // Shared - not deleted by destructor
+	std::vector<CounterRNG> m_rng;
+
+	// Free ranges of slots, as (first slot, number of slots) pairs
+	std::vector<std::pair<size_t, size_t> > m_freeRanges;
+
+	// Buffers used by drawOffsets(), kept to avoid reallocation
+	std::vector<CounterRNG*> m_movingRng;
+	std::vector<size_t> m_movingIndices;
+	std::vector<float> m_draws;
+
+	size_t m_size;
+	size_t m_count;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	WanderingLineSystem(const WanderingLineSystem& other);
+	WanderingLineSystem& operator=(const WanderingLineSystem& other);
+};
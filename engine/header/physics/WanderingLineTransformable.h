@@ -26,8 +26,8 @@ Description
 
 #include <Windows.h>
 #include <DirectXMath.h>
-#include <random>
 #include "Transformable.h"
+#include "CounterRNG.h"
 
 class WanderingLineTransformable : public Transformable {
 
@@ -66,9 +66,13 @@ public:
 public:
 	/* If 'parameters.t' is not in the range [0,1], an exception
 	   will be thrown.
+
+	   'instanceId' selects the sequence of random offsets
+	   used by this object. If zero, a unique identifier is used.
 	 */
 	WanderingLineTransformable(Transformable* const start,
-		Transformable* const end, const Parameters& parameters);
+		Transformable* const end, const Parameters& parameters,
+		const unsigned int instanceId = 0);
 
 	virtual ~WanderingLineTransformable(void);
 
@@ -102,9 +106,10 @@ private:
 
 	bool m_rollPitchYawDirection[3];
 
-private:
-	static std::default_random_engine s_generator;
-	static std::uniform_real_distribution<float> s_offsetDistribution;
+	/* Source of random offsets, independent of other objects,
+	   so that objects can be updated on different threads
+	 */
+	CounterRNG m_rng;
 
 	// Currently not implemented - will cause linker errors if called
 private:
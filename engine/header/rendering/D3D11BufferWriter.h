@@ -0,0 +1,63 @@
+/*
+D3D11BufferWriter.h
+-------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Writes ranges of bytes to a Direct3D 11 buffer
+     with ID3D11DeviceContext::UpdateSubresource()
+
+Notes
+  -The buffer must be created with D3D11_USAGE_DEFAULT.
+     (Dynamic buffers can only be mapped in their entirety
+     with D3D11_MAP_WRITE_DISCARD, which discards the parts
+     of the buffer which are not written, whereas Direct3D 11.0
+     does not allow D3D11_MAP_WRITE_NO_OVERWRITE for buffers
+     bound as shader resources.)
+  -Writes are queued on the device context, which copies the data,
+     so the source data need not outlive the call to write().
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <d3d11.h>
+#include "IBufferWriter.h"
+
+class D3D11BufferWriter : public IBufferWriter {
+
+public:
+	/* 'buffer' is shared, and is not released by this object.
+	   'size' is the size of the buffer, in bytes.
+	 */
+	D3D11BufferWriter(ID3D11Buffer* const buffer, const size_t size);
+
+	virtual ~D3D11BufferWriter(void);
+
+	/* Sets the device context used for writing.
+	   Must be called before write().
+	 */
+	void setContext(ID3D11DeviceContext* const context);
+
+	virtual size_t getSize(void) const override;
+
+	/* Also returns a failure result if no device context has been set */
+	virtual HRESULT write(const void* const data, const size_t offset, const size_t size) override;
+
+	// Data members
+private:
+	ID3D11Buffer* m_buffer;
+	size_t m_size;
+	ID3D11DeviceContext* m_context;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	D3D11BufferWriter(const D3D11BufferWriter& other);
+	D3D11BufferWriter& operator=(const D3D11BufferWriter& other);
+};
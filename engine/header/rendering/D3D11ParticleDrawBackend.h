@@ -0,0 +1,76 @@
+/*
+D3D11ParticleDrawBackend.h
+--------------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: D3D11BufferWriter.h
+
+Description
+  -Draws particle system models on a Direct3D 11 device context,
+     through InvariantParticles::drawInstancedUsingAppropriateRenderer()
+  -Model indices are assigned in the order in which models are added.
+
+Notes
+  -The vertex buffer and textures of a model are bound by
+     InvariantParticles::drawInstancedUsingAppropriateRenderer(), so
+     bindModel() only selects the model used by subsequent draw calls.
+  -draw() is a draw call with a single instance, using
+     the same instanced shader path as drawInstanced().
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <d3d11.h>
+#include <vector>
+#include "IParticleDrawBackend.h"
+#include "InvariantParticles.h"
+#include "GeometryRendererManager.h"
+#include "Camera.h"
+
+class D3D11ParticleDrawBackend : public IParticleDrawBackend {
+
+public:
+	D3D11ParticleDrawBackend(void);
+
+	virtual ~D3D11ParticleDrawBackend(void);
+
+	/* 'model' is shared, and is not deleted by this object.
+	   Returns the index of the model, for use with bindModel().
+	 */
+	size_t addModel(InvariantParticles* const model);
+
+	/* Sets the device context, renderers and camera used for drawing.
+	   Must be called before draw() or drawInstanced().
+	 */
+	void setContext(ID3D11DeviceContext* const context, GeometryRendererManager* const manager,
+		const Camera* const camera);
+
+	virtual HRESULT bindModel(const size_t model) override;
+
+	/* Also return failure results if setContext()
+	   has not been called with non-null arguments
+	 */
+	virtual HRESULT draw(const ParticleInstanceType& instance) override;
+	virtual HRESULT drawInstanced(const ParticleInstanceType* const instances, const size_t nInstances) override;
+
+	// Data members
+private:
+	std::vector<InvariantParticles*> m_models;
+
+	// The bound model, or null if no model is bound
+	InvariantParticles* m_model;
+
+	ID3D11DeviceContext* m_context;
+	GeometryRendererManager* m_manager;
+	const Camera* m_camera;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	D3D11ParticleDrawBackend(const D3D11ParticleDrawBackend& other);
+	D3D11ParticleDrawBackend& operator=(const D3D11ParticleDrawBackend& other);
+};
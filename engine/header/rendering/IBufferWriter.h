@@ -0,0 +1,48 @@
+/*
+IBufferWriter.h
+---------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: IClock.h
+
+Description
+  -An abstract destination for writes to ranges of bytes
+     in a buffer of fixed size, such as a Direct3D buffer
+  -Derived classes write to Direct3D buffers (D3D11BufferWriter),
+     or to memory, recording the amount of data written
+     (RecordingBufferWriter, for tests and benchmarks).
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+class IBufferWriter {
+
+protected:
+	IBufferWriter(void) {}
+
+public:
+	virtual ~IBufferWriter(void) {}
+
+	// Returns the size of the buffer, in bytes
+	virtual size_t getSize(void) const = 0;
+
+	/* Copies 'size' bytes from 'data' into the buffer,
+	   starting 'offset' bytes from the start of the buffer.
+	   The rest of the buffer is not changed.
+
+	   Returns a failure result, and does nothing,
+	   if the range extends past the end of the buffer.
+	 */
+	virtual HRESULT write(const void* const data, const size_t offset, const size_t size) = 0;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	IBufferWriter(const IBufferWriter& other);
+	IBufferWriter& operator=(const IBufferWriter& other);
+};
@@ -32,6 +32,8 @@ Notes
 #include <windows.h>
 #include <d3d11.h>
 #include "IGeometry.h"
+#include "vertexTypes.h"
+#include "defs.h"
 
 class IGeometry;
 class Camera;
@@ -54,6 +56,17 @@ public:
 	 */
 	virtual HRESULT render(ID3D11DeviceContext* const context, const IGeometry& geometry, const Camera* const camera) = 0;
 
+	/* Render 'nInstances' copies of the specified particle geometry,
+	   with per-system state read from 'instances',
+	   in as few draw calls as possible.
+	   Renderers which do not support instancing return a failure result
+	   with an error code of ERROR_WRONG_STATE.
+	 */
+	virtual HRESULT renderInstanced(ID3D11DeviceContext* const context, const IGeometry& geometry, const Camera* const camera,
+		const ParticleInstanceType* const instances, const size_t nInstances) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+
 	// Currently not implemented - will cause linker errors if called
 private:
 	IGeometryRenderer(const IGeometryRenderer& other);
@@ -0,0 +1,57 @@
+/*
+IParticleDrawBackend.h
+----------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: IBufferWriter.h
+
+Description
+  -An abstract destination for the draw calls of particle systems
+     which share models, issued by ParticleInstanceBatcher objects
+  -Models are identified by indices assigned by the derived class.
+  -Derived classes render with Direct3D (D3D11ParticleDrawBackend),
+     or count draw calls and pipeline state changes per frame
+     (RecordingParticleDrawBackend, for tests and benchmarks).
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include "vertexTypes.h"
+
+class IParticleDrawBackend {
+
+protected:
+	IParticleDrawBackend(void) {}
+
+public:
+	virtual ~IParticleDrawBackend(void) {}
+
+	/* Selects the model used by subsequent draw calls, binding
+	   its vertex buffer, textures and material.
+	   Returns a failure result if there is no model with the given index.
+	 */
+	virtual HRESULT bindModel(const size_t model) = 0;
+
+	/* Draws the current model once, with the per-system state
+	   of 'instance' set in constant buffers.
+	   Returns a failure result if no model has been bound.
+	 */
+	virtual HRESULT draw(const ParticleInstanceType& instance) = 0;
+
+	/* Draws the current model once for each of the 'nInstances'
+	   elements of 'instances', in a single draw call, with per-system
+	   state read from an instance buffer.
+	   Returns a failure result if no model has been bound.
+	 */
+	virtual HRESULT drawInstanced(const ParticleInstanceType* const instances, const size_t nInstances) = 0;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	IParticleDrawBackend(const IParticleDrawBackend& other);
+	IParticleDrawBackend& operator=(const IParticleDrawBackend& other);
+};
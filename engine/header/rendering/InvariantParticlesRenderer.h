@@ -25,6 +25,11 @@ Description
    state of each particle does not change between rendering passes.
   -Lighting can be enabled or disabled (during initialization only)
    using configuration data. Lighting consists of ambient lighting only.
+  -If configuration data specifies an instanced vertex shader
+   (fields prefixed with "VSInstanced_"), several copies of a model can
+   be drawn with one draw call, reading per-system state from
+   an instance buffer instead of the globals constant buffer.
+   (Refer to renderInstanced() and ParticleInstanceType.)
 */
 
 #pragma once
@@ -61,6 +66,11 @@ Description
 #define INVARIANTPARTICLESRENDERER_GSSHADER_FIELD_PREFIX L"GS_"
 #define INVARIANTPARTICLESRENDERER_PSSHADER_FIELD_PREFIX L"PS_"
 
+/* Optional - instanced rendering is disabled if there is
+   no configuration file for this shader
+ */
+#define INVARIANTPARTICLESRENDERER_VSINSTANCEDSHADER_FIELD_PREFIX L"VSInstanced_"
+
 #define INVARIANTPARTICLESRENDERER_SHADER_ENABLELOGGING_FLAG_DEFAULT true
 #define INVARIANTPARTICLESRENDERER_SHADER_ENABLELOGGING_FLAG_FIELD L"enableLogging"
 
@@ -87,6 +97,11 @@ Description
 #define INVARIANTPARTICLESRENDERER_LIGHT_AMBIENT_WEIGHT_DEFAULT 1.0f
 #define INVARIANTPARTICLESRENDERER_LIGHT_AMBIENT_WEIGHT_FIELD L"lightAmbientWeight"
 
+// Number of instances held by the instance buffer (the maximum per draw call)
+#define INVARIANTPARTICLESRENDERER_INSTANCE_CAPACITY_MIN 1
+#define INVARIANTPARTICLESRENDERER_INSTANCE_CAPACITY_DEFAULT 256
+#define INVARIANTPARTICLESRENDERER_INSTANCE_CAPACITY_FIELD L"instanceCapacity"
+
 // Type of loader to use for configuration data when creating shaders
 #define INVARIANTPARTICLESRENDERER_CONFIGIO_CLASS_SHADER FlatAtomicConfigIO
 
@@ -105,7 +120,17 @@ protected:
 	struct GlobalBufferType {
 		DirectX::XMFLOAT4X4 world;
 		DirectX::XMFLOAT4 blendAmountColourCast;
+		/* (currentTimeOffset, updateTimeInterval, billboard size multiplier,
+		   transparency multiplier), where the multipliers are the level
+		   of detail compensation factors (see InvariantParticles::getLODCompensation()).
+		   SplineParticlesRenderer replaces the multipliers with spline parameters.
+		 */
 		DirectX::XMFLOAT4 timeAndPadding;
+		/* Used by SplineParticlesRenderer only
+		   x = slot of the first spline segment in the control point buffer
+		   y = number of segment slots in the control point buffer
+		 */
+		DirectX::XMFLOAT4 splineBuffer;
 	};
 
 public:
@@ -138,6 +163,14 @@ public:
 
 	virtual HRESULT render(ID3D11DeviceContext* const context, const IGeometry& geometry, const Camera* const camera) override;
 
+	/* Instances in excess of the capacity of the instance buffer
+	   are drawn with additional draw calls.
+	   Returns a failure result if no instanced vertex shader
+	   was specified in configuration data.
+	 */
+	virtual HRESULT renderInstanced(ID3D11DeviceContext* const context, const IGeometry& geometry, const Camera* const camera,
+		const ParticleInstanceType* const instances, const size_t nInstances) override;
+
 	// Helper functions
 protected:
 
@@ -169,6 +202,14 @@ protected:
 	/* Creates the vertex input layout */
 	virtual HRESULT createInputLayout(ID3D11Device* const);
 
+	/* Creates the vertex input layout for the instanced vertex shader,
+	   with per-vertex data in slot 0, and per-instance data in slot 1
+	 */
+	virtual HRESULT createInstancedInputLayout(ID3D11Device* const);
+
+	/* Creates the dynamic vertex buffer holding per-instance data */
+	virtual HRESULT createInstanceBuffer(ID3D11Device* const);
+
 	/* Creates lighting-independent constant buffers */
 	virtual HRESULT createNoLightConstantBuffers(ID3D11Device* const);
 
@@ -185,6 +226,13 @@ protected:
 		const DirectX::XMFLOAT4 cameraPosition,
 		const InvariantParticles& geometry);
 
+	/* Sets the camera constant buffer */
+	virtual HRESULT setCameraShaderParameters(
+		ID3D11DeviceContext* const,
+		const DirectX::XMFLOAT4X4 viewMatrix,
+		const DirectX::XMFLOAT4X4 projectionMatrix,
+		const DirectX::XMFLOAT4 cameraPosition);
+
 	/* Sets light-independent pipeline state */
 	virtual HRESULT setNoLightShaderParameters(
 		ID3D11DeviceContext* const,
@@ -193,6 +241,17 @@ protected:
 		const DirectX::XMFLOAT4 cameraPosition,
 		const InvariantParticles& geometry);
 
+	/* Sets light-independent pipeline state for instanced rendering.
+	   The globals constant buffer holds the blend factor of 'geometry' only,
+	   as per-system state is read from the instance buffer.
+	 */
+	virtual HRESULT setInstancedShaderParameters(
+		ID3D11DeviceContext* const,
+		const DirectX::XMFLOAT4X4 viewMatrix,
+		const DirectX::XMFLOAT4X4 projectionMatrix,
+		const DirectX::XMFLOAT4 cameraPosition,
+		const InvariantParticles& geometry);
+
 	/* Overridden by SplineParticlesRenderer */
 	virtual HRESULT setSplineParameters(GlobalBufferType& buffer,
 		const InvariantParticles& geometry) const {
@@ -205,7 +264,11 @@ protected:
 		const INVARIANTPARTICLESRENDERER_MATERIAL_STRUCT* material,
 		const float blendFactor);
 
-	void renderShader(ID3D11DeviceContext* const, const size_t);
+	/* If 'nInstances' is non-zero, draws 'nInstances' instances
+	   with the instanced vertex shader, reading per-instance data
+	   from the instance buffer (which must already be bound).
+	 */
+	void renderShader(ID3D11DeviceContext* const, const size_t particleCount, const size_t nInstances = 0);
 
 	// Data members
 private:
@@ -218,6 +281,12 @@ private:
 	ID3D11Buffer* m_globalBuffer;
 	ID3D11Buffer* m_lightBuffer;
 
+	// Null if instanced rendering is disabled
+	Shader* m_instancedVertexShader;
+	ID3D11InputLayout* m_instancedLayout;
+	ID3D11Buffer* m_instanceBuffer;
+	size_t m_instanceCapacity;
+
 	// Is the renderer configured to use lighting?
 	bool m_lighting;
 
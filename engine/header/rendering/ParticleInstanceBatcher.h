@@ -0,0 +1,97 @@
+/*
+ParticleInstanceBatcher.h
+-------------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: SplineUploader.h
+
+Description
+  -Collects the per-system state (world transformation, time
+     and colour cast) of the particle systems to be drawn in a frame,
+     grouped by the model which they share, and issues the draw calls
+     for the frame to an IParticleDrawBackend object.
+  -In instanced mode, all systems sharing a model are drawn
+     with a single call to IParticleDrawBackend::drawInstanced(),
+     after binding the model once. Larger groups are split
+     into several draw calls of at most 'maxInstancesPerDraw' instances.
+  -Otherwise, each system is drawn separately, binding its model
+     and setting its state in constant buffers each time, in the same
+     way as when each system is drawn by itself.
+
+Notes
+  -Models are drawn in order of their indices, and the systems sharing
+     a model are drawn in the order in which they were added.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <DirectXMath.h>
+#include <vector>
+#include "vertexTypes.h"
+#include "IParticleDrawBackend.h"
+
+// Default maximum number of instances drawn by a single draw call
+#define PARTICLEINSTANCEBATCHER_MAX_INSTANCES_DEFAULT 256
+
+class ParticleInstanceBatcher {
+
+public:
+	/* 'nModels' is the number of models which can be drawn,
+	   with indices from zero to 'nModels - 1'.
+	   If 'maxInstancesPerDraw' is zero, the default value is used.
+	 */
+	ParticleInstanceBatcher(const size_t nModels, const bool instanced = true,
+		const size_t maxInstancesPerDraw = PARTICLEINSTANCEBATCHER_MAX_INSTANCES_DEFAULT);
+
+	virtual ~ParticleInstanceBatcher(void);
+
+	/* Queues a particle system for drawing with the given model.
+	   Returns a failure result, and does nothing,
+	   if 'model' is out of range.
+	 */
+	HRESULT add(const size_t model, const ParticleInstanceType& instance);
+
+	/* Draws all queued particle systems using 'backend',
+	   then empties the queues for the next frame.
+	   The queues are emptied even if drawing fails.
+	 */
+	HRESULT flush(IParticleDrawBackend& backend);
+
+	// Empties the queues without drawing
+	void clear(void);
+
+	void setInstanced(const bool instanced);
+	bool isInstanced(void) const;
+
+	size_t getNumberOfModels(void) const;
+
+	// Number of particle systems queued since the last call to flush()
+	size_t getNumberOfInstances(void) const;
+
+	/* Fills 'instance' with the per-system state which would
+	   otherwise be passed to the shaders in constant buffers.
+	   'time' is (time since creation, time since the last update).
+	   The level of detail compensation factors are set to one.
+	 */
+	static void makeInstance(ParticleInstanceType& instance,
+		const DirectX::XMFLOAT4X4& world, const DirectX::XMFLOAT2& time,
+		const DirectX::XMFLOAT3& colorCast);
+
+	// Data members
+private:
+	// Queued instances of each model
+	std::vector<std::vector<ParticleInstanceType> > m_instances;
+	size_t m_nInstances;
+	bool m_instanced;
+	size_t m_maxInstancesPerDraw;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	ParticleInstanceBatcher(const ParticleInstanceBatcher& other);
+	ParticleInstanceBatcher& operator=(const ParticleInstanceBatcher& other);
+};
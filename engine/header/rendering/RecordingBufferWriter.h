@@ -0,0 +1,66 @@
+/*
+RecordingBufferWriter.h
+-----------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: ManualClock.h
+
+Description
+  -Writes ranges of bytes to a buffer in memory, and counts
+     the number of bytes and writes per frame
+  -Stands in for a Direct3D buffer in tests and benchmarks,
+     which can compare the contents of the buffer with the data
+     which should have been written to it, and measure the amount
+     of data which would have been uploaded to the GPU.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include "IBufferWriter.h"
+
+class RecordingBufferWriter : public IBufferWriter {
+
+public:
+	/* 'size' is the size of the buffer, in bytes.
+	   The buffer is initially filled with zeros.
+	 */
+	RecordingBufferWriter(const size_t size);
+
+	virtual ~RecordingBufferWriter(void);
+
+	virtual size_t getSize(void) const override;
+
+	virtual HRESULT write(const void* const data, const size_t offset, const size_t size) override;
+
+	/* Starts a new frame, resetting the per-frame counts */
+	void beginFrame(void);
+
+	// Returns the contents of the buffer
+	const unsigned char* getContents(void) const;
+
+	size_t getFrameBytes(void) const;
+	size_t getFrameWrites(void) const;
+
+	// Totals over all frames
+	size_t getTotalBytes(void) const;
+	size_t getTotalWrites(void) const;
+
+	// Data members
+private:
+	std::vector<unsigned char> m_contents;
+	size_t m_frameBytes;
+	size_t m_frameWrites;
+	size_t m_totalBytes;
+	size_t m_totalWrites;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	RecordingBufferWriter(const RecordingBufferWriter& other);
+	RecordingBufferWriter& operator=(const RecordingBufferWriter& other);
+};
@@ -0,0 +1,96 @@
+/*
+RecordingParticleDrawBackend.h
+------------------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: RecordingBufferWriter.h
+
+Description
+  -Records the draw calls of particle systems, and counts
+     draw calls and pipeline state changes per frame
+  -Stands in for Direct3D in tests and benchmarks, which can compare
+     the instance data received with the data which should have been drawn,
+     and measure the number of draw calls and state changes which
+     would have been made on the device context.
+  -State changes are model binds (vertex buffer, textures and material),
+     constant buffer updates (one per call to draw()) and instance buffer
+     updates (one per call to drawInstanced()).
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include "IParticleDrawBackend.h"
+
+class RecordingParticleDrawBackend : public IParticleDrawBackend {
+
+public:
+	// A draw call made in the current frame
+	struct Draw {
+		size_t model;
+
+		// Index of the first instance in getFrameInstances()
+		size_t firstInstance;
+		size_t nInstances;
+
+		// True if made with drawInstanced()
+		bool instanced;
+	};
+
+public:
+	// 'nModels' is the number of valid model indices
+	RecordingParticleDrawBackend(const size_t nModels);
+
+	virtual ~RecordingParticleDrawBackend(void);
+
+	virtual HRESULT bindModel(const size_t model) override;
+	virtual HRESULT draw(const ParticleInstanceType& instance) override;
+	virtual HRESULT drawInstanced(const ParticleInstanceType* const instances, const size_t nInstances) override;
+
+	/* Starts a new frame, resetting the per-frame counts
+	   and records, and unbinding the current model
+	 */
+	void beginFrame(void);
+
+	const std::vector<Draw>& getFrameDraws(void) const;
+
+	// Instance data of all draw calls in the current frame, in order
+	const std::vector<ParticleInstanceType>& getFrameInstances(void) const;
+
+	size_t getFrameDrawCalls(void) const;
+	size_t getFrameModelBinds(void) const;
+	size_t getFrameConstantBufferWrites(void) const;
+	size_t getFrameInstanceBufferWrites(void) const;
+
+	// Sum of model binds and buffer writes
+	size_t getFrameStateChanges(void) const;
+
+	// Totals over all frames
+	size_t getTotalDrawCalls(void) const;
+	size_t getTotalStateChanges(void) const;
+
+	// Data members
+private:
+	size_t m_nModels;
+
+	// Index of the bound model, or 'm_nModels' if no model is bound
+	size_t m_model;
+
+	std::vector<Draw> m_frameDraws;
+	std::vector<ParticleInstanceType> m_frameInstances;
+	size_t m_frameModelBinds;
+	size_t m_frameConstantBufferWrites;
+	size_t m_frameInstanceBufferWrites;
+	size_t m_totalDrawCalls;
+	size_t m_totalStateChanges;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	RecordingParticleDrawBackend(const RecordingParticleDrawBackend& other);
+	RecordingParticleDrawBackend& operator=(const RecordingParticleDrawBackend& other);
+};
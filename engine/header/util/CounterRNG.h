@@ -0,0 +1,156 @@
+/*
+CounterRNG.h
+------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+References:
+  -Salmon, J. K., Moraes, M. A., Dror, R. O., and Shaw, D. E. 2011.
+     Parallel random numbers: As easy as 1, 2, 3.
+     In Proceedings of the International Conference for High Performance
+     Computing, Networking, Storage and Analysis (SC '11).
+     (The Philox4x32-10 generator)
+
+Description
+  -A counter-based pseudorandom number generator, whose output
+     is a pure function of a seed, an instance identifier,
+     and the index of the number drawn.
+  -Each object therefore produces the same sequence regardless of
+     how many other objects exist, in which order they were created,
+     or on which threads they are used, and any point in the sequence
+     can be reached in constant time with setDrawIndex().
+  -Bulk generation functions produce several blocks of four numbers at once,
+     with the rounds of the generator applied to all blocks in lockstep,
+     so that the compiler can vectorize the computation.
+
+Notes
+  -A single object must not be used by multiple threads at the same time.
+     Threads should use separate objects, or separate ranges
+     of draw indices (with separate objects keyed identically).
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <DirectXMath.h>
+
+// Seed used when no seed is specified
+#define COUNTERRNG_SEED_DEFAULT 0x2014u
+
+/* Number of blocks of four numbers generated together by the
+   bulk generation functions
+ */
+#define COUNTERRNG_BLOCKS_PER_BATCH 16
+
+class CounterRNG {
+
+public:
+	/* Objects with the same seed and instance identifier
+	   produce identical sequences.
+	 */
+	CounterRNG(const unsigned int seed = COUNTERRNG_SEED_DEFAULT,
+		const unsigned int instanceId = 0);
+
+	virtual ~CounterRNG(void);
+
+	/* Returns a different value on each call (until the counter wraps),
+	   for use as an instance identifier by objects which are not
+	   assigned identifiers explicitly. Can be called from multiple threads.
+	 */
+	static unsigned int getUniqueInstanceId(void);
+
+	/* The draw index is the number of 32-bit values
+	   consumed from the sequence so far.
+	 */
+	unsigned long long getDrawIndex(void) const;
+	void setDrawIndex(const unsigned long long index);
+
+	/* Returns the next value of the sequence,
+	   converted to a float in the interval [0,1).
+	   Consumes one value.
+	 */
+	float nextUniform(void);
+
+	/* Outputs 'n' floats in the interval [0,1).
+	   Consumes 'n' values.
+	 */
+	void uniform(float* const out, const size_t n);
+
+	/* Outputs 'n' floats in the interval [0,1) from each of 'nGenerators'
+	   objects, with the values of generator 'i' stored starting at 'out[i * n]'.
+	   The results are the same as if uniform() was called on each
+	   object in turn, but the rounds of the generator are applied
+	   to the blocks of several objects in lockstep.
+	   Consumes 'n' values from each object.
+	 */
+	static void uniform(CounterRNG* const* const generators, const size_t nGenerators,
+		float* const out, const size_t n);
+
+	/* Outputs 'n' samples of the standard normal distribution,
+	   using the Box-Muller transform.
+	   Consumes 'n' values, rounded up to an even number.
+	 */
+	void normal(float* const out, const size_t n);
+
+	/* Outputs 'n' points distributed uniformly on the surface
+	   of the unit sphere, if 'volume' is false, or within
+	   the unit sphere, if 'volume' is true.
+	   Consumes two values per point, or three values per point
+	   if 'volume' is true.
+	 */
+	void sphere(DirectX::XMFLOAT3* const out, const size_t n, const bool volume = false);
+
+	/* Outputs 'n' unit vectors distributed uniformly over the solid angle
+	   within 'maxAngle' radians of the positive z-axis.
+	   Consumes two values per vector.
+	 */
+	void cone(DirectX::XMFLOAT3* const out, const size_t n, const float maxAngle);
+
+	/* The Philox4x32-10 block function. Outputs four 32-bit values
+	   computed from a four-element counter and a two-element key.
+	 */
+	static void philox(unsigned int* const result,
+		const unsigned int* const counter, const unsigned int* const key);
+
+private:
+	/* Outputs 'nBlocks' consecutive blocks of four values, starting
+	   from the given block index, without changing the draw index.
+	   'nBlocks' must not exceed COUNTERRNG_BLOCKS_PER_BATCH.
+	 */
+	void generateBlocks(unsigned int* const out,
+		const unsigned long long firstBlock, const size_t nBlocks) const;
+
+	/* Outputs 'nBlocks' blocks of four values, where block 'b'
+	   is computed from the key ('key0[b]', 'key1[b]') and the block index
+	   'blockIndices[b]'. 'nBlocks' must not exceed COUNTERRNG_BLOCKS_PER_BATCH.
+	 */
+	static void generateBlocks(unsigned int* const out,
+		const unsigned int* const key0, const unsigned int* const key1,
+		const unsigned long long* const blockIndices, const size_t nBlocks);
+
+	/* Outputs 'n' values starting from the current draw index,
+	   and advances the draw index. 'n' must not exceed
+	   4 * (COUNTERRNG_BLOCKS_PER_BATCH - 1).
+	 */
+	void nextBatch(unsigned int* const out, const size_t n);
+
+	/* Converts a 32-bit value to a float in [0,1) */
+	static float toUniform(const unsigned int value);
+
+	// Data members
+private:
+	unsigned int m_key[2];
+
+	unsigned long long m_drawIndex;
+
+	/* Block of values containing the value at the draw index,
+	   cached for nextUniform(), and its block index
+	 */
+	unsigned int m_block[4];
+	unsigned long long m_blockIndex;
+	bool m_blockValid;
+};
@@ -0,0 +1,85 @@
+/*
+EngineTime.h
+------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -Strongly-typed time intervals and points in time,
+     with nanosecond resolution, based on std::chrono
+  -A signed 64-bit count of nanoseconds covers about 292 years,
+     so engine times do not wrap around in practice.
+  -Points in time are measured from the epoch of the clock
+     which produced them (see IClock).
+  -Conversion functions, in the 'engineTime' namespace, provide
+     the DWORD millisecond values expected by older code
+     (e.g. State::update() and Transformable::update()).
+     They are inline, as they are used once per object per frame.
+
+Notes
+  -Conversions to DWORD milliseconds truncate towards zero, and
+     wrap around after 2^32 milliseconds (about 49.7 days), as do
+     the values returned by GetTickCount(). Negative values
+     are converted to zero.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <chrono>
+
+class IClock;
+
+// A time interval [nanoseconds]
+typedef std::chrono::duration<long long, std::nano> EngineDuration;
+
+// A point in time, relative to the epoch of an IClock
+typedef std::chrono::time_point<IClock, EngineDuration> EngineTime;
+
+#define ENGINETIME_NANOSECS_PER_MILLISEC 1000000LL
+#define ENGINETIME_NANOSECS_PER_SEC 1000000000LL
+
+namespace engineTime {
+
+	// Conversions to older representations
+	// ------------------------------------
+	inline DWORD toMilliseconds(const EngineDuration& duration) {
+		const long long count = duration.count();
+		return (count <= 0) ? 0 : static_cast<DWORD>(count / ENGINETIME_NANOSECS_PER_MILLISEC);
+	}
+
+	// Returns the time since the epoch of the clock
+	inline DWORD toMilliseconds(const EngineTime& time) {
+		return toMilliseconds(time.time_since_epoch());
+	}
+
+	inline float toMillisecondsFloat(const EngineDuration& duration) {
+		return static_cast<float>(static_cast<double>(duration.count()) / static_cast<double>(ENGINETIME_NANOSECS_PER_MILLISEC));
+	}
+
+	inline float toSecondsFloat(const EngineDuration& duration) {
+		return static_cast<float>(static_cast<double>(duration.count()) / static_cast<double>(ENGINETIME_NANOSECS_PER_SEC));
+	}
+
+	// Conversions from older representations
+	// --------------------------------------
+	inline EngineDuration fromMilliseconds(const DWORD milliseconds) {
+		return EngineDuration(static_cast<long long>(milliseconds) * ENGINETIME_NANOSECS_PER_MILLISEC);
+	}
+
+	// Returns the time 'milliseconds' after the epoch of the clock
+	inline EngineTime timeFromMilliseconds(const DWORD milliseconds) {
+		return EngineTime(fromMilliseconds(milliseconds));
+	}
+
+	// Rounds to the nearest nanosecond
+	inline EngineDuration fromSeconds(const double seconds) {
+		const double nanoseconds = seconds * static_cast<double>(ENGINETIME_NANOSECS_PER_SEC);
+		return EngineDuration(static_cast<long long>((nanoseconds < 0.0) ? (nanoseconds - 0.5) : (nanoseconds + 0.5)));
+	}
+}
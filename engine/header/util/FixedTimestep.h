@@ -0,0 +1,134 @@
+/*
+FixedTimestep.h
+---------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+Other references:
+  -Glenn Fiedler, "Fix Your Timestep!"
+   (http://gafferongames.com/game-physics/fix-your-timestep/)
+
+Description
+  -Divides variable-length frames into simulation steps of a fixed length,
+     so that simulation results do not depend on the frame rate
+     or on the granularity of the system clock.
+  -Frame time is added to an accumulator, from which whole steps are
+     consumed. The remainder is expressed as an interpolation factor,
+     to be used when rendering between the previous and current
+     simulation states.
+  -The number of steps taken per frame is limited, so that a long frame
+     (e.g. after a breakpoint or a window drag) does not cause
+     the simulation to fall further and further behind. Time in excess
+     of the limit is discarded.
+  -This class does not read any clock. Frame durations are supplied
+     by the caller, which may use a synthetic clock for testing
+     (e.g. ManualClock).
+  -Frame durations are accumulated with nanosecond resolution, so frames
+     which are not whole numbers of milliseconds long do not cause drift.
+     Steps are whole numbers of milliseconds long, and their times
+     are output as DWORD values for use with State::update().
+
+Usage
+  timestep.advance(frameInterval);
+  while( timestep.nextStep(stepTime) ) {
+    state->update(stepTime, timestep.getStepInterval());
+  }
+  Transformable::setRenderInterpolation(timestep.getInterpolationFactor());
+  (Render)
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include "EngineTime.h"
+
+// Default length of a simulation step, in milliseconds
+#define FIXEDTIMESTEP_STEP_INTERVAL_DEFAULT 10
+
+// Default maximum number of simulation steps per frame
+#define FIXEDTIMESTEP_MAX_STEPS_DEFAULT 10
+
+class FixedTimestep {
+
+public:
+	/* 'stepInterval' is in milliseconds.
+	   Both parameters must be greater than zero,
+	   or the constructor will throw an exception.
+	 */
+	FixedTimestep(const DWORD stepInterval = FIXEDTIMESTEP_STEP_INTERVAL_DEFAULT,
+		const unsigned int maxStepsPerFrame = FIXEDTIMESTEP_MAX_STEPS_DEFAULT);
+
+	virtual ~FixedTimestep(void);
+
+	/* Starts a new frame, which follows a frame of duration 'frameInterval'
+	   ([milliseconds] for the DWORD version). Negative durations are ignored.
+	   Any steps not taken during the previous frame,
+	   because nextStep() was not called until it returned false,
+	   are carried over.
+	 */
+	void advance(const EngineDuration& frameInterval);
+	void advance(const DWORD frameInterval);
+
+	/* Returns true if another simulation step should be taken during
+	   the current frame, and outputs the simulation time at the start
+	   of the step in 'currentTime'. Returns false when the remaining
+	   accumulated time is less than one step, or when the limit
+	   on the number of steps per frame has been reached.
+	 */
+	bool nextStep(DWORD& currentTime);
+
+	/* Returns the fraction of a step remaining in the accumulator,
+	   in the range [0, 1). Rendering should show the state at this
+	   fraction of the way from the state before the last step
+	   to the state after the last step.
+	 */
+	float getInterpolationFactor(void) const;
+
+	/* Restores the initial state. The first frame after construction
+	   or after a reset always contains one step, so that the simulation
+	   is initialized before anything is rendered.
+	 */
+	void reset(void);
+
+	DWORD getStepInterval(void) const;
+	unsigned int getMaxStepsPerFrame(void) const;
+
+	// Simulation time at the end of the last step taken [milliseconds]
+	DWORD getSimulationTime(void) const;
+
+	// Total number of steps taken since the last reset
+	unsigned long getStepCount(void) const;
+
+	// Number of steps taken during the current frame
+	unsigned int getFrameStepCount(void) const;
+
+	/* Total time [milliseconds] discarded since the last reset
+	   because of the limit on the number of steps per frame
+	 */
+	DWORD getDroppedTime(void) const;
+
+	// Data members
+private:
+	DWORD m_stepInterval;
+	unsigned int m_maxStepsPerFrame;
+
+	// Equal to 'm_stepInterval'
+	EngineDuration m_stepDuration;
+
+	// Frame time not yet consumed by steps
+	EngineDuration m_accumulator;
+
+	DWORD m_simulationTime;
+	unsigned long m_stepCount;
+	unsigned int m_frameStepCount;
+	EngineDuration m_droppedTime;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	FixedTimestep(const FixedTimestep& other);
+	FixedTimestep& operator=(const FixedTimestep& other);
+};
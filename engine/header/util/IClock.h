@@ -0,0 +1,41 @@
+/*
+IClock.h
+--------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: ITransformable.h
+
+Description
+  -An abstract source of the current time
+  -Derived classes read real time (MonotonicClock),
+     are set by their owners (ManualClock, for tests and replays),
+     or transform the time of another clock (ScaledClock, for slow motion).
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include "EngineTime.h"
+
+class IClock {
+
+protected:
+	IClock(void) {}
+
+public:
+	virtual ~IClock(void) {}
+
+	/* Returns the current time, measured from the epoch of this clock.
+	   Successive calls never return decreasing values.
+	 */
+	virtual EngineTime now(void) const = 0;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	IClock(const IClock& other);
+	IClock& operator=(const IClock& other);
+};
@@ -0,0 +1,50 @@
+/*
+ManualClock.h
+-------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -A clock whose time only changes when its owner sets or advances it
+  -Used to drive the engine with synthetic time in tests,
+     and for deterministic replays.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include "IClock.h"
+
+class ManualClock : public IClock {
+
+public:
+	ManualClock(const EngineTime& start = EngineTime());
+
+	virtual ~ManualClock(void);
+
+	virtual EngineTime now(void) const override;
+
+	/* Returns a failure result, and does nothing,
+	   if 'time' is earlier than the current time.
+	 */
+	HRESULT set(const EngineTime& time);
+
+	/* Returns a failure result, and does nothing,
+	   if 'interval' is negative.
+	 */
+	HRESULT advance(const EngineDuration& interval);
+
+	// Data members
+private:
+	EngineTime m_time;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	ManualClock(const ManualClock& other);
+	ManualClock& operator=(const ManualClock& other);
+};
@@ -0,0 +1,49 @@
+/*
+MonotonicClock.h
+----------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -A clock which reads real time from the high-resolution performance counter
+  -The epoch of the clock is the time at which it was constructed.
+
+Notes
+  -QueryPerformanceCounter() is used instead of std::chrono::steady_clock,
+     because the Visual Studio 2013 implementation of steady_clock
+     is neither steady nor high-resolution.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include "IClock.h"
+
+class MonotonicClock : public IClock {
+
+public:
+	/* Throws an exception if the performance counter is unavailable */
+	MonotonicClock(void);
+
+	virtual ~MonotonicClock(void);
+
+	virtual EngineTime now(void) const override;
+
+	// Data members
+private:
+	// Performance counter value at construction
+	LONGLONG m_start;
+
+	// Performance counter ticks per second
+	LONGLONG m_frequency;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	MonotonicClock(const MonotonicClock& other);
+	MonotonicClock& operator=(const MonotonicClock& other);
+};
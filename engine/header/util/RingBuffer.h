@@ -0,0 +1,172 @@
+/*
+RingBuffer.h
+------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -A fixed-capacity double-ended queue, stored in a single array
+  -Elements can be added or removed at either end, and accessed
+     by their position relative to the front, in constant time
+     and without allocating memory.
+  -Removed elements are not destroyed until they are overwritten,
+     or until the buffer is destroyed.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include <exception>
+#include "defs.h"
+
+template<typename T> class RingBuffer {
+
+public:
+	/* 'capacity' must be greater than zero or the constructor
+	   will throw an exception.
+	 */
+	RingBuffer(const size_t capacity);
+
+	virtual ~RingBuffer(void);
+
+	size_t size(void) const;
+	size_t capacity(void) const;
+	bool isEmpty(void) const;
+	bool isFull(void) const;
+
+	/* Index zero is the front of the buffer.
+	   The index is not checked.
+	 */
+	T& operator[](const size_t index);
+	const T& operator[](const size_t index) const;
+
+	/* The following functions do nothing and return failure results
+	   if the buffer is full (for the 'push' functions),
+	   or empty (for the 'pop' functions).
+	 */
+	HRESULT pushFront(const T& element);
+	HRESULT pushBack(const T& element);
+	HRESULT popFront(void);
+	HRESULT popBack(void);
+
+	void clear(void);
+
+	/* Converts an index relative to the front of the buffer
+	   into an index in the underlying array, which does not change
+	   when elements are added or removed at the ends.
+	   The result is less than capacity().
+	 */
+	size_t toDataIndex(const size_t index) const;
+
+	/* The inverse of toDataIndex(). Indices in the underlying array
+	   which do not hold elements are converted to indices
+	   greater than or equal to size().
+	 */
+	size_t toIndex(const size_t dataIndex) const;
+
+	// Data members
+private:
+	std::vector<T> m_data;
+
+	// Index in 'm_data' of the front of the buffer
+	size_t m_front;
+
+	size_t m_size;
+};
+
+template<typename T> RingBuffer<T>::RingBuffer(const size_t capacity) :
+	m_data(), m_front(0), m_size(0)
+{
+	if( capacity == 0 ) {
+		throw std::exception("Cannot create a RingBuffer with a capacity of zero.");
+	}
+	m_data.resize(capacity);
+}
+
+template<typename T> RingBuffer<T>::~RingBuffer(void) {}
+
+template<typename T> size_t RingBuffer<T>::size(void) const {
+	return m_size;
+}
+
+template<typename T> size_t RingBuffer<T>::capacity(void) const {
+	return m_data.size();
+}
+
+template<typename T> bool RingBuffer<T>::isEmpty(void) const {
+	return m_size == 0;
+}
+
+template<typename T> bool RingBuffer<T>::isFull(void) const {
+	return m_size == m_data.size();
+}
+
+template<typename T> T& RingBuffer<T>::operator[](const size_t index) {
+	return m_data[toDataIndex(index)];
+}
+
+template<typename T> const T& RingBuffer<T>::operator[](const size_t index) const {
+	return m_data[toDataIndex(index)];
+}
+
+template<typename T> HRESULT RingBuffer<T>::pushFront(const T& element) {
+	if( isFull() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+	m_front = (m_front == 0) ? (m_data.size() - 1) : (m_front - 1);
+	m_data[m_front] = element;
+	++m_size;
+	return ERROR_SUCCESS;
+}
+
+template<typename T> HRESULT RingBuffer<T>::pushBack(const T& element) {
+	if( isFull() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+	m_data[toDataIndex(m_size)] = element;
+	++m_size;
+	return ERROR_SUCCESS;
+}
+
+template<typename T> HRESULT RingBuffer<T>::popFront(void) {
+	if( isEmpty() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+	m_front = toDataIndex(1);
+	--m_size;
+	return ERROR_SUCCESS;
+}
+
+template<typename T> HRESULT RingBuffer<T>::popBack(void) {
+	if( isEmpty() ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+	}
+	--m_size;
+	return ERROR_SUCCESS;
+}
+
+template<typename T> void RingBuffer<T>::clear(void) {
+	m_front = 0;
+	m_size = 0;
+}
+
+template<typename T> size_t RingBuffer<T>::toIndex(const size_t dataIndex) const {
+	if( dataIndex >= m_front ) {
+		return dataIndex - m_front;
+	}
+	return dataIndex + m_data.size() - m_front;
+}
+
+template<typename T> size_t RingBuffer<T>::toDataIndex(const size_t index) const {
+	size_t dataIndex = m_front + index;
+	if( dataIndex >= m_data.size() ) {
+		dataIndex -= m_data.size();
+	}
+	return dataIndex;
+}
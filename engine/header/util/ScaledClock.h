@@ -0,0 +1,62 @@
+/*
+ScaledClock.h
+-------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -A clock which runs at a multiple of the rate of another clock,
+     for slow motion, fast forward, or pausing (a scale of zero)
+  -Changing the scale does not change the current time,
+     only the rate at which it advances from then on.
+  -The epoch of the clock is the time at which it was constructed.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include "IClock.h"
+
+class ScaledClock : public IClock {
+
+public:
+	/* 'source' must outlive this object.
+	   Throws an exception if 'source' is null or if 'scale' is negative.
+	 */
+	ScaledClock(const IClock* const source, const double scale = 1.0);
+
+	virtual ~ScaledClock(void);
+
+	virtual EngineTime now(void) const override;
+
+	/* Returns a failure result, and does nothing,
+	   if 'scale' is negative.
+	 */
+	HRESULT setScale(const double scale);
+	double getScale(void) const;
+
+private:
+	// Converts a time of the source clock to a time of this clock
+	EngineTime timeAt(const EngineTime& sourceTime) const;
+
+	// Data members
+private:
+	const IClock* m_source; // Shared - not deleted by the destructor
+	double m_scale;
+
+	/* Time of this clock, and of the source clock,
+	   when the scale was last changed
+	 */
+	EngineTime m_base;
+	EngineTime m_sourceBase;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	ScaledClock(const ScaledClock& other);
+	ScaledClock& operator=(const ScaledClock& other);
+};
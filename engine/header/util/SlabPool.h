@@ -0,0 +1,107 @@
+/*
+SlabPool.h
+----------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -An allocator for blocks of memory of a single size,
+     intended to back the class-specific operator new and operator delete
+     of small objects which are created and destroyed frequently.
+  -Blocks are carved out of large slabs, which are allocated when
+     no free blocks remain, and are only released when the pool is destroyed.
+     Freed blocks are kept in a free list and reused,
+     so a steady number of live objects causes no further heap allocations.
+  -Allocation and deallocation are protected by a mutex,
+     so objects can be created and destroyed on multiple threads.
+  -Allocation statistics are kept for diagnostic purposes.
+
+Notes
+  -Blocks are aligned to SLABPOOL_ALIGNMENT bytes,
+     so the pool is not suitable for types with stricter alignment
+     requirements (such as those containing DirectX::XMVECTOR members).
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include <mutex>
+
+// Alignment, and minimum size, of the blocks of memory in a pool, in bytes
+#define SLABPOOL_ALIGNMENT 8
+
+// Default number of blocks in each slab
+#define SLABPOOL_BLOCKS_PER_SLAB_DEFAULT 256
+
+class SlabPool {
+
+public:
+	/* Allocation statistics */
+	struct Telemetry {
+		size_t nAllocations; // Total calls to allocate()
+		size_t nDeallocations; // Total calls to deallocate()
+		size_t nLiveBlocks; // Blocks currently allocated
+		size_t nPeakLiveBlocks; // Maximum value of 'nLiveBlocks'
+		size_t nSlabs; // Slabs currently held by the pool
+		size_t nReservedBytes; // Total size of all slabs
+	};
+
+public:
+	/* 'blockSize' is the size of the objects to be allocated.
+	   'blocksPerSlab' must be greater than zero, or the constructor
+	   will throw an exception.
+	 */
+	SlabPool(const size_t blockSize,
+		const size_t blocksPerSlab = SLABPOOL_BLOCKS_PER_SLAB_DEFAULT);
+
+	/* Releases all slabs, regardless of whether any blocks are still allocated */
+	virtual ~SlabPool(void);
+
+	/* Returns a block of at least the size given to the constructor.
+	   Throws std::bad_alloc if a new slab is needed,
+	   but cannot be allocated.
+	 */
+	void* allocate(void);
+
+	/* Returns a block obtained from allocate() to the pool.
+	   Does nothing if 'block' is null.
+	 */
+	void deallocate(void* const block);
+
+	size_t getBlockSize(void) const;
+
+	void getTelemetry(Telemetry& telemetry) const;
+
+private:
+	/* Allocates a slab and adds its blocks to the free list.
+	   Must be called with 'm_mutex' locked.
+	 */
+	void addSlab(void);
+
+	// Data members
+private:
+	size_t m_blockSize;
+	size_t m_blocksPerSlab;
+
+	std::vector<char*> m_slabs;
+
+	/* First free block. Each free block stores a pointer
+	   to the next free block.
+	 */
+	void* m_freeList;
+
+	Telemetry m_telemetry;
+
+	mutable std::mutex m_mutex;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	SlabPool(const SlabPool& other);
+	SlabPool& operator=(const SlabPool& other);
+};
@@ -0,0 +1,342 @@
+/*
+SlotMap.h
+---------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: SlabPool.h and RingBuffer.h
+
+Description
+  -A container of objects which are created and destroyed frequently,
+     supporting constant-time insertion and removal.
+  -Each element is constructed in place in a slot of a preallocated pool.
+     Slots are allocated in chunks, which are only released
+     when the container is destroyed, so elements never move,
+     and a steady number of elements causes no further heap allocations.
+  -Insertion outputs a handle (SlotMapHandle) to the new element,
+     which remains valid until the element is removed. Handles to removed
+     elements are detected as stale, even after their slots are reused,
+     using a generation counter stored with each slot.
+  -The elements are also accessible by index, from zero to size() - 1,
+     for iteration without gaps. Removing an element moves the last
+     element into its index, so iterating backwards visits every
+     element exactly once even if elements are removed during iteration,
+     provided that only the current element is removed.
+
+Notes
+  -Elements are not kept in order of insertion.
+  -Slots are aligned in the same way as memory from operator new,
+     so the container is not suitable for types with stricter alignment
+     requirements (such as those containing DirectX::XMVECTOR members).
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include <new>
+#include <utility>
+#include <exception>
+#include "defs.h"
+
+// Default number of slots allocated at once
+#define SLOTMAP_SLOTS_PER_CHUNK_DEFAULT 64
+
+// Marks the end of the list of free slots
+#define SLOTMAP_NO_SLOT (static_cast<size_t>(-1))
+
+/* Identifies an element of a SlotMap.
+   Default-constructed handles are never valid.
+ */
+struct SlotMapHandle {
+	size_t slot;
+	UINT generation;
+
+	SlotMapHandle(void) : slot(SLOTMAP_NO_SLOT), generation(0) {}
+
+	bool operator==(const SlotMapHandle& other) const {
+		return (slot == other.slot) && (generation == other.generation);
+	}
+	bool operator!=(const SlotMapHandle& other) const {
+		return !(*this == other);
+	}
+};
+
+template<typename T> class SlotMap {
+
+public:
+	/* 'slotsPerChunk' must be greater than zero or the constructor
+	   will throw an exception. The first chunk is allocated immediately.
+	 */
+	SlotMap(const size_t slotsPerChunk = SLOTMAP_SLOTS_PER_CHUNK_DEFAULT);
+
+	/* Destroys all elements and releases all chunks */
+	virtual ~SlotMap(void);
+
+	/* Constructs an element in place from 'args',
+	   outputs its handle in 'handle', and returns a pointer to it.
+	   Throws std::bad_alloc if a new chunk is needed,
+	   but cannot be allocated. If the element's constructor throws,
+	   the container is unchanged.
+	 */
+	template<typename... Args> T* emplace(SlotMapHandle& handle, Args&&... args);
+
+	/* Destroys the element identified by 'handle'.
+	   Returns a failure result, and does nothing,
+	   if the handle is stale or was never valid.
+	 */
+	HRESULT remove(const SlotMapHandle& handle);
+
+	/* Destroys the element at the given index,
+	   replacing it with the last element.
+	   The index is not checked.
+	 */
+	void removeAt(const size_t index);
+
+	// Destroys all elements, leaving all chunks allocated
+	void clear(void);
+
+	/* Returns null if the handle is stale or was never valid */
+	T* get(const SlotMapHandle& handle);
+	const T* get(const SlotMapHandle& handle) const;
+
+	bool contains(const SlotMapHandle& handle) const;
+
+	/* Returns the handle of the element at the given index.
+	   The index is not checked.
+	 */
+	SlotMapHandle getHandle(const size_t index) const;
+
+	/* Indices run from zero to size() - 1,
+	   and change when elements are removed.
+	   The index is not checked.
+	 */
+	T& operator[](const size_t index);
+	const T& operator[](const size_t index) const;
+
+	size_t size(void) const;
+	bool isEmpty(void) const;
+
+	// Number of slots allocated, including those holding elements
+	size_t capacity(void) const;
+
+	/* Allocates chunks until there are at least 'nSlots' slots,
+	   so that no heap allocations are made until
+	   more than 'nSlots' elements exist at once.
+	 */
+	void reserve(const size_t nSlots);
+
+private:
+	/* Allocates a chunk and adds its slots to the list of free slots.
+	   Also reserves room in the other vectors for an element in every slot,
+	   so that emplace() never reallocates them.
+	 */
+	void addChunk(void);
+
+	/* Ensures that 'v' can hold at least 'size' elements,
+	   at least doubling its capacity if it must grow,
+	   so that growth costs constant amortized time per element
+	 */
+	template<typename U> static void reserveGeometric(std::vector<U>& v, const size_t size);
+
+	void* getSlotAddress(const size_t slot) const;
+
+	// Data members
+private:
+	struct Slot {
+		/* Odd if the slot holds an element, and even otherwise.
+		   Incremented whenever an element is added or removed.
+		 */
+		UINT generation;
+
+		/* Index in 'm_elements' of the element in the slot,
+		   or the next free slot, if the slot is free
+		 */
+		size_t link;
+	};
+
+	size_t m_slotsPerChunk;
+
+	std::vector<char*> m_chunks;
+
+	std::vector<Slot> m_slots;
+
+	// First free slot
+	size_t m_freeList;
+
+	// Elements in order of their indices
+	std::vector<T*> m_elements;
+
+	// Slots of the elements in 'm_elements'
+	std::vector<size_t> m_elementSlots;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	SlotMap(const SlotMap& other);
+	SlotMap& operator=(const SlotMap& other);
+};
+
+template<typename T> SlotMap<T>::SlotMap(const size_t slotsPerChunk) :
+	m_slotsPerChunk(slotsPerChunk), m_chunks(), m_slots(),
+	m_freeList(SLOTMAP_NO_SLOT), m_elements(), m_elementSlots()
+{
+	if( slotsPerChunk == 0 ) {
+		throw std::exception("Cannot create a SlotMap with zero slots per chunk.");
+	}
+	addChunk();
+}
+
+template<typename T> SlotMap<T>::~SlotMap(void) {
+	clear();
+	const size_t nChunks = m_chunks.size();
+	for( size_t i = 0; i < nChunks; ++i ) {
+		::operator delete(m_chunks[i]);
+		m_chunks[i] = 0;
+	}
+}
+
+template<typename T> template<typename... Args> T* SlotMap<T>::emplace(SlotMapHandle& handle, Args&&... args) {
+	if( m_freeList == SLOTMAP_NO_SLOT ) {
+		addChunk();
+	}
+
+	/* addChunk() reserved room for an element in every slot,
+	   so nothing can fail after the element is constructed
+	 */
+	const size_t slot = m_freeList;
+	T* const element = new(getSlotAddress(slot)) T(std::forward<Args>(args)...);
+
+	Slot& slotData = m_slots[slot];
+	m_freeList = slotData.link;
+	++slotData.generation;
+	slotData.link = m_elements.size();
+	m_elements.push_back(element);
+	m_elementSlots.push_back(slot);
+
+	handle.slot = slot;
+	handle.generation = slotData.generation;
+	return element;
+}
+
+template<typename T> HRESULT SlotMap<T>::remove(const SlotMapHandle& handle) {
+	if( !contains(handle) ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_DATA_NOT_FOUND);
+	}
+	removeAt(m_slots[handle.slot].link);
+	return ERROR_SUCCESS;
+}
+
+template<typename T> void SlotMap<T>::removeAt(const size_t index) {
+	const size_t slot = m_elementSlots[index];
+	m_elements[index]->~T();
+
+	// Fill the gap with the last element
+	const size_t last = m_elements.size() - 1;
+	if( index != last ) {
+		m_elements[index] = m_elements[last];
+		m_elementSlots[index] = m_elementSlots[last];
+		m_slots[m_elementSlots[index]].link = index;
+	}
+	m_elements.pop_back();
+	m_elementSlots.pop_back();
+
+	Slot& slotData = m_slots[slot];
+	++slotData.generation;
+	slotData.link = m_freeList;
+	m_freeList = slot;
+}
+
+template<typename T> void SlotMap<T>::clear(void) {
+	while( !m_elements.empty() ) {
+		removeAt(m_elements.size() - 1);
+	}
+}
+
+template<typename T> T* SlotMap<T>::get(const SlotMapHandle& handle) {
+	if( !contains(handle) ) {
+		return 0;
+	}
+	return m_elements[m_slots[handle.slot].link];
+}
+
+template<typename T> const T* SlotMap<T>::get(const SlotMapHandle& handle) const {
+	if( !contains(handle) ) {
+		return 0;
+	}
+	return m_elements[m_slots[handle.slot].link];
+}
+
+template<typename T> bool SlotMap<T>::contains(const SlotMapHandle& handle) const {
+	return (handle.slot < m_slots.size()) &&
+		((handle.generation & 1) != 0) &&
+		(m_slots[handle.slot].generation == handle.generation);
+}
+
+template<typename T> SlotMapHandle SlotMap<T>::getHandle(const size_t index) const {
+	SlotMapHandle handle;
+	handle.slot = m_elementSlots[index];
+	handle.generation = m_slots[handle.slot].generation;
+	return handle;
+}
+
+template<typename T> T& SlotMap<T>::operator[](const size_t index) {
+	return *m_elements[index];
+}
+
+template<typename T> const T& SlotMap<T>::operator[](const size_t index) const {
+	return *m_elements[index];
+}
+
+template<typename T> size_t SlotMap<T>::size(void) const {
+	return m_elements.size();
+}
+
+template<typename T> bool SlotMap<T>::isEmpty(void) const {
+	return m_elements.empty();
+}
+
+template<typename T> size_t SlotMap<T>::capacity(void) const {
+	return m_slots.size();
+}
+
+template<typename T> void SlotMap<T>::reserve(const size_t nSlots) {
+	while( m_slots.size() < nSlots ) {
+		addChunk();
+	}
+}
+
+template<typename T> void SlotMap<T>::addChunk(void) {
+	// Grow the vectors before allocating the chunk, so that nothing can fail afterwards
+	const size_t nSlots = m_slots.size() + m_slotsPerChunk;
+	reserveGeometric(m_chunks, m_chunks.size() + 1);
+	reserveGeometric(m_slots, nSlots);
+	reserveGeometric(m_elements, nSlots);
+	reserveGeometric(m_elementSlots, nSlots);
+
+	char* const chunk = static_cast<char*>(::operator new(m_slotsPerChunk * sizeof(T)));
+	m_chunks.push_back(chunk);
+
+	// Link the new slots so that they are used in order
+	const size_t firstSlot = m_slots.size();
+	m_slots.resize(firstSlot + m_slotsPerChunk);
+	for( size_t i = m_slotsPerChunk; i > 0; --i ) {
+		Slot& slotData = m_slots[firstSlot + i - 1];
+		slotData.generation = 0;
+		slotData.link = m_freeList;
+		m_freeList = firstSlot + i - 1;
+	}
+}
+
+template<typename T> template<typename U> void SlotMap<T>::reserveGeometric(std::vector<U>& v, const size_t size) {
+	if( v.capacity() < size ) {
+		const size_t doubled = 2 * v.capacity();
+		v.reserve((doubled > size) ? doubled : size);
+	}
+}
+
+template<typename T> void* SlotMap<T>::getSlotAddress(const size_t slot) const {
+	return m_chunks[slot / m_slotsPerChunk] + (slot % m_slotsPerChunk) * sizeof(T);
+}
@@ -0,0 +1,85 @@
+/*
+WorkerPool.h
+------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: None
+
+Description
+  -A fixed set of worker threads which execute batches of independent tasks.
+  -Each call to run() executes a function for every task index in a range,
+     distributing the indices among the worker threads and the calling thread,
+     and returns once all tasks are complete.
+  -Tasks are claimed dynamically, so the assignment of tasks to threads
+     is not deterministic. Tasks must therefore not depend on each other.
+
+Notes
+  -run() must not be called concurrently from multiple threads,
+     or from within a task.
+*/
+
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+class WorkerPool {
+
+public:
+	/* 'nThreads' is the total number of threads which will execute tasks,
+	   including the thread calling run(). If zero, the number of
+	   hardware threads will be used.
+	 */
+	WorkerPool(const size_t nThreads = 0);
+
+	/* Stops and joins all worker threads */
+	virtual ~WorkerPool(void);
+
+	size_t getNumberOfThreads(void) const;
+
+	/* Calls 'task' once for each index in the range [0, nTasks),
+	   and returns when all calls have finished.
+	 */
+	HRESULT run(const size_t nTasks, const std::function<void(const size_t)>& task);
+
+private:
+	void workerLoop(void);
+
+	/* Executes tasks until there are none left to claim */
+	void runTasks(void);
+
+	// Data members
+private:
+	std::vector<std::thread> m_threads;
+
+	std::mutex m_mutex;
+	std::condition_variable m_startCondition;
+	std::condition_variable m_doneCondition;
+
+	// Current batch of tasks - Shared with worker threads under 'm_mutex'
+	const std::function<void(const size_t)>* m_task;
+	size_t m_nTasks;
+	std::atomic<size_t> m_nextTask;
+
+	// Number of worker threads which have not finished the current batch
+	size_t m_nBusyWorkers;
+
+	// Incremented for each batch, to wake worker threads
+	unsigned long m_batch;
+
+	bool m_quit;
+
+	// Currently not implemented - will cause linker errors if called
+private:
+	WorkerPool(const WorkerPool& other);
+	WorkerPool& operator=(const WorkerPool& other);
+};
@@ -0,0 +1,508 @@
+/*
+testAnimation.cpp
+-----------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testTransformSystem.cpp
+
+Description
+  -Implementations of test functions for the AnimationClip
+     and AnimationSampler classes
+*/
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+#include "testAnimation.h"
+#include "AnimationClip.h"
+#include "AnimationSampler.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+
+// Number of bones in the test skeletons
+#define TESTANIMATION_N_BONES 23
+
+// Number of keys per track before compression
+#define TESTANIMATION_N_KEYS 121
+
+// Duration of the test clips (milliseconds)
+#define TESTANIMATION_DURATION 4000.0f
+
+// Key reduction tolerance used by the tests
+#define TESTANIMATION_TOLERANCE 1.0e-3f
+
+// Number of times at which clips are sampled in the tests
+#define TESTANIMATION_N_SAMPLES 500
+
+// Maximum difference allowed between matrix elements in the sampler test
+#define TESTANIMATION_MATRIX_TOLERANCE 1.0e-4f
+
+// Numbers of bones in the benchmark skeletons
+#define TESTANIMATION_BENCHMARK_BONES { 16, 64, 256 }
+
+// Number of poses evaluated per skeleton in the benchmark
+#define TESTANIMATION_N_POSES 2000
+
+namespace testAnimation {
+
+	/* Returns a smooth random key value for the given channel
+	   at the given time, controlled by the parameters in 'p'
+	 */
+	static XMFLOAT4 smoothValue(const AnimationClip::Channel channel, const float time, const float* const p) {
+		const float phase = time / TESTANIMATION_DURATION * XM_2PI;
+		switch( channel ) {
+		case AnimationClip::Channel::TRANSLATION:
+			return XMFLOAT4(p[0] * std::sin(phase + p[1]), p[2] * std::cos(2.0f * phase + p[3]),
+				p[4] * std::sin(3.0f * phase), 0.0f);
+		case AnimationClip::Channel::ROTATION:
+		{
+			XMFLOAT4 q;
+			XMVECTOR axis = XMVector3Normalize(XMVectorSet(p[0], p[2], p[4] + 0.1f, 0.0f));
+			XMStoreFloat4(&q, XMQuaternionRotationAxis(axis, p[1] * std::sin(phase + p[3])));
+			return q;
+		}
+		default:
+			return XMFLOAT4(1.0f + 0.2f * std::sin(phase + p[1]), 1.0f + 0.1f * std::cos(phase + p[3]), 1.0f, 0.0f);
+		}
+	}
+
+	/* Fills the clip with smooth random tracks, and outputs the original keys
+	   of each track (in the order of bones, then channels) to 'keys'
+	 */
+	static void fillClip(AnimationClip& clip, std::vector<XMFLOAT4>& keys,
+		std::vector<float>& times, std::default_random_engine& generator) {
+		std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+		const size_t nBones = clip.getNumberOfBones();
+		times.resize(TESTANIMATION_N_KEYS);
+		for( size_t k = 0; k < TESTANIMATION_N_KEYS; ++k ) {
+			times[k] = TESTANIMATION_DURATION * static_cast<float>(k) / static_cast<float>(TESTANIMATION_N_KEYS - 1);
+		}
+		keys.resize(nBones * AnimationClip::N_CHANNELS * TESTANIMATION_N_KEYS);
+		float p[5];
+		for( size_t i = 0; i < nBones; ++i ) {
+			for( size_t c = 0; c < AnimationClip::N_CHANNELS; ++c ) {
+				for( size_t j = 0; j < 5; ++j ) {
+					p[j] = distribution(generator);
+				}
+				XMFLOAT4* track = &keys[(i * AnimationClip::N_CHANNELS + c) * TESTANIMATION_N_KEYS];
+				for( size_t k = 0; k < TESTANIMATION_N_KEYS; ++k ) {
+					track[k] = smoothValue(static_cast<AnimationClip::Channel>(c), times[k], p);
+				}
+				clip.setTrack(i, static_cast<AnimationClip::Channel>(c), &times[0], track,
+					TESTANIMATION_N_KEYS, TESTANIMATION_TOLERANCE);
+			}
+		}
+	}
+
+	/* Returns the piecewise linear interpolation of the keys at the given time */
+	static XMVECTOR interpolateKeys(const XMFLOAT4* const keys, const std::vector<float>& times, const float time) {
+		size_t k = 1;
+		while( k < times.size() - 1 && times[k] < time ) {
+			++k;
+		}
+		const float u = (time - times[k - 1]) / (times[k] - times[k - 1]);
+		return XMVectorLerp(XMLoadFloat4(keys + k - 1), XMLoadFloat4(keys + k), u);
+	}
+
+	// Returns the largest absolute difference between components of the two vectors
+	static float maxDifference(const XMVECTOR& a, const XMVECTOR& b) {
+		XMFLOAT4 d;
+		XMStoreFloat4(&d, XMVectorAbs(XMVectorSubtract(a, b)));
+		float result = (d.x > d.y) ? d.x : d.y;
+		result = (result > d.z) ? result : d.z;
+		return (result > d.w) ? result : d.w;
+	}
+
+	// Returns the largest absolute difference between elements of the two matrices
+	static float maxDifference(const XMFLOAT4X4& a, const XMFLOAT4X4& b) {
+		float result = 0.0f;
+		float d = 0.0f;
+		for( size_t r = 0; r < 4; ++r ) {
+			d = maxDifference(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(a.m[r])),
+				XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(b.m[r])));
+			result = (result > d) ? result : d;
+		}
+		return result;
+	}
+
+	static void randomSkeleton(std::vector<size_t>& parents, const size_t nBones, std::default_random_engine& generator) {
+		parents.resize(nBones);
+		parents[0] = ANIMATIONSAMPLER_NO_PARENT;
+		for( size_t i = 1; i < nBones; ++i ) {
+			std::uniform_int_distribution<size_t> distribution(0, i - 1);
+			parents[i] = distribution(generator);
+		}
+	}
+
+	/* Computes the model space transformations of the bones for a blend of
+	   two clips (or for the first clip alone, if 'clipB' is null),
+	   one bone at a time
+	 */
+	static void referencePose(std::vector<XMFLOAT4X4>& transforms, const std::vector<size_t>& parents,
+		const AnimationClip& clipA, const float timeA,
+		const AnimationClip* const clipB, const float timeB, const float weight) {
+		const size_t nBones = parents.size();
+		std::vector<XMFLOAT4> t(nBones), r(nBones), s(nBones);
+		std::vector<XMFLOAT4> tB(nBones), rB(nBones), sB(nBones);
+		clipA.sampleChannel(&t[0], AnimationClip::Channel::TRANSLATION, timeA);
+		clipA.sampleChannel(&r[0], AnimationClip::Channel::ROTATION, timeA);
+		clipA.sampleChannel(&s[0], AnimationClip::Channel::SCALE, timeA);
+		if( clipB != 0 ) {
+			clipB->sampleChannel(&tB[0], AnimationClip::Channel::TRANSLATION, timeB);
+			clipB->sampleChannel(&rB[0], AnimationClip::Channel::ROTATION, timeB);
+			clipB->sampleChannel(&sB[0], AnimationClip::Channel::SCALE, timeB);
+		}
+
+		transforms.resize(nBones);
+		XMVECTOR translation, rotation, scale, rotationB;
+		XMMATRIX local;
+		for( size_t i = 0; i < nBones; ++i ) {
+			translation = XMLoadFloat4(&t[i]);
+			rotation = XMQuaternionNormalize(XMLoadFloat4(&r[i]));
+			scale = XMLoadFloat4(&s[i]);
+			if( clipB != 0 ) {
+				translation = XMVectorLerp(translation, XMLoadFloat4(&tB[i]), weight);
+				scale = XMVectorLerp(scale, XMLoadFloat4(&sB[i]), weight);
+				rotationB = XMQuaternionNormalize(XMLoadFloat4(&rB[i]));
+				if( XMVectorGetX(XMVector4Dot(rotation, rotationB)) < 0.0f ) {
+					rotationB = XMVectorNegate(rotationB);
+				}
+				rotation = XMQuaternionNormalize(XMVectorLerp(rotation, rotationB, weight));
+			}
+			local = XMMatrixAffineTransformation(scale, XMVectorZero(), rotation, translation);
+			if( parents[i] != ANIMATIONSAMPLER_NO_PARENT ) {
+				local = XMMatrixMultiply(local, XMLoadFloat4x4(&transforms[parents[i]]));
+			}
+			XMStoreFloat4x4(&transforms[i], local);
+		}
+	}
+
+	static double elapsedMilliseconds(const LARGE_INTEGER& start, const LARGE_INTEGER& end, const LARGE_INTEGER& frequency) {
+		return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+}
+
+HRESULT testAnimation::testCompression(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testAnimation_testCompression.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+
+	std::default_random_engine generator(3501);
+	AnimationClip clip(TESTANIMATION_N_BONES, TESTANIMATION_DURATION, false);
+	std::vector<XMFLOAT4> keys;
+	std::vector<float> times;
+	fillClip(clip, keys, times, generator);
+
+	const size_t nOriginalKeys = TESTANIMATION_N_BONES * AnimationClip::N_CHANNELS * TESTANIMATION_N_KEYS;
+	logger->logMessage(L"Keys: " + std::to_wstring(clip.getNumberOfKeys()) +
+		L", out of " + std::to_wstring(nOriginalKeys));
+	logger->logMessage(L"Size: " + std::to_wstring(clip.getSizeInBytes()) +
+		L" bytes, compared to " + std::to_wstring(nOriginalKeys * (sizeof(float) + sizeof(XMFLOAT4))) +
+		L" bytes of uncompressed keys");
+
+	// Compare samples with the original keys
+	std::vector<XMFLOAT4> sampled(TESTANIMATION_N_BONES);
+	float maxError[AnimationClip::N_CHANNELS] = { 0.0f, 0.0f, 0.0f };
+	float error = 0.0f;
+	float time = 0.0f;
+	XMVECTOR expected, actual;
+	for( size_t n = 0; n <= TESTANIMATION_N_SAMPLES; ++n ) {
+		time = TESTANIMATION_DURATION * static_cast<float>(n) / static_cast<float>(TESTANIMATION_N_SAMPLES);
+		for( size_t c = 0; c < AnimationClip::N_CHANNELS; ++c ) {
+			clip.sampleChannel(&sampled[0], static_cast<AnimationClip::Channel>(c), time);
+			for( size_t i = 0; i < TESTANIMATION_N_BONES; ++i ) {
+				expected = interpolateKeys(&keys[(i * AnimationClip::N_CHANNELS + c) * TESTANIMATION_N_KEYS], times, time);
+				actual = XMLoadFloat4(&sampled[i]);
+				if( c == static_cast<size_t>(AnimationClip::Channel::ROTATION) ) {
+					expected = XMQuaternionNormalize(expected);
+					actual = XMQuaternionNormalize(actual);
+					if( XMVectorGetX(XMVector4Dot(expected, actual)) < 0.0f ) {
+						actual = XMVectorNegate(actual);
+					}
+				} else {
+					expected = XMVectorSetW(expected, 0.0f);
+				}
+				error = maxDifference(expected, actual);
+				maxError[c] = (maxError[c] > error) ? maxError[c] : error;
+			}
+		}
+	}
+
+	/* Quantization of values over ranges of up to 4 units,
+	   and of times, adds to the key reduction tolerance
+	 */
+	const float allowedError = TESTANIMATION_TOLERANCE + 5.0e-4f;
+	const wchar_t* channelNames[AnimationClip::N_CHANNELS] = { L"translation", L"rotation", L"scale" };
+	for( size_t c = 0; c < AnimationClip::N_CHANNELS; ++c ) {
+		logger->logMessage(L"Maximum " + std::wstring(channelNames[c]) + L" error: " + std::to_wstring(maxError[c]));
+		if( maxError[c] > allowedError ) {
+			logger->logMessage(L"Test failed: Error exceeds " + std::to_wstring(allowedError) + L".");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	// Constant and linear tracks
+	std::vector<XMFLOAT4> constantKeys(TESTANIMATION_N_KEYS, XMFLOAT4(1.0f, -2.0f, 3.0f, 0.0f));
+	std::vector<XMFLOAT4> linearKeys(TESTANIMATION_N_KEYS);
+	for( size_t k = 0; k < TESTANIMATION_N_KEYS; ++k ) {
+		linearKeys[k] = XMFLOAT4(times[k] * 0.001f, 2.0f - times[k] * 0.0005f, 0.0f, 0.0f);
+	}
+	AnimationClip simpleClip(2, TESTANIMATION_DURATION, false);
+	simpleClip.setTrack(0, AnimationClip::Channel::TRANSLATION, &times[0], &constantKeys[0], TESTANIMATION_N_KEYS);
+	simpleClip.setTrack(1, AnimationClip::Channel::TRANSLATION, &times[0], &linearKeys[0], TESTANIMATION_N_KEYS);
+	// One key per constant track, plus two keys for the linear track
+	if( simpleClip.getNumberOfKeys() != 2 * AnimationClip::N_CHANNELS + 1 ) {
+		logger->logMessage(L"Test failed: Constant and linear tracks were stored with " +
+			std::to_wstring(simpleClip.getNumberOfKeys()) + L" keys.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	simpleClip.sampleChannel(&sampled[0], AnimationClip::Channel::TRANSLATION, 1234.0f);
+	if( maxDifference(XMLoadFloat4(&sampled[0]), XMLoadFloat4(&constantKeys[0])) > 1.0e-6f ||
+		maxDifference(XMLoadFloat4(&sampled[1]), XMVectorSet(1.234f, 2.0f - 0.617f, 0.0f, 0.0f)) > 1.0e-4f ) {
+		logger->logMessage(L"Test failed: Constant or linear track sampled incorrectly.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Invalid tracks
+	std::vector<float> badTimes(times);
+	badTimes[5] = badTimes[4];
+	const XMFLOAT4 zeroRotation(0.0f, 0.0f, 0.0f, 0.0f);
+	if( SUCCEEDED(simpleClip.setTrack(0, AnimationClip::Channel::SCALE, &badTimes[0], &linearKeys[0], TESTANIMATION_N_KEYS)) ||
+		SUCCEEDED(simpleClip.setTrack(2, AnimationClip::Channel::SCALE, &times[0], &linearKeys[0], TESTANIMATION_N_KEYS)) ||
+		SUCCEEDED(simpleClip.setTrack(0, AnimationClip::Channel::ROTATION, &times[0], &zeroRotation, 1)) ||
+		SUCCEEDED(simpleClip.setTrack(0, AnimationClip::Channel::SCALE, &times[0], &linearKeys[0], 0)) ) {
+		logger->logMessage(L"Test failed: An invalid track was accepted.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testAnimation::testSampler(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testAnimation_testSampler.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+
+	std::default_random_engine generator(3501);
+	std::vector<size_t> parents;
+	randomSkeleton(parents, TESTANIMATION_N_BONES, generator);
+	AnimationSampler sampler(parents);
+
+	AnimationClip clipA(TESTANIMATION_N_BONES, TESTANIMATION_DURATION, true);
+	AnimationClip clipB(TESTANIMATION_N_BONES, TESTANIMATION_DURATION, true);
+	std::vector<XMFLOAT4> keys;
+	std::vector<float> times;
+	fillClip(clipA, keys, times, generator);
+	fillClip(clipB, keys, times, generator);
+
+	std::uniform_real_distribution<float> timeDistribution(-TESTANIMATION_DURATION, 2.0f * TESTANIMATION_DURATION);
+	std::uniform_real_distribution<float> weightDistribution(0.0f, 1.0f);
+	std::vector<XMFLOAT4X4> expected;
+	XMFLOAT4X4 actual;
+	float maxError = 0.0f;
+	float maxBlendError = 0.0f;
+	float error = 0.0f;
+	float timeA = 0.0f;
+	float timeB = 0.0f;
+	float weight = 0.0f;
+
+	for( size_t n = 0; n < TESTANIMATION_N_SAMPLES; ++n ) {
+		timeA = timeDistribution(generator);
+		timeB = timeDistribution(generator);
+		weight = weightDistribution(generator);
+
+		// Single clip
+		if( FAILED(sampler.sample(clipA, timeA)) ) {
+			logger->logMessage(L"Test failed: sample() failed.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+		referencePose(expected, parents, clipA, timeA, 0, 0.0f, 0.0f);
+		for( size_t i = 0; i < TESTANIMATION_N_BONES; ++i ) {
+			sampler.getModelTransform(i, actual);
+			error = maxDifference(actual, expected[i]);
+			maxError = (maxError > error) ? maxError : error;
+		}
+
+		// Blend
+		if( FAILED(sampler.blend(clipA, timeA, clipB, timeB, weight)) ) {
+			logger->logMessage(L"Test failed: blend() failed.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+		referencePose(expected, parents, clipA, timeA, &clipB, timeB, weight);
+		for( size_t i = 0; i < TESTANIMATION_N_BONES; ++i ) {
+			sampler.getModelTransform(i, actual);
+			error = maxDifference(actual, expected[i]);
+			maxBlendError = (maxBlendError > error) ? maxBlendError : error;
+		}
+	}
+
+	logger->logMessage(L"Maximum difference from reference, single clip: " + std::to_wstring(maxError));
+	logger->logMessage(L"Maximum difference from reference, blended clips: " + std::to_wstring(maxBlendError));
+	if( maxError > TESTANIMATION_MATRIX_TOLERANCE || maxBlendError > TESTANIMATION_MATRIX_TOLERANCE ) {
+		logger->logMessage(L"Test failed.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Bone matrices for vertex skinning
+	std::vector<XMFLOAT4X4> invBindMatrices(TESTANIMATION_N_BONES);
+	std::vector<XMFLOAT4X4> positionTransforms(TESTANIMATION_N_BONES);
+	std::vector<XMFLOAT4X4> normalTransforms(TESTANIMATION_N_BONES);
+	for( size_t i = 0; i < TESTANIMATION_N_BONES; ++i ) {
+		XMStoreFloat4x4(&invBindMatrices[i], XMMatrixTranslation(0.0f, -static_cast<float>(i), 0.0f));
+	}
+	XMFLOAT4X4 world;
+	XMStoreFloat4x4(&world, XMMatrixMultiply(XMMatrixRotationY(0.5f), XMMatrixTranslation(3.0f, 0.0f, -1.0f)));
+	sampler.sample(clipA, timeA);
+	referencePose(expected, parents, clipA, timeA, 0, 0.0f, 0.0f);
+	if( FAILED(sampler.writeBoneMatrices(&positionTransforms[0], &normalTransforms[0], &invBindMatrices[0], world)) ) {
+		logger->logMessage(L"Test failed: writeBoneMatrices() failed.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	XMMATRIX transform;
+	XMFLOAT4X4 expectedPosition, expectedNormal;
+	maxError = 0.0f;
+	for( size_t i = 0; i < TESTANIMATION_N_BONES; ++i ) {
+		transform = XMMatrixMultiply(XMMatrixMultiply(XMLoadFloat4x4(&invBindMatrices[i]),
+			XMLoadFloat4x4(&expected[i])), XMLoadFloat4x4(&world));
+		XMStoreFloat4x4(&expectedPosition, XMMatrixTranspose(transform));
+		XMStoreFloat4x4(&expectedNormal, XMMatrixInverse(0, transform));
+		error = maxDifference(positionTransforms[i], expectedPosition);
+		maxError = (maxError > error) ? maxError : error;
+		error = maxDifference(normalTransforms[i], expectedNormal);
+		maxError = (maxError > error) ? maxError : error;
+	}
+	logger->logMessage(L"Maximum difference from reference, bone matrices: " + std::to_wstring(maxError));
+	if( maxError > TESTANIMATION_MATRIX_TOLERANCE * 10.0f ) {
+		logger->logMessage(L"Test failed.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Mismatched clips and invalid weights
+	AnimationClip smallClip(TESTANIMATION_N_BONES - 1, TESTANIMATION_DURATION);
+	if( SUCCEEDED(sampler.sample(smallClip, 0.0f)) ||
+		SUCCEEDED(sampler.blend(clipA, 0.0f, clipB, 0.0f, 1.5f)) ) {
+		logger->logMessage(L"Test failed: Invalid input was accepted.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testAnimation::benchmarkSampling(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testAnimation_benchmarkSampling.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	const size_t boneCounts[] = TESTANIMATION_BENCHMARK_BONES;
+	std::default_random_engine generator(3501);
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+	std::vector<XMFLOAT4> keys;
+	std::vector<float> times;
+	XMFLOAT4X4 world;
+	XMStoreFloat4x4(&world, XMMatrixIdentity());
+	const float timeStep = 16.0f;
+
+	for( size_t b = 0; b < sizeof(boneCounts) / sizeof(boneCounts[0]); ++b ) {
+		const size_t nBones = boneCounts[b];
+		std::vector<size_t> parents;
+		randomSkeleton(parents, nBones, generator);
+		AnimationSampler sampler(parents);
+		AnimationClip clipA(nBones, TESTANIMATION_DURATION, true);
+		AnimationClip clipB(nBones, TESTANIMATION_DURATION, true);
+		fillClip(clipA, keys, times, generator);
+		fillClip(clipB, keys, times, generator);
+
+		std::vector<XMFLOAT4X4> invBindMatrices(nBones, world);
+		std::vector<XMFLOAT4X4> positionTransforms(nBones);
+		std::vector<XMFLOAT4X4> normalTransforms(nBones);
+
+		const double nSampled = static_cast<double>(nBones) * TESTANIMATION_N_POSES;
+		double elapsed[4];
+
+		QueryPerformanceCounter(&start);
+		for( size_t n = 0; n < TESTANIMATION_N_POSES; ++n ) {
+			sampler.sample(clipA, n * timeStep);
+		}
+		QueryPerformanceCounter(&end);
+		elapsed[0] = elapsedMilliseconds(start, end, frequency);
+
+		QueryPerformanceCounter(&start);
+		for( size_t n = 0; n < TESTANIMATION_N_POSES; ++n ) {
+			sampler.blend(clipA, n * timeStep, clipB, n * timeStep * 0.7f, 0.3f);
+		}
+		QueryPerformanceCounter(&end);
+		elapsed[1] = elapsedMilliseconds(start, end, frequency);
+
+		QueryPerformanceCounter(&start);
+		for( size_t n = 0; n < TESTANIMATION_N_POSES; ++n ) {
+			sampler.sample(clipA, n * timeStep);
+			sampler.writeBoneMatrices(&positionTransforms[0], &normalTransforms[0], &invBindMatrices[0], world);
+		}
+		QueryPerformanceCounter(&end);
+		elapsed[2] = elapsedMilliseconds(start, end, frequency);
+
+		QueryPerformanceCounter(&start);
+		for( size_t n = 0; n < TESTANIMATION_N_POSES; ++n ) {
+			sampler.blend(clipA, n * timeStep, clipB, n * timeStep * 0.7f, 0.3f);
+			sampler.writeBoneMatrices(&positionTransforms[0], &normalTransforms[0], &invBindMatrices[0], world);
+		}
+		QueryPerformanceCounter(&end);
+		elapsed[3] = elapsedMilliseconds(start, end, frequency);
+
+		logger->logMessage(std::to_wstring(nBones) + L" bones, " +
+			std::to_wstring(clipA.getNumberOfKeys()) + L" keys per clip (" +
+			std::to_wstring(clipA.getSizeInBytes()) + L" bytes):");
+		logger->logMessage(L"Single clip: " + std::to_wstring(nSampled / elapsed[0] * 1000.0) + L" bones per second");
+		logger->logMessage(L"Blended clips: " + std::to_wstring(nSampled / elapsed[1] * 1000.0) + L" bones per second");
+		logger->logMessage(L"Single clip, with bone matrices: " + std::to_wstring(nSampled / elapsed[2] * 1000.0) + L" bones per second");
+		logger->logMessage(L"Blended clips, with bone matrices: " + std::to_wstring(nSampled / elapsed[3] * 1000.0) + L" bones per second");
+	}
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
@@ -0,0 +1,502 @@
+/*
+testBurstVertexGenerator.cpp
+----------------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testTransformScheduler.cpp
+
+Description
+  -Implementations of test functions for the BurstVertexGenerator class
+*/
+
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstring> // for memcmp()
+#include "testBurstVertexGenerator.h"
+#include "BurstVertexGenerator.h"
+#include "WorkerPool.h"
+#include "CounterRNG.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+using std::wstring;
+
+// Maximum allowed difference from hand-computed or serially-computed values
+#define TESTBURSTVERTEXGENERATOR_TOLERANCE 1.0e-5f
+
+// Grid dimensions in the correctness tests (not multiples of the vectorization width)
+#define TESTBURSTVERTEXGENERATOR_N_COLUMNS 53
+#define TESTBURSTVERTEXGENERATOR_N_ROWS 37
+
+// Grid dimensions, and number of repetitions, in the benchmark
+#define TESTBURSTVERTEXGENERATOR_N_BENCHMARK_COLUMNS 1000
+#define TESTBURSTVERTEXGENERATOR_N_BENCHMARK_ROWS 1000
+#define TESTBURSTVERTEXGENERATOR_N_BENCHMARK_REPETITIONS 5
+
+// Random number generator parameters
+#define TESTBURSTVERTEXGENERATOR_SEED 3501
+#define TESTBURSTVERTEXGENERATOR_INSTANCE_ID 17
+
+namespace testBurstVertexGenerator {
+
+	// Similar to the jet particle system parameters
+	static void getParameters(BurstVertexGenerator::Parameters& parameters,
+		const size_t nColumns, const size_t nRows, const bool debugColorCasts) {
+		parameters.nColumns = nColumns;
+		parameters.nRows = nRows;
+		parameters.billboard = XMFLOAT3(0.05f, 0.07f, 0.3f);
+		parameters.linearSpeed = 0.002f;
+		parameters.life = XMFLOAT4(-500.0f, 2000.0f, 1.5f, 0.1f);
+		parameters.colorCast = XMFLOAT4(1.0f, 0.5f, 0.25f, 0.75f);
+		parameters.debugColorCasts = debugColorCasts;
+	}
+
+	static void getConeParameters(BurstVertexGenerator::ConeParameters& coneParameters) {
+		coneParameters.maxPhi = 0.1f;
+		coneParameters.minR = 0.5f;
+		coneParameters.maxR = 2.0f;
+	}
+
+	/* Computes vertices one at a time, drawing random values
+	   in the same way as the original RandomBurstCone::addVertices()
+	 */
+	static void coneSerially(ParticleVertexType* const vertices,
+		const BurstVertexGenerator::Parameters& parameters,
+		const BurstVertexGenerator::ConeParameters& coneParameters, const CounterRNG& rng) {
+
+		CounterRNG serialRng(rng);
+		serialRng.setDrawIndex(0);
+		std::vector<float> rowValues(1 + 2 * parameters.nColumns);
+		const float* value = 0;
+		ParticleVertexType* vertex = vertices;
+		float u = 0.0f;
+		float v = 0.0f;
+		float w = 0.0f;
+		for( size_t i = 0; i < parameters.nRows; ++i ) {
+			serialRng.uniform(&rowValues[0], rowValues.size());
+			value = &rowValues[0];
+			v = *value++;
+			for( size_t j = 0; j < parameters.nColumns; ++j ) {
+				u = *value++;
+				w = *value++;
+				BurstVertexGenerator::coneVertex(*vertex, parameters, coneParameters, u, v, w);
+				++vertex;
+			}
+		}
+	}
+
+	// Computes vertices one at a time
+	static void sphereSerially(ParticleVertexType* const vertices,
+		const BurstVertexGenerator::Parameters& parameters) {
+		ParticleVertexType* vertex = vertices;
+		float u = 0.0f;
+		float v = 0.0f;
+		for( size_t i = 0; i < parameters.nRows; ++i ) {
+			v = static_cast<float>(i) / static_cast<float>(parameters.nRows);
+			for( size_t j = 0; j < parameters.nColumns; ++j ) {
+				u = static_cast<float>(j) / static_cast<float>(parameters.nColumns);
+				BurstVertexGenerator::sphereVertex(*vertex, parameters, u, v);
+				++vertex;
+			}
+		}
+	}
+
+	static bool isClose(const float a, const float b, const float tolerance) {
+		return std::abs(a - b) <= tolerance;
+	}
+
+	static bool isClose(const XMFLOAT3& a, const XMFLOAT3& b, const float tolerance) {
+		return isClose(a.x, b.x, tolerance) && isClose(a.y, b.y, tolerance) && isClose(a.z, b.z, tolerance);
+	}
+
+	static bool isClose(const XMFLOAT4& a, const XMFLOAT4& b, const float tolerance) {
+		return isClose(a.x, b.x, tolerance) && isClose(a.y, b.y, tolerance) &&
+			isClose(a.z, b.z, tolerance) && isClose(a.w, b.w, tolerance);
+	}
+
+	static bool isEqual(const XMFLOAT3& a, const XMFLOAT3& b) {
+		return a.x == b.x && a.y == b.y && a.z == b.z;
+	}
+
+	static bool isEqual(const XMFLOAT4& a, const XMFLOAT4& b) {
+		return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
+	}
+
+	// Returns the number of vertices which are not bitwise identical
+	static size_t countMismatches(const std::vector<ParticleVertexType>& a, const std::vector<ParticleVertexType>& b) {
+		size_t nMismatches = 0;
+		for( size_t i = 0; i < a.size(); ++i ) {
+			if( memcmp(&a[i], &b[i], sizeof(ParticleVertexType)) != 0 ) {
+				++nMismatches;
+			}
+		}
+		return nMismatches;
+	}
+
+	static double elapsedMilliseconds(const LARGE_INTEGER& start, const LARGE_INTEGER& end, const LARGE_INTEGER& frequency) {
+		return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+}
+
+HRESULT testBurstVertexGenerator::testSphere(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testBurstVertexGenerator_testSphere.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT result = ERROR_SUCCESS;
+	BurstVertexGenerator generator;
+	BurstVertexGenerator::Parameters parameters;
+
+	// Hand-computed vertices on a 4 x 4 grid
+	getParameters(parameters, 4, 4, true);
+	std::vector<ParticleVertexType> vertices(16);
+	if( FAILED(generator.sphere(&vertices[0], parameters)) ) {
+		logger->logMessage(L"Test failed: BurstVertexGenerator::sphere() returned a failure result.");
+		delete logger;
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// (row, column, expected position)
+	struct SphereCase {
+		size_t i;
+		size_t j;
+		XMFLOAT3 position;
+	};
+	const SphereCase cases[] = {
+		{ 0, 0, XMFLOAT3(0.0f, -1.0f, 0.0f) }, // v = 0 is the south pole
+		{ 2, 0, XMFLOAT3(1.0f, 0.0f, 0.0f) }, // v = 0.5 is the equator
+		{ 2, 1, XMFLOAT3(0.0f, 0.0f, 1.0f) },
+		{ 2, 2, XMFLOAT3(-1.0f, 0.0f, 0.0f) },
+		{ 1, 3, XMFLOAT3(0.0f, -0.5f, -0.8660254f) } // phi = acos(-0.5), theta = 3 * pi / 2
+	};
+	const size_t nCases = sizeof(cases) / sizeof(SphereCase);
+	for( size_t c = 0; c < nCases; ++c ) {
+		const ParticleVertexType& vertex = vertices[cases[c].i * 4 + cases[c].j];
+		const float u = static_cast<float>(cases[c].j) / 4.0f;
+		const float v = static_cast<float>(cases[c].i) / 4.0f;
+		const XMFLOAT3& expected = cases[c].position;
+		if( !isClose(vertex.position, expected, TESTBURSTVERTEXGENERATOR_TOLERANCE) ||
+			!isClose(vertex.linearVelocity, XMFLOAT4(expected.x, expected.y, expected.z, parameters.linearSpeed), TESTBURSTVERTEXGENERATOR_TOLERANCE) ||
+			!isEqual(vertex.billboard, parameters.billboard) ||
+			!isEqual(vertex.life, parameters.life) ||
+			!isEqual(vertex.index, XMFLOAT4(u, v, 1.0f, 1.0f)) ) {
+			logger->logMessage(L"Test failed: Incorrect sphere vertex at row " + std::to_wstring(cases[c].i) +
+				L", column " + std::to_wstring(cases[c].j) + L". Position = (" +
+				std::to_wstring(vertex.position.x) + L", " + std::to_wstring(vertex.position.y) + L", " +
+				std::to_wstring(vertex.position.z) + L").");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	// Comparison with vertices computed one at a time
+	const bool debugColorCasts[] = { false, true };
+	for( size_t d = 0; d < 2; ++d ) {
+		getParameters(parameters, TESTBURSTVERTEXGENERATOR_N_COLUMNS, TESTBURSTVERTEXGENERATOR_N_ROWS, debugColorCasts[d]);
+		const size_t nVertices = parameters.nColumns * parameters.nRows;
+		vertices.assign(nVertices, ParticleVertexType());
+		std::vector<ParticleVertexType> expected(nVertices);
+		sphereSerially(&expected[0], parameters);
+		if( FAILED(generator.sphere(&vertices[0], parameters)) ) {
+			logger->logMessage(L"Test failed: BurstVertexGenerator::sphere() returned a failure result.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		} else {
+			const size_t nMismatches = countMismatches(vertices, expected);
+			if( nMismatches != 0 ) {
+				logger->logMessage(L"Test failed: " + std::to_wstring(nMismatches) + L" of " + std::to_wstring(nVertices) +
+					L" sphere vertices differ from those computed one at a time (debug colour casts = " +
+					std::to_wstring(debugColorCasts[d]) + L").");
+				result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+		}
+	}
+
+	// Invalid input
+	if( SUCCEEDED(generator.sphere(0, parameters)) ) {
+		logger->logMessage(L"Test failed: BurstVertexGenerator::sphere() accepted a null vertex array.");
+		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(result) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return result;
+}
+
+HRESULT testBurstVertexGenerator::testCone(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testBurstVertexGenerator_testCone.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT result = ERROR_SUCCESS;
+	BurstVertexGenerator generator;
+	BurstVertexGenerator::Parameters parameters;
+	BurstVertexGenerator::ConeParameters coneParameters;
+	getConeParameters(coneParameters);
+
+	/* Hand-computed vertex: The cone's axis is rotated from the y-axis to the z-axis,
+	   and a radius parameter of 1 places the particle at the maximum radius.
+	 */
+	getParameters(parameters, 1, 1, false);
+	ParticleVertexType vertex;
+	BurstVertexGenerator::coneVertex(vertex, parameters, coneParameters, 0.0f, 0.0f, 1.0f);
+	if( !isClose(vertex.position, XMFLOAT3(0.0f, 0.0f, coneParameters.maxR), TESTBURSTVERTEXGENERATOR_TOLERANCE) ||
+		!isClose(vertex.linearVelocity, XMFLOAT4(0.0f, 0.0f, 1.0f, 0.0f), TESTBURSTVERTEXGENERATOR_TOLERANCE) ||
+		!isEqual(vertex.life, parameters.life) ) {
+		logger->logMessage(L"Test failed: Incorrect cone vertex on the axis of the cone. Position = (" +
+			std::to_wstring(vertex.position.x) + L", " + std::to_wstring(vertex.position.y) + L", " +
+			std::to_wstring(vertex.position.z) + L").");
+		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Comparison with vertices computed one at a time
+	CounterRNG rng(TESTBURSTVERTEXGENERATOR_SEED, TESTBURSTVERTEXGENERATOR_INSTANCE_ID);
+	rng.setDrawIndex(12345);
+	const bool debugColorCasts[] = { false, true };
+	for( size_t d = 0; d < 2; ++d ) {
+		getParameters(parameters, TESTBURSTVERTEXGENERATOR_N_COLUMNS, TESTBURSTVERTEXGENERATOR_N_ROWS, debugColorCasts[d]);
+		const size_t nVertices = parameters.nColumns * parameters.nRows;
+		std::vector<ParticleVertexType> vertices(nVertices);
+		std::vector<ParticleVertexType> expected(nVertices);
+		coneSerially(&expected[0], parameters, coneParameters, rng);
+		if( FAILED(generator.cone(&vertices[0], parameters, coneParameters, rng)) ) {
+			logger->logMessage(L"Test failed: BurstVertexGenerator::cone() returned a failure result.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			continue;
+		}
+
+		size_t nMismatches = 0;
+		float maxError = 0.0f;
+		float error = 0.0f;
+		for( size_t k = 0; k < nVertices; ++k ) {
+			const ParticleVertexType& a = vertices[k];
+			const ParticleVertexType& b = expected[k];
+			error = std::abs(a.position.x - b.position.x) + std::abs(a.position.y - b.position.y) + std::abs(a.position.z - b.position.z);
+			maxError = (error > maxError) ? error : maxError;
+			if( !isClose(a.position, b.position, TESTBURSTVERTEXGENERATOR_TOLERANCE) ||
+				!isClose(a.linearVelocity, b.linearVelocity, TESTBURSTVERTEXGENERATOR_TOLERANCE) ||
+				!isEqual(a.billboard, b.billboard) || !isEqual(a.life, b.life) || !isEqual(a.index, b.index) ) {
+				++nMismatches;
+			}
+		}
+		logger->logMessage(L"Maximum position difference (debug colour casts = " + std::to_wstring(debugColorCasts[d]) +
+			L"): " + std::to_wstring(maxError));
+		if( nMismatches != 0 ) {
+			logger->logMessage(L"Test failed: " + std::to_wstring(nMismatches) + L" of " + std::to_wstring(nVertices) +
+				L" cone vertices differ from those computed one at a time.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	// The generator's random number sequence is read, but not modified
+	if( rng.getDrawIndex() != 12345 ) {
+		logger->logMessage(L"Test failed: BurstVertexGenerator::cone() changed the draw index of the random number generator.");
+		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(result) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return result;
+}
+
+HRESULT testBurstVertexGenerator::testDeterminism(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testBurstVertexGenerator_testDeterminism.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT result = ERROR_SUCCESS;
+
+	const size_t threadCounts[] = { 1, 2, 3, 4, 8 };
+	const size_t nThreadCounts = sizeof(threadCounts) / sizeof(size_t);
+	const size_t chunkSizes[] = { 1, 5, 64, 1000, BURSTVERTEXGENERATOR_CHUNK_SIZE_DEFAULT, 100000 };
+	const size_t nChunkSizes = sizeof(chunkSizes) / sizeof(size_t);
+
+	BurstVertexGenerator::Parameters parameters;
+	getParameters(parameters, TESTBURSTVERTEXGENERATOR_N_COLUMNS * 2 + 1, TESTBURSTVERTEXGENERATOR_N_ROWS * 2 + 1, true);
+	BurstVertexGenerator::ConeParameters coneParameters;
+	getConeParameters(coneParameters);
+	CounterRNG rng(TESTBURSTVERTEXGENERATOR_SEED, TESTBURSTVERTEXGENERATOR_INSTANCE_ID);
+	const size_t nVertices = parameters.nColumns * parameters.nRows;
+
+	// Single-threaded results
+	std::vector<ParticleVertexType> expectedSphere(nVertices);
+	std::vector<ParticleVertexType> expectedCone(nVertices);
+	{
+		BurstVertexGenerator generator;
+		if( FAILED(generator.sphere(&expectedSphere[0], parameters)) ||
+			FAILED(generator.cone(&expectedCone[0], parameters, coneParameters, rng)) ) {
+			logger->logMessage(L"Test failed: Single-threaded vertex generation returned a failure result.");
+			delete logger;
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	std::vector<ParticleVertexType> vertices(nVertices);
+	WorkerPool* pool = 0;
+	BurstVertexGenerator* generator = 0;
+	size_t nMismatches = 0;
+	for( size_t t = 0; t < nThreadCounts; ++t ) {
+		pool = new WorkerPool(threadCounts[t]);
+		for( size_t c = 0; c < nChunkSizes; ++c ) {
+			generator = new BurstVertexGenerator(pool, chunkSizes[c]);
+			const wstring configuration = std::to_wstring(threadCounts[t]) + L" threads and chunks of " +
+				std::to_wstring(chunkSizes[c]) + L" vertices";
+
+			vertices.assign(nVertices, ParticleVertexType());
+			if( FAILED(generator->sphere(&vertices[0], parameters)) ) {
+				logger->logMessage(L"Test failed: Sphere generation with " + configuration + L" returned a failure result.");
+				result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			} else {
+				nMismatches = countMismatches(vertices, expectedSphere);
+				if( nMismatches != 0 ) {
+					logger->logMessage(L"Test failed: " + std::to_wstring(nMismatches) +
+						L" sphere vertices differ from single-threaded results with " + configuration + L".");
+					result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+				}
+			}
+
+			vertices.assign(nVertices, ParticleVertexType());
+			if( FAILED(generator->cone(&vertices[0], parameters, coneParameters, rng)) ) {
+				logger->logMessage(L"Test failed: Cone generation with " + configuration + L" returned a failure result.");
+				result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			} else {
+				nMismatches = countMismatches(vertices, expectedCone);
+				if( nMismatches != 0 ) {
+					logger->logMessage(L"Test failed: " + std::to_wstring(nMismatches) +
+						L" cone vertices differ from single-threaded results with " + configuration + L".");
+					result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+				}
+			}
+
+			delete generator;
+			generator = 0;
+		}
+		delete pool;
+		pool = 0;
+	}
+
+	if( SUCCEEDED(result) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return result;
+}
+
+HRESULT testBurstVertexGenerator::benchmarkScaling(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testBurstVertexGenerator_benchmarkScaling.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	const size_t threadCounts[] = { 1, 2, 4, 8 };
+	const size_t nThreadCounts = sizeof(threadCounts) / sizeof(size_t);
+	const wchar_t* const names[] = { L"Sphere", L"Cone" };
+	const size_t nShapes = sizeof(names) / sizeof(wchar_t*);
+	const size_t nRepetitions = TESTBURSTVERTEXGENERATOR_N_BENCHMARK_REPETITIONS;
+
+	BurstVertexGenerator::Parameters parameters;
+	getParameters(parameters, TESTBURSTVERTEXGENERATOR_N_BENCHMARK_COLUMNS, TESTBURSTVERTEXGENERATOR_N_BENCHMARK_ROWS, false);
+	BurstVertexGenerator::ConeParameters coneParameters;
+	getConeParameters(coneParameters);
+	CounterRNG rng(TESTBURSTVERTEXGENERATOR_SEED, TESTBURSTVERTEXGENERATOR_INSTANCE_ID);
+	const size_t nVertices = parameters.nColumns * parameters.nRows;
+	std::vector<ParticleVertexType> vertices(nVertices);
+
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+
+	WorkerPool* pool = 0;
+	BurstVertexGenerator* generator = 0;
+	double serialTime = 0.0;
+	double time = 0.0;
+	float checksum = 0.0f;
+
+	logger->logMessage(L"Shape, Number of vertices, Number of threads, Time per generation (ms), Speedup relative to a serial loop");
+
+	for( size_t s = 0; s < nShapes; ++s ) {
+		QueryPerformanceCounter(&start);
+		for( size_t r = 0; r < nRepetitions; ++r ) {
+			if( s == 0 ) {
+				sphereSerially(&vertices[0], parameters);
+			} else {
+				coneSerially(&vertices[0], parameters, coneParameters, rng);
+			}
+			checksum += vertices[r].position.x;
+		}
+		QueryPerformanceCounter(&end);
+		serialTime = elapsedMilliseconds(start, end, frequency) / static_cast<double>(nRepetitions);
+		logger->logMessage(wstring(names[s]) + L", " + std::to_wstring(nVertices) +
+			L", serial, " + std::to_wstring(serialTime) + L", 1");
+
+		for( size_t t = 0; t < nThreadCounts; ++t ) {
+			if( threadCounts[t] != 1 ) {
+				pool = new WorkerPool(threadCounts[t]);
+			}
+			generator = new BurstVertexGenerator(pool);
+
+			QueryPerformanceCounter(&start);
+			for( size_t r = 0; r < nRepetitions; ++r ) {
+				if( s == 0 ) {
+					generator->sphere(&vertices[0], parameters);
+				} else {
+					generator->cone(&vertices[0], parameters, coneParameters, rng);
+				}
+				checksum += vertices[r].position.x;
+			}
+			QueryPerformanceCounter(&end);
+			time = elapsedMilliseconds(start, end, frequency) / static_cast<double>(nRepetitions);
+
+			logger->logMessage(wstring(names[s]) + L", " + std::to_wstring(nVertices) + L", " +
+				std::to_wstring(threadCounts[t]) + L", " +
+				std::to_wstring(time) + L", " + std::to_wstring(serialTime / time));
+
+			delete generator;
+			generator = 0;
+			if( pool != 0 ) {
+				delete pool;
+				pool = 0;
+			}
+		}
+	}
+	logger->logMessage(L"(Checksum: " + std::to_wstring(checksum) + L")");
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
@@ -0,0 +1,362 @@
+/*
+testCounterRNG.cpp
+------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testKnot.cpp
+
+Description
+  -Implementations of test functions for the CounterRNG class
+*/
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cstring>
+#include "testCounterRNG.h"
+#include "CounterRNG.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+using std::wstring;
+
+// Number of samples of each distribution in the statistical tests and benchmark
+#define TESTCOUNTERRNG_N_SAMPLES 1000000
+
+// Number of histogram bins in the chi-squared test of uniformity
+#define TESTCOUNTERRNG_N_BINS 64
+
+/* Critical value of the chi-squared distribution with
+   TESTCOUNTERRNG_N_BINS - 1 degrees of freedom, at the 0.1% significance level
+ */
+#define TESTCOUNTERRNG_CHI_SQUARED_CRITICAL 103.4
+
+/* Maximum deviation of sample moments from their expected values,
+   in multiples of the standard error of the mean
+ */
+#define TESTCOUNTERRNG_MAX_STANDARD_ERRORS 5.0
+
+// Half-angle of the cone in the statistical tests
+#define TESTCOUNTERRNG_CONE_ANGLE 0.5f
+
+namespace testCounterRNG {
+
+	/* Returns true if the sample mean of 'n' values,
+	   with sum 'sum', is consistent with a distribution of
+	   mean 'mean' and variance 'variance', and logs the result.
+	 */
+	static bool checkMean(Logger* const logger, const wstring& name,
+		const double sum, const size_t n, const double mean, const double variance) {
+		const double sampleMean = sum / n;
+		const double standardErrors = std::fabs(sampleMean - mean) / std::sqrt(variance / n);
+		logger->logMessage(name + L": " + std::to_wstring(sampleMean) + L" (expected " +
+			std::to_wstring(mean) + L", " + std::to_wstring(standardErrors) + L" standard errors)");
+		return standardErrors <= TESTCOUNTERRNG_MAX_STANDARD_ERRORS;
+	}
+
+	static double elapsedMilliseconds(const LARGE_INTEGER& start, const LARGE_INTEGER& end, const LARGE_INTEGER& frequency) {
+		return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+}
+
+HRESULT testCounterRNG::testStatistics(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testCounterRNG_testStatistics.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	bool passed = true;
+
+	// Known-answer vectors from the Random123 library
+	// -----------------------------------------------
+	const unsigned int counters[3][4] = {
+		{ 0u, 0u, 0u, 0u },
+		{ 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu },
+		{ 0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u }
+	};
+	const unsigned int keys[3][2] = {
+		{ 0u, 0u },
+		{ 0xffffffffu, 0xffffffffu },
+		{ 0xa4093822u, 0x299f31d0u }
+	};
+	const unsigned int answers[3][4] = {
+		{ 0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u },
+		{ 0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu },
+		{ 0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u }
+	};
+	unsigned int result[4];
+	for( size_t i = 0; i < 3; ++i ) {
+		CounterRNG::philox(result, counters[i], keys[i]);
+		if( std::memcmp(result, answers[i], sizeof(result)) != 0 ) {
+			logger->logMessage(L"Test failed: Incorrect output for known-answer vector " + std::to_wstring(i) + L".");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	// Reproducibility
+	// ---------------
+	const size_t nSequence = 1000;
+	std::vector<float> sequential(nSequence);
+	std::vector<float> bulk(nSequence);
+	std::vector<float> other(nSequence);
+	CounterRNG rng(1, 2);
+	for( size_t i = 0; i < nSequence; ++i ) {
+		sequential[i] = rng.nextUniform();
+	}
+
+	// Bulk generation in uneven pieces, from an object created later
+	CounterRNG twin(1, 2);
+	size_t offset = 0;
+	for( size_t piece = 1; offset < nSequence; ++piece ) {
+		size_t count = (nSequence - offset < piece) ? (nSequence - offset) : piece;
+		twin.uniform(&bulk[offset], count);
+		offset += count;
+	}
+	if( sequential != bulk || twin.getDrawIndex() != nSequence ) {
+		logger->logMessage(L"Test failed: Bulk generation produced a different sequence.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Seeking
+	twin.setDrawIndex(nSequence / 3);
+	if( twin.nextUniform() != sequential[nSequence / 3] ) {
+		logger->logMessage(L"Test failed: Seeking produced a different value.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Different instances
+	CounterRNG otherInstance(1, 3);
+	otherInstance.uniform(&other[0], nSequence);
+	size_t nEqual = 0;
+	for( size_t i = 0; i < nSequence; ++i ) {
+		nEqual += (other[i] == sequential[i]) ? 1 : 0;
+	}
+	if( nEqual > nSequence / 100 ) {
+		logger->logMessage(L"Test failed: Different instances produced similar sequences.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Uniform distribution
+	// --------------------
+	std::vector<float> values(TESTCOUNTERRNG_N_SAMPLES);
+	CounterRNG uniformRng(COUNTERRNG_SEED_DEFAULT, 10);
+	uniformRng.uniform(&values[0], values.size());
+	double sum = 0.0;
+	double sumSquares = 0.0;
+	std::vector<size_t> bins(TESTCOUNTERRNG_N_BINS, 0);
+	size_t nOutOfRange = 0;
+	for( size_t i = 0; i < values.size(); ++i ) {
+		if( values[i] < 0.0f || values[i] >= 1.0f ) {
+			++nOutOfRange;
+			continue;
+		}
+		sum += values[i];
+		sumSquares += (values[i] - 0.5) * (values[i] - 0.5);
+		++bins[static_cast<size_t>(values[i] * TESTCOUNTERRNG_N_BINS)];
+	}
+	passed = checkMean(logger, L"Uniform mean", sum, values.size(), 0.5, 1.0 / 12.0);
+	passed = checkMean(logger, L"Uniform variance", sumSquares, values.size(), 1.0 / 12.0, 1.0 / 180.0) && passed;
+	double chiSquared = 0.0;
+	const double expected = static_cast<double>(values.size()) / TESTCOUNTERRNG_N_BINS;
+	for( size_t i = 0; i < bins.size(); ++i ) {
+		chiSquared += (bins[i] - expected) * (bins[i] - expected) / expected;
+	}
+	logger->logMessage(L"Uniform chi-squared statistic: " + std::to_wstring(chiSquared) +
+		L" (critical value " + std::to_wstring(TESTCOUNTERRNG_CHI_SQUARED_CRITICAL) + L")");
+	if( !passed || nOutOfRange != 0 || chiSquared > TESTCOUNTERRNG_CHI_SQUARED_CRITICAL ) {
+		logger->logMessage(L"Test failed: Uniform samples are not uniformly distributed in [0,1).");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Normal distribution
+	// -------------------
+	CounterRNG normalRng(COUNTERRNG_SEED_DEFAULT, 11);
+	normalRng.normal(&values[0], values.size());
+	sum = 0.0;
+	sumSquares = 0.0;
+	double withinOne = 0.0;
+	for( size_t i = 0; i < values.size(); ++i ) {
+		sum += values[i];
+		sumSquares += values[i] * values[i];
+		withinOne += (std::fabs(values[i]) < 1.0f) ? 1.0 : 0.0;
+	}
+	passed = checkMean(logger, L"Normal mean", sum, values.size(), 0.0, 1.0);
+	passed = checkMean(logger, L"Normal variance", sumSquares, values.size(), 1.0, 2.0) && passed;
+	passed = checkMean(logger, L"Normal fraction within one standard deviation",
+		withinOne, values.size(), 0.6826895, 0.6826895 * (1.0 - 0.6826895)) && passed;
+	if( !passed ) {
+		logger->logMessage(L"Test failed: Normal samples do not have a standard normal distribution.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Sphere surface and volume
+	// -------------------------
+	std::vector<XMFLOAT3> points(TESTCOUNTERRNG_N_SAMPLES);
+	CounterRNG sphereRng(COUNTERRNG_SEED_DEFAULT, 12);
+	sphereRng.sphere(&points[0], points.size());
+	double sums[3] = { 0.0, 0.0, 0.0 };
+	double sumSquaresY = 0.0;
+	nOutOfRange = 0;
+	float length = 0.0f;
+	for( size_t i = 0; i < points.size(); ++i ) {
+		XMStoreFloat(&length, XMVector3Length(XMLoadFloat3(&points[i])));
+		nOutOfRange += (std::fabs(length - 1.0f) > 1.0e-5f) ? 1 : 0;
+		sums[0] += points[i].x;
+		sums[1] += points[i].y;
+		sums[2] += points[i].z;
+		sumSquaresY += points[i].y * points[i].y;
+	}
+	passed = checkMean(logger, L"Sphere surface mean x", sums[0], points.size(), 0.0, 1.0 / 3.0);
+	passed = checkMean(logger, L"Sphere surface mean y", sums[1], points.size(), 0.0, 1.0 / 3.0) && passed;
+	passed = checkMean(logger, L"Sphere surface mean z", sums[2], points.size(), 0.0, 1.0 / 3.0) && passed;
+	passed = checkMean(logger, L"Sphere surface mean y^2", sumSquaresY, points.size(), 1.0 / 3.0, 4.0 / 45.0) && passed;
+	if( !passed || nOutOfRange != 0 ) {
+		logger->logMessage(L"Test failed: Sphere surface samples are not uniformly distributed.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// The cube of the distance from the centre is uniformly distributed
+	sphereRng.sphere(&points[0], points.size(), true);
+	sum = 0.0;
+	nOutOfRange = 0;
+	for( size_t i = 0; i < points.size(); ++i ) {
+		XMStoreFloat(&length, XMVector3Length(XMLoadFloat3(&points[i])));
+		nOutOfRange += (length > 1.0f + 1.0e-5f) ? 1 : 0;
+		sum += length * length * length;
+	}
+	if( !checkMean(logger, L"Sphere volume mean cubed radius", sum, points.size(), 0.5, 1.0 / 12.0) ||
+		nOutOfRange != 0 ) {
+		logger->logMessage(L"Test failed: Sphere volume samples are not uniformly distributed.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Cone
+	// ----
+	CounterRNG coneRng(COUNTERRNG_SEED_DEFAULT, 13);
+	coneRng.cone(&points[0], points.size(), TESTCOUNTERRNG_CONE_ANGLE);
+	const double minCos = std::cos(TESTCOUNTERRNG_CONE_ANGLE);
+	sum = 0.0;
+	sums[0] = 0.0;
+	nOutOfRange = 0;
+	for( size_t i = 0; i < points.size(); ++i ) {
+		nOutOfRange += (points[i].z < minCos - 1.0e-5) ? 1 : 0;
+		sum += points[i].z;
+		sums[0] += points[i].x;
+	}
+	passed = checkMean(logger, L"Cone mean cosine of angle from axis", sum, points.size(),
+		(1.0 + minCos) / 2.0, (1.0 - minCos) * (1.0 - minCos) / 12.0);
+	passed = checkMean(logger, L"Cone mean x", sums[0], points.size(), 0.0, 1.0 - minCos) && passed;
+	if( !passed || nOutOfRange != 0 ) {
+		logger->logMessage(L"Test failed: Cone samples are not uniformly distributed within the cone.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testCounterRNG::benchmarkThroughput(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testCounterRNG_benchmarkThroughput.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+
+	std::vector<float> values(TESTCOUNTERRNG_N_SAMPLES);
+	std::vector<XMFLOAT3> points(TESTCOUNTERRNG_N_SAMPLES);
+	double checksum = 0.0;
+	const size_t nMethods = 6;
+	double times[nMethods];
+	const wchar_t* labels[nMethods] = {
+		L"std::default_random_engine, uniform",
+		L"CounterRNG::nextUniform()",
+		L"CounterRNG::uniform()",
+		L"std::default_random_engine, normal",
+		L"CounterRNG::normal()",
+		L"CounterRNG::sphere()"
+	};
+
+	std::default_random_engine generator;
+	std::uniform_real_distribution<float> uniformDistribution(0.0f, 1.0f);
+	std::normal_distribution<float> normalDistribution(0.0f, 1.0f);
+	CounterRNG rng;
+
+	QueryPerformanceCounter(&start);
+	for( size_t i = 0; i < values.size(); ++i ) {
+		values[i] = uniformDistribution(generator);
+	}
+	QueryPerformanceCounter(&end);
+	times[0] = elapsedMilliseconds(start, end, frequency);
+	checksum += values.back();
+
+	QueryPerformanceCounter(&start);
+	for( size_t i = 0; i < values.size(); ++i ) {
+		values[i] = rng.nextUniform();
+	}
+	QueryPerformanceCounter(&end);
+	times[1] = elapsedMilliseconds(start, end, frequency);
+	checksum += values.back();
+
+	QueryPerformanceCounter(&start);
+	rng.uniform(&values[0], values.size());
+	QueryPerformanceCounter(&end);
+	times[2] = elapsedMilliseconds(start, end, frequency);
+	checksum += values.back();
+
+	QueryPerformanceCounter(&start);
+	for( size_t i = 0; i < values.size(); ++i ) {
+		values[i] = normalDistribution(generator);
+	}
+	QueryPerformanceCounter(&end);
+	times[3] = elapsedMilliseconds(start, end, frequency);
+	checksum += values.back();
+
+	QueryPerformanceCounter(&start);
+	rng.normal(&values[0], values.size());
+	QueryPerformanceCounter(&end);
+	times[4] = elapsedMilliseconds(start, end, frequency);
+	checksum += values.back();
+
+	QueryPerformanceCounter(&start);
+	rng.sphere(&points[0], points.size());
+	QueryPerformanceCounter(&end);
+	times[5] = elapsedMilliseconds(start, end, frequency);
+	checksum += points.back().x;
+
+	logger->logMessage(L"Method, Time for " + std::to_wstring(TESTCOUNTERRNG_N_SAMPLES) +
+		L" samples (ms), Millions of samples per second");
+	for( size_t i = 0; i < nMethods; ++i ) {
+		logger->logMessage(wstring(labels[i]) + L", " + std::to_wstring(times[i]) + L", " +
+			std::to_wstring(TESTCOUNTERRNG_N_SAMPLES / times[i] / 1000.0));
+	}
+	logger->logMessage(L"(Checksum: " + std::to_wstring(checksum) + L")");
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
@@ -0,0 +1,331 @@
+/*
+testEngineTime.cpp
+------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFixedTimestep.cpp
+
+Description
+  -Implementations of test functions for the engine time types
+     and for the IClock classes
+*/
+
+#include <string>
+#include <vector>
+#include "testEngineTime.h"
+#include "EngineTime.h"
+#include "MonotonicClock.h"
+#include "ManualClock.h"
+#include "ScaledClock.h"
+#include "FixedTimestep.h"
+#include "Transformable.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+using std::wstring;
+
+// Number of iterations of each conversion benchmark
+#define TESTENGINETIME_N_CONVERSIONS 10000000
+
+// Number of objects and frames in the Transformable update benchmark
+#define TESTENGINETIME_N_OBJECTS 10000
+#define TESTENGINETIME_N_FRAMES 100
+
+// Number of clock reads used to estimate the resolution of MonotonicClock
+#define TESTENGINETIME_N_CLOCK_READS 100000
+
+namespace testEngineTime {
+
+	static double elapsedMilliseconds(const LARGE_INTEGER& start, const LARGE_INTEGER& end, const LARGE_INTEGER& frequency) {
+		return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+}
+
+HRESULT testEngineTime::testClocks(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testEngineTime_testClocks.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+
+	// Conversions
+	// -----------
+	const DWORD milliseconds[] = { 0, 1, 16, 1000, 0x7fffffffUL, 0xffffffffUL };
+	for( size_t i = 0; i < sizeof(milliseconds) / sizeof(milliseconds[0]); ++i ) {
+		if( engineTime::toMilliseconds(engineTime::fromMilliseconds(milliseconds[i])) != milliseconds[i] ||
+			engineTime::toMilliseconds(engineTime::timeFromMilliseconds(milliseconds[i])) != milliseconds[i] ) {
+			logger->logMessage(L"Test failed: Conversion of " + std::to_wstring(milliseconds[i]) +
+				L" milliseconds to and from EngineDuration is not exact.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+	if( engineTime::toMilliseconds(EngineDuration(ENGINETIME_NANOSECS_PER_MILLISEC - 1)) != 0 ||
+		engineTime::toMilliseconds(EngineDuration(-ENGINETIME_NANOSECS_PER_MILLISEC)) != 0 ||
+		engineTime::toMilliseconds(engineTime::fromMilliseconds(0xffffffffUL) + engineTime::fromMilliseconds(2)) != 1 ) {
+		logger->logMessage(L"Test failed: Conversions to milliseconds do not truncate, clamp and wrap as documented.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	if( engineTime::fromSeconds(1.5e-9).count() != 2 || engineTime::fromSeconds(-2.5).count() != -2500000000LL ||
+		engineTime::toSecondsFloat(engineTime::fromSeconds(0.25)) != 0.25f ||
+		engineTime::toMillisecondsFloat(EngineDuration(1500000)) != 1.5f ) {
+		logger->logMessage(L"Test failed: Incorrect conversions to or from seconds.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Times more than 49.7 days after the epoch do not wrap
+	const EngineTime later = EngineTime(engineTime::fromSeconds(100.0 * 24.0 * 60.0 * 60.0));
+	if( later - EngineTime() != engineTime::fromSeconds(8640000.0) || later <= engineTime::timeFromMilliseconds(0xffffffffUL) ) {
+		logger->logMessage(L"Test failed: EngineTime values wrap around.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// ManualClock
+	// -----------
+	ManualClock manualClock;
+	if( manualClock.now() != EngineTime() ||
+		FAILED(manualClock.advance(EngineDuration(123))) ||
+		manualClock.now().time_since_epoch().count() != 123 ||
+		SUCCEEDED(manualClock.advance(EngineDuration(-1))) ||
+		SUCCEEDED(manualClock.set(EngineTime(EngineDuration(122)))) ||
+		FAILED(manualClock.set(EngineTime(EngineDuration(1000)))) ||
+		manualClock.now().time_since_epoch().count() != 1000 ) {
+		logger->logMessage(L"Test failed: ManualClock did not behave as expected.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// ScaledClock
+	// -----------
+	ScaledClock scaledClock(&manualClock, 0.5);
+	bool passed = (scaledClock.now() == EngineTime());
+	manualClock.advance(engineTime::fromMilliseconds(100));
+	passed = passed && (engineTime::toMilliseconds(scaledClock.now()) == 50);
+
+	// Changing the scale does not change the current time
+	passed = passed && SUCCEEDED(scaledClock.setScale(2.0));
+	passed = passed && (engineTime::toMilliseconds(scaledClock.now()) == 50);
+	manualClock.advance(engineTime::fromMilliseconds(100));
+	passed = passed && (engineTime::toMilliseconds(scaledClock.now()) == 250);
+
+	// Pausing
+	passed = passed && SUCCEEDED(scaledClock.setScale(0.0));
+	manualClock.advance(engineTime::fromMilliseconds(100));
+	passed = passed && (engineTime::toMilliseconds(scaledClock.now()) == 250);
+	passed = passed && FAILED(scaledClock.setScale(-1.0)) && (scaledClock.getScale() == 0.0);
+	if( !passed ) {
+		logger->logMessage(L"Test failed: ScaledClock did not behave as expected.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// MonotonicClock
+	// --------------
+	MonotonicClock monotonicClock;
+	EngineTime previous = monotonicClock.now();
+	EngineTime current;
+	EngineDuration resolution = EngineDuration::max();
+	bool decreased = false;
+	for( size_t i = 0; i < TESTENGINETIME_N_CLOCK_READS; ++i ) {
+		current = monotonicClock.now();
+		if( current < previous ) {
+			decreased = true;
+		} else if( current > previous && (current - previous) < resolution ) {
+			resolution = current - previous;
+		}
+		previous = current;
+	}
+	logger->logMessage(L"Smallest observed MonotonicClock increment: " +
+		std::to_wstring(resolution.count()) + L" ns");
+	if( decreased || resolution >= engineTime::fromMilliseconds(1) ) {
+		logger->logMessage(L"Test failed: MonotonicClock is not monotonic, or does not have sub-millisecond resolution.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// FixedTimestep driven by a 60 Hz synthetic clock
+	// -----------------------------------------------
+	const DWORD stepInterval = 10;
+	const size_t nFrames = 6000; // 100 seconds
+	const EngineDuration frameInterval = engineTime::fromSeconds(1.0 / 60.0);
+	ManualClock frameClock;
+	FixedTimestep timestep(stepInterval, FIXEDTIMESTEP_MAX_STEPS_DEFAULT);
+	FixedTimestep truncatedTimestep(stepInterval, FIXEDTIMESTEP_MAX_STEPS_DEFAULT);
+	EngineTime lastFrameTime = frameClock.now();
+	DWORD stepTime = 0;
+	for( size_t i = 0; i < nFrames; ++i ) {
+		frameClock.advance(frameInterval);
+		const EngineDuration elapsed = frameClock.now() - lastFrameTime;
+		lastFrameTime = frameClock.now();
+		timestep.advance(elapsed);
+		truncatedTimestep.advance(engineTime::toMilliseconds(elapsed));
+		while( timestep.nextStep(stepTime) ) {}
+		while( truncatedTimestep.nextStep(stepTime) ) {}
+	}
+	const DWORD expectedSimulationTime = engineTime::toMilliseconds(frameClock.now()) / stepInterval * stepInterval;
+	logger->logMessage(L"Simulation time after " + std::to_wstring(engineTime::toMilliseconds(frameClock.now())) +
+		L" ms of 60 Hz frames: " + std::to_wstring(timestep.getSimulationTime()) + L" ms with nanosecond frame durations, " +
+		std::to_wstring(truncatedTimestep.getSimulationTime()) + L" ms with millisecond frame durations.");
+	if( timestep.getSimulationTime() + stepInterval < expectedSimulationTime ||
+		timestep.getSimulationTime() > expectedSimulationTime + stepInterval ) {
+		logger->logMessage(L"Test failed: FixedTimestep drifted from real time.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testEngineTime::benchmarkConversion(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testEngineTime_benchmarkConversion.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+	const size_t nMethods = 7;
+	double times[nMethods];
+	const wchar_t* labels[nMethods] = {
+		L"DWORD addition (baseline)",
+		L"EngineDuration addition",
+		L"engineTime::toMilliseconds(EngineDuration)",
+		L"engineTime::fromMilliseconds(DWORD)",
+		L"engineTime::toSecondsFloat(EngineDuration)",
+		L"GetTickCount()",
+		L"MonotonicClock::now()"
+	};
+
+	// Data-dependent inputs prevent the loops from being optimized away
+	DWORD dwordSum = 0;
+	EngineDuration durationSum = EngineDuration::zero();
+	float floatSum = 0.0f;
+	MonotonicClock clock;
+
+	QueryPerformanceCounter(&start);
+	for( DWORD i = 0; i < TESTENGINETIME_N_CONVERSIONS; ++i ) {
+		dwordSum += i ^ dwordSum;
+	}
+	QueryPerformanceCounter(&end);
+	times[0] = elapsedMilliseconds(start, end, frequency);
+
+	QueryPerformanceCounter(&start);
+	for( long long i = 0; i < TESTENGINETIME_N_CONVERSIONS; ++i ) {
+		durationSum += EngineDuration(i ^ durationSum.count());
+	}
+	QueryPerformanceCounter(&end);
+	times[1] = elapsedMilliseconds(start, end, frequency);
+
+	QueryPerformanceCounter(&start);
+	for( long long i = 0; i < TESTENGINETIME_N_CONVERSIONS; ++i ) {
+		dwordSum += engineTime::toMilliseconds(EngineDuration(i * 1234567LL + dwordSum));
+	}
+	QueryPerformanceCounter(&end);
+	times[2] = elapsedMilliseconds(start, end, frequency);
+
+	QueryPerformanceCounter(&start);
+	for( DWORD i = 0; i < TESTENGINETIME_N_CONVERSIONS; ++i ) {
+		durationSum += engineTime::fromMilliseconds(i ^ static_cast<DWORD>(durationSum.count()));
+	}
+	QueryPerformanceCounter(&end);
+	times[3] = elapsedMilliseconds(start, end, frequency);
+
+	QueryPerformanceCounter(&start);
+	for( long long i = 0; i < TESTENGINETIME_N_CONVERSIONS; ++i ) {
+		floatSum += engineTime::toSecondsFloat(EngineDuration(i * 1234567LL));
+	}
+	QueryPerformanceCounter(&end);
+	times[4] = elapsedMilliseconds(start, end, frequency);
+
+	QueryPerformanceCounter(&start);
+	for( size_t i = 0; i < TESTENGINETIME_N_CONVERSIONS; ++i ) {
+		dwordSum += GetTickCount();
+	}
+	QueryPerformanceCounter(&end);
+	times[5] = elapsedMilliseconds(start, end, frequency);
+
+	QueryPerformanceCounter(&start);
+	for( size_t i = 0; i < TESTENGINETIME_N_CONVERSIONS; ++i ) {
+		durationSum += clock.now().time_since_epoch();
+	}
+	QueryPerformanceCounter(&end);
+	times[6] = elapsedMilliseconds(start, end, frequency);
+
+	logger->logMessage(L"Operation, Time for " + std::to_wstring(TESTENGINETIME_N_CONVERSIONS) +
+		L" operations (ms), Time per operation (ns)");
+	for( size_t i = 0; i < nMethods; ++i ) {
+		logger->logMessage(wstring(labels[i]) + L", " + std::to_wstring(times[i]) + L", " +
+			std::to_wstring(times[i] * 1.0e6 / TESTENGINETIME_N_CONVERSIONS));
+	}
+
+	// Transformable updates, with times converted per object or not at all
+	std::vector<Transformable*> transforms;
+	XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+	XMFLOAT3 position(0.0f, 0.0f, 0.0f);
+	XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+	for( size_t i = 0; i < TESTENGINETIME_N_OBJECTS; ++i ) {
+		transforms.push_back(new Transformable(scale, position, orientation));
+		transforms.back()->setLinearVelocity(XMFLOAT3(1.0f, 0.0f, 0.0f), 1.0f);
+	}
+	const DWORD interval = 10;
+	const EngineDuration duration = engineTime::fromMilliseconds(interval);
+
+	// Warm up
+	for( size_t i = 0; i < transforms.size(); ++i ) {
+		transforms[i]->update(0, interval);
+	}
+
+	QueryPerformanceCounter(&start);
+	for( DWORD frame = 0; frame < TESTENGINETIME_N_FRAMES; ++frame ) {
+		for( size_t i = 0; i < transforms.size(); ++i ) {
+			transforms[i]->update(frame * interval, interval);
+		}
+	}
+	QueryPerformanceCounter(&end);
+	const double dwordTime = elapsedMilliseconds(start, end, frequency);
+
+	EngineTime time;
+	QueryPerformanceCounter(&start);
+	for( DWORD frame = 0; frame < TESTENGINETIME_N_FRAMES; ++frame ) {
+		for( size_t i = 0; i < transforms.size(); ++i ) {
+			transforms[i]->update(engineTime::toMilliseconds(time), engineTime::toMilliseconds(duration));
+		}
+		time += duration;
+	}
+	QueryPerformanceCounter(&end);
+	const double convertedTime = elapsedMilliseconds(start, end, frequency);
+
+	logger->logMessage(L"Transformable::update() for " + std::to_wstring(TESTENGINETIME_N_OBJECTS) + L" objects, " +
+		std::to_wstring(TESTENGINETIME_N_FRAMES) + L" frames: " + std::to_wstring(dwordTime) + L" ms with DWORD times, " +
+		std::to_wstring(convertedTime) + L" ms with times converted from EngineTime per object (overhead " +
+		std::to_wstring((convertedTime / dwordTime - 1.0) * 100.0) + L"%)");
+
+	for( size_t i = 0; i < transforms.size(); ++i ) {
+		delete transforms[i];
+	}
+
+	logger->logMessage(L"(Checksums: " + std::to_wstring(dwordSum) + L", " +
+		std::to_wstring(durationSum.count()) + L", " + std::to_wstring(floatSum) + L")");
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
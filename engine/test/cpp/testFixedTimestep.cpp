@@ -0,0 +1,466 @@
+/*
+testFixedTimestep.cpp
+---------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testTransformable.cpp
+
+Description
+  -Implementations of test functions for the FixedTimestep class,
+     and for render interpolation of Transformable objects
+*/
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cmath>
+#include "testFixedTimestep.h"
+#include "FixedTimestep.h"
+#include "Transformable.h"
+#include "RockingTransformable.h"
+#include "WanderingLineTransformable.h"
+#include "TransformSystem.h"
+#include "CounterRNG.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+using std::wstring;
+
+// Number of simulation steps in the determinism test
+#define TESTFIXEDTIMESTEP_N_STEPS 2000
+
+// Simulation step interval, in milliseconds
+#define TESTFIXEDTIMESTEP_STEP_INTERVAL 10
+
+// Maximum number of simulation steps per frame
+#define TESTFIXEDTIMESTEP_MAX_STEPS 8
+
+// Number of synthetic clocks in the determinism test
+#define TESTFIXEDTIMESTEP_N_CLOCKS 6
+
+// Tolerance for comparisons of interpolated transforms
+#define TESTFIXEDTIMESTEP_TOLERANCE 1.0e-5f
+
+namespace testFixedTimestep {
+
+	struct Scene {
+		// Objects not bound to the TransformSystem, in parent-before-child order
+		std::vector<Transformable*> free;
+
+		std::vector<Transformable*> bound;
+		TransformSystem* system;
+	};
+
+	/* Creates a scene containing:
+	     -A chain with a moving and rotating root
+	     -An animated RockingTransformable with a child
+	     -WanderingLineTransformable objects between the chain's root and tip
+	     -Moving and rotating objects bound to a TransformSystem,
+	        some of which have parents
+	 */
+	static void createScene(Scene& scene) {
+		XMFLOAT3 scale(1.0f, 2.0f, 0.5f);
+		XMFLOAT3 position(0.5f, -1.0f, 2.0f);
+		XMFLOAT4 orientation(0.1f, 0.2f, 0.3f, 0.9f);
+		const XMFLOAT3 axis(0.0f, 1.0f, 0.0f);
+		XMFLOAT4 angularMomentum;
+		XMStoreFloat4(&angularMomentum, XMQuaternionRotationAxis(XMLoadFloat3(&axis), 0.01f));
+
+		Transformable* transform = 0;
+		Transformable* parent = 0;
+		for( size_t i = 0; i < 8; ++i ) {
+			transform = new Transformable(scale, position, orientation);
+			if( i == 0 ) {
+				transform->setLinearVelocity(XMFLOAT3(1.0f, 0.0f, 0.0f), 2.0f);
+				transform->setAngularMomentum(angularMomentum);
+			}
+			transform->setParent(parent);
+			scene.free.push_back(transform);
+			parent = transform;
+		}
+
+		parent = new RockingTransformable(scale, position, orientation, 1000.0f, XM_PIDIV2, axis);
+		scene.free.push_back(parent);
+		transform = new Transformable(scale, position, orientation);
+		transform->setParent(parent);
+		scene.free.push_back(transform);
+
+		WanderingLineTransformable::Parameters parameters;
+		parameters.maxRadius = 2.0f;
+		parameters.linearSpeed = 0.001f;
+		parameters.maxRollPitchYaw = XMFLOAT3(0.5f, 0.5f, 0.5f);
+		parameters.rollPitchYawSpeeds = XMFLOAT3(0.001f, 0.001f, 0.001f);
+		for( unsigned int i = 1; i < 8; ++i ) {
+			parameters.t = static_cast<float>(i) / 8.0f;
+			scene.free.push_back(new WanderingLineTransformable(scene.free[0], scene.free[7], parameters, i));
+		}
+
+		scene.system = new TransformSystem();
+		parent = 0;
+		for( size_t i = 0; i < 8; ++i ) {
+			transform = new Transformable(scale, position, orientation);
+			if( i % 4 != 0 ) {
+				transform->setParent(parent);
+			}
+			transform->bindToSystem(scene.system);
+			transform->setLinearVelocity(XMFLOAT3(0.0f, 0.0f, 1.0f), static_cast<float>(i));
+			transform->setAngularMomentum(angularMomentum);
+			scene.bound.push_back(transform);
+			parent = transform;
+		}
+	}
+
+	static void deleteScene(Scene& scene) {
+		for( std::vector<Transformable*>::size_type i = scene.free.size(); i > 0; --i ) {
+			delete scene.free[i - 1];
+		}
+		scene.free.clear();
+		for( std::vector<Transformable*>::size_type i = scene.bound.size(); i > 0; --i ) {
+			delete scene.bound[i - 1];
+		}
+		scene.bound.clear();
+		delete scene.system;
+		scene.system = 0;
+	}
+
+	static void updateScene(Scene& scene, const DWORD currentTime, const DWORD updateTimeInterval) {
+		for( std::vector<Transformable*>::size_type i = 0; i < scene.free.size(); ++i ) {
+			scene.free[i]->update(currentTime, updateTimeInterval);
+		}
+		scene.system->update(updateTimeInterval);
+	}
+
+	static void getWorldTransforms(std::vector<XMFLOAT4X4>& transforms, const Scene& scene) {
+		transforms.resize(scene.free.size() + scene.bound.size());
+		for( std::vector<Transformable*>::size_type i = 0; i < scene.free.size(); ++i ) {
+			scene.free[i]->getWorldTransform(transforms[i]);
+		}
+		for( std::vector<Transformable*>::size_type i = 0; i < scene.bound.size(); ++i ) {
+			scene.bound[i]->getWorldTransform(transforms[scene.free.size() + i]);
+		}
+	}
+
+	/* Synthetic clocks, returning the duration of frame 'frame' [milliseconds]
+	     0: 60 Hz
+	     1: 30 Hz
+	     2: 144 Hz
+	     3: 60 Hz, with the granularity of GetTickCount()
+	     4: Irregular frame durations, from 0 to 60 milliseconds
+	     5: 60 Hz, with a 500 millisecond frame every 100 frames
+	 */
+	static DWORD frameInterval(const size_t clock, const size_t frame, CounterRNG& rng) {
+		switch( clock ) {
+		case 0:
+			return 16;
+		case 1:
+			return 33;
+		case 2:
+			return 7;
+		case 3:
+			return (frame % 3 == 0) ? 15 : 16;
+		case 4:
+			return static_cast<DWORD>(rng.nextUniform() * 61.0f);
+		default:
+			return (frame % 100 == 99) ? 500 : 16;
+		}
+	}
+
+	static float maxDifference(const XMFLOAT4X4& a, const XMFLOAT4X4& b) {
+		float maxDiff = 0.0f;
+		for( size_t i = 0; i < 4; ++i ) {
+			for( size_t j = 0; j < 4; ++j ) {
+				float diff = a.m[i][j] - b.m[i][j];
+				diff = (diff < 0.0f) ? -diff : diff;
+				maxDiff = (diff > maxDiff) ? diff : maxDiff;
+			}
+		}
+		return maxDiff;
+	}
+
+	static bool checkInterpolation(Logger* const logger, const wstring& name, const Transformable& transform,
+		const XMFLOAT3& previousPosition, const XMFLOAT3& currentPosition) {
+		bool passed = true;
+		XMFLOAT4X4 previous, current, interpolated;
+		transform.getInterpolatedWorldTransform(previous, 0.0f);
+		transform.getInterpolatedWorldTransform(current, 1.0f);
+
+		// The endpoints are exact, and the translation is interpolated linearly
+		XMFLOAT4X4 worldTransform;
+		transform.getWorldTransform(worldTransform);
+		if( std::memcmp(&current, &worldTransform, sizeof(XMFLOAT4X4)) != 0 ) {
+			logger->logMessage(name + L": Interpolation factor of one does not produce the current world transform.");
+			passed = false;
+		}
+		if( std::fabs(previous._41 - previousPosition.x) > TESTFIXEDTIMESTEP_TOLERANCE ||
+			std::fabs(previous._42 - previousPosition.y) > TESTFIXEDTIMESTEP_TOLERANCE ||
+			std::fabs(previous._43 - previousPosition.z) > TESTFIXEDTIMESTEP_TOLERANCE ) {
+			logger->logMessage(name + L": Interpolation factor of zero does not produce the previous world transform.");
+			passed = false;
+		}
+		if( std::fabs(current._41 - currentPosition.x) > TESTFIXEDTIMESTEP_TOLERANCE ||
+			std::fabs(current._42 - currentPosition.y) > TESTFIXEDTIMESTEP_TOLERANCE ||
+			std::fabs(current._43 - currentPosition.z) > TESTFIXEDTIMESTEP_TOLERANCE ) {
+			logger->logMessage(name + L": Unexpected current world transform.");
+			passed = false;
+		}
+
+		const float alpha = 0.25f;
+		transform.getInterpolatedWorldTransform(interpolated, alpha);
+		XMFLOAT3 expected;
+		XMStoreFloat3(&expected, XMVectorLerp(XMLoadFloat3(&previousPosition), XMLoadFloat3(&currentPosition), alpha));
+		if( std::fabs(interpolated._41 - expected.x) > TESTFIXEDTIMESTEP_TOLERANCE ||
+			std::fabs(interpolated._42 - expected.y) > TESTFIXEDTIMESTEP_TOLERANCE ||
+			std::fabs(interpolated._43 - expected.z) > TESTFIXEDTIMESTEP_TOLERANCE ) {
+			logger->logMessage(name + L": Interpolated translation is incorrect.");
+			passed = false;
+		}
+
+		// The rotation part is a rotation between the two endpoint rotations
+		XMVECTOR scale, rotation, translation, previousRotation, currentRotation;
+		XMMatrixDecompose(&scale, &rotation, &translation, XMLoadFloat4x4(&interpolated));
+		XMMatrixDecompose(&scale, &previousRotation, &translation, XMLoadFloat4x4(&previous));
+		XMMatrixDecompose(&scale, &currentRotation, &translation, XMLoadFloat4x4(&current));
+		float angleToPrevious, angleToCurrent, totalAngle;
+		XMStoreFloat(&angleToPrevious, XMVectorACos(XMVectorAbs(XMQuaternionDot(rotation, previousRotation))));
+		XMStoreFloat(&angleToCurrent, XMVectorACos(XMVectorAbs(XMQuaternionDot(rotation, currentRotation))));
+		XMStoreFloat(&totalAngle, XMVectorACos(XMVectorAbs(XMQuaternionDot(previousRotation, currentRotation))));
+		if( std::fabs(angleToPrevious - alpha * totalAngle) > 1.0e-3f ||
+			std::fabs(angleToCurrent - (1.0f - alpha) * totalAngle) > 1.0e-3f ) {
+			logger->logMessage(name + L": Interpolated rotation is incorrect.");
+			passed = false;
+		}
+
+		// getWorldTransform() uses the render interpolation factor
+		Transformable::setRenderInterpolation(alpha);
+		transform.getWorldTransform(worldTransform);
+		Transformable::setRenderInterpolation(1.0f);
+		if( std::memcmp(&interpolated, &worldTransform, sizeof(XMFLOAT4X4)) != 0 ) {
+			logger->logMessage(name + L": getWorldTransform() does not use the render interpolation factor.");
+			passed = false;
+		}
+		return passed;
+	}
+}
+
+HRESULT testFixedTimestep::testDeterminism(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testFixedTimestep_testDeterminism.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	std::vector<XMFLOAT4X4> reference;
+	std::vector<XMFLOAT4X4> transforms;
+
+	logger->logMessage(L"Clock, Frames, Steps, Dropped time (ms), Final simulation time (ms), Objects differing from the first clock");
+
+	for( size_t clock = 0; clock < TESTFIXEDTIMESTEP_N_CLOCKS; ++clock ) {
+		Scene scene;
+		createScene(scene);
+		FixedTimestep timestep(TESTFIXEDTIMESTEP_STEP_INTERVAL, TESTFIXEDTIMESTEP_MAX_STEPS);
+		CounterRNG rng(COUNTERRNG_SEED_DEFAULT, static_cast<unsigned int>(clock));
+
+		size_t frame = 0;
+		DWORD currentTime = 0;
+		while( timestep.getStepCount() < TESTFIXEDTIMESTEP_N_STEPS ) {
+			timestep.advance((frame == 0) ? 0 : frameInterval(clock, frame, rng));
+			while( timestep.getStepCount() < TESTFIXEDTIMESTEP_N_STEPS && timestep.nextStep(currentTime) ) {
+				if( currentTime != (timestep.getStepCount() - 1) * TESTFIXEDTIMESTEP_STEP_INTERVAL ) {
+					logger->logMessage(L"Test failed: Step times are not consecutive multiples of the step interval.");
+					finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+				}
+				updateScene(scene, currentTime, timestep.getStepInterval());
+			}
+			if( timestep.getFrameStepCount() > TESTFIXEDTIMESTEP_MAX_STEPS ) {
+				logger->logMessage(L"Test failed: The limit on the number of steps per frame was exceeded.");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+			++frame;
+		}
+
+		getWorldTransforms(transforms, scene);
+		size_t nDiffering = 0;
+		if( clock == 0 ) {
+			reference = transforms;
+		} else {
+			for( size_t i = 0; i < transforms.size(); ++i ) {
+				if( std::memcmp(&transforms[i], &reference[i], sizeof(XMFLOAT4X4)) != 0 ) {
+					++nDiffering;
+				}
+			}
+		}
+		logger->logMessage(std::to_wstring(clock) + L", " + std::to_wstring(frame) + L", " +
+			std::to_wstring(timestep.getStepCount()) + L", " + std::to_wstring(timestep.getDroppedTime()) + L", " +
+			std::to_wstring(timestep.getSimulationTime()) + L", " + std::to_wstring(nDiffering));
+		if( nDiffering > 0 ) {
+			logger->logMessage(L"Test failed: World transforms depend on the frame rate.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		if( clock == TESTFIXEDTIMESTEP_N_CLOCKS - 1 && timestep.getDroppedTime() == 0 ) {
+			logger->logMessage(L"Test failed: Long frames did not cause time to be dropped.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		deleteScene(scene);
+	}
+
+	// For comparison, update the scene directly with the frame durations of each clock
+	logger->logMessage(L"Variable time steps: Clock, Maximum matrix element difference from the first clock");
+	const DWORD totalTime = TESTFIXEDTIMESTEP_N_STEPS * TESTFIXEDTIMESTEP_STEP_INTERVAL;
+	for( size_t clock = 0; clock < TESTFIXEDTIMESTEP_N_CLOCKS - 1; ++clock ) {
+		Scene scene;
+		createScene(scene);
+		CounterRNG rng(COUNTERRNG_SEED_DEFAULT, static_cast<unsigned int>(clock));
+		DWORD currentTime = 0;
+		for( size_t frame = 0; currentTime < totalTime; ++frame ) {
+			DWORD interval = frameInterval(clock, frame, rng);
+			if( currentTime + interval > totalTime ) {
+				interval = totalTime - currentTime;
+			}
+			updateScene(scene, currentTime, interval);
+			currentTime += interval;
+		}
+		getWorldTransforms(transforms, scene);
+		if( clock == 0 ) {
+			reference = transforms;
+		}
+		float maxDiff = 0.0f;
+		for( size_t i = 0; i < transforms.size(); ++i ) {
+			float diff = maxDifference(transforms[i], reference[i]);
+			maxDiff = (diff > maxDiff) ? diff : maxDiff;
+		}
+		logger->logMessage(std::to_wstring(clock) + L", " + std::to_wstring(maxDiff));
+		deleteScene(scene);
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testFixedTimestep::testInterpolation(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testFixedTimestep_testInterpolation.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+
+	// Step counting
+	// -------------
+	FixedTimestep timestep(TESTFIXEDTIMESTEP_STEP_INTERVAL, TESTFIXEDTIMESTEP_MAX_STEPS);
+	DWORD currentTime = 0;
+	const DWORD frameIntervals[] = { 0, 25, 5, 1000, 3 };
+	const unsigned int expectedSteps[] = { 1, 2, 1, TESTFIXEDTIMESTEP_MAX_STEPS, 0 };
+	const float expectedFactors[] = { 0.0f, 0.5f, 0.0f, 0.0f, 0.3f };
+	const DWORD expectedDropped[] = { 0, 0, 0, 1000 - TESTFIXEDTIMESTEP_MAX_STEPS * TESTFIXEDTIMESTEP_STEP_INTERVAL, 0 };
+	DWORD droppedTime = 0;
+	for( size_t i = 0; i < sizeof(frameIntervals) / sizeof(frameIntervals[0]); ++i ) {
+		timestep.advance(frameIntervals[i]);
+		unsigned int nSteps = 0;
+		while( timestep.nextStep(currentTime) ) {
+			++nSteps;
+		}
+		droppedTime += expectedDropped[i];
+		if( nSteps != expectedSteps[i] || nSteps != timestep.getFrameStepCount() ||
+			std::fabs(timestep.getInterpolationFactor() - expectedFactors[i]) > TESTFIXEDTIMESTEP_TOLERANCE ||
+			timestep.getDroppedTime() != droppedTime ) {
+			logger->logMessage(L"Test failed: Frame " + std::to_wstring(i) + L" produced " + std::to_wstring(nSteps) +
+				L" steps, an interpolation factor of " + std::to_wstring(timestep.getInterpolationFactor()) +
+				L", and " + std::to_wstring(timestep.getDroppedTime()) + L" ms of total dropped time.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+	timestep.reset();
+	timestep.advance(0);
+	if( !timestep.nextStep(currentTime) || currentTime != 0 || timestep.getDroppedTime() != 0 ) {
+		logger->logMessage(L"Test failed: reset() did not restore the initial state.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Transform interpolation
+	// -----------------------
+	XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+	XMFLOAT3 position(0.0f, 0.0f, 0.0f);
+	XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+	const XMFLOAT3 direction(1.0f, 0.0f, 0.0f);
+	const float speed = 100.0f;
+	const DWORD interval = TESTFIXEDTIMESTEP_STEP_INTERVAL;
+	const XMFLOAT3 step(speed * interval / MILLISECS_PER_SEC_FLOAT, 0.0f, 0.0f);
+	XMFLOAT4 angularMomentum;
+	XMStoreFloat4(&angularMomentum, XMQuaternionRotationRollPitchYaw(0.1f, 0.2f, 0.3f));
+
+	Transformable freeTransform(scale, position, orientation);
+	freeTransform.setLinearVelocity(direction, speed);
+	freeTransform.setAngularMomentum(angularMomentum);
+
+	TransformSystem* system = new TransformSystem();
+	Transformable* boundTransform = new Transformable(scale, position, orientation);
+	boundTransform->bindToSystem(system);
+	boundTransform->setLinearVelocity(direction, speed);
+	boundTransform->setAngularMomentum(angularMomentum);
+
+	bool passed = true;
+	Transformable* const transforms[] = { &freeTransform, boundTransform };
+	const wstring names[] = { L"Free object", L"Bound object" };
+	XMFLOAT3 previousPosition = position;
+	XMFLOAT3 currentPosition = position;
+	for( DWORD i = 0; i < 5; ++i ) {
+		freeTransform.update(i * interval, interval);
+		system->update(interval);
+
+		/* After the first update, the previous transform
+		   is equal to the current transform.
+		 */
+		previousPosition = currentPosition;
+		XMStoreFloat3(&currentPosition, XMVectorAdd(XMLoadFloat3(&currentPosition), XMLoadFloat3(&step)));
+		if( i == 0 ) {
+			previousPosition = currentPosition;
+		}
+		for( size_t j = 0; j < 2; ++j ) {
+			passed = checkInterpolation(logger, names[j] + L", update " + std::to_wstring(i),
+				*transforms[j], previousPosition, currentPosition) && passed;
+		}
+	}
+
+	// Teleporting
+	for( size_t j = 0; j < 2; ++j ) {
+		transforms[j]->resetInterpolation();
+		passed = checkInterpolation(logger, names[j] + L", after resetInterpolation()",
+			*transforms[j], currentPosition, currentPosition) && passed;
+	}
+
+	if( !passed ) {
+		logger->logMessage(L"Test failed: Incorrect interpolated transforms.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	delete boundTransform;
+	delete system;
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
@@ -0,0 +1,275 @@
+/*
+testKnot.cpp
+------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testSpline.cpp
+
+Description
+  -Implementations of test functions for the Knot classes
+*/
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include "testKnot.h"
+#include "BasicSpline.h"
+#include "StaticKnot.h"
+#include "DynamicKnot.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+using std::wstring;
+
+// Number of splines in the pool churn test
+#define TESTKNOT_N_SPLINES 100
+
+// Capacity of each spline in the pool churn test
+#define TESTKNOT_CAPACITY 10
+
+// Number of knots added to each spline per frame in the pool churn test
+#define TESTKNOT_KNOTS_PER_FRAME 4
+
+// Number of frames in the pool churn test
+#define TESTKNOT_N_FRAMES 5000
+
+// Update time interval, in milliseconds
+#define TESTKNOT_INTERVAL 16
+
+namespace testKnot {
+
+	/* Returns true if the 'n' control points output by 'knot'
+	   are equal to 'expected' (with 'w' components of 1)
+	 */
+	static bool checkControlPoints(const Knot& knot, const XMFLOAT3* const expected, const size_t n) {
+		XMFLOAT4 actual[5];
+		XMFLOAT4* pointer = actual;
+		knot.getControlPoints(pointer);
+		if( static_cast<size_t>(pointer - actual) != n ) {
+			return false;
+		}
+		for( size_t i = 0; i < n; ++i ) {
+			if( actual[i].x != expected[i].x || actual[i].y != expected[i].y ||
+				actual[i].z != expected[i].z || actual[i].w != 1.0f ) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static size_t liveKnots(void) {
+		SlabPool::Telemetry staticTelemetry, dynamicTelemetry;
+		StaticKnot::getPoolTelemetry(staticTelemetry);
+		DynamicKnot::getPoolTelemetry(dynamicTelemetry);
+		return staticTelemetry.nLiveBlocks + dynamicTelemetry.nLiveBlocks;
+	}
+
+	static void logTelemetry(Logger* const logger, const wstring& name, const SlabPool::Telemetry& telemetry) {
+		logger->logMessage(name + L" pool: " +
+			std::to_wstring(telemetry.nAllocations) + L" allocations, " +
+			std::to_wstring(telemetry.nDeallocations) + L" deallocations, " +
+			std::to_wstring(telemetry.nLiveBlocks) + L" live, " +
+			std::to_wstring(telemetry.nPeakLiveBlocks) + L" peak live, " +
+			std::to_wstring(telemetry.nSlabs) + L" slabs, " +
+			std::to_wstring(telemetry.nReservedBytes) + L" bytes reserved");
+	}
+
+	static double elapsedMilliseconds(const LARGE_INTEGER& start, const LARGE_INTEGER& end, const LARGE_INTEGER& frequency) {
+		return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+}
+
+HRESULT testKnot::testSides(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testKnot_testSides.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	const size_t initialLiveKnots = liveKnots();
+	XMFLOAT3 p;
+
+	// p2, p3, p0 and p1 of a double-sided knot with C_1 continuity
+	const XMFLOAT3 points[] = {
+		XMFLOAT3(-1.0f, 2.0f, 0.0f),
+		XMFLOAT3(0.0f, 1.0f, 1.0f),
+		XMFLOAT3(0.0f, 1.0f, 1.0f),
+		XMFLOAT3(1.0f, 0.0f, 2.0f)
+	};
+
+	StaticKnot* start = new StaticKnot(Knot::PointSet::START, points + 2);
+	StaticKnot* end = new StaticKnot(Knot::PointSet::END, points);
+	StaticKnot* both = new StaticKnot(Knot::PointSet::BOTH, points);
+
+	if( !checkControlPoints(*start, points + 2, 2) || start->getSide() != Knot::PointSet::START ||
+		SUCCEEDED(start->getP2(p)) || SUCCEEDED(start->getP3(p)) ) {
+		logger->logMessage(L"Test failed: Incorrect START knot.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	if( !checkControlPoints(*end, points, 2) || end->getSide() != Knot::PointSet::END ||
+		SUCCEEDED(end->getP0(p)) || SUCCEEDED(end->getP1(p)) ) {
+		logger->logMessage(L"Test failed: Incorrect END knot.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	if( !checkControlPoints(*both, points, 4) || both->getSide() != Knot::PointSet::BOTH ) {
+		logger->logMessage(L"Test failed: Incorrect BOTH knot.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Conversions
+	if( FAILED(start->makeDouble()) || !checkControlPoints(*start, points, 4) ||
+		FAILED(end->makeDouble()) || !checkControlPoints(*end, points, 4) ) {
+		logger->logMessage(L"Test failed: Incorrect conversion to double-sided knots.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	if( SUCCEEDED(both->makeDouble()) || SUCCEEDED(both->makeHalf(Knot::PointSet::BOTH)) ) {
+		logger->logMessage(L"Test failed: Invalid conversions succeeded.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	if( FAILED(both->makeHalf(Knot::PointSet::END)) || !checkControlPoints(*both, points, 2) ||
+		SUCCEEDED(both->makeHalf(Knot::PointSet::START)) ||
+		FAILED(both->makeDouble()) || !checkControlPoints(*both, points, 4) ||
+		FAILED(both->makeHalf(Knot::PointSet::START)) || !checkControlPoints(*both, points + 2, 2) ) {
+		logger->logMessage(L"Test failed: Incorrect conversion to single-sided knots.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	delete start;
+	delete end;
+	delete both;
+
+	if( liveKnots() != initialLiveKnots ) {
+		logger->logMessage(L"Test failed: Knots were not returned to their pools.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testKnot::testPoolChurn(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testKnot_testPoolChurn.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	const size_t initialLiveKnots = liveKnots();
+
+	const float speed = 1.0f;
+	XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+	XMFLOAT3 position(0.0f, 0.0f, 0.0f);
+	XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+	Transformable target(scale, position, orientation);
+	target.setLinearVelocity(XMFLOAT3(1.0f, 0.5f, 0.0f), 0.01f);
+
+	std::vector<BasicSpline*> splines;
+	for( size_t i = 0; i < TESTKNOT_N_SPLINES; ++i ) {
+		splines.push_back(new BasicSpline(TESTKNOT_CAPACITY, true, &speed, false));
+	}
+
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+
+	SlabPool::Telemetry staticFirstFrame, dynamicFirstFrame, staticTelemetry, dynamicTelemetry;
+	XMFLOAT3 controlPoints[2];
+	DWORD currentTime = 0;
+	size_t nFailures = 0;
+	double time = 0.0;
+
+	for( size_t frame = 0; frame < TESTKNOT_N_FRAMES; ++frame ) {
+		currentTime += TESTKNOT_INTERVAL;
+		target.update(currentTime, TESTKNOT_INTERVAL);
+		controlPoints[0] = target.getPosition();
+		controlPoints[1] = XMFLOAT3(controlPoints[0].x + 1.0f, controlPoints[0].y, controlPoints[0].z);
+
+		QueryPerformanceCounter(&start);
+		for( size_t i = 0; i < splines.size(); ++i ) {
+			for( size_t k = 0; k < TESTKNOT_KNOTS_PER_FRAME; ++k ) {
+				switch( k % 4 ) {
+				case 0:
+					nFailures += FAILED(splines[i]->addToEnd(controlPoints)) ? 1 : 0;
+					break;
+				case 1:
+					nFailures += FAILED(splines[i]->addToEnd(&target, true)) ? 1 : 0;
+					break;
+				case 2:
+					nFailures += FAILED(splines[i]->addToEnd(&target, false)) ? 1 : 0;
+					break;
+				default:
+					// HomingSpline-like tracking
+					nFailures += FAILED(splines[i]->removeFromEnd()) ? 1 : 0;
+					nFailures += FAILED(splines[i]->addToEnd(&target, false)) ? 1 : 0;
+					nFailures += FAILED(splines[i]->addToEnd(&target, true)) ? 1 : 0;
+					break;
+				}
+			}
+			nFailures += FAILED(splines[i]->update(currentTime, TESTKNOT_INTERVAL)) ? 1 : 0;
+		}
+		QueryPerformanceCounter(&end);
+		time += elapsedMilliseconds(start, end, frequency);
+
+		// All splines are at capacity after the first few frames
+		if( (frame + 1) * TESTKNOT_KNOTS_PER_FRAME == TESTKNOT_CAPACITY * 2 ) {
+			StaticKnot::getPoolTelemetry(staticFirstFrame);
+			DynamicKnot::getPoolTelemetry(dynamicFirstFrame);
+		}
+	}
+
+	StaticKnot::getPoolTelemetry(staticTelemetry);
+	DynamicKnot::getPoolTelemetry(dynamicTelemetry);
+	logTelemetry(logger, L"StaticKnot", staticTelemetry);
+	logTelemetry(logger, L"DynamicKnot", dynamicTelemetry);
+
+	const size_t nKnots = (staticTelemetry.nAllocations - staticFirstFrame.nAllocations) +
+		(dynamicTelemetry.nAllocations - dynamicFirstFrame.nAllocations);
+	logger->logMessage(std::to_wstring(nKnots) + L" knots created after the splines reached capacity, in " +
+		std::to_wstring(time) + L" ms in total (" +
+		std::to_wstring(time * 1.0e6 / nKnots) + L" ns per knot, including spline updates).");
+
+	if( nFailures != 0 ) {
+		logger->logMessage(L"Test failed: " + std::to_wstring(nFailures) + L" spline operations failed.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	if( staticTelemetry.nReservedBytes != staticFirstFrame.nReservedBytes ||
+		dynamicTelemetry.nReservedBytes != dynamicFirstFrame.nReservedBytes ) {
+		logger->logMessage(L"Test failed: Knot pools grew after the splines reached capacity.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	for( size_t i = 0; i < splines.size(); ++i ) {
+		delete splines[i];
+	}
+	if( liveKnots() != initialLiveKnots ) {
+		logger->logMessage(L"Test failed: Knots were not returned to their pools when the splines were destroyed.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
@@ -0,0 +1,315 @@
+/*
+testParticleInstanceBatcher.cpp
+-------------------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testSplineUploader.cpp
+
+Description
+  -Implementations of test functions for the ParticleInstanceBatcher class
+*/
+
+#include <string>
+#include <vector>
+#include <cstring> // for memcmp()
+#include "testParticleInstanceBatcher.h"
+#include "ParticleInstanceBatcher.h"
+#include "RecordingParticleDrawBackend.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+using std::wstring;
+
+// Models, as in GameStateWithParticles (explosions, jets and ball lightning effects)
+#define TESTPARTICLEINSTANCEBATCHER_N_MODELS 3
+
+// Small enough that some frames need several instanced draw calls per model
+#define TESTPARTICLEINSTANCEBATCHER_MAX_INSTANCES 64
+
+namespace testParticleInstanceBatcher {
+
+	/* Instance 'index' of model 'model', with values identifying
+	   the model and instance
+	 */
+	static void makeInstance(ParticleInstanceType& instance, const size_t model, const size_t index) {
+		XMFLOAT4X4 world;
+		XMStoreFloat4x4(&world, XMMatrixTranslation(static_cast<float>(index), static_cast<float>(model), 1.0f));
+		ParticleInstanceBatcher::makeInstance(instance, world,
+			XMFLOAT2(static_cast<float>(index), 16.0f),
+			XMFLOAT3(static_cast<float>(model), 0.5f, 0.25f));
+	}
+
+	// Queues 'counts[model]' instances of each model
+	static HRESULT addInstances(ParticleInstanceBatcher& batcher, const size_t* const counts) {
+		ParticleInstanceType instance;
+		for( size_t model = 0; model < TESTPARTICLEINSTANCEBATCHER_N_MODELS; ++model ) {
+			for( size_t i = 0; i < counts[model]; ++i ) {
+				makeInstance(instance, model, i);
+				if( FAILED(batcher.add(model, instance)) ) {
+					return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+				}
+			}
+		}
+		return ERROR_SUCCESS;
+	}
+
+	static bool isEqual(const ParticleInstanceType& a, const ParticleInstanceType& b) {
+		return memcmp(&a, &b, sizeof(ParticleInstanceType)) == 0;
+	}
+}
+
+HRESULT testParticleInstanceBatcher::testDrawCounts(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testParticleInstanceBatcher_testDrawCounts.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT result = ERROR_SUCCESS;
+
+	// Numbers of explosions, jets and ball lightning effects in each frame
+	const size_t frames[][TESTPARTICLEINSTANCEBATCHER_N_MODELS] = {
+		{ 10, 1, 1 },
+		{ 0, 3, 0 },
+		{ 0, 0, 0 },
+		{ 200, 64, 65 },
+		{ 1, 0, 2 }
+	};
+	const size_t nFrames = sizeof(frames) / sizeof(frames[0]);
+
+	ParticleInstanceBatcher perSystemBatcher(TESTPARTICLEINSTANCEBATCHER_N_MODELS, false, TESTPARTICLEINSTANCEBATCHER_MAX_INSTANCES);
+	ParticleInstanceBatcher instancedBatcher(TESTPARTICLEINSTANCEBATCHER_N_MODELS, true, TESTPARTICLEINSTANCEBATCHER_MAX_INSTANCES);
+	RecordingParticleDrawBackend perSystemBackend(TESTPARTICLEINSTANCEBATCHER_N_MODELS);
+	RecordingParticleDrawBackend instancedBackend(TESTPARTICLEINSTANCEBATCHER_N_MODELS);
+
+	for( size_t f = 0; f < nFrames && SUCCEEDED(result); ++f ) {
+		const size_t* const counts = frames[f];
+		size_t nSystems = 0;
+		size_t nModelsUsed = 0;
+		size_t nInstancedDraws = 0;
+		for( size_t model = 0; model < TESTPARTICLEINSTANCEBATCHER_N_MODELS; ++model ) {
+			nSystems += counts[model];
+			nModelsUsed += (counts[model] > 0) ? 1 : 0;
+			nInstancedDraws += (counts[model] + TESTPARTICLEINSTANCEBATCHER_MAX_INSTANCES - 1) / TESTPARTICLEINSTANCEBATCHER_MAX_INSTANCES;
+		}
+
+		perSystemBackend.beginFrame();
+		instancedBackend.beginFrame();
+		if( FAILED(addInstances(perSystemBatcher, counts)) || FAILED(addInstances(instancedBatcher, counts)) ) {
+			logger->logMessage(L"Test failed: Failed to queue instances in frame " + std::to_wstring(f) + L".");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+		if( perSystemBatcher.getNumberOfInstances() != nSystems || instancedBatcher.getNumberOfInstances() != nSystems ) {
+			logger->logMessage(L"Test failed: Unexpected number of queued instances in frame " + std::to_wstring(f) + L".");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+		if( FAILED(perSystemBatcher.flush(perSystemBackend)) || FAILED(instancedBatcher.flush(instancedBackend)) ) {
+			logger->logMessage(L"Test failed: ParticleInstanceBatcher::flush() returned a failure result in frame " + std::to_wstring(f) + L".");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+
+		// One bind, constant buffer update and draw call per system
+		if( perSystemBackend.getFrameDrawCalls() != nSystems ||
+			perSystemBackend.getFrameModelBinds() != nSystems ||
+			perSystemBackend.getFrameConstantBufferWrites() != nSystems ||
+			perSystemBackend.getFrameInstanceBufferWrites() != 0 ||
+			perSystemBackend.getFrameInstances().size() != nSystems ) {
+			logger->logMessage(L"Test failed: Unexpected per-system counts in frame " + std::to_wstring(f) + L": "
+				+ std::to_wstring(perSystemBackend.getFrameDrawCalls()) + L" draw calls, "
+				+ std::to_wstring(perSystemBackend.getFrameModelBinds()) + L" model binds, for "
+				+ std::to_wstring(nSystems) + L" systems.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+
+		// One bind per model, and one instance buffer update and draw call per group of instances
+		if( instancedBackend.getFrameDrawCalls() != nInstancedDraws ||
+			instancedBackend.getFrameModelBinds() != nModelsUsed ||
+			instancedBackend.getFrameConstantBufferWrites() != 0 ||
+			instancedBackend.getFrameInstanceBufferWrites() != nInstancedDraws ||
+			instancedBackend.getFrameInstances().size() != nSystems ) {
+			logger->logMessage(L"Test failed: Unexpected instanced counts in frame " + std::to_wstring(f) + L": "
+				+ std::to_wstring(instancedBackend.getFrameDrawCalls()) + L" draw calls (expected "
+				+ std::to_wstring(nInstancedDraws) + L"), "
+				+ std::to_wstring(instancedBackend.getFrameModelBinds()) + L" model binds (expected "
+				+ std::to_wstring(nModelsUsed) + L").");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+
+		// No draw call exceeds the maximum number of instances
+		const std::vector<RecordingParticleDrawBackend::Draw>& draws = instancedBackend.getFrameDraws();
+		for( size_t d = 0; d < draws.size(); ++d ) {
+			if( !draws[d].instanced || draws[d].nInstances > TESTPARTICLEINSTANCEBATCHER_MAX_INSTANCES ) {
+				logger->logMessage(L"Test failed: Instanced draw call " + std::to_wstring(d) + L" in frame "
+					+ std::to_wstring(f) + L" is not instanced, or draws too many instances.");
+				result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+				break;
+			}
+		}
+
+		logger->logMessage(L"Frame " + std::to_wstring(f) + L": " + std::to_wstring(nSystems) + L" systems, "
+			+ std::to_wstring(perSystemBackend.getFrameDrawCalls()) + L" draw calls and "
+			+ std::to_wstring(perSystemBackend.getFrameStateChanges()) + L" state changes per system, "
+			+ std::to_wstring(instancedBackend.getFrameDrawCalls()) + L" draw calls and "
+			+ std::to_wstring(instancedBackend.getFrameStateChanges()) + L" state changes instanced.");
+	}
+
+	if( SUCCEEDED(result) ) {
+		logger->logMessage(L"Totals: " + std::to_wstring(perSystemBackend.getTotalDrawCalls()) + L" draw calls and "
+			+ std::to_wstring(perSystemBackend.getTotalStateChanges()) + L" state changes per system, "
+			+ std::to_wstring(instancedBackend.getTotalDrawCalls()) + L" draw calls and "
+			+ std::to_wstring(instancedBackend.getTotalStateChanges()) + L" state changes instanced.");
+		logger->logMessage(L"Test passed.");
+	}
+
+	delete logger;
+	return result;
+}
+
+HRESULT testParticleInstanceBatcher::testInstanceData(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testParticleInstanceBatcher_testInstanceData.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT result = ERROR_SUCCESS;
+	ParticleInstanceType instance;
+
+	// makeInstance() places values where the instanced vertex shader expects them
+	XMFLOAT4X4 world;
+	XMStoreFloat4x4(&world, XMMatrixTranslation(1.0f, 2.0f, 3.0f));
+	ParticleInstanceBatcher::makeInstance(instance, world, XMFLOAT2(100.0f, 16.0f), XMFLOAT3(0.1f, 0.2f, 0.3f));
+	if( memcmp(&instance.world, &world, sizeof(XMFLOAT4X4)) != 0 ||
+		instance.world._41 != 1.0f || instance.world._42 != 2.0f || instance.world._43 != 3.0f ||
+		instance.time.x != 100.0f || instance.time.y != 16.0f || instance.time.z != 1.0f || instance.time.w != 1.0f ||
+		instance.colorCast.x != 0.1f || instance.colorCast.y != 0.2f || instance.colorCast.z != 0.3f || instance.colorCast.w != 0.0f ) {
+		logger->logMessage(L"Test failed: ParticleInstanceBatcher::makeInstance() output unexpected values.");
+		delete logger;
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	/* Add instances of different models in an interleaved order,
+	   with more instances of model 0 than fit in one draw call
+	 */
+	ParticleInstanceBatcher batcher(TESTPARTICLEINSTANCEBATCHER_N_MODELS, true, TESTPARTICLEINSTANCEBATCHER_MAX_INSTANCES);
+	RecordingParticleDrawBackend backend(TESTPARTICLEINSTANCEBATCHER_N_MODELS);
+	size_t counts[TESTPARTICLEINSTANCEBATCHER_N_MODELS] = { 0, 0, 0 };
+	const size_t nAdded = 2 * TESTPARTICLEINSTANCEBATCHER_MAX_INSTANCES + 10;
+	for( size_t i = 0; i < nAdded; ++i ) {
+		const size_t model = ((i % 5) == 4) ? 2 : 0;
+		makeInstance(instance, model, counts[model]);
+		++counts[model];
+		if( FAILED(batcher.add(model, instance)) ) {
+			logger->logMessage(L"Test failed: ParticleInstanceBatcher::add() returned a failure result.");
+			delete logger;
+			return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	for( size_t pass = 0; pass < 2 && SUCCEEDED(result); ++pass ) {
+		batcher.setInstanced(pass == 0);
+		backend.beginFrame();
+		if( pass == 1 ) {
+			// Queue the same instances again
+			size_t nextIndex[TESTPARTICLEINSTANCEBATCHER_N_MODELS] = { 0, 0, 0 };
+			for( size_t i = 0; i < nAdded; ++i ) {
+				const size_t model = ((i % 5) == 4) ? 2 : 0;
+				makeInstance(instance, model, nextIndex[model]);
+				++nextIndex[model];
+				batcher.add(model, instance);
+			}
+		}
+		if( FAILED(batcher.flush(backend)) ) {
+			logger->logMessage(L"Test failed: ParticleInstanceBatcher::flush() returned a failure result.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+		if( batcher.getNumberOfInstances() != 0 ) {
+			logger->logMessage(L"Test failed: ParticleInstanceBatcher::flush() did not empty the queues.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+
+		/* Instances are received grouped by model, in order of model index,
+		   then in the order in which they were added
+		 */
+		const std::vector<ParticleInstanceType>& received = backend.getFrameInstances();
+		const std::vector<RecordingParticleDrawBackend::Draw>& draws = backend.getFrameDraws();
+		size_t expectedIndex = 0;
+		size_t expectedModel = 0;
+		size_t nMismatches = 0;
+		for( size_t d = 0; d < draws.size(); ++d ) {
+			for( size_t i = draws[d].firstInstance; i < draws[d].firstInstance + draws[d].nInstances; ++i ) {
+				if( draws[d].model != expectedModel ) {
+					expectedModel = draws[d].model;
+					expectedIndex = 0;
+				}
+				makeInstance(instance, expectedModel, expectedIndex);
+				if( !isEqual(received[i], instance) ) {
+					++nMismatches;
+				}
+				++expectedIndex;
+			}
+		}
+		if( received.size() != nAdded || nMismatches != 0 ||
+			draws.empty() || draws.front().model != 0 || draws.back().model != 2 ) {
+			logger->logMessage(L"Test failed: " + std::to_wstring(nMismatches) + L" of "
+				+ std::to_wstring(received.size()) + L" instances received (of " + std::to_wstring(nAdded)
+				+ L" queued) do not match the queued instances, in " + ((pass == 0) ? wstring(L"instanced") : wstring(L"per-system"))
+				+ L" mode.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	// Invalid model indices are rejected
+	if( SUCCEEDED(result) ) {
+		if( SUCCEEDED(batcher.add(TESTPARTICLEINSTANCEBATCHER_N_MODELS, instance)) || batcher.getNumberOfInstances() != 0 ) {
+			logger->logMessage(L"Test failed: ParticleInstanceBatcher::add() accepted an out-of-range model index.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	// Backend failures are reported, and the queues are still emptied
+	if( SUCCEEDED(result) ) {
+		RecordingParticleDrawBackend smallBackend(1);
+		batcher.setInstanced(true);
+		makeInstance(instance, 1, 0);
+		batcher.add(1, instance);
+		if( SUCCEEDED(batcher.flush(smallBackend)) || batcher.getNumberOfInstances() != 0 ) {
+			logger->logMessage(L"Test failed: ParticleInstanceBatcher::flush() did not report a failure to bind a model, or did not empty the queues.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		} else if( SUCCEEDED(smallBackend.draw(instance)) || SUCCEEDED(smallBackend.drawInstanced(&instance, 1)) ) {
+			logger->logMessage(L"Test failed: RecordingParticleDrawBackend accepted a draw call before a model was bound.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	if( SUCCEEDED(result) ) {
+		logger->logMessage(L"Test passed.");
+	}
+
+	delete logger;
+	return result;
+}
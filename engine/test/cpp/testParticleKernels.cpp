@@ -0,0 +1,866 @@
+/*
+testParticleKernels.cpp
+-----------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testTransformSystem.cpp
+
+Description
+  -Implementations of test functions for the ParticleKernels class
+*/
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cstring> // for memcmp()
+#include "testParticleKernels.h"
+#include "ParticleKernels.h"
+#include "BasicSpline.h"
+#include "SplineUploader.h"
+#include "RecordingBufferWriter.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+
+// Maximum allowed difference from hand-computed values
+#define TESTPARTICLEKERNELS_TOLERANCE 1.0e-4f
+
+// Number of particles in the comparison with the reference kernel
+#define TESTPARTICLEKERNELS_N_PARTICLES 1003
+
+// Number of particles, and number of repetitions, in the benchmark
+#define TESTPARTICLEKERNELS_N_BENCHMARK_PARTICLES 100000
+#define TESTPARTICLEKERNELS_N_BENCHMARK_FRAMES 50
+
+// Capacity of the splines in the spline particle tests
+#define TESTPARTICLEKERNELS_SPLINE_CAPACITY 10
+
+namespace testParticleKernels {
+
+	// A hand-computed test case for the general particle vertex shader
+	struct GeneralCase {
+		const wchar_t* name;
+		ParticleVertexType input;
+		ParticleKernels::Globals globals;
+		XMFLOAT4X4 view;
+		ParticleKernels::GeneralOutput expected;
+	};
+
+	/* Stand-in for an InvariantParticles object,
+	   providing the accessors used by ParticleKernels::getGlobals()
+	 */
+	class GeometryStandIn {
+	public:
+		HRESULT getWorldTransform(XMFLOAT4X4& worldTransform) const {
+			XMStoreFloat4x4(&worldTransform, XMMatrixTranslation(1.0f, 2.0f, 3.0f));
+			return ERROR_SUCCESS;
+		}
+		float getTransparencyBlendFactor(void) const {
+			return 1.5f; // Out of range
+		}
+		XMFLOAT3 getColorCast(void) const {
+			return XMFLOAT3(0.1f, 0.2f, 0.3f);
+		}
+		HRESULT getTime(XMFLOAT2& time) const {
+			time = XMFLOAT2(1234.0f, 16.0f);
+			return ERROR_SUCCESS;
+		}
+		XMFLOAT2 getLODCompensation(void) const {
+			return XMFLOAT2(2.0f, 0.25f);
+		}
+	};
+
+	static ParticleVertexType makeParticle(const XMFLOAT3& position, const XMFLOAT3& direction,
+		const float speed, const XMFLOAT3& billboard, const XMFLOAT4& life) {
+		ParticleVertexType particle;
+		particle.position = position;
+		particle.billboard = billboard;
+		particle.linearVelocity = XMFLOAT4(direction.x, direction.y, direction.z, speed);
+		particle.life = life;
+		particle.index = XMFLOAT4(0.25f, 0.5f, 0.75f, 1.0f);
+		return particle;
+	}
+
+	static ParticleKernels::GeneralOutput makeOutput(const XMFLOAT3& positionVS, const XMFLOAT2& billboard,
+		const float angle, const XMFLOAT3& life) {
+		ParticleKernels::GeneralOutput output;
+		output.positionVS = positionVS;
+		output.billboard = billboard;
+		output.angle = angle;
+		output.life = life;
+		output.index = XMFLOAT4(0.25f, 0.5f, 0.75f, 1.0f);
+		return output;
+	}
+
+	static bool isClose(const float a, const float b) {
+		return std::abs(a - b) <= TESTPARTICLEKERNELS_TOLERANCE * (1.0f + std::abs(b));
+	}
+
+	static bool isClose(const ParticleKernels::GeneralOutput& a, const ParticleKernels::GeneralOutput& b) {
+		return isClose(a.positionVS.x, b.positionVS.x) &&
+			isClose(a.positionVS.y, b.positionVS.y) &&
+			isClose(a.positionVS.z, b.positionVS.z) &&
+			isClose(a.billboard.x, b.billboard.x) &&
+			isClose(a.billboard.y, b.billboard.y) &&
+			isClose(a.angle, b.angle) &&
+			isClose(a.life.x, b.life.x) &&
+			isClose(a.life.y, b.life.y) &&
+			isClose(a.life.z, b.life.z) &&
+			std::memcmp(&a.index, &b.index, sizeof(XMFLOAT4)) == 0;
+	}
+
+	static std::wstring toString(const ParticleKernels::GeneralOutput& output) {
+		return L"position = (" + std::to_wstring(output.positionVS.x) + L", " +
+			std::to_wstring(output.positionVS.y) + L", " + std::to_wstring(output.positionVS.z) +
+			L"), angle = " + std::to_wstring(output.angle) +
+			L", life = (" + std::to_wstring(output.life.x) + L", " +
+			std::to_wstring(output.life.y) + L", " + std::to_wstring(output.life.z) + L")";
+	}
+
+	/* Stand-in for a SplineParticles object, providing the accessors
+	   used by ParticleKernels::getSplineGlobals()
+	 */
+	class SplineGeometryStandIn : public GeometryStandIn {
+	public:
+		SplineGeometryStandIn(const Spline* const spline) : m_spline(spline) {}
+		size_t getNumberOfSegments(const bool capacity) const {
+			return (m_spline == 0) ? (capacity ? 8 : 3) : m_spline->getNumberOfSegments(capacity);
+		}
+		size_t getNumberOfSegmentSlots(void) const {
+			return (m_spline == 0) ? 9 : m_spline->getNumberOfSegmentSlots();
+		}
+		size_t getSegmentSlotOffset(void) const {
+			return (m_spline == 0) ? 5 : m_spline->getSegmentSlotOffset();
+		}
+	private:
+		const Spline* m_spline;
+	};
+
+	/* Creates a particle with components uniformly distributed within
+	   the ranges given for the laser particle systems in 'configFiles/geometry/laser.txt'
+	 */
+	static ParticleVertexType randomSplineParticle(std::default_random_engine& generator) {
+		std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+		ParticleVertexType particle;
+		particle.position = XMFLOAT3(distribution(generator), 0.5f + 0.5f * distribution(generator),
+			6.283185307f * distribution(generator));
+		particle.billboard = XMFLOAT3(0.05f + 0.05f * distribution(generator), 0.05f + 0.05f * distribution(generator),
+			0.0002f + 0.0018f * distribution(generator));
+		particle.linearVelocity = XMFLOAT4(0.00001f + 0.00009f * distribution(generator),
+			0.001f + 0.001f * distribution(generator), 0.000001f + 0.000009f * distribution(generator), 0.0f);
+		particle.life = XMFLOAT4(1000.0f * distribution(generator), 1.0f,
+			0.00005f + 0.00045f * distribution(generator), 0.0f);
+		particle.index = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
+		return particle;
+	}
+
+	static void randomKnot(XMFLOAT3* const controlPoints, std::default_random_engine& generator) {
+		std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+		for( size_t i = 0; i < 2; ++i ) {
+			controlPoints[i] = XMFLOAT3(distribution(generator), distribution(generator), distribution(generator));
+		}
+	}
+
+	/* Uploads the spline as SplineParticles would, and returns the number of particles
+	   for which the vectorized kernel, reading from the uploaded buffer,
+	   differs from the reference kernel, reading directly from the spline
+	 */
+	static size_t compareSplineKernels(const Spline& spline, SplineUploader& uploader, RecordingBufferWriter& writer,
+		const std::vector<ParticleVertexType>& inputs, const float time, const XMFLOAT4X4& view,
+		HRESULT& result) {
+
+		result = uploader.upload(writer, spline);
+		if( FAILED(result) ) {
+			return inputs.size();
+		}
+		ParticleKernels::SplineGlobals globals;
+		SplineGeometryStandIn geometry(&spline);
+		ParticleKernels::getSplineGlobals(globals, geometry);
+		globals.general.time.x = time;
+
+		// Control points in segment order, with the first segment in the first slot
+		std::vector<XMFLOAT4> controlPoints(4 * (spline.getNumberOfSegments(true) + 1));
+		XMFLOAT4* pointer = &controlPoints[0];
+		spline.getControlPoints(pointer, true);
+		ParticleKernels::SplineGlobals unpackedGlobals = globals;
+		unpackedGlobals.slots = XMFLOAT2(0.0f, static_cast<float>(spline.getNumberOfSegments(true)));
+
+		const size_t n = inputs.size();
+		std::vector<ParticleKernels::GeneralOutput> expected(n);
+		std::vector<ParticleKernels::GeneralOutput> actual(n);
+		for( size_t i = 0; i < n; ++i ) {
+			ParticleKernels::splineParticlesVSReference(expected[i], inputs[i], &controlPoints[0], unpackedGlobals, view);
+		}
+		result = ParticleKernels::splineParticlesVS(&actual[0], &inputs[0], n,
+			reinterpret_cast<const XMFLOAT4*>(writer.getContents()), writer.getSize() / SPLINEUPLOADER_SEGMENT_SIZE,
+			globals, view);
+		if( FAILED(result) ) {
+			return n;
+		}
+
+		size_t nMismatches = 0;
+		for( size_t i = 0; i < n; ++i ) {
+			if( std::memcmp(&expected[i], &actual[i], sizeof(ParticleKernels::GeneralOutput)) != 0 ) {
+				++nMismatches;
+			}
+		}
+		return nMismatches;
+	}
+
+	static double elapsedMilliseconds(const LARGE_INTEGER& start, const LARGE_INTEGER& end, const LARGE_INTEGER& frequency) {
+		return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+}
+
+HRESULT testParticleKernels::testGeneralGolden(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testParticleKernels_testGeneralGolden.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+
+	// The HLSL '%' operator takes the sign of the dividend
+	const float modInputs[][3] = {
+		{ 7.0f, 3.0f, 1.0f },
+		{ -7.0f, 3.0f, -1.0f },
+		{ 7.0f, -3.0f, 1.0f },
+		{ -7.0f, -3.0f, -1.0f },
+		{ 2.5f, 1.0f, 0.5f },
+		{ 0.0f, 5.0f, 0.0f }
+	};
+	const size_t nModInputs = sizeof(modInputs) / sizeof(modInputs[0]);
+	float mod = 0.0f;
+	for( size_t i = 0; i < nModInputs; ++i ) {
+		mod = ParticleKernels::hlslMod(modInputs[i][0], modInputs[i][1]);
+		if( !isClose(mod, modInputs[i][2]) ) {
+			logger->logMessage(L"Test failed: " + std::to_wstring(modInputs[i][0]) + L" % " +
+				std::to_wstring(modInputs[i][1]) + L" evaluated to " + std::to_wstring(mod) + L".");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	// Constant buffer contents
+	ParticleKernels::Globals globals;
+	GeometryStandIn geometry;
+	if( FAILED(ParticleKernels::getGlobals(globals, geometry)) ||
+		globals.world._41 != 1.0f || globals.world._42 != 2.0f || globals.world._43 != 3.0f ||
+		globals.blendAmountAndColorCast.x != 1.0f || globals.blendAmountAndColorCast.w != 0.3f ||
+		globals.time.x != 1234.0f || globals.time.y != 16.0f ||
+		globals.lodCompensation.x != 2.0f || globals.lodCompensation.y != 0.25f ) {
+		logger->logMessage(L"Test failed: ParticleKernels::getGlobals() did not reproduce the renderer's constant buffer contents.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	XMFLOAT4X4 identity;
+	XMStoreFloat4x4(&identity, XMMatrixIdentity());
+	ParticleKernels::Globals identityGlobals;
+	identityGlobals.world = identity;
+	identityGlobals.blendAmountAndColorCast = XMFLOAT4(1.0f, 0.0f, 0.0f, 0.0f);
+	identityGlobals.lodCompensation = XMFLOAT2(1.0f, 1.0f);
+
+	std::vector<GeneralCase> cases;
+	GeneralCase testCase;
+
+	/* Created at 100 ms, with a lifespan of 1000 ms, and evaluated at 600 ms:
+	   The particle has moved 0.01 * 500 units along the x-axis, and is moving
+	   away from the viewer, so the billboard rotates clockwise.
+	 */
+	testCase.name = L"first lifespan";
+	testCase.input = makeParticle(XMFLOAT3(1.0f, 2.0f, 3.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), 0.01f,
+		XMFLOAT3(2.0f, 3.0f, 0.001f), XMFLOAT4(100.0f, 1000.0f, 1.0f, 0.0f));
+	testCase.globals = identityGlobals;
+	testCase.globals.time = XMFLOAT2(600.0f, 16.0f);
+	testCase.view = identity;
+	testCase.expected = makeOutput(XMFLOAT3(6.0f, 2.0f, 3.0f), XMFLOAT2(2.0f, 3.0f), -0.5f, XMFLOAT3(500.0f, 500.0f, 1.0f));
+	cases.push_back(testCase);
+
+	// Two lifespans later, the particle is in the same state
+	testCase.name = L"wrapped around";
+	testCase.globals.time = XMFLOAT2(2600.0f, 16.0f);
+	cases.push_back(testCase);
+
+	// Before its creation time, the particle is at its initial position with full health
+	testCase.name = L"not yet created";
+	testCase.globals.time = XMFLOAT2(50.0f, 16.0f);
+	testCase.expected = makeOutput(XMFLOAT3(1.0f, 2.0f, 3.0f), XMFLOAT2(2.0f, 3.0f), 0.0f, XMFLOAT3(0.0f, 1000.0f, 1.0f));
+	cases.push_back(testCase);
+
+	// Health below the cutoff is clamped to zero, without changing the age
+	testCase.name = L"below cutoff";
+	testCase.input.life.w = 600.0f;
+	testCase.globals.time = XMFLOAT2(600.0f, 16.0f);
+	testCase.expected = makeOutput(XMFLOAT3(6.0f, 2.0f, 3.0f), XMFLOAT2(2.0f, 3.0f), -0.5f, XMFLOAT3(500.0f, 0.0f, 1.0f));
+	cases.push_back(testCase);
+
+	/* Translated by 10 units along x in world space, and by 5 units along z
+	   in view space. After 100 ms, health has decayed by 2 * 100, and the particle
+	   has moved 0.2 units along the negative x-axis, towards the viewer.
+	 */
+	testCase.name = L"transformed";
+	testCase.input = makeParticle(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f), 0.002f,
+		XMFLOAT3(1.0f, 1.0f, 0.01f), XMFLOAT4(0.0f, 1000.0f, 2.0f, 0.0f));
+	XMStoreFloat4x4(&testCase.globals.world, XMMatrixTranslation(10.0f, 0.0f, 0.0f));
+	testCase.globals.time = XMFLOAT2(100.0f, 16.0f);
+	XMStoreFloat4x4(&testCase.view, XMMatrixTranslation(0.0f, 0.0f, 5.0f));
+	testCase.expected = makeOutput(XMFLOAT3(9.8f, 0.0f, 5.0f), XMFLOAT2(1.0f, 1.0f), 1.0f, XMFLOAT3(100.0f, 800.0f, 2.0f));
+	cases.push_back(testCase);
+
+	/* With a decay factor of 3, health wraps around after 333.3 ms,
+	   so at 500 ms, the recomputed age is 500 / 3 ms.
+	 */
+	testCase.name = L"fractional age";
+	testCase.input = makeParticle(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 1.0f, 0.0f), 0.0f,
+		XMFLOAT3(1.0f, 1.0f, 0.003f), XMFLOAT4(0.0f, 1000.0f, 3.0f, 0.0f));
+	testCase.globals = identityGlobals;
+	testCase.globals.time = XMFLOAT2(500.0f, 16.0f);
+	testCase.view = identity;
+	testCase.expected = makeOutput(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT2(1.0f, 1.0f), 0.5f, XMFLOAT3(500.0f / 3.0f, 500.0f, 3.0f));
+	cases.push_back(testCase);
+
+	// Level of detail compensation scales the billboard and the health
+	testCase.name = L"level of detail compensation";
+	testCase.globals.lodCompensation = XMFLOAT2(2.0f, 0.25f);
+	testCase.expected = makeOutput(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT2(2.0f, 2.0f), 0.5f, XMFLOAT3(500.0f / 3.0f, 125.0f, 3.0f));
+	cases.push_back(testCase);
+
+	// Evaluate each case with the reference kernel, and with the vectorized kernel on a full batch plus one
+	const size_t n = PARTICLEKERNELS_BATCH_SIZE + 1;
+	std::vector<ParticleVertexType> inputs(n);
+	std::vector<ParticleKernels::GeneralOutput> outputs(n);
+	ParticleKernels::GeneralOutput output;
+	for( std::vector<GeneralCase>::const_iterator it = cases.cbegin(); it != cases.cend(); ++it ) {
+		ParticleKernels::generalParticlesVSReference(output, it->input, it->globals, it->view);
+		if( !isClose(output, it->expected) ) {
+			logger->logMessage(L"Test failed: Reference kernel output for the '" + std::wstring(it->name) +
+				L"' case was " + toString(output) + L", not " + toString(it->expected) + L".");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+
+		inputs.assign(n, it->input);
+		if( FAILED(ParticleKernels::generalParticlesVS(&outputs[0], &inputs[0], n, it->globals, it->view)) ) {
+			logger->logMessage(L"Test failed: ParticleKernels::generalParticlesVS() returned a failure result.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			continue;
+		}
+		for( size_t i = 0; i < n; ++i ) {
+			if( !isClose(outputs[i], it->expected) ) {
+				logger->logMessage(L"Test failed: Vectorized kernel output " + std::to_wstring(i) + L" for the '" +
+					std::wstring(it->name) + L"' case was " + toString(outputs[i]) +
+					L", not " + toString(it->expected) + L".");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+		}
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testParticleKernels::testGeneralAgainstReference(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testParticleKernels_testGeneralAgainstReference.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	std::default_random_engine generator(3501);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> unitDistribution(0.0f, 1.0f);
+
+	const size_t n = TESTPARTICLEKERNELS_N_PARTICLES;
+	std::vector<ParticleVertexType> inputs(n);
+	XMFLOAT3 direction;
+	for( size_t i = 0; i < n; ++i ) {
+		XMStoreFloat3(&direction, XMVector3Normalize(XMVectorSet(
+			distribution(generator), distribution(generator), distribution(generator), 0.0f)));
+		inputs[i] = makeParticle(
+			XMFLOAT3(10.0f * distribution(generator), 10.0f * distribution(generator), 10.0f * distribution(generator)),
+			direction, 0.01f * unitDistribution(generator),
+			XMFLOAT3(unitDistribution(generator), unitDistribution(generator), 0.01f * distribution(generator)),
+			XMFLOAT4(5000.0f * unitDistribution(generator), 100.0f + 3000.0f * unitDistribution(generator),
+				0.5f + 2.5f * unitDistribution(generator), 0.0f));
+		inputs[i].life.w = 0.5f * inputs[i].life.y * unitDistribution(generator);
+		inputs[i].index = XMFLOAT4(unitDistribution(generator), unitDistribution(generator),
+			unitDistribution(generator), static_cast<float>(i));
+	}
+
+	ParticleKernels::Globals globals;
+	XMStoreFloat4x4(&globals.world, XMMatrixAffineTransformation(
+		XMVectorReplicate(2.0f), XMVectorZero(),
+		XMQuaternionRotationRollPitchYaw(0.3f, -1.2f, 0.7f),
+		XMVectorSet(5.0f, -3.0f, 20.0f, 0.0f)));
+	globals.blendAmountAndColorCast = XMFLOAT4(1.0f, 0.0f, 0.0f, 0.0f);
+	globals.lodCompensation = XMFLOAT2(1.5f, 2.0f);
+	XMFLOAT4X4 view;
+	XMStoreFloat4x4(&view, XMMatrixLookAtLH(
+		XMVectorSet(-10.0f, 5.0f, -30.0f, 1.0f),
+		XMVectorSet(5.0f, -3.0f, 20.0f, 1.0f),
+		XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)));
+
+	std::vector<ParticleKernels::GeneralOutput> expected(n);
+	std::vector<ParticleKernels::GeneralOutput> actual(n);
+	size_t nMismatches = 0;
+	const float times[] = { 0.0f, 1000.0f, 4321.5f, 100000.0f };
+	const size_t nTimes = sizeof(times) / sizeof(float);
+	for( size_t t = 0; t < nTimes; ++t ) {
+		globals.time = XMFLOAT2(times[t], 16.0f);
+		for( size_t i = 0; i < n; ++i ) {
+			ParticleKernels::generalParticlesVSReference(expected[i], inputs[i], globals, view);
+		}
+
+		// Array lengths which leave different numbers of particles after the last full batch
+		for( size_t length = n - PARTICLEKERNELS_BATCH_SIZE; length <= n; ++length ) {
+			if( FAILED(ParticleKernels::generalParticlesVS(&actual[0], &inputs[0], length, globals, view)) ) {
+				logger->logMessage(L"Test failed: ParticleKernels::generalParticlesVS() returned a failure result.");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+				break;
+			}
+			for( size_t i = 0; i < length; ++i ) {
+				if( std::memcmp(&expected[i], &actual[i], sizeof(ParticleKernels::GeneralOutput)) != 0 ) {
+					if( nMismatches == 0 ) {
+						logger->logMessage(L"First mismatch, at time " + std::to_wstring(times[t]) +
+							L", for particle " + std::to_wstring(i) + L": expected " + toString(expected[i]) +
+							L", got " + toString(actual[i]));
+					}
+					++nMismatches;
+				}
+			}
+		}
+	}
+
+	if( nMismatches != 0 ) {
+		logger->logMessage(L"Test failed: " + std::to_wstring(nMismatches) +
+			L" outputs of the vectorized kernel differ from those of the reference kernel.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Null arrays are rejected
+	if( SUCCEEDED(ParticleKernels::generalParticlesVS(0, &inputs[0], n, globals, view)) ) {
+		logger->logMessage(L"Test failed: A null output array was accepted.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testParticleKernels::benchmarkGeneral(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testParticleKernels_benchmarkGeneral.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	std::default_random_engine generator(3501);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> unitDistribution(0.0f, 1.0f);
+
+	const size_t n = TESTPARTICLEKERNELS_N_BENCHMARK_PARTICLES;
+	const size_t nFrames = TESTPARTICLEKERNELS_N_BENCHMARK_FRAMES;
+	std::vector<ParticleVertexType> inputs(n);
+	XMFLOAT3 direction;
+	for( size_t i = 0; i < n; ++i ) {
+		XMStoreFloat3(&direction, XMVector3Normalize(XMVectorSet(
+			distribution(generator), distribution(generator), distribution(generator), 0.0f)));
+		inputs[i] = makeParticle(
+			XMFLOAT3(distribution(generator), distribution(generator), distribution(generator)),
+			direction, 0.01f * unitDistribution(generator),
+			XMFLOAT3(0.1f, 0.1f, 0.01f * distribution(generator)),
+			XMFLOAT4(1000.0f * unitDistribution(generator), 2000.0f, 1.0f, 0.0f));
+	}
+
+	ParticleKernels::Globals globals;
+	XMStoreFloat4x4(&globals.world, XMMatrixTranslation(0.0f, 0.0f, 10.0f));
+	globals.blendAmountAndColorCast = XMFLOAT4(1.0f, 0.0f, 0.0f, 0.0f);
+	XMFLOAT4X4 view;
+	XMStoreFloat4x4(&view, XMMatrixLookAtLH(
+		XMVectorSet(0.0f, 0.0f, -10.0f, 1.0f), XMVectorZero(), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)));
+
+	std::vector<ParticleKernels::GeneralOutput> outputs(n);
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+	float checksum = 0.0f;
+
+	// Reference kernel
+	QueryPerformanceCounter(&start);
+	for( size_t frame = 0; frame < nFrames; ++frame ) {
+		globals.time = XMFLOAT2(static_cast<float>(frame) * 16.0f, 16.0f);
+		for( size_t i = 0; i < n; ++i ) {
+			ParticleKernels::generalParticlesVSReference(outputs[i], inputs[i], globals, view);
+		}
+		checksum += outputs[frame].positionVS.x;
+	}
+	QueryPerformanceCounter(&end);
+	const double referenceTime = elapsedMilliseconds(start, end, frequency);
+
+	// Vectorized kernel
+	QueryPerformanceCounter(&start);
+	for( size_t frame = 0; frame < nFrames; ++frame ) {
+		globals.time = XMFLOAT2(static_cast<float>(frame) * 16.0f, 16.0f);
+		ParticleKernels::generalParticlesVS(&outputs[0], &inputs[0], n, globals, view);
+		checksum += outputs[frame].positionVS.x;
+	}
+	QueryPerformanceCounter(&end);
+	const double vectorizedTime = elapsedMilliseconds(start, end, frequency);
+
+	const double nProcessed = static_cast<double>(n) * static_cast<double>(nFrames);
+	logger->logMessage(std::to_wstring(n) + L" particles, " + std::to_wstring(nFrames) + L" frames");
+	logger->logMessage(L"Reference kernel: " + std::to_wstring(nProcessed / (referenceTime / 1000.0)) + L" particles per second");
+	logger->logMessage(L"Vectorized kernel: " + std::to_wstring(nProcessed / (vectorizedTime / 1000.0)) + L" particles per second");
+	logger->logMessage(L"Speedup: " + std::to_wstring(referenceTime / vectorizedTime));
+	logger->logMessage(L"(Checksum: " + std::to_wstring(checksum) + L")");
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
+
+HRESULT testParticleKernels::testSplineGolden(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testParticleKernels_testSplineGolden.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+
+	// Constant buffer contents
+	ParticleKernels::SplineGlobals globals;
+	SplineGeometryStandIn geometry(0);
+	if( FAILED(ParticleKernels::getSplineGlobals(globals, geometry)) ||
+		globals.general.world._41 != 1.0f || globals.general.time.x != 1234.0f ||
+		globals.segments.x != 3.0f || globals.segments.y != 8.0f ||
+		globals.slots.x != 5.0f || globals.slots.y != 9.0f ) {
+		logger->logMessage(L"Test failed: ParticleKernels::getSplineGlobals() did not reproduce the renderer's constant buffer contents.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	/* A spline with two straight segments along the line (x, 1, 0),
+	   from x = 0 to 3, and from x = 3 to 6. The first segment is in the last slot
+	   of the buffer, and the second segment is in the first slot.
+	   The middle slot is unused.
+	 */
+	std::vector<XMFLOAT4> spline;
+	for( size_t i = 0; i < 4; ++i ) {
+		spline.push_back(XMFLOAT4(3.0f + static_cast<float>(i), 1.0f, 0.0f, 1.0f));
+	}
+	for( size_t i = 0; i < 4; ++i ) {
+		spline.push_back(XMFLOAT4(100.0f, 100.0f, 100.0f, 1.0f));
+	}
+	for( size_t i = 0; i < 4; ++i ) {
+		spline.push_back(XMFLOAT4(static_cast<float>(i), 1.0f, 0.0f, 1.0f));
+	}
+	const size_t nSlots = spline.size() / 4;
+
+	XMFLOAT4X4 identity;
+	XMStoreFloat4x4(&identity, XMMatrixIdentity());
+	ParticleKernels::SplineGlobals splineGlobals;
+	splineGlobals.general.world = identity;
+	splineGlobals.general.blendAmountAndColorCast = XMFLOAT4(1.0f, 0.0f, 0.0f, 0.0f);
+	splineGlobals.general.time = XMFLOAT2(0.0f, 16.0f);
+	splineGlobals.segments = XMFLOAT2(2.0f, 2.0f);
+	splineGlobals.slots = XMFLOAT2(2.0f, static_cast<float>(nSlots));
+
+	struct SplineCase {
+		const wchar_t* name;
+		ParticleVertexType input;
+		ParticleKernels::SplineGlobals globals;
+		XMFLOAT4X4 view;
+		ParticleKernels::GeneralOutput expected;
+	};
+	std::vector<SplineCase> cases;
+	SplineCase testCase;
+
+	/* Halfway along the first segment, offset by a distance of 2
+	   along the first tangent vector, which is the y-axis.
+	   The second tangent vector is the negative z-axis.
+	 */
+	testCase.name = L"first segment";
+	testCase.input = makeParticle(XMFLOAT3(0.25f, 2.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 0.0f), 0.0f,
+		XMFLOAT3(1.0f, 1.0f, 0.001f), XMFLOAT4(0.0f, 10000.0f, 1.0f, 0.0f));
+	testCase.globals = splineGlobals;
+	testCase.view = identity;
+	testCase.expected = makeOutput(XMFLOAT3(1.5f, 3.0f, 0.0f), XMFLOAT2(1.0f, 1.0f), 0.0f, XMFLOAT3(0.0f, 10000.0f, 1.0f));
+	cases.push_back(testCase);
+
+	testCase.name = L"rotated offset";
+	testCase.input.position.z = XM_PIDIV2;
+	testCase.expected.positionVS = XMFLOAT3(1.5f, 1.0f, -2.0f);
+	cases.push_back(testCase);
+
+	/* After 2000 ms, the spline parameter has increased by 0.2,
+	   and the radius by 2. The particle is moving away from the viewer
+	   (at the origin), so the billboard rotates clockwise.
+	 */
+	testCase.name = L"moving";
+	testCase.input = makeParticle(XMFLOAT3(0.25f, 2.0f, 0.0f), XMFLOAT3(0.001f, 0.0f, 0.0001f), 0.0f,
+		XMFLOAT3(1.0f, 1.0f, 0.001f), XMFLOAT4(0.0f, 10000.0f, 1.0f, 0.0f));
+	testCase.globals.general.time.x = 2000.0f;
+	testCase.expected = makeOutput(XMFLOAT3(2.7f, 5.0f, 0.0f), XMFLOAT2(1.0f, 1.0f), -2.0f, XMFLOAT3(2000.0f, 8000.0f, 1.0f));
+	cases.push_back(testCase);
+
+	// The spline parameter wraps around from 1 to 0
+	testCase.name = L"wrapped parameter";
+	testCase.input = makeParticle(XMFLOAT3(0.9f, 2.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 0.0001f), 0.0f,
+		XMFLOAT3(1.0f, 1.0f, 0.0f), XMFLOAT4(0.0f, 10000.0f, 1.0f, 0.0f));
+	testCase.expected = makeOutput(XMFLOAT3(0.6f, 3.0f, 0.0f), XMFLOAT2(1.0f, 1.0f), 0.0f, XMFLOAT3(2000.0f, 8000.0f, 1.0f));
+	cases.push_back(testCase);
+
+	// The second segment is found in the first slot of the buffer
+	testCase.name = L"second segment";
+	testCase.input = makeParticle(XMFLOAT3(0.75f, 2.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 0.0f), 0.0f,
+		XMFLOAT3(1.0f, 1.0f, 0.001f), XMFLOAT4(0.0f, 10000.0f, 1.0f, 0.0f));
+	testCase.globals.general.time.x = 0.0f;
+	testCase.expected = makeOutput(XMFLOAT3(4.5f, 3.0f, 0.0f), XMFLOAT2(1.0f, 1.0f), 0.0f, XMFLOAT3(0.0f, 10000.0f, 1.0f));
+	cases.push_back(testCase);
+
+	// With only one valid segment, the same particle has zero health
+	testCase.name = L"out of bounds";
+	testCase.globals.segments.x = 1.0f;
+	testCase.expected = makeOutput(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT2(0.0f, 0.0f), 0.0f, XMFLOAT3(0.0f, 0.0f, 1.0f));
+	cases.push_back(testCase);
+
+	/* The first case, after 100 ms, translated by 10 units along x in world space,
+	   and by 5 units along z in view space
+	 */
+	testCase.name = L"transformed";
+	testCase.input = cases[0].input;
+	testCase.globals = splineGlobals;
+	testCase.globals.general.time.x = 100.0f;
+	XMStoreFloat4x4(&testCase.globals.general.world, XMMatrixTranslation(10.0f, 0.0f, 0.0f));
+	XMStoreFloat4x4(&testCase.view, XMMatrixTranslation(0.0f, 0.0f, 5.0f));
+	testCase.expected = makeOutput(XMFLOAT3(11.5f, 3.0f, 5.0f), XMFLOAT2(1.0f, 1.0f), -0.1f, XMFLOAT3(100.0f, 9900.0f, 1.0f));
+	cases.push_back(testCase);
+
+	// Evaluate each case with the reference kernel, and with the vectorized kernel on a full batch plus one
+	const size_t n = PARTICLEKERNELS_BATCH_SIZE + 1;
+	std::vector<ParticleVertexType> inputs(n);
+	std::vector<ParticleKernels::GeneralOutput> outputs(n);
+	ParticleKernels::GeneralOutput output;
+	for( std::vector<SplineCase>::const_iterator it = cases.cbegin(); it != cases.cend(); ++it ) {
+		ParticleKernels::splineParticlesVSReference(output, it->input, &spline[0], it->globals, it->view);
+		if( !isClose(output, it->expected) ) {
+			logger->logMessage(L"Test failed: Reference kernel output for the '" + std::wstring(it->name) +
+				L"' case was " + toString(output) + L", not " + toString(it->expected) + L".");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+
+		inputs.assign(n, it->input);
+		if( FAILED(ParticleKernels::splineParticlesVS(&outputs[0], &inputs[0], n, &spline[0], nSlots, it->globals, it->view)) ) {
+			logger->logMessage(L"Test failed: ParticleKernels::splineParticlesVS() returned a failure result.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			continue;
+		}
+		for( size_t i = 0; i < n; ++i ) {
+			if( !isClose(outputs[i], it->expected) ) {
+				logger->logMessage(L"Test failed: Vectorized kernel output " + std::to_wstring(i) + L" for the '" +
+					std::wstring(it->name) + L"' case was " + toString(outputs[i]) +
+					L", not " + toString(it->expected) + L".");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+		}
+	}
+
+	// A buffer smaller than the number of slots given in the constant buffer is rejected
+	if( SUCCEEDED(ParticleKernels::splineParticlesVS(&outputs[0], &inputs[0], n, &spline[0], nSlots - 1, splineGlobals, identity)) ) {
+		logger->logMessage(L"Test failed: A control point buffer with too few slots was accepted.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testParticleKernels::testSplineAgainstReference(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testParticleKernels_testSplineAgainstReference.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	std::default_random_engine generator(3501);
+
+	std::vector<ParticleVertexType> inputs(TESTPARTICLEKERNELS_N_PARTICLES);
+	for( std::vector<ParticleVertexType>::iterator it = inputs.begin(); it != inputs.end(); ++it ) {
+		*it = randomSplineParticle(generator);
+	}
+
+	XMFLOAT4X4 view;
+	XMStoreFloat4x4(&view, XMMatrixLookAtLH(
+		XMVectorSet(-10.0f, 5.0f, -30.0f, 1.0f),
+		XMVectorSet(5.0f, -3.0f, 20.0f, 1.0f),
+		XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)));
+
+	const float speed = 2.0f;
+	BasicSpline spline(TESTPARTICLEKERNELS_SPLINE_CAPACITY, true, &speed, false);
+	RecordingBufferWriter writer(spline.getNumberOfSegmentSlots() * SPLINEUPLOADER_SEGMENT_SIZE);
+	SplineUploader uploader;
+	XMFLOAT3 controlPoints[2];
+	const float times[] = { 0.0f, 1000.0f, 12345.5f, 100000.0f };
+	const size_t nTimes = sizeof(times) / sizeof(float);
+	size_t nMismatches = 0;
+	HRESULT result = ERROR_SUCCESS;
+
+	/* Fill the spline, and keep adding knots to the end, so that the first segment
+	   moves through all of the slots, then remove knots from both ends
+	 */
+	const size_t nSteps = 3 * TESTPARTICLEKERNELS_SPLINE_CAPACITY;
+	for( size_t step = 0; step < nSteps; ++step ) {
+		if( step < 2 * TESTPARTICLEKERNELS_SPLINE_CAPACITY + 2 ) {
+			randomKnot(controlPoints, generator);
+			spline.addToEnd(controlPoints);
+		} else if( step % 2 == 0 ) {
+			spline.removeFromStart();
+		} else {
+			spline.removeFromEnd();
+		}
+
+		for( size_t t = 0; t < nTimes; ++t ) {
+			nMismatches += compareSplineKernels(spline, uploader, writer, inputs, times[t], view, result);
+			if( FAILED(result) ) {
+				logger->logMessage(L"Test failed: Upload or evaluation failed at step " + std::to_wstring(step) + L".");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+				break;
+			}
+		}
+	}
+
+	logger->logMessage(std::to_wstring(nSteps) + L" spline states, " + std::to_wstring(nTimes) + L" times, " +
+		std::to_wstring(inputs.size()) + L" particles:");
+	logger->logMessage(L"Particles differing from the reference: " + std::to_wstring(nMismatches));
+	if( nMismatches != 0 ) {
+		logger->logMessage(L"Test failed: The vectorized kernel, reading from the uploaded buffer, differs from the reference kernel.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testParticleKernels::benchmarkSpline(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testParticleKernels_benchmarkSpline.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	std::default_random_engine generator(3501);
+	const size_t n = TESTPARTICLEKERNELS_N_BENCHMARK_PARTICLES;
+	const size_t nFrames = TESTPARTICLEKERNELS_N_BENCHMARK_FRAMES;
+	std::vector<ParticleVertexType> inputs(n);
+	for( std::vector<ParticleVertexType>::iterator it = inputs.begin(); it != inputs.end(); ++it ) {
+		*it = randomSplineParticle(generator);
+	}
+
+	// A full spline, uploaded as SplineParticles would
+	const float speed = 2.0f;
+	BasicSpline spline(TESTPARTICLEKERNELS_SPLINE_CAPACITY, true, &speed, false);
+	XMFLOAT3 controlPoints[2];
+	for( size_t i = 0; i < TESTPARTICLEKERNELS_SPLINE_CAPACITY + 3; ++i ) {
+		randomKnot(controlPoints, generator);
+		spline.addToEnd(controlPoints);
+	}
+	RecordingBufferWriter writer(spline.getNumberOfSegmentSlots() * SPLINEUPLOADER_SEGMENT_SIZE);
+	SplineUploader uploader;
+	uploader.upload(writer, spline);
+	const XMFLOAT4* const buffer = reinterpret_cast<const XMFLOAT4*>(writer.getContents());
+	const size_t nSlots = spline.getNumberOfSegmentSlots();
+
+	ParticleKernels::SplineGlobals globals;
+	SplineGeometryStandIn geometry(&spline);
+	ParticleKernels::getSplineGlobals(globals, geometry);
+	XMFLOAT4X4 view;
+	XMStoreFloat4x4(&view, XMMatrixLookAtLH(
+		XMVectorSet(0.0f, 0.0f, -30.0f, 1.0f), XMVectorZero(), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)));
+
+	std::vector<ParticleKernels::GeneralOutput> outputs(n);
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+	float checksum = 0.0f;
+
+	// Reference kernel
+	QueryPerformanceCounter(&start);
+	for( size_t frame = 0; frame < nFrames; ++frame ) {
+		globals.general.time = XMFLOAT2(static_cast<float>(frame) * 16.0f, 16.0f);
+		for( size_t i = 0; i < n; ++i ) {
+			ParticleKernels::splineParticlesVSReference(outputs[i], inputs[i], buffer, globals, view);
+		}
+		checksum += outputs[frame].positionVS.x;
+	}
+	QueryPerformanceCounter(&end);
+	const double referenceTime = elapsedMilliseconds(start, end, frequency);
+
+	// Vectorized kernel
+	QueryPerformanceCounter(&start);
+	for( size_t frame = 0; frame < nFrames; ++frame ) {
+		globals.general.time = XMFLOAT2(static_cast<float>(frame) * 16.0f, 16.0f);
+		ParticleKernels::splineParticlesVS(&outputs[0], &inputs[0], n, buffer, nSlots, globals, view);
+		checksum += outputs[frame].positionVS.x;
+	}
+	QueryPerformanceCounter(&end);
+	const double vectorizedTime = elapsedMilliseconds(start, end, frequency);
+
+	const double nProcessed = static_cast<double>(n) * static_cast<double>(nFrames);
+	logger->logMessage(std::to_wstring(n) + L" particles, " + std::to_wstring(nFrames) + L" frames, spline capacity " +
+		std::to_wstring(TESTPARTICLEKERNELS_SPLINE_CAPACITY));
+	logger->logMessage(L"Reference kernel: " + std::to_wstring(nProcessed / (referenceTime / 1000.0)) + L" particles per second");
+	logger->logMessage(L"Vectorized kernel: " + std::to_wstring(nProcessed / (vectorizedTime / 1000.0)) + L" particles per second");
+	logger->logMessage(L"Speedup: " + std::to_wstring(referenceTime / vectorizedTime));
+	logger->logMessage(L"(Checksum: " + std::to_wstring(checksum) + L")");
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
@@ -0,0 +1,516 @@
+/*
+testParticleLOD.cpp
+-------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testBurstVertexGenerator.cpp
+
+Description
+  -Implementations of test functions for the ParticleLOD class
+*/
+
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cfloat>
+#include <random>
+#include <exception>
+#include "testParticleLOD.h"
+#include "ParticleLOD.h"
+#include "BurstVertexGenerator.h"
+#include "Transformable.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+using std::wstring;
+
+// Maximum allowed relative difference from hand-computed values
+#define TESTPARTICLELOD_TOLERANCE 1.0e-4f
+
+// Camera parameters, as in the Camera class
+#define TESTPARTICLELOD_FIELD_OF_VIEW (XM_PI / 4.0f)
+#define TESTPARTICLELOD_ASPECT_RATIO (16.0f / 9.0f)
+#define TESTPARTICLELOD_NEAR 0.1f
+#define TESTPARTICLELOD_FAR 1000.0f
+#define TESTPARTICLELOD_VIEWPORT_HEIGHT 1080.0f
+
+// Scene used to estimate the fill rate
+#define TESTPARTICLELOD_N_SYSTEMS 200
+#define TESTPARTICLELOD_MIN_DISTANCE 60.0f
+#define TESTPARTICLELOD_MAX_DISTANCE 600.0f
+#define TESTPARTICLELOD_SEED 3501
+
+namespace testParticleLOD {
+
+	// Explosion particle system parameters, from 'configFiles/geometry/explosion.txt'
+	static const size_t explosionRows = 30;
+	static const size_t explosionColumns = 30;
+	static const float explosionSpeed = 0.01f;
+	static const float explosionLifespan = 1.0f / 0.0002f;
+	static const XMFLOAT2 explosionBillboard(0.5f, 0.6f);
+
+	// Jet particle system grid, from 'configFiles/geometry/jet.txt'
+	static const size_t jetRows = 20;
+	static const size_t jetColumns = 80;
+
+	/* Bounding radius of an explosion at the given time,
+	   as computed by UniformBurstSphere::getLODRadius()
+	 */
+	static float explosionRadius(const float time) {
+		const float age = (time > explosionLifespan) ? explosionLifespan : time;
+		return 1.0f + explosionSpeed * age + 0.5f * std::sqrt(
+			explosionBillboard.x * explosionBillboard.x + explosionBillboard.y * explosionBillboard.y);
+	}
+
+	static bool isClose(const float a, const float b) {
+		return std::abs(a - b) <= TESTPARTICLELOD_TOLERANCE * (1.0f + std::abs(b));
+	}
+
+	/* Computes the view transformation of a camera with the given position and orientation,
+	   in the same way as Camera::GetViewMatrix()
+	 */
+	static void getView(XMFLOAT4X4& view, XMFLOAT3 position, XMFLOAT4 orientation) {
+		XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+		Transformable camera(scale, position, orientation);
+		camera.update(0, 0);
+		camera.getWorldTransformNoScale(view);
+		XMStoreFloat4x4(&view, XMMatrixInverse(0, XMLoadFloat4x4(&view)));
+	}
+
+	static void getProjection(XMFLOAT4X4& projection) {
+		XMStoreFloat4x4(&projection, XMMatrixPerspectiveFovLH(TESTPARTICLELOD_FIELD_OF_VIEW,
+			TESTPARTICLELOD_ASPECT_RATIO, TESTPARTICLELOD_NEAR, TESTPARTICLELOD_FAR));
+	}
+
+	// World transformation of a particle system with the given position and uniform scaling
+	static void getWorld(XMFLOAT4X4& world, XMFLOAT3 position, const float scaleFactor) {
+		XMFLOAT3 scale(scaleFactor, scaleFactor, scaleFactor);
+		XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+		Transformable transform(scale, position, orientation);
+		transform.update(0, 0);
+		transform.getWorldTransform(world);
+	}
+
+	/* Returns the largest distance, in rows or columns, from any cell
+	   of the grid to the nearest of the first 'n' cells in the given order
+	 */
+	static size_t coveringRadius(const std::vector<size_t>& order, const size_t n, const size_t nColumns) {
+		size_t maxDistance = 0;
+		for( size_t cell = 0; cell < order.size(); ++cell ) {
+			const size_t row = cell / nColumns;
+			const size_t column = cell % nColumns;
+			size_t minDistance = static_cast<size_t>(-1);
+			for( size_t i = 0; i < n; ++i ) {
+				const size_t otherRow = order[i] / nColumns;
+				const size_t otherColumn = order[i] % nColumns;
+				const size_t rowDistance = (row > otherRow) ? (row - otherRow) : (otherRow - row);
+				const size_t columnDistance = (column > otherColumn) ? (column - otherColumn) : (otherColumn - column);
+				const size_t distance = (rowDistance > columnDistance) ? rowDistance : columnDistance;
+				minDistance = (distance < minDistance) ? distance : minDistance;
+			}
+			maxDistance = (minDistance > maxDistance) ? minDistance : maxDistance;
+		}
+		return maxDistance;
+	}
+}
+
+HRESULT testParticleLOD::testSelection(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testParticleLOD_testSelection.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT result = ERROR_SUCCESS;
+	const ParticleLOD::Parameters parameters;
+	const ParticleLOD lod(parameters);
+	const size_t nVertices = explosionRows * explosionColumns;
+	const float radius = 10.0f;
+	const float smallestFraction = std::ldexp(1.0f, 1 - static_cast<int>(parameters.nLevels));
+
+	// Camera at the origin, looking along the positive z-axis
+	XMFLOAT4X4 view, projection, world;
+	getView(view, XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f));
+	getProjection(projection);
+
+	// Projected size at a distance of 30 units
+	getWorld(world, XMFLOAT3(0.0f, 0.0f, 30.0f), 1.0f);
+	float size = ParticleLOD::projectedSize(world, radius, view, projection);
+	const float expectedSize = radius / (std::tan(0.5f * TESTPARTICLELOD_FIELD_OF_VIEW) * 2.0f * 30.0f);
+	if( !isClose(size, expectedSize) ) {
+		logger->logMessage(L"Test failed: Projected size at a distance of 30 was " + std::to_wstring(size) +
+			L", not " + std::to_wstring(expectedSize) + L".");
+		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Selections with increasing distance
+	const float distances[] = { 5.0f, 15.0f, 30.0f, 45.0f, 60.0f, 90.0f, 120.0f, 180.0f, 240.0f, 480.0f, 960.0f };
+	const size_t nDistances = sizeof(distances) / sizeof(float);
+	ParticleLOD::Selection selection, other;
+	size_t previousCount = nVertices;
+	logger->logMessage(L"Distance, projected size, level, particles drawn, billboard size multiplier, transparency multiplier:");
+	for( size_t i = 0; i < nDistances; ++i ) {
+		getWorld(world, XMFLOAT3(0.0f, 0.0f, distances[i]), 1.0f);
+		size = ParticleLOD::projectedSize(world, radius, view, projection);
+		lod.select(selection, size, nVertices);
+		logger->logMessage(std::to_wstring(distances[i]) + L", " + std::to_wstring(size) + L", " +
+			std::to_wstring(selection.level) + L", " + std::to_wstring(selection.nVertices) + L", " +
+			std::to_wstring(selection.compensation.x) + L", " + std::to_wstring(selection.compensation.y));
+
+		if( selection.nVertices > previousCount ) {
+			logger->logMessage(L"Test failed: More particles were drawn at a distance of " +
+				std::to_wstring(distances[i]) + L" than at the previous distance.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		previousCount = selection.nVertices;
+
+		if( (distances[i] <= radius || size >= parameters.fullDetailSize) &&
+			(selection.nVertices != nVertices || selection.compensation.x != 1.0f || selection.compensation.y != 1.0f) ) {
+			logger->logMessage(L"Test failed: Not all particles were drawn, without compensation, at a distance of " +
+				std::to_wstring(distances[i]) + L".");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+
+		// The fraction drawn is never less than that requested, unless it is the smallest fraction
+		float requested = (size / parameters.fullDetailSize) * (size / parameters.fullDetailSize);
+		requested = (requested > 1.0f) ? 1.0f : requested;
+		if( selection.fraction < requested && selection.level != (parameters.nLevels - 1) ) {
+			logger->logMessage(L"Test failed: Too few particles were drawn at a distance of " +
+				std::to_wstring(distances[i]) + L".");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+
+		// The next level would draw less than the fraction requested, unless this is the smallest fraction
+		if( (selection.level + 1) < parameters.nLevels && (0.5f * selection.fraction) >= requested ) {
+			logger->logMessage(L"Test failed: Too many particles were drawn at a distance of " +
+				std::to_wstring(distances[i]) + L".");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+
+		// The direction of the system from the camera does not matter
+		getWorld(world, XMFLOAT3(distances[i] * std::sin(0.3f) * std::cos(0.1f), distances[i] * std::sin(0.1f),
+			distances[i] * std::cos(0.3f) * std::cos(0.1f)), 1.0f);
+		const float otherSize = ParticleLOD::projectedSize(world, radius, view, projection);
+		lod.select(other, otherSize, nVertices);
+		if( !isClose(otherSize, size) || other.level != selection.level ) {
+			logger->logMessage(L"Test failed: The level of detail at a distance of " + std::to_wstring(distances[i]) +
+				L" depends on the direction of the particle system.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	if( previousCount != static_cast<size_t>(std::ceil(smallestFraction * static_cast<float>(nVertices))) ) {
+		logger->logMessage(L"Test failed: The smallest level of detail was not used at the largest distance.");
+		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Rotating the camera does not change the level of detail
+	getWorld(world, XMFLOAT3(0.0f, 0.0f, 120.0f), 1.0f);
+	lod.select(selection, ParticleLOD::projectedSize(world, radius, view, projection), nVertices);
+	XMFLOAT4 orientation;
+	XMStoreFloat4(&orientation, XMQuaternionRotationRollPitchYaw(0.2f, 1.0f, 0.5f));
+	XMFLOAT4X4 rotatedView;
+	getView(rotatedView, XMFLOAT3(0.0f, 0.0f, 0.0f), orientation);
+	size = ParticleLOD::projectedSize(world, radius, rotatedView, projection);
+	lod.select(other, size, nVertices);
+	if( other.nVertices != selection.nVertices ) {
+		logger->logMessage(L"Test failed: Rotating the camera changed the number of particles drawn.");
+		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Scaling the system is equivalent to scaling its radius
+	getWorld(world, XMFLOAT3(0.0f, 0.0f, 120.0f), 2.0f);
+	size = ParticleLOD::projectedSize(world, radius, view, projection);
+	getWorld(world, XMFLOAT3(0.0f, 0.0f, 120.0f), 1.0f);
+	if( !isClose(size, ParticleLOD::projectedSize(world, 2.0f * radius, view, projection)) ) {
+		logger->logMessage(L"Test failed: The world transformation's scaling was not applied to the radius.");
+		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// The camera is inside the system, and the system is behind the camera
+	getWorld(world, XMFLOAT3(3.0f, -4.0f, 5.0f), 1.0f);
+	if( ParticleLOD::projectedSize(world, radius, view, projection) != FLT_MAX ) {
+		logger->logMessage(L"Test failed: A camera inside the bounding sphere did not result in the largest projected size.");
+		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	getWorld(world, XMFLOAT3(0.0f, 0.0f, -100.0f), 1.0f);
+	if( ParticleLOD::projectedSize(world, radius, view, projection) != 0.0f ) {
+		logger->logMessage(L"Test failed: A particle system behind the camera had a non-zero projected size.");
+		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Compensation preserves total opacity, until the transparency multiplier reaches its limit
+	ParticleLOD::Parameters manyLevels;
+	manyLevels.nLevels = 8;
+	const ParticleLOD lodManyLevels(manyLevels);
+	for( size_t level = 0; level < manyLevels.nLevels; ++level ) {
+		lodManyLevels.selectLevel(selection, level, nVertices);
+		const float opacity = selection.fraction * selection.compensation.x * selection.compensation.x * selection.compensation.y;
+		const float expectedAlpha = std::pow(selection.fraction, -manyLevels.alphaCompensation);
+		if( !isClose(selection.compensation.x, std::pow(selection.fraction, -0.5f * manyLevels.sizeCompensation)) ||
+			(expectedAlpha <= manyLevels.maxAlphaScale && !isClose(opacity, 1.0f)) ||
+			(expectedAlpha > manyLevels.maxAlphaScale && selection.compensation.y != manyLevels.maxAlphaScale) ) {
+			logger->logMessage(L"Test failed: Incorrect compensation factors at level " + std::to_wstring(level) + L".");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	// At least one particle is drawn
+	lodManyLevels.selectLevel(selection, manyLevels.nLevels, 3);
+	if( selection.level != (manyLevels.nLevels - 1) || selection.nVertices != 1 ) {
+		logger->logMessage(L"Test failed: Selecting a level beyond the last level did not draw one of three particles.");
+		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Invalid parameters
+	ParticleLOD::Parameters invalid[3];
+	invalid[0].nLevels = 0;
+	invalid[1].fullDetailSize = 0.0f;
+	invalid[2].maxAlphaScale = 0.5f;
+	size_t nThrown = 0;
+	for( size_t i = 0; i < 3; ++i ) {
+		try {
+			ParticleLOD invalidLOD(invalid[i]);
+		} catch( std::exception& ) {
+			++nThrown;
+		}
+	}
+	if( nThrown != 3 ) {
+		logger->logMessage(L"Test failed: ParticleLOD accepted invalid parameters.");
+		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(result) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return result;
+}
+
+HRESULT testParticleLOD::testProgressiveOrder(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testParticleLOD_testProgressiveOrder.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT result = ERROR_SUCCESS;
+	std::vector<size_t> order;
+
+	// The order is a permutation
+	const size_t grids[][2] = { { 1, 1 }, { 1, 7 }, { 7, 1 }, { 32, 16 }, { 37, 53 },
+		{ explosionRows, explosionColumns }, { jetRows, jetColumns } };
+	const size_t nGrids = sizeof(grids) / (2 * sizeof(size_t));
+	for( size_t g = 0; g < nGrids; ++g ) {
+		ParticleLOD::progressiveOrder(order, grids[g][0], grids[g][1]);
+		std::vector<bool> found(grids[g][0] * grids[g][1], false);
+		bool isPermutation = (order.size() == found.size());
+		for( size_t i = 0; isPermutation && i < order.size(); ++i ) {
+			isPermutation = (order[i] < found.size()) && !found[order[i]];
+			found[order[i]] = true;
+		}
+		if( !isPermutation ) {
+			logger->logMessage(L"Test failed: The order of a grid of " + std::to_wstring(grids[g][0]) + L" rows and " +
+				std::to_wstring(grids[g][1]) + L" columns is not a permutation.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	// With power-of-two dimensions, prefixes are exact subgrids
+	const size_t nRows = 32;
+	const size_t nColumns = 16;
+	ParticleLOD::progressiveOrder(order, nRows, nColumns);
+	for( size_t stride = 1; stride <= 8; stride *= 2 ) {
+		const size_t n = (nRows / stride) * (nColumns / stride);
+		bool isSubgrid = true;
+		for( size_t i = 0; i < n; ++i ) {
+			isSubgrid = isSubgrid && ((order[i] / nColumns) % stride == 0) && ((order[i] % nColumns) % stride == 0);
+		}
+		if( !isSubgrid ) {
+			logger->logMessage(L"Test failed: The first " + std::to_wstring(n) +
+				L" cells are not every " + std::to_wstring(stride) + L"th row and column.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	/* The prefixes drawn at each level of detail are spread evenly over the explosion and jet grids:
+	   No cell is further from the particles drawn than the spacing between the columns
+	   of an exact subgrid with the same fraction of cells
+	 */
+	const ParticleLOD::Parameters parameters;
+	const ParticleLOD lod(parameters);
+	ParticleLOD::Selection selection;
+	std::vector<size_t> rowMajor;
+	for( size_t g = nGrids - 2; g < nGrids; ++g ) {
+		const size_t rows = grids[g][0];
+		const size_t columns = grids[g][1];
+		ParticleLOD::progressiveOrder(order, rows, columns);
+		rowMajor.resize(order.size());
+		for( size_t i = 0; i < rowMajor.size(); ++i ) {
+			rowMajor[i] = i;
+		}
+		for( size_t level = 1; level < parameters.nLevels; ++level ) {
+			lod.selectLevel(selection, level, order.size());
+			const size_t radius = coveringRadius(order, selection.nVertices, columns);
+			const size_t rowMajorRadius = coveringRadius(rowMajor, selection.nVertices, columns);
+			const size_t spacing = static_cast<size_t>(1) << ((level + 1) / 2);
+			logger->logMessage(std::to_wstring(rows) + L" x " + std::to_wstring(columns) + L" grid, level " +
+				std::to_wstring(level) + L": Largest distance to a particle drawn = " + std::to_wstring(radius) +
+				L" (" + std::to_wstring(rowMajorRadius) + L" in row-major order).");
+			if( radius > spacing ) {
+				logger->logMessage(L"Test failed: The particles drawn are not spread evenly over the grid.");
+				result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+		}
+	}
+
+	// Reordered sphere vertices are in the order of progressiveOrder(), so prefixes are centred on the origin
+	BurstVertexGenerator generator;
+	BurstVertexGenerator::Parameters sphereParameters;
+	sphereParameters.nColumns = explosionColumns;
+	sphereParameters.nRows = explosionRows;
+	sphereParameters.billboard = XMFLOAT3(explosionBillboard.x, explosionBillboard.y, 0.01f);
+	sphereParameters.linearSpeed = explosionSpeed;
+	sphereParameters.life = XMFLOAT4(0.0f, 1.0f, 1.0f / explosionLifespan, 0.0f);
+	sphereParameters.colorCast = XMFLOAT4(1.0f, 0.9f, 1.0f, 1.0f);
+	sphereParameters.debugColorCasts = true;
+	std::vector<ParticleVertexType> gridOrder(explosionRows * explosionColumns);
+	if( FAILED(generator.sphere(&gridOrder[0], sphereParameters)) ) {
+		logger->logMessage(L"Test failed: BurstVertexGenerator::sphere() returned a failure result.");
+		delete logger;
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	std::vector<ParticleVertexType> vertices(gridOrder);
+	if( FAILED(ParticleLOD::reorder(&vertices[0], explosionRows, explosionColumns)) ) {
+		logger->logMessage(L"Test failed: ParticleLOD::reorder() returned a failure result.");
+		delete logger;
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	ParticleLOD::progressiveOrder(order, explosionRows, explosionColumns);
+	for( size_t i = 0; i < vertices.size(); ++i ) {
+		if( vertices[i].index.x != gridOrder[order[i]].index.x || vertices[i].index.y != gridOrder[order[i]].index.y ) {
+			logger->logMessage(L"Test failed: ParticleLOD::reorder() did not use the order of progressiveOrder().");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+	}
+	for( size_t level = 0; level < parameters.nLevels; ++level ) {
+		lod.selectLevel(selection, level, vertices.size());
+		XMVECTOR centroid = XMVectorZero();
+		for( size_t i = 0; i < selection.nVertices; ++i ) {
+			centroid = XMVectorAdd(centroid, XMLoadFloat3(&vertices[i].position));
+		}
+		const float offset = XMVectorGetX(XMVector3Length(centroid)) / static_cast<float>(selection.nVertices);
+		logger->logMessage(L"Explosion level " + std::to_wstring(level) + L": Distance of the centroid of the particles drawn from the origin = " +
+			std::to_wstring(offset));
+		if( offset > 0.1f ) {
+			logger->logMessage(L"Test failed: The particles drawn are not centred on the origin.");
+			result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	// Invalid input
+	if( SUCCEEDED(ParticleLOD::reorder(0, explosionRows, explosionColumns)) ) {
+		logger->logMessage(L"Test failed: ParticleLOD::reorder() accepted a null vertex array.");
+		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(result) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return result;
+}
+
+HRESULT testParticleLOD::testFillRate(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testParticleLOD_testFillRate.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT result = ERROR_SUCCESS;
+	const ParticleLOD::Parameters parameters;
+	const ParticleLOD lod(parameters);
+	const size_t nVertices = explosionRows * explosionColumns;
+
+	XMFLOAT4X4 view, projection, world;
+	getView(view, XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f));
+	getProjection(projection);
+
+	// Explosions in front of the camera, at random distances and stages of their lives
+	std::default_random_engine generator(TESTPARTICLELOD_SEED);
+	std::uniform_real_distribution<float> distanceDistribution(TESTPARTICLELOD_MIN_DISTANCE, TESTPARTICLELOD_MAX_DISTANCE);
+	std::uniform_real_distribution<float> angleDistribution(-0.3f, 0.3f);
+	std::uniform_real_distribution<float> timeDistribution(0.0f, explosionLifespan);
+
+	double fullParticles = 0.0, lodParticles = 0.0;
+	double fullPixels = 0.0, lodPixels = 0.0, lodOpacity = 0.0;
+	std::vector<size_t> levelCounts(parameters.nLevels, 0);
+	ParticleLOD::Selection full, selection;
+	ParticleLOD::selectFullDetail(full, nVertices);
+	for( size_t i = 0; i < TESTPARTICLELOD_N_SYSTEMS; ++i ) {
+		const float distance = distanceDistribution(generator);
+		const float yaw = angleDistribution(generator);
+		const float pitch = angleDistribution(generator);
+		const float radius = explosionRadius(timeDistribution(generator));
+		getWorld(world, XMFLOAT3(distance * std::sin(yaw) * std::cos(pitch), distance * std::sin(pitch),
+			distance * std::cos(yaw) * std::cos(pitch)), 1.0f);
+		const float size = ParticleLOD::projectedSize(world, radius, view, projection);
+		lod.select(selection, size, nVertices);
+		++levelCounts[selection.level];
+
+		const float pixels = ParticleLOD::estimateFill(selection, size, radius, explosionBillboard, TESTPARTICLELOD_VIEWPORT_HEIGHT);
+		fullParticles += static_cast<double>(nVertices);
+		lodParticles += static_cast<double>(selection.nVertices);
+		fullPixels += ParticleLOD::estimateFill(full, size, radius, explosionBillboard, TESTPARTICLELOD_VIEWPORT_HEIGHT);
+		lodPixels += pixels;
+		lodOpacity += pixels * selection.compensation.y;
+	}
+
+	logger->logMessage(std::to_wstring(TESTPARTICLELOD_N_SYSTEMS) + L" explosions at distances from " +
+		std::to_wstring(TESTPARTICLELOD_MIN_DISTANCE) + L" to " + std::to_wstring(TESTPARTICLELOD_MAX_DISTANCE) +
+		L", with a viewport height of " + std::to_wstring(TESTPARTICLELOD_VIEWPORT_HEIGHT) + L" pixels:");
+	for( size_t level = 0; level < parameters.nLevels; ++level ) {
+		logger->logMessage(L"Systems drawn at level " + std::to_wstring(level) + L": " + std::to_wstring(levelCounts[level]));
+	}
+	logger->logMessage(L"Particles drawn: " + std::to_wstring(lodParticles) + L" of " + std::to_wstring(fullParticles) +
+		L" (" + std::to_wstring(100.0 * lodParticles / fullParticles) + L"%)");
+	logger->logMessage(L"Estimated pixels covered by billboards: " + std::to_wstring(lodPixels) + L" of " + std::to_wstring(fullPixels) +
+		L" (" + std::to_wstring(100.0 * lodPixels / fullPixels) + L"%)");
+	logger->logMessage(L"Estimated opacity-weighted coverage relative to full detail: " +
+		std::to_wstring(100.0 * lodOpacity / fullPixels) + L"%");
+
+	if( lodParticles > fullParticles || lodPixels > fullPixels ) {
+		logger->logMessage(L"Test failed: Level of detail increased the number of particles or pixels drawn.");
+		result = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(result) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return result;
+}
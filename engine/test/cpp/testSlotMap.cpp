@@ -0,0 +1,496 @@
+/*
+testSlotMap.cpp
+---------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testKnot.cpp
+
+Description
+  -Implementations of test functions for the SlotMap class
+*/
+
+#include <string>
+#include <vector>
+#include <random>
+#include <unordered_map>
+#include "testSlotMap.h"
+#include "SlotMap.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using std::wstring;
+
+// Number of slots per chunk in the handle test
+#define TESTSLOTMAP_CHUNK 4
+
+// Number of elements in the handle test
+#define TESTSLOTMAP_N_ELEMENTS 10
+
+// Number of transformations to which particle systems are attached in the churn test
+#define TESTSLOTMAP_N_KEYS 500
+
+// Number of particle systems spawned per frame in the churn test
+#define TESTSLOTMAP_SPAWNS_PER_FRAME 100
+
+// Number of transformations whose particle systems are removed per frame in the churn test
+#define TESTSLOTMAP_KEY_REMOVALS_PER_FRAME 5
+
+// Range of lifespans of particle systems in the churn test, in milliseconds
+#define TESTSLOTMAP_LIFE_MIN 100
+#define TESTSLOTMAP_LIFE_MAX 1000
+
+// Number of frames in the churn test
+#define TESTSLOTMAP_N_FRAMES 1000
+
+// Update time interval, in milliseconds
+#define TESTSLOTMAP_INTERVAL 16
+
+namespace testSlotMap {
+
+	static size_t s_nConstructed = 0;
+	static size_t s_nDestroyed = 0;
+
+	/* Stands in for an active particle system.
+	   Cannot be copied, so it must be constructed in place.
+	 */
+	class TestSystem {
+	public:
+		TestSystem(const void* const key, const size_t id, const DWORD lifespan, const DWORD currentTime, const bool fail = false) :
+			m_key(key), m_id(id), m_lifespan(lifespan), m_startTime(currentTime), m_age(0)
+		{
+			if( fail ) {
+				throw std::exception("TestSystem construction failed as requested.");
+			}
+			++s_nConstructed;
+		}
+
+		~TestSystem(void) {
+			++s_nDestroyed;
+		}
+
+		// Returns true if the system has expired
+		bool update(const DWORD currentTime) {
+			m_age = currentTime - m_startTime;
+			return m_age > m_lifespan;
+		}
+
+		const void* getKey(void) const {
+			return m_key;
+		}
+
+		size_t getId(void) const {
+			return m_id;
+		}
+
+	private:
+		const void* m_key;
+		size_t m_id;
+		DWORD m_lifespan;
+		DWORD m_startTime;
+		DWORD m_age;
+
+		// Currently not implemented - will cause linker errors if called
+	private:
+		TestSystem(const TestSystem& other);
+		TestSystem& operator=(const TestSystem& other);
+	};
+
+	typedef std::unordered_multimap<const void*, SlotMapHandle> Index;
+
+	// Removes the entry for 'handle' under 'key'
+	static void eraseIndexEntry(Index& index, const void* const key, const SlotMapHandle& handle) {
+		const std::pair<Index::iterator, Index::iterator> range = index.equal_range(key);
+		for( Index::iterator it = range.first; it != range.second; ++it ) {
+			if( it->second == handle ) {
+				index.erase(it);
+				return;
+			}
+		}
+	}
+
+	/* Sum of the identifiers of the systems in the container,
+	   for comparing the contents of containers in different orders
+	 */
+	static size_t sumIds(SlotMap<TestSystem>& systems) {
+		size_t sum = 0;
+		for( size_t i = 0; i < systems.size(); ++i ) {
+			sum += systems[i].getId();
+		}
+		return sum;
+	}
+
+	static size_t sumIds(std::vector<TestSystem*>& systems) {
+		size_t sum = 0;
+		for( size_t i = 0; i < systems.size(); ++i ) {
+			sum += systems[i]->getId();
+		}
+		return sum;
+	}
+
+	static double elapsedMilliseconds(const LARGE_INTEGER& start, const LARGE_INTEGER& end, const LARGE_INTEGER& frequency) {
+		return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+}
+
+HRESULT testSlotMap::testHandles(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSlotMap_testHandles.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	const size_t initialConstructed = s_nConstructed;
+	const size_t initialDestroyed = s_nDestroyed;
+	int key = 0;
+
+	{
+		SlotMap<TestSystem> systems(TESTSLOTMAP_CHUNK);
+		if( systems.capacity() != TESTSLOTMAP_CHUNK || !systems.isEmpty() ) {
+			logger->logMessage(L"Test failed: The first chunk was not allocated on construction.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+
+		// Insertion, with growth beyond the first chunk
+		SlotMapHandle handles[TESTSLOTMAP_N_ELEMENTS];
+		TestSystem* pointers[TESTSLOTMAP_N_ELEMENTS];
+		for( size_t i = 0; i < TESTSLOTMAP_N_ELEMENTS; ++i ) {
+			pointers[i] = systems.emplace(handles[i], &key, i, 0, 0);
+		}
+		if( systems.size() != TESTSLOTMAP_N_ELEMENTS ||
+			s_nConstructed - initialConstructed != TESTSLOTMAP_N_ELEMENTS ||
+			systems.capacity() < TESTSLOTMAP_N_ELEMENTS ) {
+			logger->logMessage(L"Test failed: Incorrect size or capacity after insertion.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		for( size_t i = 0; i < TESTSLOTMAP_N_ELEMENTS; ++i ) {
+			if( systems.get(handles[i]) != pointers[i] || pointers[i]->getId() != i ) {
+				logger->logMessage(L"Test failed: Element " + std::to_wstring(i) +
+					L" moved, or its handle is incorrect, after the container grew.");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+		}
+		for( size_t i = 0; i < systems.size(); ++i ) {
+			if( systems.get(systems.getHandle(i)) != &systems[i] ) {
+				logger->logMessage(L"Test failed: Incorrect handle for index " + std::to_wstring(i) + L".");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+		}
+
+		// Removal, and stale handles
+		SlotMapHandle invalid;
+		if( systems.contains(invalid) || systems.get(invalid) != 0 || SUCCEEDED(systems.remove(invalid)) ) {
+			logger->logMessage(L"Test failed: A default-constructed handle was accepted.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		if( FAILED(systems.remove(handles[3])) || SUCCEEDED(systems.remove(handles[3])) ||
+			systems.get(handles[3]) != 0 || systems.size() != TESTSLOTMAP_N_ELEMENTS - 1 ||
+			s_nDestroyed - initialDestroyed != 1 ) {
+			logger->logMessage(L"Test failed: Incorrect removal by handle.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+
+		// The freed slot is reused, but the old handle remains stale
+		SlotMapHandle reused;
+		systems.emplace(reused, &key, TESTSLOTMAP_N_ELEMENTS, 0, 0);
+		if( reused.slot != handles[3].slot || reused == handles[3] ||
+			systems.get(handles[3]) != 0 || systems.get(reused) == 0 ||
+			systems.get(reused)->getId() != TESTSLOTMAP_N_ELEMENTS ) {
+			logger->logMessage(L"Test failed: A stale handle was accepted after its slot was reused.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		for( size_t i = 0; i < TESTSLOTMAP_N_ELEMENTS; ++i ) {
+			if( i != 3 && systems.get(handles[i]) != pointers[i] ) {
+				logger->logMessage(L"Test failed: Element " + std::to_wstring(i) + L" was affected by the removal of another element.");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+		}
+
+		// A failed construction leaves the container unchanged
+		const size_t sizeBeforeFailure = systems.size();
+		const size_t capacityBeforeFailure = systems.capacity();
+		SlotMapHandle failed;
+		bool threw = false;
+		try {
+			systems.emplace(failed, &key, 0, 0, 0, true);
+		} catch( ... ) {
+			threw = true;
+		}
+		SlotMapHandle afterFailure;
+		systems.emplace(afterFailure, &key, TESTSLOTMAP_N_ELEMENTS + 1, 0, 0);
+		if( !threw || systems.contains(failed) || systems.size() != sizeBeforeFailure + 1 ||
+			systems.capacity() != capacityBeforeFailure || systems.get(afterFailure) == 0 ) {
+			logger->logMessage(L"Test failed: A failed construction changed the container.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+
+		// Removal during backward iteration
+		std::vector<size_t> nVisits(TESTSLOTMAP_N_ELEMENTS + 2, 0);
+		size_t n = systems.size();
+		for( size_t i = n - 1; (i >= 0) && (i < n); --i ) {
+			const size_t id = systems[i].getId();
+			++nVisits[id];
+			if( id % 2 == 0 ) {
+				systems.removeAt(i);
+				n = systems.size();
+			}
+		}
+		for( size_t id = 0; id < nVisits.size(); ++id ) {
+			if( id != 3 && nVisits[id] != 1 ) {
+				logger->logMessage(L"Test failed: Element " + std::to_wstring(id) + L" was visited " +
+					std::to_wstring(nVisits[id]) + L" times while removing elements during iteration.");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+		}
+		for( size_t i = 0; i < systems.size(); ++i ) {
+			if( systems[i].getId() % 2 == 0 ||
+				systems.get(systems.getHandle(i)) != &systems[i] ) {
+				logger->logMessage(L"Test failed: Incorrect elements remaining after removal during iteration.");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+				break;
+			}
+		}
+
+		// Clearing keeps the chunks allocated
+		const size_t capacityBeforeClear = systems.capacity();
+		systems.clear();
+		if( !systems.isEmpty() || systems.capacity() != capacityBeforeClear ||
+			s_nConstructed - initialConstructed != s_nDestroyed - initialDestroyed ) {
+			logger->logMessage(L"Test failed: Incorrect state after clearing.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		for( size_t i = 0; i < TESTSLOTMAP_N_ELEMENTS; ++i ) {
+			if( systems.contains(handles[i]) ) {
+				logger->logMessage(L"Test failed: A handle remained valid after clearing.");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+				break;
+			}
+		}
+
+		// Leave some elements for the destructor
+		systems.reserve(3 * TESTSLOTMAP_CHUNK + 1);
+		if( systems.capacity() < 3 * TESTSLOTMAP_CHUNK + 1 ) {
+			logger->logMessage(L"Test failed: Incorrect capacity after reserve().");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		for( size_t i = 0; i < TESTSLOTMAP_N_ELEMENTS; ++i ) {
+			systems.emplace(handles[i], &key, i, 0, 0);
+		}
+	}
+
+	if( s_nConstructed - initialConstructed != s_nDestroyed - initialDestroyed ) {
+		logger->logMessage(L"Test failed: " + std::to_wstring(s_nConstructed - initialConstructed) +
+			L" elements were constructed, but " + std::to_wstring(s_nDestroyed - initialDestroyed) +
+			L" were destroyed.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testSlotMap::testChurn(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSlotMap_testChurn.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	const size_t initialConstructed = s_nConstructed;
+	const size_t initialDestroyed = s_nDestroyed;
+
+	// Stand-ins for the transformations of the particle systems
+	std::vector<int> keys(TESTSLOTMAP_N_KEYS, 0);
+
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+
+	// Contents of the containers after each frame
+	std::vector<size_t> slotMapSizes(TESTSLOTMAP_N_FRAMES, 0);
+	std::vector<size_t> slotMapSums(TESTSLOTMAP_N_FRAMES, 0);
+	std::vector<size_t> vectorSizes(TESTSLOTMAP_N_FRAMES, 0);
+	std::vector<size_t> vectorSums(TESTSLOTMAP_N_FRAMES, 0);
+
+	size_t nSpawned = 0;
+	size_t nRemoved = 0;
+	size_t peakSize = 0;
+	double slotMapTime = 0.0;
+	double vectorTime = 0.0;
+
+	// SlotMap with an index by transformation
+	{
+		std::default_random_engine generator(1);
+		std::uniform_int_distribution<DWORD> lifeDistribution(TESTSLOTMAP_LIFE_MIN, TESTSLOTMAP_LIFE_MAX);
+		std::uniform_int_distribution<size_t> keyDistribution(0, TESTSLOTMAP_N_KEYS - 1);
+
+		SlotMap<TestSystem> systems;
+		Index index;
+		SlotMapHandle handle;
+		DWORD currentTime = 0;
+		size_t id = 0;
+		size_t halfwayCapacity = 0;
+
+		QueryPerformanceCounter(&start);
+		for( size_t frame = 0; frame < TESTSLOTMAP_N_FRAMES; ++frame ) {
+			currentTime += TESTSLOTMAP_INTERVAL;
+
+			for( size_t s = 0; s < TESTSLOTMAP_SPAWNS_PER_FRAME; ++s ) {
+				const void* const key = &keys[keyDistribution(generator)];
+				systems.emplace(handle, key, ++id, lifeDistribution(generator), currentTime);
+				index.insert(std::make_pair(key, handle));
+			}
+			nSpawned += TESTSLOTMAP_SPAWNS_PER_FRAME;
+
+			// As in GameStateWithParticles::removeExplosion()
+			for( size_t r = 0; r < TESTSLOTMAP_KEY_REMOVALS_PER_FRAME; ++r ) {
+				const void* const key = &keys[keyDistribution(generator)];
+				const std::pair<Index::iterator, Index::iterator> range = index.equal_range(key);
+				for( Index::iterator it = range.first; it != range.second; ++it ) {
+					if( SUCCEEDED(systems.remove(it->second)) ) {
+						++nRemoved;
+					}
+				}
+				index.erase(range.first, range.second);
+			}
+
+			// As in GameStateWithParticles::update()
+			size_t n = systems.size();
+			for( size_t i = n - 1; (i >= 0) && (i < n); --i ) {
+				if( systems[i].update(currentTime) ) {
+					eraseIndexEntry(index, systems[i].getKey(), systems.getHandle(i));
+					systems.removeAt(i);
+					n = systems.size();
+					++nRemoved;
+				}
+			}
+
+			peakSize = (systems.size() > peakSize) ? systems.size() : peakSize;
+			slotMapSizes[frame] = systems.size();
+			slotMapSums[frame] = sumIds(systems);
+			if( frame == TESTSLOTMAP_N_FRAMES / 2 ) {
+				halfwayCapacity = systems.capacity();
+			}
+		}
+		QueryPerformanceCounter(&end);
+		slotMapTime = elapsedMilliseconds(start, end, frequency);
+
+		if( systems.capacity() != halfwayCapacity ) {
+			logger->logMessage(L"Test failed: The SlotMap grew from " + std::to_wstring(halfwayCapacity) +
+				L" to " + std::to_wstring(systems.capacity()) +
+				L" slots after the number of systems stabilized.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		if( index.size() != systems.size() ) {
+			logger->logMessage(L"Test failed: The index has " + std::to_wstring(index.size()) +
+				L" entries for " + std::to_wstring(systems.size()) + L" systems.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		logger->logMessage(L"SlotMap capacity: " + std::to_wstring(systems.capacity()) +
+			L" slots, peak size: " + std::to_wstring(peakSize) + L" systems.");
+	}
+
+	// Vector of pointers, as used previously
+	{
+		std::default_random_engine generator(1);
+		std::uniform_int_distribution<DWORD> lifeDistribution(TESTSLOTMAP_LIFE_MIN, TESTSLOTMAP_LIFE_MAX);
+		std::uniform_int_distribution<size_t> keyDistribution(0, TESTSLOTMAP_N_KEYS - 1);
+
+		std::vector<TestSystem*> systems;
+		DWORD currentTime = 0;
+		size_t id = 0;
+
+		QueryPerformanceCounter(&start);
+		for( size_t frame = 0; frame < TESTSLOTMAP_N_FRAMES; ++frame ) {
+			currentTime += TESTSLOTMAP_INTERVAL;
+
+			for( size_t s = 0; s < TESTSLOTMAP_SPAWNS_PER_FRAME; ++s ) {
+				const void* const key = &keys[keyDistribution(generator)];
+				systems.emplace_back(new TestSystem(key, ++id, lifeDistribution(generator), currentTime));
+			}
+
+			for( size_t r = 0; r < TESTSLOTMAP_KEY_REMOVALS_PER_FRAME; ++r ) {
+				const void* const key = &keys[keyDistribution(generator)];
+				std::vector<TestSystem*>::iterator it = systems.begin();
+				while( it != systems.end() ) {
+					if( (*it)->getKey() == key ) {
+						delete *it;
+						it = systems.erase(it);
+					} else {
+						++it;
+					}
+				}
+			}
+
+			size_t n = systems.size();
+			for( size_t i = n - 1; (i >= 0) && (i < n); --i ) {
+				if( systems[i]->update(currentTime) ) {
+					delete systems[i];
+					systems.erase(systems.begin() + i);
+					n = systems.size();
+				}
+			}
+
+			vectorSizes[frame] = systems.size();
+			vectorSums[frame] = sumIds(systems);
+		}
+		QueryPerformanceCounter(&end);
+		vectorTime = elapsedMilliseconds(start, end, frequency);
+
+		for( size_t i = 0; i < systems.size(); ++i ) {
+			delete systems[i];
+		}
+	}
+
+	for( size_t frame = 0; frame < TESTSLOTMAP_N_FRAMES; ++frame ) {
+		if( slotMapSizes[frame] != vectorSizes[frame] || slotMapSums[frame] != vectorSums[frame] ) {
+			logger->logMessage(L"Test failed: The containers hold different systems after frame " +
+				std::to_wstring(frame) + L" (" + std::to_wstring(slotMapSizes[frame]) + L" systems in the SlotMap, and " +
+				std::to_wstring(vectorSizes[frame]) + L" systems in the vector).");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+	}
+
+	if( s_nConstructed - initialConstructed != s_nDestroyed - initialDestroyed ) {
+		logger->logMessage(L"Test failed: " + std::to_wstring(s_nConstructed - initialConstructed) +
+			L" systems were constructed, but " + std::to_wstring(s_nDestroyed - initialDestroyed) +
+			L" were destroyed.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	const double simulatedSeconds = static_cast<double>(TESTSLOTMAP_N_FRAMES * TESTSLOTMAP_INTERVAL) / 1000.0;
+	const double nChurned = static_cast<double>(nSpawned + nRemoved);
+	logger->logMessage(std::to_wstring(nSpawned) + L" systems spawned and " + std::to_wstring(nRemoved) +
+		L" removed over " + std::to_wstring(simulatedSeconds) + L" s of simulated time (" +
+		std::to_wstring(nChurned / simulatedSeconds) + L" spawns and removals per simulated second).");
+	logger->logMessage(L"SlotMap: " + std::to_wstring(slotMapTime) + L" ms in total (" +
+		std::to_wstring(nChurned * 1000.0 / slotMapTime) + L" spawns and removals per second, including updates).");
+	logger->logMessage(L"Vector of pointers: " + std::to_wstring(vectorTime) + L" ms in total (" +
+		std::to_wstring(nChurned * 1000.0 / vectorTime) + L" spawns and removals per second, including updates).");
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
@@ -0,0 +1,603 @@
+/*
+testSpatialIndex.cpp
+--------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testTransformScheduler.cpp
+
+Description
+  -Implementations of test functions for the SpatialIndex class
+*/
+
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include "testSpatialIndex.h"
+#include "SpatialIndex.h"
+#include "Transformable.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+using std::wstring;
+
+// Number of objects in the correctness test
+#define TESTSPATIALINDEX_N_OBJECTS 2000
+
+// Number of queries of each kind per round of the correctness test
+#define TESTSPATIALINDEX_N_QUERIES 200
+
+// Number of nearest objects requested by k-nearest queries
+#define TESTSPATIALINDEX_K 8
+
+// Number of queries of each kind timed for each benchmark configuration
+#define TESTSPATIALINDEX_N_BENCHMARK_QUERIES 10000
+
+// Number of queries of each kind timed for brute force searches
+#define TESTSPATIALINDEX_N_BRUTE_FORCE_QUERIES 100
+
+// Average volume of space per object, in cubic units
+#define TESTSPATIALINDEX_VOLUME_PER_OBJECT 1000.0f
+
+// Range of object radii
+#define TESTSPATIALINDEX_MIN_RADIUS 0.5f
+#define TESTSPATIALINDEX_MAX_RADIUS 3.0f
+
+// Update time interval, in milliseconds
+#define TESTSPATIALINDEX_INTERVAL 16
+
+// Tolerance for comparing distances
+#define TESTSPATIALINDEX_TOLERANCE 1.0e-3f
+
+namespace testSpatialIndex {
+
+	/* Brute force versions of the SpatialIndex queries,
+	   using the same bounding spheres as SpatialIndex
+	 */
+	class BruteForce {
+	public:
+		BruteForce(const std::vector<Transformable*>& transforms) :
+			m_transforms(transforms), m_centers(), m_radii()
+		{
+			XMFLOAT4X4 worldTransform;
+			for( size_t i = 0; i < transforms.size(); ++i ) {
+				transforms[i]->getWorldTransform(worldTransform);
+				m_centers.push_back(XMFLOAT3(worldTransform._41, worldTransform._42, worldTransform._43));
+				m_radii.push_back(transforms[i]->m_radius);
+			}
+		}
+
+		bool rayCast(const XMFLOAT3& origin, const XMFLOAT3& direction, const float maxDistance, float& distance) const {
+			const XMVECTOR o = XMLoadFloat3(&origin);
+			const XMVECTOR d = XMVector3Normalize(XMLoadFloat3(&direction));
+			bool hit = false;
+			distance = maxDistance;
+			for( size_t i = 0; i < m_centers.size(); ++i ) {
+				const XMVECTOR m = XMVectorSubtract(o, XMLoadFloat3(&m_centers[i]));
+				const float c = XMVectorGetX(XMVector3Dot(m, m)) - m_radii[i] * m_radii[i];
+				const float b = XMVectorGetX(XMVector3Dot(m, d));
+				float t = 0.0f;
+				if( c > 0.0f ) {
+					const float discriminant = m_radii[i] * m_radii[i] -
+						XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(m, XMVectorScale(d, b))));
+					if( b > 0.0f || discriminant < 0.0f ) {
+						continue;
+					}
+					t = -b - std::sqrt(discriminant);
+				}
+				if( t <= distance ) {
+					distance = t;
+					hit = true;
+				}
+			}
+			return hit;
+		}
+
+		void sphereOverlap(const XMFLOAT3& center, const float radius, std::vector<const Transformable*>& results) const {
+			results.clear();
+			for( size_t i = 0; i < m_centers.size(); ++i ) {
+				if( distanceTo(center, i) <= radius ) {
+					results.push_back(m_transforms[i]);
+				}
+			}
+		}
+
+		void nearest(const XMFLOAT3& point, const size_t k, std::vector<float>& distances) const {
+			distances.clear();
+			for( size_t i = 0; i < m_centers.size(); ++i ) {
+				distances.push_back(distanceTo(point, i));
+			}
+			const size_t n = (k < distances.size()) ? k : distances.size();
+			std::partial_sort(distances.begin(), distances.begin() + n, distances.end());
+			distances.resize(n);
+		}
+
+	private:
+		float distanceTo(const XMFLOAT3& point, const size_t i) const {
+			const float distance = XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&point), XMLoadFloat3(&m_centers[i])))) - m_radii[i];
+			return (distance > 0.0f) ? distance : 0.0f;
+		}
+
+		const std::vector<Transformable*>& m_transforms;
+		std::vector<XMFLOAT3> m_centers;
+		std::vector<float> m_radii;
+	};
+
+	static XMFLOAT3 randomPoint(const float halfSide, std::default_random_engine& generator) {
+		std::uniform_real_distribution<float> distribution(-halfSide, halfSide);
+		const float x = distribution(generator);
+		const float y = distribution(generator);
+		const float z = distribution(generator);
+		return XMFLOAT3(x, y, z);
+	}
+
+	static Transformable* createObject(const float halfSide, std::default_random_engine& generator) {
+		std::uniform_real_distribution<float> radiusDistribution(TESTSPATIALINDEX_MIN_RADIUS, TESTSPATIALINDEX_MAX_RADIUS);
+		XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+		XMFLOAT3 position = randomPoint(halfSide, generator);
+		XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+		Transformable* transform = new Transformable(scale, position, orientation);
+		transform->m_radius = radiusDistribution(generator);
+		transform->update(0, TESTSPATIALINDEX_INTERVAL);
+		return transform;
+	}
+
+	static void deleteObjects(std::vector<Transformable*>& transforms) {
+		for( std::vector<Transformable*>::size_type i = 0; i < transforms.size(); ++i ) {
+			delete transforms[i];
+		}
+		transforms.clear();
+	}
+
+	/* Moves the object by a random offset with components
+	   in the range [-distance, distance]
+	 */
+	static void moveObject(Transformable* const transform, const float distance,
+		const DWORD currentTime, std::default_random_engine& generator) {
+		XMFLOAT4X4 worldTransform;
+		transform->getWorldTransform(worldTransform);
+		const XMFLOAT3 offset = randomPoint(distance, generator);
+		transform->setPosition(XMFLOAT3(worldTransform._41 + offset.x,
+			worldTransform._42 + offset.y, worldTransform._43 + offset.z));
+		transform->update(currentTime, TESTSPATIALINDEX_INTERVAL);
+	}
+
+	/* Returns the number of queries whose results differ
+	   from those of the brute force searches
+	 */
+	static size_t countMismatches(const SpatialIndex& index, const std::vector<Transformable*>& transforms,
+		const float halfSide, std::default_random_engine& generator) {
+
+		const BruteForce bruteForce(transforms);
+		std::uniform_real_distribution<float> radiusDistribution(0.0f, 0.1f * halfSide);
+		std::uniform_real_distribution<float> distanceDistribution(0.0f, 2.0f * halfSide);
+		size_t nMismatches = 0;
+		SpatialIndex::Result result;
+		std::vector<SpatialIndex::Result> results;
+		std::vector<const Transformable*> expected, actual;
+		std::vector<float> expectedDistances;
+		float expectedDistance = 0.0f;
+
+		for( size_t i = 0; i < TESTSPATIALINDEX_N_QUERIES; ++i ) {
+
+			// Ray cast
+			const XMFLOAT3 origin = randomPoint(1.2f * halfSide, generator);
+			const XMFLOAT3 direction = randomPoint(1.0f, generator);
+			const float maxDistance = distanceDistribution(generator);
+			const bool expectedHit = bruteForce.rayCast(origin, direction, maxDistance, expectedDistance);
+			const bool hit = index.rayCast(origin, direction, maxDistance, result);
+			if( hit != expectedHit || (hit && std::abs(result.distance - expectedDistance) > TESTSPATIALINDEX_TOLERANCE) ) {
+				++nMismatches;
+			}
+
+			// Sphere overlap
+			const XMFLOAT3 center = randomPoint(halfSide, generator);
+			const float radius = radiusDistribution(generator);
+			bruteForce.sphereOverlap(center, radius, expected);
+			index.sphereOverlap(center, radius, results);
+			actual.clear();
+			for( size_t j = 0; j < results.size(); ++j ) {
+				actual.push_back(results[j].transform);
+				if( index.getTransformable(results[j].id) != results[j].transform ) {
+					++nMismatches;
+				}
+			}
+			std::sort(expected.begin(), expected.end());
+			std::sort(actual.begin(), actual.end());
+			if( expected != actual ) {
+				++nMismatches;
+			}
+
+			// k-nearest
+			const XMFLOAT3 point = randomPoint(1.2f * halfSide, generator);
+			bruteForce.nearest(point, TESTSPATIALINDEX_K, expectedDistances);
+			index.nearest(point, TESTSPATIALINDEX_K, results);
+			if( results.size() != expectedDistances.size() ) {
+				++nMismatches;
+			} else {
+				for( size_t j = 0; j < results.size(); ++j ) {
+					if( std::abs(results[j].distance - expectedDistances[j]) > TESTSPATIALINDEX_TOLERANCE ) {
+						++nMismatches;
+						break;
+					}
+				}
+			}
+		}
+		return nMismatches;
+	}
+
+	static double elapsedMilliseconds(const LARGE_INTEGER& start, const LARGE_INTEGER& end, const LARGE_INTEGER& frequency) {
+		return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+}
+
+HRESULT testSpatialIndex::testQueries(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSpatialIndex_testQueries.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	std::default_random_engine generator(3501);
+	const float halfSide = 0.5f * std::pow(TESTSPATIALINDEX_VOLUME_PER_OBJECT * TESTSPATIALINDEX_N_OBJECTS, 1.0f / 3.0f);
+	std::vector<Transformable*> transforms;
+	std::vector<size_t> ids;
+	SpatialIndex index;
+	DWORD currentTime = 0;
+	size_t nReinserted = 0;
+
+	// Invalid input
+	size_t id = 0;
+	bool passed = FAILED(index.add(id, 0)) && FAILED(index.remove(0)) && index.getTransformable(0) == 0;
+	SpatialIndex::Result queryResult;
+	std::vector<SpatialIndex::Result> results;
+	passed = passed && !index.rayCast(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), 1.0f, queryResult);
+	passed = passed && index.nearest(XMFLOAT3(0.0f, 0.0f, 0.0f), 1, results) == 0;
+	passed = passed && SUCCEEDED(index.validate());
+	try {
+		SpatialIndex invalidIndex(-1.0f);
+		passed = false;
+	} catch( ... ) {}
+	if( !passed ) {
+		logger->logMessage(L"Test failed: Incorrect handling of invalid input or of an empty index.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	/* Each round modifies the objects and the index,
+	   then checks the index and compares query results
+	   with those of brute force searches.
+	 */
+	const size_t nRounds = 7;
+	const wchar_t* labels[nRounds] = {
+		L"incremental insertion",
+		L"small movements, then update()",
+		L"large movements, then update()",
+		L"removal of one third of the objects, and insertion of new objects",
+		L"large movements, then refit()",
+		L"rebuild()",
+		L"removal, insertion, and small movements after rebuild(), then update()"
+	};
+	for( size_t round = 0; round < nRounds; ++round ) {
+		currentTime += TESTSPATIALINDEX_INTERVAL;
+		HRESULT result = ERROR_SUCCESS;
+		switch( round ) {
+		case 0:
+			for( size_t i = 0; i < TESTSPATIALINDEX_N_OBJECTS && SUCCEEDED(result); ++i ) {
+				transforms.push_back(createObject(halfSide, generator));
+				result = index.add(id, transforms.back());
+				ids.push_back(id);
+			}
+			break;
+		case 1:
+		case 2:
+			for( size_t i = 0; i < transforms.size(); ++i ) {
+				moveObject(transforms[i], (round == 1) ? 0.5f * SPATIALINDEX_MARGIN_DEFAULT : 10.0f, currentTime, generator);
+			}
+			result = index.update(&nReinserted);
+			logger->logMessage(wstring(labels[round]) + L": " + std::to_wstring(nReinserted) + L" objects reinserted.");
+			if( round == 1 && nReinserted != 0 ) {
+				logger->logMessage(L"Test failed: Objects which did not leave their fat boxes were reinserted.");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+			break;
+		case 3:
+		case 6:
+			for( size_t i = transforms.size(); i > 0; --i ) {
+				if( i % 3 == 0 && SUCCEEDED(result) ) {
+					result = index.remove(ids[i - 1]);
+					delete transforms[i - 1];
+					transforms.erase(transforms.begin() + (i - 1));
+					ids.erase(ids.begin() + (i - 1));
+				}
+			}
+			if( SUCCEEDED(result) ) {
+				result = index.remove(ids.front());
+				if( SUCCEEDED(index.remove(ids.front())) ) {
+					logger->logMessage(L"Test failed: An object was removed twice.");
+					finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+				}
+				if( SUCCEEDED(result) ) {
+					result = index.add(ids.front(), transforms.front());
+				}
+			}
+			for( size_t i = 0; i < TESTSPATIALINDEX_N_OBJECTS / 3 && SUCCEEDED(result); ++i ) {
+				transforms.push_back(createObject(halfSide, generator));
+				result = index.add(id, transforms.back());
+				ids.push_back(id);
+			}
+			if( round == 6 ) {
+				for( size_t i = 0; i < transforms.size(); ++i ) {
+					moveObject(transforms[i], 1.0f, currentTime, generator);
+				}
+				if( SUCCEEDED(result) ) {
+					result = index.update();
+				}
+			}
+			break;
+		case 4:
+			for( size_t i = 0; i < transforms.size(); ++i ) {
+				moveObject(transforms[i], 10.0f, currentTime, generator);
+			}
+			result = index.refit();
+			break;
+		case 5:
+			result = index.rebuild();
+			break;
+		}
+
+		if( FAILED(result) ) {
+			logger->logMessage(wstring(labels[round]) + L": Test failed: A call to a SpatialIndex function failed.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+
+		if( index.getCount() != transforms.size() ) {
+			logger->logMessage(wstring(labels[round]) + L": Test failed: Incorrect object count.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		for( size_t i = 0; i < ids.size(); ++i ) {
+			if( index.getTransformable(ids[i]) != transforms[i] ) {
+				logger->logMessage(wstring(labels[round]) + L": Test failed: Identifiers do not refer to the correct objects.");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+				break;
+			}
+		}
+		if( FAILED(index.validate()) ) {
+			logger->logMessage(wstring(labels[round]) + L": Test failed: The structure of the index is invalid.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		const size_t nMismatches = countMismatches(index, transforms, halfSide, generator);
+		logger->logMessage(wstring(labels[round]) + L": Height " + std::to_wstring(index.getHeight()) +
+			L", cost " + std::to_wstring(index.getCost()) + L", " + std::to_wstring(nMismatches) +
+			L" queries out of " + std::to_wstring(3 * TESTSPATIALINDEX_N_QUERIES) + L" with incorrect results.");
+		if( nMismatches != 0 ) {
+			logger->logMessage(L"Test failed: Query results differ from those of brute force searches.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	// Removing all objects
+	for( size_t i = 0; i < ids.size(); ++i ) {
+		if( FAILED(index.remove(ids[i])) ) {
+			passed = false;
+		}
+	}
+	if( !passed || index.getCount() != 0 || index.getHeight() != 0 || FAILED(index.validate()) ||
+		index.sphereOverlap(XMFLOAT3(0.0f, 0.0f, 0.0f), halfSide, results) != 0 ) {
+		logger->logMessage(L"Test failed: The index is not empty after removing all objects.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	deleteObjects(transforms);
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testSpatialIndex::benchmarkScaling(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSpatialIndex_benchmarkScaling.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+	HRESULT finalResult = ERROR_SUCCESS;
+
+	logger->logMessage(L"Objects, Incremental build (ms), Incremental build cost, Rebuild (ms), Rebuild cost, "
+		L"Update with no movement (ms), Update with 10% of objects moving (ms), Objects reinserted, "
+		L"Update with all objects moving (ms), Objects reinserted, Cost after update, "
+		L"Refit with all objects moving (ms), Cost after refit, "
+		L"Ray cast (us), Sphere overlap (us), Mean overlaps, " +
+		std::to_wstring(TESTSPATIALINDEX_K) + L"-nearest (us), "
+		L"Brute force ray cast (us), Brute force sphere overlap (us), Brute force k-nearest (us)");
+
+	const size_t sizes[] = { 10000, 100000, 1000000 };
+	for( size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s ) {
+		const size_t n = sizes[s];
+		std::default_random_engine generator(3501);
+		const float halfSide = 0.5f * std::pow(TESTSPATIALINDEX_VOLUME_PER_OBJECT * static_cast<float>(n), 1.0f / 3.0f);
+		std::vector<Transformable*> transforms;
+		for( size_t i = 0; i < n; ++i ) {
+			transforms.push_back(createObject(halfSide, generator));
+		}
+		size_t id = 0;
+		size_t nReinserted = 0;
+		size_t nReinsertedAll = 0;
+		double times[8];
+		float costs[4];
+		DWORD currentTime = 0;
+
+		// Construction
+		SpatialIndex incrementalIndex(SPATIALINDEX_MARGIN_DEFAULT, n);
+		QueryPerformanceCounter(&start);
+		for( size_t i = 0; i < n; ++i ) {
+			incrementalIndex.add(id, transforms[i]);
+		}
+		QueryPerformanceCounter(&end);
+		times[0] = elapsedMilliseconds(start, end, frequency);
+		costs[0] = incrementalIndex.getCost();
+		incrementalIndex.clear();
+
+		SpatialIndex index(SPATIALINDEX_MARGIN_DEFAULT, n);
+		for( size_t i = 0; i < n; ++i ) {
+			index.add(id, transforms[i]);
+		}
+		QueryPerformanceCounter(&start);
+		index.rebuild();
+		QueryPerformanceCounter(&end);
+		times[1] = elapsedMilliseconds(start, end, frequency);
+		costs[1] = index.getCost();
+
+		// Maintenance
+		QueryPerformanceCounter(&start);
+		index.update();
+		QueryPerformanceCounter(&end);
+		times[2] = elapsedMilliseconds(start, end, frequency);
+
+		currentTime += TESTSPATIALINDEX_INTERVAL;
+		for( size_t i = 0; i < n; i += 10 ) {
+			moveObject(transforms[i], 1.0f, currentTime, generator);
+		}
+		QueryPerformanceCounter(&start);
+		index.update(&nReinserted);
+		QueryPerformanceCounter(&end);
+		times[3] = elapsedMilliseconds(start, end, frequency);
+
+		currentTime += TESTSPATIALINDEX_INTERVAL;
+		for( size_t i = 0; i < n; ++i ) {
+			moveObject(transforms[i], 1.0f, currentTime, generator);
+		}
+		QueryPerformanceCounter(&start);
+		index.update(&nReinsertedAll);
+		QueryPerformanceCounter(&end);
+		times[4] = elapsedMilliseconds(start, end, frequency);
+		costs[2] = index.getCost();
+
+		currentTime += TESTSPATIALINDEX_INTERVAL;
+		for( size_t i = 0; i < n; ++i ) {
+			moveObject(transforms[i], 1.0f, currentTime, generator);
+		}
+		QueryPerformanceCounter(&start);
+		index.refit();
+		QueryPerformanceCounter(&end);
+		times[5] = elapsedMilliseconds(start, end, frequency);
+		costs[3] = index.getCost();
+
+		if( FAILED(index.validate()) ) {
+			logger->logMessage(L"Benchmark failed: The structure of the index is invalid.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+
+		// Queries, on the rebuilt index
+		index.rebuild();
+		std::vector<XMFLOAT3> origins, directions;
+		for( size_t i = 0; i < TESTSPATIALINDEX_N_BENCHMARK_QUERIES; ++i ) {
+			origins.push_back(randomPoint(halfSide, generator));
+			directions.push_back(randomPoint(1.0f, generator));
+		}
+		const float maxDistance = halfSide;
+		const float overlapRadius = 10.0f;
+		SpatialIndex::Result result;
+		std::vector<SpatialIndex::Result> results;
+		size_t nHits = 0;
+		size_t nOverlaps = 0;
+
+		QueryPerformanceCounter(&start);
+		for( size_t i = 0; i < TESTSPATIALINDEX_N_BENCHMARK_QUERIES; ++i ) {
+			if( index.rayCast(origins[i], directions[i], maxDistance, result) ) {
+				++nHits;
+			}
+		}
+		QueryPerformanceCounter(&end);
+		times[6] = elapsedMilliseconds(start, end, frequency);
+
+		QueryPerformanceCounter(&start);
+		for( size_t i = 0; i < TESTSPATIALINDEX_N_BENCHMARK_QUERIES; ++i ) {
+			nOverlaps += index.sphereOverlap(origins[i], overlapRadius, results);
+		}
+		QueryPerformanceCounter(&end);
+		times[7] = elapsedMilliseconds(start, end, frequency);
+
+		QueryPerformanceCounter(&start);
+		for( size_t i = 0; i < TESTSPATIALINDEX_N_BENCHMARK_QUERIES; ++i ) {
+			index.nearest(origins[i], TESTSPATIALINDEX_K, results);
+		}
+		QueryPerformanceCounter(&end);
+		const double nearestTime = elapsedMilliseconds(start, end, frequency);
+
+		// Brute force queries, for comparison
+		const BruteForce bruteForce(transforms);
+		float distance = 0.0f;
+		std::vector<const Transformable*> bruteForceResults;
+		std::vector<float> distances;
+		double bruteForceTimes[3];
+
+		QueryPerformanceCounter(&start);
+		for( size_t i = 0; i < TESTSPATIALINDEX_N_BRUTE_FORCE_QUERIES; ++i ) {
+			if( bruteForce.rayCast(origins[i], directions[i], maxDistance, distance) ) {
+				++nHits;
+			}
+		}
+		QueryPerformanceCounter(&end);
+		bruteForceTimes[0] = elapsedMilliseconds(start, end, frequency);
+
+		QueryPerformanceCounter(&start);
+		for( size_t i = 0; i < TESTSPATIALINDEX_N_BRUTE_FORCE_QUERIES; ++i ) {
+			bruteForce.sphereOverlap(origins[i], overlapRadius, bruteForceResults);
+			nHits += bruteForceResults.size();
+		}
+		QueryPerformanceCounter(&end);
+		bruteForceTimes[1] = elapsedMilliseconds(start, end, frequency);
+
+		QueryPerformanceCounter(&start);
+		for( size_t i = 0; i < TESTSPATIALINDEX_N_BRUTE_FORCE_QUERIES; ++i ) {
+			bruteForce.nearest(origins[i], TESTSPATIALINDEX_K, distances);
+		}
+		QueryPerformanceCounter(&end);
+		bruteForceTimes[2] = elapsedMilliseconds(start, end, frequency);
+
+		const double perQuery = 1000.0 / TESTSPATIALINDEX_N_BENCHMARK_QUERIES;
+		const double perBruteForceQuery = 1000.0 / TESTSPATIALINDEX_N_BRUTE_FORCE_QUERIES;
+		logger->logMessage(std::to_wstring(n) + L", " +
+			std::to_wstring(times[0]) + L", " + std::to_wstring(costs[0]) + L", " +
+			std::to_wstring(times[1]) + L", " + std::to_wstring(costs[1]) + L", " +
+			std::to_wstring(times[2]) + L", " + std::to_wstring(times[3]) + L", " + std::to_wstring(nReinserted) + L", " +
+			std::to_wstring(times[4]) + L", " + std::to_wstring(nReinsertedAll) + L", " + std::to_wstring(costs[2]) + L", " +
+			std::to_wstring(times[5]) + L", " + std::to_wstring(costs[3]) + L", " +
+			std::to_wstring(times[6] * perQuery) + L", " + std::to_wstring(times[7] * perQuery) + L", " +
+			std::to_wstring(static_cast<double>(nOverlaps) / TESTSPATIALINDEX_N_BENCHMARK_QUERIES) + L", " +
+			std::to_wstring(nearestTime * perQuery) + L", " +
+			std::to_wstring(bruteForceTimes[0] * perBruteForceQuery) + L", " +
+			std::to_wstring(bruteForceTimes[1] * perBruteForceQuery) + L", " +
+			std::to_wstring(bruteForceTimes[2] * perBruteForceQuery) + L" (Checksum: " + std::to_wstring(nHits) + L")");
+
+		index.clear();
+		deleteObjects(transforms);
+	}
+
+	delete logger;
+	return finalResult;
+}
@@ -0,0 +1,1513 @@
+/*
+testSpline.cpp
+--------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testTransformSystem.cpp
+
+Description
+  -Implementations of test functions for the Spline class
+*/
+
+#include <string>
+#include <vector>
+#include <list>
+#include <random>
+#include <cmath>
+#include <cstring>
+#include <cfloat>
+#include "testSpline.h"
+#include "BasicSpline.h"
+#include "StaticKnot.h"
+#include "DynamicKnot.h"
+#include "WanderingLineTransformable.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+using std::wstring;
+using std::list;
+
+// Number of random operations in the correctness test
+#define TESTSPLINE_N_OPERATIONS 5000
+
+// Capacity of the spline in the correctness test
+#define TESTSPLINE_CAPACITY 5
+
+// Number of spline parameter values evaluated after each operation or frame
+#define TESTSPLINE_N_EVAL 16
+
+// Number of segments in each laser spline in the benchmark
+#define TESTSPLINE_LASER_CAPACITY 10
+
+// Number of frames timed in the benchmark
+#define TESTSPLINE_N_FRAMES 50
+
+// Update time interval, in milliseconds
+#define TESTSPLINE_INTERVAL 16
+
+// Number of random splines in the batch evaluation test
+#define TESTSPLINE_N_BATCH_SPLINES 100
+
+// Number of parameter values evaluated per call in the batch evaluation test and benchmark
+#define TESTSPLINE_N_BATCH_EVAL 1000
+
+// Number of repetitions timed in the batch evaluation benchmark
+#define TESTSPLINE_N_BATCH_REPETITIONS 200
+
+/* Maximum position error in the batch evaluation test,
+   in multiples of FLT_EPSILON times the largest control point coordinate.
+   The measured maximum is 7.5: The power basis coefficients evaluated
+   in Horner form by evalBatch() can be several times larger than the control points
+   weighted by eval(), so the results differ by a few units in the last place
+   of the largest coordinate, rather than of each result.
+ */
+#define TESTSPLINE_BATCH_POSITION_TOLERANCE 10.0f
+
+// Maximum error in derivative directions, and relative error in second derivatives
+#define TESTSPLINE_BATCH_DERIVATIVE_TOLERANCE 1.0e-3f
+
+// Number of random operations in the arc length test
+#define TESTSPLINE_N_ARC_LENGTH_OPERATIONS 1000
+
+// Number of chords per segment used to compute brute-force arc lengths
+#define TESTSPLINE_N_CHORDS 2000
+
+// Maximum relative arc length error, and maximum round-trip error
+#define TESTSPLINE_ARC_LENGTH_TOLERANCE 1.0e-4f
+
+// Number of splines in the arc length benchmark
+#define TESTSPLINE_N_ARC_LENGTH_SPLINES 1000
+
+// Number of random operations in the bounding volume test
+#define TESTSPLINE_N_BOUNDS_OPERATIONS 1000
+
+/* Capacity of the spline in the bounding volume test
+   (not a power of two, so that some leaves of the tree are never used)
+ */
+#define TESTSPLINE_BOUNDS_CAPACITY 37
+
+// Number of closest point and ray queries after each operation
+#define TESTSPLINE_N_PROXIMITY_QUERIES 8
+
+// Length of the rays in the bounding volume test and benchmark
+#define TESTSPLINE_RAY_LENGTH 30.0f
+
+// Maximum error in distances, relative to the distance plus one
+#define TESTSPLINE_PROXIMITY_TOLERANCE 1.0e-4f
+
+// Number of samples per segment in the brute-force proximity queries of the benchmark
+#define TESTSPLINE_N_BENCHMARK_SAMPLES 64
+
+namespace testSpline {
+
+	/* The original Spline implementation, which stored knots
+	   in a linked list, for comparison
+	 */
+	class ListSpline {
+	public:
+		ListSpline(const size_t capacity, const float speed) :
+			m_capacity(capacity), m_speed(speed), m_knots()
+		{}
+
+		~ListSpline(void) {
+			for( list<Knot*>::iterator it = m_knots.begin(); it != m_knots.end(); ++it ) {
+				delete *it;
+			}
+		}
+
+		HRESULT update(const DWORD currentTime, const DWORD updateTimeInterval) {
+			for( list<Knot*>::iterator it = m_knots.begin(); it != m_knots.end(); ++it ) {
+				if( FAILED((*it)->update(currentTime, updateTimeInterval)) ) {
+					return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+				}
+			}
+			return ERROR_SUCCESS;
+		}
+
+		HRESULT getControlPoints(XMFLOAT4*& controlPoints) const {
+			if( getNumberOfSegments() > 0 ) {
+				for( list<Knot*>::const_iterator it = m_knots.cbegin(); it != m_knots.cend(); ++it ) {
+					if( FAILED((*it)->getControlPoints(controlPoints)) ) {
+						return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+					}
+				}
+			}
+			size_t n = 4 * (m_capacity - getNumberOfSegments());
+			for( size_t i = 0; i < n; ++i ) {
+				*controlPoints = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
+				++controlPoints;
+			}
+			return ERROR_SUCCESS;
+		}
+
+		size_t getNumberOfSegments(void) const {
+			return (m_knots.size() < 2) ? 0 : (m_knots.size() - 1);
+		}
+
+		HRESULT addToStart(const XMFLOAT3* const controlPoints) {
+			return addKnot(new StaticKnot(Knot::PointSet::START, controlPoints), true);
+		}
+
+		HRESULT addToEnd(const XMFLOAT3* const controlPoints) {
+			return addKnot(new StaticKnot(Knot::PointSet::END, controlPoints), false);
+		}
+
+		HRESULT addToStart(Transformable* const transform, const bool dynamic) {
+			if( dynamic ) {
+				return addKnot(new DynamicKnot(Knot::PointSet::START, transform, false, true, &m_speed), true);
+			}
+			return addKnot(new StaticKnot(Knot::PointSet::START, *transform, true, &m_speed), true);
+		}
+
+		HRESULT addToEnd(Transformable* const transform, const bool dynamic) {
+			if( dynamic ) {
+				return addKnot(new DynamicKnot(Knot::PointSet::END, transform, false, true, &m_speed), false);
+			}
+			return addKnot(new StaticKnot(Knot::PointSet::END, *transform, true, &m_speed), false);
+		}
+
+		HRESULT removeFromStart(void) {
+			if( m_knots.empty() ) {
+				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+			}
+			delete m_knots.front();
+			m_knots.pop_front();
+			if( m_knots.size() > 1 ) {
+				return m_knots.front()->makeHalf(Knot::PointSet::START);
+			} else if( m_knots.size() == 1 ) {
+				return m_knots.front()->makeDouble();
+			}
+			return ERROR_SUCCESS;
+		}
+
+		HRESULT removeFromEnd(void) {
+			if( m_knots.empty() ) {
+				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+			}
+			delete m_knots.back();
+			m_knots.pop_back();
+			if( m_knots.size() > 1 ) {
+				return m_knots.back()->makeHalf(Knot::PointSet::END);
+			} else if( m_knots.size() == 1 ) {
+				return m_knots.back()->makeDouble();
+			}
+			return ERROR_SUCCESS;
+		}
+
+		HRESULT eval(XMFLOAT3* const position, XMFLOAT3* const direction, const float& t) const {
+			size_t segments = getNumberOfSegments();
+			if( segments == 0 ) {
+				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_WRONG_STATE);
+			}
+			float adjustedT = t - floor(t);
+			float segmentT = adjustedT * segments;
+			size_t segmentIndex = static_cast<size_t>(segmentT);
+			segmentT = segmentT - floor(segmentT);
+			list<Knot*>::const_iterator itr = m_knots.cbegin();
+			for( size_t i = 0; i < segmentIndex; ++i ) {
+				++itr;
+			}
+			const Knot* preKnot = *itr;
+			++itr;
+			const Knot* postKnot = *itr;
+
+			XMFLOAT3 temp;
+			preKnot->getP0(temp);
+			XMVECTOR p0 = XMLoadFloat3(&temp);
+			preKnot->getP1(temp);
+			XMVECTOR p1 = XMLoadFloat3(&temp);
+			postKnot->getP2(temp);
+			XMVECTOR p2 = XMLoadFloat3(&temp);
+			postKnot->getP3(temp);
+			XMVECTOR p3 = XMLoadFloat3(&temp);
+
+			float invSegmentT = 1.0f - segmentT;
+			XMVECTOR result =
+				XMVectorAdd(
+					XMVectorAdd(
+						XMVectorScale(p0, pow(invSegmentT, 3.0f)),
+						XMVectorScale(p1, 3.0f*segmentT*pow(invSegmentT, 2.0f))
+					),
+					XMVectorAdd(
+						XMVectorScale(p2, 3.0f*pow(segmentT, 2.0f)*invSegmentT),
+						XMVectorScale(p3, pow(segmentT, 3.0f))
+					)
+				);
+			XMStoreFloat3(position, result);
+			result =
+				XMVectorAdd(
+					XMVectorAdd(
+						XMVectorScale(XMVectorSubtract(p1, p0), 3.0f*pow(invSegmentT, 2.0f)),
+						XMVectorScale(XMVectorSubtract(p2, p1), 6.0f*(invSegmentT)*segmentT)
+					),
+						XMVectorScale(XMVectorSubtract(p3, p2), 3.0f*pow(segmentT, 2.0f))
+				);
+			result = XMVector3Normalize(result);
+			XMStoreFloat3(direction, result);
+			return ERROR_SUCCESS;
+		}
+
+	private:
+		HRESULT addKnot(Knot* const knot, const bool addToStart) {
+			HRESULT result = ERROR_SUCCESS;
+			if( getNumberOfSegments() == m_capacity ) {
+				result = addToStart ? removeFromEnd() : removeFromStart();
+				if( FAILED(result) ) {
+					return result;
+				}
+			}
+			size_t n = m_knots.size();
+			if( n > 1 ) {
+				result = (addToStart ? m_knots.front() : m_knots.back())->makeDouble();
+			} else if( n == 1 ) {
+				result = (addToStart ? m_knots.front() : m_knots.back())->makeHalf(
+					addToStart ? Knot::PointSet::END : Knot::PointSet::START);
+			} else {
+				result = knot->makeDouble();
+			}
+			if( addToStart ) {
+				m_knots.push_front(knot);
+			} else {
+				m_knots.push_back(knot);
+			}
+			return result;
+		}
+
+		size_t m_capacity;
+		float m_speed;
+		list<Knot*> m_knots;
+	};
+
+	static void randomControlPoints(XMFLOAT3* const controlPoints, std::default_random_engine& generator) {
+		std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+		for( size_t i = 0; i < 2; ++i ) {
+			controlPoints[i] = XMFLOAT3(distribution(generator), distribution(generator), distribution(generator));
+		}
+	}
+
+	/* Returns the number of parameter values at which the results
+	   of the two splines differ. The parameter values are
+	   chosen to avoid the end of the last segment, where the
+	   linked-list implementation would access an invalid knot.
+	 */
+	static size_t compareEval(const Spline& spline, const ListSpline& reference) {
+		XMFLOAT3 position, direction, expectedPosition, expectedDirection;
+		size_t nMismatched = 0;
+		float t = 0.0f;
+		for( size_t i = 0; i < TESTSPLINE_N_EVAL; ++i ) {
+			t = (static_cast<float>(i) - 2.0f) / static_cast<float>(TESTSPLINE_N_EVAL - 1) * 0.99f;
+			spline.eval(&position, &direction, t);
+			reference.eval(&expectedPosition, &expectedDirection, t);
+			if( std::memcmp(&position, &expectedPosition, sizeof(XMFLOAT3)) != 0 ||
+				std::memcmp(&direction, &expectedDirection, sizeof(XMFLOAT3)) != 0 ) {
+				++nMismatched;
+			}
+		}
+		return nMismatched;
+	}
+
+	// Creates a spline of static knots with random control points
+	static void randomStaticSpline(BasicSpline& spline, std::default_random_engine& generator) {
+		XMFLOAT3 controlPoints[2];
+		for( size_t k = 0; k <= spline.getNumberOfSegments(true); ++k ) {
+			randomControlPoints(controlPoints, generator);
+			spline.addToEnd(controlPoints);
+		}
+	}
+
+	static float maxAbsDifference(const XMFLOAT3& a, const XMFLOAT3& b) {
+		float result = std::fabs(a.x - b.x);
+		if( std::fabs(a.y - b.y) > result ) {
+			result = std::fabs(a.y - b.y);
+		}
+		if( std::fabs(a.z - b.z) > result ) {
+			result = std::fabs(a.z - b.z);
+		}
+		return result;
+	}
+
+	/* Returns the arc length, from the start of the spline to the parameter value 't'
+	   in the interval [0,1], of a spline with the given control points,
+	   computed by summing the lengths of many chords
+	 */
+	static double bruteForceArcLength(const XMFLOAT4* const controlPoints, const size_t nSegments, const double t) {
+		double length = 0.0;
+		double previous[3];
+		double current[3];
+		double u = 0.0;
+		double v = 0.0;
+		double dx = 0.0;
+		double end = 1.0;
+		const XMFLOAT4* p = 0;
+		for( size_t segment = 0; segment < nSegments; ++segment ) {
+			// Fraction of this segment within the interval [0, t]
+			end = t * nSegments - segment;
+			if( end <= 0.0 ) {
+				break;
+			} else if( end > 1.0 ) {
+				end = 1.0;
+			}
+			p = controlPoints + 4 * segment;
+			previous[0] = p[0].x;
+			previous[1] = p[0].y;
+			previous[2] = p[0].z;
+			for( size_t i = 1; i <= TESTSPLINE_N_CHORDS; ++i ) {
+				u = end * static_cast<double>(i) / TESTSPLINE_N_CHORDS;
+				v = 1.0 - u;
+				current[0] = v*v*v*p[0].x + 3.0*u*v*v*p[1].x + 3.0*u*u*v*p[2].x + u*u*u*p[3].x;
+				current[1] = v*v*v*p[0].y + 3.0*u*v*v*p[1].y + 3.0*u*u*v*p[2].y + u*u*u*p[3].y;
+				current[2] = v*v*v*p[0].z + 3.0*u*v*v*p[1].z + 3.0*u*u*v*p[2].z + u*u*u*p[3].z;
+				dx = 0.0;
+				for( size_t j = 0; j < 3; ++j ) {
+					dx += (current[j] - previous[j]) * (current[j] - previous[j]);
+					previous[j] = current[j];
+				}
+				length += std::sqrt(dx);
+			}
+		}
+		return length;
+	}
+
+	static XMFLOAT3 bezier(const XMFLOAT4* const p, const float u) {
+		const float v = 1.0f - u;
+		const float b0 = v * v * v;
+		const float b1 = 3.0f * u * v * v;
+		const float b2 = 3.0f * u * u * v;
+		const float b3 = u * u * u;
+		return XMFLOAT3(
+			b0 * p[0].x + b1 * p[1].x + b2 * p[2].x + b3 * p[3].x,
+			b0 * p[0].y + b1 * p[1].y + b2 * p[2].y + b3 * p[3].y,
+			b0 * p[0].z + b1 * p[1].z + b2 * p[2].z + b3 * p[3].z);
+	}
+
+	static bool isInBox(const XMFLOAT3& point, const XMFLOAT3& min, const XMFLOAT3& max) {
+		return point.x >= min.x && point.y >= min.y && point.z >= min.z &&
+			point.x <= max.x && point.y <= max.y && point.z <= max.z;
+	}
+
+	/* Returns the squared distance from 'point' to the ray segment
+	   from 'origin' in the unit direction 'direction', with the given length
+	 */
+	static float distanceSquaredToRay(const XMFLOAT3& point, const XMFLOAT3& origin,
+		const XMFLOAT3& direction, const float length) {
+		const XMFLOAT3 w(point.x - origin.x, point.y - origin.y, point.z - origin.z);
+		float s = w.x * direction.x + w.y * direction.y + w.z * direction.z;
+		s = (s < 0.0f) ? 0.0f : ((s > length) ? length : s);
+		const XMFLOAT3 d(w.x - s * direction.x, w.y - s * direction.y, w.z - s * direction.z);
+		return d.x * d.x + d.y * d.y + d.z * d.z;
+	}
+
+	/* Returns the smallest distance from the ray segment to 'nSamples' samples
+	   per segment of a spline with the given control points.
+	   A ray length of zero gives the distance to the point 'origin'.
+	   Outputs half the largest distance between consecutive samples,
+	   which bounds the amount by which the result exceeds the true distance.
+	 */
+	static float bruteForceDistance(float& resolution, const XMFLOAT4* const controlPoints, const size_t nSegments,
+		const size_t nSamples, const XMFLOAT3& origin, const XMFLOAT3& direction, const float length) {
+		float best = FLT_MAX;
+		float spacing = 0.0f;
+		float d = 0.0f;
+		XMFLOAT3 sample, previous;
+		for( size_t segment = 0; segment < nSegments; ++segment ) {
+			for( size_t i = 0; i <= nSamples; ++i ) {
+				sample = bezier(controlPoints + 4 * segment, static_cast<float>(i) / nSamples);
+				d = distanceSquaredToRay(sample, origin, direction, length);
+				best = (d < best) ? d : best;
+				if( i > 0 ) {
+					d = distanceSquaredToRay(sample, previous, previous, 0.0f);
+					spacing = (d > spacing) ? d : spacing;
+				}
+				previous = sample;
+			}
+		}
+		resolution = 0.5f * std::sqrt(spacing);
+		return std::sqrt(best);
+	}
+
+	/* Returns the relative amount by which a computed distance
+	   exceeds the distance found by sampling, or falls short of it
+	   by more than the resolution of the samples
+	 */
+	static float proximityError(const float distance, const float expected, const float resolution) {
+		float error = 0.0f;
+		if( distance > expected ) {
+			error = distance - expected;
+		} else if( distance < expected - resolution ) {
+			error = expected - resolution - distance;
+		}
+		return error / (expected + 1.0f);
+	}
+
+	static XMFLOAT3 randomUnitVector(std::default_random_engine& generator) {
+		std::normal_distribution<float> distribution(0.0f, 1.0f);
+		XMFLOAT3 v(distribution(generator), distribution(generator), distribution(generator));
+		XMStoreFloat3(&v, XMVector3Normalize(XMLoadFloat3(&v)));
+		return v;
+	}
+
+	static double elapsedMilliseconds(const LARGE_INTEGER& start, const LARGE_INTEGER& end, const LARGE_INTEGER& frequency) {
+		return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+}
+
+HRESULT testSpline::testAgainstList(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSpline_testAgainstList.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+
+	const float speed = 2.0f;
+	BasicSpline spline(TESTSPLINE_CAPACITY, true, &speed, false);
+	ListSpline reference(TESTSPLINE_CAPACITY, speed);
+
+	// Moving objects for dynamic knots
+	XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+	XMFLOAT3 position(0.0f, 0.0f, 0.0f);
+	XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+	XMFLOAT4 angularMomentum;
+	XMStoreFloat4(&angularMomentum, XMQuaternionRotationRollPitchYaw(0.01f, 0.02f, 0.03f));
+	std::vector<Transformable*> transforms;
+	for( size_t i = 0; i < 4; ++i ) {
+		position.x = static_cast<float>(i);
+		transforms.push_back(new Transformable(scale, position, orientation));
+		transforms.back()->setLinearVelocity(XMFLOAT3(1.0f, 0.5f, 0.0f), 0.01f * (i + 1));
+		transforms.back()->setAngularMomentum(angularMomentum);
+	}
+
+	std::default_random_engine generator;
+	std::uniform_int_distribution<int> operationDistribution(0, 8);
+	std::uniform_int_distribution<size_t> transformDistribution(0, transforms.size() - 1);
+	XMFLOAT3 controlPoints[2];
+	XMFLOAT4 actualPoints[4 * TESTSPLINE_CAPACITY];
+	XMFLOAT4 expectedPoints[4 * TESTSPLINE_CAPACITY];
+	XMFLOAT4* pointer = 0;
+	Transformable* transform = 0;
+	HRESULT actualResult = ERROR_SUCCESS;
+	HRESULT expectedResult = ERROR_SUCCESS;
+	size_t nMismatchedResults = 0;
+	size_t nMismatchedPoints = 0;
+	size_t nMismatchedEval = 0;
+	DWORD currentTime = 0;
+
+	for( size_t op = 0; op < TESTSPLINE_N_OPERATIONS; ++op ) {
+		transform = transforms[transformDistribution(generator)];
+		switch( operationDistribution(generator) ) {
+		case 0:
+			randomControlPoints(controlPoints, generator);
+			actualResult = spline.addToStart(controlPoints);
+			expectedResult = reference.addToStart(controlPoints);
+			break;
+		case 1:
+			randomControlPoints(controlPoints, generator);
+			actualResult = spline.addToEnd(controlPoints);
+			expectedResult = reference.addToEnd(controlPoints);
+			break;
+		case 2:
+			actualResult = spline.addToStart(transform, true);
+			expectedResult = reference.addToStart(transform, true);
+			break;
+		case 3:
+			actualResult = spline.addToEnd(transform, true);
+			expectedResult = reference.addToEnd(transform, true);
+			break;
+		case 4:
+			actualResult = spline.addToEnd(transform, false);
+			expectedResult = reference.addToEnd(transform, false);
+			break;
+		case 5:
+			actualResult = spline.removeFromStart();
+			expectedResult = reference.removeFromStart();
+			break;
+		case 6:
+			actualResult = spline.removeFromEnd();
+			expectedResult = reference.removeFromEnd();
+			break;
+		default:
+			currentTime += TESTSPLINE_INTERVAL;
+			for( size_t i = 0; i < transforms.size(); ++i ) {
+				transforms[i]->update(currentTime, TESTSPLINE_INTERVAL);
+			}
+			actualResult = spline.update(currentTime, TESTSPLINE_INTERVAL);
+			expectedResult = reference.update(currentTime, TESTSPLINE_INTERVAL);
+			break;
+		}
+
+		if( FAILED(actualResult) != FAILED(expectedResult) ) {
+			++nMismatchedResults;
+		}
+
+		if( spline.getNumberOfSegments() != reference.getNumberOfSegments() ) {
+			logger->logMessage(L"Test failed: Different numbers of segments after operation " + std::to_wstring(op) + L".");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+
+		pointer = actualPoints;
+		spline.getControlPoints(pointer, true);
+		pointer = expectedPoints;
+		reference.getControlPoints(pointer);
+		if( std::memcmp(actualPoints, expectedPoints, sizeof(actualPoints)) != 0 ) {
+			++nMismatchedPoints;
+		}
+
+		if( spline.getNumberOfSegments() > 0 ) {
+			nMismatchedEval += compareEval(spline, reference);
+		}
+	}
+
+	logger->logMessage(std::to_wstring(TESTSPLINE_N_OPERATIONS) + L" operations: " +
+		std::to_wstring(nMismatchedResults) + L" mismatched return values, " +
+		std::to_wstring(nMismatchedPoints) + L" mismatched control point arrays, " +
+		std::to_wstring(nMismatchedEval) + L" mismatched evaluations.");
+	if( nMismatchedResults != 0 || nMismatchedPoints != 0 || nMismatchedEval != 0 ) {
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Evaluation at the very end of the spline must be valid
+	XMFLOAT3 direction;
+	if( spline.getNumberOfSegments() > 0 && FAILED(spline.eval(&position, &direction, 0.99999999f)) ) {
+		logger->logMessage(L"Test failed: Evaluation at the end of the spline failed.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	for( size_t i = 0; i < transforms.size(); ++i ) {
+		delete transforms[i];
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testSpline::benchmarkLasers(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSpline_benchmarkLasers.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	const size_t sizes[] = { 100, 1000, 5000 };
+	const size_t nSizes = sizeof(sizes) / sizeof(size_t);
+	const float speed = 1.0f;
+
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+
+	XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+	XMFLOAT3 startPosition(0.0f, 0.0f, 0.0f);
+	XMFLOAT3 endPosition(0.0f, 0.0f, 20.0f);
+	XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+	Transformable laserStart(scale, startPosition, orientation);
+	Transformable laserEnd(scale, endPosition, orientation);
+	laserEnd.setLinearVelocity(XMFLOAT3(1.0f, 0.0f, 0.0f), 0.005f);
+
+	WanderingLineTransformable::Parameters parameters;
+	parameters.maxRadius = 2.0f;
+	parameters.linearSpeed = 0.001f;
+	parameters.maxRollPitchYaw = XMFLOAT3(0.5f, 0.5f, 0.5f);
+	parameters.rollPitchYawSpeeds = XMFLOAT3(0.001f, 0.001f, 0.001f);
+
+	std::vector<WanderingLineTransformable*> knotTransforms;
+	std::vector<BasicSpline*> splines;
+	std::vector<ListSpline*> references;
+	std::vector<XMFLOAT4> buffer(4 * TESTSPLINE_LASER_CAPACITY);
+	XMFLOAT4* pointer = 0;
+	XMFLOAT3 position, direction;
+	double splineTime = 0.0;
+	double referenceTime = 0.0;
+	double splineChurnTime = 0.0;
+	double referenceChurnTime = 0.0;
+	DWORD currentTime = 0;
+	BasicSpline* spline = 0;
+	ListSpline* reference = 0;
+
+	logger->logMessage(L"Number of lasers, Ring buffer time per frame (ms), Linked list time per frame (ms), Speedup, "
+		L"Ring buffer time per frame with knot churn (ms), Linked list time per frame with knot churn (ms), Speedup");
+
+	for( size_t s = 0; s < nSizes; ++s ) {
+
+		// Each laser is a WanderingLineSpline-like spline of dynamic knots
+		for( size_t i = 0; i < sizes[s]; ++i ) {
+			spline = new BasicSpline(TESTSPLINE_LASER_CAPACITY, true, &speed, false);
+			reference = new ListSpline(TESTSPLINE_LASER_CAPACITY, speed);
+			for( size_t k = 0; k <= TESTSPLINE_LASER_CAPACITY; ++k ) {
+				parameters.t = static_cast<float>(k) / static_cast<float>(TESTSPLINE_LASER_CAPACITY);
+				knotTransforms.push_back(new WanderingLineTransformable(&laserStart, &laserEnd, parameters));
+				spline->addToEnd(knotTransforms.back(), true);
+				reference->addToEnd(knotTransforms.back(), true);
+			}
+			splines.push_back(spline);
+			references.push_back(reference);
+		}
+
+		splineTime = 0.0;
+		referenceTime = 0.0;
+		splineChurnTime = 0.0;
+		referenceChurnTime = 0.0;
+		for( size_t frame = 0; frame < TESTSPLINE_N_FRAMES; ++frame ) {
+			currentTime += TESTSPLINE_INTERVAL;
+			laserEnd.update(currentTime, TESTSPLINE_INTERVAL);
+			for( size_t i = 0; i < knotTransforms.size(); ++i ) {
+				knotTransforms[i]->update(currentTime, TESTSPLINE_INTERVAL);
+			}
+
+			// Per-frame work of a laser: Update knots, upload control points, and sample
+			QueryPerformanceCounter(&start);
+			for( size_t i = 0; i < sizes[s]; ++i ) {
+				splines[i]->update(currentTime, TESTSPLINE_INTERVAL);
+				pointer = &buffer[0];
+				splines[i]->getControlPoints(pointer, true);
+				for( size_t j = 0; j < TESTSPLINE_N_EVAL; ++j ) {
+					splines[i]->eval(&position, &direction, static_cast<float>(j) / TESTSPLINE_N_EVAL);
+				}
+			}
+			QueryPerformanceCounter(&end);
+			splineTime += elapsedMilliseconds(start, end, frequency);
+
+			QueryPerformanceCounter(&start);
+			for( size_t i = 0; i < sizes[s]; ++i ) {
+				references[i]->update(currentTime, TESTSPLINE_INTERVAL);
+				pointer = &buffer[0];
+				references[i]->getControlPoints(pointer);
+				for( size_t j = 0; j < TESTSPLINE_N_EVAL; ++j ) {
+					references[i]->eval(&position, &direction, static_cast<float>(j) / TESTSPLINE_N_EVAL);
+				}
+			}
+			QueryPerformanceCounter(&end);
+			referenceTime += elapsedMilliseconds(start, end, frequency);
+
+			// HomingSpline-like tracking: Replace the last knot, and push out the first
+			QueryPerformanceCounter(&start);
+			for( size_t i = 0; i < sizes[s]; ++i ) {
+				splines[i]->removeFromEnd();
+				splines[i]->addToEnd(&laserEnd, false);
+				splines[i]->addToEnd(&laserEnd, true);
+			}
+			QueryPerformanceCounter(&end);
+			splineChurnTime += elapsedMilliseconds(start, end, frequency);
+
+			QueryPerformanceCounter(&start);
+			for( size_t i = 0; i < sizes[s]; ++i ) {
+				references[i]->removeFromEnd();
+				references[i]->addToEnd(&laserEnd, false);
+				references[i]->addToEnd(&laserEnd, true);
+			}
+			QueryPerformanceCounter(&end);
+			referenceChurnTime += elapsedMilliseconds(start, end, frequency);
+		}
+
+		splineTime /= TESTSPLINE_N_FRAMES;
+		referenceTime /= TESTSPLINE_N_FRAMES;
+		splineChurnTime = splineTime + splineChurnTime / TESTSPLINE_N_FRAMES;
+		referenceChurnTime = referenceTime + referenceChurnTime / TESTSPLINE_N_FRAMES;
+		logger->logMessage(std::to_wstring(sizes[s]) + L", " +
+			std::to_wstring(splineTime) + L", " +
+			std::to_wstring(referenceTime) + L", " +
+			std::to_wstring(referenceTime / splineTime) + L", " +
+			std::to_wstring(splineChurnTime) + L", " +
+			std::to_wstring(referenceChurnTime) + L", " +
+			std::to_wstring(referenceChurnTime / splineChurnTime));
+
+		for( size_t i = 0; i < splines.size(); ++i ) {
+			delete splines[i];
+			delete references[i];
+		}
+		splines.clear();
+		references.clear();
+		for( size_t i = 0; i < knotTransforms.size(); ++i ) {
+			delete knotTransforms[i];
+		}
+		knotTransforms.clear();
+	}
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
+
+HRESULT testSpline::testEvalBatch(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSpline_testEvalBatch.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+
+	const float speed = 1.0f;
+	std::default_random_engine generator;
+	std::uniform_real_distribution<float> tDistribution(-0.5f, 1.5f);
+
+	std::vector<float> t(TESTSPLINE_N_BATCH_EVAL);
+	std::vector<XMFLOAT3> positions(TESTSPLINE_N_BATCH_EVAL);
+	std::vector<XMFLOAT3> firstDerivatives(TESTSPLINE_N_BATCH_EVAL);
+	std::vector<XMFLOAT3> secondDerivatives(TESTSPLINE_N_BATCH_EVAL);
+	XMFLOAT3 position, direction, batchDirection;
+	XMFLOAT3 finitePositions[2];
+	XMFLOAT3 finiteDifferences[2];
+	XMVECTOR expected;
+	XMFLOAT4 controlPoints[4 * TESTSPLINE_LASER_CAPACITY];
+	XMFLOAT4* pointer = 0;
+	float finiteT[2];
+	float midT = 0.0f;
+	float maxCoordinate = 0.0f;
+	float error = 0.0f;
+	float maxPositionError = 0.0f; // In multiples of FLT_EPSILON times 'maxCoordinate'
+	float maxDirectionError = 0.0f;
+	float maxSecondDerivativeError = 0.0f;
+	float h = 0.0f;
+	size_t segmentIndex = 0;
+	size_t nFailedCalls = 0;
+	const float segmentWidth = 1.0f / TESTSPLINE_LASER_CAPACITY;
+
+	for( size_t i = 0; i < TESTSPLINE_N_BATCH_SPLINES; ++i ) {
+		BasicSpline spline(TESTSPLINE_LASER_CAPACITY, true, &speed, false);
+		randomStaticSpline(spline, generator);
+
+		pointer = controlPoints;
+		spline.getControlPoints(pointer);
+		maxCoordinate = 1.0f;
+		for( size_t j = 0; j < 4 * TESTSPLINE_LASER_CAPACITY; ++j ) {
+			maxCoordinate = (std::fabs(controlPoints[j].x) > maxCoordinate) ? std::fabs(controlPoints[j].x) : maxCoordinate;
+			maxCoordinate = (std::fabs(controlPoints[j].y) > maxCoordinate) ? std::fabs(controlPoints[j].y) : maxCoordinate;
+			maxCoordinate = (std::fabs(controlPoints[j].z) > maxCoordinate) ? std::fabs(controlPoints[j].z) : maxCoordinate;
+		}
+
+		// Unsorted parameter values, including values to be wrapped around
+		for( size_t j = 0; j < TESTSPLINE_N_BATCH_EVAL; ++j ) {
+			t[j] = tDistribution(generator);
+		}
+		if( FAILED(spline.evalBatch(&t[0], t.size(), &positions[0], &firstDerivatives[0], &secondDerivatives[0])) ) {
+			++nFailedCalls;
+			continue;
+		}
+
+		for( size_t j = 0; j < TESTSPLINE_N_BATCH_EVAL; ++j ) {
+			if( FAILED(spline.eval(&position, &direction, t[j])) ) {
+				++nFailedCalls;
+				continue;
+			}
+			error = maxAbsDifference(position, positions[j]) / (FLT_EPSILON * maxCoordinate);
+			maxPositionError = (error > maxPositionError) ? error : maxPositionError;
+
+			XMStoreFloat3(&batchDirection, XMVector3Normalize(XMLoadFloat3(&firstDerivatives[j])));
+			error = maxAbsDifference(direction, batchDirection);
+			maxDirectionError = (error > maxDirectionError) ? error : maxDirectionError;
+
+			/* Compare the second derivative with central differences
+			   of the first derivative, where these do not cross segment boundaries
+			 */
+			midT = t[j] - std::floor(t[j]);
+			segmentIndex = static_cast<size_t>(midT / segmentWidth);
+			// Central differences are exact for the quadratic first derivative, apart from rounding
+			h = 0.05f * segmentWidth;
+			if( midT - h < segmentIndex * segmentWidth || midT + h > (segmentIndex + 1) * segmentWidth ) {
+				continue;
+			}
+			finiteT[0] = midT - h;
+			finiteT[1] = midT + h;
+			if( FAILED(spline.evalBatch(finiteT, 2, finitePositions, finiteDifferences)) ) {
+				++nFailedCalls;
+				continue;
+			}
+			expected = XMVectorScale(
+				XMVectorSubtract(XMLoadFloat3(finiteDifferences + 1), XMLoadFloat3(finiteDifferences)),
+				0.5f / h);
+			error = XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&secondDerivatives[j]), expected))) /
+				(XMVectorGetX(XMVector3Length(expected)) + 1.0f);
+			maxSecondDerivativeError = (error > maxSecondDerivativeError) ? error : maxSecondDerivativeError;
+		}
+	}
+
+	logger->logMessage(std::to_wstring(TESTSPLINE_N_BATCH_SPLINES) + L" splines, " +
+		std::to_wstring(TESTSPLINE_N_BATCH_EVAL) + L" parameter values each:");
+	logger->logMessage(L"Maximum position error (multiples of FLT_EPSILON times the largest coordinate): " +
+		std::to_wstring(maxPositionError));
+	logger->logMessage(L"Maximum direction error: " + std::to_wstring(maxDirectionError));
+	logger->logMessage(L"Maximum relative second derivative error: " + std::to_wstring(maxSecondDerivativeError));
+
+	if( nFailedCalls != 0 ) {
+		logger->logMessage(L"Test failed: " + std::to_wstring(nFailedCalls) + L" evaluations failed.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	if( maxPositionError > TESTSPLINE_BATCH_POSITION_TOLERANCE ||
+		maxDirectionError > TESTSPLINE_BATCH_DERIVATIVE_TOLERANCE ||
+		maxSecondDerivativeError > TESTSPLINE_BATCH_DERIVATIVE_TOLERANCE ) {
+		logger->logMessage(L"Test failed: Errors exceed tolerances.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Invalid calls
+	BasicSpline emptySpline(TESTSPLINE_LASER_CAPACITY, true, &speed, false);
+	if( SUCCEEDED(emptySpline.evalBatch(&t[0], t.size(), &positions[0])) ) {
+		logger->logMessage(L"Test failed: Evaluation of a spline with no segments succeeded.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testSpline::benchmarkEvalBatch(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSpline_benchmarkEvalBatch.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	const float speed = 1.0f;
+	std::default_random_engine generator;
+	BasicSpline spline(TESTSPLINE_LASER_CAPACITY, true, &speed, false);
+	randomStaticSpline(spline, generator);
+
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+
+	// Evenly-spaced parameter values, as used when sampling a spline for rendering
+	std::vector<float> t(TESTSPLINE_N_BATCH_EVAL);
+	for( size_t j = 0; j < TESTSPLINE_N_BATCH_EVAL; ++j ) {
+		t[j] = static_cast<float>(j) / static_cast<float>(TESTSPLINE_N_BATCH_EVAL);
+	}
+	std::vector<XMFLOAT3> positions(TESTSPLINE_N_BATCH_EVAL);
+	std::vector<XMFLOAT3> firstDerivatives(TESTSPLINE_N_BATCH_EVAL);
+	std::vector<XMFLOAT3> secondDerivatives(TESTSPLINE_N_BATCH_EVAL);
+	double times[4] = { 0.0, 0.0, 0.0, 0.0 };
+	float checksum = 0.0f;
+
+	for( size_t r = 0; r < TESTSPLINE_N_BATCH_REPETITIONS; ++r ) {
+		QueryPerformanceCounter(&start);
+		for( size_t j = 0; j < TESTSPLINE_N_BATCH_EVAL; ++j ) {
+			spline.eval(&positions[j], &firstDerivatives[j], t[j]);
+		}
+		QueryPerformanceCounter(&end);
+		times[0] += elapsedMilliseconds(start, end, frequency);
+		checksum += positions.back().x;
+
+		QueryPerformanceCounter(&start);
+		spline.evalBatch(&t[0], t.size(), &positions[0]);
+		QueryPerformanceCounter(&end);
+		times[1] += elapsedMilliseconds(start, end, frequency);
+		checksum += positions.back().x;
+
+		QueryPerformanceCounter(&start);
+		spline.evalBatch(&t[0], t.size(), &positions[0], &firstDerivatives[0]);
+		QueryPerformanceCounter(&end);
+		times[2] += elapsedMilliseconds(start, end, frequency);
+		checksum += firstDerivatives.back().x;
+
+		QueryPerformanceCounter(&start);
+		spline.evalBatch(&t[0], t.size(), &positions[0], &firstDerivatives[0], &secondDerivatives[0]);
+		QueryPerformanceCounter(&end);
+		times[3] += elapsedMilliseconds(start, end, frequency);
+		checksum += secondDerivatives.back().x;
+	}
+
+	const double nEvaluations = static_cast<double>(TESTSPLINE_N_BATCH_EVAL) * TESTSPLINE_N_BATCH_REPETITIONS;
+	const wchar_t* labels[4] = {
+		L"eval() with direction",
+		L"evalBatch() positions only",
+		L"evalBatch() with first derivatives",
+		L"evalBatch() with first and second derivatives"
+	};
+	logger->logMessage(L"Method, Total time (ms), Millions of evaluations per second, Speedup over eval()");
+	for( size_t i = 0; i < 4; ++i ) {
+		logger->logMessage(wstring(labels[i]) + L", " +
+			std::to_wstring(times[i]) + L", " +
+			std::to_wstring(nEvaluations / times[i] / 1000.0) + L", " +
+			std::to_wstring(times[0] / times[i]));
+	}
+	logger->logMessage(L"(Checksum: " + std::to_wstring(checksum) + L")");
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
+
+HRESULT testSpline::testArcLength(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSpline_testArcLength.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+
+	const float speed = 2.0f;
+	BasicSpline spline(TESTSPLINE_CAPACITY, true, &speed, false);
+
+	// Moving objects for dynamic knots
+	XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+	XMFLOAT3 position(0.0f, 0.0f, 0.0f);
+	XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+	XMFLOAT4 angularMomentum;
+	XMStoreFloat4(&angularMomentum, XMQuaternionRotationRollPitchYaw(0.01f, 0.02f, 0.03f));
+	std::vector<Transformable*> transforms;
+	for( size_t i = 0; i < 4; ++i ) {
+		position.x = static_cast<float>(i);
+		transforms.push_back(new Transformable(scale, position, orientation));
+		transforms.back()->setLinearVelocity(XMFLOAT3(1.0f, 0.5f, 0.0f), 0.01f * (i + 1));
+		transforms.back()->setAngularMomentum(angularMomentum);
+	}
+
+	std::default_random_engine generator;
+	std::uniform_int_distribution<int> operationDistribution(0, 6);
+	std::uniform_int_distribution<size_t> transformDistribution(0, transforms.size() - 1);
+	XMFLOAT3 controlPoints[2];
+	XMFLOAT4 points[4 * TESTSPLINE_CAPACITY];
+	XMFLOAT4* pointer = 0;
+	Transformable* transform = 0;
+	DWORD currentTime = 0;
+	size_t nSegments = 0;
+	size_t nStaleQueries = 0;
+	float length = 0.0f;
+	float s = 0.0f;
+	float t = 0.0f;
+	float roundTrip = 0.0f;
+	float previousT = 0.0f;
+	double expectedLength = 0.0;
+	double error = 0.0;
+	double maxLengthError = 0.0;
+	double maxPartialLengthError = 0.0;
+	float maxRoundTripError = 0.0f;
+	size_t nNonMonotonic = 0;
+
+	for( size_t op = 0; op < TESTSPLINE_N_ARC_LENGTH_OPERATIONS; ++op ) {
+		transform = transforms[transformDistribution(generator)];
+		switch( operationDistribution(generator) ) {
+		case 0:
+			randomControlPoints(controlPoints, generator);
+			spline.addToStart(controlPoints);
+			break;
+		case 1:
+			randomControlPoints(controlPoints, generator);
+			spline.addToEnd(controlPoints);
+			break;
+		case 2:
+			spline.addToEnd(transform, true);
+			break;
+		case 3:
+			spline.removeFromStart();
+			break;
+		case 4:
+			spline.removeFromEnd();
+			break;
+		default:
+			currentTime += TESTSPLINE_INTERVAL;
+			for( size_t i = 0; i < transforms.size(); ++i ) {
+				transforms[i]->update(currentTime, TESTSPLINE_INTERVAL);
+			}
+			spline.update(currentTime, TESTSPLINE_INTERVAL);
+			break;
+		}
+
+		nSegments = spline.getNumberOfSegments();
+		if( nSegments == 0 ) {
+			if( SUCCEEDED(spline.updateArcLengths()) ) {
+				logger->logMessage(L"Test failed: Arc lengths were computed for a spline with no segments.");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+			continue;
+		}
+		if( !spline.areArcLengthsValid() && SUCCEEDED(spline.getArcLength(length)) ) {
+			++nStaleQueries;
+		}
+		if( FAILED(spline.updateArcLengths()) || FAILED(spline.getArcLength(length)) ) {
+			logger->logMessage(L"Test failed: Arc length computation failed after operation " + std::to_wstring(op) + L".");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+
+		pointer = points;
+		spline.getControlPoints(pointer);
+		expectedLength = bruteForceArcLength(points, nSegments, 1.0);
+		error = std::fabs(length - expectedLength) / (expectedLength + 1.0);
+		maxLengthError = (error > maxLengthError) ? error : maxLengthError;
+
+		previousT = 0.0f;
+		for( size_t i = 1; i < TESTSPLINE_N_EVAL; ++i ) {
+			s = static_cast<float>(i) / TESTSPLINE_N_EVAL;
+			spline.arcLengthToT(t, s);
+			spline.tToArcLength(roundTrip, t);
+			if( std::fabs(roundTrip - s) > maxRoundTripError ) {
+				maxRoundTripError = std::fabs(roundTrip - s);
+			}
+			if( t < previousT ) {
+				++nNonMonotonic;
+			}
+			previousT = t;
+
+			error = std::fabs(s * length - bruteForceArcLength(points, nSegments, t)) / (expectedLength + 1.0);
+			maxPartialLengthError = (error > maxPartialLengthError) ? error : maxPartialLengthError;
+		}
+	}
+
+	logger->logMessage(std::to_wstring(TESTSPLINE_N_ARC_LENGTH_OPERATIONS) + L" operations:");
+	logger->logMessage(L"Maximum relative error in total length: " + std::to_wstring(maxLengthError));
+	logger->logMessage(L"Maximum relative error in partial lengths: " + std::to_wstring(maxPartialLengthError));
+	logger->logMessage(L"Maximum round-trip error: " + std::to_wstring(maxRoundTripError));
+	logger->logMessage(L"Non-monotonic conversions: " + std::to_wstring(nNonMonotonic));
+	logger->logMessage(L"Queries which succeeded with out-of-date tables: " + std::to_wstring(nStaleQueries));
+
+	if( maxLengthError > TESTSPLINE_ARC_LENGTH_TOLERANCE ||
+		maxPartialLengthError > TESTSPLINE_ARC_LENGTH_TOLERANCE ||
+		maxRoundTripError > TESTSPLINE_ARC_LENGTH_TOLERANCE ||
+		nNonMonotonic != 0 || nStaleQueries != 0 ) {
+		logger->logMessage(L"Test failed.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	for( size_t i = 0; i < transforms.size(); ++i ) {
+		delete transforms[i];
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testSpline::benchmarkArcLength(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSpline_benchmarkArcLength.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	const float speed = 1.0f;
+	std::default_random_engine generator;
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+
+	std::vector<BasicSpline*> splines;
+	for( size_t i = 0; i < TESTSPLINE_N_ARC_LENGTH_SPLINES; ++i ) {
+		splines.push_back(new BasicSpline(TESTSPLINE_LASER_CAPACITY, true, &speed, false));
+		randomStaticSpline(*splines.back(), generator);
+	}
+
+	// Building all tables
+	QueryPerformanceCounter(&start);
+	for( size_t i = 0; i < splines.size(); ++i ) {
+		splines[i]->updateArcLengths();
+	}
+	QueryPerformanceCounter(&end);
+	double fullTime = elapsedMilliseconds(start, end, frequency);
+
+	// HomingSpline-like tracking: Replace the last knot, and push out the first
+	XMFLOAT3 controlPoints[2];
+	double incrementalTime = 0.0;
+	for( size_t frame = 0; frame < TESTSPLINE_N_FRAMES; ++frame ) {
+		for( size_t i = 0; i < splines.size(); ++i ) {
+			randomControlPoints(controlPoints, generator);
+			splines[i]->addToEnd(controlPoints);
+		}
+		QueryPerformanceCounter(&start);
+		for( size_t i = 0; i < splines.size(); ++i ) {
+			splines[i]->updateArcLengths();
+		}
+		QueryPerformanceCounter(&end);
+		incrementalTime += elapsedMilliseconds(start, end, frequency);
+	}
+	incrementalTime /= TESTSPLINE_N_FRAMES;
+
+	// Conversions
+	const size_t nQueries = splines.size() * TESTSPLINE_N_BATCH_EVAL;
+	float t = 0.0f;
+	float s = 0.0f;
+	float checksum = 0.0f;
+	QueryPerformanceCounter(&start);
+	for( size_t i = 0; i < splines.size(); ++i ) {
+		for( size_t j = 0; j < TESTSPLINE_N_BATCH_EVAL; ++j ) {
+			splines[i]->arcLengthToT(t, static_cast<float>(j) / TESTSPLINE_N_BATCH_EVAL);
+			checksum += t;
+		}
+	}
+	QueryPerformanceCounter(&end);
+	double inverseTime = elapsedMilliseconds(start, end, frequency);
+
+	QueryPerformanceCounter(&start);
+	for( size_t i = 0; i < splines.size(); ++i ) {
+		for( size_t j = 0; j < TESTSPLINE_N_BATCH_EVAL; ++j ) {
+			splines[i]->tToArcLength(s, static_cast<float>(j) / TESTSPLINE_N_BATCH_EVAL);
+			checksum += s;
+		}
+	}
+	QueryPerformanceCounter(&end);
+	double forwardTime = elapsedMilliseconds(start, end, frequency);
+
+	logger->logMessage(std::to_wstring(TESTSPLINE_N_ARC_LENGTH_SPLINES) + L" splines of " +
+		std::to_wstring(TESTSPLINE_LASER_CAPACITY) + L" segments:");
+	logger->logMessage(L"Building all tables (ms): " + std::to_wstring(fullTime));
+	logger->logMessage(L"Updating tables after adding one knot to each spline (ms): " + std::to_wstring(incrementalTime));
+	logger->logMessage(L"arcLengthToT() time per call (ns): " + std::to_wstring(inverseTime * 1.0e6 / nQueries));
+	logger->logMessage(L"tToArcLength() time per call (ns): " + std::to_wstring(forwardTime * 1.0e6 / nQueries));
+	logger->logMessage(L"(Checksum: " + std::to_wstring(checksum) + L")");
+
+	for( size_t i = 0; i < splines.size(); ++i ) {
+		delete splines[i];
+	}
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
+
+HRESULT testSpline::testBounds(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSpline_testBounds.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+
+	const float speed = 2.0f;
+	BasicSpline spline(TESTSPLINE_BOUNDS_CAPACITY, true, &speed, false);
+
+	// Moving objects for dynamic knots
+	XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+	XMFLOAT3 position(0.0f, 0.0f, 0.0f);
+	XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+	XMFLOAT4 angularMomentum;
+	XMStoreFloat4(&angularMomentum, XMQuaternionRotationRollPitchYaw(0.01f, 0.02f, 0.03f));
+	std::vector<Transformable*> transforms;
+	for( size_t i = 0; i < 4; ++i ) {
+		position.x = static_cast<float>(i);
+		transforms.push_back(new Transformable(scale, position, orientation));
+		transforms.back()->setLinearVelocity(XMFLOAT3(1.0f, 0.5f, 0.0f), 0.01f * (i + 1));
+		transforms.back()->setAngularMomentum(angularMomentum);
+	}
+
+	std::default_random_engine generator(3501);
+	// Additions are more likely than removals, so that the spline fills up
+	std::uniform_int_distribution<int> operationDistribution(0, 7);
+	std::uniform_int_distribution<size_t> transformDistribution(0, transforms.size() - 1);
+	std::uniform_real_distribution<float> pointDistribution(-15.0f, 15.0f);
+	XMFLOAT3 controlPoints[2];
+	XMFLOAT4 points[4 * TESTSPLINE_BOUNDS_CAPACITY];
+	XMFLOAT4* pointer = 0;
+	Transformable* transform = 0;
+	DWORD currentTime = 0;
+	size_t nSegments = 0;
+	size_t nStaleQueries = 0;
+	size_t nUnbounded = 0;
+	size_t nInexactBounds = 0;
+	size_t nInconsistent = 0;
+	size_t nInvalidAccepted = 0;
+	XMFLOAT3 min, max, segmentMin, segmentMax, expectedMin, expectedMax;
+	XMFLOAT3 sample, point, direction, closest, evaluated, evaluatedDirection;
+	float t = 0.0f;
+	float distance = 0.0f;
+	float rayDistance = 0.0f;
+	float expected = 0.0f;
+	float resolution = 0.0f;
+	float error = 0.0f;
+	float maxPointError = 0.0f;
+	float maxRayError = 0.0f;
+
+	for( size_t op = 0; op < TESTSPLINE_N_BOUNDS_OPERATIONS; ++op ) {
+		transform = transforms[transformDistribution(generator)];
+		switch( operationDistribution(generator) ) {
+		case 0:
+		case 1:
+			randomControlPoints(controlPoints, generator);
+			spline.addToStart(controlPoints);
+			break;
+		case 2:
+		case 3:
+			randomControlPoints(controlPoints, generator);
+			spline.addToEnd(controlPoints);
+			break;
+		case 4:
+			spline.addToEnd(transform, true);
+			break;
+		case 5:
+			spline.removeFromStart();
+			break;
+		case 6:
+			spline.removeFromEnd();
+			break;
+		default:
+			currentTime += TESTSPLINE_INTERVAL;
+			for( size_t i = 0; i < transforms.size(); ++i ) {
+				transforms[i]->update(currentTime, TESTSPLINE_INTERVAL);
+			}
+			spline.update(currentTime, TESTSPLINE_INTERVAL);
+			break;
+		}
+
+		nSegments = spline.getNumberOfSegments();
+		if( nSegments == 0 ) {
+			if( SUCCEEDED(spline.updateBounds()) ) {
+				logger->logMessage(L"Test failed: Bounds were computed for a spline with no segments.");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+			continue;
+		}
+		if( !spline.areBoundsValid() && SUCCEEDED(spline.getBounds(min, max)) ) {
+			++nStaleQueries;
+		}
+		if( FAILED(spline.updateBounds()) || FAILED(spline.getBounds(min, max)) ) {
+			logger->logMessage(L"Test failed: Bounds computation failed after operation " + std::to_wstring(op) + L".");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+		pointer = points;
+		spline.getControlPoints(pointer);
+
+		/* The box of the spline should be exactly the box of the control points,
+		   and each segment should be within its box
+		 */
+		expectedMin = XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX);
+		expectedMax = XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		for( size_t i = 0; i < 4 * nSegments; ++i ) {
+			XMStoreFloat3(&expectedMin, XMVectorMin(XMLoadFloat3(&expectedMin), XMLoadFloat4(points + i)));
+			XMStoreFloat3(&expectedMax, XMVectorMax(XMLoadFloat3(&expectedMax), XMLoadFloat4(points + i)));
+		}
+		if( std::memcmp(&min, &expectedMin, sizeof(XMFLOAT3)) != 0 ||
+			std::memcmp(&max, &expectedMax, sizeof(XMFLOAT3)) != 0 ) {
+			++nInexactBounds;
+		}
+		for( size_t segment = 0; segment < nSegments; ++segment ) {
+			spline.getSegmentBounds(segmentMin, segmentMax, segment);
+			for( size_t i = 0; i <= TESTSPLINE_N_EVAL; ++i ) {
+				sample = bezier(points + 4 * segment, static_cast<float>(i) / TESTSPLINE_N_EVAL);
+				if( !isInBox(sample, segmentMin, segmentMax) || !isInBox(sample, min, max) ) {
+					++nUnbounded;
+				}
+			}
+		}
+
+		// Invalid rays
+		if( SUCCEEDED(spline.closestPointToRay(t, rayDistance, distance, point, XMFLOAT3(0.0f, 0.0f, 0.0f), TESTSPLINE_RAY_LENGTH)) ||
+			SUCCEEDED(spline.closestPointToRay(t, rayDistance, distance, point, XMFLOAT3(1.0f, 0.0f, 0.0f), 0.0f)) ) {
+			++nInvalidAccepted;
+		}
+
+		for( size_t i = 0; i < TESTSPLINE_N_PROXIMITY_QUERIES; ++i ) {
+			point = XMFLOAT3(pointDistribution(generator), pointDistribution(generator), pointDistribution(generator));
+
+			// Closest point
+			spline.closestPoint(t, closest, distance, point);
+			expected = bruteForceDistance(resolution, points, nSegments, TESTSPLINE_N_CHORDS, point, point, 0.0f);
+			error = proximityError(distance, expected, resolution);
+			maxPointError = (error > maxPointError) ? error : maxPointError;
+			spline.eval(&evaluated, &evaluatedDirection, (t < 1.0f) ? t : (1.0f - FLT_EPSILON));
+			if( maxAbsDifference(evaluated, closest) > TESTSPLINE_PROXIMITY_TOLERANCE * (1.0f + std::fabs(closest.x) + std::fabs(closest.y) + std::fabs(closest.z)) ||
+				std::fabs(std::sqrt(distanceSquaredToRay(closest, point, point, 0.0f)) - distance) > TESTSPLINE_PROXIMITY_TOLERANCE * (distance + 1.0f) ) {
+				++nInconsistent;
+			}
+
+			// Ray distance
+			direction = randomUnitVector(generator);
+			spline.closestPointToRay(t, rayDistance, distance, point, direction, TESTSPLINE_RAY_LENGTH);
+			expected = bruteForceDistance(resolution, points, nSegments, TESTSPLINE_N_CHORDS, point, direction, TESTSPLINE_RAY_LENGTH);
+			error = proximityError(distance, expected, resolution);
+			maxRayError = (error > maxRayError) ? error : maxRayError;
+			spline.eval(&evaluated, &evaluatedDirection, (t < 1.0f) ? t : (1.0f - FLT_EPSILON));
+			closest = XMFLOAT3(point.x + rayDistance * direction.x, point.y + rayDistance * direction.y, point.z + rayDistance * direction.z);
+			if( rayDistance < 0.0f || rayDistance > TESTSPLINE_RAY_LENGTH ||
+				std::fabs(std::sqrt(distanceSquaredToRay(evaluated, closest, direction, 0.0f)) - distance) > TESTSPLINE_PROXIMITY_TOLERANCE * (distance + 10.0f) ) {
+				++nInconsistent;
+			}
+		}
+	}
+
+	logger->logMessage(std::to_wstring(TESTSPLINE_N_BOUNDS_OPERATIONS) + L" operations:");
+	logger->logMessage(L"Samples outside their bounding boxes: " + std::to_wstring(nUnbounded));
+	logger->logMessage(L"Spline boxes differing from the box of the control points: " + std::to_wstring(nInexactBounds));
+	logger->logMessage(L"Maximum relative error in closest point distances: " + std::to_wstring(maxPointError));
+	logger->logMessage(L"Maximum relative error in ray distances: " + std::to_wstring(maxRayError));
+	logger->logMessage(L"Results inconsistent with eval(): " + std::to_wstring(nInconsistent));
+	logger->logMessage(L"Queries which succeeded with out-of-date bounds: " + std::to_wstring(nStaleQueries));
+	logger->logMessage(L"Ray queries which succeeded with invalid rays: " + std::to_wstring(nInvalidAccepted));
+
+	if( nUnbounded != 0 || nInexactBounds != 0 || nInvalidAccepted != 0 ||
+		maxPointError > TESTSPLINE_PROXIMITY_TOLERANCE ||
+		maxRayError > TESTSPLINE_PROXIMITY_TOLERANCE ||
+		nInconsistent != 0 || nStaleQueries != 0 ) {
+		logger->logMessage(L"Test failed.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	for( size_t i = 0; i < transforms.size(); ++i ) {
+		delete transforms[i];
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testSpline::benchmarkBounds(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSpline_benchmarkBounds.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	const float speed = 1.0f;
+	std::default_random_engine generator(3501);
+	std::uniform_real_distribution<float> pointDistribution(-15.0f, 15.0f);
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+
+	std::vector<BasicSpline*> splines;
+	for( size_t i = 0; i < TESTSPLINE_N_ARC_LENGTH_SPLINES; ++i ) {
+		splines.push_back(new BasicSpline(TESTSPLINE_LASER_CAPACITY, true, &speed, false));
+		randomStaticSpline(*splines.back(), generator);
+	}
+
+	// Building all boxes
+	QueryPerformanceCounter(&start);
+	for( size_t i = 0; i < splines.size(); ++i ) {
+		splines[i]->updateBounds();
+	}
+	QueryPerformanceCounter(&end);
+	double fullTime = elapsedMilliseconds(start, end, frequency);
+
+	// HomingSpline-like tracking: Add a knot to the end, and push out the first
+	XMFLOAT3 controlPoints[2];
+	double incrementalTime = 0.0;
+	for( size_t frame = 0; frame < TESTSPLINE_N_FRAMES; ++frame ) {
+		for( size_t i = 0; i < splines.size(); ++i ) {
+			randomControlPoints(controlPoints, generator);
+			splines[i]->addToEnd(controlPoints);
+		}
+		QueryPerformanceCounter(&start);
+		for( size_t i = 0; i < splines.size(); ++i ) {
+			splines[i]->updateBounds();
+		}
+		QueryPerformanceCounter(&end);
+		incrementalTime += elapsedMilliseconds(start, end, frequency);
+	}
+	incrementalTime /= TESTSPLINE_N_FRAMES;
+
+	// Queries from random points, along random directions
+	const size_t nQueries = splines.size() * TESTSPLINE_N_EVAL;
+	std::vector<XMFLOAT3> origins(nQueries);
+	std::vector<XMFLOAT3> directions(nQueries);
+	for( size_t i = 0; i < nQueries; ++i ) {
+		origins[i] = XMFLOAT3(pointDistribution(generator), pointDistribution(generator), pointDistribution(generator));
+		directions[i] = randomUnitVector(generator);
+	}
+	XMFLOAT4 points[4 * TESTSPLINE_LASER_CAPACITY];
+	XMFLOAT4* pointer = 0;
+	XMFLOAT3 position;
+	float t = 0.0f;
+	float rayDistance = 0.0f;
+	float distance = 0.0f;
+	float resolution = 0.0f;
+	float checksum = 0.0f;
+
+	QueryPerformanceCounter(&start);
+	for( size_t i = 0; i < nQueries; ++i ) {
+		splines[i / TESTSPLINE_N_EVAL]->closestPoint(t, position, distance, origins[i]);
+		checksum += distance;
+	}
+	QueryPerformanceCounter(&end);
+	double pointTime = elapsedMilliseconds(start, end, frequency);
+
+	QueryPerformanceCounter(&start);
+	for( size_t i = 0; i < nQueries; ++i ) {
+		splines[i / TESTSPLINE_N_EVAL]->closestPointToRay(t, rayDistance, distance,
+			origins[i], directions[i], TESTSPLINE_RAY_LENGTH);
+		checksum += distance;
+	}
+	QueryPerformanceCounter(&end);
+	double rayTime = elapsedMilliseconds(start, end, frequency);
+
+	QueryPerformanceCounter(&start);
+	for( size_t i = 0; i < nQueries; ++i ) {
+		pointer = points;
+		splines[i / TESTSPLINE_N_EVAL]->getControlPoints(pointer);
+		checksum += bruteForceDistance(resolution, points, TESTSPLINE_LASER_CAPACITY, TESTSPLINE_N_BENCHMARK_SAMPLES,
+			origins[i], origins[i], 0.0f);
+	}
+	QueryPerformanceCounter(&end);
+	double bruteForcePointTime = elapsedMilliseconds(start, end, frequency);
+
+	QueryPerformanceCounter(&start);
+	for( size_t i = 0; i < nQueries; ++i ) {
+		pointer = points;
+		splines[i / TESTSPLINE_N_EVAL]->getControlPoints(pointer);
+		checksum += bruteForceDistance(resolution, points, TESTSPLINE_LASER_CAPACITY, TESTSPLINE_N_BENCHMARK_SAMPLES,
+			origins[i], directions[i], TESTSPLINE_RAY_LENGTH);
+	}
+	QueryPerformanceCounter(&end);
+	double bruteForceRayTime = elapsedMilliseconds(start, end, frequency);
+
+	logger->logMessage(std::to_wstring(TESTSPLINE_N_ARC_LENGTH_SPLINES) + L" splines of " +
+		std::to_wstring(TESTSPLINE_LASER_CAPACITY) + L" segments:");
+	logger->logMessage(L"Building all boxes (ms): " + std::to_wstring(fullTime));
+	logger->logMessage(L"Updating boxes after adding one knot to each spline (ms): " + std::to_wstring(incrementalTime));
+	logger->logMessage(L"closestPoint() time per call (ns): " + std::to_wstring(pointTime * 1.0e6 / nQueries));
+	logger->logMessage(L"closestPointToRay() time per call (ns): " + std::to_wstring(rayTime * 1.0e6 / nQueries));
+	logger->logMessage(L"Brute-force closest point time per call, with " + std::to_wstring(TESTSPLINE_N_BENCHMARK_SAMPLES) +
+		L" samples per segment (ns): " + std::to_wstring(bruteForcePointTime * 1.0e6 / nQueries));
+	logger->logMessage(L"Brute-force ray distance time per call, with " + std::to_wstring(TESTSPLINE_N_BENCHMARK_SAMPLES) +
+		L" samples per segment (ns): " + std::to_wstring(bruteForceRayTime * 1.0e6 / nQueries));
+	logger->logMessage(L"(Checksum: " + std::to_wstring(checksum) + L")");
+
+	for( size_t i = 0; i < splines.size(); ++i ) {
+		delete splines[i];
+	}
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
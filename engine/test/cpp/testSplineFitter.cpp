@@ -0,0 +1,492 @@
+/*
+testSplineFitter.cpp
+--------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testSweepAndPrune.cpp
+
+Description
+  -Implementations of test functions for the SplineFitter class
+*/
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+#include "testSplineFitter.h"
+#include "SplineFitter.h"
+#include "HomingSpline.h"
+#include "Transformable.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+using std::wstring;
+
+// Number of segments of the trails in the error bound test
+#define TESTSPLINEFITTER_N_SEGMENTS 120
+
+// Number of segments appended per call in incremental fitting
+#define TESTSPLINEFITTER_INCREMENT 4
+
+// Number of samples per output segment used to measure distances to the output
+#define TESTSPLINEFITTER_OUTPUT_SAMPLES 256
+
+// Relative tolerance for comparisons of control points
+#define TESTSPLINEFITTER_TOLERANCE 1.0e-4f
+
+// Number of fits timed for each benchmark configuration
+#define TESTSPLINEFITTER_N_BENCHMARK_FITS 10
+
+// Update time interval, in milliseconds
+#define TESTSPLINEFITTER_INTERVAL 16
+
+namespace testSplineFitter {
+
+	/* Position of a winding trail at the parameter 's',
+	   where knots are placed at integer values of 's'
+	 */
+	static XMFLOAT3 trailPosition(const float s) {
+		return XMFLOAT3(8.0f * std::sin(0.21f * s), 5.0f * std::sin(0.13f * s + 1.0f), 1.5f * s);
+	}
+
+	static XMFLOAT3 trailDerivative(const float s) {
+		return XMFLOAT3(8.0f * 0.21f * std::cos(0.21f * s), 5.0f * 0.13f * std::cos(0.13f * s + 1.0f), 1.5f);
+	}
+
+	/* Fills 'controlPoints' with a C_1 continuous trail of 'nSegments' segments,
+	   starting from the knot at 'first'. The knots are displaced
+	   by up to 'jitter' along each axis, to imitate a target which changes direction.
+	 */
+	static void makeTrail(std::vector<XMFLOAT4>& controlPoints, const size_t first, const size_t nSegments,
+		const float jitter, std::default_random_engine& generator) {
+		std::uniform_real_distribution<float> distribution(-jitter, jitter);
+		std::vector<XMFLOAT3> positions, tangents;
+		for( size_t i = 0; i <= nSegments; ++i ) {
+			const float s = static_cast<float>(first + i);
+			const XMFLOAT3 p = trailPosition(s);
+			const XMFLOAT3 d = trailDerivative(s);
+			const float jx = distribution(generator);
+			const float jy = distribution(generator);
+			const float jz = distribution(generator);
+			positions.push_back(XMFLOAT3(p.x + jx, p.y + jy, p.z + jz));
+			tangents.push_back(XMFLOAT3((d.x + jy) / 3.0f, (d.y + jz) / 3.0f, (d.z + jx) / 3.0f));
+		}
+		controlPoints.clear();
+		for( size_t i = 0; i < nSegments; ++i ) {
+			const XMFLOAT3& p0 = positions[i];
+			const XMFLOAT3& t0 = tangents[i];
+			const XMFLOAT3& p3 = positions[i + 1];
+			const XMFLOAT3& t3 = tangents[i + 1];
+			controlPoints.push_back(XMFLOAT4(p0.x, p0.y, p0.z, 1.0f));
+			controlPoints.push_back(XMFLOAT4(p0.x + t0.x, p0.y + t0.y, p0.z + t0.z, 1.0f));
+			controlPoints.push_back(XMFLOAT4(p3.x - t3.x, p3.y - t3.y, p3.z - t3.z, 1.0f));
+			controlPoints.push_back(XMFLOAT4(p3.x, p3.y, p3.z, 1.0f));
+		}
+	}
+
+	static XMFLOAT3 toFloat3(const XMFLOAT4& v) {
+		return XMFLOAT3(v.x, v.y, v.z);
+	}
+
+	static XMFLOAT3 bezier(const XMFLOAT3* const p, const float u) {
+		const float v = 1.0f - u;
+		const float b0 = v * v * v;
+		const float b1 = 3.0f * u * v * v;
+		const float b2 = 3.0f * u * u * v;
+		const float b3 = u * u * u;
+		return XMFLOAT3(
+			b0 * p[0].x + b1 * p[1].x + b2 * p[2].x + b3 * p[3].x,
+			b0 * p[0].y + b1 * p[1].y + b2 * p[2].y + b3 * p[3].y,
+			b0 * p[0].z + b1 * p[1].z + b2 * p[2].z + b3 * p[3].z);
+	}
+
+	/* Outputs the positions at which the fitter samples the input */
+	static void sampleInput(std::vector<XMFLOAT3>& samples, const XMFLOAT4* const controlPoints,
+		const size_t nSegments, const size_t samplesPerSegment) {
+		samples.clear();
+		XMFLOAT3 p[4];
+		for( size_t i = 0; i < nSegments; ++i ) {
+			for( size_t j = 0; j < 4; ++j ) {
+				p[j] = toFloat3(controlPoints[4 * i + j]);
+			}
+			for( size_t j = 0; j < samplesPerSegment; ++j ) {
+				samples.push_back(bezier(p, static_cast<float>(j) / static_cast<float>(samplesPerSegment)));
+			}
+		}
+		samples.push_back(p[3]);
+	}
+
+	static float distance(const XMFLOAT3& a, const XMFLOAT3& b) {
+		const float dx = a.x - b.x;
+		const float dy = a.y - b.y;
+		const float dz = a.z - b.z;
+		return std::sqrt(dx * dx + dy * dy + dz * dz);
+	}
+
+	static float distanceToLineSegment(const XMFLOAT3& point, const XMFLOAT3& a, const XMFLOAT3& b) {
+		const XMFLOAT3 ab(b.x - a.x, b.y - a.y, b.z - a.z);
+		const float lengthSquared = ab.x * ab.x + ab.y * ab.y + ab.z * ab.z;
+		float u = 0.0f;
+		if( lengthSquared > 0.0f ) {
+			u = ((point.x - a.x) * ab.x + (point.y - a.y) * ab.y + (point.z - a.z) * ab.z) / lengthSquared;
+			u = (u < 0.0f) ? 0.0f : ((u > 1.0f) ? 1.0f : u);
+		}
+		return distance(point, XMFLOAT3(a.x + u * ab.x, a.y + u * ab.y, a.z + u * ab.z));
+	}
+
+	/* Returns the largest distance from a sample to the curve
+	   described by 'output', approximated by a dense polyline
+	 */
+	static float maxDistance(const std::vector<XMFLOAT3>& samples, const XMFLOAT3* const output, const size_t nSegments) {
+		std::vector<XMFLOAT3> polyline;
+		for( size_t i = 0; i < nSegments; ++i ) {
+			for( size_t j = 0; j < TESTSPLINEFITTER_OUTPUT_SAMPLES; ++j ) {
+				polyline.push_back(bezier(output + 4 * i,
+					static_cast<float>(j) / static_cast<float>(TESTSPLINEFITTER_OUTPUT_SAMPLES)));
+			}
+		}
+		polyline.push_back(output[4 * nSegments - 1]);
+
+		float result = 0.0f;
+		for( size_t k = 0; k < samples.size(); ++k ) {
+			float best = distance(samples[k], polyline[0]);
+			for( size_t i = 0; i + 1 < polyline.size(); ++i ) {
+				const float d = distanceToLineSegment(samples[k], polyline[i], polyline[i + 1]);
+				if( d < best ) {
+					best = d;
+				}
+			}
+			if( best > result ) {
+				result = best;
+			}
+		}
+		return result;
+	}
+
+	static bool nearlyEqual(const XMFLOAT3& a, const XMFLOAT3& b, const float scale) {
+		return distance(a, b) <= TESTSPLINEFITTER_TOLERANCE * scale;
+	}
+
+	/* Returns true if adjacent segments share their end positions,
+	   and have equal tangent control points at their shared knots
+	 */
+	static bool isC1Continuous(const XMFLOAT3* const controlPoints, const size_t nSegments, const float scale) {
+		for( size_t i = 0; i + 1 < nSegments; ++i ) {
+			const XMFLOAT3* p = controlPoints + 4 * i;
+			const XMFLOAT3 before(p[3].x - p[2].x, p[3].y - p[2].y, p[3].z - p[2].z);
+			const XMFLOAT3 after(p[5].x - p[4].x, p[5].y - p[4].y, p[5].z - p[4].z);
+			if( !nearlyEqual(p[3], p[4], scale) || !nearlyEqual(before, after, scale) ) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/* Returns true if the first two and last two control points
+	   of the output equal those of the input
+	 */
+	static bool preservesEnds(const std::vector<XMFLOAT3>& output,
+		const std::vector<XMFLOAT4>& input, const float scale) {
+		const size_t n = output.size();
+		const size_t m = input.size();
+		return nearlyEqual(output[0], toFloat3(input[0]), scale) &&
+			nearlyEqual(output[1], toFloat3(input[1]), scale) &&
+			nearlyEqual(output[n - 2], toFloat3(input[m - 2]), scale) &&
+			nearlyEqual(output[n - 1], toFloat3(input[m - 1]), scale);
+	}
+
+	/* Fits 'input' incrementally, and outputs the resulting curve in 'output' */
+	static HRESULT fitIncrementally(SplineFitter& fitter, std::vector<XMFLOAT3>& output,
+		const std::vector<XMFLOAT4>& input) {
+		std::vector<XMFLOAT3> increment;
+		output.clear();
+		fitter.reset();
+		const size_t nSegments = input.size() / 4;
+		for( size_t i = 0; i < nSegments; i += TESTSPLINEFITTER_INCREMENT ) {
+			const size_t n = (i + TESTSPLINEFITTER_INCREMENT <= nSegments) ? TESTSPLINEFITTER_INCREMENT : (nSegments - i);
+			const size_t nReplaced = fitter.getNumberOfReplacedSegments();
+			HRESULT result = fitter.append(increment, &input[4 * i], n);
+			if( FAILED(result) ) {
+				return result;
+			}
+			output.resize(output.size() - 4 * nReplaced);
+			output.insert(output.end(), increment.begin(), increment.end());
+		}
+		return ERROR_SUCCESS;
+	}
+
+	static double elapsedMilliseconds(const LARGE_INTEGER& start, const LARGE_INTEGER& end, const LARGE_INTEGER& frequency) {
+		return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+}
+
+HRESULT testSplineFitter::testErrorBound(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSplineFitter_testErrorBound.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	std::default_random_engine generator(3501);
+
+	// Invalid input
+	bool exceptionThrown = false;
+	try {
+		SplineFitter invalidFitter(0.0f);
+	} catch( ... ) {
+		exceptionThrown = true;
+	}
+	SplineFitter fitter(0.1f);
+	std::vector<XMFLOAT3> output;
+	std::vector<XMFLOAT4> input;
+	makeTrail(input, 0, 1, 0.0f, generator);
+	if( !exceptionThrown || SUCCEEDED(fitter.fit(output, 0, 1)) || SUCCEEDED(fitter.fit(output, &input[0], 0)) ) {
+		logger->logMessage(L"Test failed: Incorrect handling of invalid input.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// The trails span tens of units
+	const float scale = 100.0f;
+	const float maxErrors[] = { 0.01f, 0.1f, 0.5f };
+	const float jitters[] = { 0.0f, 0.3f };
+	std::vector<XMFLOAT3> samples;
+	logger->logMessage(L"Jitter, Maximum error, Mode, Input segments, Output segments, "
+		L"Reduction ratio, Measured error, Passes");
+	for( size_t j = 0; j < sizeof(jitters) / sizeof(jitters[0]); ++j ) {
+		makeTrail(input, 0, TESTSPLINEFITTER_N_SEGMENTS, jitters[j], generator);
+		for( size_t e = 0; e < sizeof(maxErrors) / sizeof(maxErrors[0]); ++e ) {
+			SplineFitter errorFitter(maxErrors[e]);
+			sampleInput(samples, &input[0], TESTSPLINEFITTER_N_SEGMENTS, errorFitter.getSamplesPerSegment());
+			for( size_t mode = 0; mode < 2; ++mode ) {
+				const bool incremental = (mode == 1);
+				HRESULT result = ERROR_SUCCESS;
+				if( incremental ) {
+					result = fitIncrementally(errorFitter, output, input);
+				} else {
+					result = errorFitter.fit(output, &input[0], TESTSPLINEFITTER_N_SEGMENTS);
+				}
+				const wstring label = std::to_wstring(jitters[j]) + L", " + std::to_wstring(maxErrors[e]) +
+					(incremental ? L", Incremental" : L", At once");
+				if( FAILED(result) || output.empty() || output.size() % 4 != 0 ) {
+					logger->logMessage(label + L": Test failed: Call to fit() or append() failed.");
+					finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+					continue;
+				}
+				const size_t nOutput = output.size() / 4;
+				const float error = maxDistance(samples, &output[0], nOutput);
+				logger->logMessage(label + L", " + std::to_wstring(TESTSPLINEFITTER_N_SEGMENTS) + L", " +
+					std::to_wstring(nOutput) + L", " +
+					std::to_wstring(static_cast<double>(TESTSPLINEFITTER_N_SEGMENTS) / static_cast<double>(nOutput)) + L", " +
+					std::to_wstring(error) + L", " + std::to_wstring(errorFitter.getLastNumberOfPasses()));
+
+				if( error > maxErrors[e] * 1.01f ) {
+					logger->logMessage(label + L": Test failed: The output is too far from the input.");
+					finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+				}
+				if( !isC1Continuous(&output[0], nOutput, scale) ) {
+					logger->logMessage(label + L": Test failed: The output is not C_1 continuous.");
+					finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+				}
+				if( !preservesEnds(output, input, scale) ) {
+					logger->logMessage(label + L": Test failed: The ends of the input were not preserved.");
+					finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+				}
+				// The noise cannot be removed without exceeding a smaller maximum error
+				if( maxErrors[e] >= jitters[j] && nOutput >= TESTSPLINEFITTER_N_SEGMENTS ) {
+					logger->logMessage(label + L": Test failed: The number of segments was not reduced.");
+					finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+				}
+			}
+		}
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testSplineFitter::testHomingSplineCompression(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSplineFitter_testHomingSplineCompression.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	const size_t capacity = 1024;
+	const size_t initialSize = 4;
+	const float speed = 2.0f;
+	const float thresholdDistance = 2.0f;
+	const float maxError = 0.25f;
+	const float scale = 100.0f;
+	const DWORD nFrames = 3000;
+
+	XMFLOAT3 scaleVector(1.0f, 1.0f, 1.0f);
+	XMFLOAT3 startPosition(0.0f, 0.0f, -20.0f);
+	XMFLOAT3 endPosition = trailPosition(0.0f);
+	XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+	Transformable start(scaleVector, startPosition, orientation);
+	Transformable end(scaleVector, endPosition, orientation);
+
+	/* The initial knots do not wander, as they would be randomized
+	   differently in the two splines
+	 */
+	WanderingLineTransformable::Parameters parameters;
+	parameters.maxRadius = 0.0f;
+	parameters.linearSpeed = 0.0f;
+	parameters.maxRollPitchYaw = XMFLOAT3(0.0f, 0.0f, 0.0f);
+	parameters.rollPitchYawSpeeds = XMFLOAT3(0.0f, 0.0f, 0.0f);
+
+	HomingSpline reference(capacity, initialSize, speed, &start, &end, parameters, thresholdDistance);
+	HomingSpline compressed(capacity, initialSize, speed, &start, &end, parameters, thresholdDistance);
+	if( SUCCEEDED(compressed.setCompression(-1.0f)) || FAILED(compressed.setCompression(maxError)) ) {
+		logger->logMessage(L"Test failed: Incorrect handling of compression parameters.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// The end moves along the trail, facing its direction of motion
+	for( DWORD frame = 1; frame <= nFrames && SUCCEEDED(finalResult); ++frame ) {
+		const float s = 0.02f * static_cast<float>(frame);
+		end.setPosition(trailPosition(s));
+		end.setOrientation(trailDerivative(s));
+		end.update(frame * TESTSPLINEFITTER_INTERVAL, TESTSPLINEFITTER_INTERVAL);
+		if( FAILED(reference.update(frame * TESTSPLINEFITTER_INTERVAL, TESTSPLINEFITTER_INTERVAL)) ||
+			FAILED(compressed.update(frame * TESTSPLINEFITTER_INTERVAL, TESTSPLINEFITTER_INTERVAL)) ) {
+			logger->logMessage(L"Frame " + std::to_wstring(frame) + L": Test failed: Call to update() failed.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		std::vector<XMFLOAT4> referencePoints(reference.getNumberOfControlPoints());
+		std::vector<XMFLOAT4> compressedPoints(compressed.getNumberOfControlPoints());
+		XMFLOAT4* pointer = &referencePoints[0];
+		reference.getControlPoints(pointer);
+		pointer = &compressedPoints[0];
+		compressed.getControlPoints(pointer);
+		std::vector<XMFLOAT3> compressedPoints3;
+		for( size_t i = 0; i < compressedPoints.size(); ++i ) {
+			compressedPoints3.push_back(toFloat3(compressedPoints[i]));
+		}
+
+		const size_t nReference = reference.getNumberOfSegments();
+		const size_t nCompressed = compressed.getNumberOfSegments();
+		/* The last segments, which end at the dynamic knot, are not compressed,
+		   and are compared only through their endpoints.
+		 */
+		std::vector<XMFLOAT3> samples;
+		sampleInput(samples, &referencePoints[0], nReference - 1, SPLINEFITTER_SAMPLES_PER_SEGMENT);
+		const float error = maxDistance(samples, &compressedPoints3[0], nCompressed - 1);
+		logger->logMessage(L"Segments without compression: " + std::to_wstring(nReference) +
+			L", Segments with compression: " + std::to_wstring(nCompressed) +
+			L", Reduction ratio: " + std::to_wstring(static_cast<double>(nReference) / static_cast<double>(nCompressed)) +
+			L", Measured error: " + std::to_wstring(error));
+
+		if( nReference >= capacity || nCompressed * 2 > nReference ) {
+			logger->logMessage(L"Test failed: Compression did not halve the number of segments.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		if( error > maxError * 1.01f ) {
+			logger->logMessage(L"Test failed: The compressed spline is too far from the uncompressed spline.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		if( !isC1Continuous(&compressedPoints3[0], nCompressed, scale) ) {
+			logger->logMessage(L"Test failed: The compressed spline is not C_1 continuous.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		if( !nearlyEqual(compressedPoints3.front(), toFloat3(referencePoints.front()), scale) ||
+			!nearlyEqual(compressedPoints3.back(), end.getPosition(), scale) ) {
+			logger->logMessage(L"Test failed: The compressed spline does not connect its endpoints.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testSplineFitter::benchmarkFitting(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSplineFitter_benchmarkFitting.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+
+	logger->logMessage(L"Jitter, Maximum error, Input segments, Output segments, Reduction ratio, "
+		L"Time per fit (ms), Incremental output segments, Incremental reduction ratio, "
+		L"Time per incremental fit of " + std::to_wstring(TESTSPLINEFITTER_INCREMENT) + L" segments (ms)");
+
+	const size_t sizes[] = { 64, 256, 1024, 4096 };
+	const float maxErrors[] = { 0.05f, 0.25f };
+	const float jitters[] = { 0.0f, 0.3f };
+	std::vector<XMFLOAT4> input;
+	std::vector<XMFLOAT3> output;
+	for( size_t j = 0; j < sizeof(jitters) / sizeof(jitters[0]); ++j ) {
+		for( size_t e = 0; e < sizeof(maxErrors) / sizeof(maxErrors[0]); ++e ) {
+			SplineFitter fitter(maxErrors[e]);
+			for( size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s ) {
+				const size_t n = sizes[s];
+				std::default_random_engine generator(3501);
+				makeTrail(input, 0, n, jitters[j], generator);
+
+				QueryPerformanceCounter(&start);
+				for( size_t i = 0; i < TESTSPLINEFITTER_N_BENCHMARK_FITS; ++i ) {
+					fitter.fit(output, &input[0], n);
+				}
+				QueryPerformanceCounter(&end);
+				const double fitTime = elapsedMilliseconds(start, end, frequency) /
+					static_cast<double>(TESTSPLINEFITTER_N_BENCHMARK_FITS);
+				const size_t nOutput = output.size() / 4;
+
+				QueryPerformanceCounter(&start);
+				fitIncrementally(fitter, output, input);
+				QueryPerformanceCounter(&end);
+				const size_t nIncrements = (n + TESTSPLINEFITTER_INCREMENT - 1) / TESTSPLINEFITTER_INCREMENT;
+				const double incrementalTime = elapsedMilliseconds(start, end, frequency) /
+					static_cast<double>(nIncrements);
+				const size_t nIncrementalOutput = output.size() / 4;
+
+				logger->logMessage(std::to_wstring(jitters[j]) + L", " + std::to_wstring(maxErrors[e]) + L", " +
+					std::to_wstring(n) + L", " + std::to_wstring(nOutput) + L", " +
+					std::to_wstring(static_cast<double>(n) / static_cast<double>(nOutput)) + L", " +
+					std::to_wstring(fitTime) + L", " + std::to_wstring(nIncrementalOutput) + L", " +
+					std::to_wstring(static_cast<double>(n) / static_cast<double>(nIncrementalOutput)) + L", " +
+					std::to_wstring(incrementalTime));
+			}
+		}
+	}
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
@@ -0,0 +1,356 @@
+/*
+testSplineUploader.cpp
+----------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testSpline.cpp
+
+Description
+  -Implementations of test functions for the SplineUploader class
+*/
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cstring>
+#include <new>
+#include "testSplineUploader.h"
+#include "SplineUploader.h"
+#include "RecordingBufferWriter.h"
+#include "BasicSpline.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+
+// Number of random operations in the incremental upload test
+#define TESTSPLINEUPLOADER_N_OPERATIONS 1000
+
+// Capacity of the spline in the incremental upload test
+#define TESTSPLINEUPLOADER_CAPACITY 10
+
+// Number of splines in the benchmark
+#define TESTSPLINEUPLOADER_N_SPLINES 1000
+
+// Capacities of the splines in the benchmark
+#define TESTSPLINEUPLOADER_BENCHMARK_CAPACITIES { 10, 100 }
+
+// Number of frames in the benchmark
+#define TESTSPLINEUPLOADER_N_FRAMES 100
+
+// Frame interval for spline updates (milliseconds)
+#define TESTSPLINEUPLOADER_INTERVAL 16
+
+namespace testSplineUploader {
+
+	static void randomControlPoints(XMFLOAT3* const controlPoints, std::default_random_engine& generator) {
+		std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+		for( size_t i = 0; i < 2; ++i ) {
+			controlPoints[i] = XMFLOAT3(distribution(generator), distribution(generator), distribution(generator));
+		}
+	}
+
+	/* Returns the number of segments of the spline which differ
+	   between the output of getControlPoints() and the buffer
+	 */
+	static size_t compareBuffer(const Spline& spline, const RecordingBufferWriter& writer,
+		std::vector<XMFLOAT4>& controlPoints) {
+		const size_t nSegments = spline.getNumberOfSegments();
+		const size_t nSlots = spline.getNumberOfSegmentSlots();
+		const size_t offset = spline.getSegmentSlotOffset();
+		controlPoints.resize(4 * (nSegments + 1));
+		XMFLOAT4* pointer = &controlPoints[0];
+		spline.getControlPoints(pointer);
+
+		size_t nMismatched = 0;
+		const unsigned char* contents = writer.getContents();
+		for( size_t i = 0; i < nSegments; ++i ) {
+			const size_t slot = (i + offset) % nSlots;
+			if( std::memcmp(contents + slot * SPLINEUPLOADER_SEGMENT_SIZE,
+				&controlPoints[4 * i], SPLINEUPLOADER_SEGMENT_SIZE) != 0 ) {
+				++nMismatched;
+			}
+		}
+		return nMismatched;
+	}
+
+	static double elapsedMilliseconds(const LARGE_INTEGER& start, const LARGE_INTEGER& end, const LARGE_INTEGER& frequency) {
+		return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+}
+
+HRESULT testSplineUploader::testIncrementalUpload(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSplineUploader_testIncrementalUpload.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+
+	const float speed = 2.0f;
+	BasicSpline spline(TESTSPLINEUPLOADER_CAPACITY, true, &speed, false);
+	const size_t bufferSize = spline.getNumberOfSegmentSlots() * SPLINEUPLOADER_SEGMENT_SIZE;
+	RecordingBufferWriter writer(bufferSize);
+	SplineUploader uploader;
+
+	// Moving objects for dynamic knots
+	XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+	XMFLOAT3 position(0.0f, 0.0f, 0.0f);
+	XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+	std::vector<Transformable*> transforms;
+	for( size_t i = 0; i < 4; ++i ) {
+		position.x = static_cast<float>(i);
+		transforms.push_back(new Transformable(scale, position, orientation));
+		transforms.back()->setLinearVelocity(XMFLOAT3(1.0f, 0.5f, 0.0f), 0.01f * (i + 1));
+	}
+
+	std::default_random_engine generator(3501);
+	std::uniform_int_distribution<int> operationDistribution(0, 7);
+	std::uniform_int_distribution<size_t> transformDistribution(0, transforms.size() - 1);
+	XMFLOAT3 controlPoints[2];
+	std::vector<XMFLOAT4> expected;
+	DWORD currentTime = 0;
+	size_t nMismatched = 0;
+	size_t nRedundantUploads = 0;
+	size_t nFullUploads = 0;
+
+	for( size_t op = 0; op < TESTSPLINEUPLOADER_N_OPERATIONS; ++op ) {
+		switch( operationDistribution(generator) ) {
+		case 0:
+		case 1:
+			randomControlPoints(controlPoints, generator);
+			spline.addToStart(controlPoints);
+			break;
+		case 2:
+		case 3:
+			randomControlPoints(controlPoints, generator);
+			spline.addToEnd(controlPoints);
+			break;
+		case 4:
+			spline.addToEnd(transforms[transformDistribution(generator)], true);
+			break;
+		case 5:
+			spline.removeFromStart();
+			break;
+		case 6:
+			spline.removeFromEnd();
+			break;
+		default:
+			currentTime += TESTSPLINEUPLOADER_INTERVAL;
+			for( size_t i = 0; i < transforms.size(); ++i ) {
+				transforms[i]->update(currentTime, TESTSPLINEUPLOADER_INTERVAL);
+			}
+			spline.update(currentTime, TESTSPLINEUPLOADER_INTERVAL);
+			break;
+		}
+
+		writer.beginFrame();
+		if( FAILED(uploader.upload(writer, spline)) ) {
+			logger->logMessage(L"Test failed: Upload failed after operation " + std::to_wstring(op) + L".");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+		if( op > 0 && writer.getFrameBytes() == bufferSize ) {
+			++nFullUploads;
+		}
+		nMismatched += compareBuffer(spline, writer, expected);
+
+		// A second upload without changes should not write anything
+		writer.beginFrame();
+		uploader.upload(writer, spline);
+		if( writer.getFrameBytes() != 0 ) {
+			++nRedundantUploads;
+		}
+	}
+
+	logger->logMessage(std::to_wstring(TESTSPLINEUPLOADER_N_OPERATIONS) + L" operations:");
+	logger->logMessage(L"Segments differing from the spline: " + std::to_wstring(nMismatched));
+	logger->logMessage(L"Uploads without changes which wrote data: " + std::to_wstring(nRedundantUploads));
+	logger->logMessage(L"Uploads which wrote the entire buffer: " + std::to_wstring(nFullUploads));
+	logger->logMessage(L"Average bytes per upload: " +
+		std::to_wstring(static_cast<double>(writer.getTotalBytes()) / TESTSPLINEUPLOADER_N_OPERATIONS) +
+		L", out of " + std::to_wstring(bufferSize));
+	if( nMismatched != 0 || nRedundantUploads != 0 ) {
+		logger->logMessage(L"Test failed.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Laser-like use: Add knots to the end of a full spline of static knots
+	for( size_t i = 0; i < 2 * TESTSPLINEUPLOADER_CAPACITY; ++i ) {
+		randomControlPoints(controlPoints, generator);
+		spline.addToEnd(controlPoints);
+		writer.beginFrame();
+		uploader.upload(writer, spline);
+		if( i > TESTSPLINEUPLOADER_CAPACITY && writer.getFrameBytes() > 2 * SPLINEUPLOADER_SEGMENT_SIZE ) {
+			logger->logMessage(L"Test failed: Adding a knot to a full spline uploaded " +
+				std::to_wstring(writer.getFrameBytes()) + L" bytes.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		if( compareBuffer(spline, writer, expected) != 0 ) {
+			logger->logMessage(L"Test failed: Buffer differs from the spline after adding knots to a full spline.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	// Switching to another spline uploads it entirely
+	BasicSpline other(TESTSPLINEUPLOADER_CAPACITY, true, &speed, false);
+	for( size_t i = 0; i < 3; ++i ) {
+		randomControlPoints(controlPoints, generator);
+		other.addToEnd(controlPoints);
+	}
+	writer.beginFrame();
+	uploader.upload(writer, other);
+	if( writer.getFrameBytes() != bufferSize || compareBuffer(other, writer, expected) != 0 ) {
+		logger->logMessage(L"Test failed: A new spline was not uploaded entirely.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	/* A new spline created at the address of a destroyed spline
+	   is uploaded entirely, even though its version is lower
+	 */
+	void* const storage = ::operator new(sizeof(BasicSpline));
+	BasicSpline* reused = new(storage) BasicSpline(TESTSPLINEUPLOADER_CAPACITY, true, &speed, false);
+	for( size_t i = 0; i < TESTSPLINEUPLOADER_CAPACITY; ++i ) {
+		randomControlPoints(controlPoints, generator);
+		reused->addToEnd(controlPoints);
+	}
+	writer.beginFrame();
+	uploader.upload(writer, *reused);
+	reused->~BasicSpline();
+	reused = new(storage) BasicSpline(TESTSPLINEUPLOADER_CAPACITY, true, &speed, false);
+	for( size_t i = 0; i < 3; ++i ) {
+		randomControlPoints(controlPoints, generator);
+		reused->addToEnd(controlPoints);
+	}
+	writer.beginFrame();
+	uploader.upload(writer, *reused);
+	if( writer.getFrameBytes() != bufferSize || compareBuffer(*reused, writer, expected) != 0 ) {
+		logger->logMessage(L"Test failed: A new spline at the address of a destroyed spline was not uploaded entirely.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	reused->~BasicSpline();
+	::operator delete(storage);
+
+	// Buffers of the wrong size are rejected
+	RecordingBufferWriter smallWriter(bufferSize - SPLINEUPLOADER_SEGMENT_SIZE);
+	if( SUCCEEDED(uploader.upload(smallWriter, other)) || smallWriter.getTotalBytes() != 0 ) {
+		logger->logMessage(L"Test failed: Upload to a buffer of the wrong size was accepted.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	for( size_t i = 0; i < transforms.size(); ++i ) {
+		delete transforms[i];
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testSplineUploader::benchmarkUpload(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSplineUploader_benchmarkUpload.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	const float speed = 1.0f;
+	const size_t capacities[] = TESTSPLINEUPLOADER_BENCHMARK_CAPACITIES;
+	std::default_random_engine generator(3501);
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+	XMFLOAT3 controlPoints[2];
+
+	for( size_t c = 0; c < sizeof(capacities) / sizeof(capacities[0]); ++c ) {
+		const size_t capacity = capacities[c];
+		std::vector<BasicSpline*> splines;
+		std::vector<RecordingBufferWriter*> writers;
+		std::vector<SplineUploader*> uploaders;
+		for( size_t i = 0; i < TESTSPLINEUPLOADER_N_SPLINES; ++i ) {
+			splines.push_back(new BasicSpline(capacity, true, &speed, false));
+			for( size_t k = 0; k <= capacity; ++k ) {
+				randomControlPoints(controlPoints, generator);
+				splines.back()->addToEnd(controlPoints);
+			}
+			writers.push_back(new RecordingBufferWriter(splines.back()->getNumberOfSegmentSlots() * SPLINEUPLOADER_SEGMENT_SIZE));
+			uploaders.push_back(new SplineUploader);
+			uploaders.back()->upload(*writers.back(), *splines.back());
+		}
+		std::vector<XMFLOAT4> staging(4 * capacity);
+		XMFLOAT4* pointer = 0;
+
+		double fullTime = 0.0;
+		double incrementalTime = 0.0;
+		size_t fullBytes = 0;
+		size_t incrementalBytes = 0;
+		for( size_t frame = 0; frame < TESTSPLINEUPLOADER_N_FRAMES; ++frame ) {
+			for( size_t i = 0; i < splines.size(); ++i ) {
+				randomControlPoints(controlPoints, generator);
+				splines[i]->addToEnd(controlPoints);
+				writers[i]->beginFrame();
+			}
+
+			// Previous approach: Output all control points, and write the entire spline
+			QueryPerformanceCounter(&start);
+			for( size_t i = 0; i < splines.size(); ++i ) {
+				pointer = &staging[0];
+				splines[i]->getControlPoints(pointer, true);
+				writers[i]->write(&staging[0], 0, capacity * SPLINEUPLOADER_SEGMENT_SIZE);
+			}
+			QueryPerformanceCounter(&end);
+			fullTime += elapsedMilliseconds(start, end, frequency);
+			for( size_t i = 0; i < splines.size(); ++i ) {
+				fullBytes += writers[i]->getFrameBytes();
+				writers[i]->beginFrame();
+			}
+
+			// Write changed segments
+			QueryPerformanceCounter(&start);
+			for( size_t i = 0; i < splines.size(); ++i ) {
+				uploaders[i]->upload(*writers[i], *splines[i]);
+			}
+			QueryPerformanceCounter(&end);
+			incrementalTime += elapsedMilliseconds(start, end, frequency);
+			for( size_t i = 0; i < splines.size(); ++i ) {
+				incrementalBytes += writers[i]->getFrameBytes();
+			}
+		}
+
+		logger->logMessage(std::to_wstring(TESTSPLINEUPLOADER_N_SPLINES) + L" splines of " +
+			std::to_wstring(capacity) + L" segments, each gaining one knot per frame:");
+		logger->logMessage(L"Entire splines: " +
+			std::to_wstring(fullBytes / TESTSPLINEUPLOADER_N_FRAMES) + L" bytes and " +
+			std::to_wstring(fullTime / TESTSPLINEUPLOADER_N_FRAMES) + L" ms per frame");
+		logger->logMessage(L"Changed segments: " +
+			std::to_wstring(incrementalBytes / TESTSPLINEUPLOADER_N_FRAMES) + L" bytes and " +
+			std::to_wstring(incrementalTime / TESTSPLINEUPLOADER_N_FRAMES) + L" ms per frame");
+
+		for( size_t i = 0; i < splines.size(); ++i ) {
+			delete splines[i];
+			delete writers[i];
+			delete uploaders[i];
+		}
+	}
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
@@ -0,0 +1,458 @@
+/*
+testSweepAndPrune.cpp
+---------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testSpatialIndex.cpp
+
+Description
+  -Implementations of test functions for the SweepAndPrune class
+*/
+
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include "testSweepAndPrune.h"
+#include "SweepAndPrune.h"
+#include "Transformable.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+using std::wstring;
+
+// Number of objects in the correctness test
+#define TESTSWEEPANDPRUNE_N_OBJECTS 500
+
+// Number of updates in the correctness test
+#define TESTSWEEPANDPRUNE_N_FRAMES 60
+
+// Number of updates timed for each benchmark configuration
+#define TESTSWEEPANDPRUNE_N_BENCHMARK_FRAMES 10
+
+// Largest number of objects for which brute force testing is timed
+#define TESTSWEEPANDPRUNE_BRUTE_FORCE_MAX 10000
+
+// Average volume of space per object, in cubic units
+#define TESTSWEEPANDPRUNE_VOLUME_PER_OBJECT 100.0f
+
+// Range of object radii
+#define TESTSWEEPANDPRUNE_MIN_RADIUS 0.5f
+#define TESTSWEEPANDPRUNE_MAX_RADIUS 2.0f
+
+// Maximum distance moved along each axis per update
+#define TESTSWEEPANDPRUNE_SPEED 0.3f
+
+// Update time interval, in milliseconds
+#define TESTSWEEPANDPRUNE_INTERVAL 16
+
+// Collision categories
+#define TESTSWEEPANDPRUNE_STATIC 0x1U
+#define TESTSWEEPANDPRUNE_MOVING 0x2U
+
+namespace testSweepAndPrune {
+
+	struct TestObject {
+		Transformable* transform;
+		size_t id;
+		unsigned int category;
+		unsigned int mask;
+	};
+
+	static XMFLOAT3 randomPoint(const float halfSide, std::default_random_engine& generator) {
+		std::uniform_real_distribution<float> distribution(-halfSide, halfSide);
+		const float x = distribution(generator);
+		const float y = distribution(generator);
+		const float z = distribution(generator);
+		return XMFLOAT3(x, y, z);
+	}
+
+	static Transformable* createTransformable(const XMFLOAT3& position, std::default_random_engine& generator) {
+		std::uniform_real_distribution<float> radiusDistribution(TESTSWEEPANDPRUNE_MIN_RADIUS, TESTSWEEPANDPRUNE_MAX_RADIUS);
+		XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+		XMFLOAT3 positionCopy = position;
+		XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+		Transformable* transform = new Transformable(scale, positionCopy, orientation);
+		transform->m_radius = radiusDistribution(generator);
+		transform->update(0, TESTSWEEPANDPRUNE_INTERVAL);
+		return transform;
+	}
+
+	/* Adds an object to 'objects' and to 'broadphase'.
+	   The object is in the static category, and is not tested
+	   against other static objects, with probability 'staticFraction'.
+	 */
+	static HRESULT addObject(std::vector<TestObject>& objects, SweepAndPrune& broadphase,
+		const XMFLOAT3& position, const float staticFraction, std::default_random_engine& generator) {
+		std::uniform_real_distribution<float> unitDistribution(0.0f, 1.0f);
+		TestObject object;
+		object.transform = createTransformable(position, generator);
+		if( unitDistribution(generator) < staticFraction ) {
+			object.category = TESTSWEEPANDPRUNE_STATIC;
+			object.mask = SWEEPANDPRUNE_CATEGORY_ALL & ~TESTSWEEPANDPRUNE_STATIC;
+		} else {
+			object.category = TESTSWEEPANDPRUNE_MOVING;
+			object.mask = SWEEPANDPRUNE_CATEGORY_ALL;
+		}
+		HRESULT result = broadphase.add(object.id, object.transform, object.category, object.mask);
+		objects.push_back(object);
+		return result;
+	}
+
+	static void moveObject(Transformable* const transform, const XMFLOAT3& position, const DWORD currentTime) {
+		transform->setPosition(position);
+		transform->update(currentTime, TESTSWEEPANDPRUNE_INTERVAL);
+	}
+
+	static XMFLOAT3 getPosition(const Transformable* const transform) {
+		XMFLOAT4X4 worldTransform;
+		transform->getWorldTransform(worldTransform);
+		return XMFLOAT3(worldTransform._41, worldTransform._42, worldTransform._43);
+	}
+
+	static bool pairLess(const SweepAndPrune::Pair& a, const SweepAndPrune::Pair& b) {
+		return (a.id1 < b.id1) || (a.id1 == b.id1 && a.id2 < b.id2);
+	}
+
+	// Finds overlapping pairs by testing all pairs of objects
+	static void bruteForcePairs(const std::vector<TestObject>& objects, std::vector<SweepAndPrune::Pair>& pairs) {
+		pairs.clear();
+		std::vector<XMFLOAT3> positions;
+		for( size_t i = 0; i < objects.size(); ++i ) {
+			positions.push_back(getPosition(objects[i].transform));
+		}
+		SweepAndPrune::Pair pair;
+		for( size_t i = 0; i < objects.size(); ++i ) {
+			const TestObject& a = objects[i];
+			for( size_t j = i + 1; j < objects.size(); ++j ) {
+				const TestObject& b = objects[j];
+				if( (a.category & b.mask) == 0 || (b.category & a.mask) == 0 ) {
+					continue;
+				}
+				const float dx = positions[i].x - positions[j].x;
+				const float dy = positions[i].y - positions[j].y;
+				const float dz = positions[i].z - positions[j].z;
+				const float r = a.transform->m_radius + b.transform->m_radius;
+				if( dx * dx + dy * dy + dz * dz <= r * r ) {
+					pair.id1 = (a.id < b.id) ? a.id : b.id;
+					pair.id2 = (a.id < b.id) ? b.id : a.id;
+					pairs.push_back(pair);
+				}
+			}
+		}
+		std::sort(pairs.begin(), pairs.end(), pairLess);
+	}
+
+	static bool pairsEqual(const std::vector<SweepAndPrune::Pair>& a, const std::vector<SweepAndPrune::Pair>& b) {
+		if( a.size() != b.size() ) {
+			return false;
+		}
+		for( size_t i = 0; i < a.size(); ++i ) {
+			if( a[i].id1 != b[i].id1 || a[i].id2 != b[i].id2 ) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/* Returns the number of events which differ from those expected
+	   from the current and previous pairs, including missing events
+	 */
+	static size_t countEventMismatches(const std::vector<SweepAndPrune::Event>& events,
+		const std::vector<SweepAndPrune::Pair>& previous, const std::vector<SweepAndPrune::Pair>& current,
+		const SweepAndPrune& broadphase) {
+
+		size_t nMismatches = 0;
+		size_t e = 0;
+		std::vector<SweepAndPrune::Pair>::const_iterator c = current.cbegin();
+		std::vector<SweepAndPrune::Pair>::const_iterator p = previous.cbegin();
+		SweepAndPrune::EventType type;
+		size_t id1 = 0, id2 = 0;
+		while( c != current.cend() || p != previous.cend() ) {
+			if( p == previous.cend() || (c != current.cend() && pairLess(*c, *p)) ) {
+				type = SweepAndPrune::EventType::BEGIN;
+				id1 = c->id1;
+				id2 = (c++)->id2;
+			} else if( c == current.cend() || pairLess(*p, *c) ) {
+				type = SweepAndPrune::EventType::END;
+				id1 = p->id1;
+				id2 = (p++)->id2;
+			} else {
+				type = SweepAndPrune::EventType::STAY;
+				id1 = c->id1;
+				id2 = (c++)->id2;
+				++p;
+			}
+			if( e >= events.size() ) {
+				++nMismatches;
+				continue;
+			}
+			const SweepAndPrune::Event& event = events[e++];
+			if( event.type != type || event.id1 != id1 || event.id2 != id2 ||
+				event.transform1 != broadphase.getTransformable(id1) ||
+				event.transform2 != broadphase.getTransformable(id2) ||
+				(type != SweepAndPrune::EventType::END && (event.transform1 == 0 || event.transform2 == 0)) ) {
+				++nMismatches;
+			}
+		}
+		return nMismatches + (events.size() - e);
+	}
+
+	static double elapsedMilliseconds(const LARGE_INTEGER& start, const LARGE_INTEGER& end, const LARGE_INTEGER& frequency) {
+		return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+}
+
+HRESULT testSweepAndPrune::testAgainstBruteForce(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSweepAndPrune_testAgainstBruteForce.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	std::default_random_engine generator(3501);
+	std::uniform_real_distribution<float> unitDistribution(0.0f, 1.0f);
+	const float halfSide = 0.5f * std::pow(TESTSWEEPANDPRUNE_VOLUME_PER_OBJECT * TESTSWEEPANDPRUNE_N_OBJECTS, 1.0f / 3.0f);
+	std::vector<TestObject> objects;
+	SweepAndPrune broadphase;
+	std::vector<SweepAndPrune::Pair> expected, previous;
+
+	// Invalid input
+	size_t id = 0;
+	if( SUCCEEDED(broadphase.add(id, 0)) || SUCCEEDED(broadphase.remove(0)) ||
+		FAILED(broadphase.update()) || !broadphase.getEvents().empty() || broadphase.getCount() != 0 ) {
+		logger->logMessage(L"Test failed: Incorrect handling of invalid input or of an empty broadphase.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	for( size_t i = 0; i < TESTSWEEPANDPRUNE_N_OBJECTS; ++i ) {
+		addObject(objects, broadphase, randomPoint(halfSide, generator), 0.25f, generator);
+	}
+
+	size_t previousAxis = broadphase.getAxis();
+	size_t nAxisChanges = 0;
+	size_t nEvents[3] = { 0, 0, 0 };
+	XMFLOAT3 position;
+	for( DWORD frame = 1; frame <= TESTSWEEPANDPRUNE_N_FRAMES; ++frame ) {
+		const DWORD currentTime = frame * TESTSWEEPANDPRUNE_INTERVAL;
+
+		// Stretch the distribution of objects along a different axis
+		XMFLOAT3 stretch(1.0f, 1.0f, 1.0f);
+		if( frame == TESTSWEEPANDPRUNE_N_FRAMES / 3 ) {
+			stretch = XMFLOAT3(0.25f, 4.0f, 1.0f);
+		} else if( frame == 2 * TESTSWEEPANDPRUNE_N_FRAMES / 3 ) {
+			stretch = XMFLOAT3(1.0f, 0.25f, 4.0f);
+		}
+
+		for( size_t i = 0; i < objects.size(); ++i ) {
+			if( objects[i].category == TESTSWEEPANDPRUNE_STATIC && stretch.x == 1.0f && stretch.y == 1.0f ) {
+				continue;
+			}
+			position = getPosition(objects[i].transform);
+			if( frame % 10 == 0 && unitDistribution(generator) < 0.05f ) {
+				// Teleport
+				position = randomPoint(halfSide, generator);
+			} else {
+				const XMFLOAT3 offset = randomPoint(TESTSWEEPANDPRUNE_SPEED, generator);
+				position = XMFLOAT3(position.x + offset.x, position.y + offset.y, position.z + offset.z);
+			}
+			position = XMFLOAT3(position.x * stretch.x, position.y * stretch.y, position.z * stretch.z);
+			moveObject(objects[i].transform, position, currentTime);
+		}
+
+		// Removal and addition
+		if( frame % 7 == 0 ) {
+			for( size_t i = objects.size(); i > 0; --i ) {
+				if( unitDistribution(generator) < 0.05f ) {
+					if( FAILED(broadphase.remove(objects[i - 1].id)) ) {
+						logger->logMessage(L"Test failed: Failed to remove an object.");
+						finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+					}
+					delete objects[i - 1].transform;
+					objects.erase(objects.begin() + (i - 1));
+				}
+			}
+			while( objects.size() < TESTSWEEPANDPRUNE_N_OBJECTS ) {
+				addObject(objects, broadphase, randomPoint(halfSide, generator), 0.25f, generator);
+			}
+		}
+
+		if( FAILED(broadphase.update()) ) {
+			logger->logMessage(L"Test failed: Call to update() failed.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+		if( broadphase.getAxis() != previousAxis ) {
+			previousAxis = broadphase.getAxis();
+			++nAxisChanges;
+		}
+
+		previous.swap(expected);
+		bruteForcePairs(objects, expected);
+		if( !pairsEqual(expected, broadphase.getPairs()) ) {
+			logger->logMessage(L"Frame " + std::to_wstring(frame) + L": Test failed: " +
+				std::to_wstring(broadphase.getPairs().size()) + L" pairs found, " +
+				std::to_wstring(expected.size()) + L" pairs expected.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		const std::vector<SweepAndPrune::Event>& events = broadphase.getEvents();
+		const size_t nMismatches = countEventMismatches(events, previous, expected, broadphase);
+		if( nMismatches != 0 ) {
+			logger->logMessage(L"Frame " + std::to_wstring(frame) + L": Test failed: " +
+				std::to_wstring(nMismatches) + L" incorrect or missing events.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		for( size_t i = 0; i < events.size(); ++i ) {
+			++nEvents[static_cast<unsigned int>(events[i].type)];
+		}
+		if( broadphase.getCount() != objects.size() ) {
+			logger->logMessage(L"Frame " + std::to_wstring(frame) + L": Test failed: Incorrect object count.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	logger->logMessage(std::to_wstring(nEvents[0]) + L" BEGIN events, " + std::to_wstring(nEvents[1]) +
+		L" STAY events, and " + std::to_wstring(nEvents[2]) + L" END events over " +
+		std::to_wstring(TESTSWEEPANDPRUNE_N_FRAMES) + L" updates, with " +
+		std::to_wstring(nAxisChanges) + L" changes of sweep axis.");
+	if( nEvents[0] == 0 || nEvents[1] == 0 || nEvents[2] == 0 || nAxisChanges < 2 ) {
+		logger->logMessage(L"Test failed: The test did not exercise all events and axis changes.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Removing all objects produces only END events
+	for( size_t i = 0; i < objects.size(); ++i ) {
+		broadphase.remove(objects[i].id);
+		delete objects[i].transform;
+	}
+	const size_t nPairs = broadphase.getPairs().size();
+	broadphase.update();
+	bool passed = broadphase.getCount() == 0 && broadphase.getPairs().empty() &&
+		broadphase.getEvents().size() == nPairs;
+	for( size_t i = 0; i < broadphase.getEvents().size(); ++i ) {
+		const SweepAndPrune::Event& event = broadphase.getEvents()[i];
+		passed = passed && event.type == SweepAndPrune::EventType::END &&
+			event.transform1 == 0 && event.transform2 == 0;
+	}
+	if( !passed ) {
+		logger->logMessage(L"Test failed: Incorrect events after removing all objects.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	objects.clear();
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testSweepAndPrune::benchmarkScaling(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testSweepAndPrune_benchmarkScaling.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+
+	logger->logMessage(L"Configuration, Objects, First update (ms), Update with no movement (ms), "
+		L"Mean update with all objects moving (ms), Mean swaps, Mean interval overlaps, Mean pairs, "
+		L"Mean events, Brute force (ms)");
+
+	const size_t sizes[] = { 1000, 10000, 100000 };
+	const size_t nConfigurations = 2;
+	const wchar_t* labels[nConfigurations] = {
+		L"All objects moving",
+		L"99% static objects"
+	};
+	for( size_t configuration = 0; configuration < nConfigurations; ++configuration ) {
+		const float staticFraction = (configuration == 0) ? 0.0f : 0.99f;
+		for( size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s ) {
+			const size_t n = sizes[s];
+			std::default_random_engine generator(3501);
+			const float halfSide = 0.5f * std::pow(TESTSWEEPANDPRUNE_VOLUME_PER_OBJECT * static_cast<float>(n), 1.0f / 3.0f);
+			std::vector<TestObject> objects;
+			SweepAndPrune broadphase(n);
+			for( size_t i = 0; i < n; ++i ) {
+				addObject(objects, broadphase, randomPoint(halfSide, generator), staticFraction, generator);
+			}
+			QueryPerformanceCounter(&start);
+			broadphase.update();
+			QueryPerformanceCounter(&end);
+			const double firstTime = elapsedMilliseconds(start, end, frequency);
+
+			QueryPerformanceCounter(&start);
+			broadphase.update();
+			QueryPerformanceCounter(&end);
+			const double staticTime = elapsedMilliseconds(start, end, frequency);
+
+			double movingTime = 0.0;
+			size_t nSwaps = 0, nTests = 0, nPairs = 0, nEvents = 0;
+			XMFLOAT3 position;
+			for( DWORD frame = 1; frame <= TESTSWEEPANDPRUNE_N_BENCHMARK_FRAMES; ++frame ) {
+				for( size_t i = 0; i < n; ++i ) {
+					if( objects[i].category != TESTSWEEPANDPRUNE_STATIC ) {
+						position = getPosition(objects[i].transform);
+						const XMFLOAT3 offset = randomPoint(TESTSWEEPANDPRUNE_SPEED, generator);
+						position = XMFLOAT3(position.x + offset.x, position.y + offset.y, position.z + offset.z);
+						moveObject(objects[i].transform, position, frame * TESTSWEEPANDPRUNE_INTERVAL);
+					}
+				}
+				QueryPerformanceCounter(&start);
+				broadphase.update();
+				QueryPerformanceCounter(&end);
+				movingTime += elapsedMilliseconds(start, end, frequency);
+				nSwaps += broadphase.getNumberOfSwaps();
+				nTests += broadphase.getNumberOfTests();
+				nPairs += broadphase.getPairs().size();
+				nEvents += broadphase.getEvents().size();
+			}
+
+			wstring bruteForceTime = L"-";
+			if( n <= TESTSWEEPANDPRUNE_BRUTE_FORCE_MAX ) {
+				std::vector<SweepAndPrune::Pair> pairs;
+				QueryPerformanceCounter(&start);
+				bruteForcePairs(objects, pairs);
+				QueryPerformanceCounter(&end);
+				bruteForceTime = std::to_wstring(elapsedMilliseconds(start, end, frequency));
+			}
+
+			const double nFrames = static_cast<double>(TESTSWEEPANDPRUNE_N_BENCHMARK_FRAMES);
+			logger->logMessage(wstring(labels[configuration]) + L", " + std::to_wstring(n) + L", " +
+				std::to_wstring(firstTime) + L", " + std::to_wstring(staticTime) + L", " +
+				std::to_wstring(movingTime / nFrames) + L", " +
+				std::to_wstring(nSwaps / nFrames) + L", " + std::to_wstring(nTests / nFrames) + L", " +
+				std::to_wstring(nPairs / nFrames) + L", " + std::to_wstring(nEvents / nFrames) + L", " +
+				bruteForceTime);
+
+			broadphase.clear();
+			for( size_t i = 0; i < objects.size(); ++i ) {
+				delete objects[i].transform;
+			}
+		}
+	}
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
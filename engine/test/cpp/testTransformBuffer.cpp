@@ -0,0 +1,391 @@
+/*
+testTransformBuffer.cpp
+-----------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testTransformScheduler.cpp
+
+Description
+  -Implementations of test functions for the TransformBuffer class
+*/
+
+#include <string>
+#include <vector>
+#include <cmath>
+#include "testTransformBuffer.h"
+#include "TransformBuffer.h"
+#include "TransformSystem.h"
+#include "Transformable.h"
+#include "WorkerPool.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+
+// Number of transformations in the concurrency test
+#define TESTTRANSFORMBUFFER_N_TRANSFORMS 1000
+
+// Number of frames in the concurrency test
+#define TESTTRANSFORMBUFFER_N_FRAMES 2000
+
+// Number of transformations in the benchmark
+#define TESTTRANSFORMBUFFER_N_BENCHMARK_TRANSFORMS 100000
+
+// Number of frames in the benchmark
+#define TESTTRANSFORMBUFFER_N_BENCHMARK_FRAMES 50
+
+// Simulation step (milliseconds)
+#define TESTTRANSFORMBUFFER_INTERVAL 1
+
+namespace testTransformBuffer {
+
+	/* Distance moved per simulation step by the transformation
+	   with the given index
+	 */
+	static float stepDistance(const size_t index) {
+		return static_cast<float>(index % 7 + 1);
+	}
+
+	/* Adds transformations which move along the x-axis
+	   by a whole number of units per millisecond, depending on their index
+	 */
+	static void fillSystem(TransformSystem& system, const size_t n) {
+		XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+		XMFLOAT3 position(0.0f, 0.0f, 0.0f);
+		XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+		size_t index = 0;
+		for( size_t i = 0; i < n; ++i ) {
+			system.add(index, scale, position, orientation);
+			system.setLinearVelocity(index, XMFLOAT3(1.0f, 0.0f, 0.0f), stepDistance(index) * MILLISECS_PER_SEC_FLOAT);
+		}
+	}
+
+	static XMFLOAT4X4 translation(const float x) {
+		XMFLOAT4X4 result;
+		XMStoreFloat4x4(&result, XMMatrixTranslation(x, 0.0f, 0.0f));
+		return result;
+	}
+
+	static double elapsedMilliseconds(const LARGE_INTEGER& start, const LARGE_INTEGER& end, const LARGE_INTEGER& frequency) {
+		return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+}
+
+HRESULT testTransformBuffer::testFlip(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testTransformBuffer_testFlip.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	TransformBuffer buffer(4);
+	XMFLOAT4X4 out;
+
+	// Writes are not visible until the flip
+	buffer.beginWrite();
+	for( size_t i = 0; i < 4; ++i ) {
+		buffer.write(i, translation(static_cast<float>(i + 1)), translation(0.0f));
+	}
+	buffer.endWrite();
+	buffer.getWorldTransform(2, out);
+	if( out._41 != 0.0f ) {
+		logger->logMessage(L"Test failed: A write was visible before the flip.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	buffer.flip();
+	buffer.getWorldTransform(2, out);
+	if( out._41 != 3.0f || buffer.getFrameNumber() != 1 ) {
+		logger->logMessage(L"Test failed: A write was not visible after the flip.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Slots which are not written carry over, across several writes per frame
+	buffer.beginWrite();
+	buffer.write(0, translation(10.0f), translation(1.0f));
+	buffer.endWrite();
+	buffer.beginWrite();
+	buffer.write(1, translation(20.0f), translation(2.0f));
+	buffer.endWrite();
+	buffer.flip();
+	buffer.beginWrite();
+	buffer.write(1, translation(30.0f), translation(20.0f));
+	buffer.endWrite();
+	buffer.flip();
+	const float expected[] = { 10.0f, 30.0f, 3.0f, 4.0f };
+	for( size_t i = 0; i < 4; ++i ) {
+		buffer.getWorldTransform(i, out);
+		if( out._41 != expected[i] ) {
+			logger->logMessage(L"Test failed: Slot " + std::to_wstring(i) + L" holds " +
+				std::to_wstring(out._41) + L" instead of " + std::to_wstring(expected[i]) + L".");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+	buffer.getInterpolatedWorldTransform(1, out, 0.5f);
+	if( std::abs(out._41 - 25.0f) > 1.0e-4f ) {
+		logger->logMessage(L"Test failed: Incorrect interpolated transformation.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// A flip without writes keeps the current front buffer
+	buffer.flip();
+	buffer.getWorldTransform(1, out);
+	if( out._41 != 30.0f || buffer.getFrameNumber() != 3 ) {
+		logger->logMessage(L"Test failed: A flip without writes changed the front buffer.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Copying from Transformable and TransformSystem objects
+	TransformSystem system;
+	fillSystem(system, 3);
+	system.update(TESTTRANSFORMBUFFER_INTERVAL);
+	system.update(TESTTRANSFORMBUFFER_INTERVAL);
+	XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+	XMFLOAT3 position(5.0f, 0.0f, 0.0f);
+	XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+	Transformable transformable(scale, position, orientation);
+	transformable.update(0, TESTTRANSFORMBUFFER_INTERVAL);
+	buffer.beginWrite();
+	buffer.write(system);
+	buffer.write(3, transformable);
+	buffer.endWrite();
+	buffer.flip();
+	const float expectedFromObjects[] = { 2.0f, 4.0f, 6.0f, 5.0f };
+	for( size_t i = 0; i < 4; ++i ) {
+		buffer.getWorldTransform(i, out);
+		if( out._41 != expectedFromObjects[i] ) {
+			logger->logMessage(L"Test failed: Slot " + std::to_wstring(i) + L" holds " +
+				std::to_wstring(out._41) + L" after copying from objects, instead of " +
+				std::to_wstring(expectedFromObjects[i]) + L".");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+	buffer.getInterpolatedWorldTransform(1, out, 0.0f);
+	if( std::abs(out._41 - 2.0f) > 1.0e-4f ) {
+		logger->logMessage(L"Test failed: The previous transformation was not copied from the TransformSystem.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Calls at the wrong time
+	bool isWrongStateAccepted = SUCCEEDED(buffer.write(0, translation(0.0f), translation(0.0f))) ||
+		SUCCEEDED(buffer.endWrite()) || SUCCEEDED(buffer.endRead());
+	buffer.beginWrite();
+	isWrongStateAccepted = isWrongStateAccepted || SUCCEEDED(buffer.beginWrite()) ||
+		SUCCEEDED(buffer.flip()) || SUCCEEDED(buffer.resize(8));
+	buffer.endWrite();
+	buffer.beginRead();
+	isWrongStateAccepted = isWrongStateAccepted || SUCCEEDED(buffer.flip()) || SUCCEEDED(buffer.resize(8));
+	buffer.endRead();
+	if( isWrongStateAccepted ) {
+		logger->logMessage(L"Test failed: A call at the wrong time succeeded.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	if( FAILED(buffer.flip()) || FAILED(buffer.resize(8)) || buffer.getSize() != 8 ) {
+		logger->logMessage(L"Test failed: flip() or resize() failed while the buffer was idle.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testTransformBuffer::testConcurrentUpdateAndRender(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testTransformBuffer_testConcurrentUpdateAndRender.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+
+	TransformSystem system(TESTTRANSFORMBUFFER_N_TRANSFORMS);
+	fillSystem(system, TESTTRANSFORMBUFFER_N_TRANSFORMS);
+	TransformBuffer buffer(TESTTRANSFORMBUFFER_N_TRANSFORMS);
+	WorkerPool pool(2);
+
+	HRESULT updateResult = ERROR_SUCCESS;
+	size_t nInconsistent = 0;
+	size_t nInterpolationErrors = 0;
+
+	// Simulation: Update the system and copy it to the back buffer
+	const auto update = [&](void) {
+		if( FAILED(system.update(TESTTRANSFORMBUFFER_INTERVAL)) ||
+			FAILED(buffer.beginWrite()) ||
+			FAILED(buffer.write(system)) ||
+			FAILED(buffer.endWrite()) ) {
+			updateResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+		}
+	};
+
+	// Rendering: Check that the front buffer holds one complete frame
+	const auto render = [&](void) {
+		buffer.beginRead();
+		const float frame = static_cast<float>(buffer.getFrameNumber());
+		const XMFLOAT4X4* const transforms = buffer.getWorldTransforms();
+		XMFLOAT4X4 interpolated;
+		for( size_t i = 0; i < TESTTRANSFORMBUFFER_N_TRANSFORMS; ++i ) {
+			if( transforms[i]._41 != frame * stepDistance(i) ) {
+				++nInconsistent;
+			}
+		}
+		if( frame >= 2.0f ) {
+			for( size_t i = 0; i < TESTTRANSFORMBUFFER_N_TRANSFORMS; i += 97 ) {
+				buffer.getInterpolatedWorldTransform(i, interpolated, 0.5f);
+				if( std::abs(interpolated._41 - (frame - 0.5f) * stepDistance(i)) > 1.0e-3f * frame ) {
+					++nInterpolationErrors;
+				}
+			}
+		}
+		buffer.endRead();
+	};
+
+	const std::function<void(const size_t)> frameTasks = [&](const size_t task) {
+		if( task == 0 ) {
+			update();
+		} else {
+			render();
+		}
+	};
+
+	for( size_t frame = 0; frame < TESTTRANSFORMBUFFER_N_FRAMES; ++frame ) {
+		if( FAILED(pool.run(2, frameTasks)) || FAILED(updateResult) ) {
+			logger->logMessage(L"Test failed: Frame " + std::to_wstring(frame) + L" failed.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+		if( FAILED(buffer.flip()) ) {
+			logger->logMessage(L"Test failed: Flip after frame " + std::to_wstring(frame) + L" failed.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+	}
+
+	logger->logMessage(std::to_wstring(TESTTRANSFORMBUFFER_N_FRAMES) + L" frames of " +
+		std::to_wstring(TESTTRANSFORMBUFFER_N_TRANSFORMS) + L" transformations:");
+	logger->logMessage(L"Transformations read from the wrong frame: " + std::to_wstring(nInconsistent));
+	logger->logMessage(L"Incorrect interpolated transformations: " + std::to_wstring(nInterpolationErrors));
+	if( nInconsistent != 0 || nInterpolationErrors != 0 ) {
+		logger->logMessage(L"Test failed.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testTransformBuffer::benchmarkOverlap(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testTransformBuffer_benchmarkOverlap.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	TransformSystem system(TESTTRANSFORMBUFFER_N_BENCHMARK_TRANSFORMS);
+	fillSystem(system, TESTTRANSFORMBUFFER_N_BENCHMARK_TRANSFORMS);
+	TransformBuffer buffer(TESTTRANSFORMBUFFER_N_BENCHMARK_TRANSFORMS);
+	WorkerPool pool(2);
+	XMFLOAT4X4 viewProjection;
+	XMStoreFloat4x4(&viewProjection, XMMatrixPerspectiveFovLH(XM_PIDIV4, 1.0f, 0.1f, 1000.0f));
+
+	const auto update = [&](void) {
+		system.update(TESTTRANSFORMBUFFER_INTERVAL);
+		buffer.beginWrite();
+		buffer.write(system);
+		buffer.endWrite();
+	};
+
+	// Simulated rendering: Transform each object's origin to clip space
+	float checksum = 0.0f;
+	const auto render = [&](void) {
+		buffer.beginRead();
+		const XMMATRIX projection = XMLoadFloat4x4(&viewProjection);
+		XMFLOAT4X4 transform;
+		XMVECTOR sum = XMVectorZero();
+		for( size_t i = 0; i < TESTTRANSFORMBUFFER_N_BENCHMARK_TRANSFORMS; ++i ) {
+			buffer.getInterpolatedWorldTransform(i, transform, 0.5f);
+			sum = XMVectorAdd(sum, XMVector3Transform(XMVectorZero(),
+				XMMatrixMultiply(XMLoadFloat4x4(&transform), projection)));
+		}
+		checksum += XMVectorGetX(sum);
+		buffer.endRead();
+	};
+
+	const std::function<void(const size_t)> frameTasks = [&](const size_t task) {
+		if( task == 0 ) {
+			update();
+		} else {
+			render();
+		}
+	};
+
+	LARGE_INTEGER frequency, start, middle, end;
+	QueryPerformanceFrequency(&frequency);
+	double updateTime = 0.0;
+	double renderTime = 0.0;
+	double overlappedTime = 0.0;
+
+	// One after the other, on one thread
+	for( size_t frame = 0; frame < TESTTRANSFORMBUFFER_N_BENCHMARK_FRAMES; ++frame ) {
+		QueryPerformanceCounter(&start);
+		update();
+		QueryPerformanceCounter(&middle);
+		render();
+		QueryPerformanceCounter(&end);
+		buffer.flip();
+		updateTime += elapsedMilliseconds(start, middle, frequency);
+		renderTime += elapsedMilliseconds(middle, end, frequency);
+	}
+
+	// Concurrently, on two threads
+	for( size_t frame = 0; frame < TESTTRANSFORMBUFFER_N_BENCHMARK_FRAMES; ++frame ) {
+		QueryPerformanceCounter(&start);
+		pool.run(2, frameTasks);
+		buffer.flip();
+		QueryPerformanceCounter(&end);
+		overlappedTime += elapsedMilliseconds(start, end, frequency);
+	}
+
+	updateTime /= TESTTRANSFORMBUFFER_N_BENCHMARK_FRAMES;
+	renderTime /= TESTTRANSFORMBUFFER_N_BENCHMARK_FRAMES;
+	overlappedTime /= TESTTRANSFORMBUFFER_N_BENCHMARK_FRAMES;
+	const double shorterTime = (updateTime < renderTime) ? updateTime : renderTime;
+
+	logger->logMessage(std::to_wstring(TESTTRANSFORMBUFFER_N_BENCHMARK_TRANSFORMS) + L" transformations:");
+	logger->logMessage(L"Update: " + std::to_wstring(updateTime) + L" ms per frame");
+	logger->logMessage(L"Render: " + std::to_wstring(renderTime) + L" ms per frame");
+	logger->logMessage(L"Update, then render: " + std::to_wstring(updateTime + renderTime) + L" ms per frame");
+	logger->logMessage(L"Update and render concurrently: " + std::to_wstring(overlappedTime) + L" ms per frame");
+	logger->logMessage(L"Fraction of the shorter phase hidden by overlap: " +
+		std::to_wstring((updateTime + renderTime - overlappedTime) / shorterTime));
+	logger->logMessage(L"(Checksum: " + std::to_wstring(checksum) + L")");
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
@@ -0,0 +1,348 @@
+/*
+testTransformScheduler.cpp
+--------------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testTransformSystem.cpp
+
+Description
+  -Implementations of test functions for the TransformScheduler class
+*/
+
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstring>
+#include "testTransformScheduler.h"
+#include "TransformScheduler.h"
+#include "WorkerPool.h"
+#include "Transformable.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+using std::wstring;
+
+// Number of updates in the determinism test
+#define TESTTRANSFORMSCHEDULER_N_FRAMES 20
+
+// Number of updates timed for each benchmark configuration
+#define TESTTRANSFORMSCHEDULER_N_BENCHMARK_FRAMES 20
+
+// Update time interval, in milliseconds
+#define TESTTRANSFORMSCHEDULER_INTERVAL 16
+
+namespace testTransformScheduler {
+
+	/* Creates 'nRoots' trees, in parent-before-child order.
+	   If 'irregular' is false, each tree is a chain of 'depth' objects,
+	   each of which has 'width' - 1 additional leaf children.
+	   Otherwise, each tree has 'width' * 'depth' objects,
+	   with parents chosen at random among the preceding objects.
+	   All objects are moving and rotating, so that no updates are skipped.
+	 */
+	static void createHierarchy(std::vector<Transformable*>& transforms,
+		const size_t nRoots, const size_t width, const size_t depth,
+		const bool irregular, std::default_random_engine& generator) {
+
+		std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+		XMFLOAT3 scale, position, direction;
+		XMFLOAT4 orientation, angularMomentum;
+		Transformable* transform = 0;
+		Transformable* parent = 0;
+		size_t treeStart = 0;
+		const size_t treeSize = width * depth;
+
+		for( size_t root = 0; root < nRoots; ++root ) {
+			treeStart = transforms.size();
+			parent = 0;
+			for( size_t i = 0; i < treeSize; ++i ) {
+				scale = XMFLOAT3(1.0f + 0.1f * distribution(generator), 1.0f, 1.0f - 0.1f * distribution(generator));
+				position = XMFLOAT3(distribution(generator), distribution(generator), distribution(generator));
+				XMStoreFloat4(&orientation, XMQuaternionNormalize(XMVectorSet(
+					distribution(generator), distribution(generator), distribution(generator), 1.0f)));
+				transform = new Transformable(scale, position, orientation);
+
+				direction = XMFLOAT3(distribution(generator), distribution(generator), 1.0f);
+				transform->setLinearVelocity(direction, 0.001f);
+				XMStoreFloat4(&angularMomentum, XMQuaternionRotationAxis(
+					XMVectorSet(distribution(generator), 1.0f, distribution(generator), 0.0f), 0.01f));
+				transform->setAngularMomentum(angularMomentum);
+
+				if( i != 0 ) {
+					if( irregular ) {
+						std::uniform_int_distribution<size_t> parentDistribution(treeStart, transforms.size() - 1);
+						transform->setParent(transforms[parentDistribution(generator)]);
+					} else {
+						// Next element of the chain, or a leaf child of the current element
+						transform->setParent(parent);
+					}
+				}
+				transforms.push_back(transform);
+				if( !irregular && i % width == 0 ) {
+					parent = transform;
+				}
+			}
+		}
+	}
+
+	static void deleteHierarchy(std::vector<Transformable*>& transforms) {
+		for( std::vector<Transformable*>::size_type i = 0; i < transforms.size(); ++i ) {
+			delete transforms[i];
+		}
+		transforms.clear();
+	}
+
+	/* Updates objects in the given order, which is assumed
+	   to be parent-before-child order
+	 */
+	static HRESULT updateSerially(std::vector<Transformable*>& transforms, const DWORD currentTime) {
+		for( std::vector<Transformable*>::size_type i = 0; i < transforms.size(); ++i ) {
+			if( FAILED(transforms[i]->update(currentTime, TESTTRANSFORMSCHEDULER_INTERVAL)) ) {
+				return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_FUNCTION_CALL);
+			}
+		}
+		return ERROR_SUCCESS;
+	}
+
+	/* Returns the number of objects whose world transforms differ */
+	static size_t countMismatches(std::vector<Transformable*>& expected, std::vector<Transformable*>& actual) {
+		XMFLOAT4X4 expectedTransform, actualTransform;
+		size_t nMismatched = 0;
+		for( std::vector<Transformable*>::size_type i = 0; i < expected.size(); ++i ) {
+			expected[i]->getWorldTransform(expectedTransform);
+			actual[i]->getWorldTransform(actualTransform);
+			if( std::memcmp(&expectedTransform, &actualTransform, sizeof(XMFLOAT4X4)) != 0 ) {
+				++nMismatched;
+				continue;
+			}
+			expected[i]->getWorldTransformNoScale(expectedTransform);
+			actual[i]->getWorldTransformNoScale(actualTransform);
+			if( std::memcmp(&expectedTransform, &actualTransform, sizeof(XMFLOAT4X4)) != 0 ) {
+				++nMismatched;
+			}
+		}
+		return nMismatched;
+	}
+
+	static double elapsedMilliseconds(const LARGE_INTEGER& start, const LARGE_INTEGER& end, const LARGE_INTEGER& frequency) {
+		return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+}
+
+HRESULT testTransformScheduler::testDeterminism(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testTransformScheduler_testDeterminism.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+
+	// Hierarchy shapes: Number of trees, width, depth, irregular
+	const size_t nRoots[] = { 20, 4, 8 };
+	const size_t widths[] = { 50, 2, 25 };
+	const size_t depths[] = { 2, 100, 10 };
+	const bool irregular[] = { false, false, true };
+	const wchar_t* const names[] = { L"Wide", L"Deep", L"Irregular" };
+	const size_t nShapes = sizeof(nRoots) / sizeof(size_t);
+
+	const size_t threadCounts[] = { 1, 2, 4, 8 };
+	const size_t nThreadCounts = sizeof(threadCounts) / sizeof(size_t);
+
+	std::vector<Transformable*> expected;
+	std::vector<Transformable*> actual;
+	std::vector<Transformable*> shuffled;
+	std::vector<size_t> permutation;
+	WorkerPool* pool = 0;
+	TransformScheduler* scheduler = 0;
+	size_t nMismatched = 0;
+	DWORD currentTime = 0;
+
+	for( size_t s = 0; s < nShapes; ++s ) {
+		for( size_t t = 0; t < nThreadCounts; ++t ) {
+
+			// Identical hierarchies
+			std::default_random_engine generator;
+			createHierarchy(expected, nRoots[s], widths[s], depths[s], irregular[s], generator);
+			generator.seed();
+			createHierarchy(actual, nRoots[s], widths[s], depths[s], irregular[s], generator);
+
+			// The scheduler must recover the parent-before-child order
+			permutation.resize(actual.size());
+			for( size_t i = 0; i < permutation.size(); ++i ) {
+				permutation[i] = i;
+			}
+			std::shuffle(permutation.begin(), permutation.end(), generator);
+			shuffled.resize(actual.size());
+			for( size_t i = 0; i < permutation.size(); ++i ) {
+				shuffled[i] = actual[permutation[i]];
+			}
+
+			pool = new WorkerPool(threadCounts[t]);
+			scheduler = new TransformScheduler(pool, 16);
+			if( FAILED(scheduler->setTransformables(shuffled)) ) {
+				logger->logMessage(L"Test failed: TransformScheduler::setTransformables() failed.");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			} else {
+				nMismatched = 0;
+				currentTime = 0;
+				for( size_t frame = 0; frame < TESTTRANSFORMSCHEDULER_N_FRAMES; ++frame ) {
+					currentTime += TESTTRANSFORMSCHEDULER_INTERVAL;
+					if( FAILED(updateSerially(expected, currentTime)) ||
+						FAILED(scheduler->update(currentTime, TESTTRANSFORMSCHEDULER_INTERVAL)) ) {
+						logger->logMessage(L"Test failed: Update failed.");
+						finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+						break;
+					}
+					nMismatched += countMismatches(expected, actual);
+				}
+
+				logger->logMessage(wstring(names[s]) + L" hierarchy (" + std::to_wstring(actual.size()) +
+					L" objects, " + std::to_wstring(scheduler->getNumberOfLevels()) + L" levels, " +
+					std::to_wstring(scheduler->getNumberOfPhases()) + L" phases), " +
+					std::to_wstring(pool->getNumberOfThreads()) + L" thread(s): " +
+					std::to_wstring(nMismatched) + L" mismatched world transforms.");
+				if( nMismatched != 0 ) {
+					finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+				}
+			}
+
+			delete scheduler;
+			scheduler = 0;
+			delete pool;
+			pool = 0;
+			deleteHierarchy(expected);
+			deleteHierarchy(actual);
+		}
+	}
+
+	// Null elements, duplicates and cycles must be rejected
+	XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+	XMFLOAT3 position(0.0f, 0.0f, 0.0f);
+	XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+	Transformable* a = new Transformable(scale, position, orientation);
+	Transformable* b = new Transformable(scale, position, orientation);
+	scheduler = new TransformScheduler();
+	shuffled.clear();
+	shuffled.push_back(a);
+	shuffled.push_back(0);
+	if( SUCCEEDED(scheduler->setTransformables(shuffled)) ) {
+		logger->logMessage(L"Test failed: A null element was accepted.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	shuffled[1] = a;
+	if( SUCCEEDED(scheduler->setTransformables(shuffled)) ) {
+		logger->logMessage(L"Test failed: A duplicate element was accepted.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	shuffled[1] = b;
+	a->setParent(b);
+	b->setParent(a);
+	if( SUCCEEDED(scheduler->setTransformables(shuffled)) ) {
+		logger->logMessage(L"Test failed: A cycle was accepted.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	delete scheduler;
+	delete a;
+	delete b;
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testTransformScheduler::benchmarkUpdate(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testTransformScheduler_benchmarkUpdate.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	// Wide: 1000 roots with 100 children each. Deep: 100 chains of depth 1000.
+	const size_t nRoots[] = { 1000, 100 };
+	const size_t widths[] = { 101, 1 };
+	const size_t depths[] = { 1, 1000 };
+	const wchar_t* const names[] = { L"Wide", L"Deep" };
+	const size_t nShapes = sizeof(nRoots) / sizeof(size_t);
+
+	const size_t threadCounts[] = { 1, 2, 4, 8 };
+	const size_t nThreadCounts = sizeof(threadCounts) / sizeof(size_t);
+
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+
+	std::vector<Transformable*> transforms;
+	WorkerPool* pool = 0;
+	TransformScheduler* scheduler = 0;
+	double serialTime = 0.0;
+	double time = 0.0;
+	DWORD currentTime = 0;
+
+	logger->logMessage(L"Hierarchy, Number of transformations, Number of levels, Number of phases, Number of threads, Time per frame (ms), Speedup relative to a serial loop");
+
+	for( size_t s = 0; s < nShapes; ++s ) {
+		std::default_random_engine generator;
+		createHierarchy(transforms, nRoots[s], widths[s], depths[s], false, generator);
+
+		currentTime = 0;
+		QueryPerformanceCounter(&start);
+		for( size_t frame = 0; frame < TESTTRANSFORMSCHEDULER_N_BENCHMARK_FRAMES; ++frame ) {
+			currentTime += TESTTRANSFORMSCHEDULER_INTERVAL;
+			updateSerially(transforms, currentTime);
+		}
+		QueryPerformanceCounter(&end);
+		serialTime = elapsedMilliseconds(start, end, frequency) / TESTTRANSFORMSCHEDULER_N_BENCHMARK_FRAMES;
+		logger->logMessage(wstring(names[s]) + L", " + std::to_wstring(transforms.size()) +
+			L", -, -, serial, " + std::to_wstring(serialTime) + L", 1");
+
+		for( size_t t = 0; t < nThreadCounts; ++t ) {
+			pool = new WorkerPool(threadCounts[t]);
+			scheduler = new TransformScheduler(pool);
+			scheduler->setTransformables(transforms);
+
+			QueryPerformanceCounter(&start);
+			for( size_t frame = 0; frame < TESTTRANSFORMSCHEDULER_N_BENCHMARK_FRAMES; ++frame ) {
+				currentTime += TESTTRANSFORMSCHEDULER_INTERVAL;
+				scheduler->update(currentTime, TESTTRANSFORMSCHEDULER_INTERVAL);
+			}
+			QueryPerformanceCounter(&end);
+			time = elapsedMilliseconds(start, end, frequency) / TESTTRANSFORMSCHEDULER_N_BENCHMARK_FRAMES;
+
+			logger->logMessage(wstring(names[s]) + L", " + std::to_wstring(transforms.size()) + L", " +
+				std::to_wstring(scheduler->getNumberOfLevels()) + L", " +
+				std::to_wstring(scheduler->getNumberOfPhases()) + L", " +
+				std::to_wstring(pool->getNumberOfThreads()) + L", " +
+				std::to_wstring(time) + L", " + std::to_wstring(serialTime / time));
+
+			delete scheduler;
+			scheduler = 0;
+			delete pool;
+			pool = 0;
+		}
+
+		deleteHierarchy(transforms);
+	}
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
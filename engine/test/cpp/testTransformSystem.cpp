@@ -0,0 +1,496 @@
+/*
+testTransformSystem.cpp
+-----------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFileUtil.cpp (win32_base project)
+
+Description
+  -Implementations of test functions for the TransformSystem class
+*/
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+#include "testTransformSystem.h"
+#include "TransformSystem.h"
+#include "Transformable.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+using std::wstring;
+
+// Number of root transformations in the correctness test
+#define TESTTRANSFORMSYSTEM_N_ROOTS 64
+
+// Number of children of each root in the correctness test
+#define TESTTRANSFORMSYSTEM_N_CHILDREN 3
+
+// Number of updates in each test
+#define TESTTRANSFORMSYSTEM_N_FRAMES 100
+
+// Update time interval, in milliseconds
+#define TESTTRANSFORMSYSTEM_INTERVAL 16
+
+// Maximum absolute difference between matrix elements
+#define TESTTRANSFORMSYSTEM_TOLERANCE 1.0e-3f
+
+namespace testTransformSystem {
+
+	/* Creates 'n' Transformable objects with random initial states and motion,
+	   where every second object is a child of the object before it.
+	   If 'system' is not null, the objects are bound to it.
+	 */
+	static void createTransformables(std::vector<Transformable*>& transforms,
+		const size_t n, TransformSystem* const system, std::default_random_engine& generator) {
+
+		std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+		XMFLOAT3 scale, position, direction;
+		XMFLOAT4 orientation, angularMomentum;
+		Transformable* transform = 0;
+
+		for( size_t i = 0; i < n; ++i ) {
+			scale = XMFLOAT3(
+				1.5f + distribution(generator),
+				1.5f + distribution(generator),
+				1.5f + distribution(generator));
+			position = XMFLOAT3(
+				10.0f * distribution(generator),
+				10.0f * distribution(generator),
+				10.0f * distribution(generator));
+			orientation = XMFLOAT4(
+				distribution(generator),
+				distribution(generator),
+				distribution(generator),
+				distribution(generator));
+			XMStoreFloat3(&direction, XMVector3Normalize(XMVectorSet(
+				distribution(generator),
+				distribution(generator),
+				distribution(generator),
+				0.0f)));
+			XMStoreFloat4(&angularMomentum, XMQuaternionRotationAxis(
+				XMVectorSet(distribution(generator), distribution(generator), 1.0f, 0.0f),
+				0.01f * distribution(generator)));
+
+			transform = new Transformable(scale, position, orientation);
+			if( i % 2 == 1 ) {
+				transform->setParent(transforms.back());
+			}
+			if( system != 0 ) {
+				transform->bindToSystem(system);
+			}
+			transform->setLinearVelocity(direction, distribution(generator));
+			transform->setAngularMomentum(angularMomentum);
+			transforms.push_back(transform);
+		}
+	}
+
+	static void deleteTransformables(std::vector<Transformable*>& transforms) {
+		// Delete children before parents
+		std::vector<Transformable*>::size_type i = transforms.size();
+		while( i > 0 ) {
+			--i;
+			delete transforms[i];
+		}
+		transforms.clear();
+	}
+
+	// Returns the largest absolute difference between corresponding matrix elements
+	static float maxDifference(const XMFLOAT4X4& a, const XMFLOAT4X4& b) {
+		float error = 0.0f;
+		float maxError = 0.0f;
+		for( size_t r = 0; r < 4; ++r ) {
+			for( size_t c = 0; c < 4; ++c ) {
+				error = std::abs(a.m[r][c] - b.m[r][c]);
+				if( error > maxError ) {
+					maxError = error;
+				}
+			}
+		}
+		return maxError;
+	}
+
+	/* Adds the transformations of an x by y by z grid of asteroids
+	   (a centre, and two poles which are its children) to 'system',
+	   with the same layout as GameState::spawnAsteroidsGrid()
+	 */
+	static void spawnAsteroids(std::vector<Transformable*>& transforms, TransformSystem* const system,
+		const size_t x, const size_t y, const size_t z, const bool bake) {
+
+		const float radius = 1.0f;
+		const float spacing = 5.0f;
+		XMFLOAT3 scale(radius, radius, radius);
+		XMFLOAT3 offset(0.0f, 0.0f, 0.0f);
+		XMFLOAT3 southOffset(0.0f, -radius, 0.0f);
+		XMFLOAT3 northOffset(0.0f, radius, 0.0f);
+		XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+		Transformable* parent = 0;
+		Transformable* transform = 0;
+
+		for( size_t i = 0; i < x; ++i ) {
+			for( size_t j = 0; j < y; ++j ) {
+				for( size_t k = 0; k < z; ++k ) {
+					offset = XMFLOAT3(static_cast<float>(i) * spacing, static_cast<float>(j) * spacing, static_cast<float>(k) * spacing);
+					parent = new Transformable(scale, offset, orientation);
+					parent->bindToSystem(system);
+					transforms.push_back(parent);
+
+					transform = new Transformable(scale, southOffset, orientation);
+					transform->setParent(parent);
+					transform->bindToSystem(system);
+					transforms.push_back(transform);
+
+					transform = new Transformable(scale, northOffset, orientation);
+					transform->setParent(parent);
+					transform->bindToSystem(system);
+					transforms.push_back(transform);
+
+					if( bake ) {
+						parent->bake();
+						transforms[transforms.size() - 2]->bake();
+						transform->bake();
+					}
+				}
+			}
+		}
+	}
+
+	static double elapsedMilliseconds(const LARGE_INTEGER& start, const LARGE_INTEGER& end, const LARGE_INTEGER& frequency) {
+		return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+}
+
+HRESULT testTransformSystem::testAgainstTransformable(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testTransformSystem_testAgainstTransformable.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	const size_t n = TESTTRANSFORMSYSTEM_N_ROOTS * (TESTTRANSFORMSYSTEM_N_CHILDREN + 1);
+
+	// Identical sets of transformations, using the same random number sequence
+	std::vector<Transformable*> reference;
+	std::vector<Transformable*> bound;
+	TransformSystem* system = new TransformSystem(n);
+	std::default_random_engine generator;
+	createTransformables(reference, n, 0, generator);
+	generator.seed();
+	createTransformables(bound, n, system, generator);
+
+	if( system->getCount() != n ) {
+		logger->logMessage(L"TransformSystem::getCount() returned " + std::to_wstring(system->getCount()) +
+			L", not " + std::to_wstring(n) + L".");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Run the simulation and compare results
+	XMFLOAT4X4 expected, actual;
+	float error = 0.0f;
+	float maxError = 0.0f;
+	DWORD currentTime = 0;
+	for( size_t frame = 0; frame < TESTTRANSFORMSYSTEM_N_FRAMES; ++frame ) {
+		currentTime += TESTTRANSFORMSYSTEM_INTERVAL;
+		for( size_t i = 0; i < n; ++i ) {
+			reference[i]->update(currentTime, TESTTRANSFORMSYSTEM_INTERVAL);
+			bound[i]->update(currentTime, TESTTRANSFORMSYSTEM_INTERVAL); // Should have no effect
+		}
+		system->update(TESTTRANSFORMSYSTEM_INTERVAL);
+
+		for( size_t i = 0; i < n; ++i ) {
+			reference[i]->getWorldTransform(expected);
+			bound[i]->getWorldTransform(actual);
+			for( size_t r = 0; r < 4; ++r ) {
+				for( size_t c = 0; c < 4; ++c ) {
+					error = std::abs(expected.m[r][c] - actual.m[r][c]);
+					if( error > maxError ) {
+						maxError = error;
+					}
+				}
+			}
+		}
+	}
+
+	logger->logMessage(L"Maximum absolute difference in world transformation elements after " +
+		std::to_wstring(TESTTRANSFORMSYSTEM_N_FRAMES) + L" updates: " + std::to_wstring(maxError));
+	if( maxError > TESTTRANSFORMSYSTEM_TOLERANCE ) {
+		logger->logMessage(L"Test failed: Difference exceeds tolerance of " + std::to_wstring(TESTTRANSFORMSYSTEM_TOLERANCE));
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Handles must release their slots
+	deleteTransformables(bound);
+	if( system->getCount() != 0 ) {
+		logger->logMessage(L"Test failed: TransformSystem slots were not released when Transformable objects were deleted.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	deleteTransformables(reference);
+	delete system;
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testTransformSystem::benchmarkUpdate(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testTransformSystem_benchmarkUpdate.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	const size_t sizes[] = { 1000, 10000, 100000 };
+	const size_t nSizes = sizeof(sizes) / sizeof(size_t);
+
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+
+	std::vector<Transformable*> transforms;
+	TransformSystem* system = 0;
+	std::default_random_engine generator;
+	double objectTime = 0.0;
+	double systemTime = 0.0;
+	DWORD currentTime = 0;
+
+	logger->logMessage(L"Number of transformations, Transformable::update() time per frame (ms), TransformSystem::update() time per frame (ms), Speedup");
+
+	for( size_t s = 0; s < nSizes; ++s ) {
+
+		// Unbound Transformable objects
+		createTransformables(transforms, sizes[s], 0, generator);
+		currentTime = 0;
+		QueryPerformanceCounter(&start);
+		for( size_t frame = 0; frame < TESTTRANSFORMSYSTEM_N_FRAMES; ++frame ) {
+			currentTime += TESTTRANSFORMSYSTEM_INTERVAL;
+			for( size_t i = 0; i < sizes[s]; ++i ) {
+				transforms[i]->update(currentTime, TESTTRANSFORMSYSTEM_INTERVAL);
+			}
+		}
+		QueryPerformanceCounter(&end);
+		objectTime = elapsedMilliseconds(start, end, frequency) / TESTTRANSFORMSYSTEM_N_FRAMES;
+		deleteTransformables(transforms);
+
+		// TransformSystem
+		system = new TransformSystem(sizes[s]);
+		createTransformables(transforms, sizes[s], system, generator);
+		QueryPerformanceCounter(&start);
+		for( size_t frame = 0; frame < TESTTRANSFORMSYSTEM_N_FRAMES; ++frame ) {
+			system->update(TESTTRANSFORMSYSTEM_INTERVAL);
+		}
+		QueryPerformanceCounter(&end);
+		systemTime = elapsedMilliseconds(start, end, frequency) / TESTTRANSFORMSYSTEM_N_FRAMES;
+		deleteTransformables(transforms);
+		delete system;
+		system = 0;
+
+		logger->logMessage(std::to_wstring(sizes[s]) + L", " +
+			std::to_wstring(objectTime) + L", " +
+			std::to_wstring(systemTime) + L", " +
+			std::to_wstring(objectTime / systemTime));
+	}
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
+
+HRESULT testTransformSystem::testBaking(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testTransformSystem_testBaking.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	const size_t n = TESTTRANSFORMSYSTEM_N_ROOTS * 2;
+
+	// Identical sets of transformations, using the same random number sequence
+	std::vector<Transformable*> reference;
+	std::vector<Transformable*> bound;
+	TransformSystem* system = new TransformSystem(n);
+	std::default_random_engine generator;
+	createTransformables(reference, n, 0, generator);
+	generator.seed();
+	createTransformables(bound, n, system, generator);
+
+	/* Objects come in (parent, child) pairs. Both objects in every third pair
+	   are baked, only the parent is baked in the next pair, and neither object
+	   is baked in the pair after that. Baked objects must be at rest
+	   to produce the same results as the reference objects.
+	 */
+	const XMFLOAT3 direction(0.0f, 0.0f, 1.0f);
+	const XMFLOAT4 identity(0.0f, 0.0f, 0.0f, 1.0f);
+	size_t nBaked = 0;
+	for( size_t i = 0; i < n; i += 2 ) {
+		if( (i / 2) % 3 == 2 ) {
+			continue;
+		}
+		reference[i]->setLinearVelocity(direction, 0.0f);
+		reference[i]->setAngularMomentum(identity);
+		bound[i]->setLinearVelocity(direction, 0.0f);
+		bound[i]->setAngularMomentum(identity);
+		if( FAILED(bound[i]->bake()) ) {
+			logger->logMessage(L"Test failed: Failed to bake a transformation at index " + std::to_wstring(i) + L".");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		++nBaked;
+		if( (i / 2) % 3 == 0 ) {
+			reference[i + 1]->setLinearVelocity(direction, 0.0f);
+			reference[i + 1]->setAngularMomentum(identity);
+			bound[i + 1]->setLinearVelocity(direction, 0.0f);
+			bound[i + 1]->setAngularMomentum(identity);
+			if( FAILED(bound[i + 1]->bake()) ) {
+				logger->logMessage(L"Test failed: Failed to bake a transformation at index " + std::to_wstring(i + 1) + L".");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+			++nBaked;
+		}
+	}
+
+	// Children of transformations which are not baked cannot be baked
+	if( SUCCEEDED(bound[5]->bake()) ) {
+		logger->logMessage(L"Test failed: A transformation whose parent is not baked was baked.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	if( system->getNumberOfBaked() != nBaked ) {
+		logger->logMessage(L"Test failed: TransformSystem::getNumberOfBaked() returned " + std::to_wstring(system->getNumberOfBaked()) +
+			L", not " + std::to_wstring(nBaked) + L".");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Run the simulation, moving the first pair of objects halfway through
+	XMFLOAT4X4 expected, actual;
+	float error = 0.0f;
+	float maxError = 0.0f;
+	DWORD currentTime = 0;
+	for( size_t frame = 0; frame < TESTTRANSFORMSYSTEM_N_FRAMES; ++frame ) {
+		if( frame == TESTTRANSFORMSYSTEM_N_FRAMES / 2 ) {
+			reference[0]->setPosition(XMFLOAT3(1.0f, 2.0f, 3.0f));
+			bound[0]->setPosition(XMFLOAT3(1.0f, 2.0f, 3.0f));
+			if( bound[0]->isBaked() || bound[1]->isBaked() ) {
+				logger->logMessage(L"Test failed: Moving a baked transformation did not unbake it and its child.");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+			if( system->getNumberOfBaked() != nBaked - 2 ) {
+				logger->logMessage(L"Test failed: TransformSystem::getNumberOfBaked() was not updated by unbaking.");
+				finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			}
+		}
+
+		currentTime += TESTTRANSFORMSYSTEM_INTERVAL;
+		for( size_t i = 0; i < n; ++i ) {
+			reference[i]->update(currentTime, TESTTRANSFORMSYSTEM_INTERVAL);
+		}
+		system->update(TESTTRANSFORMSYSTEM_INTERVAL);
+
+		for( size_t i = 0; i < n; ++i ) {
+			reference[i]->getWorldTransform(expected);
+			bound[i]->getWorldTransform(actual);
+			error = maxDifference(expected, actual);
+			if( error > maxError ) {
+				maxError = error;
+			}
+		}
+	}
+
+	logger->logMessage(L"Maximum absolute difference in world transformation elements after " +
+		std::to_wstring(TESTTRANSFORMSYSTEM_N_FRAMES) + L" updates: " + std::to_wstring(maxError));
+	if( maxError > TESTTRANSFORMSYSTEM_TOLERANCE ) {
+		logger->logMessage(L"Test failed: Difference exceeds tolerance of " + std::to_wstring(TESTTRANSFORMSYSTEM_TOLERANCE));
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Handles must release their slots, whether baked or not
+	deleteTransformables(bound);
+	if( system->getCount() != 0 || system->getNumberOfBaked() != 0 ) {
+		logger->logMessage(L"Test failed: TransformSystem slots were not released when Transformable objects were deleted.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	deleteTransformables(reference);
+	delete system;
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testTransformSystem::benchmarkBaking(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testTransformSystem_benchmarkBaking.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	// Asteroid grid dimensions (the same in all directions)
+	const size_t sizes[] = { 10, 20, 30 };
+	const size_t nSizes = sizeof(sizes) / sizeof(size_t);
+
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+
+	std::vector<Transformable*> transforms;
+	TransformSystem* system = 0;
+	double times[2] = { 0.0, 0.0 };
+	size_t n = 0;
+
+	logger->logMessage(L"Number of transformations, Time per frame without baking (ms), Time per frame with baking (ms), Time saved per frame (ms)");
+
+	for( size_t s = 0; s < nSizes; ++s ) {
+		n = sizes[s] * sizes[s] * sizes[s] * 3;
+		for( size_t b = 0; b < 2; ++b ) {
+			system = new TransformSystem(n);
+			spawnAsteroids(transforms, system, sizes[s], sizes[s], sizes[s], (b == 1));
+			QueryPerformanceCounter(&start);
+			for( size_t frame = 0; frame < TESTTRANSFORMSYSTEM_N_FRAMES; ++frame ) {
+				system->update(TESTTRANSFORMSYSTEM_INTERVAL);
+			}
+			QueryPerformanceCounter(&end);
+			times[b] = elapsedMilliseconds(start, end, frequency) / TESTTRANSFORMSYSTEM_N_FRAMES;
+			deleteTransformables(transforms);
+			delete system;
+			system = 0;
+		}
+
+		logger->logMessage(std::to_wstring(n) + L", " +
+			std::to_wstring(times[0]) + L", " +
+			std::to_wstring(times[1]) + L", " +
+			std::to_wstring(times[0] - times[1]));
+	}
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
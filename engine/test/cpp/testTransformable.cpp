@@ -0,0 +1,238 @@
+/*
+testTransformable.cpp
+---------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFileUtil.cpp (win32_base project)
+
+Description
+  -Implementations of test functions for the Transformable class
+*/
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include "testTransformable.h"
+#include "Transformable.h"
+#include "RockingTransformable.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+using std::wstring;
+
+// Number of updates in each test
+#define TESTTRANSFORMABLE_N_FRAMES 200
+
+// Update time interval, in milliseconds
+#define TESTTRANSFORMABLE_INTERVAL 16
+
+// Depth of each deep chain of objects
+#define TESTTRANSFORMABLE_CHAIN_DEPTH 16
+
+// Number of static children of each root in the wide hierarchies
+#define TESTTRANSFORMABLE_N_WIDE_CHILDREN 32
+
+namespace testTransformable {
+
+	/* Applies a translation in transformations() during the first half
+	   of every period of 'period' milliseconds, and no translation
+	   otherwise, without changing any version counters
+	 */
+	class PulsingTransformable : public Transformable {
+	public:
+		PulsingTransformable(XMFLOAT3& scale, XMFLOAT3& position, XMFLOAT4& orientation, const DWORD period) :
+			Transformable(scale, position, orientation), m_period(period)
+		{}
+
+	protected:
+		virtual HRESULT transformations(XMFLOAT4X4& transform, const DWORD currentTime, const DWORD updateTimeInterval) override {
+			if( (currentTime % m_period) < (m_period / 2) ) {
+				XMStoreFloat4x4(&transform, XMMatrixMultiply(
+					XMMatrixTranslation(0.0f, 1.0f, 0.0f), XMLoadFloat4x4(&transform)));
+			}
+			return ERROR_SUCCESS;
+		}
+
+	private:
+		DWORD m_period;
+	};
+
+	/* Creates a scene, with objects listed in parent-before-child order.
+	   The scene contains:
+	     -A deep chain with a static root
+	     -A deep chain with a moving root
+	     -A deep chain with an animated RockingTransformable in the middle
+	     -A static root with many static children
+	     -A rotating root with many static children
+	     -A static parent with a non-animated RockingTransformable child
+	     -A static parent with a PulsingTransformable child
+	 */
+	static void createScene(std::vector<Transformable*>& scene) {
+		XMFLOAT3 scale(1.0f, 2.0f, 0.5f);
+		XMFLOAT3 position(0.5f, -1.0f, 2.0f);
+		XMFLOAT4 orientation(0.1f, 0.2f, 0.3f, 0.9f);
+		const XMFLOAT3 axis(0.0f, 1.0f, 0.0f);
+		Transformable* transform = 0;
+		Transformable* parent = 0;
+
+		for( size_t chain = 0; chain < 3; ++chain ) {
+			parent = 0;
+			for( size_t i = 0; i < TESTTRANSFORMABLE_CHAIN_DEPTH; ++i ) {
+				if( chain == 2 && i == TESTTRANSFORMABLE_CHAIN_DEPTH / 2 ) {
+					transform = new RockingTransformable(scale, position, orientation, 1000.0f, XM_PIDIV2, axis);
+				} else {
+					transform = new Transformable(scale, position, orientation);
+				}
+				if( chain == 1 && i == 0 ) {
+					transform->setLinearVelocity(XMFLOAT3(1.0f, 0.0f, 0.0f), 2.0f);
+				}
+				transform->setParent(parent);
+				scene.push_back(transform);
+				parent = transform;
+			}
+		}
+
+		for( size_t root = 0; root < 2; ++root ) {
+			parent = new Transformable(scale, position, orientation);
+			if( root == 1 ) {
+				XMFLOAT4 angularMomentum;
+				XMStoreFloat4(&angularMomentum, XMQuaternionRotationAxis(XMLoadFloat3(&axis), 0.01f));
+				parent->setAngularMomentum(angularMomentum);
+			}
+			scene.push_back(parent);
+			for( size_t i = 0; i < TESTTRANSFORMABLE_N_WIDE_CHILDREN; ++i ) {
+				transform = new Transformable(scale, position, orientation);
+				transform->setParent(parent);
+				scene.push_back(transform);
+			}
+		}
+
+		parent = new Transformable(scale, position, orientation);
+		scene.push_back(parent);
+		transform = new RockingTransformable(scale, position, orientation, 0.0f, 0.0f, axis);
+		transform->setParent(parent);
+		scene.push_back(transform);
+
+		parent = new Transformable(scale, position, orientation);
+		scene.push_back(parent);
+		transform = new PulsingTransformable(scale, position, orientation, 10 * TESTTRANSFORMABLE_INTERVAL);
+		transform->setParent(parent);
+		scene.push_back(transform);
+	}
+
+	static void deleteScene(std::vector<Transformable*>& scene) {
+		for( std::vector<Transformable*>::size_type i = 0; i < scene.size(); ++i ) {
+			delete scene[i];
+		}
+		scene.clear();
+	}
+
+	/* Updates all objects, and returns the number of skipped updates */
+	static size_t updateScene(std::vector<Transformable*>& scene, const DWORD currentTime) {
+		size_t nSkipped = 0;
+		for( std::vector<Transformable*>::size_type i = 0; i < scene.size(); ++i ) {
+			scene[i]->update(currentTime, TESTTRANSFORMABLE_INTERVAL);
+			if( scene[i]->wasUpdateSkipped() ) {
+				++nSkipped;
+			}
+		}
+		return nSkipped;
+	}
+}
+
+HRESULT testTransformable::testLazyEvaluation(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testTransformable_testLazyEvaluation.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	const bool lazyEvaluation = Transformable::getLazyEvaluation();
+
+	std::vector<Transformable*> eager;
+	std::vector<Transformable*> lazy;
+	createScene(eager);
+	createScene(lazy);
+	const size_t n = eager.size();
+
+	XMFLOAT4X4 expected, actual;
+	size_t nSkipped = 0;
+	size_t nSkippedTotal = 0;
+	size_t nMismatched = 0;
+	DWORD currentTime = 0;
+
+	for( size_t frame = 0; frame < TESTTRANSFORMABLE_N_FRAMES; ++frame ) {
+		currentTime += TESTTRANSFORMABLE_INTERVAL;
+
+		// Modify a static object partway through
+		if( frame == TESTTRANSFORMABLE_N_FRAMES / 2 ) {
+			XMFLOAT3 position(3.0f, 2.0f, 1.0f);
+			eager[TESTTRANSFORMABLE_CHAIN_DEPTH / 4]->setPosition(position);
+			lazy[TESTTRANSFORMABLE_CHAIN_DEPTH / 4]->setPosition(position);
+		}
+
+		Transformable::setLazyEvaluation(false);
+		if( updateScene(eager, currentTime) != 0 ) {
+			logger->logMessage(L"Test failed: Updates were skipped with lazy evaluation disabled.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+		Transformable::setLazyEvaluation(true);
+		nSkipped = updateScene(lazy, currentTime);
+		nSkippedTotal += nSkipped;
+
+		for( size_t i = 0; i < n; ++i ) {
+			eager[i]->getWorldTransform(expected);
+			lazy[i]->getWorldTransform(actual);
+			if( std::memcmp(&expected, &actual, sizeof(XMFLOAT4X4)) != 0 ) {
+				++nMismatched;
+			}
+			eager[i]->getWorldTransformNoScale(expected);
+			lazy[i]->getWorldTransformNoScale(actual);
+			if( std::memcmp(&expected, &actual, sizeof(XMFLOAT4X4)) != 0 ) {
+				++nMismatched;
+			}
+		}
+
+		if( frame < 4 || frame % 50 == 0 || frame == TESTTRANSFORMABLE_N_FRAMES / 2 ) {
+			logger->logMessage(L"Frame " + std::to_wstring(frame) + L": " + std::to_wstring(nSkipped) +
+				L" of " + std::to_wstring(n) + L" updates skipped.");
+		}
+	}
+
+	logger->logMessage(L"Average number of updates skipped per frame: " +
+		std::to_wstring(static_cast<double>(nSkippedTotal) / TESTTRANSFORMABLE_N_FRAMES) +
+		L" of " + std::to_wstring(n) + L".");
+
+	if( nMismatched != 0 ) {
+		logger->logMessage(L"Test failed: " + std::to_wstring(nMismatched) +
+			L" world transforms differed between lazy and eager evaluation.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	if( nSkippedTotal == 0 ) {
+		logger->logMessage(L"Test failed: No updates were skipped with lazy evaluation enabled.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	deleteScene(eager);
+	deleteScene(lazy);
+	Transformable::setLazyEvaluation(lazyEvaluation);
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
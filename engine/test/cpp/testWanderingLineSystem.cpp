@@ -0,0 +1,405 @@
+/*
+testWanderingLineSystem.cpp
+---------------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testTransformSystem.cpp
+
+Description
+  -Implementations of test functions for the WanderingLineSystem class
+*/
+
+#include <string>
+#include <vector>
+#include <cmath>
+#include "testWanderingLineSystem.h"
+#include "WanderingLineSystem.h"
+#include "WanderingLineTransformable.h"
+#include "WanderingLineSpline.h"
+#include "Transformable.h"
+#include "engineGlobals.h"
+#include "fileUtil.h"
+#include "defs.h"
+#include "Logger.h"
+
+using namespace DirectX;
+
+// Number of objects in the comparison tests
+#define TESTWANDERINGLINESYSTEM_N_OBJECTS 103
+
+// Number of updates in the comparison tests
+#define TESTWANDERINGLINESYSTEM_N_FRAMES 300
+
+// Update time interval (milliseconds)
+#define TESTWANDERINGLINESYSTEM_INTERVAL 16
+
+// Maximum allowed differences in positions, and in unit vectors and quaternions
+#define TESTWANDERINGLINESYSTEM_POSITION_TOLERANCE 1.0e-3f
+#define TESTWANDERINGLINESYSTEM_DIRECTION_TOLERANCE 1.0e-4f
+
+// Number of objects of each kind in the benchmark
+#define TESTWANDERINGLINESYSTEM_N_BENCHMARK_OBJECTS 10000
+
+// Number of updates timed in the benchmark
+#define TESTWANDERINGLINESYSTEM_N_BENCHMARK_FRAMES 50
+
+namespace testWanderingLineSystem {
+
+	/* Parameters which make use of all of the features of wandering lines,
+	   and vary with the index of the object
+	 */
+	static WanderingLineTransformable::Parameters makeParameters(const size_t index, const size_t n) {
+		WanderingLineTransformable::Parameters parameters;
+		parameters.t = static_cast<float>(index) / static_cast<float>(n - 1);
+		parameters.maxRadius = (index % 5 == 0) ? 0.0f : 2.0f;
+		parameters.linearSpeed = (index % 7 == 0) ? 0.0f : 0.002f * static_cast<float>(index % 3 + 1);
+		parameters.maxRollPitchYaw = XMFLOAT3(30.0f, (index % 4 == 0) ? 0.0f : 20.0f, 10.0f);
+		parameters.rollPitchYawSpeeds = XMFLOAT3(0.05f, 0.03f, (index % 6 == 0) ? 0.0f : 0.02f);
+		return parameters;
+	}
+
+	/* Parameters which do not produce random offsets */
+	static WanderingLineTransformable::Parameters makeStraightParameters(void) {
+		WanderingLineTransformable::Parameters parameters;
+		parameters.t = 0.0f;
+		parameters.maxRadius = 0.0f;
+		parameters.linearSpeed = 0.0f;
+		parameters.maxRollPitchYaw = XMFLOAT3(0.0f, 0.0f, 0.0f);
+		parameters.rollPitchYawSpeeds = XMFLOAT3(0.0f, 0.0f, 0.0f);
+		return parameters;
+	}
+
+	static Transformable* makeTransformable(const XMFLOAT3& position, const float scale) {
+		XMFLOAT3 scaleVector(scale, scale, scale);
+		XMFLOAT3 positionVector = position;
+		XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+		return new Transformable(scaleVector, positionVector, orientation);
+	}
+
+	/* Moves a pair of endpoints along curves, passing through
+	   configurations in which the line between them is parallel to the z-axis
+	 */
+	static void moveEndpoints(Transformable& start, Transformable& end, const size_t frame) {
+		const float time = static_cast<float>(frame) * 0.02f;
+		start.setPosition(XMFLOAT3(3.0f * sinf(time), 2.0f * cosf(0.7f * time), -5.0f));
+		end.setPosition(XMFLOAT3(4.0f * sinf(0.5f * time), 3.0f * sinf(time), 5.0f + cosf(time)));
+		start.update(0, 0);
+		end.update(0, 0);
+	}
+
+	static float difference(const XMFLOAT3& a, const XMFLOAT3& b) {
+		XMFLOAT3 length;
+		XMStoreFloat3(&length, XMVector3Length(XMVectorSubtract(XMLoadFloat3(&a), XMLoadFloat3(&b))));
+		return length.x;
+	}
+
+	static float difference(const XMFLOAT4& a, const XMFLOAT4& b) {
+		XMFLOAT4 length;
+		XMStoreFloat4(&length, XMVector4Length(XMVectorSubtract(XMLoadFloat4(&a), XMLoadFloat4(&b))));
+		return length.x;
+	}
+
+	static void updateMaximum(float& maximum, const float value) {
+		maximum = (value > maximum) ? value : maximum;
+	}
+
+	static double elapsedMilliseconds(const LARGE_INTEGER& start, const LARGE_INTEGER& end, const LARGE_INTEGER& frequency) {
+		return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+}
+
+HRESULT testWanderingLineSystem::testAgainstWanderingLineTransformable(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testWanderingLineSystem_testAgainstWanderingLineTransformable.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	const size_t n = TESTWANDERINGLINESYSTEM_N_OBJECTS;
+	Transformable* start = makeTransformable(XMFLOAT3(0.0f, 0.0f, -5.0f), 1.0f);
+	Transformable* end = makeTransformable(XMFLOAT3(0.0f, 0.0f, 5.0f), 2.0f);
+	moveEndpoints(*start, *end, 0);
+
+	std::vector<WanderingLineTransformable::Parameters> parameters(n);
+	std::vector<unsigned int> instanceIds(n);
+	std::vector<WanderingLineTransformable*> objects(n, 0);
+	for( size_t i = 0; i < n; ++i ) {
+		parameters[i] = makeParameters(i, n);
+		instanceIds[i] = static_cast<unsigned int>(1000 + i);
+		objects[i] = new WanderingLineTransformable(start, end, parameters[i], instanceIds[i]);
+	}
+
+	// Occupy some slots first, so that the objects compared do not start at a batch boundary
+	WanderingLineSystem system;
+	size_t padding = 0;
+	size_t first = 0;
+	if( FAILED(system.add(padding, 2, start, end, &parameters[0])) ||
+		FAILED(system.add(first, n, start, end, &parameters[0], &instanceIds[0])) ) {
+		logger->logMessage(L"Test failed: WanderingLineSystem::add() failed.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	// Invalid parameters are rejected
+	WanderingLineTransformable::Parameters invalid = parameters[0];
+	invalid.t = 1.5f;
+	size_t unused = 0;
+	if( SUCCEEDED(system.add(unused, 1, start, end, &invalid)) ) {
+		logger->logMessage(L"Test failed: An interpolation parameter outside [0,1] was accepted.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	float maxPositionError = 0.0f;
+	float maxScaleError = 0.0f;
+	float maxOrientationError = 0.0f;
+	float maxForwardError = 0.0f;
+	XMFLOAT3 position, scale, forward, expectedForward;
+	XMFLOAT4 orientation, expectedOrientation;
+	DWORD interval = 0;
+	for( size_t frame = 1; frame <= TESTWANDERINGLINESYSTEM_N_FRAMES && SUCCEEDED(finalResult); ++frame ) {
+		moveEndpoints(*start, *end, frame);
+
+		// Include some updates with no elapsed time
+		interval = (frame % 50 == 0) ? 0 : TESTWANDERINGLINESYSTEM_INTERVAL;
+		for( size_t i = 0; i < n; ++i ) {
+			objects[i]->update(static_cast<DWORD>(frame * TESTWANDERINGLINESYSTEM_INTERVAL), interval);
+		}
+		if( FAILED(system.update(interval)) ) {
+			logger->logMessage(L"Test failed: WanderingLineSystem::update() failed.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+
+		for( size_t i = 0; i < n; ++i ) {
+			system.getPosition(first + i, position);
+			system.getScale(first + i, scale);
+			system.getOrientation(first + i, orientation);
+			system.getForward(first + i, forward);
+			expectedOrientation = objects[i]->getOrientation();
+			objects[i]->getWorldForward(expectedForward);
+
+			updateMaximum(maxPositionError, difference(position, objects[i]->getPosition()));
+			updateMaximum(maxScaleError, difference(scale, objects[i]->getScale()));
+			updateMaximum(maxOrientationError, difference(orientation, expectedOrientation));
+			updateMaximum(maxForwardError, difference(forward, expectedForward));
+		}
+		if( maxPositionError > TESTWANDERINGLINESYSTEM_POSITION_TOLERANCE ||
+			maxScaleError > TESTWANDERINGLINESYSTEM_POSITION_TOLERANCE ||
+			maxOrientationError > TESTWANDERINGLINESYSTEM_DIRECTION_TOLERANCE ||
+			maxForwardError > TESTWANDERINGLINESYSTEM_DIRECTION_TOLERANCE ) {
+			logger->logMessage(L"Test failed: The objects differ from WanderingLineTransformable objects after update " +
+				std::to_wstring(frame) + L".");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+
+	logger->logMessage(L"Maximum position error: " + std::to_wstring(maxPositionError));
+	logger->logMessage(L"Maximum scale error: " + std::to_wstring(maxScaleError));
+	logger->logMessage(L"Maximum orientation error: " + std::to_wstring(maxOrientationError));
+	logger->logMessage(L"Maximum forward direction error: " + std::to_wstring(maxForwardError));
+
+	for( size_t i = 0; i < n; ++i ) {
+		delete objects[i];
+	}
+	delete start;
+	delete end;
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testWanderingLineSystem::testSplines(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testWanderingLineSystem_testSplines.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	HRESULT finalResult = ERROR_SUCCESS;
+	const size_t capacity = 6;
+	const size_t nKnots = capacity + 1;
+	const float speed = 3.0f;
+	Transformable* start = makeTransformable(XMFLOAT3(0.0f, 0.0f, -5.0f), 1.0f);
+	Transformable* end = makeTransformable(XMFLOAT3(0.0f, 0.0f, 5.0f), 1.0f);
+	moveEndpoints(*start, *end, 0);
+
+	/* Knots created as separate objects are given unique random sequences,
+	   so only parameters without random offsets can be compared.
+	 */
+	const WanderingLineTransformable::Parameters parameters = makeStraightParameters();
+	WanderingLineSystem system;
+	WanderingLineSpline* reference = new WanderingLineSpline(capacity, speed, start, end, parameters);
+	WanderingLineSpline* batched = new WanderingLineSpline(capacity, speed, start, end, parameters, &system);
+	if( system.getCount() != nKnots ) {
+		logger->logMessage(L"Test failed: The spline did not add one object per knot to the system.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+
+	const size_t nControlPoints = reference->getNumberOfControlPoints();
+	std::vector<XMFLOAT4> referencePoints(nControlPoints);
+	std::vector<XMFLOAT4> batchedPoints(nControlPoints);
+	XMFLOAT4* output = 0;
+	float maxError = 0.0f;
+	const DWORD interval = TESTWANDERINGLINESYSTEM_INTERVAL;
+	for( size_t frame = 1; frame <= TESTWANDERINGLINESYSTEM_N_FRAMES && SUCCEEDED(finalResult); ++frame ) {
+		moveEndpoints(*start, *end, frame);
+
+		// Splines first, then their knots, as in GameStateWithParticles
+		if( FAILED(reference->update(static_cast<DWORD>(frame * interval), interval)) ||
+			FAILED(batched->update(static_cast<DWORD>(frame * interval), interval)) ||
+			FAILED(system.update(interval)) ) {
+			logger->logMessage(L"Test failed: Spline update failed.");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+			break;
+		}
+
+		/* Knots created as separate objects use an identity transformation
+		   for their tangents until they are first updated
+		 */
+		if( frame < 2 ) {
+			continue;
+		}
+		output = &referencePoints[0];
+		reference->getControlPoints(output);
+		output = &batchedPoints[0];
+		batched->getControlPoints(output);
+		for( size_t i = 0; i < nControlPoints; ++i ) {
+			updateMaximum(maxError, difference(referencePoints[i], batchedPoints[i]));
+		}
+		if( maxError > TESTWANDERINGLINESYSTEM_POSITION_TOLERANCE ) {
+			logger->logMessage(L"Test failed: The spline control points differ after update " +
+				std::to_wstring(frame) + L".");
+			finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+		}
+	}
+	logger->logMessage(L"Maximum control point error: " + std::to_wstring(maxError));
+
+	// Slots are freed by the destructor, and reused
+	delete batched;
+	batched = 0;
+	if( system.getCount() != 0 ) {
+		logger->logMessage(L"Test failed: The spline's destructor did not free its knots.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	const size_t size = system.getSize();
+	WanderingLineSpline* first = new WanderingLineSpline(capacity, speed, start, end, parameters, &system);
+	WanderingLineSpline* second = new WanderingLineSpline(capacity, speed, start, end, parameters, &system);
+	delete first;
+	WanderingLineSpline* third = new WanderingLineSpline(capacity, speed, start, end, parameters, &system);
+	if( system.getSize() != size + nKnots || system.getCount() != 2 * nKnots ) {
+		logger->logMessage(L"Test failed: Free slots were not reused.");
+		finalResult = MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_BROKEN_CODE);
+	}
+	delete second;
+	delete third;
+
+	delete reference;
+	delete start;
+	delete end;
+
+	if( SUCCEEDED(finalResult) ) {
+		logger->logMessage(L"Test passed.");
+	}
+	delete logger;
+	return finalResult;
+}
+
+HRESULT testWanderingLineSystem::benchmarkUpdate(void) {
+
+	// Create a file for logging the test results
+	Logger* logger = 0;
+	try {
+		std::wstring logFilename;
+		fileUtil::combineAsPath(logFilename, ENGINE_DEFAULT_LOG_PATH_TEST, L"testWanderingLineSystem_benchmarkUpdate.txt");
+		logger = new Logger(true, logFilename, true, false);
+	} catch( ... ) {
+		return MAKE_HRESULT(SEVERITY_ERROR, FACILITY_BL_ENGINE, ERROR_NO_LOGGER);
+	}
+
+	const size_t n = TESTWANDERINGLINESYSTEM_N_BENCHMARK_OBJECTS;
+	const size_t nFrames = TESTWANDERINGLINESYSTEM_N_BENCHMARK_FRAMES;
+	const DWORD interval = TESTWANDERINGLINESYSTEM_INTERVAL;
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+	double individualTime = 0.0;
+	double batchedTime = 0.0;
+	float checksum = 0.0f;
+
+	// Wandering lines, in groups of 16 sharing endpoints (as the knots of a spline do)
+	const size_t groupSize = 16;
+	const size_t nGroups = (n + groupSize - 1) / groupSize;
+	std::vector<Transformable*> starts(nGroups, 0);
+	std::vector<Transformable*> ends(nGroups, 0);
+	for( size_t g = 0; g < nGroups; ++g ) {
+		starts[g] = makeTransformable(XMFLOAT3(static_cast<float>(g), 0.0f, -5.0f), 1.0f);
+		ends[g] = makeTransformable(XMFLOAT3(0.0f, static_cast<float>(g), 5.0f), 1.0f);
+	}
+	std::vector<WanderingLineTransformable::Parameters> parameters(groupSize);
+	for( size_t i = 0; i < groupSize; ++i ) {
+		parameters[i] = makeParameters(i, groupSize);
+		parameters[i].maxRadius = 2.0f;
+		parameters[i].linearSpeed = 0.002f;
+	}
+	std::vector<WanderingLineTransformable*> lines(n, 0);
+	WanderingLineSystem system(n);
+	size_t first = 0;
+	for( size_t g = 0; g < nGroups; ++g ) {
+		for( size_t i = 0; i < groupSize && g * groupSize + i < n; ++i ) {
+			lines[g * groupSize + i] = new WanderingLineTransformable(starts[g], ends[g], parameters[i]);
+		}
+		system.add(first, (n - g * groupSize < groupSize) ? (n - g * groupSize) : groupSize,
+			starts[g], ends[g], &parameters[0]);
+	}
+
+	for( size_t frame = 0; frame < nFrames; ++frame ) {
+		QueryPerformanceCounter(&start);
+		for( size_t i = 0; i < n; ++i ) {
+			lines[i]->update(static_cast<DWORD>(frame * interval), interval);
+		}
+		QueryPerformanceCounter(&end);
+		individualTime += elapsedMilliseconds(start, end, frequency);
+
+		QueryPerformanceCounter(&start);
+		system.update(interval);
+		QueryPerformanceCounter(&end);
+		batchedTime += elapsedMilliseconds(start, end, frequency);
+	}
+	checksum += lines[n - 1]->getPosition().x;
+	XMFLOAT3 position;
+	system.getPosition(n - 1, position);
+	checksum += position.x;
+
+	logger->logMessage(std::to_wstring(n) + L" wandering line objects:");
+	logger->logMessage(L"WanderingLineTransformable::update(): " + std::to_wstring(individualTime / nFrames) + L" ms per frame");
+	logger->logMessage(L"WanderingLineSystem::update(): " + std::to_wstring(batchedTime / nFrames) + L" ms per frame");
+	logger->logMessage(L"Speedup: " + std::to_wstring(individualTime / batchedTime));
+	logger->logMessage(L"(Checksum: " + std::to_wstring(checksum) + L")");
+
+	for( size_t i = 0; i < n; ++i ) {
+		delete lines[i];
+	}
+	for( size_t g = 0; g < nGroups; ++g ) {
+		delete starts[g];
+		delete ends[g];
+	}
+
+	delete logger;
+	return ERROR_SUCCESS;
+}
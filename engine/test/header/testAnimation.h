@@ -0,0 +1,45 @@
+/*
+testAnimation.h
+---------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFileUtil.h (win32_base project)
+
+Description
+  -Test functions for the AnimationClip and AnimationSampler classes
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testAnimation {
+
+	/* Compresses smooth random tracks, and checks that sampling
+	   the clip reproduces piecewise linear interpolation of the
+	   original keys within the key reduction tolerance plus the
+	   quantization error. Also checks that constant and linear tracks
+	   are reduced to one and two keys, respectively, and that
+	   invalid tracks are rejected.
+	 */
+	HRESULT testCompression(void);
+
+	/* Compares the bone transformations output by AnimationSampler,
+	   for single clips and for blends of two clips, with transformations
+	   computed one bone at a time using XMMatrixAffineTransformation().
+	 */
+	HRESULT testSampler(void);
+
+	/* Logs the number of bones sampled per second for single clips
+	   and for blends of two clips, with and without output
+	   of the bone matrices used for vertex skinning
+	 */
+	HRESULT benchmarkSampling(void);
+}
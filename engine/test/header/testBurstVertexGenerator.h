@@ -0,0 +1,51 @@
+/*
+testBurstVertexGenerator.h
+--------------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testTransformScheduler.h
+
+Description
+  -Test functions for the BurstVertexGenerator class
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testBurstVertexGenerator {
+
+	/* Checks that sphere vertices are bitwise identical to those computed
+	   one at a time by BurstVertexGenerator::sphereVertex()
+	   (the mapping used by UniformBurstSphere::uvToPosition(), etc.),
+	   and compares a few vertices with hand-computed values.
+	 */
+	HRESULT testSphere(void);
+
+	/* Checks that cone vertices match those computed one at a time by
+	   BurstVertexGenerator::coneVertex() from random values drawn serially,
+	   row by row, as in the original RandomBurstCone::addVertices().
+	   Positions and velocities are compared within a tolerance,
+	   because the sines and cosines are computed differently.
+	 */
+	HRESULT testCone(void);
+
+	/* Generates sphere and cone vertices using different numbers
+	   of threads and chunk sizes, and checks that the results
+	   are bitwise identical to those generated on a single thread.
+	 */
+	HRESULT testDeterminism(void);
+
+	/* Logs the time taken to generate large spheres and cones
+	   with different numbers of threads, relative to a serial loop
+	   which computes vertices one at a time.
+	 */
+	HRESULT benchmarkScaling(void);
+}
@@ -0,0 +1,38 @@
+/*
+testCounterRNG.h
+----------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFileUtil.h (win32_base project)
+
+Description
+  -Test functions for the CounterRNG class
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testCounterRNG {
+
+	/* Checks the generator against published Philox4x32-10
+	   known-answer vectors, checks that sequences are reproducible
+	   and independent of the way in which they are drawn,
+	   and checks the moments and histograms of uniform, normal,
+	   sphere and cone samples.
+	 */
+	HRESULT testStatistics(void);
+
+	/* Logs the rate at which random numbers are generated
+	   by the standard library engine previously used by the engine,
+	   and by CounterRNG, one value at a time and in bulk.
+	 */
+	HRESULT benchmarkThroughput(void);
+}
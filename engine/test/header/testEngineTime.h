@@ -0,0 +1,39 @@
+/*
+testEngineTime.h
+----------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFileUtil.h (win32_base project)
+
+Description
+  -Test functions for the engine time types (EngineTime.h)
+     and for the IClock classes
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testEngineTime {
+
+	/* Checks conversions to and from DWORD milliseconds,
+	   the behaviour of ManualClock and ScaledClock,
+	   the monotonicity and resolution of MonotonicClock,
+	   and that FixedTimestep does not drift when driven
+	   by frames which are not whole numbers of milliseconds long.
+	 */
+	HRESULT testClocks(void);
+
+	/* Logs the cost of time conversions and clock reads,
+	   and of updating many Transformable objects with times
+	   converted from EngineTime values, compared to DWORD values.
+	 */
+	HRESULT benchmarkConversion(void);
+}
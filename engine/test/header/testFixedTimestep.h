@@ -0,0 +1,43 @@
+/*
+testFixedTimestep.h
+-------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFileUtil.h (win32_base project)
+
+Description
+  -Test functions for the FixedTimestep class,
+     and for render interpolation of Transformable objects
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testFixedTimestep {
+
+	/* Simulates identical scenes driven by synthetic clocks with different
+	   frame rates, irregular frame intervals, and occasional long frames,
+	   and checks that all world transforms are bitwise identical
+	   after the same number of simulation steps.
+	   The scenes contain moving hierarchies, RockingTransformable and
+	   WanderingLineTransformable objects, and objects bound to a TransformSystem.
+	   Also logs the divergence of the same scenes when updated
+	   with variable time steps.
+	 */
+	HRESULT testDeterminism(void);
+
+	/* Checks the number of steps taken per frame, the limit on steps per frame,
+	   and the interpolation factor, and checks that interpolated world transforms
+	   of free and bound Transformable objects lie between the previous and current
+	   world transforms.
+	 */
+	HRESULT testInterpolation(void);
+}
@@ -0,0 +1,37 @@
+/*
+testKnot.h
+----------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFileUtil.h (win32_base project)
+
+Description
+  -Test functions for the Knot, StaticKnot and DynamicKnot classes
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testKnot {
+
+	/* Checks the control points output by knots of each side,
+	   and after conversions between single and double-sided knots.
+	 */
+	HRESULT testSides(void);
+
+	/* Adds millions of static and dynamic knots to splines
+	   at capacity, so that knots are continually created and destroyed,
+	   and checks that the knot pools do not grow after the first frame,
+	   and that all knots are returned to the pools when the splines
+	   are destroyed. Also logs the rate of knot churn.
+	 */
+	HRESULT testPoolChurn(void);
+}
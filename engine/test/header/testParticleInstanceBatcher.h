@@ -0,0 +1,40 @@
+/*
+testParticleInstanceBatcher.h
+-----------------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testSplineUploader.h
+
+Description
+  -Test functions for the ParticleInstanceBatcher class
+  -These tests do not create any windows or Direct3D objects.
+     Draw calls are made to RecordingParticleDrawBackend objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testParticleInstanceBatcher {
+
+	/* Draws several frames of explosions, jets and ball lightning effects,
+	   with and without instancing, and checks the numbers of draw calls
+	   and state changes in each frame. Without instancing, each system
+	   is a draw call with a model bind and a constant buffer update.
+	   With instancing, each model is bound once, and drawn with one call
+	   per 'maxInstancesPerDraw' systems. Logs the totals for both modes.
+	 */
+	HRESULT testDrawCounts(void);
+
+	/* Checks that the instance data received by the backend is the data
+	   queued, in the same order, with each model's instances drawn together,
+	   and that failures leave the batcher with empty queues.
+	 */
+	HRESULT testInstanceData(void);
+}
@@ -0,0 +1,66 @@
+/*
+testParticleKernels.h
+---------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testTransformSystem.h
+
+Description
+  -Test functions for the ParticleKernels class
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testParticleKernels {
+
+	/* Compares the output of the general particle vertex shader kernels
+	   with values computed by hand from generalParticlesVS.hlsl,
+	   for particles before birth, during their first lifespan,
+	   after wrapping around, and below the health cutoff.
+	   Also checks ParticleKernels::hlslMod() and ParticleKernels::getGlobals().
+	 */
+	HRESULT testGeneralGolden(void);
+
+	/* Checks that the vectorized general particle vertex shader kernel
+	   produces results bitwise-identical to those of the reference kernel,
+	   for random particles and transformations, and array lengths
+	   which are not multiples of the batch size
+	 */
+	HRESULT testGeneralAgainstReference(void);
+
+	/* Measures the number of particles per second processed by the
+	   reference and vectorized general particle vertex shader kernels
+	 */
+	HRESULT benchmarkGeneral(void);
+
+	/* Compares the output of the spline particle vertex shader kernels
+	   with values computed by hand from splineParticlesVS.hlsl,
+	   for particles on different segments of a spline whose segments
+	   wrap around the end of the control point buffer, and for particles
+	   outside the valid segments. Also checks ParticleKernels::getSplineGlobals().
+	 */
+	HRESULT testSplineGolden(void);
+
+	/* Uploads splines to a control point buffer with SplineUploader,
+	   as done by SplineParticles, and checks that the vectorized spline
+	   particle vertex shader kernel, reading from the buffer, produces results
+	   bitwise-identical to those of the reference kernel, reading control points
+	   directly from the splines. Particles are generated in the same ranges
+	   as the laser particle systems (UniformRandomSplineModel).
+	 */
+	HRESULT testSplineAgainstReference(void);
+
+	/* Measures the number of particles per second processed by the
+	   reference and vectorized spline particle vertex shader kernels
+	 */
+	HRESULT benchmarkSpline(void);
+}
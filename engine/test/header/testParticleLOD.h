@@ -0,0 +1,51 @@
+/*
+testParticleLOD.h
+-----------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testBurstVertexGenerator.h
+
+Description
+  -Test functions for the ParticleLOD class
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testParticleLOD {
+
+	/* Computes the number of particles drawn for a particle system
+	   placed with Transformable objects at a range of distances from a camera,
+	   given as view and projection transformations. Checks that all particles
+	   are drawn when the system is close to, or surrounds, the camera,
+	   that the number of particles decreases with distance down to
+	   the smallest level of detail, that the projected size agrees with
+	   a hand-computed value, and does not depend on the direction
+	   of the system from the camera, and that compensation preserves
+	   the total opacity of the billboards drawn. Logs the selections.
+	 */
+	HRESULT testSelection(void);
+
+	/* Checks that progressiveOrder() outputs a permutation,
+	   which places exact subgrids first when the grid dimensions
+	   are powers of two, and that the prefixes drawn at each level of detail
+	   of the explosion and jet particle grids are spread evenly over
+	   the grid, unlike prefixes of the grid in row-major order.
+	 */
+	HRESULT testProgressiveOrder(void);
+
+	/* Estimates the number of pixels covered by the billboards
+	   of a scene of explosions at random distances from the camera,
+	   with and without level of detail, and logs the numbers of particles
+	   and pixels drawn. Fails if level of detail increases either number.
+	 */
+	HRESULT testFillRate(void);
+}
@@ -0,0 +1,44 @@
+/*
+testSlotMap.h
+-------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testKnot.h
+
+Description
+  -Test functions for the SlotMap class
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testSlotMap {
+
+	/* Checks that handles remain valid until their elements are removed,
+	   that stale handles are rejected after their slots are reused,
+	   that elements are constructed in place, do not move when
+	   the container grows, and are destroyed exactly once,
+	   and that iterating backwards while removing elements
+	   visits every element exactly once.
+	 */
+	HRESULT testHandles(void);
+
+	/* Simulates several seconds of gameplay in which many thousands
+	   of particle systems per second are spawned, expire, or are removed
+	   by their transformations, stored in a SlotMap with an index
+	   by transformation, and in a vector of pointers to heap-allocated
+	   systems searched linearly, as GameStateWithParticles did previously.
+	   Checks that both containers hold the same systems in every frame,
+	   and that the SlotMap does not grow once the number of systems
+	   has stabilized. Logs the rate of churn with each container.
+	 */
+	HRESULT testChurn(void);
+}
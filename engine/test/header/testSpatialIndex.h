@@ -0,0 +1,38 @@
+/*
+testSpatialIndex.h
+------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFileUtil.h (win32_base project)
+
+Description
+  -Test functions for the SpatialIndex class
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testSpatialIndex {
+
+	/* Compares the results of ray casts, sphere overlap queries
+	   and k-nearest queries with the results of brute force searches,
+	   while objects are added, moved and removed, and while the index
+	   is maintained with update(), refit() and rebuild().
+	   Also checks the structure of the index after each change.
+	 */
+	HRESULT testQueries(void);
+
+	/* Logs the time taken to build, update, refit and query indices
+	   of 10 thousand to 1 million objects, and the time taken
+	   by brute force queries for comparison.
+	 */
+	HRESULT benchmarkScaling(void);
+}
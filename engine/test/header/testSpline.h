@@ -0,0 +1,78 @@
+/*
+testSpline.h
+------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFileUtil.h (win32_base project)
+
+Description
+  -Test functions for the Spline class
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testSpline {
+
+	/* Applies a random sequence of knot additions, removals
+	   and updates to a spline, and to a reference implementation
+	   storing knots in a linked list, and checks that the outputs
+	   of getControlPoints() and eval() are bitwise identical.
+	 */
+	HRESULT testAgainstList(void);
+
+	/* Logs the time taken to update, output control points from,
+	   and evaluate many laser-like splines per frame,
+	   compared to the reference linked-list implementation.
+	 */
+	HRESULT benchmarkLasers(void);
+
+	/* Checks that the positions output by Spline::evalBatch()
+	   are within a few units in the last place of the largest
+	   control point coordinate of those output by eval(),
+	   that the first derivatives are parallel to the directions
+	   output by eval(), and that the second derivatives
+	   agree with finite differences of the first derivatives.
+	 */
+	HRESULT testEvalBatch(void);
+
+	/* Logs the time taken to evaluate a spline at many parameter values
+	   using eval(), and using evalBatch() with and without derivatives.
+	 */
+	HRESULT benchmarkEvalBatch(void);
+
+	/* Applies a random sequence of knot additions, removals
+	   and updates to a spline, and checks the results of its
+	   arc length functions against brute-force arc lengths
+	   computed from its control points, and against each other.
+	 */
+	HRESULT testArcLength(void);
+
+	/* Logs the time taken to build arc length tables,
+	   from scratch and incrementally, and to convert between
+	   arc lengths and spline parameter values.
+	 */
+	HRESULT benchmarkArcLength(void);
+
+	/* Applies a random sequence of knot additions, removals
+	   and updates to a spline, and checks that its bounding boxes
+	   contain dense samples of its segments, and that the results
+	   of its closest point and ray distance queries agree with
+	   distances to dense samples of its segments.
+	 */
+	HRESULT testBounds(void);
+
+	/* Logs the time taken to build bounding boxes,
+	   from scratch and incrementally, and to perform closest point
+	   and ray distance queries, compared to dense sampling.
+	 */
+	HRESULT benchmarkBounds(void);
+}
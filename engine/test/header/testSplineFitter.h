@@ -0,0 +1,45 @@
+/*
+testSplineFitter.h
+------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFileUtil.h (win32_base project)
+
+Description
+  -Test functions for the SplineFitter class,
+     and for compression of HomingSpline objects
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testSplineFitter {
+
+	/* Fits smooth and noisy trails, both at once and incrementally,
+	   at several maximum errors, and checks that all samples of the input
+	   are within the maximum error of the output, that the output
+	   is C_1 continuous, that the ends of the input are preserved,
+	   and that the number of segments is reduced.
+	 */
+	HRESULT testErrorBound(void);
+
+	/* Compares a HomingSpline with compression enabled
+	   against an identical spline without compression,
+	   as their end Transformable moves along a curved path.
+	 */
+	HRESULT testHomingSplineCompression(void);
+
+	/* Logs the number of segments output, the reduction ratio
+	   and the time taken per fit, for fits of trails of 64 to 4096 segments
+	   at once, and in increments of a few segments.
+	 */
+	HRESULT benchmarkFitting(void);
+}
@@ -0,0 +1,43 @@
+/*
+testSplineUploader.h
+--------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFileUtil.h (win32_base project)
+
+Description
+  -Test functions for the SplineUploader class,
+     and for change tracking in the Spline class
+  -These tests do not create any windows or Direct3D objects.
+     Uploads are made to RecordingBufferWriter objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testSplineUploader {
+
+	/* Applies a random sequence of knot additions, removals
+	   and updates to a spline, uploading the spline after each operation,
+	   and checks that the buffer holds the spline's control points,
+	   that unchanged splines are not uploaded again, and that
+	   at most two segments are uploaded when a knot is added
+	   to the end of a full spline of static knots, and that
+	   a new spline is uploaded entirely, even if it is created
+	   at the address of a previous spline.
+	 */
+	HRESULT testIncrementalUpload(void);
+
+	/* Logs the number of bytes uploaded per frame, and the time
+	   taken per frame, for many laser-like splines which each gain
+	   a knot per frame, compared to uploading entire splines.
+	 */
+	HRESULT benchmarkUpload(void);
+}
@@ -0,0 +1,38 @@
+/*
+testSweepAndPrune.h
+-------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFileUtil.h (win32_base project)
+
+Description
+  -Test functions for the SweepAndPrune class
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testSweepAndPrune {
+
+	/* Compares the overlapping pairs and the BEGIN, STAY and END events
+	   with those computed by testing all pairs of objects,
+	   over many updates in which objects move, teleport,
+	   and are added and removed, and in which the sweep axis changes.
+	 */
+	HRESULT testAgainstBruteForce(void);
+
+	/* Logs the time taken by updates of 1 thousand to 100 thousand objects,
+	   both when all objects are moving, and when most objects are static
+	   and filtered from testing against each other,
+	   and the time taken by testing all pairs, for comparison.
+	 */
+	HRESULT benchmarkScaling(void);
+}
@@ -0,0 +1,44 @@
+/*
+testTransformBuffer.h
+---------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFileUtil.h (win32_base project)
+
+Description
+  -Test functions for the TransformBuffer class
+  -These tests do not create any windows or Direct3D objects.
+     Rendering is simulated by reading transformations
+     from the TransformBuffer on another thread.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testTransformBuffer {
+
+	/* Checks, on a single thread, that written transformations
+	   become visible only after a flip, that slots which are not written
+	   carry over between frames, and that functions called at the wrong time fail.
+	 */
+	HRESULT testFlip(void);
+
+	/* Updates a TransformSystem and writes it to a TransformBuffer on one thread,
+	   while another thread reads the front buffer, and checks that every
+	   frame read is complete and consistent (no transformations from
+	   different frames). Intended to also be run under a race detector.
+	 */
+	HRESULT testConcurrentUpdateAndRender(void);
+
+	/* Logs the wall-clock time per frame of an update and a simulated render
+	   run one after the other, and run concurrently on two threads.
+	 */
+	HRESULT benchmarkOverlap(void);
+}
@@ -0,0 +1,37 @@
+/*
+testTransformScheduler.h
+------------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFileUtil.h (win32_base project)
+
+Description
+  -Test functions for the TransformScheduler class
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testTransformScheduler {
+
+	/* Updates randomly-generated wide, deep and irregular hierarchies,
+	   supplied to the scheduler in shuffled order, using different numbers
+	   of threads, and checks that all world transforms are bitwise identical
+	   to those of identical hierarchies updated serially in parent-before-child order.
+	 */
+	HRESULT testDeterminism(void);
+
+	/* Logs the time taken to update wide and deep hierarchies
+	   with different numbers of threads, relative to a serial update
+	   in parent-before-child order.
+	 */
+	HRESULT benchmarkUpdate(void);
+}
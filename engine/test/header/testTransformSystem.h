@@ -0,0 +1,47 @@
+/*
+testTransformSystem.h
+---------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFileUtil.h (win32_base project)
+
+Description
+  -Test functions for the TransformSystem class
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testTransformSystem {
+
+	/* Compares the world transformations computed by a TransformSystem
+	   with those computed by unbound Transformable objects,
+	   for a randomly-generated set of moving and rotating hierarchies.
+	 */
+	HRESULT testAgainstTransformable(void);
+
+	/* Times the update of 1000, 10000 and 100000 transformations,
+	   using unbound Transformable objects and a TransformSystem.
+	 */
+	HRESULT benchmarkUpdate(void);
+
+	/* Compares baked and unbaked transformations in a TransformSystem
+	   with unbound Transformable objects, checks that a baked parent
+	   can have children which move, and that moving a baked transformation
+	   unbakes it, together with its baked children.
+	 */
+	HRESULT testBaking(void);
+
+	/* Times the update of asteroid fields laid out as by
+	   GameState::spawnAsteroidsGrid(), with and without baking
+	 */
+	HRESULT benchmarkBaking(void);
+}
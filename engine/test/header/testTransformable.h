@@ -0,0 +1,35 @@
+/*
+testTransformable.h
+-------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testFileUtil.h (win32_base project)
+
+Description
+  -Test functions for the Transformable class
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testTransformable {
+
+	/* Updates two identical sets of hierarchies, one with lazy evaluation
+	   enabled and the other with lazy evaluation disabled,
+	   and checks that all world transforms are bitwise identical after each frame.
+	   The hierarchies contain static and moving objects, wide and deep
+	   parent-child relationships, RockingTransformable objects,
+	   and an object whose transformations() switches a translation
+	   on and off without changing its version counters.
+	   Also logs the number of skipped updates per frame.
+	 */
+	HRESULT testLazyEvaluation(void);
+}
@@ -0,0 +1,43 @@
+/*
+testWanderingLineSystem.h
+-------------------------
+
+Authors:
+agent
+
+Created October 19, 2026
+
+Primary basis: testTransformSystem.h
+
+Description
+  -Test functions for the WanderingLineSystem class
+  -These tests do not create any windows or Direct3D objects.
+  -HRESULT return values indicate success or failure.
+  -Results are written to log files in ENGINE_DEFAULT_LOG_PATH_TEST
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+namespace testWanderingLineSystem {
+
+	/* Compares the positions, orientations, scales and forward directions
+	   of objects in a WanderingLineSystem with those of WanderingLineTransformable
+	   objects constructed with the same parameters and instance identifiers,
+	   over many updates with moving endpoints.
+	 */
+	HRESULT testAgainstWanderingLineTransformable(void);
+
+	/* Compares the control points of a WanderingLineSpline whose knots are
+	   simulated by a WanderingLineSystem with those of a WanderingLineSpline
+	   with separate knot objects, and checks that the system's slots
+	   are freed and reused when splines are destroyed and created.
+	 */
+	HRESULT testSplines(void);
+
+	/* Times the update of 10000 wandering line objects,
+	   updated individually and by a WanderingLineSystem
+	 */
+	HRESULT benchmarkUpdate(void);
+}
@@ -29,6 +29,8 @@ cbuffer Globals : register(cb1) {
 	matrix worldMatrix;
 	float4 blendAmountAndColorCast;
 	float2 time;
+	// (billboard size multiplier, transparency multiplier) - Level of detail compensation
+	float2 lodCompensation;
 };
 
 // See vertexTypes.h for details
@@ -61,6 +63,7 @@ VSOutput VSMAIN(in VSInput input) {
 	if (health < input.life.w) {
 		health = 0.0f;
 	}
+	health *= lodCompensation.y;
 
 	// Linear motion
 	inPosition.xyz += (input.linearVelocity.xyz) * (input.linearVelocity.w) * age;
@@ -79,7 +82,7 @@ VSOutput VSMAIN(in VSInput input) {
 	viewDirection = mul(float4(viewDirection, 0.0f), viewMatrix).xyz;
 
 	// Billboard
-	output.billboard = input.billboard.xy;
+	output.billboard = input.billboard.xy * lodCompensation.x;
 
 	// Angular motion
 	output.angle = input.billboard.z * age;
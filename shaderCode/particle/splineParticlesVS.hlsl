@@ -44,6 +44,12 @@ cbuffer Globals : register(cb1) {
 	   w = spline capacity (maximum number of valid segments)
 	 */
 	float4 timeAndSplineParameters;
+	/* x = index in 'Spline' of the first segment
+	   y = number of elements in 'Spline'
+	   (Segments are stored in a ring, to avoid moving them
+	    when segments are added and removed.)
+	 */
+	float4 splineBufferParameters;
 };
 
 // See vertexTypes.h for details
@@ -74,7 +80,8 @@ struct Segment {
 StructuredBuffer<Segment> Spline : register(t0);
 
 VSOutput VSMAIN(in VSInput input) {
-	VSOutput output;
+	// Outputs are zero for particles outside the valid segments of the spline
+	VSOutput output = (VSOutput)0;
 
 	// Compute age and health
 	// ----------------------
@@ -98,7 +105,7 @@ VSOutput VSMAIN(in VSInput input) {
 		// ----------------------------------------------
 		float segmentT = frac(segmentIndex);
 		float invSegmentT = 1.0f - segmentT;
-		Segment segment = Spline[(uint)segmentIndex];
+		Segment segment = Spline[((uint)segmentIndex + (uint)splineBufferParameters.x) % (uint)splineBufferParameters.y];
 		float3 splinePosition =
 			(pow(invSegmentT, 3)*segment.p0 +
 			3.0f*segmentT*pow(invSegmentT, 2)*segment.p1 +
@@ -159,14 +166,15 @@ VSOutput VSMAIN(in VSInput input) {
 		if (dotV_Vel > 0.0f) {
 			output.angle = -output.angle;
 		}
+	}
 
-		// Updated life information
-		output.life.x = age;
-		output.life.y = health;
-		output.life.z = input.life.z;
+	// Updated life information
+	output.life.x = age;
+	output.life.y = health;
+	output.life.z = input.life.z;
+
+	// Index - pass-through
+	output.index = input.index;
 
-		// Index - pass-through
-		output.index = input.index;
-	}
 	return output;
 }
\ No newline at end of file